@@ -2,18 +2,58 @@
 #include <cstdlib>
 #include <exception>
 #include <iostream>
+#include <string>
+#include <string_view>
 
 // Platform
 #include "Platform/GraphicsAPI.h"
 
 // Application
 #include "Application/Application.h"
+#include "Application/ApplicationConfig.h"
 
 int main(int argc, char* argv[]) {
   try {
+    maple::application::ApplicationConfig config{
+      .window_title = "Maple Editor",
+      .graphics_api = maple::platform::GraphicsAPI::Vulkan
+    };
+
+    // Parse command line options
+    //   --headless     Run without a GPU or visible window (Null RHI)
+    //   --frames=<N>   Exit after N frames
+    //   --pipelined    Render on a dedicated thread
+    //   --device=<X>   Use the GPU at index X or whose name contains X
+    //   --mailbox      Present without vsync blocking (falls back to FIFO)
+    //   --trace=<path> Write a Chrome trace of the last frames on exit
+    for (int i{ 1 }; i < argc; ++i) {
+      const std::string_view arg{ argv[i] };
+      if (arg == "--headless") {
+        config.graphics_api = maple::platform::GraphicsAPI::Null;
+      } else if (arg.starts_with("--frames=")) {
+        config.max_frames = std::stoull(std::string{ arg.substr(9) });
+      } else if (arg == "--pipelined") {
+        config.run_mode = maple::application::RunMode::Pipelined;
+      } else if (arg.starts_with("--device=")) {
+        const std::string device{ arg.substr(9) };
+        if (!device.empty()
+            && device.find_first_not_of("0123456789") == std::string::npos) {
+          config.rhi_config.device_index = std::stoi(device);
+        } else {
+          config.rhi_config.device_name = device;
+        }
+      } else if (arg == "--mailbox") {
+        config.rhi_config.present_mode = maple::rhi::PresentMode::Mailbox;
+      } else if (arg.starts_with("--trace=")) {
+        config.profile_trace_path = std::string{ arg.substr(8) };
+      } else {
+        std::cerr << "Unknown option: " << arg << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
     // Initialize and run Maple Editor
-    maple::application::Application app{ "Maple Editor",
-                                         maple::platform::GraphicsAPI::Vulkan };
+    maple::application::Application app{ config };
     app.Run();
   } catch (const std::exception& e) {
     std::cerr << e.what() << std::endl;
@@ -1,7 +1,17 @@
 #include "Application/Application.h"
 
 // STL
+#include <exception>
 #include <stdexcept>
+#include <thread>
+
+// Core
+#include "Core/JobSystem.h"
+#include "Core/SnapshotQueue.h"
+
+// ECS
+#include "ECS/Scheduler.h"
+#include "ECS/World.h"
 
 // Platform
 #include "Platform/Window.h"
@@ -15,29 +25,59 @@
 namespace maple::application {
 
 Application::Application(const std::string& window_title,
-                         platform::GraphicsAPI graphics_api) {
-  // Initialize the logging system
-  core::Log::Initialize();
-
-  // Create the application window
-  MAPLE_LOG_INFO(LogApplication, "Creating application window...");
-  window_ = std::make_unique<platform::Window>(window_title, graphics_api);
-  if (!window_) {
-    const std::string msg{ "Failed to create application window" };
-    MAPLE_LOG_CRITICAL(LogApplication, msg);
-    throw std::runtime_error{ msg };
-  }
-  MAPLE_LOG_INFO(LogApplication, "Application window created");
-
-  // Create the renderer
-  MAPLE_LOG_INFO(LogApplication, "Creating renderer...");
-  renderer_ = std::make_unique<renderer::Renderer>(window_.get());
-  if (!renderer_) {
-    const std::string msg{ "Failed to create renderer" };
-    MAPLE_LOG_CRITICAL(LogApplication, msg);
-    throw std::runtime_error{ msg };
+                         platform::GraphicsAPI graphics_api)
+  : Application{ ApplicationConfig{ .window_title = window_title,
+                                    .graphics_api = graphics_api } } {}
+
+Application::Application(const ApplicationConfig& config)
+  : run_mode_{ config.run_mode }
+  , max_frames_{ config.max_frames }
+  , profile_trace_path_{ config.profile_trace_path }
+  , frame_pacer_{ config.frame_pacing } {
+  // Initialize the logging system; console output is written by a background
+  // thread so that logging never stalls the frame loop
+  core::Log::Initialize({ .mode = core::LogMode::Asynchronous });
+  MAPLE_PROFILE_THREAD("Main");
+
+  // Start one job worker per additional hardware thread
+  core::JobSystem::Initialize();
+
+  // The destructor does not run if construction fails, so stop the workers
+  // here; otherwise their threads would still be joinable at exit
+  try {
+    // Create the scene's world
+    world_ = std::make_unique<ecs::World>();
+    scheduler_ = std::make_unique<ecs::Scheduler>(*world_);
+
+    // Create the application window
+    MAPLE_LOG_INFO(LogApplication, "Creating application window...");
+    window_ = std::make_unique<platform::Window>(config.window_title,
+                                                 config.graphics_api);
+    if (!window_) {
+      const std::string msg{ "Failed to create application window" };
+      MAPLE_LOG_CRITICAL(LogApplication, msg);
+      throw std::runtime_error{ msg };
+    }
+    MAPLE_LOG_INFO(LogApplication, "Application window created");
+
+    // Create the renderer
+    MAPLE_LOG_INFO(LogApplication, "Creating renderer...");
+    renderer_ = std::make_unique<renderer::Renderer>(window_.get(),
+                                                     config.rhi_config);
+    if (!renderer_) {
+      const std::string msg{ "Failed to create renderer" };
+      MAPLE_LOG_CRITICAL(LogApplication, msg);
+      throw std::runtime_error{ msg };
+    }
+    MAPLE_LOG_INFO(LogApplication, "Renderer created");
+  } catch (...) {
+    renderer_.reset();
+    window_.reset();
+    scheduler_.reset();
+    world_.reset();
+    core::JobSystem::Shutdown();
+    throw;
   }
-  MAPLE_LOG_INFO(LogApplication, "Renderer created");
 }
 
 Application::~Application() {
@@ -51,25 +91,205 @@ Application::~Application() {
   window_.reset();
   MAPLE_LOG_INFO(LogApplication, "Application window destroyed");
 
+  // Destroy the scene's systems and entities
+  scheduler_.reset();
+  world_.reset();
+
+  // Stop the job workers
+  core::JobSystem::Shutdown();
+
+#if MAPLE_PROFILE_ENABLED
+  // Dump the most recent profiler zones
+  if (!profile_trace_path_.empty()) {
+    try {
+      core::Profiler::WriteChromeTrace(profile_trace_path_);
+    } catch (const std::exception& e) {
+      MAPLE_LOG_ERROR(LogApplication, e.what());
+    }
+  }
+#endif
+
   // Shut down the logging system
   core::Log::Shutdown();
 }
 
 void Application::Run() {
-  while (!window_->ShouldQuit()) {
+  MAPLE_PROFILE_FUNCTION(LogApplication);
+
+  switch (run_mode_) {
+    case RunMode::Sequential: {
+      RunSequential();
+      break;
+    }
+
+    case RunMode::Pipelined: {
+      RunPipelined();
+      break;
+    }
+
+    default: {
+      const std::string msg{ "Unknown run mode" };
+      MAPLE_LOG_CRITICAL(LogApplication, msg);
+      throw std::runtime_error{ msg };
+    }
+  }
+}
+
+core::FrameArena& Application::GetFrameArena() noexcept {
+  return frame_arena_;
+}
+
+const core::FrameStats& Application::GetFrameStats() const noexcept {
+  return frame_stats_;
+}
+
+ecs::World& Application::GetWorld() noexcept {
+  return *world_;
+}
+
+ecs::Scheduler& Application::GetScheduler() noexcept {
+  return *scheduler_;
+}
+
+void Application::SetFramePacing(const core::FramePacingConfig& config) {
+  frame_pacer_.SetConfig(config);
+}
+
+void Application::RunSequential() {
+  FrameSnapshot snapshot{};
+  while (!ShouldQuit()) {
+    MAPLE_PROFILE_SCOPE(LogApplication, "Frame");
+
+    // Wait for the frame according to the pacing policy
+    snapshot.delta_time = PaceFrame();
+
+    // Release the temporaries of the frame that last used this arena
+    frame_arena_.BeginFrame();
+
     // Process window events
     window_->PollEvents();
 
-    // Render frame
-    renderer_->BeginFrame();
-    renderer_->Clear(0.0F, 0.0F, 0.0F, 1.0F);
+    // Simulate, then render the frame
+    UpdateFrame(snapshot);
+    RenderFrame(snapshot);
+  }
+}
+
+void Application::RunPipelined() {
+  MAPLE_LOG_INFO(LogApplication, "Starting render thread...");
+
+  // Snapshots handed to the render thread; one slot per frame arena so that
+  // a frame's temporaries outlive its rendering
+  core::SnapshotQueue<FrameSnapshot, kFramesInFlight> snapshots{};
+
+  // Render every published snapshot until the queue is closed
+  std::exception_ptr render_error{ nullptr };
+  std::thread render_thread{ [this, &snapshots, &render_error] {
+    MAPLE_PROFILE_THREAD("Render");
+    try {
+      while (const FrameSnapshot* snapshot{ snapshots.BeginRead() }) {
+        RenderFrame(*snapshot);
+        snapshots.EndRead();
+      }
+    } catch (...) {
+      // Stop the simulation; the error is rethrown on the main thread
+      render_error = std::current_exception();
+      snapshots.Close();
+    }
+  } };
+
+  // A failing system must not unwind past the joinable render thread
+  try {
+    while (!ShouldQuit()) {
+      MAPLE_PROFILE_SCOPE(LogApplication, "Frame");
+
+      // Wait for the frame according to the pacing policy
+      const double delta_time{ PaceFrame() };
+
+      // Wait until the render thread has released the oldest snapshot, which
+      // also means the frame that last used the next arena has been rendered
+      FrameSnapshot* snapshot{ snapshots.BeginWrite() };
+      if (!snapshot) {
+        break;
+      }
+
+      // Release the temporaries of the frame that last used this arena
+      frame_arena_.BeginFrame();
+
+      // Process window events
+      window_->PollEvents();
+
+      // Simulate the frame and hand it to the render thread
+      snapshot->delta_time = delta_time;
+      UpdateFrame(*snapshot);
+      snapshots.EndWrite();
+    }
+  } catch (...) {
+    snapshots.Close();
+    render_thread.join();
+    throw;
+  }
+
+  // Let the render thread drain the remaining snapshots and exit
+  snapshots.Close();
+  render_thread.join();
+  MAPLE_LOG_INFO(LogApplication, "Render thread stopped");
+
+  if (render_error) {
+    MAPLE_LOG_CRITICAL(LogApplication, "Render thread failed");
+    std::rethrow_exception(render_error);
+  }
+}
+
+bool Application::ShouldQuit() const noexcept {
+  return window_->ShouldQuit()
+         || (max_frames_ != 0U && frame_index_ >= max_frames_);
+}
 
-    // ???
+double Application::PaceFrame() {
+  MAPLE_PROFILE_FUNCTION(LogApplication);
 
-    // Finish and present frame
-    renderer_->EndFrame();
-    renderer_->Present();
+  const double delta_time{ frame_pacer_.BeginFrame() };
+  if (frame_index_ == 0U) {
+    return delta_time;
   }
+  frame_stats_.AddSample(delta_time * 1000.0);
+
+  // Periodically summarize frame times so hitches show up in the log
+  frame_stats_log_timer_ += delta_time;
+  if (frame_stats_log_timer_ >= kFrameStatsLogInterval) {
+    frame_stats_log_timer_ = 0.0;
+    const core::FrameTimeSummary summary{ frame_stats_.GetSummary() };
+    MAPLE_LOG_DEBUG(LogApplication,
+                    "Frame time: mean {:.2f} ms, p50 {:.2f} ms, p99 {:.2f} ms, "
+                    "max {:.2f} ms",
+                    summary.mean_ms, summary.p50_ms, summary.p99_ms,
+                    summary.max_ms);
+  }
+
+  return delta_time;
+}
+
+void Application::UpdateFrame(FrameSnapshot& snapshot) {
+  MAPLE_PROFILE_FUNCTION(LogApplication);
+
+  snapshot.frame_index = frame_index_++;
+
+  // Run gameplay and simulation systems across the job threads
+  scheduler_->Update(snapshot.delta_time);
+}
+
+void Application::RenderFrame(const FrameSnapshot& snapshot) {
+  MAPLE_PROFILE_FUNCTION(LogApplication);
+
+  // Render frame
+  renderer_->BeginFrame();
+  const auto& [r, g, b, a]{ snapshot.clear_color };
+  renderer_->Clear(r, g, b, a);
+
+  // Finish and present frame
+  renderer_->EndFrame();
+  renderer_->Present();
 }
 
 } // namespace maple::application
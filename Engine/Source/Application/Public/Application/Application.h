@@ -1,16 +1,26 @@
 #pragma once
 
 // STL
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 
+// Core
+#include "Core/FrameArena.h"
+#include "Core/FramePacer.h"
+#include "Core/FrameStats.h"
+
 // Platform
 #include "Platform/GraphicsAPI.h"
 
 // Application
+#include "Application/ApplicationConfig.h"
 #include "Application/ApplicationExport.h"
+#include "Application/FrameSnapshot.h"
 
 // Forward declarations
+namespace maple::ecs{ class Scheduler; class World; }
 namespace maple::platform{ class Window; }
 namespace maple::renderer{ class Renderer; }
 
@@ -44,6 +54,17 @@ public:
   Application(const std::string& window_title,
               platform::GraphicsAPI graphics_api);
 
+  /**
+   * @brief Construct an application from a configuration.
+   *
+   * Initializes all engine subsystems and prepares the application for execution.
+   *
+   * @param config Window, graphics API, and run mode settings
+   *
+   * @throws std::runtime_error If critical subsystem initialization fails
+   */
+  explicit Application(const ApplicationConfig& config);
+
   /**
    * @brief Shut down all subsystems and destroy the application.
    */
@@ -53,11 +74,138 @@ public:
    * @brief Run the main application loop.
    *
    * Executes the engine's frame loop, updating and rendering all active
-   * subsystems and layers until termination is requested.
+   * subsystems and layers until termination is requested or the configured
+   * frame limit is reached. In pipelined mode, rendering runs on a dedicated
+   * thread one frame behind the simulation.
+   *
+   * @throws std::runtime_error If rendering fails on the render thread
    */
   void Run();
 
+  /**
+   * @brief Get the per-frame arena for temporary allocations.
+   *
+   * Allocations from the current arena remain valid for as many frames as
+   * there are frames in flight and are released in bulk afterwards.
+   *
+   * @return The application's frame arena
+   */
+  [[nodiscard]] core::FrameArena& GetFrameArena() noexcept;
+
+  /**
+   * @brief Get the rolling frame-time statistics of the main loop.
+   *
+   * @return Frame-time samples of the most recent frames
+   */
+  [[nodiscard]] const core::FrameStats& GetFrameStats() const noexcept;
+
+  /**
+   * @brief Get the world holding the scene's entities and components.
+   *
+   * @return The application's world
+   *
+   * @note Structural changes must be made from the main thread, outside of
+   *       query iteration.
+   */
+  [[nodiscard]] ecs::World& GetWorld() noexcept;
+
+  /**
+   * @brief Get the scheduler that runs the world's systems every frame.
+   *
+   * @return The application's system scheduler
+   *
+   * @note Systems must be added from the main thread.
+   */
+  [[nodiscard]] ecs::Scheduler& GetScheduler() noexcept;
+
+  /**
+   * @brief Change the frame rate limiting of the main loop.
+   *
+   * @param config Pacing policy and target frame rate
+   *
+   * @note Must be called from the main thread.
+   */
+  void SetFramePacing(const core::FramePacingConfig& config);
+
 private:
+  /**
+   * @brief Run events, simulation, and rendering in lockstep.
+   */
+  void RunSequential();
+
+  /**
+   * @brief Run events and simulation here and rendering on a render thread.
+   */
+  void RunPipelined();
+
+  /**
+   * @brief Check whether the main loop should stop.
+   *
+   * @return true if a quit was requested or the frame limit was reached
+   */
+  [[nodiscard]] bool ShouldQuit() const noexcept;
+
+  /**
+   * @brief Wait for the next frame according to the pacing policy and
+   *        record the previous frame's duration.
+   *
+   * @return Seconds elapsed since the previous frame began
+   */
+  double PaceFrame();
+
+  /**
+   * @brief Simulate a frame and capture what the renderer needs.
+   *
+   * @param snapshot Snapshot to fill for the frame
+   */
+  void UpdateFrame(FrameSnapshot& snapshot);
+
+  /**
+   * @brief Record, submit, and present a frame.
+   *
+   * @param snapshot Snapshot produced by UpdateFrame()
+   */
+  void RenderFrame(const FrameSnapshot& snapshot);
+
+  /// Capacity of each frame's arena in bytes
+  static constexpr std::size_t kFrameArenaCapacity{ 4U * 1024U * 1024U };
+
+  /// Number of frames whose temporary allocations must remain valid
+  static constexpr std::uint32_t kFramesInFlight{ 2U };
+
+  /// Seconds between frame-time summaries in the log
+  static constexpr double kFrameStatsLogInterval{ 10.0 };
+
+  /// Threading model of the main loop
+  RunMode run_mode_;
+
+  /// Number of frames to run (0 for no limit)
+  std::uint64_t max_frames_;
+
+  /// Chrome trace file written on shutdown (empty to skip)
+  std::string profile_trace_path_;
+
+  /// Index of the next frame to simulate
+  std::uint64_t frame_index_{ 0U };
+
+  /// Frame timer and rate limiter
+  core::FramePacer frame_pacer_;
+
+  /// Rolling frame-time samples
+  core::FrameStats frame_stats_{};
+
+  /// Seconds since frame-time statistics were last logged
+  double frame_stats_log_timer_{ 0.0 };
+
+  /// Per-frame arenas for temporary allocations
+  core::FrameArena frame_arena_{ kFrameArenaCapacity, kFramesInFlight };
+
+  /// Entities and components of the scene
+  std::unique_ptr<ecs::World> world_{ nullptr };
+
+  /// Runs the world's systems during simulation
+  std::unique_ptr<ecs::Scheduler> scheduler_{ nullptr };
+
   /// Application window
   std::unique_ptr<platform::Window> window_{ nullptr };
 
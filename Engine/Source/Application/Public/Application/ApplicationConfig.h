@@ -0,0 +1,59 @@
+#pragma once
+
+// STL
+#include <cstdint>
+#include <string>
+
+// Core
+#include "Core/FramePacer.h"
+
+// Platform
+#include "Platform/GraphicsAPI.h"
+
+// RHI
+#include "RHI/RHIConfig.h"
+
+namespace maple::application {
+
+/**
+ * @brief Threading model of the main loop.
+ */
+enum class RunMode {
+  /// Events, simulation, and rendering of each frame run in lockstep on the
+  /// main thread
+  Sequential,
+
+  /// The main thread handles events and simulation of frame N while a render
+  /// thread submits frame N-1
+  Pipelined
+};
+
+/**
+ * @brief Configuration for constructing an Application.
+ */
+struct ApplicationConfig {
+  /// Title displayed in the window title bar
+  std::string window_title{ "Maple" };
+
+  /// Requested graphics API (may fall back to the platform default)
+  platform::GraphicsAPI graphics_api{ platform::GraphicsAPI::Vulkan };
+
+  /// Device selection and backend settings of the RHI
+  rhi::RHIConfig rhi_config{};
+
+  /// Threading model of the main loop
+  RunMode run_mode{ RunMode::Sequential };
+
+  /// Number of frames to run before Run() returns (0 runs until the window
+  /// is closed; headless runs have no window to close)
+  std::uint64_t max_frames{ 0U };
+
+  /// Frame rate limiting of the main loop
+  core::FramePacingConfig frame_pacing{};
+
+  /// Chrome trace file written on shutdown (empty to skip; requires
+  /// MAPLE_PROFILE builds)
+  std::string profile_trace_path{};
+};
+
+} // namespace maple::application
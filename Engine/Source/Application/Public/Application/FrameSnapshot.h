@@ -0,0 +1,27 @@
+#pragma once
+
+// STL
+#include <array>
+#include <cstdint>
+
+namespace maple::application {
+
+/**
+ * @brief Everything the renderer needs to draw one frame.
+ *
+ * Produced by the simulation step and consumed by the render step. In
+ * pipelined mode, snapshots are handed to the render thread by value, so they
+ * must not reference simulation state that changes in later frames.
+ */
+struct FrameSnapshot {
+  /// Index of the simulated frame
+  std::uint64_t frame_index{ 0U };
+
+  /// Seconds elapsed since the previous frame began
+  double delta_time{ 0.0 };
+
+  /// Color the frame is cleared to (RGBA, [0.0 - 1.0])
+  std::array<float, 4> clear_color{ 0.0F, 0.0F, 0.0F, 1.0F };
+};
+
+} // namespace maple::application
@@ -0,0 +1,255 @@
+#include "Core/AsyncLogSink.h"
+
+// STL
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace maple::core {
+
+AsyncLogSink::AsyncLogSink(std::shared_ptr<spdlog::sinks::sink> backend,
+                           std::size_t capacity,
+                           LogOverflowPolicy overflow_policy)
+  : backend_{ std::move(backend) }
+  , overflow_policy_{ overflow_policy } {
+  // Preallocate the ring; each slot starts free for the matching position
+  const std::size_t slot_count{ std::bit_ceil(capacity < 2U ? 2U : capacity) };
+  slots_ = std::make_unique<Slot[]>(slot_count);
+  mask_ = slot_count - 1U;
+  for (std::size_t i{ 0U }; i < slot_count; ++i) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  // Start the drain thread
+  drain_thread_ = std::thread{ &AsyncLogSink::DrainLoop, this };
+}
+
+AsyncLogSink::~AsyncLogSink() {
+  Stop();
+}
+
+void AsyncLogSink::log(const spdlog::details::log_msg& msg) {
+  // Announce the producer before checking running_, so Stop() either sees it
+  // and waits for its record, or it sees running_ cleared (both seq_cst)
+  active_producers_.fetch_add(1U);
+  struct ProducerGuard {
+    std::atomic<std::uint32_t>& active_producers;
+    ~ProducerGuard() {
+      active_producers.fetch_sub(1U, std::memory_order_release);
+    }
+  } guard{ active_producers_ };
+
+  // Once stopped, fall back to writing on the calling thread
+  if (!running_.load()) {
+    backend_->log(msg);
+    return;
+  }
+
+  while (!TryEnqueue(msg)) {
+    switch (overflow_policy_) {
+      case LogOverflowPolicy::Block: {
+        // Nobody will free a slot once stopped; write synchronously instead
+        if (!running_.load(std::memory_order_acquire)) {
+          backend_->log(msg);
+          return;
+        }
+
+        // Wait for the drain thread to free a slot
+        wake_cv_.notify_one();
+        std::this_thread::yield();
+        break;
+      }
+
+      case LogOverflowPolicy::DropNewest: {
+        dropped_.fetch_add(1U, std::memory_order_relaxed);
+        return;
+      }
+
+      case LogOverflowPolicy::OverwriteOldest: {
+        // Discard the oldest record to make room, then retry
+        if (TryDequeue(false)) {
+          dropped_.fetch_add(1U, std::memory_order_relaxed);
+        }
+        break;
+      }
+    }
+  }
+}
+
+void AsyncLogSink::flush() {
+  // Wait until every record enqueued so far has been forwarded or discarded
+  const std::uint64_t target{ enqueue_pos_.load(std::memory_order_acquire) };
+  while (running_.load(std::memory_order_acquire)
+         && completed_.load(std::memory_order_acquire) < target) {
+    wake_cv_.notify_one();
+    std::this_thread::yield();
+  }
+
+  backend_->flush();
+}
+
+void AsyncLogSink::set_pattern(const std::string& pattern) {
+  backend_->set_pattern(pattern);
+}
+
+void AsyncLogSink::set_formatter(
+  std::unique_ptr<spdlog::formatter> formatter) {
+  backend_->set_formatter(std::move(formatter));
+}
+
+void AsyncLogSink::Stop() {
+  // Signal the drain thread, which empties the ring before exiting
+  {
+    std::lock_guard lock{ wake_mutex_ };
+    running_.store(false);
+  }
+  wake_cv_.notify_one();
+
+  // Producers that saw the sink running may still be enqueueing
+  while (active_producers_.load(std::memory_order_acquire) != 0U) {
+    std::this_thread::yield();
+  }
+
+  if (drain_thread_.joinable()) {
+    drain_thread_.join();
+  }
+
+  // The drain thread may have exited before the last producers enqueued
+  while (TryDequeue(true)) {}
+  ReportDroppedMessages();
+
+  backend_->flush();
+}
+
+bool AsyncLogSink::TryEnqueue(const spdlog::details::log_msg& msg) {
+  // Claim the slot at the current enqueue position
+  Slot* slot{ nullptr };
+  std::uint64_t pos{ enqueue_pos_.load(std::memory_order_relaxed) };
+  for (;;) {
+    slot = &slots_[pos & mask_];
+    const std::uint64_t seq{ slot->sequence.load(std::memory_order_acquire) };
+    const auto diff{ static_cast<std::int64_t>(seq - pos) };
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1U,
+                                             std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // Slot still holds an unconsumed record; ring is full
+      return false;
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Copy the message into the claimed slot
+  Record& record{ slot->record };
+  record.time = msg.time;
+  record.source = msg.source;
+  record.logger_name = msg.logger_name;
+  record.level = msg.level;
+  record.thread_id = msg.thread_id;
+  record.payload_size = msg.payload.size();
+  char* payload{ record.inline_payload };
+  if (record.payload_size > kInlinePayloadSize) {
+    record.heap_payload = std::make_unique<char[]>(record.payload_size);
+    payload = record.heap_payload.get();
+  }
+  std::memcpy(payload, msg.payload.data(), record.payload_size);
+
+  // Publish the record to the consumer
+  slot->sequence.store(pos + 1U, std::memory_order_release);
+  return true;
+}
+
+bool AsyncLogSink::TryDequeue(bool forward) {
+  // Claim the slot at the current dequeue position
+  Slot* slot{ nullptr };
+  std::uint64_t pos{ dequeue_pos_.load(std::memory_order_relaxed) };
+  for (;;) {
+    slot = &slots_[pos & mask_];
+    const std::uint64_t seq{ slot->sequence.load(std::memory_order_acquire) };
+    const auto diff{ static_cast<std::int64_t>(seq - (pos + 1U)) };
+    if (diff == 0) {
+      if (dequeue_pos_.compare_exchange_weak(pos, pos + 1U,
+                                             std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // Slot not yet published; ring is empty
+      return false;
+    } else {
+      pos = dequeue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Forward or discard the record, then release the slot to producers
+  if (forward) {
+    Forward(slot->record);
+  }
+  slot->record.heap_payload.reset();
+  slot->sequence.store(pos + mask_ + 1U, std::memory_order_release);
+  completed_.fetch_add(1U, std::memory_order_release);
+  return true;
+}
+
+void AsyncLogSink::Forward(const Record& record) {
+  const char* payload{ record.heap_payload ? record.heap_payload.get()
+                                           : record.inline_payload };
+  spdlog::details::log_msg msg{
+    record.time, record.source, record.logger_name, record.level,
+    spdlog::string_view_t{ payload, record.payload_size }
+  };
+  msg.thread_id = record.thread_id;
+
+  if (backend_->should_log(msg.level)) {
+    backend_->log(msg);
+  }
+}
+
+void AsyncLogSink::ReportDroppedMessages() {
+  const std::uint64_t dropped{
+    dropped_.exchange(0U, std::memory_order_relaxed)
+  };
+  if (dropped == 0U) {
+    return;
+  }
+
+  const std::string text{
+    "Asynchronous log queue overflowed; " + std::to_string(dropped)
+    + " message(s) dropped"
+  };
+  const spdlog::details::log_msg msg{
+    spdlog::string_view_t{ "Log" }, spdlog::level::warn,
+    spdlog::string_view_t{ text }
+  };
+  backend_->log(msg);
+}
+
+void AsyncLogSink::DrainLoop() {
+  for (;;) {
+    // Forward everything currently queued
+    bool drained_any{ false };
+    while (TryDequeue(true)) {
+      drained_any = true;
+    }
+    ReportDroppedMessages();
+
+    // Exit only once the ring is empty after shutdown was requested
+    if (!running_.load(std::memory_order_acquire)) {
+      while (TryDequeue(true)) {}
+      ReportDroppedMessages();
+      return;
+    }
+
+    // Sleep briefly when idle; producers never signal, flush() and Stop() do
+    if (!drained_any) {
+      std::unique_lock lock{ wake_mutex_ };
+      wake_cv_.wait_for(lock, std::chrono::milliseconds{ 1 });
+    }
+  }
+}
+
+} // namespace maple::core
@@ -0,0 +1,163 @@
+#pragma once
+
+// STL
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// spdlog
+#include "spdlog/sinks/sink.h"
+
+// Core
+#include "Core/Log.h"
+
+namespace maple::core {
+
+/**
+ * @brief spdlog sink that defers console output to a background thread.
+ *
+ * Log calls copy the message into a preallocated, bounded, lock-free
+ * multi-producer ring buffer (Vyukov MPMC queue) and return immediately. A
+ * dedicated thread drains the ring and forwards messages to the backend sink.
+ * Producers never take a lock unless the overflow policy is Block and the
+ * ring is full.
+ */
+class AsyncLogSink final : public spdlog::sinks::sink {
+public:
+  AsyncLogSink() = delete;
+  AsyncLogSink(const AsyncLogSink&) = delete;
+  AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+  AsyncLogSink(AsyncLogSink&&) = delete;
+  AsyncLogSink& operator=(AsyncLogSink&&) = delete;
+
+  /**
+   * @brief Construct the sink and start the background drain thread.
+   *
+   * @param backend Sink that receives messages on the drain thread
+   * @param capacity Number of ring slots (rounded up to a power of two)
+   * @param overflow_policy Behavior when the ring is full
+   */
+  AsyncLogSink(std::shared_ptr<spdlog::sinks::sink> backend,
+               std::size_t capacity, LogOverflowPolicy overflow_policy);
+
+  /**
+   * @brief Drain all queued messages and stop the background thread.
+   */
+  ~AsyncLogSink() override;
+
+  void log(const spdlog::details::log_msg& msg) override;
+  void flush() override;
+  void set_pattern(const std::string& pattern) override;
+  void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+  /**
+   * @brief Drain all queued messages and join the background thread.
+   *
+   * Safe to call multiple times. Messages logged after Stop() are written
+   * synchronously to the backend sink.
+   */
+  void Stop();
+
+private:
+  /// Payload bytes stored inline in each slot; longer messages spill to heap
+  static constexpr std::size_t kInlinePayloadSize{ 384 };
+
+  /**
+   * @brief Copy of a log message that owns its payload.
+   */
+  struct Record {
+    spdlog::log_clock::time_point time{};
+    spdlog::source_loc source{};
+    spdlog::string_view_t logger_name{};
+    spdlog::level::level_enum level{ spdlog::level::off };
+    std::size_t thread_id{ 0U };
+    std::size_t payload_size{ 0U };
+    std::unique_ptr<char[]> heap_payload{ nullptr };
+    char inline_payload[kInlinePayloadSize]{};
+  };
+
+  /**
+   * @brief Ring slot guarded by a sequence number.
+   *
+   * The sequence encodes whether the slot is free for the producer at a given
+   * enqueue position or holds a record for the consumer at a dequeue position.
+   */
+  struct alignas(64) Slot {
+    std::atomic<std::uint64_t> sequence{ 0U };
+    Record record{};
+  };
+
+  /**
+   * @brief Try to claim a slot and copy the message into it.
+   *
+   * @return false if the ring is full
+   */
+  bool TryEnqueue(const spdlog::details::log_msg& msg);
+
+  /**
+   * @brief Try to pop the oldest record.
+   *
+   * @param forward Whether to forward the record to the backend sink or
+   *                discard it (used by the OverwriteOldest policy)
+   * @return false if the ring is empty
+   */
+  bool TryDequeue(bool forward);
+
+  /**
+   * @brief Forward a record to the backend sink.
+   */
+  void Forward(const Record& record);
+
+  /**
+   * @brief Report messages lost to the overflow policy since the last report.
+   */
+  void ReportDroppedMessages();
+
+  /**
+   * @brief Background thread entry point.
+   */
+  void DrainLoop();
+
+  /// Sink receiving messages on the drain thread
+  std::shared_ptr<spdlog::sinks::sink> backend_{ nullptr };
+
+  /// Behavior when the ring is full
+  const LogOverflowPolicy overflow_policy_;
+
+  /// Preallocated ring slots
+  std::unique_ptr<Slot[]> slots_{ nullptr };
+
+  /// Index mask for the power-of-two ring
+  std::uint64_t mask_{ 0U };
+
+  /// Next position to be claimed by a producer
+  alignas(64) std::atomic<std::uint64_t> enqueue_pos_{ 0U };
+
+  /// Next position to be popped by the consumer
+  alignas(64) std::atomic<std::uint64_t> dequeue_pos_{ 0U };
+
+  /// Number of records forwarded or discarded (used by flush())
+  alignas(64) std::atomic<std::uint64_t> completed_{ 0U };
+
+  /// Messages discarded by the overflow policy and not yet reported
+  std::atomic<std::uint64_t> dropped_{ 0U };
+
+  /// Whether the drain thread should keep running
+  std::atomic<bool> running_{ true };
+
+  /// Producers inside log() (Stop() waits for them before the final drain)
+  std::atomic<std::uint32_t> active_producers_{ 0U };
+
+  /// Wakes the drain thread early (flush or shutdown requests)
+  std::mutex wake_mutex_{};
+  std::condition_variable wake_cv_{};
+
+  /// Background drain thread
+  std::thread drain_thread_{};
+};
+
+} // namespace maple::core
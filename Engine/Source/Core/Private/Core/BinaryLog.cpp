@@ -0,0 +1,360 @@
+#include "Core/BinaryLog.h"
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Core
+#include "Core/Log.h"
+
+namespace maple::core {
+
+namespace {
+
+/// Capacity in bytes of each per-thread event buffer
+constexpr std::size_t kThreadBufferSize{ 256U * 1024U };
+
+/**
+ * @brief Single-producer, single-consumer byte ring owned by one thread.
+ *
+ * The owning thread appends encoded events; the writer drains them to the
+ * file while holding the writer mutex.
+ */
+struct ThreadBuffer {
+  /// Ring storage
+  std::unique_ptr<std::byte[]> data{
+    std::make_unique<std::byte[]>(kThreadBufferSize)
+  };
+
+  /// Engine-assigned index of the owning thread
+  std::uint32_t thread_index{ 0U };
+
+  /// Total bytes written by the producer
+  alignas(64) std::atomic<std::uint64_t> head{ 0U };
+
+  /// Total bytes consumed by the writer
+  alignas(64) std::atomic<std::uint64_t> tail{ 0U };
+};
+
+/**
+ * @brief Shared state of the binary logging backend.
+ */
+struct BinaryLogState {
+  /**
+   * @brief Stop the writer if Shutdown() was never called.
+   */
+  ~BinaryLogState() {
+    {
+      std::lock_guard lock{ mutex };
+      running = false;
+    }
+    wake_cv.notify_one();
+    if (writer.joinable()) {
+      writer.join();
+    }
+    if (file) {
+      std::fclose(file);
+    }
+  }
+
+  /// Guards the file, the format table, and buffer draining
+  std::mutex mutex{};
+
+  /// Wakes the writer thread on flush or shutdown
+  std::condition_variable wake_cv{};
+
+  /// Output file (null until Initialize())
+  std::FILE* file{ nullptr };
+
+  /// Encoded format definitions awaiting an open file
+  std::vector<std::byte> pending_formats{};
+
+  /// Number of assigned format IDs
+  std::uint32_t format_count{ 0U };
+
+  /// Guards the buffer list
+  std::mutex buffers_mutex{};
+
+  /// Buffers of all threads that have logged (including exited threads)
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers{};
+
+  /// Next thread index to assign
+  std::uint32_t next_thread_index{ 0U };
+
+  /// Events dropped because a thread buffer was full
+  std::atomic<std::uint64_t> dropped{ 0U };
+
+  /// Whether the writer thread should keep running
+  bool running{ false };
+
+  /// Background writer thread
+  std::thread writer{};
+};
+
+BinaryLogState& GetState() {
+  static BinaryLogState state{};
+  return state;
+}
+
+/**
+ * @brief Get the calling thread's buffer, creating it on first use.
+ */
+ThreadBuffer& GetThreadBuffer() {
+  thread_local std::shared_ptr<ThreadBuffer> buffer{ [] {
+    auto new_buffer{ std::make_shared<ThreadBuffer>() };
+
+    BinaryLogState& state{ GetState() };
+    std::lock_guard lock{ state.buffers_mutex };
+    new_buffer->thread_index = state.next_thread_index++;
+    state.buffers.emplace_back(new_buffer);
+    return new_buffer;
+  }() };
+  return *buffer;
+}
+
+/**
+ * @brief Append raw bytes to a byte vector.
+ */
+void Append(std::vector<std::byte>& out, const void* data, std::size_t size) {
+  const auto* bytes{ static_cast<const std::byte*>(data) };
+  out.insert(out.end(), bytes, bytes + size);
+}
+
+/**
+ * @brief Get the current steady clock time in nanoseconds.
+ */
+std::int64_t SteadyNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()
+  ).count();
+}
+
+/**
+ * @brief Write every thread buffer's pending bytes to the file.
+ *
+ * @note The caller must hold BinaryLogState::mutex and the file must be open.
+ */
+void DrainBuffers(BinaryLogState& state) {
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers{};
+  {
+    std::lock_guard lock{ state.buffers_mutex };
+    buffers = state.buffers;
+  }
+
+  for (const auto& buffer : buffers) {
+    const std::uint64_t tail{ buffer->tail.load(std::memory_order_relaxed) };
+    const std::uint64_t head{ buffer->head.load(std::memory_order_acquire) };
+    if (head == tail) {
+      continue;
+    }
+
+    // Copy the pending range, which may wrap around the end of the ring
+    const std::size_t offset{ tail % kThreadBufferSize };
+    const std::size_t size{ head - tail };
+    const std::size_t first{ std::min(size, kThreadBufferSize - offset) };
+    std::fwrite(buffer->data.get() + offset, 1U, first, state.file);
+    std::fwrite(buffer->data.get(), 1U, size - first, state.file);
+
+    buffer->tail.store(head, std::memory_order_release);
+  }
+
+  // Drop the copies first, so that only the list and live threads hold
+  // buffers, then release buffers of exited threads once they are empty
+  buffers.clear();
+  std::lock_guard lock{ state.buffers_mutex };
+  std::erase_if(state.buffers, [](const std::shared_ptr<ThreadBuffer>& buffer) {
+    return buffer.use_count() == 1
+           && buffer->head.load(std::memory_order_acquire)
+              == buffer->tail.load(std::memory_order_relaxed);
+  });
+}
+
+/**
+ * @brief Background writer thread entry point.
+ */
+void WriterLoop() {
+  BinaryLogState& state{ GetState() };
+  std::unique_lock lock{ state.mutex };
+  while (state.running) {
+    DrainBuffers(state);
+    state.wake_cv.wait_for(lock, std::chrono::milliseconds{ 2 });
+  }
+  DrainBuffers(state);
+}
+
+} // namespace
+
+void BinaryLog::Initialize(const std::string& path) {
+  BinaryLogState& state{ GetState() };
+  std::lock_guard lock{ state.mutex };
+  if (state.file) {
+    return;
+  }
+
+  // Open the output file
+  state.file = std::fopen(path.c_str(), "wb");
+  if (!state.file) {
+    throw std::runtime_error{ "Failed to open binary log file: " + path };
+  }
+
+  // Write the header with matching steady and system clock origins
+  const binary_log::FileHeader header{
+    .steady_origin_ns = SteadyNowNs(),
+    .system_origin_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch()
+    ).count()
+  };
+  std::fwrite(&header, sizeof(header), 1U, state.file);
+
+  // Write definitions registered before the file was opened
+  std::fwrite(state.pending_formats.data(), 1U, state.pending_formats.size(),
+              state.file);
+  state.pending_formats.clear();
+  state.pending_formats.shrink_to_fit();
+
+  // Start the background writer
+  state.running = true;
+  state.writer = std::thread{ WriterLoop };
+}
+
+void BinaryLog::Shutdown() {
+  BinaryLogState& state{ GetState() };
+
+  // Stop the writer, which drains all buffers before exiting
+  {
+    std::lock_guard lock{ state.mutex };
+    if (!state.file) {
+      return;
+    }
+    state.running = false;
+  }
+  state.wake_cv.notify_one();
+  if (state.writer.joinable()) {
+    state.writer.join();
+  }
+
+  // Report events lost to full buffers
+  const std::uint64_t dropped{ state.dropped.exchange(0U) };
+  if (dropped > 0U) {
+    spdlog::warn("Binary log buffers overflowed; {} event(s) dropped", dropped);
+  }
+
+  std::lock_guard lock{ state.mutex };
+  std::fclose(state.file);
+  state.file = nullptr;
+}
+
+void BinaryLog::Flush() {
+  BinaryLogState& state{ GetState() };
+  std::lock_guard lock{ state.mutex };
+  if (!state.file) {
+    return;
+  }
+
+  DrainBuffers(state);
+  std::fflush(state.file);
+}
+
+std::uint32_t BinaryLog::RegisterFormat(
+  BinaryLogSite& site, std::string_view format,
+  std::span<const binary_log::ArgType> arg_types
+) {
+  BinaryLogState& state{ GetState() };
+  std::lock_guard lock{ state.mutex };
+
+  // Another thread may have registered the site in the meantime
+  const std::uint32_t existing_id{
+    site.format_id.load(std::memory_order_acquire)
+  };
+  if (existing_id != 0U) {
+    return existing_id;
+  }
+  const std::uint32_t format_id{ ++state.format_count };
+
+  // Encode the definition record
+  const std::string& category{ site.category.logger->name() };
+  const std::string_view file{ site.file };
+  const auto kind{ binary_log::RecordKind::Format };
+  const auto level{ static_cast<std::uint8_t>(site.level) };
+  const auto arg_count{ static_cast<std::uint8_t>(arg_types.size()) };
+  const auto category_length{ static_cast<std::uint16_t>(category.size()) };
+  const auto file_length{ static_cast<std::uint16_t>(file.size()) };
+  const auto format_length{ static_cast<std::uint32_t>(format.size()) };
+
+  std::vector<std::byte> record{};
+  Append(record, &kind, sizeof(kind));
+  Append(record, &format_id, sizeof(format_id));
+  Append(record, &level, sizeof(level));
+  Append(record, &site.line, sizeof(site.line));
+  Append(record, &arg_count, sizeof(arg_count));
+  Append(record, arg_types.data(), arg_types.size_bytes());
+  Append(record, &category_length, sizeof(category_length));
+  Append(record, category.data(), category_length);
+  Append(record, &file_length, sizeof(file_length));
+  Append(record, file.data(), file_length);
+  Append(record, &format_length, sizeof(format_length));
+  Append(record, format.data(), format_length);
+
+  // Write it ahead of any event that references it
+  if (state.file) {
+    std::fwrite(record.data(), 1U, record.size(), state.file);
+  } else {
+    state.pending_formats.insert(state.pending_formats.end(), record.begin(),
+                                 record.end());
+  }
+
+  site.format_id.store(format_id, std::memory_order_release);
+  return format_id;
+}
+
+void BinaryLog::Submit(std::uint32_t format_id, const std::byte* args,
+                       std::size_t args_size) {
+  ThreadBuffer& buffer{ GetThreadBuffer() };
+
+  // Drop the event if the writer has not caught up
+  const std::size_t record_size{ binary_log::kEventHeaderSize + args_size };
+  const std::uint64_t head{ buffer.head.load(std::memory_order_relaxed) };
+  const std::uint64_t tail{ buffer.tail.load(std::memory_order_acquire) };
+  if (kThreadBufferSize - (head - tail) < record_size) {
+    GetState().dropped.fetch_add(1U, std::memory_order_relaxed);
+    return;
+  }
+
+  // Encode the event header next to the arguments
+  std::byte record[binary_log::kEventHeaderSize + binary_log::kMaxArgsSize];
+  const auto kind{ binary_log::RecordKind::Event };
+  const std::int64_t timestamp{ SteadyNowNs() };
+  const auto size{ static_cast<std::uint16_t>(args_size) };
+  std::byte* cursor{ record };
+  std::memcpy(cursor, &kind, sizeof(kind));
+  cursor += sizeof(kind);
+  std::memcpy(cursor, &format_id, sizeof(format_id));
+  cursor += sizeof(format_id);
+  std::memcpy(cursor, &buffer.thread_index, sizeof(buffer.thread_index));
+  cursor += sizeof(buffer.thread_index);
+  std::memcpy(cursor, &timestamp, sizeof(timestamp));
+  cursor += sizeof(timestamp);
+  std::memcpy(cursor, &size, sizeof(size));
+  cursor += sizeof(size);
+  std::memcpy(cursor, args, args_size);
+
+  // Copy into the ring, wrapping around the end if necessary
+  const std::size_t offset{ head % kThreadBufferSize };
+  const std::size_t first{
+    std::min(record_size, kThreadBufferSize - offset)
+  };
+  std::memcpy(buffer.data.get() + offset, record, first);
+  std::memcpy(buffer.data.get(), record + first, record_size - first);
+
+  // Publish the event to the writer
+  buffer.head.store(head + record_size, std::memory_order_release);
+}
+
+} // namespace maple::core
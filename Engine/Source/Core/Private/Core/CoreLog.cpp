@@ -0,0 +1,3 @@
+#include "Core/CoreLog.h"
+
+MAPLE_DEFINE_LOG_CATEGORY(LogCore);
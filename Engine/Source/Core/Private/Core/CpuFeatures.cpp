@@ -0,0 +1,91 @@
+#include "Core/CpuFeatures.h"
+
+// STL
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86)
+  #include <intrin.h>
+  #define MAPLE_CPU_X86 1
+#elif defined(__x86_64__) || defined(__i386__)
+  #include <cpuid.h>
+  #define MAPLE_CPU_X86 1
+#endif
+
+namespace maple::core {
+
+namespace {
+
+#if defined(MAPLE_CPU_X86)
+
+/**
+ * @brief Registers returned by the cpuid instruction.
+ */
+struct CpuidResult {
+  std::uint32_t eax{ 0U };
+  std::uint32_t ebx{ 0U };
+  std::uint32_t ecx{ 0U };
+  std::uint32_t edx{ 0U };
+};
+
+CpuidResult Cpuid(std::uint32_t leaf, std::uint32_t subleaf) noexcept {
+  CpuidResult result{};
+#if defined(_MSC_VER) && !defined(__clang__)
+  int registers[4]{};
+  __cpuidex(registers, static_cast<int>(leaf), static_cast<int>(subleaf));
+  result.eax = static_cast<std::uint32_t>(registers[0]);
+  result.ebx = static_cast<std::uint32_t>(registers[1]);
+  result.ecx = static_cast<std::uint32_t>(registers[2]);
+  result.edx = static_cast<std::uint32_t>(registers[3]);
+#else
+  __cpuid_count(leaf, subleaf, result.eax, result.ebx, result.ecx,
+                result.edx);
+#endif
+  return result;
+}
+
+std::uint64_t ReadXcr0() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+  return _xgetbv(0);
+#else
+  std::uint32_t low{ 0U };
+  std::uint32_t high{ 0U };
+  __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+  return (static_cast<std::uint64_t>(high) << 32U) | low;
+#endif
+}
+
+#endif
+
+CpuFeatures DetectCpuFeatures() noexcept {
+  CpuFeatures features{};
+#if defined(MAPLE_CPU_X86)
+  const std::uint32_t max_leaf{ Cpuid(0U, 0U).eax };
+  if (max_leaf < 1U) {
+    return features;
+  }
+
+  const CpuidResult leaf1{ Cpuid(1U, 0U) };
+  features.sse41 = (leaf1.ecx & (1U << 19U)) != 0U;
+
+  // AVX state is only usable if the OS saves the XMM and YMM registers
+  const bool osxsave{ (leaf1.ecx & (1U << 27U)) != 0U };
+  const bool ymm_saved{ osxsave && (ReadXcr0() & 0x6U) == 0x6U };
+  features.avx = ymm_saved && (leaf1.ecx & (1U << 28U)) != 0U;
+  features.fma = features.avx && (leaf1.ecx & (1U << 12U)) != 0U;
+
+  if (max_leaf >= 7U) {
+    const CpuidResult leaf7{ Cpuid(7U, 0U) };
+    features.avx2 = features.avx && (leaf7.ebx & (1U << 5U)) != 0U;
+  }
+#endif
+  return features;
+}
+
+} // namespace
+
+const CpuFeatures& GetCpuFeatures() noexcept {
+  static const CpuFeatures features{ DetectCpuFeatures() };
+  return features;
+}
+
+} // namespace maple::core
@@ -0,0 +1,39 @@
+#include "Core/FrameArena.h"
+
+// STL
+#include <algorithm>
+
+namespace maple::core {
+
+FrameArena::FrameArena(std::size_t capacity_per_frame,
+                       std::uint32_t frames_in_flight) {
+  // Create and preallocate one arena per frame in flight
+  const std::uint32_t arena_count{ std::max(frames_in_flight, 1U) };
+  arenas_.reserve(arena_count);
+  for (std::uint32_t i{ 0U }; i < arena_count; ++i) {
+    arenas_.emplace_back(
+      std::make_unique<LinearArena>(capacity_per_frame, "FrameArena")
+    );
+  }
+}
+
+FrameArena::~FrameArena() = default;
+
+void FrameArena::BeginFrame() {
+  current_ = (current_ + 1U) % static_cast<std::uint32_t>(arenas_.size());
+  arenas_[current_]->Reset();
+}
+
+LinearArena& FrameArena::GetCurrent() noexcept {
+  return *arenas_[current_];
+}
+
+ArenaAllocator FrameArena::GetAllocator() noexcept {
+  return ArenaAllocator{ *arenas_[current_], "FrameArena" };
+}
+
+std::uint32_t FrameArena::GetFramesInFlight() const noexcept {
+  return static_cast<std::uint32_t>(arenas_.size());
+}
+
+} // namespace maple::core
@@ -0,0 +1,72 @@
+#include "Core/FramePacer.h"
+
+// STL
+#include <algorithm>
+#include <thread>
+
+namespace maple::core {
+
+FramePacer::FramePacer(const FramePacingConfig& config) {
+  SetConfig(config);
+}
+
+double FramePacer::BeginFrame() {
+  if (!started_) {
+    started_ = true;
+    frame_start_ = Clock::now();
+    next_deadline_ = frame_start_ + period_;
+    return 0.0;
+  }
+
+  if (config_.policy == PacingPolicy::TargetFPS) {
+    WaitUntil(next_deadline_);
+
+    // Advance the deadline by whole periods to avoid drift, but do not try to
+    // catch up on frames that were already missed
+    const Clock::time_point now{ Clock::now() };
+    next_deadline_ += period_;
+    if (next_deadline_ < now) {
+      next_deadline_ = now + period_;
+    }
+  }
+
+  // Measure the time since the previous frame began
+  const Clock::time_point now{ Clock::now() };
+  delta_time_ = std::chrono::duration<double>(now - frame_start_).count();
+  frame_start_ = now;
+  return delta_time_;
+}
+
+void FramePacer::SetConfig(const FramePacingConfig& config) {
+  config_ = config;
+
+  // Clamp to a sane rate so that a bad setting cannot stall the loop
+  const double target_fps{ std::clamp(config_.target_fps, 1.0, 1000.0) };
+  period_ = std::chrono::duration_cast<Clock::duration>(
+    std::chrono::duration<double>{ 1.0 / target_fps }
+  );
+  next_deadline_ = Clock::now() + period_;
+}
+
+const FramePacingConfig& FramePacer::GetConfig() const noexcept {
+  return config_;
+}
+
+double FramePacer::GetDeltaTime() const noexcept {
+  return delta_time_;
+}
+
+void FramePacer::WaitUntil(Clock::time_point deadline) {
+  // Sleep through most of the wait, waking early enough to absorb jitter
+  const Clock::time_point sleep_until{ deadline - kSpinThreshold };
+  if (Clock::now() < sleep_until) {
+    std::this_thread::sleep_until(sleep_until);
+  }
+
+  // Spin for the remainder
+  while (Clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+}
+
+} // namespace maple::core
@@ -0,0 +1,50 @@
+#include "Core/FrameStats.h"
+
+// STL
+#include <algorithm>
+#include <numeric>
+
+namespace maple::core {
+
+void FrameStats::AddSample(double frame_time_ms) noexcept {
+  samples_[next_] = frame_time_ms;
+  next_ = (next_ + 1U) % kSampleCount;
+  count_ = std::min(count_ + 1U, kSampleCount);
+}
+
+FrameTimeSummary FrameStats::GetSummary() const {
+  if (count_ == 0U) {
+    return {};
+  }
+
+  // Work on a sorted copy so the ring keeps its order
+  std::array<double, kSampleCount> sorted{};
+  const auto begin{ sorted.begin() };
+  const auto end{ begin + static_cast<std::ptrdiff_t>(count_) };
+  std::copy_n(samples_.begin(), count_, begin);
+  std::sort(begin, end);
+
+  // Nearest-rank percentiles
+  const auto percentile{ [&](double p) {
+    const auto rank{ static_cast<std::size_t>(
+      p * static_cast<double>(count_ - 1U) + 0.5
+    ) };
+    return sorted[rank];
+  } };
+
+  return FrameTimeSummary{
+    .sample_count = count_,
+    .mean_ms = std::accumulate(begin, end, 0.0)
+               / static_cast<double>(count_),
+    .p50_ms = percentile(0.50),
+    .p99_ms = percentile(0.99),
+    .max_ms = sorted[count_ - 1U]
+  };
+}
+
+void FrameStats::Reset() noexcept {
+  next_ = 0U;
+  count_ = 0U;
+}
+
+} // namespace maple::core
@@ -0,0 +1,356 @@
+#include "Core/JobSystem.h"
+
+// STL
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+
+// Core
+#include "Core/CoreLog.h"
+#include "Core/WorkStealingDeque.h"
+
+namespace maple::core {
+
+namespace {
+
+/// Queue index of threads that do not own a deque
+constexpr std::uint32_t kNoQueue{ JobSystem::kNoThreadIndex };
+
+/// Failed job searches before a worker goes to sleep
+constexpr std::uint32_t kSpinCount{ 64U };
+
+/**
+ * @brief Shared state of the job system.
+ */
+struct JobSystemState {
+  /// One deque per job thread; index 0 belongs to the initializing thread
+  std::vector<std::unique_ptr<WorkStealingDeque<Job*>>> queues{};
+
+  /// Worker threads (queue indices 1..N)
+  std::vector<std::thread> workers{};
+
+  /// Guards the shared queue
+  std::mutex shared_mutex{};
+
+  /// Jobs scheduled from threads without a deque, or from full deques
+  std::deque<Job*> shared_queue{};
+
+  /// Number of jobs queued anywhere and not yet taken
+  std::atomic<std::uint32_t> queued_jobs{ 0U };
+
+  /// Guards sleeping workers
+  std::mutex sleep_mutex{};
+
+  /// Wakes sleeping workers when jobs are queued or on shutdown
+  std::condition_variable sleep_cv{};
+
+  /// Number of workers sleeping on sleep_cv
+  std::atomic<std::uint32_t> sleeping_workers{ 0U };
+
+  /// Whether the workers should keep running
+  std::atomic<bool> running{ false };
+};
+
+JobSystemState& GetState() {
+  static JobSystemState state{};
+  return state;
+}
+
+/// Deque index of the calling thread
+thread_local std::uint32_t t_queue_index{ kNoQueue };
+
+/**
+ * @brief Xorshift generator for picking steal victims.
+ */
+std::uint32_t NextRandom() {
+  thread_local std::uint32_t seed{ static_cast<std::uint32_t>(
+    std::hash<std::thread::id>{}(std::this_thread::get_id())
+  ) | 1U };
+  seed ^= seed << 13U;
+  seed ^= seed >> 17U;
+  seed ^= seed << 5U;
+  return seed;
+}
+
+/**
+ * @brief Find a job: own deque first, then the shared queue, then steal.
+ *
+ * @return Job, or null if none was found
+ */
+Job* FindJob(JobSystemState& state) {
+  Job* job{ nullptr };
+
+  // Newest job of this thread's own deque
+  const std::uint32_t own_index{ t_queue_index };
+  if (own_index != kNoQueue && state.queues[own_index]->Pop(job)) {
+    state.queued_jobs.fetch_sub(1U);
+    return job;
+  }
+
+  // Oldest job of the shared queue
+  {
+    std::lock_guard lock{ state.shared_mutex };
+    if (!state.shared_queue.empty()) {
+      job = state.shared_queue.front();
+      state.shared_queue.pop_front();
+      state.queued_jobs.fetch_sub(1U);
+      return job;
+    }
+  }
+
+  // Oldest job of another thread, starting at a random victim
+  const auto queue_count{ static_cast<std::uint32_t>(state.queues.size()) };
+  const std::uint32_t start{ NextRandom() % queue_count };
+  for (std::uint32_t i{ 0U }; i < queue_count; ++i) {
+    const std::uint32_t victim{ (start + i) % queue_count };
+    if (victim != own_index && state.queues[victim]->Steal(job)) {
+      state.queued_jobs.fetch_sub(1U);
+      return job;
+    }
+  }
+
+  return nullptr;
+}
+
+/**
+ * @brief Run a job and signal its counter.
+ */
+void Execute(Job& job) {
+  JobCounter* counter{ job.counter };
+  job.function(job);
+
+  // Recycle the job before signaling, which may schedule more jobs
+  if (job.heap_allocated) {
+    delete &job;
+  } else {
+    job.in_use.store(false, std::memory_order_release);
+  }
+
+  if (counter) {
+    counter->Decrement();
+  }
+}
+
+/**
+ * @brief Worker thread entry point.
+ */
+void WorkerLoop(std::uint32_t queue_index) {
+  JobSystemState& state{ GetState() };
+  t_queue_index = queue_index;
+  MAPLE_PROFILE_THREAD("Worker " + std::to_string(queue_index));
+
+  std::uint32_t failed_searches{ 0U };
+  while (state.running.load(std::memory_order_relaxed)) {
+    if (Job* job{ FindJob(state) }) {
+      Execute(*job);
+      failed_searches = 0U;
+      continue;
+    }
+
+    // Spin briefly before sleeping, since new work often follows quickly
+    if (++failed_searches < kSpinCount) {
+      std::this_thread::yield();
+      continue;
+    }
+    failed_searches = 0U;
+
+    std::unique_lock lock{ state.sleep_mutex };
+    state.sleeping_workers.fetch_add(1U);
+    state.sleep_cv.wait(lock, [&state] {
+      return state.queued_jobs.load() > 0U || !state.running.load();
+    });
+    state.sleeping_workers.fetch_sub(1U);
+  }
+
+  t_queue_index = kNoQueue;
+}
+
+} // namespace
+
+JobCounter::JobCounter(std::uint32_t initial_value) noexcept
+  : value_{ initial_value } {}
+
+JobCounter::~JobCounter() {
+  // Wait for a concurrent Decrement() to release the lock
+  std::lock_guard lock{ mutex_ };
+}
+
+void JobCounter::Add(std::uint32_t count) noexcept {
+  value_.fetch_add(count, std::memory_order_relaxed);
+}
+
+void JobCounter::Decrement() {
+  // Fast path: not the last job, so nobody can be released
+  std::uint32_t value{ value_.load(std::memory_order_relaxed) };
+  while (value > 1U) {
+    if (value_.compare_exchange_weak(value, value - 1U,
+                                     std::memory_order_acq_rel)) {
+      return;
+    }
+  }
+
+  // Possibly the last job: reach zero under the lock so that waiters are
+  // never missed and the counter is not destroyed while it is still in use
+  std::vector<std::coroutine_handle<>> waiters{};
+  {
+    std::lock_guard lock{ mutex_ };
+    if (value_.fetch_sub(1U, std::memory_order_acq_rel) != 1U) {
+      return;
+    }
+    waiters.swap(waiters_);
+  }
+
+  for (const std::coroutine_handle<> waiter : waiters) {
+    JobSystem::Schedule([waiter] { waiter.resume(); });
+  }
+}
+
+bool JobCounter::IsDone() const noexcept {
+  if (value_.load(std::memory_order_acquire) != 0U) {
+    return false;
+  }
+
+  // Synchronize with the Decrement() that reached zero
+  std::lock_guard lock{ mutex_ };
+  return true;
+}
+
+bool JobCounter::AddWaiter(std::coroutine_handle<> handle) {
+  std::lock_guard lock{ mutex_ };
+  if (value_.load(std::memory_order_acquire) == 0U) {
+    return false;
+  }
+  waiters_.emplace_back(handle);
+  return true;
+}
+
+void JobSystem::Initialize(std::uint32_t worker_count) {
+  JobSystemState& state{ GetState() };
+  if (state.running.load()) {
+    return;
+  }
+
+  // One worker per hardware thread besides this one
+  if (worker_count == 0U) {
+    const std::uint32_t hardware_threads{ std::thread::hardware_concurrency() };
+    worker_count = hardware_threads > 1U ? hardware_threads - 1U : 1U;
+  }
+
+  // Create a deque for this thread and every worker
+  state.queues.clear();
+  for (std::uint32_t i{ 0U }; i <= worker_count; ++i) {
+    state.queues.emplace_back(
+      std::make_unique<WorkStealingDeque<Job*>>(kMaxJobsPerThread)
+    );
+  }
+  t_queue_index = 0U;
+
+  // Start the workers
+  state.running.store(true);
+  for (std::uint32_t i{ 1U }; i <= worker_count; ++i) {
+    state.workers.emplace_back(WorkerLoop, i);
+  }
+
+  MAPLE_LOG_INFO(LogCore, "Job system started with {} worker thread(s)",
+                 worker_count);
+}
+
+void JobSystem::Shutdown() {
+  JobSystemState& state{ GetState() };
+  if (!state.running.load()) {
+    return;
+  }
+
+  // Wake and join the workers
+  {
+    std::lock_guard lock{ state.sleep_mutex };
+    state.running.store(false);
+  }
+  state.sleep_cv.notify_all();
+  for (std::thread& worker : state.workers) {
+    worker.join();
+  }
+  state.workers.clear();
+
+  // Run anything that was left behind
+  while (Job* job{ FindJob(state) }) {
+    Execute(*job);
+  }
+  state.queues.clear();
+  t_queue_index = kNoQueue;
+
+  MAPLE_LOG_INFO(LogCore, "Job system stopped");
+}
+
+std::uint32_t JobSystem::GetThreadCount() noexcept {
+  JobSystemState& state{ GetState() };
+  return state.running.load()
+           ? static_cast<std::uint32_t>(state.workers.size()) + 1U
+           : 1U;
+}
+
+std::uint32_t JobSystem::GetThreadIndex() noexcept {
+  return t_queue_index;
+}
+
+void JobSystem::Wait(const JobCounter& counter) {
+  JobSystemState& state{ GetState() };
+  while (!counter.IsDone()) {
+    Job* job{ state.running.load(std::memory_order_relaxed) ? FindJob(state)
+                                                            : nullptr };
+    if (job) {
+      Execute(*job);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+Job& JobSystem::AllocateJob() {
+  // Slots are recycled in order; if the next one is still pending, this
+  // thread has too many jobs in flight and the job goes to the heap instead
+  thread_local std::unique_ptr<Job[]> jobs{
+    std::make_unique<Job[]>(kMaxJobsPerThread)
+  };
+  thread_local std::size_t next_job{ 0U };
+
+  Job& job{ jobs[next_job++ & (kMaxJobsPerThread - 1U)] };
+  if (job.in_use.load(std::memory_order_acquire)) {
+    Job* heap_job{ new Job{} };
+    heap_job->heap_allocated = true;
+    return *heap_job;
+  }
+  job.in_use.store(true, std::memory_order_relaxed);
+  return job;
+}
+
+void JobSystem::Submit(Job& job) {
+  JobSystemState& state{ GetState() };
+  if (!state.running.load(std::memory_order_relaxed)) {
+    Execute(job);
+    return;
+  }
+
+  // Count the job before publishing it so the count never goes negative
+  state.queued_jobs.fetch_add(1U);
+
+  // Prefer this thread's deque; fall back to the shared queue
+  const std::uint32_t queue_index{ t_queue_index };
+  if (queue_index == kNoQueue || !state.queues[queue_index]->Push(&job)) {
+    std::lock_guard lock{ state.shared_mutex };
+    state.shared_queue.emplace_back(&job);
+  }
+
+  // Wake a sleeping worker. Workers register as sleeping before checking
+  // for queued jobs, so either they see this job or this sees them.
+  if (state.sleeping_workers.load() > 0U) {
+    {
+      std::lock_guard lock{ state.sleep_mutex };
+    }
+    state.sleep_cv.notify_one();
+  }
+}
+
+} // namespace maple::core
@@ -0,0 +1,133 @@
+#include "Core/LinearArena.h"
+
+// STL
+#include <algorithm>
+#include <new>
+
+// Core
+#include "Core/CoreLog.h"
+
+namespace maple::core {
+
+LinearArena::LinearArena(std::size_t capacity, const char* name)
+  : name_{ name }
+  , block_{ std::make_unique<std::byte[]>(capacity) }
+  , capacity_{ capacity } {}
+
+LinearArena::~LinearArena() = default;
+
+void LinearArena::Reset() {
+  // Record the usage of the frame that is ending
+  const std::size_t overflow_bytes{
+    overflow_bytes_.load(std::memory_order_relaxed)
+  };
+  const std::size_t used{ GetUsed() };
+  peak_ = std::max(peak_, used);
+
+  // Overflow means the block is too small for a typical frame
+  if (overflow_bytes > 0U) {
+    MAPLE_LOG_WARN(LogCore, "{} overflowed by {} bytes ({} of {} bytes "
+                            "used); consider increasing its capacity",
+                   name_, overflow_bytes, used, capacity_);
+  }
+
+  // Release everything at once
+  {
+    std::lock_guard lock{ overflow_mutex_ };
+    overflow_blocks_.clear();
+  }
+  overflow_bytes_.store(0U, std::memory_order_relaxed);
+  offset_.store(0U, std::memory_order_relaxed);
+}
+
+std::size_t LinearArena::GetCapacity() const noexcept {
+  return capacity_;
+}
+
+std::size_t LinearArena::GetUsed() const noexcept {
+  return std::min(offset_.load(std::memory_order_relaxed), capacity_)
+         + overflow_bytes_.load(std::memory_order_relaxed);
+}
+
+std::size_t LinearArena::GetPeak() const noexcept {
+  return peak_;
+}
+
+void* LinearArena::AllocateOverflow(std::size_t size, std::size_t alignment) {
+  // Over-allocate so the result can be aligned within the block
+  auto block{ std::make_unique<std::byte[]>(size + alignment - 1U) };
+  const auto address{ reinterpret_cast<std::uintptr_t>(block.get()) };
+  const std::uintptr_t aligned{
+    (address + alignment - 1U) & ~(std::uintptr_t{ alignment } - 1U)
+  };
+
+  std::lock_guard lock{ overflow_mutex_ };
+  overflow_blocks_.emplace_back(std::move(block));
+  overflow_bytes_.fetch_add(size, std::memory_order_relaxed);
+  return reinterpret_cast<void*>(aligned);
+}
+
+ArenaAllocator::ArenaAllocator(const char* name) noexcept
+  : name_{ name } {}
+
+ArenaAllocator::ArenaAllocator(LinearArena& arena, const char* name) noexcept
+  : arena_{ &arena }
+  , name_{ name } {}
+
+ArenaAllocator::ArenaAllocator(const ArenaAllocator& other,
+                               const char* name) noexcept
+  : arena_{ other.arena_ }
+  , name_{ name } {}
+
+void* ArenaAllocator::allocate(std::size_t n, [[maybe_unused]] int flags) {
+  if (!arena_) {
+    throw std::bad_alloc{};
+  }
+  return arena_->Allocate(n);
+}
+
+void* ArenaAllocator::allocate(std::size_t n, std::size_t alignment,
+                               std::size_t offset,
+                               [[maybe_unused]] int flags) {
+  if (!arena_) {
+    throw std::bad_alloc{};
+  }
+  if (offset == 0U) {
+    return arena_->Allocate(n, alignment);
+  }
+
+  // Align (pointer + offset) rather than the pointer itself
+  const auto address{
+    reinterpret_cast<std::uintptr_t>(arena_->Allocate(n + alignment, 1U))
+  };
+  const std::uintptr_t aligned{
+    ((address + offset + alignment - 1U) & ~(std::uintptr_t{ alignment } - 1U))
+    - offset
+  };
+  return reinterpret_cast<void*>(aligned);
+}
+
+void ArenaAllocator::deallocate([[maybe_unused]] void* p,
+                                [[maybe_unused]] std::size_t n) noexcept {}
+
+const char* ArenaAllocator::get_name() const noexcept {
+  return name_;
+}
+
+void ArenaAllocator::set_name(const char* name) noexcept {
+  name_ = name;
+}
+
+LinearArena* ArenaAllocator::GetArena() const noexcept {
+  return arena_;
+}
+
+bool operator==(const ArenaAllocator& a, const ArenaAllocator& b) noexcept {
+  return a.GetArena() == b.GetArena();
+}
+
+bool operator!=(const ArenaAllocator& a, const ArenaAllocator& b) noexcept {
+  return !(a == b);
+}
+
+} // namespace maple::core
@@ -1,25 +1,90 @@
 #include "Core/Log.h"
 
+// STL
+#include <mutex>
+
 // spdlog
 #include "spdlog/sinks/stdout_color_sinks.h"
 
+// Core
+#include "Core/AsyncLogSink.h"
+
 namespace maple::core {
 
-void Log::Initialize() {
+namespace {
+
+/// Shared asynchronous sink (null in synchronous mode)
+std::shared_ptr<AsyncLogSink> async_sink{ nullptr };
+
+/// Guards async_sink against concurrent category creation
+std::mutex async_sink_mutex{};
+
+} // namespace
+
+void Log::Initialize(const LogConfig& config) {
   // Configure the global runtime log level based on build configuration
 #ifdef NDEBUG
   spdlog::set_level(spdlog::level::info);
 #else
   spdlog::set_level(spdlog::level::debug);
 #endif
+
+#ifdef MAPLE_LOG_BINARY
+  // Open the binary log file for deferred-format events
+  BinaryLog::Initialize(config.binary_log_path);
+#endif
+
+  if (config.mode != LogMode::Asynchronous) {
+    return;
+  }
+
+  // Create the shared queue in front of a single console sink
+  std::lock_guard lock{ async_sink_mutex };
+  async_sink = std::make_shared<AsyncLogSink>(
+    std::make_shared<spdlog::sinks::stdout_color_sink_mt>(),
+    config.queue_capacity, config.overflow_policy
+  );
+
+  // Reroute categories that were created before initialization
+  spdlog::apply_all([](const std::shared_ptr<spdlog::logger>& logger) {
+    logger->sinks().assign(1U, async_sink);
+  });
+
+  // Drain the queue on severe messages so they survive a crash or exception
+  spdlog::flush_on(spdlog::level::err);
 }
 
 void Log::Shutdown() {
+#ifdef MAPLE_LOG_BINARY
+  // Write all pending binary events and close the binary log file
+  BinaryLog::Shutdown();
+#endif
+
+  // Drain the asynchronous queue before tearing down the loggers
+  {
+    std::lock_guard lock{ async_sink_mutex };
+    if (async_sink) {
+      async_sink->Stop();
+    }
+  }
+
   // Flush all loggers and clean up background threads
   spdlog::shutdown();
+
+  std::lock_guard lock{ async_sink_mutex };
+  async_sink.reset();
 }
 
 LogCategory::LogCategory(const std::string& name)
-  : logger{ spdlog::stdout_color_mt(name) } {}
+  : logger{ [&name]() -> std::shared_ptr<spdlog::logger> {
+      // Attach to the asynchronous queue if the logging system already uses it
+      std::lock_guard lock{ async_sink_mutex };
+      if (async_sink) {
+        auto async_logger{ std::make_shared<spdlog::logger>(name, async_sink) };
+        spdlog::initialize_logger(async_logger);
+        return async_logger;
+      }
+      return spdlog::stdout_color_mt(name);
+    }() } {}
 
 } // namespace maple::core
@@ -0,0 +1,326 @@
+#include "Core/Memory.h"
+
+// STL
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+// Core
+#include "Core/CoreLog.h"
+#include "Core/PoolAllocator.h"
+
+namespace maple::core {
+
+namespace {
+
+/**
+ * @brief Header stored in the 16 bytes preceding every allocation.
+ */
+struct AllocationHeader {
+  /// Requested size in bytes
+  std::uint64_t size;
+
+  /// Tag charged for the allocation
+  MemoryTag tag;
+
+  /// Size class index, or one of the special sources below
+  std::uint8_t source;
+
+  /// Distance from the start of the underlying block to the payload
+  std::uint32_t offset;
+};
+static_assert(sizeof(AllocationHeader) == 16U);
+
+/// Alignment of every payload, and the header size
+constexpr std::size_t kHeaderSize{ 16U };
+
+/// Pool block sizes (header included); must be multiples of 16
+constexpr std::array<std::size_t, 9U> kSizeClasses{
+  32U, 48U, 64U, 96U, 128U, 192U, 256U, 384U, 512U
+};
+
+/// Largest block served by a pool
+constexpr std::size_t kMaxPooledSize{ kSizeClasses.back() };
+
+/// Blocks allocated at once when a size-class pool grows
+constexpr std::size_t kBlocksPerPage{ 256U };
+
+/// Source markers for allocations not served by a pool
+constexpr std::uint8_t kSourceHeap{ 0xFEU };
+constexpr std::uint8_t kSourceSystem{ 0xFFU };
+
+/// Size of every pool added to the TLSF heap
+constexpr std::size_t kHeapPoolSize{ 16U * 1024U * 1024U };
+
+/// Requests above this are served by the system instead of the TLSF heap
+constexpr std::size_t kMaxHeapSize{ kHeapPoolSize / 4U };
+
+/// Number of tags tracked
+constexpr std::size_t kTagCount{ static_cast<std::size_t>(MemoryTag::Count) };
+
+/**
+ * @brief Map a total block size to the smallest size class that fits it.
+ */
+constexpr std::array<std::uint8_t, kMaxPooledSize / 16U + 1U>
+BuildSizeClassTable() {
+  std::array<std::uint8_t, kMaxPooledSize / 16U + 1U> table{};
+  std::uint8_t size_class{ 0U };
+  for (std::size_t i{ 0U }; i < table.size(); ++i) {
+    while (kSizeClasses[size_class] < i * 16U) {
+      ++size_class;
+    }
+    table[i] = size_class;
+  }
+  return table;
+}
+constexpr auto kSizeClassTable{ BuildSizeClassTable() };
+
+/**
+ * @brief Size-class pool with its own lock.
+ */
+struct SizeClass {
+  explicit SizeClass(std::size_t block_size)
+    : pool{ block_size, kBlocksPerPage } {}
+
+  std::mutex mutex{};
+  PoolAllocator pool;
+};
+
+/**
+ * @brief Per-tag counters.
+ */
+struct TagCounters {
+  std::atomic<std::size_t> current_bytes{ 0U };
+  std::atomic<std::size_t> peak_bytes{ 0U };
+  std::atomic<std::size_t> live_allocations{ 0U };
+  std::atomic<std::size_t> total_allocations{ 0U };
+  std::atomic<std::size_t> budget_bytes{ 0U };
+};
+
+/**
+ * @brief Shared state of the tagged heap.
+ */
+struct MemoryState {
+  MemoryState() {
+    for (std::size_t i{ 0U }; i < kSizeClasses.size(); ++i) {
+      size_classes[i].emplace(kSizeClasses[i]);
+    }
+  }
+
+  /// One pool per size class
+  std::array<std::optional<SizeClass>, kSizeClasses.size()> size_classes{};
+
+  /// Guards the TLSF heap and its pools
+  std::mutex heap_mutex{};
+
+  /// General-purpose heap for medium and over-aligned requests
+  TLSFAllocator heap{};
+
+  /// Memory backing the heap's pools
+  std::vector<std::unique_ptr<std::byte[]>> heap_pools{};
+
+  /// Counters of every tag
+  std::array<TagCounters, kTagCount> tags{};
+};
+
+MemoryState& GetState() {
+  // Leaked on purpose: tracked objects may be freed during static destruction
+  static MemoryState* state{ new MemoryState{} };
+  return *state;
+}
+
+/**
+ * @brief Allocate a block from the TLSF heap, growing it if necessary.
+ *
+ * @return Block, or null if the system is out of memory
+ */
+void* AllocateFromHeap(MemoryState& state, std::size_t size) {
+  std::lock_guard lock{ state.heap_mutex };
+  if (void* block{ state.heap.Allocate(size) }) {
+    return block;
+  }
+
+  // Grow the heap by one pool and retry
+  auto pool{ std::make_unique_for_overwrite<std::byte[]>(kHeapPoolSize) };
+  if (!state.heap.AddPool(pool.get(), kHeapPoolSize)) {
+    return nullptr;
+  }
+  state.heap_pools.emplace_back(std::move(pool));
+  MAPLE_LOG_DEBUG(LogCore, "Memory heap grown to {} pool(s)",
+                  state.heap_pools.size());
+  return state.heap.Allocate(size);
+}
+
+/**
+ * @brief Charge an allocation to a tag, warning when its budget is crossed.
+ */
+void Track(TagCounters& counters, MemoryTag tag, std::size_t size) {
+  const std::size_t previous{
+    counters.current_bytes.fetch_add(size, std::memory_order_relaxed)
+  };
+  const std::size_t current{ previous + size };
+  counters.live_allocations.fetch_add(1U, std::memory_order_relaxed);
+  counters.total_allocations.fetch_add(1U, std::memory_order_relaxed);
+
+  // Raise the peak
+  std::size_t peak{ counters.peak_bytes.load(std::memory_order_relaxed) };
+  while (current > peak
+         && !counters.peak_bytes.compare_exchange_weak(
+           peak, current, std::memory_order_relaxed
+         )) {}
+
+  const std::size_t budget{
+    counters.budget_bytes.load(std::memory_order_relaxed)
+  };
+  if (budget > 0U && previous <= budget && current > budget) {
+    MAPLE_LOG_WARN(LogCore, "{} memory over budget: {} of {} bytes",
+                   GetMemoryTagName(tag), current, budget);
+  }
+}
+
+} // namespace
+
+const char* GetMemoryTagName(MemoryTag tag) noexcept {
+  switch (tag) {
+    case MemoryTag::General: {
+      return "General";
+    }
+
+    case MemoryTag::Application: {
+      return "Application";
+    }
+
+    case MemoryTag::Platform: {
+      return "Platform";
+    }
+
+    case MemoryTag::Renderer: {
+      return "Renderer";
+    }
+
+    case MemoryTag::RHI: {
+      return "RHI";
+    }
+
+    case MemoryTag::ECS: {
+      return "ECS";
+    }
+
+    default: {
+      return "Unknown";
+    }
+  }
+}
+
+void* Memory::Allocate(std::size_t size, std::size_t alignment,
+                       MemoryTag tag) {
+  MemoryState& state{ GetState() };
+  alignment = std::max(alignment, kHeaderSize);
+
+  // Leave room for the header, plus slack to align over-aligned payloads
+  const std::size_t padding{
+    alignment > kHeaderSize ? alignment : std::size_t{ 0U }
+  };
+  const std::size_t total{ size + kHeaderSize + padding };
+  if (total < size) {
+    throw std::bad_alloc{};
+  }
+
+  void* block{ nullptr };
+  std::uint8_t source{ 0U };
+  if (total <= kMaxPooledSize) {
+    source = kSizeClassTable[(total + 15U) / 16U];
+    SizeClass& size_class{ *state.size_classes[source] };
+    std::lock_guard lock{ size_class.mutex };
+    block = size_class.pool.Allocate();
+  } else if (total <= kMaxHeapSize) {
+    source = kSourceHeap;
+    block = AllocateFromHeap(state, total);
+  } else {
+    source = kSourceSystem;
+    block = std::malloc(total);
+  }
+  if (!block) {
+    throw std::bad_alloc{};
+  }
+
+  // Place the payload after the header at the requested alignment
+  const auto base{ reinterpret_cast<std::uintptr_t>(block) };
+  const std::uintptr_t payload{
+    (base + kHeaderSize + alignment - 1U) & ~(std::uintptr_t{ alignment } - 1U)
+  };
+  auto* header{ reinterpret_cast<AllocationHeader*>(payload - kHeaderSize) };
+  header->size = size;
+  header->tag = tag;
+  header->source = source;
+  header->offset = static_cast<std::uint32_t>(payload - base);
+
+  Track(state.tags[static_cast<std::size_t>(tag)], tag, size);
+  return reinterpret_cast<void*>(payload);
+}
+
+void Memory::Free(void* ptr) noexcept {
+  if (!ptr) {
+    return;
+  }
+
+  MemoryState& state{ GetState() };
+  const auto payload{ reinterpret_cast<std::uintptr_t>(ptr) };
+  const auto* header{
+    reinterpret_cast<const AllocationHeader*>(payload - kHeaderSize)
+  };
+  void* block{ reinterpret_cast<void*>(payload - header->offset) };
+
+  // Release the charge before the header becomes invalid
+  TagCounters& counters{ state.tags[static_cast<std::size_t>(header->tag)] };
+  counters.current_bytes.fetch_sub(header->size, std::memory_order_relaxed);
+  counters.live_allocations.fetch_sub(1U, std::memory_order_relaxed);
+
+  const std::uint8_t source{ header->source };
+  if (source == kSourceSystem) {
+    std::free(block);
+  } else if (source == kSourceHeap) {
+    std::lock_guard lock{ state.heap_mutex };
+    state.heap.Free(block);
+  } else {
+    SizeClass& size_class{ *state.size_classes[source] };
+    std::lock_guard lock{ size_class.mutex };
+    size_class.pool.Free(block);
+  }
+}
+
+void Memory::SetBudget(MemoryTag tag, std::size_t budget_bytes) noexcept {
+  GetState().tags[static_cast<std::size_t>(tag)].budget_bytes.store(
+    budget_bytes, std::memory_order_relaxed
+  );
+}
+
+MemoryStats Memory::GetStats(MemoryTag tag) noexcept {
+  const TagCounters& counters{
+    GetState().tags[static_cast<std::size_t>(tag)]
+  };
+  return MemoryStats{
+    .current_bytes = counters.current_bytes.load(std::memory_order_relaxed),
+    .peak_bytes = counters.peak_bytes.load(std::memory_order_relaxed),
+    .live_allocations = counters.live_allocations.load(
+      std::memory_order_relaxed
+    ),
+    .total_allocations = counters.total_allocations.load(
+      std::memory_order_relaxed
+    ),
+    .budget_bytes = counters.budget_bytes.load(std::memory_order_relaxed)
+  };
+}
+
+TLSFStats Memory::GetHeapStats() noexcept {
+  MemoryState& state{ GetState() };
+  std::lock_guard lock{ state.heap_mutex };
+  return state.heap.GetStats();
+}
+
+} // namespace maple::core
@@ -0,0 +1,72 @@
+#include "Core/PoolAllocator.h"
+
+// STL
+#include <algorithm>
+#include <cstdint>
+
+namespace maple::core {
+
+PoolAllocator::PoolAllocator(std::size_t block_size,
+                             std::size_t blocks_per_page)
+  : block_size_{ (std::max(block_size, sizeof(FreeBlock)) + kBlockAlignment - 1U)
+                 & ~(kBlockAlignment - 1U) }
+  , blocks_per_page_{ std::max(blocks_per_page, std::size_t{ 1U }) } {}
+
+PoolAllocator::~PoolAllocator() = default;
+
+void* PoolAllocator::Allocate() {
+  if (!free_list_) {
+    AddPage();
+  }
+
+  // Pop the head of the free list
+  FreeBlock* block{ free_list_ };
+  free_list_ = block->next;
+  ++used_blocks_;
+  return block;
+}
+
+void PoolAllocator::Free(void* block) noexcept {
+  if (!block) {
+    return;
+  }
+
+  // Push the block onto the free list
+  auto* free_block{ static_cast<FreeBlock*>(block) };
+  free_block->next = free_list_;
+  free_list_ = free_block;
+  --used_blocks_;
+}
+
+std::size_t PoolAllocator::GetBlockSize() const noexcept {
+  return block_size_;
+}
+
+std::size_t PoolAllocator::GetUsedBlocks() const noexcept {
+  return used_blocks_;
+}
+
+std::size_t PoolAllocator::GetReservedBytes() const noexcept {
+  return pages_.size() * block_size_ * blocks_per_page_;
+}
+
+void PoolAllocator::AddPage() {
+  // Over-allocate so the first block can be aligned
+  auto& page{ pages_.emplace_back(
+    std::make_unique<std::byte[]>(block_size_ * blocks_per_page_
+                                  + kBlockAlignment - 1U)
+  ) };
+  const auto address{ reinterpret_cast<std::uintptr_t>(page.get()) };
+  auto* first{ reinterpret_cast<std::byte*>(
+    (address + kBlockAlignment - 1U) & ~(kBlockAlignment - 1U)
+  ) };
+
+  // Thread the page's blocks onto the free list in address order
+  for (std::size_t i{ blocks_per_page_ }; i > 0U; --i) {
+    auto* block{ reinterpret_cast<FreeBlock*>(first + (i - 1U) * block_size_) };
+    block->next = free_list_;
+    free_list_ = block;
+  }
+}
+
+} // namespace maple::core
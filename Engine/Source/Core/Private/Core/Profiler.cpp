@@ -0,0 +1,341 @@
+#include "Core/Profiler.h"
+
+// STL
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Core
+#include "Core/CoreLog.h"
+
+namespace maple::core {
+
+namespace {
+
+/**
+ * @brief Recorded zone; fields are atomic so a trace can be written while
+ *        the owning thread keeps overwriting old zones.
+ */
+struct ZoneEvent {
+  std::atomic<const char*> category{ nullptr };
+  std::atomic<const char*> name{ nullptr };
+  std::atomic<std::int64_t> start_ns{ 0 };
+  std::atomic<std::int64_t> end_ns{ 0 };
+};
+
+/**
+ * @brief Zone ring owned by one thread.
+ */
+struct ThreadEvents {
+  /// Ring storage
+  std::unique_ptr<ZoneEvent[]> events{
+    std::make_unique<ZoneEvent[]>(Profiler::kEventsPerThread)
+  };
+
+  /// Engine-assigned thread index, used as the trace thread ID
+  std::uint32_t thread_index{ 0U };
+
+  /// Display name (guarded by ProfilerState::mutex)
+  std::string name{};
+
+  /// Total zones recorded by the owning thread
+  std::atomic<std::uint64_t> head{ 0U };
+
+  /// Whether the owning thread has exited (guarded by ProfilerState::mutex)
+  bool retired{ false };
+};
+
+/**
+ * @brief Shared state of the profiler.
+ */
+struct ProfilerState {
+  /// Whether zones are recorded
+  std::atomic<bool> enabled{ true };
+
+  /// Guards the thread list and thread names
+  std::mutex mutex{};
+
+  /// Rings of all live threads that have recorded, of exited threads whose
+  /// zones have not been written to a trace yet, and of all tracks
+  std::vector<std::shared_ptr<ThreadEvents>> threads{};
+
+  /// Trace thread ID of the next ring; IDs are not reused, so a trace never
+  /// merges two threads
+  std::uint32_t next_thread_index{ 0U };
+
+  /// Rings of the tracks, indexed by track; an entry is written once
+  /// under mutex, before track_count publishes it
+  std::array<std::shared_ptr<ThreadEvents>, Profiler::kMaxTracks> tracks{};
+
+  /// Number of tracks created; incremented under mutex with release order
+  /// once the new entry of tracks has been filled, so recording threads may
+  /// read the published entries without locking
+  std::atomic<std::uint32_t> track_count{ 0U };
+};
+
+ProfilerState& GetState() {
+  static ProfilerState state{};
+  return state;
+}
+
+/**
+ * @brief Owner of a thread's ring, which retires the ring when the thread
+ *        exits.
+ *
+ * A retired ring is released by the next WriteChromeTrace(), once its zones
+ * have been written, or right away if it holds none.
+ */
+struct ThreadEventsOwner {
+  ThreadEventsOwner() {
+    ProfilerState& state{ GetState() };
+    std::lock_guard lock{ state.mutex };
+    events->thread_index = state.next_thread_index++;
+    events->name = "Thread " + std::to_string(events->thread_index);
+    state.threads.emplace_back(events);
+  }
+
+  ThreadEventsOwner(const ThreadEventsOwner&) = delete;
+  ThreadEventsOwner& operator=(const ThreadEventsOwner&) = delete;
+  ThreadEventsOwner(ThreadEventsOwner&&) = delete;
+  ThreadEventsOwner& operator=(ThreadEventsOwner&&) = delete;
+
+  ~ThreadEventsOwner() {
+    ProfilerState& state{ GetState() };
+    std::lock_guard lock{ state.mutex };
+    events->retired = true;
+    if (events->head.load(std::memory_order_relaxed) == 0U) {
+      std::erase(state.threads, events);
+    }
+  }
+
+  /// Ring of the owning thread
+  std::shared_ptr<ThreadEvents> events{ std::make_shared<ThreadEvents>() };
+};
+
+/**
+ * @brief Get the calling thread's ring, creating it on first use.
+ */
+ThreadEvents& GetThreadEvents() {
+  thread_local ThreadEventsOwner owner{};
+  return *owner.events;
+}
+
+/**
+ * @brief Append a zone to a ring, overwriting the oldest one.
+ */
+void RecordZone(ThreadEvents& events, const char* category, const char* name,
+                std::int64_t start_ns, std::int64_t end_ns) noexcept {
+  const std::uint64_t head{ events.head.load(std::memory_order_relaxed) };
+  ZoneEvent& event{ events.events[head % Profiler::kEventsPerThread] };
+  event.category.store(category, std::memory_order_relaxed);
+  event.name.store(name, std::memory_order_relaxed);
+  event.start_ns.store(start_ns, std::memory_order_relaxed);
+  event.end_ns.store(end_ns, std::memory_order_relaxed);
+  events.head.store(head + 1U, std::memory_order_release);
+}
+
+/**
+ * @brief Write a string as a JSON string literal.
+ */
+void WriteJsonString(std::ostream& out, std::string_view text) {
+  out << '"';
+  for (const char c : text) {
+    switch (c) {
+      case '"': {
+        out << "\\\"";
+        break;
+      }
+
+      case '\\': {
+        out << "\\\\";
+        break;
+      }
+
+      case '\n': {
+        out << "\\n";
+        break;
+      }
+
+      default: {
+        // Other control characters have no short escape
+        const auto byte{ static_cast<unsigned char>(c) };
+        if (byte < 0x20U) {
+          constexpr char kHexDigits[]{ "0123456789abcdef" };
+          out << "\\u00" << kHexDigits[byte >> 4U] << kHexDigits[byte & 0xFU];
+        } else {
+          out << c;
+        }
+        break;
+      }
+    }
+  }
+  out << '"';
+}
+
+} // namespace
+
+void Profiler::SetEnabled(bool enabled) noexcept {
+  GetState().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::IsEnabled() noexcept {
+  return GetState().enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+  ThreadEvents& events{ GetThreadEvents() };
+  std::lock_guard lock{ GetState().mutex };
+  events.name = name;
+}
+
+std::int64_t Profiler::Now() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()
+  ).count();
+}
+
+void Profiler::Record(const char* category, const char* name,
+                      std::int64_t start_ns, std::int64_t end_ns) noexcept {
+  RecordZone(GetThreadEvents(), category, name, start_ns, end_ns);
+}
+
+std::uint32_t Profiler::CreateTrack(const std::string& name) {
+  ProfilerState& state{ GetState() };
+  std::lock_guard lock{ state.mutex };
+  const std::uint32_t track{
+    state.track_count.load(std::memory_order_relaxed)
+  };
+  if (track == kMaxTracks) {
+    throw std::runtime_error{ "Profiler track limit reached: " + name };
+  }
+
+  // Tracks share the trace thread IDs of the threads
+  auto events{ std::make_shared<ThreadEvents>() };
+  events->thread_index = state.next_thread_index++;
+  events->name = name;
+  state.threads.emplace_back(events);
+  state.tracks[track] = std::move(events);
+  state.track_count.store(track + 1U, std::memory_order_release);
+  return track;
+}
+
+void Profiler::RecordOnTrack(std::uint32_t track, const char* category,
+                             const char* name, std::int64_t start_ns,
+                             std::int64_t end_ns) noexcept {
+  // Ignore tracks that were never created
+  const ProfilerState& state{ GetState() };
+  if (track >= state.track_count.load(std::memory_order_acquire)) {
+    return;
+  }
+  RecordZone(*state.tracks[track], category, name, start_ns, end_ns);
+}
+
+void Profiler::WriteChromeTrace(const std::string& path) {
+  std::ofstream out{ path };
+  if (!out) {
+    throw std::runtime_error{ "Failed to open trace file: " + path };
+  }
+
+  ProfilerState& state{ GetState() };
+  std::lock_guard lock{ state.mutex };
+
+  // Timestamps are written relative to the earliest recorded zone
+  struct Zone {
+    const char* category;
+    const char* name;
+    std::int64_t start_ns;
+    std::int64_t end_ns;
+  };
+  std::vector<std::pair<const ThreadEvents*, std::vector<Zone>>> threads{};
+  std::int64_t origin_ns{ std::numeric_limits<std::int64_t>::max() };
+  for (const auto& thread : state.threads) {
+    // Copy the retained zones
+    const std::uint64_t head{ thread->head.load(std::memory_order_acquire) };
+    const std::uint64_t count{ std::min<std::uint64_t>(head, kEventsPerThread) };
+    std::vector<Zone> zones{};
+    zones.reserve(count);
+    for (std::uint64_t i{ head - count }; i < head; ++i) {
+      const ZoneEvent& event{ thread->events[i % kEventsPerThread] };
+      zones.emplace_back(Zone{
+        event.category.load(std::memory_order_relaxed),
+        event.name.load(std::memory_order_relaxed),
+        event.start_ns.load(std::memory_order_relaxed),
+        event.end_ns.load(std::memory_order_relaxed)
+      });
+    }
+
+    // The slot of zone new_head may be mid-write, so it counts as
+    // overwritten along with every older slot reused since the copy began
+    const std::uint64_t new_head{
+      thread->head.load(std::memory_order_acquire)
+    };
+    const std::uint64_t first_valid{
+      new_head >= kEventsPerThread ? new_head - kEventsPerThread + 1U : 0U
+    };
+    const std::uint64_t first_copied{ head - count };
+    const std::uint64_t overwritten{
+      first_valid > first_copied ? std::min(first_valid - first_copied, count)
+                                 : 0U
+    };
+    zones.erase(zones.begin(),
+                zones.begin() + static_cast<std::ptrdiff_t>(overwritten));
+
+    for (const Zone& zone : zones) {
+      origin_ns = std::min(origin_ns, zone.start_ns);
+    }
+    threads.emplace_back(thread.get(), std::move(zones));
+  }
+
+  // Write complete ("X") events, with thread names as metadata
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first{ true };
+  const auto separator{ [&] {
+    out << (first ? "\n" : ",\n");
+    first = false;
+  } };
+  for (const auto& [thread, zones] : threads) {
+    separator();
+    out << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << thread->thread_index
+        << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+    WriteJsonString(out, thread->name);
+    out << "}}";
+
+    for (const Zone& zone : zones) {
+      separator();
+      out << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << thread->thread_index
+          << ",\"ts\":"
+          << static_cast<double>(zone.start_ns - origin_ns) / 1000.0
+          << ",\"dur\":"
+          << static_cast<double>(zone.end_ns - zone.start_ns) / 1000.0
+          << ",\"cat\":";
+      WriteJsonString(out, zone.category);
+      out << ",\"name\":";
+      WriteJsonString(out, zone.name);
+      out << '}';
+    }
+  }
+  out << "\n]}\n";
+
+  if (!out) {
+    throw std::runtime_error{ "Failed to write trace file: " + path };
+  }
+
+  // Exited threads record nothing more, so their rings are no longer needed
+  std::erase_if(state.threads, [](const std::shared_ptr<ThreadEvents>& ring) {
+    return ring->retired;
+  });
+  MAPLE_LOG_INFO(LogCore, "Profiler trace written to {}", path);
+}
+
+} // namespace maple::core
@@ -0,0 +1,338 @@
+#include "Core/TLSFAllocator.h"
+
+// STL
+#include <algorithm>
+#include <bit>
+
+namespace maple::core {
+
+namespace {
+
+/// Flag bit marking a free block in Block::size_and_flags
+constexpr std::size_t kFreeFlag{ 1U };
+
+/**
+ * @brief Round an address or size up to a power-of-two alignment.
+ */
+constexpr std::uintptr_t AlignUp(std::uintptr_t value,
+                                 std::size_t alignment) noexcept {
+  return (value + alignment - 1U) & ~(std::uintptr_t{ alignment } - 1U);
+}
+
+/**
+ * @brief Round an address or size down to a power-of-two alignment.
+ */
+constexpr std::uintptr_t AlignDown(std::uintptr_t value,
+                                   std::size_t alignment) noexcept {
+  return value & ~(std::uintptr_t{ alignment } - 1U);
+}
+
+/**
+ * @brief Index of the most significant set bit (value must be non-zero).
+ */
+constexpr std::uint32_t FindLastSet(std::size_t value) noexcept {
+  return static_cast<std::uint32_t>(std::bit_width(value)) - 1U;
+}
+
+/**
+ * @brief Index of the least significant set bit (value must be non-zero).
+ */
+constexpr std::uint32_t FindFirstSet(std::uint32_t value) noexcept {
+  return static_cast<std::uint32_t>(std::countr_zero(value));
+}
+
+} // namespace
+
+std::size_t TLSFAllocator::Block::GetSize() const noexcept {
+  return size_and_flags & ~kFreeFlag;
+}
+
+void TLSFAllocator::Block::SetSize(std::size_t size) noexcept {
+  size_and_flags = size | (size_and_flags & kFreeFlag);
+}
+
+bool TLSFAllocator::Block::IsFree() const noexcept {
+  return (size_and_flags & kFreeFlag) != 0U;
+}
+
+void TLSFAllocator::Block::SetFree(bool free) noexcept {
+  size_and_flags = free ? (size_and_flags | kFreeFlag)
+                        : (size_and_flags & ~kFreeFlag);
+}
+
+TLSFAllocator::Block*
+TLSFAllocator::Block::GetNextPhysical() const noexcept {
+  const auto address{ reinterpret_cast<std::uintptr_t>(this) };
+  return reinterpret_cast<Block*>(address + kBlockOverhead + GetSize());
+}
+
+void* TLSFAllocator::Block::GetPayload() noexcept {
+  return reinterpret_cast<std::byte*>(this) + kBlockOverhead;
+}
+
+TLSFAllocator::Block*
+TLSFAllocator::Block::FromPayload(const void* ptr) noexcept {
+  const auto address{ reinterpret_cast<std::uintptr_t>(ptr) };
+  return reinterpret_cast<Block*>(address - kBlockOverhead);
+}
+
+TLSFAllocator::TLSFAllocator() noexcept = default;
+
+TLSFAllocator::~TLSFAllocator() = default;
+
+bool TLSFAllocator::AddPool(void* memory, std::size_t size) noexcept {
+  if (pool_count_ == kMaxPools) {
+    return false;
+  }
+
+  // Align the region and leave room for the first header and the sentinel
+  const auto address{ reinterpret_cast<std::uintptr_t>(memory) };
+  const std::uintptr_t start{ AlignUp(address, kAlignment) };
+  const std::uintptr_t end{ AlignDown(address + size, kAlignment) };
+  if (end <= start || end - start < 2U * kBlockOverhead + kMinBlockSize) {
+    return false;
+  }
+  const std::size_t block_size{ end - start - 2U * kBlockOverhead };
+  if (block_size >= (std::size_t{ 1U } << kFirstLevelMax)) {
+    return false;
+  }
+
+  // One free block spanning the pool
+  auto* block{ reinterpret_cast<Block*>(start) };
+  block->prev_physical = nullptr;
+  block->size_and_flags = block_size | kFreeFlag;
+  InsertFreeBlock(block);
+
+  // A zero-sized used sentinel terminates the pool so that coalescing never
+  // walks past its end
+  Block* sentinel{ block->GetNextPhysical() };
+  sentinel->prev_physical = block;
+  sentinel->size_and_flags = 0U;
+
+  pools_[pool_count_++] = block;
+  pool_bytes_ += size;
+  return true;
+}
+
+void* TLSFAllocator::Allocate(std::size_t size,
+                              std::size_t alignment) noexcept {
+  const std::size_t adjusted{
+    AlignUp(std::max(size, kMinBlockSize), kAlignment)
+  };
+  if (adjusted >= (std::size_t{ 1U } << (kFirstLevelMax - 1U))) {
+    return nullptr;
+  }
+
+  Block* block{ nullptr };
+  if (alignment <= kAlignment) {
+    block = LocateFreeBlock(adjusted);
+    if (!block) {
+      return nullptr;
+    }
+  } else {
+    // Search with enough slack to split off a valid leading free block
+    constexpr std::size_t kMinGap{ kBlockOverhead + kMinBlockSize };
+    block = LocateFreeBlock(adjusted + alignment + kMinGap);
+    if (!block) {
+      return nullptr;
+    }
+
+    const auto payload{ reinterpret_cast<std::uintptr_t>(block->GetPayload()) };
+    std::uintptr_t aligned{ AlignUp(payload, alignment) };
+    if (aligned != payload && aligned - payload < kMinGap) {
+      aligned = AlignUp(payload + kMinGap, alignment);
+    }
+
+    // Return the leading gap to the heap as its own free block
+    const std::size_t gap{ aligned - payload };
+    if (gap > 0U) {
+      auto* aligned_block{ Block::FromPayload(
+        reinterpret_cast<void*>(aligned)
+      ) };
+      aligned_block->prev_physical = block;
+      aligned_block->size_and_flags = block->GetSize() - gap;
+      aligned_block->GetNextPhysical()->prev_physical = aligned_block;
+
+      block->SetSize(gap - kBlockOverhead);
+      InsertFreeBlock(block);
+      block = aligned_block;
+    }
+  }
+
+  // Return the unused tail to the heap and hand out the block
+  TrimTrailing(block, adjusted);
+  block->SetFree(false);
+  return block->GetPayload();
+}
+
+void TLSFAllocator::Free(void* ptr) noexcept {
+  if (!ptr) {
+    return;
+  }
+
+  Block* block{ Block::FromPayload(ptr) };
+  block->SetFree(true);
+  InsertFreeBlock(Coalesce(block));
+}
+
+std::size_t TLSFAllocator::GetBlockSize(const void* ptr) noexcept {
+  return Block::FromPayload(ptr)->GetSize();
+}
+
+TLSFStats TLSFAllocator::GetStats() const noexcept {
+  TLSFStats stats{ .pool_bytes = pool_bytes_ };
+
+  // Walk every pool up to its zero-sized sentinel
+  for (std::size_t i{ 0U }; i < pool_count_; ++i) {
+    for (const Block* block{ pools_[i] }; block->GetSize() != 0U;
+         block = block->GetNextPhysical()) {
+      if (block->IsFree()) {
+        stats.free_bytes += block->GetSize();
+        stats.largest_free_block = std::max(stats.largest_free_block,
+                                             block->GetSize());
+        ++stats.free_blocks;
+      } else {
+        stats.used_bytes += block->GetSize();
+        ++stats.used_blocks;
+      }
+    }
+  }
+
+  return stats;
+}
+
+void TLSFAllocator::MappingInsert(std::size_t size, std::uint32_t& fl,
+                                  std::uint32_t& sl) noexcept {
+  if (size < kSmallBlockSize) {
+    // Small sizes map linearly into the first level
+    fl = 0U;
+    sl = static_cast<std::uint32_t>(size / (kSmallBlockSize
+                                            / kSecondLevelCount));
+  } else {
+    const std::uint32_t last_bit{ FindLastSet(size) };
+    sl = static_cast<std::uint32_t>(size >> (last_bit - kSecondLevelLog2))
+         ^ kSecondLevelCount;
+    fl = last_bit - (kFirstLevelShift - 1U);
+  }
+}
+
+void TLSFAllocator::MappingSearch(std::size_t size, std::uint32_t& fl,
+                                  std::uint32_t& sl) noexcept {
+  // Round up to the next list boundary so every block in the list fits
+  if (size >= kSmallBlockSize) {
+    size += (std::size_t{ 1U } << (FindLastSet(size) - kSecondLevelLog2)) - 1U;
+  }
+  MappingInsert(size, fl, sl);
+}
+
+TLSFAllocator::Block*
+TLSFAllocator::LocateFreeBlock(std::size_t size) noexcept {
+  std::uint32_t fl{ 0U };
+  std::uint32_t sl{ 0U };
+  MappingSearch(size, fl, sl);
+  if (fl >= kFirstLevelCount) {
+    return nullptr;
+  }
+
+  // Look for a non-empty list in this first level at or above sl
+  std::uint32_t sl_map{ second_level_bitmaps_[fl] & (~0U << sl) };
+  if (sl_map == 0U) {
+    // Fall back to the smallest non-empty list of a larger first level
+    const std::uint32_t fl_map{
+      fl + 1U < kFirstLevelCount ? first_level_bitmap_ & (~0U << (fl + 1U))
+                                 : 0U
+    };
+    if (fl_map == 0U) {
+      return nullptr;
+    }
+    fl = FindFirstSet(fl_map);
+    sl_map = second_level_bitmaps_[fl];
+  }
+  sl = FindFirstSet(sl_map);
+
+  Block* block{ free_lists_[fl][sl] };
+  RemoveFreeBlock(block);
+  return block;
+}
+
+void TLSFAllocator::InsertFreeBlock(Block* block) noexcept {
+  std::uint32_t fl{ 0U };
+  std::uint32_t sl{ 0U };
+  MappingInsert(block->GetSize(), fl, sl);
+
+  // Push onto the head of the list and mark it non-empty
+  Block* head{ free_lists_[fl][sl] };
+  block->next_free = head;
+  block->prev_free = nullptr;
+  if (head) {
+    head->prev_free = block;
+  }
+  free_lists_[fl][sl] = block;
+  first_level_bitmap_ |= 1U << fl;
+  second_level_bitmaps_[fl] |= 1U << sl;
+}
+
+void TLSFAllocator::RemoveFreeBlock(Block* block) noexcept {
+  std::uint32_t fl{ 0U };
+  std::uint32_t sl{ 0U };
+  MappingInsert(block->GetSize(), fl, sl);
+
+  // Unlink from the list
+  if (block->prev_free) {
+    block->prev_free->next_free = block->next_free;
+  } else {
+    free_lists_[fl][sl] = block->next_free;
+  }
+  if (block->next_free) {
+    block->next_free->prev_free = block->prev_free;
+  }
+
+  // Clear the bitmap bits if the list became empty
+  if (!free_lists_[fl][sl]) {
+    second_level_bitmaps_[fl] &= ~(1U << sl);
+    if (second_level_bitmaps_[fl] == 0U) {
+      first_level_bitmap_ &= ~(1U << fl);
+    }
+  }
+}
+
+void TLSFAllocator::TrimTrailing(Block* block, std::size_t size) noexcept {
+  if (block->GetSize() < size + kBlockOverhead + kMinBlockSize) {
+    return;
+  }
+
+  // Carve the remainder into a new free block after the payload. Free blocks
+  // never border each other, so the remainder's next neighbor is in use.
+  auto* remainder{ reinterpret_cast<Block*>(
+    static_cast<std::byte*>(block->GetPayload()) + size
+  ) };
+  remainder->prev_physical = block;
+  remainder->size_and_flags = (block->GetSize() - size - kBlockOverhead)
+                              | kFreeFlag;
+  remainder->GetNextPhysical()->prev_physical = remainder;
+  block->SetSize(size);
+  InsertFreeBlock(remainder);
+}
+
+TLSFAllocator::Block* TLSFAllocator::Coalesce(Block* block) noexcept {
+  // Merge with the previous block
+  Block* prev{ block->prev_physical };
+  if (prev && prev->IsFree()) {
+    RemoveFreeBlock(prev);
+    prev->SetSize(prev->GetSize() + kBlockOverhead + block->GetSize());
+    prev->GetNextPhysical()->prev_physical = prev;
+    block = prev;
+  }
+
+  // Merge with the next block (the pool sentinel is never free)
+  Block* next{ block->GetNextPhysical() };
+  if (next->IsFree()) {
+    RemoveFreeBlock(next);
+    block->SetSize(block->GetSize() + kBlockOverhead + next->GetSize());
+    block->GetNextPhysical()->prev_physical = block;
+  }
+
+  return block;
+}
+
+} // namespace maple::core
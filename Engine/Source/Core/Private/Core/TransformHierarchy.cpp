@@ -0,0 +1,483 @@
+#include "Core/TransformHierarchy.h"
+
+// STL
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <xmmintrin.h>
+  #define MAPLE_CORE_SSE 1
+#endif
+
+// Core
+#include "Core/CoreLog.h"
+#include "Core/CpuFeatures.h"
+#include "Core/JobSystem.h"
+#include "Core/Profiler.h"
+#include "Core/TransformKernels.h"
+
+namespace maple::core {
+
+namespace {
+
+static_assert(sizeof(glm::mat4) == 16U * sizeof(float),
+              "Kernels expect glm::mat4 to be 16 packed floats");
+
+void MultiplyTransformsScalar(const float* locals, float* worlds,
+                              const std::uint32_t* parents,
+                              const std::uint32_t* nodes,
+                              std::size_t count) noexcept {
+  for (std::size_t k{ 0U }; k < count; ++k) {
+    const std::uint32_t node{ nodes[k] };
+    const float* parent{ worlds + std::size_t{ parents[node] } * 16U };
+    const float* local{ locals + std::size_t{ node } * 16U };
+    float* world{ worlds + std::size_t{ node } * 16U };
+    for (std::size_t column{ 0U }; column < 4U; ++column) {
+      const float* weights{ local + column * 4U };
+      for (std::size_t row{ 0U }; row < 4U; ++row) {
+        world[column * 4U + row] = parent[row] * weights[0]
+                                   + parent[4U + row] * weights[1]
+                                   + parent[8U + row] * weights[2]
+                                   + parent[12U + row] * weights[3];
+      }
+    }
+  }
+}
+
+#if defined(MAPLE_CORE_SSE)
+void MultiplyTransformsSse(const float* locals, float* worlds,
+                           const std::uint32_t* parents,
+                           const std::uint32_t* nodes,
+                           std::size_t count) noexcept {
+  for (std::size_t k{ 0U }; k < count; ++k) {
+    const std::uint32_t node{ nodes[k] };
+    const float* parent{ worlds + std::size_t{ parents[node] } * 16U };
+    const float* local{ locals + std::size_t{ node } * 16U };
+    float* world{ worlds + std::size_t{ node } * 16U };
+
+    const __m128 p0{ _mm_loadu_ps(parent + 0) };
+    const __m128 p1{ _mm_loadu_ps(parent + 4) };
+    const __m128 p2{ _mm_loadu_ps(parent + 8) };
+    const __m128 p3{ _mm_loadu_ps(parent + 12) };
+
+    // Column j of the result is the sum of the parent columns weighted by
+    // local column j's elements
+    for (std::size_t column{ 0U }; column < 16U; column += 4U) {
+      const __m128 l{ _mm_loadu_ps(local + column) };
+      __m128 w{ _mm_mul_ps(p0, _mm_shuffle_ps(l, l, 0x00)) };
+      w = _mm_add_ps(w, _mm_mul_ps(p1, _mm_shuffle_ps(l, l, 0x55)));
+      w = _mm_add_ps(w, _mm_mul_ps(p2, _mm_shuffle_ps(l, l, 0xAA)));
+      w = _mm_add_ps(w, _mm_mul_ps(p3, _mm_shuffle_ps(l, l, 0xFF)));
+      _mm_storeu_ps(world + column, w);
+    }
+  }
+}
+#endif
+
+detail::TransformBatchFunction GetBatchFunction(
+  TransformKernel kernel) noexcept {
+  switch (kernel) {
+#if defined(MAPLE_CORE_SSE)
+    case TransformKernel::SSE: {
+      return &MultiplyTransformsSse;
+    }
+#endif
+
+#if defined(MAPLE_CORE_AVX2)
+    case TransformKernel::AVX2: {
+      return &detail::MultiplyTransformsAvx2;
+    }
+#endif
+
+    default: {
+      return &MultiplyTransformsScalar;
+    }
+  }
+}
+
+} // namespace
+
+const char* GetTransformKernelName(TransformKernel kernel) noexcept {
+  switch (kernel) {
+    case TransformKernel::Scalar: {
+      return "Scalar";
+    }
+
+    case TransformKernel::SSE: {
+      return "SSE";
+    }
+
+    case TransformKernel::AVX2: {
+      return "AVX2";
+    }
+
+    default: {
+      return "Unknown";
+    }
+  }
+}
+
+TransformHierarchy::TransformHierarchy() {
+  for (const TransformKernel kernel : {
+         TransformKernel::AVX2, TransformKernel::SSE
+       }) {
+    if (IsKernelSupported(kernel)) {
+      kernel_ = kernel;
+      break;
+    }
+  }
+  stats_.kernel = kernel_;
+}
+
+TransformId TransformHierarchy::Create(TransformId parent,
+                                       const glm::mat4& local) {
+  const std::uint32_t parent_index{
+    parent == kInvalidTransform ? kNoIndex : GetIndex(parent)
+  };
+
+  TransformId id{ kInvalidTransform };
+  if (free_ids_.empty()) {
+    id = static_cast<TransformId>(indices_.size());
+    indices_.push_back(kNoIndex);
+  } else {
+    id = free_ids_.back();
+    free_ids_.pop_back();
+  }
+
+  const auto index{ static_cast<std::uint32_t>(ids_.size()) };
+  locals_.push_back(local);
+  worlds_.push_back(local);
+  parents_.push_back(parent_index);
+  dirty_.push_back(1U);
+  ids_.push_back(id);
+  indices_[id] = index;
+  any_dirty_ = true;
+
+  // Appending keeps the nodes sorted if the new node is not shallower than
+  // the last one; otherwise the next update sorts them
+  const std::uint32_t depth{
+    parent_index == kNoIndex ? 0U : depths_[parent_index] + 1U
+  };
+  depths_.push_back(depth);
+  const std::size_t level_count{ level_offsets_.size() - 1U };
+  if (!unsorted_ && depth + 1U >= level_count) {
+    if (depth == level_count) {
+      level_offsets_.push_back(index + 1U);
+    } else {
+      level_offsets_.back() = index + 1U;
+    }
+  } else {
+    unsorted_ = true;
+  }
+  return id;
+}
+
+void TransformHierarchy::Destroy(TransformId node) {
+  std::uint32_t first{ GetIndex(node) };
+  if (unsorted_) {
+    SortNodes();
+    first = indices_[node];
+  }
+
+  // Descendants follow their ancestors once sorted, so one forward pass
+  // finds the whole subtree and compacts the survivors in order
+  std::vector<std::uint32_t> remap(ids_.size(), kNoIndex);
+  std::uint32_t kept{ first };
+  for (std::uint32_t i{ 0U }; i < first; ++i) {
+    remap[i] = i;
+  }
+  for (std::uint32_t i{ first }; i < ids_.size(); ++i) {
+    const std::uint32_t parent{ parents_[i] };
+    const bool removed{
+      i == first || (parent != kNoIndex && remap[parent] == kNoIndex)
+    };
+    if (removed) {
+      indices_[ids_[i]] = kNoIndex;
+      free_ids_.push_back(ids_[i]);
+      continue;
+    }
+    remap[i] = kept;
+    locals_[kept] = locals_[i];
+    worlds_[kept] = worlds_[i];
+    parents_[kept] = parent == kNoIndex ? kNoIndex : remap[parent];
+    depths_[kept] = depths_[i];
+    dirty_[kept] = dirty_[i];
+    ids_[kept] = ids_[i];
+    indices_[ids_[kept]] = kept;
+    ++kept;
+  }
+
+  locals_.resize(kept);
+  worlds_.resize(kept);
+  parents_.resize(kept);
+  depths_.resize(kept);
+  dirty_.resize(kept);
+  ids_.resize(kept);
+
+  // Rebuild the depth ranges from the compacted depths
+  level_offsets_.assign(1U, 0U);
+  for (std::uint32_t i{ 0U }; i < kept; ++i) {
+    if (depths_[i] + 1U == level_offsets_.size()) {
+      level_offsets_.push_back(i + 1U);
+    } else {
+      level_offsets_.back() = i + 1U;
+    }
+  }
+}
+
+void TransformHierarchy::SetParent(TransformId node, TransformId parent) {
+  const std::uint32_t index{ GetIndex(node) };
+  const std::uint32_t parent_index{
+    parent == kInvalidTransform ? kNoIndex : GetIndex(parent)
+  };
+
+  // The new parent must not be in the node's subtree
+  for (std::uint32_t ancestor{ parent_index }; ancestor != kNoIndex;
+       ancestor = parents_[ancestor]) {
+    if (ancestor == index) {
+      throw std::runtime_error{ "Cannot parent transform "
+                                + std::to_string(node) + " to "
+                                + std::to_string(parent)
+                                + ", which is in its subtree" };
+    }
+  }
+
+  parents_[index] = parent_index;
+  dirty_[index] = 1U;
+  any_dirty_ = true;
+  unsorted_ = true;
+}
+
+void TransformHierarchy::SetLocal(TransformId node,
+                                  const glm::mat4& local) noexcept {
+  const std::uint32_t index{ indices_[node] };
+  locals_[index] = local;
+  dirty_[index] = 1U;
+  any_dirty_ = true;
+}
+
+TransformId TransformHierarchy::GetParent(TransformId node) const noexcept {
+  const std::uint32_t parent{ parents_[indices_[node]] };
+  return parent == kNoIndex ? kInvalidTransform : ids_[parent];
+}
+
+const glm::mat4& TransformHierarchy::GetLocal(
+  TransformId node) const noexcept {
+  return locals_[indices_[node]];
+}
+
+const glm::mat4& TransformHierarchy::GetWorld(
+  TransformId node) const noexcept {
+  return worlds_[indices_[node]];
+}
+
+bool TransformHierarchy::IsValid(TransformId node) const noexcept {
+  return node < indices_.size() && indices_[node] != kNoIndex;
+}
+
+std::size_t TransformHierarchy::GetNodeCount() const noexcept {
+  return ids_.size();
+}
+
+void TransformHierarchy::Update() {
+  MAPLE_PROFILE_FUNCTION(LogCore);
+
+  if (unsorted_) {
+    SortNodes();
+  }
+
+  stats_.node_count = ids_.size();
+  stats_.level_count = level_offsets_.size() - 1U;
+  stats_.updated_count = 0U;
+  stats_.kernel = kernel_;
+  if (!any_dirty_) {
+    return;
+  }
+
+  // Roots have no parent to multiply by
+  const std::uint32_t root_count{
+    stats_.level_count == 0U ? 0U : level_offsets_[1]
+  };
+  for (std::uint32_t i{ 0U }; i < root_count; ++i) {
+    if (dirty_[i] != 0U) {
+      worlds_[i] = locals_[i];
+      ++stats_.updated_count;
+    }
+  }
+
+  // Each depth only reads the one before it, which is complete
+  std::atomic<std::size_t> updated_count{ 0U };
+  for (std::size_t level{ 1U }; level < stats_.level_count; ++level) {
+    const std::size_t first{ level_offsets_[level] };
+    JobSystem::ParallelFor(
+      level_offsets_[level + 1U] - first, kMinNodesPerJob,
+      [this, first, &updated_count](std::size_t begin, std::size_t end) {
+        updated_count.fetch_add(UpdateRange(first + begin, first + end),
+                                std::memory_order_relaxed);
+      }
+    );
+  }
+  stats_.updated_count += updated_count.load(std::memory_order_relaxed);
+
+  std::memset(dirty_.data(), 0, dirty_.size());
+  any_dirty_ = false;
+}
+
+bool TransformHierarchy::IsKernelSupported(TransformKernel kernel) noexcept {
+  switch (kernel) {
+    case TransformKernel::Scalar: {
+      return true;
+    }
+
+    case TransformKernel::SSE: {
+#if defined(MAPLE_CORE_SSE)
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    case TransformKernel::AVX2: {
+#if defined(MAPLE_CORE_AVX2)
+      const CpuFeatures& features{ GetCpuFeatures() };
+      return features.avx2 && features.fma;
+#else
+      return false;
+#endif
+    }
+
+    default: { return false; }
+  }
+}
+
+void TransformHierarchy::SetKernel(TransformKernel kernel) {
+  if (!IsKernelSupported(kernel)) {
+    throw std::runtime_error{ std::string{ "Transform kernel " }
+                              + GetTransformKernelName(kernel)
+                              + " is not supported on this CPU" };
+  }
+  kernel_ = kernel;
+}
+
+TransformKernel TransformHierarchy::GetKernel() const noexcept {
+  return kernel_;
+}
+
+const TransformStats& TransformHierarchy::GetStats() const noexcept {
+  return stats_;
+}
+
+std::uint32_t TransformHierarchy::GetIndex(TransformId node) const {
+  if (!IsValid(node)) {
+    throw std::runtime_error{ "Transform " + std::to_string(node)
+                              + " does not exist" };
+  }
+  return indices_[node];
+}
+
+void TransformHierarchy::SortNodes() {
+  MAPLE_PROFILE_FUNCTION(LogCore);
+
+  // Children of each node, grouped by parent in their current order
+  const auto count{ static_cast<std::uint32_t>(ids_.size()) };
+  std::vector<std::uint32_t> child_offsets(count + 1U, 0U);
+  for (const std::uint32_t parent : parents_) {
+    if (parent != kNoIndex) {
+      ++child_offsets[parent + 1U];
+    }
+  }
+  for (std::uint32_t i{ 0U }; i < count; ++i) {
+    child_offsets[i + 1U] += child_offsets[i];
+  }
+  std::vector<std::uint32_t> children(child_offsets[count]);
+  std::vector<std::uint32_t> cursors(child_offsets.begin(),
+                                     child_offsets.end() - 1);
+  for (std::uint32_t i{ 0U }; i < count; ++i) {
+    if (parents_[i] != kNoIndex) {
+      children[cursors[parents_[i]]++] = i;
+    }
+  }
+
+  // Breadth-first from the roots; order[new index] = old index
+  std::vector<std::uint32_t> order{};
+  order.reserve(count);
+  for (std::uint32_t i{ 0U }; i < count; ++i) {
+    if (parents_[i] == kNoIndex) {
+      order.push_back(i);
+    }
+  }
+  std::vector<std::uint32_t> remap(count, kNoIndex);
+  std::vector<std::uint32_t> depths(count, 0U);
+  level_offsets_.assign(1U, 0U);
+  for (std::uint32_t next{ 0U }; next < order.size(); ++next) {
+    const std::uint32_t old_index{ order[next] };
+    const std::uint32_t parent{ parents_[old_index] };
+    remap[old_index] = next;
+    depths[next] = parent == kNoIndex ? 0U : depths[remap[parent]] + 1U;
+    if (depths[next] + 1U == level_offsets_.size()) {
+      level_offsets_.push_back(next + 1U);
+    } else {
+      level_offsets_.back() = next + 1U;
+    }
+    for (std::uint32_t c{ child_offsets[old_index] };
+         c < child_offsets[old_index + 1U]; ++c) {
+      order.push_back(children[c]);
+    }
+  }
+
+  // Permute every array into the new order
+  std::vector<glm::mat4> locals(count);
+  std::vector<glm::mat4> worlds(count);
+  std::vector<std::uint32_t> parents(count);
+  std::vector<std::uint8_t> dirty(count);
+  std::vector<TransformId> ids(count);
+  for (std::uint32_t i{ 0U }; i < count; ++i) {
+    const std::uint32_t old_index{ order[i] };
+    const std::uint32_t parent{ parents_[old_index] };
+    locals[i] = locals_[old_index];
+    worlds[i] = worlds_[old_index];
+    parents[i] = parent == kNoIndex ? kNoIndex : remap[parent];
+    dirty[i] = dirty_[old_index];
+    ids[i] = ids_[old_index];
+    indices_[ids[i]] = i;
+  }
+  locals_ = std::move(locals);
+  worlds_ = std::move(worlds);
+  parents_ = std::move(parents);
+  depths_ = std::move(depths);
+  dirty_ = std::move(dirty);
+  ids_ = std::move(ids);
+  unsorted_ = false;
+}
+
+std::size_t TransformHierarchy::UpdateRange(std::size_t begin,
+                                            std::size_t end) noexcept {
+  const detail::TransformBatchFunction multiply{ GetBatchFunction(kernel_) };
+  const auto* locals{ reinterpret_cast<const float*>(locals_.data()) };
+  auto* worlds{ reinterpret_cast<float*>(worlds_.data()) };
+
+  // A node changed if its local matrix or its parent's world matrix did;
+  // the parent's flag is final since its depth was already processed
+  std::uint32_t batch[kBatchSize];
+  std::size_t batch_count{ 0U };
+  std::size_t updated_count{ 0U };
+  for (std::size_t i{ begin }; i < end; ++i) {
+    dirty_[i] |= dirty_[parents_[i]];
+    if (dirty_[i] == 0U) {
+      continue;
+    }
+    batch[batch_count++] = static_cast<std::uint32_t>(i);
+    if (batch_count == kBatchSize) {
+      multiply(locals, worlds, parents_.data(), batch, batch_count);
+      updated_count += batch_count;
+      batch_count = 0U;
+    }
+  }
+  multiply(locals, worlds, parents_.data(), batch, batch_count);
+  return updated_count + batch_count;
+}
+
+} // namespace maple::core
@@ -0,0 +1,41 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <cstdint>
+
+namespace maple::core::detail {
+
+/**
+ * @brief Multiplies a batch of nodes' local matrices by their parents' world
+ *        matrices.
+ *
+ * Matrices are column-major arrays of 16 floats, laid out like glm::mat4.
+ * For each k < count, with n = nodes[k]:
+ * worlds[n] = worlds[parents[n]] * locals[n].
+ *
+ * @param locals Local matrix of each node
+ * @param worlds World matrix of each node; parents are read, nodes written
+ * @param parents Index of each node's parent
+ * @param nodes Indices of the nodes to compute (distinct from their parents)
+ * @param count Number of nodes to compute
+ */
+using TransformBatchFunction = void (*)(const float* locals, float* worlds,
+                                        const std::uint32_t* parents,
+                                        const std::uint32_t* nodes,
+                                        std::size_t count);
+
+#if defined(MAPLE_CORE_AVX2)
+/**
+ * @brief AVX2 and FMA implementation of TransformBatchFunction.
+ *
+ * Compiled with AVX2 enabled in its own translation unit, so it must only be
+ * called once GetCpuFeatures() reported AVX2 and FMA.
+ */
+void MultiplyTransformsAvx2(const float* locals, float* worlds,
+                            const std::uint32_t* parents,
+                            const std::uint32_t* nodes,
+                            std::size_t count) noexcept;
+#endif
+
+} // namespace maple::core::detail
@@ -0,0 +1,55 @@
+#include "Core/TransformKernels.h"
+
+#if defined(MAPLE_CORE_AVX2)
+
+// This file is compiled with AVX2 enabled. It must not include headers with
+// inline functions (e.g., glm or most of the STL): the linker may keep this
+// file's AVX2 copy of such a function for every caller, which would then
+// fault on CPUs without AVX2.
+#include <immintrin.h>
+
+namespace maple::core::detail {
+
+void MultiplyTransformsAvx2(const float* locals, float* worlds,
+                            const std::uint32_t* parents,
+                            const std::uint32_t* nodes,
+                            std::size_t count) noexcept {
+  for (std::size_t k{ 0U }; k < count; ++k) {
+    const std::uint32_t node{ nodes[k] };
+    const float* parent{ worlds + std::size_t{ parents[node] } * 16U };
+    const float* local{ locals + std::size_t{ node } * 16U };
+    float* world{ worlds + std::size_t{ node } * 16U };
+
+    // Every parent column in both halves of a register
+    const __m256 p0{ _mm256_broadcast_ps(
+      reinterpret_cast<const __m128*>(parent + 0)) };
+    const __m256 p1{ _mm256_broadcast_ps(
+      reinterpret_cast<const __m128*>(parent + 4)) };
+    const __m256 p2{ _mm256_broadcast_ps(
+      reinterpret_cast<const __m128*>(parent + 8)) };
+    const __m256 p3{ _mm256_broadcast_ps(
+      reinterpret_cast<const __m128*>(parent + 12)) };
+
+    // Two local columns per register; column j of the result is the sum of
+    // the parent columns weighted by local column j's elements, so each
+    // half splats its own column's elements
+    const __m256 l01{ _mm256_loadu_ps(local + 0) };
+    const __m256 l23{ _mm256_loadu_ps(local + 8) };
+
+    __m256 w01{ _mm256_mul_ps(p0, _mm256_shuffle_ps(l01, l01, 0x00)) };
+    __m256 w23{ _mm256_mul_ps(p0, _mm256_shuffle_ps(l23, l23, 0x00)) };
+    w01 = _mm256_fmadd_ps(p1, _mm256_shuffle_ps(l01, l01, 0x55), w01);
+    w23 = _mm256_fmadd_ps(p1, _mm256_shuffle_ps(l23, l23, 0x55), w23);
+    w01 = _mm256_fmadd_ps(p2, _mm256_shuffle_ps(l01, l01, 0xAA), w01);
+    w23 = _mm256_fmadd_ps(p2, _mm256_shuffle_ps(l23, l23, 0xAA), w23);
+    w01 = _mm256_fmadd_ps(p3, _mm256_shuffle_ps(l01, l01, 0xFF), w01);
+    w23 = _mm256_fmadd_ps(p3, _mm256_shuffle_ps(l23, l23, 0xFF), w23);
+
+    _mm256_storeu_ps(world + 0, w01);
+    _mm256_storeu_ps(world + 8, w23);
+  }
+}
+
+} // namespace maple::core::detail
+
+#endif
@@ -0,0 +1,285 @@
+#pragma once
+
+// STL
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// spdlog
+#include "spdlog/spdlog.h"
+
+// Core
+#include "Core/BinaryLogFormat.h"
+#include "Core/CoreExport.h"
+
+namespace maple::core {
+
+// Forward declarations
+class LogCategory;
+
+/**
+ * @brief Static state of a single binary log call site.
+ *
+ * One instance lives in a function-local static at every MAPLE_LOG_* call
+ * site when binary logging is enabled. The format ID is assigned on first use
+ * and reused for every subsequent call from the same site.
+ */
+struct BinaryLogSite {
+  /// Category the call site logs to
+  const LogCategory& category;
+
+  /// Severity of the call site
+  spdlog::level::level_enum level;
+
+  /// Source file of the call site
+  const char* file;
+
+  /// Source line of the call site
+  std::uint32_t line;
+
+  /// Format definition ID (0 until registered)
+  std::atomic<std::uint32_t> format_id{ 0U };
+};
+
+/**
+ * @brief Deferred-format binary logging backend.
+ *
+ * Instead of formatting messages on the calling thread, each log call stores
+ * a format ID and the raw bytes of its arguments into a per-thread lock-free
+ * ring buffer. A background thread appends the buffers to a compact binary
+ * file, which the MapleLogDecoder tool turns back into text offline.
+ *
+ * Enabled at compile time with the MAPLE_LOG_BINARY CMake option, in which
+ * case the MAPLE_LOG_* macros route here instead of to spdlog. The file is
+ * opened by Log::Initialize() and closed by Log::Shutdown().
+ *
+ * @par Supported Arguments
+ * Booleans, characters, integers, floating-point values, pointers, and
+ * anything convertible to std::string_view are stored raw. Any other
+ * formattable type is formatted to a string on the calling thread.
+ *
+ * @note Format strings must be string literals to be deferred; any other
+ *       format string is formatted eagerly and stored as a single string.
+ */
+class MAPLE_CORE_API BinaryLog {
+public:
+  /**
+   * @brief Open the binary log file and start the background writer.
+   *
+   * Format definitions registered and events logged before this call are
+   * retained and written once the file is open.
+   *
+   * @param path Path of the binary log file (truncated if it exists)
+   * @throws std::runtime_error If the file cannot be opened
+   */
+  static void Initialize(const std::string& path);
+
+  /**
+   * @brief Write all pending events, stop the writer, and close the file.
+   */
+  static void Shutdown();
+
+  /**
+   * @brief Write all pending events from every thread to the file.
+   *
+   * Called automatically after error and critical messages.
+   */
+  static void Flush();
+
+  /**
+   * @brief Assign a format ID to a call site and record its definition.
+   *
+   * Thread-safe; concurrent first calls from the same site return the same ID.
+   *
+   * @param site Call site to register
+   * @param format Format string in spdlog/fmt syntax
+   * @param arg_types Encoded types of the call site's arguments
+   * @return The call site's format ID
+   */
+  static std::uint32_t RegisterFormat(
+    BinaryLogSite& site, std::string_view format,
+    std::span<const binary_log::ArgType> arg_types
+  );
+
+  /**
+   * @brief Append an event to the calling thread's buffer.
+   *
+   * Never blocks; the event is dropped if the buffer is full.
+   *
+   * @param format_id Format ID returned by RegisterFormat()
+   * @param args Encoded argument bytes
+   * @param args_size Number of argument bytes (at most kMaxArgsSize)
+   */
+  static void Submit(std::uint32_t format_id, const std::byte* args,
+                     std::size_t args_size);
+
+  /**
+   * @brief Encode and submit a log call.
+   *
+   * @param site Static state of the call site
+   * @param format Format string (deferred if it is a string literal)
+   * @param args Format arguments
+   */
+  template <typename Format, typename... Args>
+  static void Write(BinaryLogSite& site, const Format& format,
+                    const Args&... args);
+
+private:
+  /**
+   * @brief Map an argument type to its encoded representation.
+   */
+  template <typename T>
+  static consteval binary_log::ArgType ArgTypeOf();
+
+  /**
+   * @brief Append a single encoded argument to the buffer.
+   *
+   * Strings are truncated so that at least @p reserve bytes remain for the
+   * arguments that follow.
+   */
+  template <typename T>
+  static void EncodeArg(std::byte* buffer, std::size_t& size,
+                        std::size_t reserve, const T& arg);
+
+  /**
+   * @brief Append a length-prefixed string to the buffer.
+   */
+  static void EncodeString(std::byte* buffer, std::size_t& size,
+                           std::size_t reserve, std::string_view text);
+};
+
+template <typename Format, typename... Args>
+void BinaryLog::Write(BinaryLogSite& site, const Format& format,
+                      const Args&... args) {
+  static_assert(sizeof...(Args) <= 64U, "Too many binary log arguments");
+
+  std::byte buffer[binary_log::kMaxArgsSize];
+  std::size_t size{ 0U };
+
+  if constexpr (std::is_array_v<Format>) {
+    // Literal format string; register once, then store only raw arguments
+    std::uint32_t format_id{ site.format_id.load(std::memory_order_acquire) };
+    if (format_id == 0U) {
+      static constexpr std::array<binary_log::ArgType, sizeof...(Args)>
+        kArgTypes{ ArgTypeOf<Args>()... };
+      format_id = RegisterFormat(site, std::string_view{ format }, kArgTypes);
+    }
+
+    // Reserve eight bytes for each argument after the one being encoded
+    std::size_t reserve{ sizeof...(Args) * 8U };
+    ((reserve -= 8U, EncodeArg(buffer, size, reserve, args)), ...);
+
+    Submit(format_id, buffer, size);
+  } else {
+    // Runtime format string; format eagerly and store the resulting text
+    std::uint32_t format_id{ site.format_id.load(std::memory_order_acquire) };
+    if (format_id == 0U) {
+      static constexpr std::array<binary_log::ArgType, 1U> kArgTypes{
+        binary_log::ArgType::String
+      };
+      format_id = RegisterFormat(site, "{}", kArgTypes);
+    }
+
+    if constexpr (sizeof...(Args) == 0U) {
+      EncodeString(buffer, size, 0U, std::string_view{ format });
+    } else {
+      const std::string text{
+        spdlog::fmt_lib::vformat(std::string_view{ format },
+                                 spdlog::fmt_lib::make_format_args(args...))
+      };
+      EncodeString(buffer, size, 0U, text);
+    }
+
+    Submit(format_id, buffer, size);
+  }
+
+  // Make severe messages durable immediately
+  if (site.level >= spdlog::level::err) {
+    Flush();
+  }
+}
+
+template <typename T>
+consteval binary_log::ArgType BinaryLog::ArgTypeOf() {
+  using U = std::remove_cvref_t<T>;
+  if constexpr (std::is_same_v<U, bool>) {
+    return binary_log::ArgType::Bool;
+  } else if constexpr (std::is_same_v<U, char>) {
+    return binary_log::ArgType::Char;
+  } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+    return binary_log::ArgType::Int64;
+  } else if constexpr (std::is_integral_v<U>) {
+    return binary_log::ArgType::UInt64;
+  } else if constexpr (std::is_floating_point_v<U>) {
+    return binary_log::ArgType::Double;
+  } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+    return binary_log::ArgType::String;
+  } else if constexpr (std::is_pointer_v<U>) {
+    return binary_log::ArgType::Pointer;
+  } else {
+    // Formatted to a string on the calling thread
+    return binary_log::ArgType::String;
+  }
+}
+
+template <typename T>
+void BinaryLog::EncodeArg(std::byte* buffer, std::size_t& size,
+                          std::size_t reserve, const T& arg) {
+  using U = std::remove_cvref_t<T>;
+  constexpr binary_log::ArgType kType{ ArgTypeOf<T>() };
+
+  if constexpr (kType == binary_log::ArgType::Bool
+                || kType == binary_log::ArgType::Char) {
+    const auto value{ static_cast<std::uint8_t>(arg) };
+    std::memcpy(buffer + size, &value, sizeof(value));
+    size += sizeof(value);
+  } else if constexpr (kType == binary_log::ArgType::Int64) {
+    const auto value{ static_cast<std::int64_t>(arg) };
+    std::memcpy(buffer + size, &value, sizeof(value));
+    size += sizeof(value);
+  } else if constexpr (kType == binary_log::ArgType::UInt64) {
+    const auto value{ static_cast<std::uint64_t>(arg) };
+    std::memcpy(buffer + size, &value, sizeof(value));
+    size += sizeof(value);
+  } else if constexpr (kType == binary_log::ArgType::Double) {
+    const auto value{ static_cast<double>(arg) };
+    std::memcpy(buffer + size, &value, sizeof(value));
+    size += sizeof(value);
+  } else if constexpr (kType == binary_log::ArgType::Pointer) {
+    const auto value{
+      static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(arg))
+    };
+    std::memcpy(buffer + size, &value, sizeof(value));
+    size += sizeof(value);
+  } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+    EncodeString(buffer, size, reserve, std::string_view{ arg });
+  } else {
+    EncodeString(buffer, size, reserve, spdlog::fmt_lib::format("{}", arg));
+  }
+}
+
+inline void BinaryLog::EncodeString(std::byte* buffer, std::size_t& size,
+                                    std::size_t reserve,
+                                    std::string_view text) {
+  // Truncate to the space left after the length prefix and reservation
+  const std::size_t available{
+    binary_log::kMaxArgsSize - size - sizeof(std::uint16_t) - reserve
+  };
+  const auto length{
+    static_cast<std::uint16_t>(text.size() < available ? text.size()
+                                                       : available)
+  };
+
+  std::memcpy(buffer + size, &length, sizeof(length));
+  size += sizeof(length);
+  std::memcpy(buffer + size, text.data(), length);
+  size += length;
+}
+
+} // namespace maple::core
@@ -0,0 +1,91 @@
+#pragma once
+
+/**
+ * @file BinaryLogFormat.h
+ * @brief On-disk layout of binary log files shared by the engine and decoder.
+ *
+ * A binary log file starts with a FileHeader followed by a stream of records.
+ * Each record begins with a one-byte RecordKind. All integers are stored in
+ * native (little-endian) byte order without padding.
+ *
+ * @par Format definition record
+ * | Field       | Type                          |
+ * |-------------|-------------------------------|
+ * | kind        | u8 (RecordKind::Format)       |
+ * | id          | u32                           |
+ * | level       | u8 (spdlog::level::level_enum)|
+ * | line        | u32                           |
+ * | arg_count   | u8                            |
+ * | arg_types   | u8[arg_count] (ArgType)       |
+ * | category    | u16 length + chars            |
+ * | file        | u16 length + chars            |
+ * | format      | u32 length + chars            |
+ *
+ * @par Event record
+ * | Field       | Type                          |
+ * |-------------|-------------------------------|
+ * | kind        | u8 (RecordKind::Event)        |
+ * | id          | u32 (format definition id)    |
+ * | thread      | u32 (engine thread index)     |
+ * | timestamp   | i64 (steady clock, ns)        |
+ * | args_size   | u16                           |
+ * | args        | u8[args_size]                 |
+ *
+ * Arguments are encoded back to back in the order of the definition's
+ * arg_types: Bool and Char as one byte, Int64, UInt64, Double and Pointer as
+ * eight bytes, and String as a u16 length followed by the characters.
+ */
+
+// STL
+#include <cstddef>
+#include <cstdint>
+
+namespace maple::core::binary_log {
+
+/// File magic ("MLOG" in little-endian byte order)
+inline constexpr std::uint32_t kFileMagic{ 0x474F4C4DU };
+
+/// Current file format version
+inline constexpr std::uint32_t kFileVersion{ 1U };
+
+/// Size in bytes of an event record header (everything before the args)
+inline constexpr std::size_t kEventHeaderSize{ 1U + 4U + 4U + 8U + 2U };
+
+/// Maximum size in bytes of the encoded arguments of a single event
+inline constexpr std::size_t kMaxArgsSize{ 2048U };
+
+/**
+ * @brief Header at the start of every binary log file.
+ *
+ * The two origins allow the decoder to convert steady-clock event timestamps
+ * into wall-clock time.
+ */
+struct FileHeader {
+  std::uint32_t magic{ kFileMagic };
+  std::uint32_t version{ kFileVersion };
+  std::int64_t steady_origin_ns{ 0 };
+  std::int64_t system_origin_ns{ 0 };
+};
+
+/**
+ * @brief Kind tag at the start of every record.
+ */
+enum class RecordKind : std::uint8_t {
+  Format = 1,
+  Event = 2
+};
+
+/**
+ * @brief Encoded type of a single log argument.
+ */
+enum class ArgType : std::uint8_t {
+  Bool = 1,
+  Char = 2,
+  Int64 = 3,
+  UInt64 = 4,
+  Double = 5,
+  String = 6,
+  Pointer = 7
+};
+
+} // namespace maple::core::binary_log
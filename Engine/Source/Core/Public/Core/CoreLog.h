@@ -0,0 +1,7 @@
+#pragma once
+
+// Core
+#include "Core/CoreExport.h"
+#include "Core/Log.h"
+
+MAPLE_DECLARE_LOG_CATEGORY(MAPLE_CORE_API, LogCore);
@@ -0,0 +1,37 @@
+#pragma once
+
+// Core
+#include "Core/CoreExport.h"
+
+namespace maple::core {
+
+/**
+ * @brief Instruction set extensions usable on the running CPU.
+ *
+ * An extension is only reported if both the CPU and the operating system
+ * support it (e.g., the OS must save the AVX registers on context switches).
+ */
+struct CpuFeatures {
+  /// SSE4.1 (x86)
+  bool sse41{ false };
+
+  /// AVX (x86)
+  bool avx{ false };
+
+  /// AVX2 (x86)
+  bool avx2{ false };
+
+  /// Fused multiply-add (x86 FMA3)
+  bool fma{ false };
+};
+
+/**
+ * @brief Get the instruction set extensions of the running CPU.
+ *
+ * Detected on first call; later calls return the cached result.
+ *
+ * @return Features detected (all false on non-x86 platforms)
+ */
+[[nodiscard]] MAPLE_CORE_API const CpuFeatures& GetCpuFeatures() noexcept;
+
+} // namespace maple::core
@@ -0,0 +1,78 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Core
+#include "Core/CoreExport.h"
+#include "Core/LinearArena.h"
+
+namespace maple::core {
+
+/**
+ * @brief Set of per-frame linear arenas, one for each frame in flight.
+ *
+ * Per-frame temporaries are allocated from the current frame's arena instead
+ * of the global heap. BeginFrame() advances to the next arena and resets it in
+ * bulk; since that arena was last used frames-in-flight frames ago, anything
+ * still referenced by frames being processed remains valid.
+ */
+class MAPLE_CORE_API FrameArena {
+public:
+  FrameArena() = delete;
+  FrameArena(const FrameArena&) = delete;
+  FrameArena& operator=(const FrameArena&) = delete;
+  FrameArena(FrameArena&&) = delete;
+  FrameArena& operator=(FrameArena&&) = delete;
+
+  /**
+   * @brief Construct one arena per frame in flight.
+   *
+   * @param capacity_per_frame Size of each frame's arena in bytes
+   * @param frames_in_flight Number of frames whose allocations must stay
+   *                         valid at the same time (at least 1)
+   */
+  FrameArena(std::size_t capacity_per_frame, std::uint32_t frames_in_flight);
+
+  ~FrameArena();
+
+  /**
+   * @brief Advance to the next frame's arena and reset it.
+   *
+   * @note Must not be called while other threads allocate from the arena.
+   */
+  void BeginFrame();
+
+  /**
+   * @brief Get the arena of the current frame.
+   *
+   * @return Arena that is valid until frames-in-flight more BeginFrame() calls
+   */
+  [[nodiscard]] LinearArena& GetCurrent() noexcept;
+
+  /**
+   * @brief Get an EASTL allocator bound to the current frame's arena.
+   *
+   * @return Allocator for containers that live no longer than the frame
+   */
+  [[nodiscard]] ArenaAllocator GetAllocator() noexcept;
+
+  /**
+   * @brief Get the number of frames in flight.
+   *
+   * @return Number of per-frame arenas
+   */
+  [[nodiscard]] std::uint32_t GetFramesInFlight() const noexcept;
+
+private:
+  /// One arena per frame in flight
+  std::vector<std::unique_ptr<LinearArena>> arenas_{};
+
+  /// Index of the current frame's arena
+  std::uint32_t current_{ 0U };
+};
+
+} // namespace maple::core
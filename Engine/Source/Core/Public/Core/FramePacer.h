@@ -0,0 +1,119 @@
+#pragma once
+
+// STL
+#include <chrono>
+
+// Core
+#include "Core/CoreExport.h"
+
+namespace maple::core {
+
+/**
+ * @brief Policies for limiting the frame rate.
+ */
+enum class PacingPolicy {
+  /// Start the next frame as soon as the previous one is done
+  Uncapped,
+
+  /// Wait until the target frame period has elapsed, sleeping for most of
+  /// the wait and spinning for the remainder to hit the deadline precisely
+  TargetFPS,
+
+  /// Do not wait; the blocking present of the swapchain (e.g. FIFO) paces
+  /// the loop
+  PresentDriven
+};
+
+/**
+ * @brief Configuration of the frame pacer.
+ */
+struct FramePacingConfig {
+  /// Frame rate limiting policy
+  PacingPolicy policy{ PacingPolicy::PresentDriven };
+
+  /// Target frame rate (TargetFPS policy only)
+  double target_fps{ 60.0 };
+};
+
+/**
+ * @brief High-resolution frame timer with frame rate limiting.
+ *
+ * Call BeginFrame() once at the top of every frame; it waits according to the
+ * pacing policy and returns the time elapsed since the previous frame began.
+ *
+ * @note Not thread-safe; use from the thread running the main loop.
+ */
+class MAPLE_CORE_API FramePacer {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  FramePacer(const FramePacer&) = delete;
+  FramePacer& operator=(const FramePacer&) = delete;
+  FramePacer(FramePacer&&) = delete;
+  FramePacer& operator=(FramePacer&&) = delete;
+
+  /**
+   * @brief Construct a pacer.
+   *
+   * @param config Pacing policy and target frame rate
+   */
+  explicit FramePacer(const FramePacingConfig& config = {});
+
+  /**
+   * @brief Wait for the next frame according to the policy and start it.
+   *
+   * @return Seconds elapsed since the previous frame began (0 for the first)
+   */
+  double BeginFrame();
+
+  /**
+   * @brief Change the pacing policy; takes effect on the next frame.
+   *
+   * @param config Pacing policy and target frame rate
+   */
+  void SetConfig(const FramePacingConfig& config);
+
+  /**
+   * @brief Get the current pacing configuration.
+   *
+   * @return Pacing policy and target frame rate
+   */
+  [[nodiscard]] const FramePacingConfig& GetConfig() const noexcept;
+
+  /**
+   * @brief Get the duration of the last frame.
+   *
+   * @return Seconds between the last two calls to BeginFrame()
+   */
+  [[nodiscard]] double GetDeltaTime() const noexcept;
+
+private:
+  /**
+   * @brief Sleep, then spin, until the deadline.
+   */
+  static void WaitUntil(Clock::time_point deadline);
+
+  /// Remaining wait below which the pacer spins instead of sleeping, to
+  /// absorb OS scheduler wake-up latency
+  static constexpr std::chrono::microseconds kSpinThreshold{ 2000 };
+
+  /// Pacing policy and target frame rate
+  FramePacingConfig config_{};
+
+  /// Frame period of the TargetFPS policy
+  Clock::duration period_{};
+
+  /// Start of the current frame
+  Clock::time_point frame_start_{};
+
+  /// Deadline of the next frame (TargetFPS policy only)
+  Clock::time_point next_deadline_{};
+
+  /// Duration of the last frame in seconds
+  double delta_time_{ 0.0 };
+
+  /// Whether BeginFrame() has been called before
+  bool started_{ false };
+};
+
+} // namespace maple::core
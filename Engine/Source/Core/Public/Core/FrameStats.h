@@ -0,0 +1,76 @@
+#pragma once
+
+// STL
+#include <array>
+#include <cstddef>
+
+// Core
+#include "Core/CoreExport.h"
+
+namespace maple::core {
+
+/**
+ * @brief Summary of recent frame times, in milliseconds.
+ */
+struct FrameTimeSummary {
+  /// Number of samples summarized
+  std::size_t sample_count{ 0U };
+
+  /// Arithmetic mean
+  double mean_ms{ 0.0 };
+
+  /// Median
+  double p50_ms{ 0.0 };
+
+  /// 99th percentile
+  double p99_ms{ 0.0 };
+
+  /// Longest frame
+  double max_ms{ 0.0 };
+};
+
+/**
+ * @brief Rolling window of frame-time samples.
+ *
+ * Recording a sample is O(1); percentiles are computed on demand from a copy
+ * of the window, so summaries are cheap enough to query a few times per
+ * second in shipping builds.
+ *
+ * @note Not thread-safe.
+ */
+class MAPLE_CORE_API FrameStats {
+public:
+  /// Number of most recent frames kept in the window
+  static constexpr std::size_t kSampleCount{ 512U };
+
+  /**
+   * @brief Record the duration of a frame.
+   *
+   * @param frame_time_ms Frame duration in milliseconds
+   */
+  void AddSample(double frame_time_ms) noexcept;
+
+  /**
+   * @brief Summarize the samples currently in the window.
+   *
+   * @return Mean, median, 99th percentile, and maximum frame time
+   */
+  [[nodiscard]] FrameTimeSummary GetSummary() const;
+
+  /**
+   * @brief Discard all samples.
+   */
+  void Reset() noexcept;
+
+private:
+  /// Ring of the most recent samples
+  std::array<double, kSampleCount> samples_{};
+
+  /// Slot the next sample is written to
+  std::size_t next_{ 0U };
+
+  /// Number of valid samples (at most kSampleCount)
+  std::size_t count_{ 0U };
+};
+
+} // namespace maple::core
@@ -0,0 +1,302 @@
+#pragma once
+
+// STL
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Core
+#include "Core/CoreExport.h"
+
+namespace maple::core {
+
+class JobCounter;
+
+/**
+ * @brief Unit of work executed by the job system.
+ *
+ * Jobs are fixed-size, store their callable inline, and live in per-thread
+ * rings, so scheduling does not touch the heap. Use JobSystem::Schedule()
+ * rather than filling jobs directly.
+ */
+struct alignas(64) Job {
+  /// Bytes available for the callable's captured state
+  static constexpr std::size_t kPayloadSize{ 48U };
+
+  /// Invokes and destroys the callable stored in the payload
+  void (*function)(Job& job){ nullptr };
+
+  /// Counter decremented once the job has run (may be null)
+  JobCounter* counter{ nullptr };
+
+  /// Whether the job's slot in its thread's job ring is still pending
+  std::atomic<bool> in_use{ false };
+
+  /// Whether the job was heap-allocated because its ring slot was in use
+  bool heap_allocated{ false };
+
+  /// Inline storage for the callable
+  alignas(std::max_align_t) std::byte payload[kPayloadSize];
+};
+
+/**
+ * @brief Counts outstanding jobs for fork/join synchronization.
+ *
+ * Each job scheduled against a counter increments it and decrements it once
+ * the job has run. Threads wait for a counter with JobSystem::Wait() (which
+ * runs other jobs in the meantime), and coroutines with `co_await counter`
+ * (see Core/Task.h).
+ *
+ * @note A counter may be destroyed as soon as it is done, but must not be
+ *       destroyed while jobs scheduled against it are still pending.
+ */
+class MAPLE_CORE_API JobCounter {
+public:
+  JobCounter(const JobCounter&) = delete;
+  JobCounter& operator=(const JobCounter&) = delete;
+  JobCounter(JobCounter&&) = delete;
+  JobCounter& operator=(JobCounter&&) = delete;
+
+  /**
+   * @brief Construct a counter.
+   *
+   * @param initial_value Initial number of outstanding jobs
+   */
+  explicit JobCounter(std::uint32_t initial_value = 0U) noexcept;
+
+  ~JobCounter();
+
+  /**
+   * @brief Add outstanding jobs.
+   *
+   * @param count Number of jobs to add
+   */
+  void Add(std::uint32_t count = 1U) noexcept;
+
+  /**
+   * @brief Mark one outstanding job as finished.
+   *
+   * When the count reaches zero, every coroutine waiting on the counter is
+   * scheduled for resumption.
+   */
+  void Decrement();
+
+  /**
+   * @brief Check whether all outstanding jobs have finished.
+   *
+   * @return true if the count is zero
+   */
+  [[nodiscard]] bool IsDone() const noexcept;
+
+  /**
+   * @brief Register a coroutine to resume once the count reaches zero.
+   *
+   * @param handle Suspended coroutine
+   * @return false if the count is already zero (the caller must not suspend)
+   */
+  bool AddWaiter(std::coroutine_handle<> handle);
+
+private:
+  /// Number of outstanding jobs
+  std::atomic<std::uint32_t> value_;
+
+  /// Guards the waiters and the transition to zero
+  mutable std::mutex mutex_{};
+
+  /// Coroutines waiting for the count to reach zero
+  std::vector<std::coroutine_handle<>> waiters_{};
+};
+
+/**
+ * @brief Work-stealing job scheduler.
+ *
+ * Static singleton interface, like Log. Initialize() starts one worker thread
+ * per additional hardware thread; the initializing thread participates as
+ * well whenever it waits. Every worker owns a Chase-Lev deque: it pops its
+ * own newest jobs and, when idle, steals the oldest jobs of other workers.
+ * Jobs scheduled from threads without a deque go through a shared queue.
+ *
+ * @par Example
+ * @code
+ * core::JobCounter counter{};
+ * core::JobSystem::Schedule([&] { SimulateCloth(); }, &counter);
+ * core::JobSystem::Schedule([&] { SimulateHair(); }, &counter);
+ * core::JobSystem::Wait(counter);
+ * @endcode
+ *
+ * @note Before Initialize() and after Shutdown(), jobs run immediately on the
+ *       scheduling thread. Jobs must not throw.
+ */
+class MAPLE_CORE_API JobSystem {
+public:
+  JobSystem() = delete;
+  JobSystem(const JobSystem&) = delete;
+  JobSystem& operator=(const JobSystem&) = delete;
+  JobSystem(JobSystem&&) = delete;
+  JobSystem& operator=(JobSystem&&) = delete;
+
+  /**
+   * @brief Start the worker threads.
+   *
+   * @param worker_count Number of worker threads to start, or 0 for one per
+   *                     hardware thread besides the calling thread
+   */
+  static void Initialize(std::uint32_t worker_count = 0U);
+
+  /**
+   * @brief Stop and join the worker threads.
+   *
+   * @note Every scheduled job must have been waited on.
+   */
+  static void Shutdown();
+
+  /**
+   * @brief Get the number of threads executing jobs.
+   *
+   * @return Worker threads plus the initializing thread (1 if not running)
+   */
+  [[nodiscard]] static std::uint32_t GetThreadCount() noexcept;
+
+  /**
+   * @brief Get the index of the calling thread among the job threads.
+   *
+   * Lets jobs pick per-thread state without locking. Threads that are not
+   * job threads may still run jobs while they wait, so callers must handle
+   * kNoThreadIndex.
+   *
+   * @return Index in [0, GetThreadCount()) (0 for the initializing thread),
+   *         or kNoThreadIndex if the thread is not a job thread
+   */
+  [[nodiscard]] static std::uint32_t GetThreadIndex() noexcept;
+
+  /**
+   * @brief Schedule a callable to run on any job thread.
+   *
+   * @param function Callable with signature void(); its captured state must
+   *                 fit in Job::kPayloadSize bytes (capture large state by
+   *                 reference or pointer)
+   * @param counter Counter to increment now and decrement after the job has
+   *                run (may be null)
+   */
+  template <typename Function>
+    requires std::invocable<std::decay_t<Function>&>
+  static void Schedule(Function&& function, JobCounter* counter = nullptr);
+
+  /**
+   * @brief Block until a counter reaches zero, running jobs in the meantime.
+   *
+   * @param counter Counter to wait for
+   */
+  static void Wait(const JobCounter& counter);
+
+  /**
+   * @brief Run a function over [0, count) split into chunks across threads.
+   *
+   * Blocks until every chunk has run; the calling thread runs chunks too.
+   * If the chunk run by the calling thread throws, the exception propagates
+   * once the scheduled chunks have finished.
+   *
+   * @param count Number of elements
+   * @param grain_size Minimum number of elements per chunk
+   * @param function Callable with signature void(std::size_t begin,
+   *                 std::size_t end)
+   */
+  template <typename Function>
+    requires std::invocable<Function&, std::size_t, std::size_t>
+  static void ParallelFor(std::size_t count, std::size_t grain_size,
+                          Function&& function);
+
+  /// Size of each thread's job ring and deque; jobs beyond this many in
+  /// flight per thread fall back to the heap and the shared queue
+  static constexpr std::size_t kMaxJobsPerThread{ 4096U };
+
+  /// Thread index of threads that are not job threads
+  static constexpr std::uint32_t kNoThreadIndex{ ~0U };
+
+private:
+  /// Upper bound on the number of chunks ParallelFor() creates
+  static constexpr std::size_t kMaxParallelForJobs{ 256U };
+
+  /**
+   * @brief Get the next job slot of the calling thread's job ring.
+   */
+  static Job& AllocateJob();
+
+  /**
+   * @brief Queue a filled job for execution.
+   */
+  static void Submit(Job& job);
+};
+
+template <typename Function>
+  requires std::invocable<std::decay_t<Function>&>
+void JobSystem::Schedule(Function&& function, JobCounter* counter) {
+  using Callable = std::decay_t<Function>;
+  static_assert(sizeof(Callable) <= Job::kPayloadSize,
+                "Job captures too much state; capture it by reference");
+  static_assert(alignof(Callable) <= alignof(std::max_align_t));
+
+  // Store the callable inline along with a thunk that runs and destroys it
+  Job& job{ AllocateJob() };
+  ::new (static_cast<void*>(job.payload)) Callable{
+    std::forward<Function>(function)
+  };
+  job.function = [](Job& self) {
+    auto* callable{
+      std::launder(reinterpret_cast<Callable*>(self.payload))
+    };
+    (*callable)();
+    callable->~Callable();
+  };
+  job.counter = counter;
+
+  if (counter) {
+    counter->Add();
+  }
+  Submit(job);
+}
+
+template <typename Function>
+  requires std::invocable<Function&, std::size_t, std::size_t>
+void JobSystem::ParallelFor(std::size_t count, std::size_t grain_size,
+                            Function&& function) {
+  if (count == 0U) {
+    return;
+  }
+
+  // Grow the chunks if there would be too many of them
+  const std::size_t chunk_size{ std::max({
+    grain_size, std::size_t{ 1U },
+    (count + kMaxParallelForJobs - 1U) / kMaxParallelForJobs
+  }) };
+
+  // Schedule every chunk but the last, which runs on the calling thread
+  JobCounter counter{};
+  std::size_t begin{ 0U };
+  for (; begin + chunk_size < count; begin += chunk_size) {
+    Schedule([&function, begin, chunk_size] {
+      function(begin, begin + chunk_size);
+    }, &counter);
+  }
+
+  // Scheduled chunks reference the counter and the function, so they must
+  // finish before an exception from the last chunk unwinds this frame
+  try {
+    function(begin, count);
+  } catch (...) {
+    Wait(counter);
+    throw;
+  }
+
+  Wait(counter);
+}
+
+} // namespace maple::core
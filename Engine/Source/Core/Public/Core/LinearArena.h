@@ -0,0 +1,227 @@
+#pragma once
+
+// STL
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Core
+#include "Core/CoreExport.h"
+
+namespace maple::core {
+
+/**
+ * @brief Thread-safe bump-pointer arena that is reset in bulk.
+ *
+ * Allocations are carved linearly out of one preallocated block with a single
+ * atomic compare-and-swap and are never freed individually; Reset() releases
+ * everything at once. Requests that do not fit in the block are served from
+ * heap overflow blocks, which are released on Reset() and reported so the
+ * capacity can be tuned.
+ */
+class MAPLE_CORE_API LinearArena {
+public:
+  LinearArena() = delete;
+  LinearArena(const LinearArena&) = delete;
+  LinearArena& operator=(const LinearArena&) = delete;
+  LinearArena(LinearArena&&) = delete;
+  LinearArena& operator=(LinearArena&&) = delete;
+
+  /**
+   * @brief Construct an arena with a preallocated block.
+   *
+   * @param capacity Size of the preallocated block in bytes
+   * @param name Name used when reporting overflow (must outlive the arena)
+   */
+  explicit LinearArena(std::size_t capacity,
+                       const char* name = "LinearArena");
+
+  ~LinearArena();
+
+  /**
+   * @brief Allocate uninitialized memory from the arena.
+   *
+   * @param size Number of bytes to allocate
+   * @param alignment Required alignment (must be a power of two)
+   * @return Pointer to the allocated memory, valid until the next Reset()
+   */
+  [[nodiscard]] void* Allocate(
+    std::size_t size,
+    std::size_t alignment = alignof(std::max_align_t)
+  );
+
+  /**
+   * @brief Release every allocation made since the last reset.
+   *
+   * @note Must not be called while other threads are allocating.
+   */
+  void Reset();
+
+  /**
+   * @brief Get the size of the preallocated block.
+   *
+   * @return Capacity in bytes
+   */
+  [[nodiscard]] std::size_t GetCapacity() const noexcept;
+
+  /**
+   * @brief Get the number of bytes allocated since the last reset.
+   *
+   * @return Bytes used in the block plus any overflow bytes
+   */
+  [[nodiscard]] std::size_t GetUsed() const noexcept;
+
+  /**
+   * @brief Get the highest usage observed at any reset.
+   *
+   * @return Peak bytes used between two resets
+   */
+  [[nodiscard]] std::size_t GetPeak() const noexcept;
+
+private:
+  /**
+   * @brief Serve an allocation that does not fit in the block from the heap.
+   */
+  void* AllocateOverflow(std::size_t size, std::size_t alignment);
+
+  /// Name used when reporting overflow
+  const char* name_;
+
+  /// Preallocated block
+  std::unique_ptr<std::byte[]> block_{ nullptr };
+
+  /// Size of the preallocated block in bytes
+  const std::size_t capacity_;
+
+  /// Current bump offset into the block
+  std::atomic<std::size_t> offset_{ 0U };
+
+  /// Guards the overflow blocks
+  std::mutex overflow_mutex_{};
+
+  /// Heap blocks serving allocations that did not fit
+  std::vector<std::unique_ptr<std::byte[]>> overflow_blocks_{};
+
+  /// Bytes requested from overflow blocks since the last reset
+  std::atomic<std::size_t> overflow_bytes_{ 0U };
+
+  /// Highest usage observed at any reset
+  std::size_t peak_{ 0U };
+};
+
+inline void* LinearArena::Allocate(std::size_t size, std::size_t alignment) {
+  const auto base{ reinterpret_cast<std::uintptr_t>(block_.get()) };
+  std::size_t offset{ offset_.load(std::memory_order_relaxed) };
+  for (;;) {
+    // Align the bump pointer, then claim the range
+    const std::uintptr_t aligned{
+      (base + offset + alignment - 1U) & ~(std::uintptr_t{ alignment } - 1U)
+    };
+    const std::size_t new_offset{ aligned - base + size };
+    if (new_offset > capacity_) {
+      return AllocateOverflow(size, alignment);
+    }
+    if (offset_.compare_exchange_weak(offset, new_offset,
+                                      std::memory_order_relaxed)) {
+      return reinterpret_cast<void*>(aligned);
+    }
+  }
+}
+
+/**
+ * @brief EASTL-compatible allocator backed by a LinearArena.
+ *
+ * Lets EASTL containers place their storage in an arena, e.g.
+ * @code
+ * eastl::vector<int, core::ArenaAllocator> values{
+ *   core::ArenaAllocator{ frame_arena.GetCurrent() }
+ * };
+ * @endcode
+ * Deallocation is a no-op; memory is reclaimed when the arena is reset, so
+ * containers must not outlive the arena's current frame.
+ *
+ * @note A default-constructed allocator has no arena and throws
+ *       std::bad_alloc on allocation. EASTL requires the default constructor.
+ */
+class MAPLE_CORE_API ArenaAllocator {
+public:
+  /**
+   * @brief Construct an allocator that is not bound to an arena.
+   *
+   * @param name Debug name reported by get_name()
+   */
+  explicit ArenaAllocator(const char* name = "ArenaAllocator") noexcept;
+
+  /**
+   * @brief Construct an allocator that allocates from the given arena.
+   *
+   * @param arena Arena to allocate from (must outlive all allocations)
+   * @param name Debug name reported by get_name()
+   */
+  explicit ArenaAllocator(LinearArena& arena,
+                          const char* name = "ArenaAllocator") noexcept;
+
+  ArenaAllocator(const ArenaAllocator& other) noexcept = default;
+
+  ArenaAllocator(const ArenaAllocator& other, const char* name) noexcept;
+
+  ArenaAllocator& operator=(const ArenaAllocator& other) noexcept = default;
+
+  /**
+   * @brief Allocate memory with default alignment.
+   *
+   * @param n Number of bytes to allocate
+   * @param flags EASTL allocation flags (unused)
+   * @return Pointer to the allocated memory
+   * @throws std::bad_alloc If the allocator is not bound to an arena
+   */
+  void* allocate(std::size_t n, int flags = 0);
+
+  /**
+   * @brief Allocate memory such that (pointer + offset) is aligned.
+   *
+   * @param n Number of bytes to allocate
+   * @param alignment Required alignment (must be a power of two)
+   * @param offset Offset from the returned pointer that must be aligned
+   * @param flags EASTL allocation flags (unused)
+   * @return Pointer to the allocated memory
+   * @throws std::bad_alloc If the allocator is not bound to an arena
+   */
+  void* allocate(std::size_t n, std::size_t alignment, std::size_t offset,
+                 int flags = 0);
+
+  /**
+   * @brief No-op; memory is reclaimed when the arena is reset.
+   */
+  void deallocate(void* p, std::size_t n) noexcept;
+
+  [[nodiscard]] const char* get_name() const noexcept;
+  void set_name(const char* name) noexcept;
+
+  /**
+   * @brief Get the arena this allocator allocates from.
+   *
+   * @return Non-owning pointer to the arena (null if unbound)
+   */
+  [[nodiscard]] LinearArena* GetArena() const noexcept;
+
+private:
+  /// Arena backing all allocations (null if unbound)
+  LinearArena* arena_{ nullptr };
+
+  /// Debug name
+  const char* name_;
+};
+
+/**
+ * @brief Allocators are interchangeable when they share an arena.
+ */
+MAPLE_CORE_API bool operator==(const ArenaAllocator& a,
+                               const ArenaAllocator& b) noexcept;
+MAPLE_CORE_API bool operator!=(const ArenaAllocator& a,
+                               const ArenaAllocator& b) noexcept;
+
+} // namespace maple::core
@@ -1,6 +1,7 @@
 #pragma once
 
 // STL
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -10,8 +11,62 @@
 // Core
 #include "Core/CoreExport.h"
 
+#ifdef MAPLE_LOG_BINARY
+  #include "Core/BinaryLog.h"
+#endif
+
+#if MAPLE_PROFILE_ENABLED
+  #include <type_traits>
+
+  #include "Core/Profiler.h"
+#endif
+
 namespace maple::core {
 
+/**
+ * @brief Delivery modes for log messages.
+ */
+enum class LogMode {
+  /// Messages are formatted and written to the console on the calling thread
+  Synchronous,
+
+  /// Messages are queued into a lock-free ring buffer and written to the
+  /// console by a dedicated background thread
+  Asynchronous
+};
+
+/**
+ * @brief Behavior of the asynchronous log queue when it is full.
+ */
+enum class LogOverflowPolicy {
+  /// Wait until the background thread frees a slot (no messages are lost)
+  Block,
+
+  /// Discard the message being logged
+  DropNewest,
+
+  /// Discard the oldest queued message to make room for the new one
+  OverwriteOldest
+};
+
+/**
+ * @brief Configuration for the logging system.
+ */
+struct LogConfig {
+  /// Delivery mode for all log categories
+  LogMode mode{ LogMode::Synchronous };
+
+  /// Behavior when the asynchronous queue is full (asynchronous mode only)
+  LogOverflowPolicy overflow_policy{ LogOverflowPolicy::Block };
+
+  /// Number of preallocated queue slots, rounded up to a power of two
+  /// (asynchronous mode only)
+  std::size_t queue_capacity{ 8192 };
+
+  /// Output path of the binary log file (MAPLE_LOG_BINARY builds only)
+  std::string binary_log_path{ "Maple.mlog" };
+};
+
 /**
  * @brief Global logging system initialization and shutdown.
  *
@@ -24,6 +79,12 @@ namespace maple::core {
  *   binary entirely for zero overhead. Configured in CMake.
  * - Runtime filtering (spdlog::set_level, configured by Initialize()) allows
  *   dynamic log level changes but still evaluates function arguments.
+ *
+ * @par Binary Logging
+ * Builds configured with the MAPLE_LOG_BINARY CMake option record messages as
+ * deferred binary events instead of formatting them (see BinaryLog). The
+ * binary log file is opened by Initialize() and decoded offline with the
+ * MapleLogDecoder tool.
  */
 class MAPLE_CORE_API Log {
 public:
@@ -34,15 +95,23 @@ public:
    * - Debug builds: spdlog::level::debug
    * - Release builds: spdlog::level::info
    *
+   * In asynchronous mode, all existing and future log categories are rerouted
+   * through a shared preallocated ring buffer that is drained by a background
+   * thread. Error and critical messages flush the queue before returning so
+   * they are never lost to a subsequent crash or exception.
+   *
+   * @param config Logging configuration (synchronous by default)
+   *
    * @note Must be called before any logging occurs.
    */
-  static void Initialize();
+  static void Initialize(const LogConfig& config = {});
 
   /**
    * @brief Shut down the logging system.
    *
    * Flushes all loggers and cleans up background threads. Ensures all pending
-   * log messages are written before termination.
+   * log messages, including those still queued in asynchronous mode, are
+   * written before termination.
    *
    * @note Must be called before program termination to prevent resource leaks.
    *       No logging should occur after calling this method.
@@ -69,7 +138,9 @@ public:
   /**
    * @brief Construct a log category with the given name.
    *
-   * Creates a color-enabled console logger for this category.
+   * Creates a color-enabled console logger for this category. If the logging
+   * system is already running in asynchronous mode, the logger writes to the
+   * shared asynchronous queue instead.
    *
    * @param name Category name (e.g., "LogApplication")
    *
@@ -110,6 +181,33 @@ public:
 #define MAPLE_DEFINE_LOG_CATEGORY(CategoryName) \
         maple::core::LogCategory CategoryName{ #CategoryName };
 
+/**
+ * @brief Route a log call to the active logging backend.
+ *
+ * By default, messages are formatted and written through the category's spdlog
+ * logger. When built with MAPLE_LOG_BINARY, messages are instead recorded as
+ * deferred binary events (see BinaryLog). Runtime level filtering applies to
+ * both backends. Used by the MAPLE_LOG_* macros; not intended for direct use.
+ *
+ * @param Category Log category instance (e.g., LogApplication)
+ * @param Level spdlog level of the message
+ * @param ... Format string and arguments (spdlog/fmt syntax)
+ */
+#ifdef MAPLE_LOG_BINARY
+  #define MAPLE_LOG_CALL_(Category, Level, ...) \
+          do { \
+            if ((Category).logger->should_log(Level)) { \
+              static maple::core::BinaryLogSite maple_log_site_{ \
+                (Category), (Level), __FILE__, __LINE__ \
+              }; \
+              maple::core::BinaryLog::Write(maple_log_site_, __VA_ARGS__); \
+            } \
+          } while (false)
+#else
+  #define MAPLE_LOG_CALL_(Category, Level, ...) \
+          SPDLOG_LOGGER_CALL((Category).logger, Level, __VA_ARGS__)
+#endif
+
 /**
  * @brief Log a trace-level message.
  *
@@ -120,8 +218,12 @@ public:
  * @param Category Log category instance (e.g., LogApplication)
  * @param ... Format string and arguments (spdlog/fmt syntax)
  */
-#define MAPLE_LOG_TRACE(Category, ...) \
-        SPDLOG_LOGGER_TRACE(Category.logger, __VA_ARGS__)
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+  #define MAPLE_LOG_TRACE(Category, ...) \
+          MAPLE_LOG_CALL_(Category, spdlog::level::trace, __VA_ARGS__)
+#else
+  #define MAPLE_LOG_TRACE(Category, ...) (void)0
+#endif
 
 /**
  * @brief Log a debug-level message.
@@ -133,8 +235,12 @@ public:
  * @param Category Log category instance (e.g., LogApplication)
  * @param ... Format string and arguments (spdlog/fmt syntax)
  */
-#define MAPLE_LOG_DEBUG(Category, ...) \
-        SPDLOG_LOGGER_DEBUG(Category.logger, __VA_ARGS__)
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+  #define MAPLE_LOG_DEBUG(Category, ...) \
+          MAPLE_LOG_CALL_(Category, spdlog::level::debug, __VA_ARGS__)
+#else
+  #define MAPLE_LOG_DEBUG(Category, ...) (void)0
+#endif
 
 /**
  * @brief Log an info-level message.
@@ -146,8 +252,12 @@ public:
  * @param Category Log category instance (e.g., LogApplication)
  * @param ... Format string and arguments (spdlog/fmt syntax)
  */
-#define MAPLE_LOG_INFO(Category, ...) \
-        SPDLOG_LOGGER_INFO(Category.logger, __VA_ARGS__)
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+  #define MAPLE_LOG_INFO(Category, ...) \
+          MAPLE_LOG_CALL_(Category, spdlog::level::info, __VA_ARGS__)
+#else
+  #define MAPLE_LOG_INFO(Category, ...) (void)0
+#endif
 
 /**
  * @brief Log a warning-level message.
@@ -159,8 +269,12 @@ public:
  * @param Category Log category instance (e.g., LogApplication)
  * @param ... Format string and arguments (spdlog/fmt syntax)
  */
-#define MAPLE_LOG_WARN(Category, ...) \
-        SPDLOG_LOGGER_WARN(Category.logger, __VA_ARGS__)
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
+  #define MAPLE_LOG_WARN(Category, ...) \
+          MAPLE_LOG_CALL_(Category, spdlog::level::warn, __VA_ARGS__)
+#else
+  #define MAPLE_LOG_WARN(Category, ...) (void)0
+#endif
 
 /**
  * @brief Log an error-level message.
@@ -172,8 +286,12 @@ public:
  * @param Category Log category instance (e.g., LogApplication)
  * @param ... Format string and arguments (spdlog/fmt syntax)
  */
-#define MAPLE_LOG_ERROR(Category, ...) \
-        SPDLOG_LOGGER_ERROR(Category.logger, __VA_ARGS__)
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR
+  #define MAPLE_LOG_ERROR(Category, ...) \
+          MAPLE_LOG_CALL_(Category, spdlog::level::err, __VA_ARGS__)
+#else
+  #define MAPLE_LOG_ERROR(Category, ...) (void)0
+#endif
 
 /**
  * @brief Log a critical-level message.
@@ -186,5 +304,52 @@ public:
  * @param Category Log category instance (e.g., LogApplication)
  * @param ... Format string and arguments (spdlog/fmt syntax)
  */
-#define MAPLE_LOG_CRITICAL(Category, ...) \
-        SPDLOG_LOGGER_CRITICAL(Category.logger, __VA_ARGS__)
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_CRITICAL
+  #define MAPLE_LOG_CRITICAL(Category, ...) \
+          MAPLE_LOG_CALL_(Category, spdlog::level::critical, __VA_ARGS__)
+#else
+  #define MAPLE_LOG_CRITICAL(Category, ...) (void)0
+#endif
+
+/**
+ * @brief Profile the enclosing scope as a named zone.
+ *
+ * Records the scope's begin and end timestamps with the Profiler. The zone is
+ * categorized by the subsystem's log category, so traces group zones the same
+ * way as log output. Compiled out entirely unless MAPLE_PROFILE_ENABLED is
+ * non-zero (configured by the MAPLE_PROFILE CMake option).
+ *
+ * @param Category Log category instance (e.g., LogRenderer)
+ * @param Name Zone name (string literal)
+ */
+#if MAPLE_PROFILE_ENABLED
+  #define MAPLE_PROFILE_CONCAT_INNER_(A, B) A##B
+  #define MAPLE_PROFILE_CONCAT_(A, B) MAPLE_PROFILE_CONCAT_INNER_(A, B)
+  #define MAPLE_PROFILE_SCOPE(Category, Name) \
+          static_assert(std::is_same_v<std::remove_cvref_t<decltype(Category)>, \
+                                       maple::core::LogCategory>, \
+                        "Profile zones are categorized by log category"); \
+          maple::core::ProfileScope MAPLE_PROFILE_CONCAT_( \
+            maple_profile_scope_, __LINE__ \
+          ){ #Category, Name }
+#else
+  #define MAPLE_PROFILE_SCOPE(Category, Name) (void)0
+#endif
+
+/**
+ * @brief Profile the enclosing function as a zone named after it.
+ *
+ * @param Category Log category instance (e.g., LogRenderer)
+ */
+#define MAPLE_PROFILE_FUNCTION(Category) MAPLE_PROFILE_SCOPE(Category, __func__)
+
+/**
+ * @brief Name the calling thread in profiler traces.
+ *
+ * @param Name Thread name (e.g., "Render")
+ */
+#if MAPLE_PROFILE_ENABLED
+  #define MAPLE_PROFILE_THREAD(Name) maple::core::Profiler::SetThreadName(Name)
+#else
+  #define MAPLE_PROFILE_THREAD(Name) (void)0
+#endif
@@ -0,0 +1,165 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+// Core
+#include "Core/CoreExport.h"
+#include "Core/TLSFAllocator.h"
+
+namespace maple::core {
+
+/**
+ * @brief Subsystem that owns an allocation, for tracking and budgets.
+ */
+enum class MemoryTag : std::uint8_t {
+  General,
+  Application,
+  Platform,
+  Renderer,
+  RHI,
+  ECS,
+  Count
+};
+
+/**
+ * @brief Get the display name of a memory tag.
+ *
+ * @param tag Memory tag
+ * @return Static, null-terminated name
+ */
+MAPLE_CORE_API const char* GetMemoryTagName(MemoryTag tag) noexcept;
+
+/**
+ * @brief Allocation statistics of one memory tag.
+ */
+struct MemoryStats {
+  /// Bytes currently allocated
+  std::size_t current_bytes{ 0U };
+
+  /// Highest value of current_bytes observed
+  std::size_t peak_bytes{ 0U };
+
+  /// Number of allocations not yet freed
+  std::size_t live_allocations{ 0U };
+
+  /// Number of allocations made since startup
+  std::size_t total_allocations{ 0U };
+
+  /// Budget in bytes (0 if unlimited)
+  std::size_t budget_bytes{ 0U };
+};
+
+/**
+ * @brief Tagged engine heap.
+ *
+ * Small requests are served from fixed-size pools, one per size class; larger
+ * and over-aligned requests from a TLSF heap that grows in large pools; very
+ * large requests directly from the system. Allocation and free are O(1) on
+ * every path except heap growth.
+ *
+ * Every allocation carries a MemoryTag so per-subsystem usage can be queried
+ * and checked against a budget. Exceeding a budget is reported, not enforced.
+ *
+ * @note Thread-safe. State is created on first use and intentionally never
+ *       destroyed so that objects freed during static destruction are safe.
+ */
+class MAPLE_CORE_API Memory {
+public:
+  Memory() = delete;
+  Memory(const Memory&) = delete;
+  Memory& operator=(const Memory&) = delete;
+  Memory(Memory&&) = delete;
+  Memory& operator=(Memory&&) = delete;
+
+  /**
+   * @brief Allocate uninitialized memory.
+   *
+   * @param size Number of bytes to allocate
+   * @param alignment Required alignment (must be a power of two)
+   * @param tag Subsystem charged for the allocation
+   * @return Pointer to the allocated memory
+   * @throws std::bad_alloc If the system is out of memory
+   */
+  [[nodiscard]] static void* Allocate(
+    std::size_t size,
+    std::size_t alignment = alignof(std::max_align_t),
+    MemoryTag tag = MemoryTag::General
+  );
+
+  /**
+   * @brief Free memory returned by Allocate().
+   *
+   * @param ptr Pointer to free (null is ignored)
+   */
+  static void Free(void* ptr) noexcept;
+
+  /**
+   * @brief Set a soft budget for a tag; crossing it logs a warning.
+   *
+   * @param tag Memory tag
+   * @param budget_bytes Budget in bytes (0 for unlimited)
+   */
+  static void SetBudget(MemoryTag tag, std::size_t budget_bytes) noexcept;
+
+  /**
+   * @brief Get allocation statistics of a tag.
+   *
+   * @param tag Memory tag
+   * @return Snapshot of the tag's statistics
+   */
+  [[nodiscard]] static MemoryStats GetStats(MemoryTag tag) noexcept;
+
+  /**
+   * @brief Get fragmentation statistics of the TLSF heap.
+   *
+   * @return Snapshot of the heap statistics (walks every heap block)
+   */
+  [[nodiscard]] static TLSFStats GetHeapStats() noexcept;
+};
+
+/**
+ * @brief Mixin routing a class's dynamic allocations to the tagged heap.
+ *
+ * Derive from it to make `new`, `std::make_unique`, and friends allocate the
+ * class (and subclasses) through Memory, charged to the given tag:
+ * @code
+ * class Window : public core::TrackedAllocation<core::MemoryTag::Platform> {};
+ * @endcode
+ *
+ * @tparam Tag Subsystem charged for instances
+ */
+template <MemoryTag Tag>
+class TrackedAllocation {
+public:
+  [[nodiscard]] static void* operator new(std::size_t size) {
+    return Memory::Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, Tag);
+  }
+
+  [[nodiscard]] static void* operator new(std::size_t size,
+                                          std::align_val_t alignment) {
+    return Memory::Allocate(size, static_cast<std::size_t>(alignment), Tag);
+  }
+
+  [[nodiscard]] static void* operator new(std::size_t, void* ptr) noexcept {
+    return ptr;
+  }
+
+  static void operator delete(void* ptr) noexcept {
+    Memory::Free(ptr);
+  }
+
+  static void operator delete(void* ptr, std::align_val_t) noexcept {
+    Memory::Free(ptr);
+  }
+
+  static void operator delete(void*, void*) noexcept {}
+
+protected:
+  TrackedAllocation() = default;
+  ~TrackedAllocation() = default;
+};
+
+} // namespace maple::core
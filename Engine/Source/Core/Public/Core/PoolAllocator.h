@@ -0,0 +1,106 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Core
+#include "Core/CoreExport.h"
+
+namespace maple::core {
+
+/**
+ * @brief Fixed-size block pool with O(1) allocation and free.
+ *
+ * Blocks are carved out of pages allocated on demand and recycled through an
+ * intrusive free list, so fragmentation is bounded by the block size and no
+ * memory is returned to the system until the pool is destroyed.
+ *
+ * @note Not thread-safe; callers must provide their own synchronization.
+ */
+class MAPLE_CORE_API PoolAllocator {
+public:
+  PoolAllocator() = delete;
+  PoolAllocator(const PoolAllocator&) = delete;
+  PoolAllocator& operator=(const PoolAllocator&) = delete;
+  PoolAllocator(PoolAllocator&&) = delete;
+  PoolAllocator& operator=(PoolAllocator&&) = delete;
+
+  /**
+   * @brief Construct an empty pool.
+   *
+   * @param block_size Size of every block in bytes (rounded up to 16)
+   * @param blocks_per_page Number of blocks allocated at once when the pool
+   *                        runs out of free blocks
+   */
+  PoolAllocator(std::size_t block_size, std::size_t blocks_per_page);
+
+  ~PoolAllocator();
+
+  /**
+   * @brief Allocate a block, growing the pool by one page if necessary.
+   *
+   * @return Pointer to a 16-byte aligned block
+   */
+  [[nodiscard]] void* Allocate();
+
+  /**
+   * @brief Return a block to the pool.
+   *
+   * @param block Block previously returned by Allocate() on this pool
+   */
+  void Free(void* block) noexcept;
+
+  /**
+   * @brief Get the size of every block.
+   *
+   * @return Block size in bytes
+   */
+  [[nodiscard]] std::size_t GetBlockSize() const noexcept;
+
+  /**
+   * @brief Get the number of blocks currently allocated.
+   *
+   * @return Number of live blocks
+   */
+  [[nodiscard]] std::size_t GetUsedBlocks() const noexcept;
+
+  /**
+   * @brief Get the total memory reserved by the pool's pages.
+   *
+   * @return Reserved bytes
+   */
+  [[nodiscard]] std::size_t GetReservedBytes() const noexcept;
+
+private:
+  /// Free blocks store the link to the next free block in place
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  /// Block alignment and size granularity
+  static constexpr std::size_t kBlockAlignment{ 16U };
+
+  /**
+   * @brief Allocate a new page and push its blocks onto the free list.
+   */
+  void AddPage();
+
+  /// Size of every block in bytes
+  const std::size_t block_size_;
+
+  /// Number of blocks per page
+  const std::size_t blocks_per_page_;
+
+  /// Head of the intrusive free list
+  FreeBlock* free_list_{ nullptr };
+
+  /// Pages owned by the pool
+  std::vector<std::unique_ptr<std::byte[]>> pages_{};
+
+  /// Number of live blocks
+  std::size_t used_blocks_{ 0U };
+};
+
+} // namespace maple::core
@@ -0,0 +1,49 @@
+#pragma once
+
+// STL
+#include <cstddef>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+  #include <intrin.h>
+#endif
+
+namespace maple::core {
+
+/// Size of a cache line on the platforms the engine targets
+inline constexpr std::size_t kCacheLineSize{ 64U };
+
+/**
+ * @brief Hint that a cache line will soon be read.
+ *
+ * Used ahead of data the hardware prefetcher cannot predict, such as the
+ * next block of a chain of separately allocated blocks. The hint never
+ * faults, so any address may be passed.
+ *
+ * @param address Any address in the cache line
+ */
+inline void PrefetchRead(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address, 0, 3);
+#elif defined(_M_X64) || defined(_M_IX86)
+  _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#elif defined(_M_ARM64)
+  __prefetch(address);
+#else
+  (void)address;
+#endif
+}
+
+/**
+ * @brief Hint that a cache line will soon be written.
+ *
+ * @param address Any address in the cache line
+ */
+inline void PrefetchWrite(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address, 1, 3);
+#else
+  PrefetchRead(address);
+#endif
+}
+
+} // namespace maple::core
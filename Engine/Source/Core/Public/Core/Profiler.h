@@ -0,0 +1,157 @@
+#pragma once
+
+// STL
+#include <cstdint>
+#include <string>
+
+// Core
+#include "Core/CoreExport.h"
+
+namespace maple::core {
+
+/**
+ * @brief Hierarchical CPU profiler with Chrome trace export.
+ *
+ * Static singleton interface, like Log. Scoped zones (see the MAPLE_PROFILE_*
+ * macros in Core/Log.h) record their begin and end timestamps into a
+ * lock-free ring owned by the calling thread. Rings keep the most recent
+ * kEventsPerThread zones of every thread and overwrite older ones, so the
+ * profiler acts as an always-on flight recorder that can be dumped on demand
+ * with WriteChromeTrace(). Zones nest by time, which trace viewers display as
+ * a hierarchy per thread.
+ *
+ * Zones timed elsewhere (e.g., on the GPU) are recorded on named tracks,
+ * which the trace shows next to the threads.
+ *
+ * @note Zone and category names must be string literals or otherwise outlive
+ *       the profiler; only their pointers are recorded.
+ */
+class MAPLE_CORE_API Profiler {
+public:
+  Profiler() = delete;
+  Profiler(const Profiler&) = delete;
+  Profiler& operator=(const Profiler&) = delete;
+  Profiler(Profiler&&) = delete;
+  Profiler& operator=(Profiler&&) = delete;
+
+  /**
+   * @brief Enable or disable recording at runtime (enabled by default).
+   *
+   * @param enabled Whether zones should be recorded
+   */
+  static void SetEnabled(bool enabled) noexcept;
+
+  /**
+   * @brief Check whether zones are being recorded.
+   *
+   * @return true if recording is enabled
+   */
+  [[nodiscard]] static bool IsEnabled() noexcept;
+
+  /**
+   * @brief Name the calling thread in exported traces.
+   *
+   * @param name Thread name (e.g., "Main", "Render", "Worker 3")
+   */
+  static void SetThreadName(const std::string& name);
+
+  /**
+   * @brief Get the current profiler timestamp.
+   *
+   * @return Steady clock time in nanoseconds
+   */
+  [[nodiscard]] static std::int64_t Now() noexcept;
+
+  /**
+   * @brief Record a completed zone on the calling thread.
+   *
+   * @param category Category name (e.g., "LogRenderer")
+   * @param name Zone name
+   * @param start_ns Begin timestamp from Now()
+   * @param end_ns End timestamp from Now()
+   */
+  static void Record(const char* category, const char* name,
+                     std::int64_t start_ns, std::int64_t end_ns) noexcept;
+
+  /**
+   * @brief Create a track for zones that did not run on a CPU thread.
+   *
+   * Tracks live until the program exits.
+   *
+   * @param name Track name in exported traces (e.g., "GPU Graphics")
+   * @return Track to record on
+   * @throws std::runtime_error If kMaxTracks tracks exist already
+   */
+  [[nodiscard]] static std::uint32_t CreateTrack(const std::string& name);
+
+  /**
+   * @brief Record a completed zone on a track.
+   *
+   * Each track must be recorded on by one thread at a time.
+   *
+   * @param track Track returned by CreateTrack() (other values are ignored)
+   * @param category Category name (e.g., "GPU")
+   * @param name Zone name
+   * @param start_ns Begin timestamp on the Now() clock
+   * @param end_ns End timestamp on the Now() clock
+   */
+  static void RecordOnTrack(std::uint32_t track, const char* category,
+                            const char* name, std::int64_t start_ns,
+                            std::int64_t end_ns) noexcept;
+
+  /**
+   * @brief Write the recorded zones of every thread as Chrome trace JSON.
+   *
+   * The file can be opened in chrome://tracing or https://ui.perfetto.dev.
+   * Threads may keep recording while the trace is written. Zones of threads
+   * that have exited are written to one trace only, after which their rings
+   * are released.
+   *
+   * @param path Output file path
+   * @throws std::runtime_error If the file cannot be written
+   */
+  static void WriteChromeTrace(const std::string& path);
+
+  /// Number of most recent zones kept per thread and per track
+  static constexpr std::size_t kEventsPerThread{ 16384U };
+
+  /// Most tracks CreateTrack() creates
+  static constexpr std::uint32_t kMaxTracks{ 16U };
+};
+
+/**
+ * @brief RAII zone that records its lifetime with the profiler.
+ *
+ * @note Use the MAPLE_PROFILE_SCOPE and MAPLE_PROFILE_FUNCTION macros instead
+ *       of instantiating this class directly.
+ */
+class ProfileScope {
+public:
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+  ProfileScope(ProfileScope&&) = delete;
+  ProfileScope& operator=(ProfileScope&&) = delete;
+
+  ProfileScope(const char* category, const char* name) noexcept
+    : category_{ category }
+    , name_{ name }
+    , start_ns_{ Profiler::IsEnabled() ? Profiler::Now() : -1 } {}
+
+  ~ProfileScope() {
+    if (start_ns_ >= 0) {
+      Profiler::Record(category_, name_, start_ns_, Profiler::Now());
+    }
+  }
+
+private:
+  /// Category name
+  const char* category_;
+
+  /// Zone name
+  const char* name_;
+
+  /// Begin timestamp (negative if recording was disabled)
+  std::int64_t start_ns_;
+};
+
+} // namespace maple::core
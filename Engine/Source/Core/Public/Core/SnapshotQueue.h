@@ -0,0 +1,131 @@
+#pragma once
+
+// STL
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace maple::core {
+
+/**
+ * @brief Bounded single-producer, single-consumer ring of frame snapshots.
+ *
+ * Hands per-frame data from one thread to another through a fixed set of
+ * preallocated slots (two for double buffering, three for triple buffering).
+ * The producer blocks while every slot is either published or being read, so
+ * it can run at most kSlotCount frames ahead of the consumer; slots are
+ * reused in place and never reallocated.
+ *
+ * @code
+ * // Producer
+ * if (FrameData* data{ queue.BeginWrite() }) {
+ *   Fill(*data);
+ *   queue.EndWrite();
+ * }
+ *
+ * // Consumer
+ * while (const FrameData* data{ queue.BeginRead() }) {
+ *   Consume(*data);
+ *   queue.EndRead();
+ * }
+ * @endcode
+ *
+ * @tparam T Snapshot type
+ * @tparam kSlotCount Number of slots
+ */
+template <typename T, std::size_t kSlotCount>
+class SnapshotQueue {
+  static_assert(kSlotCount >= 2U, "Snapshot queues need at least two slots");
+
+public:
+  SnapshotQueue(const SnapshotQueue&) = delete;
+  SnapshotQueue& operator=(const SnapshotQueue&) = delete;
+  SnapshotQueue(SnapshotQueue&&) = delete;
+  SnapshotQueue& operator=(SnapshotQueue&&) = delete;
+
+  SnapshotQueue() = default;
+
+  /**
+   * @brief Wait for a free slot to write the next snapshot into.
+   *
+   * @return Slot to fill, or null once the queue is closed
+   */
+  [[nodiscard]] T* BeginWrite() {
+    std::unique_lock lock{ mutex_ };
+    cv_.wait(lock, [this] { return count_ < kSlotCount || closed_; });
+    return closed_ ? nullptr : &slots_[write_index_];
+  }
+
+  /**
+   * @brief Publish the slot returned by BeginWrite() to the consumer.
+   */
+  void EndWrite() {
+    {
+      std::lock_guard lock{ mutex_ };
+      write_index_ = (write_index_ + 1U) % kSlotCount;
+      ++count_;
+    }
+    cv_.notify_all();
+  }
+
+  /**
+   * @brief Wait for the oldest published snapshot.
+   *
+   * @return Snapshot to consume, or null once the queue is closed and empty
+   */
+  [[nodiscard]] const T* BeginRead() {
+    std::unique_lock lock{ mutex_ };
+    cv_.wait(lock, [this] { return count_ > 0U || closed_; });
+    return count_ > 0U ? &slots_[read_index_] : nullptr;
+  }
+
+  /**
+   * @brief Return the slot returned by BeginRead() to the producer.
+   */
+  void EndRead() {
+    {
+      std::lock_guard lock{ mutex_ };
+      read_index_ = (read_index_ + 1U) % kSlotCount;
+      --count_;
+    }
+    cv_.notify_all();
+  }
+
+  /**
+   * @brief Close the queue, waking both sides.
+   *
+   * The consumer still drains snapshots published before closing.
+   */
+  void Close() {
+    {
+      std::lock_guard lock{ mutex_ };
+      closed_ = true;
+    }
+    cv_.notify_all();
+  }
+
+private:
+  /// Guards the indices, count, and closed flag
+  std::mutex mutex_{};
+
+  /// Signals slot publication, release, and closing
+  std::condition_variable cv_{};
+
+  /// Preallocated snapshots
+  std::array<T, kSlotCount> slots_{};
+
+  /// Slot the producer writes next
+  std::size_t write_index_{ 0U };
+
+  /// Slot the consumer reads next
+  std::size_t read_index_{ 0U };
+
+  /// Number of published or in-use slots
+  std::size_t count_{ 0U };
+
+  /// Whether the queue has been closed
+  bool closed_{ false };
+};
+
+} // namespace maple::core
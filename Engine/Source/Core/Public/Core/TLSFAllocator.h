@@ -0,0 +1,206 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <cstdint>
+
+// Core
+#include "Core/CoreExport.h"
+
+namespace maple::core {
+
+/**
+ * @brief Statistics of a TLSF heap.
+ */
+struct TLSFStats {
+  /// Bytes handed to the heap through AddPool()
+  std::size_t pool_bytes{ 0U };
+
+  /// Payload bytes of allocated blocks
+  std::size_t used_bytes{ 0U };
+
+  /// Payload bytes of free blocks
+  std::size_t free_bytes{ 0U };
+
+  /// Payload bytes of the largest free block
+  std::size_t largest_free_block{ 0U };
+
+  /// Number of allocated blocks
+  std::size_t used_blocks{ 0U };
+
+  /// Number of free blocks
+  std::size_t free_blocks{ 0U };
+};
+
+/**
+ * @brief Two-level segregated fit (TLSF) general-purpose heap.
+ *
+ * Free blocks are kept in segregated lists indexed by a first level (power of
+ * two) and a second level (32 linear subdivisions of that power of two). Two
+ * bitmaps locate a suitable list with bit scans, so allocation and free are
+ * O(1) with bounded fragmentation. Adjacent free blocks are coalesced
+ * immediately on free.
+ *
+ * The heap manages memory handed to it through AddPool() and never allocates
+ * on its own; callers add pools when Allocate() fails.
+ *
+ * @note Not thread-safe; callers must provide their own synchronization.
+ */
+class MAPLE_CORE_API TLSFAllocator {
+public:
+  TLSFAllocator(const TLSFAllocator&) = delete;
+  TLSFAllocator& operator=(const TLSFAllocator&) = delete;
+  TLSFAllocator(TLSFAllocator&&) = delete;
+  TLSFAllocator& operator=(TLSFAllocator&&) = delete;
+
+  /**
+   * @brief Construct a heap without any pools.
+   */
+  TLSFAllocator() noexcept;
+
+  ~TLSFAllocator();
+
+  /**
+   * @brief Hand a region of memory to the heap.
+   *
+   * @param memory Start of the region (must outlive the heap)
+   * @param size Size of the region in bytes
+   * @return false if the region is too small to hold a block
+   */
+  bool AddPool(void* memory, std::size_t size) noexcept;
+
+  /**
+   * @brief Allocate a block.
+   *
+   * @param size Number of bytes to allocate
+   * @param alignment Required alignment (must be a power of two)
+   * @return Pointer to the block, or null if no free block is large enough
+   */
+  [[nodiscard]] void* Allocate(std::size_t size,
+                               std::size_t alignment = kAlignment) noexcept;
+
+  /**
+   * @brief Return a block to the heap, coalescing it with free neighbors.
+   *
+   * @param ptr Pointer previously returned by Allocate() on this heap
+   */
+  void Free(void* ptr) noexcept;
+
+  /**
+   * @brief Get the usable size of an allocated block.
+   *
+   * @param ptr Pointer previously returned by Allocate() on this heap
+   * @return Usable size in bytes (at least the requested size)
+   */
+  [[nodiscard]] static std::size_t GetBlockSize(const void* ptr) noexcept;
+
+  /**
+   * @brief Compute heap statistics by walking all pools.
+   *
+   * @return Current statistics (O(number of blocks))
+   */
+  [[nodiscard]] TLSFStats GetStats() const noexcept;
+
+  /// Minimum alignment of every block
+  static constexpr std::size_t kAlignment{ 16U };
+
+  /// Per-block bookkeeping overhead in bytes
+  static constexpr std::size_t kBlockOverhead{ 16U };
+
+  /// Per-pool bookkeeping overhead in bytes (alignment slack and sentinel)
+  static constexpr std::size_t kPoolOverhead{ kAlignment + 2U * kBlockOverhead };
+
+private:
+  /**
+   * @brief Block header preceding every block's payload.
+   *
+   * The free-list links are only valid while the block is free and overlap
+   * the first bytes of the payload otherwise.
+   */
+  struct Block {
+    /// Physically preceding block (null for the first block of a pool)
+    Block* prev_physical;
+
+    /// Payload size in bytes; the lowest bit marks free blocks
+    std::size_t size_and_flags;
+
+    /// Next block in the same free list
+    Block* next_free;
+
+    /// Previous block in the same free list
+    Block* prev_free;
+
+    [[nodiscard]] std::size_t GetSize() const noexcept;
+    void SetSize(std::size_t size) noexcept;
+    [[nodiscard]] bool IsFree() const noexcept;
+    void SetFree(bool free) noexcept;
+    [[nodiscard]] Block* GetNextPhysical() const noexcept;
+    [[nodiscard]] void* GetPayload() noexcept;
+    [[nodiscard]] static Block* FromPayload(const void* ptr) noexcept;
+  };
+
+  /// Number of second-level subdivisions per first level (log2)
+  static constexpr std::uint32_t kSecondLevelLog2{ 5U };
+  static constexpr std::uint32_t kSecondLevelCount{ 1U << kSecondLevelLog2 };
+
+  /// Sizes below this are mapped linearly into first level 0
+  static constexpr std::uint32_t kFirstLevelShift{ kSecondLevelLog2 + 4U };
+  static constexpr std::size_t kSmallBlockSize{ std::size_t{ 1U }
+                                                << kFirstLevelShift };
+
+  /// Largest supported block size is 2^kFirstLevelMax bytes
+  static constexpr std::uint32_t kFirstLevelMax{ 40U };
+  static constexpr std::uint32_t kFirstLevelCount{
+    kFirstLevelMax - kFirstLevelShift + 1U
+  };
+
+  /// Smallest payload, large enough to hold the free-list links
+  static constexpr std::size_t kMinBlockSize{ 16U };
+
+  /**
+   * @brief Map a block size to the free list that holds it.
+   */
+  static void MappingInsert(std::size_t size, std::uint32_t& fl,
+                            std::uint32_t& sl) noexcept;
+
+  /**
+   * @brief Map a requested size to the first list whose blocks all fit it.
+   */
+  static void MappingSearch(std::size_t size, std::uint32_t& fl,
+                            std::uint32_t& sl) noexcept;
+
+  /**
+   * @brief Find and unlink a free block of at least the given size.
+   */
+  Block* LocateFreeBlock(std::size_t size) noexcept;
+
+  void InsertFreeBlock(Block* block) noexcept;
+  void RemoveFreeBlock(Block* block) noexcept;
+
+  /**
+   * @brief Split off the tail of a block beyond size as a new free block.
+   */
+  void TrimTrailing(Block* block, std::size_t size) noexcept;
+
+  /**
+   * @brief Merge a free block with its free physical neighbors.
+   */
+  Block* Coalesce(Block* block) noexcept;
+
+  /// Bit f set if any list in first level f is non-empty
+  std::uint32_t first_level_bitmap_{ 0U };
+
+  /// Bit s of entry f set if list [f][s] is non-empty
+  std::uint32_t second_level_bitmaps_[kFirstLevelCount]{};
+
+  /// Heads of the segregated free lists
+  Block* free_lists_[kFirstLevelCount][kSecondLevelCount]{};
+
+  /// First block of every pool, for statistics
+  static constexpr std::size_t kMaxPools{ 64U };
+  Block* pools_[kMaxPools]{};
+  std::size_t pool_count_{ 0U };
+  std::size_t pool_bytes_{ 0U };
+};
+
+} // namespace maple::core
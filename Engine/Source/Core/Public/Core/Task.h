@@ -0,0 +1,341 @@
+#pragma once
+
+// STL
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+// Core
+#include "Core/JobSystem.h"
+
+namespace maple::core {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+/**
+ * @brief Promise state shared by every Task result type.
+ */
+struct TaskPromiseBase {
+  /**
+   * @brief Resumes the awaiting coroutine when the task finishes.
+   */
+  struct FinalAwaiter {
+    bool await_ready() const noexcept {
+      return false;
+    }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(
+      std::coroutine_handle<Promise> handle
+    ) noexcept {
+      return handle.promise().continuation;
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  std::suspend_always initial_suspend() const noexcept {
+    return {};
+  }
+
+  FinalAwaiter final_suspend() const noexcept {
+    return {};
+  }
+
+  void unhandled_exception() noexcept {
+    exception = std::current_exception();
+  }
+
+  /// Coroutine to resume when the task finishes
+  std::coroutine_handle<> continuation{ std::noop_coroutine() };
+
+  /// Exception thrown by the task body, rethrown to the awaiter
+  std::exception_ptr exception{};
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase {
+  Task<T> get_return_object() noexcept;
+
+  template <typename U>
+  void return_value(U&& value) {
+    result.emplace(std::forward<U>(value));
+  }
+
+  T TakeResult() {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+    return std::move(*result);
+  }
+
+  /// Value produced by co_return
+  std::optional<T> result{};
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+  Task<void> get_return_object() noexcept;
+
+  void return_void() const noexcept {}
+
+  void TakeResult() const {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+};
+
+/**
+ * @brief Fire-and-forget coroutine that frees itself when it finishes.
+ */
+struct DetachedTask {
+  struct promise_type {
+    DetachedTask get_return_object() noexcept {
+      return DetachedTask{
+        std::coroutine_handle<promise_type>::from_promise(*this)
+      };
+    }
+
+    std::suspend_always initial_suspend() const noexcept {
+      return {};
+    }
+
+    std::suspend_never final_suspend() const noexcept {
+      return {};
+    }
+
+    void return_void() const noexcept {}
+
+    void unhandled_exception() const noexcept {
+      std::terminate();
+    }
+  };
+
+  std::coroutine_handle<promise_type> handle;
+};
+
+/**
+ * @brief Run a task to completion, then signal a counter.
+ */
+inline DetachedTask RunAndSignal(Task<void> task, JobCounter& counter);
+
+template <typename T>
+struct SyncWaitResult {
+  std::optional<T> value{};
+  std::exception_ptr exception{};
+};
+
+template <>
+struct SyncWaitResult<void> {
+  std::exception_ptr exception{};
+};
+
+/**
+ * @brief Run a task and store its result or exception.
+ */
+template <typename T>
+Task<void> CaptureResult(Task<T> task, SyncWaitResult<T>& result);
+
+} // namespace detail
+
+/**
+ * @brief Lazily started coroutine task.
+ *
+ * A task does not run until it is awaited, and then runs on the awaiting
+ * thread; the awaiting coroutine resumes through symmetric transfer when the
+ * task finishes. To run tasks in parallel, Spawn() them onto the job system
+ * and `co_await` their counter:
+ * @code
+ * core::Task<> BuildScene(Scene& scene) {
+ *   core::JobCounter counter{};
+ *   core::Spawn(LoadMeshes(scene), counter);
+ *   core::Spawn(LoadTextures(scene), counter);
+ *   co_await counter;
+ *   co_return;
+ * }
+ * @endcode
+ *
+ * @tparam T Result type
+ */
+template <typename T>
+class [[nodiscard]] Task {
+public:
+  using promise_type = detail::TaskPromise<T>;
+
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  Task(Task&& other) noexcept
+    : handle_{ std::exchange(other.handle_, nullptr) } {}
+
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      if (handle_) {
+        handle_.destroy();
+      }
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  ~Task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  /**
+   * @brief Start the task and suspend the caller until it finishes.
+   *
+   * @return Awaiter producing the task's result (or rethrowing its exception)
+   */
+  auto operator co_await() && noexcept {
+    struct Awaiter {
+      bool await_ready() const noexcept {
+        return !handle || handle.done();
+      }
+
+      std::coroutine_handle<> await_suspend(
+        std::coroutine_handle<> awaiting
+      ) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+      }
+
+      T await_resume() {
+        return handle.promise().TakeResult();
+      }
+
+      std::coroutine_handle<promise_type> handle;
+    };
+    return Awaiter{ handle_ };
+  }
+
+private:
+  friend promise_type;
+
+  explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+    : handle_{ handle } {}
+
+  /// Owned coroutine frame
+  std::coroutine_handle<promise_type> handle_{ nullptr };
+};
+
+/**
+ * @brief Suspend until all jobs of a counter have finished.
+ *
+ * The coroutine is resumed by a job thread once the counter reaches zero.
+ */
+inline auto operator co_await(JobCounter& counter) noexcept {
+  struct Awaiter {
+    bool await_ready() const noexcept {
+      return counter.IsDone();
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+      return counter.AddWaiter(handle);
+    }
+
+    void await_resume() const noexcept {}
+
+    JobCounter& counter;
+  };
+  return Awaiter{ counter };
+}
+
+/**
+ * @brief Move the awaiting coroutine onto a job thread.
+ *
+ * @code
+ * co_await core::SwitchToJobThread();  // continues as a scheduled job
+ * @endcode
+ */
+inline auto SwitchToJobThread() noexcept {
+  struct Awaiter {
+    bool await_ready() const noexcept {
+      return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+      JobSystem::Schedule([handle] { handle.resume(); });
+    }
+
+    void await_resume() const noexcept {}
+  };
+  return Awaiter{};
+}
+
+/**
+ * @brief Run a task concurrently as a job.
+ *
+ * @param task Task to run (exceptions escaping it terminate the program)
+ * @param counter Counter incremented now and decremented once the task is done
+ */
+inline void Spawn(Task<void> task, JobCounter& counter) {
+  counter.Add();
+  const auto handle{ detail::RunAndSignal(std::move(task), counter).handle };
+  JobSystem::Schedule([handle] { handle.resume(); });
+}
+
+/**
+ * @brief Run a task on the job system and block until it finishes.
+ *
+ * The calling thread runs other jobs while it waits.
+ *
+ * @param task Task to run
+ * @return The task's result
+ * @throws Any exception thrown by the task
+ */
+template <typename T>
+T SyncWait(Task<T> task) {
+  detail::SyncWaitResult<T> result{};
+  JobCounter counter{};
+  Spawn(detail::CaptureResult(std::move(task), result), counter);
+  JobSystem::Wait(counter);
+
+  if (result.exception) {
+    std::rethrow_exception(result.exception);
+  }
+  if constexpr (!std::is_void_v<T>) {
+    return std::move(*result.value);
+  }
+}
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+  return Task<T>{ std::coroutine_handle<TaskPromise>::from_promise(*this) };
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+  return Task<void>{ std::coroutine_handle<TaskPromise>::from_promise(*this) };
+}
+
+inline DetachedTask RunAndSignal(Task<void> task, JobCounter& counter) {
+  co_await std::move(task);
+  counter.Decrement();
+}
+
+template <typename T>
+Task<void> CaptureResult(Task<T> task, SyncWaitResult<T>& result) {
+  try {
+    if constexpr (std::is_void_v<T>) {
+      co_await std::move(task);
+    } else {
+      result.value.emplace(co_await std::move(task));
+    }
+  } catch (...) {
+    result.exception = std::current_exception();
+  }
+}
+
+} // namespace detail
+
+} // namespace maple::core
@@ -0,0 +1,265 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// glm
+#include "glm/mat4x4.hpp"
+
+// Core
+#include "Core/CoreExport.h"
+
+namespace maple::core {
+
+/// Handle to a node of a TransformHierarchy (reused once the node is
+/// destroyed)
+using TransformId = std::uint32_t;
+
+/// Handle that refers to no node, e.g., the parent of a root
+inline constexpr TransformId kInvalidTransform{ ~0U };
+
+/**
+ * @brief Implementation of the batched local-to-world multiplies.
+ */
+enum class TransformKernel : std::uint8_t {
+  /// Portable C++
+  Scalar,
+
+  /// 128-bit SSE, one matrix column per register (x86-64 baseline)
+  SSE,
+
+  /// 256-bit AVX2 with FMA, two matrix columns per register
+  AVX2
+};
+
+/**
+ * @brief Get the display name of a transform kernel.
+ *
+ * @param kernel Transform kernel
+ * @return Static, null-terminated name
+ */
+MAPLE_CORE_API const char* GetTransformKernelName(
+  TransformKernel kernel) noexcept;
+
+/**
+ * @brief What the hierarchy did in the last update.
+ */
+struct TransformStats {
+  /// Number of nodes
+  std::size_t node_count{ 0U };
+
+  /// Depth of the deepest node plus one
+  std::size_t level_count{ 0U };
+
+  /// Number of world matrices recomputed
+  std::size_t updated_count{ 0U };
+
+  /// Kernel the world matrices were recomputed with
+  TransformKernel kernel{ TransformKernel::Scalar };
+};
+
+/**
+ * @brief Parent-child hierarchy of local transforms, flattened to world
+ *        transforms.
+ *
+ * Nodes are stored as arrays of local matrices, world matrices, parent
+ * indices, and dirty flags, sorted breadth-first so that every depth is a
+ * contiguous range that follows its parents' range. Update() then walks the
+ * depths in order: each node whose local matrix or parent changed is
+ * gathered into a batch, and batches are multiplied by a SIMD kernel picked
+ * from the CPU's features. Nodes whose subtree did not change are skipped,
+ * and large depths are split across the job system's threads.
+ *
+ * Handles stay valid when nodes are reordered. Creating nodes top-down keeps
+ * the arrays sorted; reparenting, or creating a node shallower than the last
+ * one, re-sorts them on the next update, and destroying a node compacts them
+ * immediately, so these are meant for loading rather than every frame.
+ *
+ * @code
+ * const TransformId body{ hierarchy.Create() };
+ * const TransformId wheel{ hierarchy.Create(body, wheel_offset) };
+ * hierarchy.SetLocal(body, glm::translate(glm::mat4{ 1.0F }, position));
+ * hierarchy.Update();
+ * const glm::mat4& wheel_to_world{ hierarchy.GetWorld(wheel) };
+ * @endcode
+ *
+ * @note Not thread-safe; Update() splits its own work across threads.
+ */
+class MAPLE_CORE_API TransformHierarchy {
+public:
+  TransformHierarchy(const TransformHierarchy&) = delete;
+  TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+  TransformHierarchy(TransformHierarchy&&) = delete;
+  TransformHierarchy& operator=(TransformHierarchy&&) = delete;
+
+  /**
+   * @brief Construct an empty hierarchy using the fastest supported kernel.
+   */
+  TransformHierarchy();
+
+  /**
+   * @brief Create a node.
+   *
+   * @param parent Parent node, or kInvalidTransform for a root
+   * @param local Transform relative to the parent
+   * @return Handle to the node; its world matrix is computed by the next
+   *         update
+   * @throws std::runtime_error If the parent is not a node
+   */
+  TransformId Create(TransformId parent = kInvalidTransform,
+                     const glm::mat4& local = glm::mat4{ 1.0F });
+
+  /**
+   * @brief Destroy a node and all of its descendants.
+   *
+   * Runs in time linear in the number of nodes.
+   *
+   * @throws std::runtime_error If the node does not exist
+   */
+  void Destroy(TransformId node);
+
+  /**
+   * @brief Move a node, along with its descendants, under another parent.
+   *
+   * The node keeps its local matrix.
+   *
+   * @param node Node to move
+   * @param parent New parent, or kInvalidTransform to make the node a root
+   * @throws std::runtime_error If either node does not exist, or if the
+   *         parent is the node or one of its descendants
+   */
+  void SetParent(TransformId node, TransformId parent);
+
+  /**
+   * @brief Set a node's transform relative to its parent.
+   */
+  void SetLocal(TransformId node, const glm::mat4& local) noexcept;
+
+  /**
+   * @brief Get a node's parent.
+   *
+   * @return Parent node, or kInvalidTransform for a root
+   */
+  [[nodiscard]] TransformId GetParent(TransformId node) const noexcept;
+
+  /**
+   * @brief Get a node's transform relative to its parent.
+   */
+  [[nodiscard]] const glm::mat4& GetLocal(TransformId node) const noexcept;
+
+  /**
+   * @brief Get a node's local-to-world transform as of the last update.
+   */
+  [[nodiscard]] const glm::mat4& GetWorld(TransformId node) const noexcept;
+
+  /**
+   * @brief Check whether a handle refers to a node.
+   */
+  [[nodiscard]] bool IsValid(TransformId node) const noexcept;
+
+  /**
+   * @brief Get the number of nodes.
+   */
+  [[nodiscard]] std::size_t GetNodeCount() const noexcept;
+
+  /**
+   * @brief Recompute the world matrices of changed nodes and their
+   *        descendants.
+   */
+  void Update();
+
+  /**
+   * @brief Check whether a kernel can run on this CPU and build.
+   */
+  [[nodiscard]] static bool IsKernelSupported(TransformKernel kernel) noexcept;
+
+  /**
+   * @brief Override the kernel picked at construction, e.g., to compare
+   *        them.
+   *
+   * @throws std::runtime_error If the kernel is not supported
+   */
+  void SetKernel(TransformKernel kernel);
+
+  /**
+   * @brief Get the kernel used by updates.
+   */
+  [[nodiscard]] TransformKernel GetKernel() const noexcept;
+
+  /**
+   * @brief Get what the last update did.
+   */
+  [[nodiscard]] const TransformStats& GetStats() const noexcept;
+
+private:
+  /// Dense index of a root's parent, and of a free handle
+  static constexpr std::uint32_t kNoIndex{ ~0U };
+
+  /// Nodes gathered before a kernel call
+  static constexpr std::size_t kBatchSize{ 64U };
+
+  /// Minimum number of nodes of a depth per job
+  static constexpr std::size_t kMinNodesPerJob{ 2048U };
+
+  /**
+   * @brief Get the dense index of a node.
+   *
+   * @throws std::runtime_error If the node does not exist
+   */
+  [[nodiscard]] std::uint32_t GetIndex(TransformId node) const;
+
+  /**
+   * @brief Sort the nodes breadth-first and rebuild the depth ranges.
+   */
+  void SortNodes();
+
+  /**
+   * @brief Recompute the changed nodes of a range of one depth.
+   *
+   * @return Number of world matrices recomputed
+   */
+  std::size_t UpdateRange(std::size_t begin, std::size_t end) noexcept;
+
+  /// Transform of each node relative to its parent
+  std::vector<glm::mat4> locals_{};
+
+  /// Local-to-world transform of each node
+  std::vector<glm::mat4> worlds_{};
+
+  /// Dense index of each node's parent (kNoIndex for roots)
+  std::vector<std::uint32_t> parents_{};
+
+  /// Depth of each node (only meaningful while the nodes are sorted)
+  std::vector<std::uint32_t> depths_{};
+
+  /// Whether each node's world matrix must be recomputed
+  std::vector<std::uint8_t> dirty_{};
+
+  /// Handle of each node
+  std::vector<TransformId> ids_{};
+
+  /// First dense index of each depth, followed by the node count
+  std::vector<std::uint32_t> level_offsets_{ 0U };
+
+  /// Dense index of each handle (kNoIndex if free)
+  std::vector<std::uint32_t> indices_{};
+
+  /// Handles of destroyed nodes, reused first
+  std::vector<TransformId> free_ids_{};
+
+  /// Whether the nodes are no longer sorted breadth-first
+  bool unsorted_{ false };
+
+  /// Whether any node is dirty
+  bool any_dirty_{ false };
+
+  /// Kernel used by updates
+  TransformKernel kernel_{ TransformKernel::Scalar };
+
+  /// What the last update did
+  TransformStats stats_{};
+};
+
+} // namespace maple::core
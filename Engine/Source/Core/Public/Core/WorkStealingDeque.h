@@ -0,0 +1,157 @@
+#pragma once
+
+// STL
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace maple::core {
+
+/**
+ * @brief Fixed-capacity Chase-Lev work-stealing deque.
+ *
+ * The owning thread pushes and pops at the bottom (LIFO, cache-friendly);
+ * any other thread steals from the top (FIFO, oldest work first). Only the
+ * last remaining element is contended, and then resolved with a single
+ * compare-and-swap. Memory ordering follows Lê et al., "Correct and Efficient
+ * Work-Stealing for Weak Memory Models" (PPoPP 2013).
+ *
+ * @tparam T Element type (must be trivially copyable and lock-free atomic,
+ *           typically a pointer)
+ */
+template <typename T>
+class WorkStealingDeque {
+  static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+  WorkStealingDeque() = delete;
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+  WorkStealingDeque(WorkStealingDeque&&) = delete;
+  WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+
+  /**
+   * @brief Construct an empty deque.
+   *
+   * @param capacity Maximum number of elements (rounded up to a power of two)
+   */
+  explicit WorkStealingDeque(std::size_t capacity)
+    : capacity_{ std::bit_ceil(capacity) }
+    , mask_{ capacity_ - 1U }
+    , buffer_{ std::make_unique<std::atomic<T>[]>(capacity_) } {}
+
+  /**
+   * @brief Push an element at the bottom.
+   *
+   * @note Owner thread only.
+   *
+   * @param value Element to push
+   * @return false if the deque is full
+   */
+  bool Push(T value) noexcept {
+    const std::int64_t bottom{ bottom_.load(std::memory_order_relaxed) };
+    const std::int64_t top{ top_.load(std::memory_order_acquire) };
+    if (bottom - top >= static_cast<std::int64_t>(capacity_)) {
+      return false;
+    }
+
+    buffer_[static_cast<std::size_t>(bottom) & mask_].store(
+      value, std::memory_order_relaxed
+    );
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief Pop the most recently pushed element.
+   *
+   * @note Owner thread only.
+   *
+   * @param value Receives the element on success
+   * @return false if the deque is empty or the last element was stolen
+   */
+  bool Pop(T& value) noexcept {
+    // Reserve the bottom element before looking at the top
+    const std::int64_t bottom{ bottom_.load(std::memory_order_relaxed) - 1 };
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top{ top_.load(std::memory_order_relaxed) };
+
+    if (top > bottom) {
+      // Empty; restore the bottom
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+
+    value = buffer_[static_cast<std::size_t>(bottom) & mask_].load(
+      std::memory_order_relaxed
+    );
+    if (top < bottom) {
+      return true;
+    }
+
+    // Last element; race thieves for it
+    const bool won{ top_.compare_exchange_strong(top, top + 1,
+                                                 std::memory_order_seq_cst,
+                                                 std::memory_order_relaxed) };
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return won;
+  }
+
+  /**
+   * @brief Steal the least recently pushed element.
+   *
+   * @note Safe to call from any thread.
+   *
+   * @param value Receives the element on success
+   * @return false if the deque is empty or another thread won the race
+   */
+  bool Steal(T& value) noexcept {
+    std::int64_t top{ top_.load(std::memory_order_acquire) };
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t bottom{ bottom_.load(std::memory_order_acquire) };
+    if (top >= bottom) {
+      return false;
+    }
+
+    value = buffer_[static_cast<std::size_t>(top) & mask_].load(
+      std::memory_order_relaxed
+    );
+    return top_.compare_exchange_strong(top, top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get an estimate of the number of elements.
+   *
+   * @return Number of elements at some recent point in time
+   */
+  [[nodiscard]] std::size_t GetSizeEstimate() const noexcept {
+    const std::int64_t bottom{ bottom_.load(std::memory_order_relaxed) };
+    const std::int64_t top{ top_.load(std::memory_order_relaxed) };
+    return bottom > top ? static_cast<std::size_t>(bottom - top) : 0U;
+  }
+
+private:
+  /// Maximum number of elements (power of two)
+  const std::size_t capacity_;
+
+  /// Index mask for the ring buffer
+  const std::size_t mask_;
+
+  /// Ring buffer of elements
+  std::unique_ptr<std::atomic<T>[]> buffer_;
+
+  /// Index of the oldest element, advanced by thieves
+  alignas(64) std::atomic<std::int64_t> top_{ 0 };
+
+  /// Index one past the newest element, moved only by the owner
+  alignas(64) std::atomic<std::int64_t> bottom_{ 0 };
+};
+
+} // namespace maple::core
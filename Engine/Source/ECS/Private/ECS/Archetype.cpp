@@ -0,0 +1,217 @@
+#include "ECS/Archetype.h"
+
+// STL
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+// Core
+#include "Core/Memory.h"
+#include "Core/Prefetch.h"
+
+// ECS
+#include "ECS/ECSLog.h"
+
+namespace maple::ecs {
+
+namespace {
+
+/**
+ * @brief Round an offset up to a multiple of a power of two.
+ */
+constexpr std::size_t AlignUp(std::size_t offset,
+                              std::size_t alignment) noexcept {
+  return (offset + alignment - 1U) & ~(alignment - 1U);
+}
+
+} // namespace
+
+Archetype::Archetype(const ComponentMask& mask)
+  : mask_{ mask } {
+  column_of_.fill(kNoColumn);
+  for (ComponentId id{ 0U }; id < kMaxComponentTypes; ++id) {
+    if (!mask_.test(id)) {
+      continue;
+    }
+    const ComponentInfo& info{ ComponentRegistry::GetInfo(id) };
+    column_of_[id] = static_cast<std::uint8_t>(columns_.size());
+    component_ids_.push_back(id);
+    columns_.push_back(Column{
+      .size = static_cast<std::uint32_t>(info.size),
+      .info = &info
+    });
+  }
+
+  // Start from the capacity that ignores padding, then shrink until the
+  // aligned arrays fit
+  std::size_t row_size{ sizeof(Entity) };
+  for (const Column& column : columns_) {
+    row_size += column.size;
+  }
+  std::uint32_t capacity{ static_cast<std::uint32_t>(kChunkSize / row_size) };
+  while (capacity > 0U && LayOutColumns(capacity) > kChunkSize) {
+    --capacity;
+  }
+  if (capacity == 0U) {
+    const std::string msg{ "Components of " + std::to_string(columns_.size())
+                           + " type(s) do not fit in a chunk" };
+    MAPLE_LOG_CRITICAL(LogECS, msg);
+    throw std::runtime_error{ msg };
+  }
+  chunk_capacity_ = capacity;
+  LayOutColumns(chunk_capacity_);
+}
+
+Archetype::~Archetype() {
+  for (const Chunk& chunk : chunks_) {
+    for (const Column& column : columns_) {
+      if (column.info->destroy) {
+        for (std::uint32_t i{ 0U }; i < chunk.count; ++i) {
+          column.info->destroy(chunk.data + column.offset + i * column.size);
+        }
+      }
+    }
+    core::Memory::Free(chunk.data);
+  }
+  core::Memory::Free(spare_chunk_);
+}
+
+std::uint32_t Archetype::AddRow(Entity entity) {
+  if (chunks_.empty() || chunks_.back().count == chunk_capacity_) {
+    std::byte* data{ spare_chunk_ };
+    spare_chunk_ = nullptr;
+    if (!data) {
+      data = static_cast<std::byte*>(core::Memory::Allocate(
+        kChunkSize, core::kCacheLineSize, core::MemoryTag::ECS
+      ));
+    }
+    chunks_.push_back(Chunk{ .data = data });
+  }
+
+  Chunk& chunk{ chunks_.back() };
+  std::memcpy(chunk.data + chunk.count * sizeof(Entity), &entity,
+              sizeof(Entity));
+  ++chunk.count;
+  return entity_count_++;
+}
+
+Entity Archetype::RemoveRow(std::uint32_t row, bool destroy) noexcept {
+  const std::uint32_t last_row{ entity_count_ - 1U };
+  Chunk& chunk{ chunks_[row / chunk_capacity_] };
+  const std::uint32_t index{ row % chunk_capacity_ };
+  Chunk& last_chunk{ chunks_.back() };
+  const std::uint32_t last_index{ last_chunk.count - 1U };
+
+  for (const Column& column : columns_) {
+    std::byte* value{ chunk.data + column.offset + index * column.size };
+    if (destroy && column.info->destroy) {
+      column.info->destroy(value);
+    }
+    if (row == last_row) {
+      continue;
+    }
+    std::byte* last_value{
+      last_chunk.data + column.offset + last_index * column.size
+    };
+    if (column.info->relocate) {
+      column.info->relocate(value, last_value);
+    } else {
+      std::memcpy(value, last_value, column.size);
+    }
+  }
+
+  // Move the last entity's handle into the row
+  Entity moved{ kNullEntity };
+  if (row != last_row) {
+    std::memcpy(&moved, last_chunk.data + last_index * sizeof(Entity),
+                sizeof(Entity));
+    std::memcpy(chunk.data + index * sizeof(Entity), &moved, sizeof(Entity));
+  }
+
+  --entity_count_;
+  if (--last_chunk.count == 0U) {
+    core::Memory::Free(spare_chunk_);
+    spare_chunk_ = last_chunk.data;
+    chunks_.pop_back();
+  }
+  return moved;
+}
+
+const ComponentMask& Archetype::GetMask() const noexcept {
+  return mask_;
+}
+
+std::span<const ComponentId> Archetype::GetComponentIds() const noexcept {
+  return component_ids_;
+}
+
+std::uint8_t Archetype::GetColumn(ComponentId id) const noexcept {
+  return id < kMaxComponentTypes ? column_of_[id] : kNoColumn;
+}
+
+std::uint32_t Archetype::GetColumnOffset(std::uint8_t column)
+  const noexcept {
+  return columns_[column].offset;
+}
+
+void* Archetype::GetComponent(std::uint32_t row,
+                              std::uint8_t column) const noexcept {
+  const Chunk& chunk{ chunks_[row / chunk_capacity_] };
+  const Column& info{ columns_[column] };
+  return chunk.data + info.offset + (row % chunk_capacity_) * info.size;
+}
+
+Entity Archetype::GetEntity(std::uint32_t row) const noexcept {
+  const Chunk& chunk{ chunks_[row / chunk_capacity_] };
+  Entity entity{};
+  std::memcpy(&entity,
+              chunk.data + (row % chunk_capacity_) * sizeof(Entity),
+              sizeof(Entity));
+  return entity;
+}
+
+std::span<const Chunk> Archetype::GetChunks() const noexcept {
+  return chunks_;
+}
+
+std::uint32_t Archetype::GetChunkCapacity() const noexcept {
+  return chunk_capacity_;
+}
+
+std::uint32_t Archetype::GetEntityCount() const noexcept {
+  return entity_count_;
+}
+
+Archetype* Archetype::GetAddEdge(ComponentId id) const noexcept {
+  const auto it{ add_edges_.find(id) };
+  return it != add_edges_.end() ? it->second : nullptr;
+}
+
+Archetype* Archetype::GetRemoveEdge(ComponentId id) const noexcept {
+  const auto it{ remove_edges_.find(id) };
+  return it != remove_edges_.end() ? it->second : nullptr;
+}
+
+void Archetype::SetAddEdge(ComponentId id, Archetype* archetype) {
+  add_edges_[id] = archetype;
+}
+
+void Archetype::SetRemoveEdge(ComponentId id, Archetype* archetype) {
+  remove_edges_[id] = archetype;
+}
+
+std::size_t Archetype::LayOutColumns(std::uint32_t capacity) noexcept {
+  // Entity handles come first; every array starts on a cache line so that
+  // iteration and SIMD loads never split a line between two arrays
+  std::size_t offset{ capacity * sizeof(Entity) };
+  for (Column& column : columns_) {
+    offset = AlignUp(offset, std::max(column.info->alignment,
+                                      core::kCacheLineSize));
+    column.offset = static_cast<std::uint32_t>(offset);
+    offset += std::size_t{ capacity } * column.size;
+  }
+  return offset;
+}
+
+} // namespace maple::ecs
@@ -0,0 +1,148 @@
+#include "ECS/CommandBuffer.h"
+
+// STL
+#include <cstring>
+
+// ECS
+#include "ECS/World.h"
+
+namespace maple::ecs {
+
+CommandBuffer::CommandBuffer(std::size_t value_capacity)
+  : values_{ value_capacity, "ECS command buffer" } {}
+
+CommandBuffer::~CommandBuffer() {
+  DestroyValues(0U);
+}
+
+Entity CommandBuffer::CreateEntity() {
+  const Entity entity{
+    .index = pending_count_,
+    .generation = Entity::kPendingGeneration
+  };
+  commands_.push_back(Command{
+    .type = CommandType::CreateEntity,
+    .entity = entity
+  });
+  ++pending_count_;
+  return entity;
+}
+
+void CommandBuffer::DestroyEntity(Entity entity) {
+  commands_.push_back(Command{
+    .type = CommandType::DestroyEntity,
+    .entity = entity
+  });
+}
+
+void CommandBuffer::Playback(World& world) {
+  std::vector<Entity> created{};
+  created.reserve(pending_count_);
+
+  // Values already moved into the world are no longer owned by the buffer,
+  // which matters if a command throws
+  std::size_t played{ 0U };
+  try {
+    for (; played < commands_.size(); ++played) {
+      Command& command{ commands_[played] };
+      if (command.type == CommandType::CreateEntity) {
+        created.push_back(world.CreateEntity());
+        continue;
+      }
+
+      const Entity entity{ Resolve(command.entity, created) };
+      const bool alive{ world.IsAlive(entity) };
+      switch (command.type) {
+        case CommandType::DestroyEntity: {
+          if (alive) {
+            world.DestroyEntity(entity);
+          }
+          break;
+        }
+
+        case CommandType::AddComponent: {
+          const ComponentInfo& info{
+            ComponentRegistry::GetInfo(command.component)
+          };
+          if (alive) {
+            // Assigning an existing component is destroy, then relocate
+            bool exists{ false };
+            void* storage{
+              world.EmplaceComponent(entity, command.component, exists)
+            };
+            if (exists && info.destroy) {
+              info.destroy(storage);
+            }
+            if (info.relocate) {
+              info.relocate(storage, command.value);
+            } else {
+              std::memcpy(storage, command.value, info.size);
+            }
+          } else if (info.destroy) {
+            info.destroy(command.value);
+          }
+          command.value = nullptr;
+          break;
+        }
+
+        case CommandType::RemoveComponent: {
+          if (alive) {
+            world.RemoveComponent(entity, command.component);
+          }
+          break;
+        }
+
+        default: { break; }
+      }
+    }
+  } catch (...) {
+    DestroyValues(played);
+    commands_.clear();
+    values_.Reset();
+    pending_count_ = 0U;
+    throw;
+  }
+
+  commands_.clear();
+  values_.Reset();
+  pending_count_ = 0U;
+}
+
+void CommandBuffer::Clear() {
+  DestroyValues(0U);
+  commands_.clear();
+  values_.Reset();
+  pending_count_ = 0U;
+}
+
+bool CommandBuffer::IsEmpty() const noexcept {
+  return commands_.empty();
+}
+
+std::size_t CommandBuffer::GetCommandCount() const noexcept {
+  return commands_.size();
+}
+
+Entity CommandBuffer::Resolve(Entity entity,
+                              const std::vector<Entity>& created) noexcept {
+  if (entity.generation != Entity::kPendingGeneration) {
+    return entity;
+  }
+  return entity.index < created.size() ? created[entity.index] : kNullEntity;
+}
+
+void CommandBuffer::DestroyValues(std::size_t first) noexcept {
+  for (std::size_t i{ first }; i < commands_.size(); ++i) {
+    const Command& command{ commands_[i] };
+    if (command.value) {
+      const ComponentInfo& info{
+        ComponentRegistry::GetInfo(command.component)
+      };
+      if (info.destroy) {
+        info.destroy(command.value);
+      }
+    }
+  }
+}
+
+} // namespace maple::ecs
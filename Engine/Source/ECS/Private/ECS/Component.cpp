@@ -0,0 +1,70 @@
+#include "ECS/Component.h"
+
+// STL
+#include <array>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+// ECS
+#include "ECS/ECSLog.h"
+
+namespace maple::ecs {
+
+namespace {
+
+/**
+ * @brief Registered component types.
+ */
+struct RegistryState {
+  /// Guards registration
+  std::mutex mutex{};
+
+  /// Information of every registered type, indexed by ComponentId
+  std::array<ComponentInfo, kMaxComponentTypes> infos{};
+
+  /// Ids of the registered types, by name
+  std::unordered_map<std::string_view, ComponentId> ids{};
+};
+
+/**
+ * @brief Get the registry, created on first use.
+ */
+RegistryState& GetState() {
+  static RegistryState state{};
+  return state;
+}
+
+} // namespace
+
+ComponentId ComponentRegistry::Register(const ComponentInfo& info) {
+  RegistryState& state{ GetState() };
+  std::lock_guard lock{ state.mutex };
+  if (const auto it{ state.ids.find(info.name) }; it != state.ids.end()) {
+    return it->second;
+  }
+
+  if (state.ids.size() == kMaxComponentTypes) {
+    const std::string msg{ "Too many component types (limit "
+                           + std::to_string(kMaxComponentTypes)
+                           + "): " + std::string{ info.name } };
+    MAPLE_LOG_CRITICAL(LogECS, msg);
+    throw std::runtime_error{ msg };
+  }
+
+  // Ids are handed out under the lock, which publishes the information to
+  // any thread that later reads it by id
+  const auto id{ static_cast<ComponentId>(state.ids.size()) };
+  state.infos[id] = info;
+  state.ids.emplace(info.name, id);
+  MAPLE_LOG_DEBUG(LogECS, "Registered component {} ({} bytes): {}", id,
+                  info.size, info.name);
+  return id;
+}
+
+const ComponentInfo& ComponentRegistry::GetInfo(ComponentId id) noexcept {
+  return GetState().infos[id];
+}
+
+} // namespace maple::ecs
@@ -0,0 +1,3 @@
+#include "ECS/ECSLog.h"
+
+MAPLE_DEFINE_LOG_CATEGORY(LogECS);
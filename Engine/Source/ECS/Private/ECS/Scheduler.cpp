@@ -0,0 +1,278 @@
+#include "ECS/Scheduler.h"
+
+// STL
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+// Core
+#include "Core/JobSystem.h"
+#include "Core/Profiler.h"
+
+// ECS
+#include "ECS/ECSLog.h"
+#include "ECS/World.h"
+
+namespace maple::ecs {
+
+SystemContext::SystemContext(Scheduler& scheduler, World& world,
+                             SystemId system) noexcept
+  : scheduler_{ &scheduler }
+  , world_{ &world }
+  , system_{ system } {}
+
+World& SystemContext::GetWorld() const noexcept {
+  return *world_;
+}
+
+CommandBuffer& SystemContext::GetCommandBuffer() const {
+  // Each job thread only touches its own slot; other threads may run the
+  // system's jobs while they wait and share a map
+  Scheduler::System& system{ scheduler_->GetSystem(system_) };
+  const std::uint32_t index{ core::JobSystem::GetThreadIndex() };
+  if (index < system.thread_commands.size()) {
+    std::unique_ptr<CommandBuffer>& commands{ system.thread_commands[index] };
+    if (!commands) {
+      commands = std::make_unique<CommandBuffer>();
+    }
+    return *commands;
+  }
+  std::lock_guard lock{ scheduler_->foreign_mutex_ };
+  std::unique_ptr<CommandBuffer>& commands{
+    system.foreign_commands[std::this_thread::get_id()]
+  };
+  if (!commands) {
+    commands = std::make_unique<CommandBuffer>();
+  }
+  return *commands;
+}
+
+double SystemContext::GetDeltaTime() const noexcept {
+  return scheduler_->delta_time_;
+}
+
+std::uint64_t SystemContext::GetFrameIndex() const noexcept {
+  return scheduler_->frame_index_;
+}
+
+SystemBuilder::SystemBuilder(Scheduler& scheduler, SystemId system) noexcept
+  : scheduler_{ &scheduler }
+  , system_{ system } {}
+
+SystemBuilder& SystemBuilder::After(SystemId system) {
+  scheduler_->GetSystem(system_).after.push_back(system);
+  scheduler_->graph_dirty_ = true;
+  return *this;
+}
+
+SystemBuilder& SystemBuilder::Exclusive() {
+  scheduler_->GetSystem(system_).exclusive = true;
+  scheduler_->graph_dirty_ = true;
+  return *this;
+}
+
+SystemId SystemBuilder::GetId() const noexcept {
+  return system_;
+}
+
+Scheduler::Scheduler(World& world)
+  : world_{ &world } {}
+
+Scheduler::~Scheduler() = default;
+
+SystemBuilder Scheduler::AddSystem(const char* name,
+                                   SystemFunction function) {
+  return SystemBuilder{ *this, CreateSystem(name, std::move(function)) };
+}
+
+void Scheduler::Update(double delta_time) {
+  MAPLE_PROFILE_FUNCTION(LogECS);
+
+  if (graph_dirty_) {
+    BuildGraph();
+  }
+
+  // A command buffer slot per system and job thread, sized before the jobs
+  // start so that threads only ever fill their own slot
+  const std::uint32_t thread_count{ core::JobSystem::GetThreadCount() };
+  for (const std::unique_ptr<System>& system : systems_) {
+    if (system->thread_commands.size() < thread_count) {
+      system->thread_commands.resize(thread_count);
+    }
+  }
+
+  delta_time_ = delta_time;
+  failed_.store(false, std::memory_order_relaxed);
+  error_ = nullptr;
+
+  // Start the systems without predecessors; each finished system starts
+  // the successors it was the last predecessor of
+  for (const std::unique_ptr<System>& system : systems_) {
+    system->pending.store(system->predecessor_count,
+                          std::memory_order_relaxed);
+  }
+  for (SystemId id{ 0U }; id < systems_.size(); ++id) {
+    if (systems_[id]->predecessor_count == 0U) {
+      ScheduleSystem(id);
+    }
+  }
+  core::JobSystem::Wait(counter_);
+  ++frame_index_;
+
+  // Changes recorded by a failed update are discarded
+  if (error_) {
+    for (const std::unique_ptr<System>& system : systems_) {
+      for (const auto& commands : system->thread_commands) {
+        if (commands) {
+          commands->Clear();
+        }
+      }
+      for (auto& [thread, commands] : system->foreign_commands) {
+        commands->Clear();
+      }
+    }
+    std::rethrow_exception(error_);
+  }
+
+  stats_.command_count = PlaybackCommands();
+}
+
+const SchedulerStats& Scheduler::GetStats() const noexcept {
+  return stats_;
+}
+
+SystemId Scheduler::CreateSystem(const char* name, SystemFunction function) {
+  auto system{ std::make_unique<System>() };
+  system->name = name;
+  system->function = std::move(function);
+  system->context.reset(new SystemContext{
+    *this, *world_, static_cast<SystemId>(systems_.size())
+  });
+  systems_.push_back(std::move(system));
+  graph_dirty_ = true;
+  return static_cast<SystemId>(systems_.size() - 1U);
+}
+
+Scheduler::System& Scheduler::GetSystem(SystemId system) noexcept {
+  return *systems_[system];
+}
+
+void Scheduler::BuildGraph() {
+  MAPLE_PROFILE_FUNCTION(LogECS);
+
+  for (const std::unique_ptr<System>& system : systems_) {
+    system->successors.clear();
+    system->predecessor_count = 0U;
+  }
+
+  // An earlier system precedes a later one if either writes what the other
+  // accesses, if either runs alone, or if the later one asked for it
+  std::uint32_t dependency_count{ 0U };
+  std::vector<std::uint32_t> levels(systems_.size(), 0U);
+  for (SystemId later{ 0U }; later < systems_.size(); ++later) {
+    System& system{ *systems_[later] };
+    for (const SystemId after : system.after) {
+      if (after >= later) {
+        const std::string msg{ "System '" + std::string{ system.name }
+                               + "' runs after system "
+                               + std::to_string(after)
+                               + ", which was not added before it" };
+        MAPLE_LOG_CRITICAL(LogECS, msg);
+        throw std::runtime_error{ msg };
+      }
+    }
+
+    const ComponentMask accesses{ system.reads | system.writes };
+    for (SystemId earlier{ 0U }; earlier < later; ++earlier) {
+      System& other{ *systems_[earlier] };
+      const bool conflict{
+        system.exclusive || other.exclusive
+        || (system.writes & (other.reads | other.writes)).any()
+        || (other.writes & accesses).any()
+        || std::ranges::find(system.after, earlier) != system.after.end()
+      };
+      if (conflict) {
+        other.successors.push_back(later);
+        ++system.predecessor_count;
+        ++dependency_count;
+        levels[later] = std::max(levels[later], levels[earlier] + 1U);
+      }
+    }
+  }
+
+  // Systems of a level have no path between them and may overlap
+  std::vector<std::uint32_t> level_sizes{};
+  for (const std::uint32_t level : levels) {
+    if (level >= level_sizes.size()) {
+      level_sizes.resize(level + 1U, 0U);
+    }
+    ++level_sizes[level];
+  }
+  stats_.system_count = static_cast<std::uint32_t>(systems_.size());
+  stats_.dependency_count = dependency_count;
+  stats_.level_count = static_cast<std::uint32_t>(level_sizes.size());
+  stats_.max_concurrent_systems = level_sizes.empty()
+                                    ? 0U
+                                    : std::ranges::max(level_sizes);
+  graph_dirty_ = false;
+
+  MAPLE_LOG_DEBUG(LogECS, "Scheduled {} system(s) with {} dependency(ies) "
+                          "in {} level(s), up to {} concurrent",
+                  stats_.system_count, stats_.dependency_count,
+                  stats_.level_count, stats_.max_concurrent_systems);
+}
+
+void Scheduler::ScheduleSystem(SystemId system) {
+  core::JobSystem::Schedule([this, system] { RunSystem(system); },
+                            &counter_);
+}
+
+void Scheduler::RunSystem(SystemId id) {
+  System& system{ *systems_[id] };
+
+  // Jobs must not throw, so the first exception is kept for Update()
+  if (!failed_.load(std::memory_order_relaxed)) {
+    MAPLE_PROFILE_SCOPE(LogECS, system.name);
+    try {
+      system.function(*system.context);
+    } catch (...) {
+      std::lock_guard lock{ error_mutex_ };
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+      failed_.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  // Start the successors this system was the last predecessor of; they
+  // are counted before this job finishes, so the update cannot end early
+  for (const SystemId successor : system.successors) {
+    if (systems_[successor]->pending.fetch_sub(
+          1U, std::memory_order_acq_rel) == 1U) {
+      ScheduleSystem(successor);
+    }
+  }
+}
+
+std::size_t Scheduler::PlaybackCommands() {
+  MAPLE_PROFILE_FUNCTION(LogECS);
+
+  // Systems run on whichever threads are free, so playing buffers back in
+  // thread order would make the outcome differ between runs
+  std::size_t command_count{ 0U };
+  for (const std::unique_ptr<System>& system : systems_) {
+    for (const auto& commands : system->thread_commands) {
+      if (commands) {
+        command_count += commands->GetCommandCount();
+        commands->Playback(*world_);
+      }
+    }
+    for (auto& [thread, commands] : system->foreign_commands) {
+      command_count += commands->GetCommandCount();
+      commands->Playback(*world_);
+    }
+  }
+  return command_count;
+}
+
+} // namespace maple::ecs
@@ -0,0 +1,187 @@
+#include "ECS/World.h"
+
+// STL
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+// ECS
+#include "ECS/ECSLog.h"
+
+namespace maple::ecs {
+
+World::World() {
+  // Entities without components live in the first archetype
+  static_cast<void>(GetOrCreateArchetype(ComponentMask{}));
+}
+
+World::~World() {
+  MAPLE_LOG_DEBUG(LogECS, "Destroying world with {} entity(ies) in {} "
+                          "archetype(s)",
+                  entity_count_, archetypes_.size());
+}
+
+Entity World::CreateEntity() {
+  return AllocateEntity(*archetypes_.front());
+}
+
+void World::DestroyEntity(Entity entity) {
+  EntityRecord& record{ GetRecord(entity) };
+  const Entity moved{ record.archetype->RemoveRow(record.row, true) };
+  if (!moved.IsNull()) {
+    records_[moved.index].row = record.row;
+  }
+
+  // Invalidate handles to the entity; the pending generation belongs to
+  // command buffers
+  record.archetype = nullptr;
+  if (++record.generation == Entity::kPendingGeneration) {
+    record.generation = 0U;
+  }
+  free_indices_.push_back(entity.index);
+  --entity_count_;
+}
+
+bool World::IsAlive(Entity entity) const noexcept {
+  return entity.index < records_.size()
+         && records_[entity.index].archetype
+         && records_[entity.index].generation == entity.generation;
+}
+
+void* World::EmplaceComponent(Entity entity, ComponentId id, bool& exists) {
+  EntityRecord& record{ GetRecord(entity) };
+  Archetype* source{ record.archetype };
+  const std::uint8_t column{ source->GetColumn(id) };
+  exists = column != Archetype::kNoColumn;
+  if (exists) {
+    return source->GetComponent(record.row, column);
+  }
+
+  Archetype* target{ source->GetAddEdge(id) };
+  if (!target) {
+    ComponentMask mask{ source->GetMask() };
+    mask.set(id);
+    target = &GetOrCreateArchetype(mask);
+    source->SetAddEdge(id, target);
+    target->SetRemoveEdge(id, source);
+  }
+  MoveEntity(record, *target);
+  return target->GetComponent(record.row, target->GetColumn(id));
+}
+
+void World::RemoveComponent(Entity entity, ComponentId id) {
+  EntityRecord& record{ GetRecord(entity) };
+  Archetype* source{ record.archetype };
+  if (source->GetColumn(id) == Archetype::kNoColumn) {
+    return;
+  }
+
+  Archetype* target{ source->GetRemoveEdge(id) };
+  if (!target) {
+    ComponentMask mask{ source->GetMask() };
+    mask.reset(id);
+    target = &GetOrCreateArchetype(mask);
+    source->SetRemoveEdge(id, target);
+    target->SetAddEdge(id, source);
+  }
+  MoveEntity(record, *target);
+}
+
+void* World::GetComponent(Entity entity, ComponentId id) const noexcept {
+  if (!IsAlive(entity)) {
+    return nullptr;
+  }
+  const EntityRecord& record{ records_[entity.index] };
+  const std::uint8_t column{ record.archetype->GetColumn(id) };
+  return column != Archetype::kNoColumn
+           ? record.archetype->GetComponent(record.row, column)
+           : nullptr;
+}
+
+std::span<const std::unique_ptr<Archetype>> World::GetArchetypes()
+  const noexcept {
+  return archetypes_;
+}
+
+std::uint32_t World::GetEntityCount() const noexcept {
+  return entity_count_;
+}
+
+Entity World::AllocateEntity(Archetype& archetype) {
+  // Grow the records first so that a failure leaves the archetype intact
+  if (free_indices_.empty()) {
+    records_.emplace_back();
+    free_indices_.push_back(static_cast<std::uint32_t>(records_.size() - 1U));
+  }
+  const std::uint32_t index{ free_indices_.back() };
+  EntityRecord& record{ records_[index] };
+  const Entity entity{ .index = index, .generation = record.generation };
+  record.row = archetype.AddRow(entity);
+  record.archetype = &archetype;
+  free_indices_.pop_back();
+  ++entity_count_;
+  return entity;
+}
+
+World::EntityRecord& World::GetRecord(Entity entity) {
+  if (!IsAlive(entity)) {
+    const std::string msg{ "Entity " + std::to_string(entity.index) + "v"
+                           + std::to_string(entity.generation)
+                           + " is not alive" };
+    MAPLE_LOG_ERROR(LogECS, msg);
+    throw std::runtime_error{ msg };
+  }
+  return records_[entity.index];
+}
+
+Archetype& World::GetOrCreateArchetype(const ComponentMask& mask) {
+  if (const auto it{ archetype_by_mask_.find(mask) };
+      it != archetype_by_mask_.end()) {
+    return *it->second;
+  }
+
+  auto archetype{ std::make_unique<Archetype>(mask) };
+  Archetype* created{ archetype.get() };
+  archetypes_.reserve(archetypes_.size() + 1U);
+  archetype_by_mask_.emplace(mask, created);
+  archetypes_.push_back(std::move(archetype));
+  MAPLE_LOG_DEBUG(LogECS, "Created archetype {} with {} component type(s), "
+                          "{} entity(ies) per chunk",
+                  archetypes_.size() - 1U,
+                  created->GetComponentIds().size(),
+                  created->GetChunkCapacity());
+  return *created;
+}
+
+void World::MoveEntity(EntityRecord& record, Archetype& target) {
+  Archetype& source{ *record.archetype };
+  const std::uint32_t row{ target.AddRow(source.GetEntity(record.row)) };
+
+  // Components move with the entity; those the target lacks are destroyed
+  const std::span<const ComponentId> ids{ source.GetComponentIds() };
+  for (std::size_t i{ 0U }; i < ids.size(); ++i) {
+    const ComponentInfo& info{ ComponentRegistry::GetInfo(ids[i]) };
+    void* value{
+      source.GetComponent(record.row, static_cast<std::uint8_t>(i))
+    };
+    const std::uint8_t column{ target.GetColumn(ids[i]) };
+    if (column == Archetype::kNoColumn) {
+      if (info.destroy) {
+        info.destroy(value);
+      }
+    } else if (info.relocate) {
+      info.relocate(target.GetComponent(row, column), value);
+    } else {
+      std::memcpy(target.GetComponent(row, column), value, info.size);
+    }
+  }
+
+  const Entity moved{ source.RemoveRow(record.row, false) };
+  if (!moved.IsNull()) {
+    records_[moved.index].row = record.row;
+  }
+  record.archetype = &target;
+  record.row = row;
+}
+
+} // namespace maple::ecs
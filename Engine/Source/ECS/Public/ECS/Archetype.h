@@ -0,0 +1,218 @@
+#pragma once
+
+// STL
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+// ECS
+#include "ECS/Component.h"
+#include "ECS/ECSExport.h"
+#include "ECS/Entity.h"
+
+namespace maple::ecs {
+
+/**
+ * @brief Fixed-size block holding a run of entities of one archetype.
+ *
+ * Components are stored SoA: the chunk begins with the entities' handles,
+ * followed by one cache-line aligned array per component type, each with
+ * room for the archetype's chunk capacity.
+ */
+struct Chunk {
+  /// Storage of the arrays (Archetype::kChunkSize bytes)
+  std::byte* data{ nullptr };
+
+  /// Number of entities stored
+  std::uint32_t count{ 0U };
+};
+
+/**
+ * @brief Storage of every entity with exactly one set of component types.
+ *
+ * Entities are packed densely: every chunk but the last is full, and
+ * removing an entity moves the archetype's last entity into its row.
+ * Entities therefore move within their archetype, and callers must update
+ * the location of the entity that RemoveRow() reports.
+ *
+ * @note Not thread-safe; structural changes belong to the owning World.
+ */
+class MAPLE_ECS_API Archetype {
+public:
+  Archetype() = delete;
+  Archetype(const Archetype&) = delete;
+  Archetype& operator=(const Archetype&) = delete;
+  Archetype(Archetype&&) = delete;
+  Archetype& operator=(Archetype&&) = delete;
+
+  /// Size of every chunk in bytes
+  static constexpr std::size_t kChunkSize{ 16U * 1024U };
+
+  /// Column index meaning "component type not in the archetype"
+  static constexpr std::uint8_t kNoColumn{ 0xFFU };
+
+  /**
+   * @brief Lay out the chunks of a set of component types.
+   *
+   * @param mask Component types of the archetype
+   * @throws std::runtime_error If a single entity does not fit in a chunk
+   */
+  explicit Archetype(const ComponentMask& mask);
+
+  /**
+   * @brief Destroy the remaining components and free the chunks.
+   */
+  ~Archetype();
+
+  /**
+   * @brief Append an entity whose components the caller constructs.
+   *
+   * @param entity Handle stored in the new row
+   * @return Index of the new row across the archetype's chunks
+   */
+  [[nodiscard]] std::uint32_t AddRow(Entity entity);
+
+  /**
+   * @brief Remove a row by moving the last row into it.
+   *
+   * @param row Row to remove
+   * @param destroy Whether to destroy the row's components (false if the
+   *                caller relocated them already)
+   * @return Entity moved into the row (null if the row was the last one)
+   */
+  Entity RemoveRow(std::uint32_t row, bool destroy) noexcept;
+
+  /**
+   * @brief Get the component types of the archetype.
+   */
+  [[nodiscard]] const ComponentMask& GetMask() const noexcept;
+
+  /**
+   * @brief Get the component types of the archetype, in column order.
+   */
+  [[nodiscard]] std::span<const ComponentId> GetComponentIds()
+    const noexcept;
+
+  /**
+   * @brief Get the column of a component type.
+   *
+   * @return Column index, or kNoColumn if the type is not in the archetype
+   */
+  [[nodiscard]] std::uint8_t GetColumn(ComponentId id) const noexcept;
+
+  /**
+   * @brief Get the byte offset of a column's array within each chunk.
+   */
+  [[nodiscard]] std::uint32_t GetColumnOffset(std::uint8_t column)
+    const noexcept;
+
+  /**
+   * @brief Get the address of a component of a row.
+   *
+   * @param row Row of the entity
+   * @param column Column of the component type
+   */
+  [[nodiscard]] void* GetComponent(std::uint32_t row, std::uint8_t column)
+    const noexcept;
+
+  /**
+   * @brief Get the entity stored in a row.
+   */
+  [[nodiscard]] Entity GetEntity(std::uint32_t row) const noexcept;
+
+  /**
+   * @brief Get the chunks; every chunk but the last is full.
+   */
+  [[nodiscard]] std::span<const Chunk> GetChunks() const noexcept;
+
+  /**
+   * @brief Get the number of entities per chunk.
+   */
+  [[nodiscard]] std::uint32_t GetChunkCapacity() const noexcept;
+
+  /**
+   * @brief Get the number of entities stored.
+   */
+  [[nodiscard]] std::uint32_t GetEntityCount() const noexcept;
+
+  /**
+   * @brief Get the archetype with one component type added, if known.
+   *
+   * @return Cached archetype, or null if the edge was not taken before
+   */
+  [[nodiscard]] Archetype* GetAddEdge(ComponentId id) const noexcept;
+
+  /**
+   * @brief Get the archetype with one component type removed, if known.
+   *
+   * @return Cached archetype, or null if the edge was not taken before
+   */
+  [[nodiscard]] Archetype* GetRemoveEdge(ComponentId id) const noexcept;
+
+  /**
+   * @brief Cache the archetype reached by adding a component type.
+   */
+  void SetAddEdge(ComponentId id, Archetype* archetype);
+
+  /**
+   * @brief Cache the archetype reached by removing a component type.
+   */
+  void SetRemoveEdge(ComponentId id, Archetype* archetype);
+
+private:
+  /**
+   * @brief Column of one component type.
+   */
+  struct Column {
+    /// Byte offset of the array within each chunk
+    std::uint32_t offset{ 0U };
+
+    /// Size of one component in bytes
+    std::uint32_t size{ 0U };
+
+    /// How to relocate and destroy the components
+    const ComponentInfo* info{ nullptr };
+  };
+
+  /**
+   * @brief Compute the column offsets for a number of entities per chunk.
+   *
+   * @return Bytes used by the arrays
+   */
+  std::size_t LayOutColumns(std::uint32_t capacity) noexcept;
+
+  /// Component types of the archetype
+  ComponentMask mask_;
+
+  /// Component types, in column order (ascending id)
+  std::vector<ComponentId> component_ids_{};
+
+  /// Columns, parallel to component_ids_
+  std::vector<Column> columns_{};
+
+  /// Column of each component type (kNoColumn if absent)
+  std::array<std::uint8_t, kMaxComponentTypes> column_of_{};
+
+  /// Number of entities per chunk
+  std::uint32_t chunk_capacity_{ 0U };
+
+  /// Number of entities stored
+  std::uint32_t entity_count_{ 0U };
+
+  /// Chunks holding entities
+  std::vector<Chunk> chunks_{};
+
+  /// Emptied chunk kept to avoid reallocating at a chunk boundary
+  std::byte* spare_chunk_{ nullptr };
+
+  /// Archetypes reached by adding a component type
+  std::unordered_map<ComponentId, Archetype*> add_edges_{};
+
+  /// Archetypes reached by removing a component type
+  std::unordered_map<ComponentId, Archetype*> remove_edges_{};
+};
+
+} // namespace maple::ecs
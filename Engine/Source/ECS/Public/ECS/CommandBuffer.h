@@ -0,0 +1,196 @@
+#pragma once
+
+// STL
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Core
+#include "Core/LinearArena.h"
+
+// ECS
+#include "ECS/Component.h"
+#include "ECS/ECSExport.h"
+#include "ECS/Entity.h"
+
+namespace maple::ecs {
+
+class World;
+
+/**
+ * @brief Records structural changes to a World for later playback.
+ *
+ * Lets code that iterates a query create and destroy entities or add and
+ * remove components without invalidating the chunks being iterated.
+ * Commands are applied in recording order by Playback(). Component values
+ * are moved into an arena owned by the buffer until then.
+ *
+ * Entities created through the buffer get pending handles that are only
+ * valid for further commands on the same buffer; Playback() replaces them
+ * with real entities. Commands on entities that are no longer alive at
+ * playback (e.g., destroyed by another buffer) are skipped.
+ *
+ * @note Not thread-safe; give each thread its own buffer.
+ */
+class MAPLE_ECS_API CommandBuffer {
+public:
+  CommandBuffer(const CommandBuffer&) = delete;
+  CommandBuffer& operator=(const CommandBuffer&) = delete;
+  CommandBuffer(CommandBuffer&&) = delete;
+  CommandBuffer& operator=(CommandBuffer&&) = delete;
+
+  /**
+   * @brief Construct an empty buffer.
+   *
+   * @param value_capacity Bytes of component values held before the arena
+   *                       overflows to the heap
+   */
+  explicit CommandBuffer(std::size_t value_capacity = 64U * 1024U);
+
+  /**
+   * @brief Destroy the component values that were never played back.
+   */
+  ~CommandBuffer();
+
+  /**
+   * @brief Record the creation of an entity without components.
+   *
+   * @return Pending handle, valid for commands on this buffer until
+   *         playback
+   */
+  [[nodiscard]] Entity CreateEntity();
+
+  /**
+   * @brief Record the destruction of an entity.
+   *
+   * @param entity Live or pending entity
+   */
+  void DestroyEntity(Entity entity);
+
+  /**
+   * @brief Record adding (or assigning) a component.
+   *
+   * @param entity Live or pending entity
+   * @param component Value of the component
+   */
+  template <Component T>
+  void AddComponent(Entity entity, T component);
+
+  /**
+   * @brief Record removing a component.
+   *
+   * @param entity Live or pending entity
+   */
+  template <Component T>
+  void RemoveComponent(Entity entity);
+
+  /**
+   * @brief Apply the recorded commands in order, then clear the buffer.
+   *
+   * @param world World to change
+   */
+  void Playback(World& world);
+
+  /**
+   * @brief Discard the recorded commands without applying them.
+   */
+  void Clear();
+
+  /**
+   * @brief Check whether no commands are recorded.
+   */
+  [[nodiscard]] bool IsEmpty() const noexcept;
+
+  /**
+   * @brief Get the number of recorded commands.
+   */
+  [[nodiscard]] std::size_t GetCommandCount() const noexcept;
+
+private:
+  /**
+   * @brief Kind of recorded command.
+   */
+  enum class CommandType : std::uint8_t {
+    CreateEntity,
+    DestroyEntity,
+    AddComponent,
+    RemoveComponent
+  };
+
+  /**
+   * @brief Recorded command.
+   */
+  struct Command {
+    /// Kind of command
+    CommandType type{ CommandType::CreateEntity };
+
+    /// Component type added or removed
+    ComponentId component{ 0U };
+
+    /// Entity changed (pending for CreateEntity)
+    Entity entity{};
+
+    /// Component value added, in the arena (moved out by playback)
+    void* value{ nullptr };
+  };
+
+  /**
+   * @brief Resolve a recorded handle to a world entity.
+   *
+   * @param entity Recorded handle
+   * @param created Entities created so far, indexed by pending index
+   * @return World entity (may no longer be alive)
+   */
+  [[nodiscard]] static Entity Resolve(Entity entity,
+                                      const std::vector<Entity>& created)
+    noexcept;
+
+  /**
+   * @brief Destroy the values of the commands not yet played back.
+   *
+   * @param first First command whose value is still owned by the buffer
+   */
+  void DestroyValues(std::size_t first) noexcept;
+
+  /// Recorded commands, in order
+  std::vector<Command> commands_{};
+
+  /// Storage of the recorded component values
+  core::LinearArena values_;
+
+  /// Number of entities created through the buffer since the last playback
+  std::uint32_t pending_count_{ 0U };
+};
+
+template <Component T>
+void CommandBuffer::AddComponent(Entity entity, T component) {
+  const ComponentId id{ GetComponentId<T>() };
+
+  // Make room before moving the value in, so push_back() cannot throw and
+  // leak it; doubling keeps recording amortized constant time
+  if (commands_.size() == commands_.capacity()) {
+    commands_.reserve(std::max<std::size_t>(commands_.size() * 2U, 64U));
+  }
+  void* value{ ::new (values_.Allocate(sizeof(T), alignof(T)))
+                 T(std::move(component)) };
+  commands_.push_back(Command{
+    .type = CommandType::AddComponent,
+    .component = id,
+    .entity = entity,
+    .value = value
+  });
+}
+
+template <Component T>
+void CommandBuffer::RemoveComponent(Entity entity) {
+  commands_.push_back(Command{
+    .type = CommandType::RemoveComponent,
+    .component = GetComponentId<T>(),
+    .entity = entity
+  });
+}
+
+} // namespace maple::ecs
@@ -0,0 +1,188 @@
+#pragma once
+
+// STL
+#include <bitset>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Core
+#include "Core/Prefetch.h"
+
+// ECS
+#include "ECS/ECSExport.h"
+
+namespace maple::ecs {
+
+/// Dense index of a component type, assigned on first use
+using ComponentId = std::uint32_t;
+
+/// Number of component types a program may use
+inline constexpr std::size_t kMaxComponentTypes{ 128U };
+
+/// Set of component types, indexed by ComponentId
+using ComponentMask = std::bitset<kMaxComponentTypes>;
+
+/**
+ * @brief Type that can be stored as a component.
+ *
+ * Components are relocated between chunks when entities change archetype,
+ * so moving and destroying them must not throw. Chunks are aligned to cache
+ * lines, which bounds the alignment of components.
+ */
+template <typename T>
+concept Component = std::is_object_v<T>
+                    && std::same_as<T, std::remove_cv_t<T>>
+                    && alignof(T) <= core::kCacheLineSize
+                    && std::is_nothrow_move_constructible_v<T>
+                    && std::is_nothrow_move_assignable_v<T>
+                    && std::is_nothrow_destructible_v<T>;
+
+/**
+ * @brief How to store and relocate a component type.
+ */
+struct ComponentInfo {
+  /// Name that identifies the type across modules
+  std::string_view name{};
+
+  /// Size in bytes
+  std::size_t size{ 0U };
+
+  /// Alignment in bytes
+  std::size_t alignment{ 1U };
+
+  /// Move-constructs dst from src and destroys src (null to copy bytes)
+  void (*relocate)(void* dst, void* src) noexcept{ nullptr };
+
+  /// Destroys a value (null if trivially destructible)
+  void (*destroy)(void* value) noexcept{ nullptr };
+};
+
+/**
+ * @brief Process-wide table of component types.
+ *
+ * Types are registered on first use through GetComponentId(), which caches
+ * the id per module; registration matches types by name so that every
+ * module sees the same id for a type.
+ *
+ * @note Thread-safe.
+ */
+class MAPLE_ECS_API ComponentRegistry {
+public:
+  ComponentRegistry() = delete;
+  ComponentRegistry(const ComponentRegistry&) = delete;
+  ComponentRegistry& operator=(const ComponentRegistry&) = delete;
+  ComponentRegistry(ComponentRegistry&&) = delete;
+  ComponentRegistry& operator=(ComponentRegistry&&) = delete;
+
+  /**
+   * @brief Register a component type, or find it if already registered.
+   *
+   * @param info How to store the type (name must have static storage)
+   * @return Id of the type
+   * @throws std::runtime_error If kMaxComponentTypes types are registered
+   *                            already
+   */
+  [[nodiscard]] static ComponentId Register(const ComponentInfo& info);
+
+  /**
+   * @brief Get how to store a registered component type.
+   *
+   * @param id Id returned by Register()
+   * @return Information about the type (valid for the program's lifetime)
+   */
+  [[nodiscard]] static const ComponentInfo& GetInfo(ComponentId id) noexcept;
+};
+
+namespace detail {
+
+/**
+ * @brief Get a name unique to a type, from the compiler's signature of this
+ *        function.
+ */
+template <typename T>
+[[nodiscard]] constexpr std::string_view GetTypeSignature() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+  return __FUNCSIG__;
+#else
+  return __PRETTY_FUNCTION__;
+#endif
+}
+
+/**
+ * @brief Describe how to store a component type.
+ */
+template <Component T>
+[[nodiscard]] constexpr ComponentInfo MakeComponentInfo() noexcept {
+  ComponentInfo info{
+    .name = GetTypeSignature<T>(),
+    .size = sizeof(T),
+    .alignment = alignof(T)
+  };
+  if constexpr (!std::is_trivially_copyable_v<T>) {
+    info.relocate = [](void* dst, void* src) noexcept {
+      T* value{ std::launder(static_cast<T*>(src)) };
+      ::new (dst) T(std::move(*value));
+      value->~T();
+    };
+  }
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    info.destroy = [](void* value) noexcept {
+      std::launder(static_cast<T*>(value))->~T();
+    };
+  }
+  return info;
+}
+
+/**
+ * @brief Check that no type appears twice in a pack.
+ */
+template <typename... Ts>
+[[nodiscard]] consteval bool AreDistinct() noexcept {
+  if constexpr (sizeof...(Ts) < 2U) {
+    return true;
+  } else {
+    return []<typename T, typename... Rest>(std::type_identity<T>,
+                                            std::type_identity<Rest>...) {
+      return (!std::same_as<T, Rest> && ...) && AreDistinct<Rest...>();
+    }(std::type_identity<Ts>{}...);
+  }
+}
+
+/**
+ * @brief Get the position of a type in a pack.
+ *
+ * @return Index of the first match, or sizeof...(Ts) if T is absent
+ */
+template <typename T, typename... Ts>
+[[nodiscard]] consteval std::size_t IndexOf() noexcept {
+  constexpr bool matches[]{ std::same_as<T, Ts>..., false };
+  std::size_t index{ 0U };
+  while (index < sizeof...(Ts) && !matches[index]) {
+    ++index;
+  }
+  return index;
+}
+
+} // namespace detail
+
+/**
+ * @brief Get the id of a component type, registering it on first use.
+ *
+ * @tparam T Component type
+ * @return Id of the type
+ * @throws std::runtime_error If too many component types are registered
+ */
+template <Component T>
+[[nodiscard]] ComponentId GetComponentId() {
+  static const ComponentId id{
+    ComponentRegistry::Register(detail::MakeComponentInfo<T>())
+  };
+  return id;
+}
+
+} // namespace maple::ecs
@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * @file ECSExport.h
+ * @brief Dynamic library import/export macros for the ECS module.
+ */
+
+#if defined(_WIN32) || defined(_WIN64)
+  #ifdef MAPLE_ECS_BUILD
+    #define MAPLE_ECS_API __declspec(dllexport)
+  #else
+    #define MAPLE_ECS_API __declspec(dllimport)
+  #endif
+#else
+  #if defined(__GNUC__) || defined(__clang__)
+    #ifdef MAPLE_ECS_BUILD
+      #define MAPLE_ECS_API __attribute__((visibility("default")))
+    #else
+      #define MAPLE_ECS_API
+    #endif
+  #else
+    #define MAPLE_ECS_API
+  #endif
+#endif
@@ -0,0 +1,9 @@
+#pragma once
+
+// Core
+#include "Core/Log.h"
+
+// ECS
+#include "ECS/ECSExport.h"
+
+MAPLE_DECLARE_LOG_CATEGORY(MAPLE_ECS_API, LogECS);
@@ -0,0 +1,46 @@
+#pragma once
+
+// STL
+#include <cstdint>
+#include <limits>
+
+namespace maple::ecs {
+
+/**
+ * @brief Handle of an entity in a World.
+ *
+ * Indices of destroyed entities are reused; the generation tells a reused
+ * index apart from handles to the entity that held it before.
+ */
+struct Entity {
+  /// Index of the entity "no entity" uses
+  static constexpr std::uint32_t kInvalidIndex{
+    std::numeric_limits<std::uint32_t>::max()
+  };
+
+  /// Generation of entities created by a CommandBuffer and not yet played
+  /// back (never used by a World)
+  static constexpr std::uint32_t kPendingGeneration{
+    std::numeric_limits<std::uint32_t>::max()
+  };
+
+  /// Slot of the entity in its world
+  std::uint32_t index{ kInvalidIndex };
+
+  /// Number of times the slot had been reused when the entity was created
+  std::uint32_t generation{ 0U };
+
+  /**
+   * @brief Check whether the handle refers to no entity.
+   */
+  [[nodiscard]] constexpr bool IsNull() const noexcept {
+    return index == kInvalidIndex;
+  }
+
+  friend constexpr bool operator==(Entity, Entity) noexcept = default;
+};
+
+/// Handle that refers to no entity
+inline constexpr Entity kNullEntity{};
+
+} // namespace maple::ecs
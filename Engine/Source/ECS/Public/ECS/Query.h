@@ -0,0 +1,378 @@
+#pragma once
+
+// STL
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Core
+#include "Core/JobSystem.h"
+#include "Core/Prefetch.h"
+
+// ECS
+#include "ECS/Archetype.h"
+#include "ECS/Component.h"
+#include "ECS/Entity.h"
+#include "ECS/World.h"
+
+namespace maple::ecs {
+
+/**
+ * @brief Type a query accesses: a component type, const-qualified if the
+ *        query only reads it.
+ */
+template <typename T>
+concept QueryTerm = Component<std::remove_const_t<T>>;
+
+/**
+ * @brief Arrays of one chunk matched by a query.
+ *
+ * @tparam Ts Accessed component types (const for read-only access)
+ */
+template <QueryTerm... Ts>
+class QueryChunk {
+public:
+  /**
+   * @brief Construct a view of a chunk's arrays.
+   *
+   * @param entities Handles of the chunk's entities
+   * @param count Number of entities in the chunk
+   * @param arrays Array of each accessed component type
+   */
+  QueryChunk(const Entity* entities, std::uint32_t count,
+             std::tuple<Ts*...> arrays) noexcept
+    : entities_{ entities }
+    , count_{ count }
+    , arrays_{ arrays } {}
+
+  /**
+   * @brief Get the array of an accessed component type.
+   *
+   * @tparam T Component type, with or without const
+   * @return Components of the chunk's entities (const if the query reads
+   *         the type)
+   */
+  template <typename T>
+  [[nodiscard]] auto Get() const noexcept {
+    constexpr std::size_t index{
+      detail::IndexOf<std::remove_const_t<T>, std::remove_const_t<Ts>...>()
+    };
+    static_assert(index < sizeof...(Ts), "Component type not in the query");
+    return std::span{ std::get<index>(arrays_), count_ };
+  }
+
+  /**
+   * @brief Get the handles of the chunk's entities.
+   */
+  [[nodiscard]] std::span<const Entity> GetEntities() const noexcept {
+    return { entities_, count_ };
+  }
+
+  /**
+   * @brief Get the number of entities in the chunk.
+   */
+  [[nodiscard]] std::uint32_t GetCount() const noexcept {
+    return count_;
+  }
+
+  /**
+   * @brief Get the array of every accessed component type.
+   */
+  [[nodiscard]] const std::tuple<Ts*...>& GetArrays() const noexcept {
+    return arrays_;
+  }
+
+private:
+  /// Handles of the chunk's entities
+  const Entity* entities_;
+
+  /// Number of entities in the chunk
+  std::uint32_t count_;
+
+  /// Array of each accessed component type
+  std::tuple<Ts*...> arrays_;
+};
+
+/**
+ * @brief Iterates the entities that have a set of component types.
+ *
+ * Matching archetypes are cached; archetypes created since the last
+ * iteration are matched incrementally, so a query is meant to be kept and
+ * reused across frames. Iteration walks each chunk's arrays linearly and
+ * prefetches the next chunk's arrays, which the hardware prefetcher cannot
+ * predict, while the current one is processed. The parallel variants split
+ * the matching chunks across the job system's threads.
+ *
+ * @code
+ * Query<Position, const Velocity> query{ world };
+ * query.ForEach([dt](Position& position, const Velocity& velocity) {
+ *   position.value += velocity.value * dt;
+ * });
+ * @endcode
+ *
+ * @tparam Ts Accessed component types (distinct; const for read-only)
+ */
+template <QueryTerm... Ts>
+  requires (sizeof...(Ts) > 0)
+class Query {
+public:
+  static_assert(detail::AreDistinct<std::remove_const_t<Ts>...>(),
+                "Component types of a query must be distinct");
+
+  /// Chunk view passed to ForEachChunk()
+  using Chunk = QueryChunk<Ts...>;
+
+  /**
+   * @brief Construct a query over a world.
+   *
+   * @param world World to iterate (must outlive the query)
+   */
+  explicit Query(World& world)
+    : world_{ &world } {
+    (required_.set(GetComponentId<std::remove_const_t<Ts>>()), ...);
+  }
+
+  /**
+   * @brief Skip entities that have any of the given component types.
+   *
+   * @return This query, for chaining
+   */
+  template <Component... Excluded>
+  Query& Without() {
+    (excluded_.set(GetComponentId<Excluded>()), ...);
+    matched_.clear();
+    archetypes_seen_ = 0U;
+    return *this;
+  }
+
+  /**
+   * @brief Call a function for every matching entity.
+   *
+   * @param function Callable as function(Ts&...) or
+   *                 function(Entity, Ts&...)
+   */
+  template <typename F>
+  void ForEach(F&& function) {
+    ForEachChunk([&function](const Chunk& chunk) {
+      ForEachEntity(function, chunk);
+    });
+  }
+
+  /**
+   * @brief Call a function for every matching chunk.
+   *
+   * @param function Callable as function(const Chunk&)
+   */
+  template <typename F>
+  void ForEachChunk(F&& function) {
+    Update();
+    for (const MatchedArchetype& matched : matched_) {
+      const std::span<const ecs::Chunk> chunks{
+        matched.archetype->GetChunks()
+      };
+      for (std::size_t i{ 0U }; i < chunks.size(); ++i) {
+        if (i + 1U < chunks.size()) {
+          Prefetch(chunks[i + 1U], matched);
+        }
+        function(MakeChunk(chunks[i], matched));
+      }
+    }
+  }
+
+  /**
+   * @brief Call a function for every matching entity, on several threads.
+   *
+   * Blocks until every entity was visited; the calling thread takes part.
+   *
+   * @param function Callable as function(Ts&...) or
+   *                 function(Entity, Ts&...), safe to call concurrently
+   * @param grain_size Minimum number of chunks per job
+   */
+  template <typename F>
+  void ParallelForEach(F&& function, std::size_t grain_size = 1U) {
+    ParallelForEachChunk([&function](const Chunk& chunk) {
+      ForEachEntity(function, chunk);
+    }, grain_size);
+  }
+
+  /**
+   * @brief Call a function for every matching chunk, on several threads.
+   *
+   * Blocks until every chunk was visited; the calling thread takes part.
+   *
+   * @param function Callable as function(const Chunk&), safe to call
+   *                 concurrently
+   * @param grain_size Minimum number of chunks per job
+   */
+  template <typename F>
+  void ParallelForEachChunk(F&& function, std::size_t grain_size = 1U) {
+    GetChunks(chunks_);
+    core::JobSystem::ParallelFor(
+      chunks_.size(), grain_size,
+      [this, &function](std::size_t begin, std::size_t end) {
+        for (std::size_t i{ begin }; i < end; ++i) {
+          if (i + 1U < end) {
+            Prefetch(chunks_[i + 1U]);
+          }
+          function(chunks_[i]);
+        }
+      }
+    );
+  }
+
+  /**
+   * @brief Get every matching chunk, e.g., to split iteration across
+   *        threads.
+   *
+   * @param[out] chunks Cleared, then filled with the matching chunks
+   */
+  void GetChunks(std::vector<Chunk>& chunks) {
+    Update();
+    chunks.clear();
+    for (const MatchedArchetype& matched : matched_) {
+      for (const ecs::Chunk& chunk : matched.archetype->GetChunks()) {
+        chunks.push_back(MakeChunk(chunk, matched));
+      }
+    }
+  }
+
+  /**
+   * @brief Get the number of matching entities.
+   */
+  [[nodiscard]] std::uint32_t GetEntityCount() {
+    Update();
+    std::uint32_t count{ 0U };
+    for (const MatchedArchetype& matched : matched_) {
+      count += matched.archetype->GetEntityCount();
+    }
+    return count;
+  }
+
+private:
+  /**
+   * @brief Archetype matched by the query.
+   */
+  struct MatchedArchetype {
+    /// Matched archetype
+    const Archetype* archetype{ nullptr };
+
+    /// Byte offset of each accessed type's array within the chunks
+    std::array<std::uint32_t, sizeof...(Ts)> offsets{};
+  };
+
+  /// Cache lines of each array prefetched ahead of iteration
+  static constexpr std::size_t kPrefetchLines{ 2U };
+
+  /**
+   * @brief Call a per-entity function for every entity of a chunk.
+   */
+  template <typename F>
+  static void ForEachEntity(F& function, const Chunk& chunk) {
+    std::apply([&function, &chunk](Ts*... arrays) {
+      const std::span<const Entity> entities{ chunk.GetEntities() };
+      for (std::uint32_t i{ 0U }; i < chunk.GetCount(); ++i) {
+        if constexpr (std::is_invocable_v<F&, Entity, Ts&...>) {
+          function(entities[i], arrays[i]...);
+        } else {
+          function(arrays[i]...);
+        }
+      }
+    }, chunk.GetArrays());
+  }
+
+  /**
+   * @brief Match the archetypes created since the last update.
+   */
+  void Update() {
+    const auto archetypes{ world_->GetArchetypes() };
+    for (; archetypes_seen_ < archetypes.size(); ++archetypes_seen_) {
+      const Archetype& archetype{ *archetypes[archetypes_seen_] };
+      const ComponentMask& mask{ archetype.GetMask() };
+      if ((mask & required_) != required_ || (mask & excluded_).any()) {
+        continue;
+      }
+      MatchedArchetype matched{ .archetype = &archetype };
+      std::size_t index{ 0U };
+      ((matched.offsets[index++] = archetype.GetColumnOffset(
+          archetype.GetColumn(GetComponentId<std::remove_const_t<Ts>>())
+        )), ...);
+      matched_.push_back(matched);
+    }
+  }
+
+  /**
+   * @brief Build the view of a matched chunk.
+   */
+  [[nodiscard]] static Chunk MakeChunk(const ecs::Chunk& chunk,
+                                       const MatchedArchetype& matched) {
+    return MakeChunk(chunk, matched, std::index_sequence_for<Ts...>{});
+  }
+
+  template <std::size_t... Is>
+  [[nodiscard]] static Chunk MakeChunk(const ecs::Chunk& chunk,
+                                       const MatchedArchetype& matched,
+                                       std::index_sequence<Is...>) {
+    return Chunk{
+      reinterpret_cast<const Entity*>(chunk.data), chunk.count,
+      std::tuple<Ts*...>{
+        reinterpret_cast<Ts*>(chunk.data + matched.offsets[Is])...
+      }
+    };
+  }
+
+  /**
+   * @brief Prefetch the start of a chunk's accessed arrays.
+   */
+  static void Prefetch(const ecs::Chunk& chunk,
+                       const MatchedArchetype& matched) noexcept {
+    for (std::size_t line{ 0U }; line < kPrefetchLines; ++line) {
+      const std::size_t offset{ line * core::kCacheLineSize };
+      core::PrefetchRead(chunk.data + offset);
+      for (const std::uint32_t array : matched.offsets) {
+        core::PrefetchRead(chunk.data + array + offset);
+      }
+    }
+  }
+
+  /**
+   * @brief Prefetch the start of a chunk view's arrays.
+   */
+  static void Prefetch(const Chunk& chunk) noexcept {
+    for (std::size_t line{ 0U }; line < kPrefetchLines; ++line) {
+      const std::size_t offset{ line * core::kCacheLineSize };
+      core::PrefetchRead(
+        reinterpret_cast<const std::byte*>(chunk.GetEntities().data()) + offset
+      );
+      std::apply([offset](Ts*... arrays) {
+        (core::PrefetchRead(
+           reinterpret_cast<const std::byte*>(arrays) + offset
+         ), ...);
+      }, chunk.GetArrays());
+    }
+  }
+
+  /// World iterated by the query
+  World* world_;
+
+  /// Component types an entity must have
+  ComponentMask required_{};
+
+  /// Component types an entity must not have
+  ComponentMask excluded_{};
+
+  /// Archetypes matched so far
+  std::vector<MatchedArchetype> matched_{};
+
+  /// Number of the world's archetypes matched against so far
+  std::size_t archetypes_seen_{ 0U };
+
+  /// Matching chunks of the current parallel iteration
+  std::vector<Chunk> chunks_{};
+};
+
+} // namespace maple::ecs
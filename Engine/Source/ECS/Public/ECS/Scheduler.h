@@ -0,0 +1,412 @@
+#pragma once
+
+// STL
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Core
+#include "Core/Memory.h"
+
+// ECS
+#include "ECS/CommandBuffer.h"
+#include "ECS/Component.h"
+#include "ECS/ECSExport.h"
+#include "ECS/Query.h"
+
+namespace maple::ecs {
+
+class Scheduler;
+class World;
+
+/// Index of a system in its scheduler, in registration order
+using SystemId = std::uint32_t;
+
+/**
+ * @brief What a system run by a Scheduler can reach.
+ */
+class MAPLE_ECS_API SystemContext {
+public:
+  SystemContext(const SystemContext&) = delete;
+  SystemContext& operator=(const SystemContext&) = delete;
+  SystemContext(SystemContext&&) = delete;
+  SystemContext& operator=(SystemContext&&) = delete;
+
+  /**
+   * @brief Get the world the systems run on.
+   *
+   * Only exclusive systems may change its structure directly; the others
+   * record changes with GetCommandBuffer().
+   */
+  [[nodiscard]] World& GetWorld() const noexcept;
+
+  /**
+   * @brief Get the system's command buffer for the calling thread.
+   *
+   * Buffers are played back once every system of the update has run, in
+   * the order the systems were added, so that the outcome does not depend
+   * on which threads ran them. Commands a system records on one thread
+   * keep their order; those its parallel jobs record on different threads
+   * are played back in no particular order.
+   *
+   * @return Buffer owned by the scheduler (may be called from jobs the
+   *         system starts, e.g., inside Query::ParallelForEach())
+   */
+  [[nodiscard]] CommandBuffer& GetCommandBuffer() const;
+
+  /**
+   * @brief Get the seconds elapsed since the previous update.
+   */
+  [[nodiscard]] double GetDeltaTime() const noexcept;
+
+  /**
+   * @brief Get the number of updates run before this one.
+   */
+  [[nodiscard]] std::uint64_t GetFrameIndex() const noexcept;
+
+private:
+  friend class Scheduler;
+
+  /**
+   * @brief Construct the context passed to a system.
+   */
+  SystemContext(Scheduler& scheduler, World& world, SystemId system) noexcept;
+
+  /// Scheduler running the update
+  Scheduler* scheduler_;
+
+  /// World the systems run on
+  World* world_;
+
+  /// System the context is passed to
+  SystemId system_;
+};
+
+/**
+ * @brief Declares the accesses and ordering of a system being added.
+ */
+class MAPLE_ECS_API SystemBuilder {
+public:
+  /**
+   * @brief Declare component types the system reads outside its query.
+   */
+  template <Component... Ts>
+  SystemBuilder& Reads();
+
+  /**
+   * @brief Declare component types the system writes outside its query.
+   */
+  template <Component... Ts>
+  SystemBuilder& Writes();
+
+  /**
+   * @brief Run the system after another one, even without a conflict.
+   *
+   * @param system System added earlier
+   */
+  SystemBuilder& After(SystemId system);
+
+  /**
+   * @brief Run the system alone, so that it may change the world's
+   *        structure directly.
+   */
+  SystemBuilder& Exclusive();
+
+  /**
+   * @brief Get the id of the system.
+   */
+  [[nodiscard]] SystemId GetId() const noexcept;
+
+private:
+  friend class Scheduler;
+
+  /**
+   * @brief Construct a builder for a system of a scheduler.
+   */
+  SystemBuilder(Scheduler& scheduler, SystemId system) noexcept;
+
+  /// Scheduler owning the system
+  Scheduler* scheduler_;
+
+  /// System being declared
+  SystemId system_;
+};
+
+/**
+ * @brief What the scheduler did in the last update.
+ */
+struct SchedulerStats {
+  /// Number of systems run
+  std::uint32_t system_count{ 0U };
+
+  /// Number of ordering edges between systems (conflicts and After())
+  std::uint32_t dependency_count{ 0U };
+
+  /// Length of the longest chain of dependent systems
+  std::uint32_t level_count{ 0U };
+
+  /// Most systems that share a level and may run concurrently
+  std::uint32_t max_concurrent_systems{ 0U };
+
+  /// Number of deferred commands played back
+  std::size_t command_count{ 0U };
+};
+
+/**
+ * @brief Runs systems on the job system, concurrently where their component
+ *        accesses allow.
+ *
+ * Each system declares the component types it reads and writes, taken from
+ * its query and from SystemBuilder. Two systems conflict if one writes a
+ * type the other accesses, or if either is exclusive; conflicting systems
+ * run in the order they were added, and the others run concurrently. The
+ * ordering graph is rebuilt when systems are added, and each update walks
+ * it on job threads, starting a system as soon as the last system it
+ * depends on finishes. Systems may split their own work across threads with
+ * Query::ParallelForEach().
+ *
+ * @code
+ * scheduler.AddSystem<Position, const Velocity>(
+ *   "Integrate",
+ *   [](SystemContext& context, Query<Position, const Velocity>& query) {
+ *     const auto dt{ static_cast<float>(context.GetDeltaTime()) };
+ *     query.ParallelForEach([dt](Position& p, const Velocity& v) {
+ *       p.value += v.value * dt;
+ *     });
+ *   }
+ * );
+ * @endcode
+ *
+ * @note An exception thrown by a system skips the systems not yet started
+ *       and is rethrown by Update(); jobs a system starts must not throw.
+ */
+class MAPLE_ECS_API Scheduler
+  : public core::TrackedAllocation<core::MemoryTag::ECS> {
+public:
+  Scheduler() = delete;
+  Scheduler(const Scheduler&) = delete;
+  Scheduler& operator=(const Scheduler&) = delete;
+  Scheduler(Scheduler&&) = delete;
+  Scheduler& operator=(Scheduler&&) = delete;
+
+  /// Function run by a system
+  using SystemFunction = std::function<void(SystemContext&)>;
+
+  /**
+   * @brief Construct a scheduler without systems.
+   *
+   * @param world World the systems run on (must outlive the scheduler)
+   */
+  explicit Scheduler(World& world);
+
+  ~Scheduler();
+
+  /**
+   * @brief Add a system that iterates a query.
+   *
+   * The query's terms declare the system's accesses: const terms are read,
+   * the others written.
+   *
+   * @tparam Ts Query terms
+   * @param name Name of the system for logs and its profile zone (string
+   *             literal)
+   * @param function Callable as function(SystemContext&, Query<Ts...>&)
+   * @return Builder to declare further accesses and ordering
+   */
+  template <QueryTerm... Ts, typename F>
+    requires (sizeof...(Ts) > 0)
+             && std::invocable<F&, SystemContext&, Query<Ts...>&>
+  SystemBuilder AddSystem(const char* name, F function);
+
+  /**
+   * @brief Add a system without a query; declare its accesses with the
+   *        returned builder.
+   *
+   * @param name Name of the system for logs and its profile zone (string
+   *             literal)
+   * @param function Function of the system
+   * @return Builder to declare accesses and ordering
+   */
+  SystemBuilder AddSystem(const char* name, SystemFunction function);
+
+  /**
+   * @brief Run every system once, then play back the deferred commands.
+   *
+   * @param delta_time Seconds elapsed since the previous update
+   * @throws std::runtime_error If a system declared an unknown dependency
+   * @throws Any exception thrown by a system function
+   */
+  void Update(double delta_time);
+
+  /**
+   * @brief Get what the last update did.
+   */
+  [[nodiscard]] const SchedulerStats& GetStats() const noexcept;
+
+private:
+  friend class SystemBuilder;
+  friend class SystemContext;
+
+  /**
+   * @brief Registered system.
+   */
+  struct System {
+    /// Name for logs and the profile zone
+    const char* name{ "" };
+
+    /// Function of the system
+    SystemFunction function{};
+
+    /// Component types read
+    ComponentMask reads{};
+
+    /// Component types written
+    ComponentMask writes{};
+
+    /// Whether the system must run alone
+    bool exclusive{ false };
+
+    /// Systems that must finish first (from After())
+    std::vector<SystemId> after{};
+
+    /// Systems that wait for this one
+    std::vector<SystemId> successors{};
+
+    /// Number of systems this one waits for
+    std::uint32_t predecessor_count{ 0U };
+
+    /// Predecessors left to finish in the current update
+    std::atomic<std::uint32_t> pending{ 0U };
+
+    /// Context passed to the function
+    std::unique_ptr<SystemContext> context{ nullptr };
+
+    /// Command buffers of the job threads, indexed by thread index and
+    /// created on first use
+    std::vector<std::unique_ptr<CommandBuffer>> thread_commands{};
+
+    /// Command buffers of threads that are not job threads but ran the
+    /// system's jobs while waiting (guarded by foreign_mutex_)
+    std::unordered_map<std::thread::id, std::unique_ptr<CommandBuffer>>
+      foreign_commands{};
+  };
+
+  /**
+   * @brief Register a system and mark the graph for rebuilding.
+   */
+  [[nodiscard]] SystemId CreateSystem(const char* name,
+                                      SystemFunction function);
+
+  /**
+   * @brief Get a registered system.
+   */
+  [[nodiscard]] System& GetSystem(SystemId system) noexcept;
+
+  /**
+   * @brief Order conflicting systems and compute the graph's statistics.
+   *
+   * @throws std::runtime_error If a system runs after an unknown system
+   */
+  void BuildGraph();
+
+  /**
+   * @brief Schedule a system whose predecessors have all finished.
+   */
+  void ScheduleSystem(SystemId system);
+
+  /**
+   * @brief Run a system, then release the systems that wait for it.
+   */
+  void RunSystem(SystemId system);
+
+  /**
+   * @brief Play back every system's command buffers in system order.
+   *
+   * @return Number of commands played back
+   */
+  std::size_t PlaybackCommands();
+
+  /// World the systems run on
+  World* world_;
+
+  /// Systems, in registration order (stable addresses for running jobs)
+  std::vector<std::unique_ptr<System>> systems_{};
+
+  /// Whether systems were added since the graph was built
+  bool graph_dirty_{ true };
+
+  /// Seconds elapsed since the previous update
+  double delta_time_{ 0.0 };
+
+  /// Number of updates run before the current one
+  std::uint64_t frame_index_{ 0U };
+
+  /// Outstanding systems of the current update
+  core::JobCounter counter_{};
+
+  /// Guards the systems' foreign command buffers
+  std::mutex foreign_mutex_{};
+
+  /// Whether a system threw in the current update
+  std::atomic<bool> failed_{ false };
+
+  /// Guards error_
+  std::mutex error_mutex_{};
+
+  /// First exception thrown by a system in the current update
+  std::exception_ptr error_{ nullptr };
+
+  /// What the last update did
+  SchedulerStats stats_{};
+};
+
+template <Component... Ts>
+SystemBuilder& SystemBuilder::Reads() {
+  Scheduler::System& system{ scheduler_->GetSystem(system_) };
+  (system.reads.set(GetComponentId<Ts>()), ...);
+  scheduler_->graph_dirty_ = true;
+  return *this;
+}
+
+template <Component... Ts>
+SystemBuilder& SystemBuilder::Writes() {
+  Scheduler::System& system{ scheduler_->GetSystem(system_) };
+  (system.writes.set(GetComponentId<Ts>()), ...);
+  scheduler_->graph_dirty_ = true;
+  return *this;
+}
+
+template <QueryTerm... Ts, typename F>
+  requires (sizeof...(Ts) > 0)
+           && std::invocable<F&, SystemContext&, Query<Ts...>&>
+SystemBuilder Scheduler::AddSystem(const char* name, F function) {
+  // The query is kept with the system, so its matches persist across updates
+  const SystemId id{ CreateSystem(name, [
+    function = std::move(function), query = Query<Ts...>{ *world_ }
+  ](SystemContext& context) mutable {
+    function(context, query);
+  }) };
+
+  // Const terms are read; the others are written
+  SystemBuilder builder{ *this, id };
+  const auto declare{ [&builder]<typename T>(std::type_identity<T>) {
+    if constexpr (std::is_const_v<T>) {
+      builder.Reads<std::remove_const_t<T>>();
+    } else {
+      builder.Writes<T>();
+    }
+  } };
+  (declare(std::type_identity<Ts>{}), ...);
+  return builder;
+}
+
+} // namespace maple::ecs
@@ -0,0 +1,280 @@
+#pragma once
+
+// STL
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Core
+#include "Core/Memory.h"
+
+// ECS
+#include "ECS/Archetype.h"
+#include "ECS/Component.h"
+#include "ECS/ECSExport.h"
+#include "ECS/Entity.h"
+
+namespace maple::ecs {
+
+/**
+ * @brief Entities and their components, stored by archetype.
+ *
+ * Every entity lives in the archetype of its exact set of component types,
+ * so a query walks the dense arrays of matching archetypes instead of
+ * chasing per-entity objects. Adding or removing a component moves the
+ * entity to another archetype; the transitions are cached on the
+ * archetypes, so repeated changes skip the lookup.
+ *
+ * Component references are invalidated by any structural change (creating
+ * or destroying entities, adding or removing components). Structural
+ * changes must not happen while a query iterates; record them in a
+ * CommandBuffer and play it back afterwards.
+ *
+ * @note Not thread-safe for structural changes. Queries may run on several
+ *       threads at once as long as no two of them write the same component
+ *       type.
+ */
+class MAPLE_ECS_API World
+  : public core::TrackedAllocation<core::MemoryTag::ECS> {
+public:
+  World(const World&) = delete;
+  World& operator=(const World&) = delete;
+  World(World&&) = delete;
+  World& operator=(World&&) = delete;
+
+  /**
+   * @brief Construct an empty world.
+   */
+  World();
+
+  /**
+   * @brief Destroy every entity and its components.
+   */
+  ~World();
+
+  /**
+   * @brief Create an entity without components.
+   *
+   * @return Handle of the entity
+   */
+  [[nodiscard]] Entity CreateEntity();
+
+  /**
+   * @brief Create an entity directly in the archetype of its components.
+   *
+   * @tparam Ts Component types (distinct)
+   * @param components Initial values of the components
+   * @return Handle of the entity
+   */
+  template <Component... Ts>
+    requires (sizeof...(Ts) > 0)
+  Entity CreateEntity(Ts... components);
+
+  /**
+   * @brief Destroy an entity and its components.
+   *
+   * @param entity Live entity
+   * @throws std::runtime_error If the entity is not alive
+   */
+  void DestroyEntity(Entity entity);
+
+  /**
+   * @brief Check whether a handle refers to a live entity.
+   */
+  [[nodiscard]] bool IsAlive(Entity entity) const noexcept;
+
+  /**
+   * @brief Add a component, or assign it if the entity has it already.
+   *
+   * @param entity Live entity
+   * @param component Value of the component
+   * @return Reference to the stored component (valid until the next
+   *         structural change)
+   * @throws std::runtime_error If the entity is not alive
+   */
+  template <Component T>
+  T& AddComponent(Entity entity, T component);
+
+  /**
+   * @brief Remove a component; does nothing if the entity lacks it.
+   *
+   * @param entity Live entity
+   * @throws std::runtime_error If the entity is not alive
+   */
+  template <Component T>
+  void RemoveComponent(Entity entity);
+
+  /**
+   * @brief Check whether an entity has a component.
+   *
+   * @return false if the entity lacks the component or is not alive
+   */
+  template <Component T>
+  [[nodiscard]] bool HasComponent(Entity entity) const;
+
+  /**
+   * @brief Get a component of an entity.
+   *
+   * @return Pointer to the component (valid until the next structural
+   *         change), or null if the entity lacks it or is not alive
+   */
+  template <Component T>
+  [[nodiscard]] T* GetComponent(Entity entity) const;
+
+  /**
+   * @brief Get storage for a component, moving the entity to the archetype
+   *        that has it if needed.
+   *
+   * @param entity Live entity
+   * @param id Component type
+   * @param[out] exists Whether the entity had the component already; if
+   *                    not, the caller must construct it in the storage
+   *                    before any other call on the world
+   * @return Storage of the component
+   * @throws std::runtime_error If the entity is not alive
+   */
+  [[nodiscard]] void* EmplaceComponent(Entity entity, ComponentId id,
+                                       bool& exists);
+
+  /**
+   * @brief Remove a component; does nothing if the entity lacks it.
+   *
+   * @param entity Live entity
+   * @param id Component type
+   * @throws std::runtime_error If the entity is not alive
+   */
+  void RemoveComponent(Entity entity, ComponentId id);
+
+  /**
+   * @brief Get a component of an entity.
+   *
+   * @return Address of the component, or null if the entity lacks it or is
+   *         not alive
+   */
+  [[nodiscard]] void* GetComponent(Entity entity,
+                                   ComponentId id) const noexcept;
+
+  /**
+   * @brief Get the archetypes, in creation order.
+   *
+   * Archetypes are never destroyed before the world, so queries keep track
+   * of the ones they matched by counting.
+   */
+  [[nodiscard]] std::span<const std::unique_ptr<Archetype>> GetArchetypes()
+    const noexcept;
+
+  /**
+   * @brief Get the number of live entities.
+   */
+  [[nodiscard]] std::uint32_t GetEntityCount() const noexcept;
+
+private:
+  /**
+   * @brief Where an entity is stored.
+   */
+  struct EntityRecord {
+    /// Archetype holding the entity (null if the slot is free)
+    Archetype* archetype{ nullptr };
+
+    /// Row of the entity in its archetype
+    std::uint32_t row{ 0U };
+
+    /// Generation of the entity using the slot, or of the next one
+    std::uint32_t generation{ 0U };
+  };
+
+  /**
+   * @brief Take a free entity slot and store the entity in an archetype.
+   *
+   * @return Handle of the entity
+   */
+  [[nodiscard]] Entity AllocateEntity(Archetype& archetype);
+
+  /**
+   * @brief Get the record of a live entity.
+   *
+   * @throws std::runtime_error If the entity is not alive
+   */
+  [[nodiscard]] EntityRecord& GetRecord(Entity entity);
+
+  /**
+   * @brief Get the archetype of a set of component types, creating it if
+   *        needed.
+   */
+  [[nodiscard]] Archetype& GetOrCreateArchetype(const ComponentMask& mask);
+
+  /**
+   * @brief Move an entity to another archetype, relocating the components
+   *        both share and destroying the others.
+   */
+  void MoveEntity(EntityRecord& record, Archetype& target);
+
+  /// Archetypes, in creation order (the first has no components)
+  std::vector<std::unique_ptr<Archetype>> archetypes_{};
+
+  /// Archetypes by component types
+  std::unordered_map<ComponentMask, Archetype*> archetype_by_mask_{};
+
+  /// Entity slots, indexed by Entity::index
+  std::vector<EntityRecord> records_{};
+
+  /// Free entity slots, reused last-in first-out
+  std::vector<std::uint32_t> free_indices_{};
+
+  /// Number of live entities
+  std::uint32_t entity_count_{ 0U };
+};
+
+template <Component... Ts>
+  requires (sizeof...(Ts) > 0)
+Entity World::CreateEntity(Ts... components) {
+  static_assert(detail::AreDistinct<Ts...>(),
+                "Component types of an entity must be distinct");
+  ComponentMask mask{};
+  (mask.set(GetComponentId<Ts>()), ...);
+  Archetype& archetype{ GetOrCreateArchetype(mask) };
+  const Entity entity{ AllocateEntity(archetype) };
+
+  // Construct the components in their columns of the new row
+  const std::uint32_t row{ records_[entity.index].row };
+  const auto construct{ [&archetype, row]<typename T>(T& component) {
+    const std::uint8_t column{ archetype.GetColumn(GetComponentId<T>()) };
+    ::new (archetype.GetComponent(row, column)) T(std::move(component));
+  } };
+  (construct(components), ...);
+  return entity;
+}
+
+template <Component T>
+T& World::AddComponent(Entity entity, T component) {
+  bool exists{ false };
+  void* storage{ EmplaceComponent(entity, GetComponentId<T>(), exists) };
+  if (exists) {
+    T& value{ *std::launder(static_cast<T*>(storage)) };
+    value = std::move(component);
+    return value;
+  }
+  return *::new (storage) T(std::move(component));
+}
+
+template <Component T>
+void World::RemoveComponent(Entity entity) {
+  RemoveComponent(entity, GetComponentId<T>());
+}
+
+template <Component T>
+bool World::HasComponent(Entity entity) const {
+  return GetComponent(entity, GetComponentId<T>()) != nullptr;
+}
+
+template <Component T>
+T* World::GetComponent(Entity entity) const {
+  void* component{ GetComponent(entity, GetComponentId<T>()) };
+  return component ? std::launder(static_cast<T*>(component)) : nullptr;
+}
+
+} // namespace maple::ecs
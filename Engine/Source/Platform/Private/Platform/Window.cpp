@@ -15,10 +15,20 @@ namespace maple::platform {
 Window::Window(const std::string& window_title, GraphicsAPI graphics_api)
   : platform_os_{ DetectPlatformOS() }
   , graphics_api_{ SelectGraphicsAPI(graphics_api) } {
+  // Headless runs use SDL's offscreen video driver and skip input devices,
+  // so they work on machines without a display or GPU
+  const bool headless{ graphics_api_ == GraphicsAPI::Null };
+  SDL_InitFlags init_flags{
+    SDL_INIT_VIDEO | SDL_INIT_JOYSTICK | SDL_INIT_HAPTIC | SDL_INIT_GAMEPAD
+  };
+  if (headless) {
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    init_flags = SDL_INIT_VIDEO;
+  }
+
   // Initialize SDL subsystems
   MAPLE_LOG_INFO(LogPlatform, "Initializing SDL3...");
-  if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_JOYSTICK
-                | SDL_INIT_HAPTIC | SDL_INIT_GAMEPAD)) {
+  if (!SDL_Init(init_flags)) {
     const std::string msg{ std::format("Failed to initialize SDL3: {}",
                                        SDL_GetError()) };
     MAPLE_LOG_CRITICAL(LogPlatform, msg);
@@ -49,6 +59,12 @@ Window::Window(const std::string& window_title, GraphicsAPI graphics_api)
       break;
     }
 
+    case GraphicsAPI::Null: {
+      window_flags = SDL_WINDOW_HIDDEN;
+      MAPLE_LOG_INFO(LogPlatform, "Configured offscreen SDL window.");
+      break;
+    }
+
     default: { break; }
   }
 
@@ -68,6 +84,9 @@ Window::Window(const std::string& window_title, GraphicsAPI graphics_api)
     throw std::runtime_error{ msg };
   }
   MAPLE_LOG_INFO(LogPlatform, "SDL window created");
+
+  // Record the initial framebuffer size
+  RefreshFramebufferSize();
 }
 
 Window::~Window() {
@@ -87,6 +106,8 @@ bool Window::ShouldQuit() const noexcept {
 }
 
 void Window::PollEvents() {
+  MAPLE_PROFILE_FUNCTION(LogPlatform);
+
   // Poll and process all queued SDL events
   SDL_Event event{};
   while (SDL_PollEvent(&event)) {
@@ -95,6 +116,20 @@ void Window::PollEvents() {
         should_quit_ = true;
         break;
       }
+
+      case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+      case SDL_EVENT_WINDOW_RESTORED: {
+        RefreshFramebufferSize();
+        framebuffer_resized_.store(true);
+        break;
+      }
+
+      case SDL_EVENT_WINDOW_MINIMIZED: {
+        framebuffer_width_.store(0U);
+        framebuffer_height_.store(0U);
+        framebuffer_resized_.store(true);
+        break;
+      }
       default: { break; }
     }
   }
@@ -104,6 +139,15 @@ SDL_Window* Window::GetSDLWindow() const noexcept {
   return window_.get();
 }
 
+FramebufferSize Window::GetFramebufferSize() const noexcept {
+  return FramebufferSize{ .width = framebuffer_width_.load(),
+                          .height = framebuffer_height_.load() };
+}
+
+bool Window::ConsumeFramebufferResize() noexcept {
+  return framebuffer_resized_.exchange(false);
+}
+
 PlatformOS Window::GetPlatformOS() const noexcept {
   return platform_os_;
 }
@@ -118,6 +162,14 @@ void Window::SDLWindowDeleter::operator()(SDL_Window* window) {
   }
 }
 
+void Window::RefreshFramebufferSize() {
+  int width{ 0 };
+  int height{ 0 };
+  SDL_GetWindowSizeInPixels(window_.get(), &width, &height);
+  framebuffer_width_.store(static_cast<std::uint32_t>(width));
+  framebuffer_height_.store(static_cast<std::uint32_t>(height));
+}
+
 PlatformOS Window::DetectPlatformOS() const {
   // Get the platform OS as a string
   const std::string detected_os{ SDL_GetPlatform() };
@@ -180,6 +232,11 @@ GraphicsAPI Window::SelectGraphicsAPI(GraphicsAPI requested_api) const {
       return requested_api;
     }
 
+    case GraphicsAPI::Null: {
+      MAPLE_LOG_INFO(LogPlatform, "Selected graphics API: Null (headless)");
+      return requested_api;
+    }
+
     default: { break; }
   }
 
@@ -8,7 +8,11 @@ namespace maple::platform {
 enum class GraphicsAPI {
   D3D12,
   Metal,
-  Vulkan
+  Vulkan,
+
+  /// CPU-only backend that records and validates commands without a GPU;
+  /// the window is created offscreen
+  Null
 };
 
 } // namespace maple::platform
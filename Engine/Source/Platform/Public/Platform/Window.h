@@ -1,9 +1,14 @@
 #pragma once
 
 // STL
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 
+// Core
+#include "Core/Memory.h"
+
 // Platform
 #include "Platform/PlatformExport.h"
 #include "Platform/PlatformOS.h"
@@ -14,13 +19,25 @@ struct SDL_Window;
 
 namespace maple::platform {
 
+/**
+ * @brief Size of a window's drawable area in pixels.
+ */
+struct FramebufferSize {
+  /// Width in pixels
+  std::uint32_t width{ 0U };
+
+  /// Height in pixels
+  std::uint32_t height{ 0U };
+};
+
 /**
  * @brief Cross-platform window management via SDL.
  *
  * Manages platform detection, graphics API selection with fallback support,
  * SDL lifecycle, window creation, and event handling.
  */
-class MAPLE_PLATFORM_API Window {
+class MAPLE_PLATFORM_API Window
+  : public core::TrackedAllocation<core::MemoryTag::Platform> {
 public:
   Window() = delete;
   Window(const Window&) = delete;
@@ -33,7 +50,8 @@ public:
    *
    * Detects the platform OS, selects an available graphics API (falling back to
    * the platform default if the requested API is unavailable), initializes SDL,
-   * and creates the window for the selected API.
+   * and creates the window for the selected API. The Null graphics API
+   * creates a hidden window on SDL's offscreen video driver for headless runs.
    *
    * @param window_title Title displayed in the window title bar
    * @param graphics_api Requested graphics API (may fall back to default)
@@ -70,6 +88,25 @@ public:
    */
   [[nodiscard]] SDL_Window* GetSDLWindow() const noexcept;
 
+  /**
+   * @brief Get the size of the drawable area as of the last PollEvents().
+   *
+   * @return Framebuffer size in pixels (zero while minimized)
+   *
+   * @note Safe to call from any thread, e.g. a render thread.
+   */
+  [[nodiscard]] FramebufferSize GetFramebufferSize() const noexcept;
+
+  /**
+   * @brief Check and clear whether the framebuffer was resized since the
+   *        previous call.
+   *
+   * @return true if the framebuffer size changed
+   *
+   * @note Safe to call from any thread, e.g. a render thread.
+   */
+  [[nodiscard]] bool ConsumeFramebufferResize() noexcept;
+
   /**
    * @brief Get the detected operating system platform.
    *
@@ -94,6 +131,11 @@ private:
     void operator()(SDL_Window* window);
   };
 
+  /**
+   * @brief Query SDL for the framebuffer size and store it.
+   */
+  void RefreshFramebufferSize();
+
   /**
    * @brief Detect the operating system at runtime.
    *
@@ -131,6 +173,15 @@ private:
   /// Flag indicating whether a quit has been requested
   bool should_quit_{ false };
 
+  /// Framebuffer width in pixels (read by the renderer on any thread)
+  std::atomic<std::uint32_t> framebuffer_width_{ 0U };
+
+  /// Framebuffer height in pixels (read by the renderer on any thread)
+  std::atomic<std::uint32_t> framebuffer_height_{ 0U };
+
+  /// Whether the framebuffer was resized since the renderer last checked
+  std::atomic<bool> framebuffer_resized_{ false };
+
   /// Detected operating system platform (immutable after construction)
   const PlatformOS platform_os_;
 
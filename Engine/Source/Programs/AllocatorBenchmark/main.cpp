@@ -0,0 +1,370 @@
+// STL
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <ratio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__GLIBC__)
+  #include <malloc.h>
+#endif
+
+// fmt
+#include "fmt/format.h"
+
+// Core
+#include "Core/Log.h"
+#include "Core/Memory.h"
+#include "Core/PoolAllocator.h"
+#include "Core/TLSFAllocator.h"
+
+// Programs
+#include "BenchmarkTiming.h"
+
+namespace {
+
+using maple::benchmark::Summarize;
+using maple::benchmark::Times;
+
+/// Allocations kept alive while churning
+constexpr std::size_t kLiveCount{ 20'000U };
+
+/// Free-then-allocate operations per thread unless given on the command line
+constexpr std::size_t kDefaultOperationCount{ 2'000'000U };
+
+/// Block size of the fixed-size pool case
+constexpr std::size_t kPoolBlockSize{ 64U };
+
+/// Size of the single pool handed to the TLSF heap
+constexpr std::size_t kTLSFPoolSize{ 512U * 1024U * 1024U };
+
+/// Threads of the multithreaded cases
+constexpr std::uint32_t kThreadCount{ 4U };
+
+/**
+ * @brief Pre-drawn allocation sizes and replacement order of a churn run.
+ */
+struct Workload {
+  /// Size of each initial live allocation
+  std::vector<std::uint32_t> initial_sizes{};
+
+  /// Size of the allocation made by each operation
+  std::vector<std::uint32_t> sizes{};
+
+  /// Live slot freed and refilled by each operation
+  std::vector<std::uint32_t> slots{};
+};
+
+/**
+ * @brief Outcome of a churn run.
+ */
+struct ChurnResult {
+  double operations_per_second{ 0.0 };
+
+  /// Times of a free-then-allocate operation, in nanoseconds
+  Times times{};
+
+  /// Bytes requested by the allocations live at the end
+  std::size_t live_bytes{ 0U };
+};
+
+/**
+ * @brief Draw a workload: mostly small objects, some medium buffers, and a
+ *        few large ones, like a game's mix of components, strings, and
+ *        resource metadata.
+ */
+Workload MakeWorkload(std::size_t operation_count, std::uint32_t seed,
+                      bool fixed_size) {
+  std::mt19937 random{ seed };
+  std::uniform_real_distribution<double> bucket{ 0.0, 1.0 };
+  std::uniform_int_distribution<std::uint32_t> small{ 16U, 256U };
+  std::uniform_int_distribution<std::uint32_t> medium{ 257U, 4'096U };
+  std::uniform_int_distribution<std::uint32_t> large{ 4'097U, 65'536U };
+  std::uniform_int_distribution<std::uint32_t> slot{
+    0U, static_cast<std::uint32_t>(kLiveCount - 1U)
+  };
+  const auto draw_size{ [&]() -> std::uint32_t {
+    if (fixed_size) {
+      return static_cast<std::uint32_t>(kPoolBlockSize);
+    }
+    const double b{ bucket(random) };
+    return b < 0.70 ? small(random)
+                    : (b < 0.95 ? medium(random) : large(random));
+  } };
+
+  Workload workload{};
+  workload.initial_sizes.resize(kLiveCount);
+  std::ranges::generate(workload.initial_sizes, draw_size);
+  workload.sizes.resize(operation_count);
+  std::ranges::generate(workload.sizes, draw_size);
+  workload.slots.resize(operation_count);
+  std::ranges::generate(workload.slots, [&] { return slot(random); });
+  return workload;
+}
+
+/**
+ * @brief Fill a live set, then repeatedly free a random live allocation and
+ *        allocate a new one, timing every pair.
+ *
+ * The live set is freed before returning, unless keep_live is set, in which
+ * case it is returned through live for fragmentation statistics.
+ */
+template <typename AllocateFn, typename FreeFn>
+ChurnResult RunChurn(const Workload& workload, AllocateFn allocate,
+                     FreeFn free, std::vector<void*>* live = nullptr) {
+  using Clock = std::chrono::steady_clock;
+
+  std::vector<void*> blocks(kLiveCount, nullptr);
+  std::vector<std::uint32_t> block_sizes{ workload.initial_sizes };
+  for (std::size_t i{ 0U }; i < kLiveCount; ++i) {
+    blocks[i] = allocate(block_sizes[i]);
+  }
+
+  std::vector<double> samples{};
+  samples.reserve(workload.sizes.size());
+  const Clock::time_point begin{ Clock::now() };
+  for (std::size_t op{ 0U }; op < workload.sizes.size(); ++op) {
+    const std::uint32_t slot{ workload.slots[op] };
+    const Clock::time_point start{ Clock::now() };
+    free(blocks[slot]);
+    blocks[slot] = allocate(workload.sizes[op]);
+    const Clock::time_point end{ Clock::now() };
+
+    // Touch the block, as its owner would
+    *static_cast<std::byte*>(blocks[slot]) = std::byte{ 1 };
+    block_sizes[slot] = workload.sizes[op];
+    samples.emplace_back(
+      std::chrono::duration<double, std::nano>(end - start).count()
+    );
+  }
+  const double seconds{
+    std::chrono::duration<double>(Clock::now() - begin).count()
+  };
+
+  ChurnResult result{};
+  for (const std::uint32_t size : block_sizes) {
+    result.live_bytes += size;
+  }
+  if (live) {
+    *live = std::move(blocks);
+  } else {
+    for (void* block : blocks) {
+      free(block);
+    }
+  }
+
+  result.operations_per_second =
+    static_cast<double>(samples.size()) / seconds;
+  result.times = Summarize(std::move(samples));
+  return result;
+}
+
+/**
+ * @brief Run the same churn on several threads at once, each with its own
+ *        workload, and combine their results.
+ */
+template <typename AllocateFn, typename FreeFn>
+ChurnResult RunThreadedChurn(const std::vector<Workload>& workloads,
+                             AllocateFn allocate, FreeFn free) {
+  std::vector<ChurnResult> results(workloads.size());
+  std::vector<std::thread> threads{};
+  for (std::size_t t{ 0U }; t < workloads.size(); ++t) {
+    threads.emplace_back([&, t] {
+      results[t] = RunChurn(workloads[t], allocate, free);
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  // Throughput adds up; latencies are those of the slowest thread
+  ChurnResult combined{};
+  for (const ChurnResult& result : results) {
+    combined.operations_per_second += result.operations_per_second;
+    combined.times.p50 = std::max(combined.times.p50, result.times.p50);
+    combined.times.p99 = std::max(combined.times.p99, result.times.p99);
+    combined.times.p999 = std::max(combined.times.p999, result.times.p999);
+    combined.times.max = std::max(combined.times.max, result.times.max);
+    combined.live_bytes += result.live_bytes;
+  }
+  return combined;
+}
+
+/**
+ * @brief Print a throughput and latency row.
+ */
+void ReportChurn(std::string_view name, const ChurnResult& result) {
+  std::cout << fmt::format("{:<28} {:>12.2f} {:>8.0f} {:>8.0f} {:>9.0f} "
+                           "{:>10.0f}\n", name,
+                           result.operations_per_second / 1.0e6,
+                           result.times.p50, result.times.p99,
+                           result.times.p999, result.times.max);
+}
+
+/**
+ * @brief Print how much memory a live set occupies.
+ *
+ * @param live_bytes Bytes requested by the live allocations
+ * @param block_bytes Bytes of the blocks holding them
+ * @param hole_bytes Free bytes between blocks, excluding the untouched end
+ *                   of the heap
+ */
+void ReportFragmentation(std::string_view name, std::size_t live_bytes,
+                         std::size_t block_bytes, std::size_t hole_bytes) {
+  const double live{ static_cast<double>(live_bytes) };
+  std::cout << fmt::format("{:<28} {:>10.1f} {:>10.1f} {:>9.1f}% {:>10.1f} "
+                           "{:>9.1f}%\n", name, live / 1048576.0,
+                           static_cast<double>(block_bytes) / 1048576.0,
+                           100.0 * (static_cast<double>(block_bytes) / live
+                                    - 1.0),
+                           static_cast<double>(hole_bytes) / 1048576.0,
+                           100.0 * static_cast<double>(hole_bytes) / live);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc > 2) {
+    std::cerr << "Usage: MapleAllocatorBenchmark [operations]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    maple::core::Log::Initialize();
+    const std::size_t operation_count{
+      argc == 2 ? static_cast<std::size_t>(std::stoull(argv[1]))
+                : kDefaultOperationCount
+    };
+    const Workload mixed{ MakeWorkload(operation_count, 1U, false) };
+    const Workload fixed{ MakeWorkload(operation_count, 2U, true) };
+    std::vector<Workload> threaded{};
+    for (std::uint32_t t{ 0U }; t < kThreadCount; ++t) {
+      threaded.push_back(MakeWorkload(operation_count, 10U + t, false));
+    }
+
+    const auto malloc_allocate{ [](std::size_t size) {
+      void* block{ std::malloc(size) };
+      if (!block) {
+        throw std::bad_alloc{};
+      }
+      return block;
+    } };
+    const auto malloc_free{ [](void* block) { std::free(block); } };
+    const auto memory_allocate{ [](std::size_t size) {
+      return maple::core::Memory::Allocate(size);
+    } };
+    const auto memory_free{ [](void* block) {
+      maple::core::Memory::Free(block);
+    } };
+
+    std::cout << fmt::format("{} live allocation(s), {} free+allocate "
+                             "operation(s) per thread\n\n", kLiveCount,
+                             operation_count);
+    std::cout << fmt::format("{:<28} {:>12} {:>8} {:>8} {:>9} {:>10}\n",
+                             "Free+allocate", "Mops/s", "p50 ns", "p99 ns",
+                             "p99.9 ns", "Max ns");
+
+    // Fixed-size objects: one size-class pool versus malloc
+    ReportChurn(fmt::format("malloc, {} B", kPoolBlockSize),
+                RunChurn(fixed, malloc_allocate, malloc_free));
+    maple::core::PoolAllocator pool{ kPoolBlockSize, 256U };
+    ReportChurn(fmt::format("PoolAllocator, {} B", kPoolBlockSize),
+                RunChurn(fixed, [&pool](std::size_t) {
+                  return pool.Allocate();
+                }, [&pool](void* block) { pool.Free(block); }));
+
+    // Mixed sizes, keeping the live sets for fragmentation statistics; the
+    // heap's state before the run is subtracted to leave out the workloads
+#if defined(__GLIBC__)
+    const struct mallinfo2 malloc_before{ mallinfo2() };
+#endif
+    std::vector<void*> malloc_live{};
+    const ChurnResult malloc_result{
+      RunChurn(mixed, malloc_allocate, malloc_free, &malloc_live)
+    };
+    ReportChurn("malloc, mixed", malloc_result);
+#if defined(__GLIBC__)
+    const struct mallinfo2 malloc_after{ mallinfo2() };
+#endif
+    for (void* block : malloc_live) {
+      std::free(block);
+    }
+
+    auto tlsf_memory{ std::make_unique_for_overwrite<std::byte[]>(
+      kTLSFPoolSize
+    ) };
+    maple::core::TLSFAllocator tlsf{};
+    if (!tlsf.AddPool(tlsf_memory.get(), kTLSFPoolSize)) {
+      throw std::runtime_error{ "Failed to add the TLSF pool" };
+    }
+    std::vector<void*> tlsf_live{};
+    const ChurnResult tlsf_result{ RunChurn(mixed, [&tlsf](std::size_t size) {
+      void* block{ tlsf.Allocate(size) };
+      if (!block) {
+        throw std::runtime_error{ "TLSF pool exhausted" };
+      }
+      return block;
+    }, [&tlsf](void* block) { tlsf.Free(block); }, &tlsf_live) };
+    ReportChurn("TLSFAllocator, mixed", tlsf_result);
+    const maple::core::TLSFStats tlsf_stats{ tlsf.GetStats() };
+    for (void* block : tlsf_live) {
+      tlsf.Free(block);
+    }
+
+    ReportChurn("Memory (pools + TLSF), mixed",
+                RunChurn(mixed, memory_allocate, memory_free));
+
+    // Mixed sizes on several threads; only the thread-safe allocators
+    ReportChurn(fmt::format("malloc, mixed, {} threads", kThreadCount),
+                RunThreadedChurn(threaded, malloc_allocate, malloc_free));
+    ReportChurn(fmt::format("Memory, mixed, {} threads", kThreadCount),
+                RunThreadedChurn(threaded, memory_allocate, memory_free));
+
+    // Fragmentation with the mixed live set still allocated
+    std::cout << fmt::format("\n{:<28} {:>10} {:>10} {:>10} {:>10} {:>10}\n",
+                             "Mixed live set", "Live MiB", "Block MiB",
+                             "Overhead", "Hole MiB", "Holes");
+    ReportFragmentation("TLSFAllocator", tlsf_result.live_bytes,
+                        tlsf_stats.used_bytes
+                          + tlsf_stats.used_blocks
+                              * maple::core::TLSFAllocator::kBlockOverhead,
+                        tlsf_stats.free_bytes - tlsf_stats.largest_free_block);
+#if defined(__GLIBC__)
+    // The top chunk (keepcost) is the untouched end of the main arena
+    const auto delta{ [](std::size_t after, std::size_t before) {
+      return after > before ? after - before : std::size_t{ 0U };
+    } };
+    const std::size_t malloc_block_bytes{
+      delta(malloc_after.uordblks + malloc_after.hblkhd,
+            malloc_before.uordblks + malloc_before.hblkhd)
+    };
+    // Interposed allocators (e.g., sanitizers) leave mallinfo2() empty
+    if (malloc_block_bytes > 0U) {
+      ReportFragmentation(
+        "glibc malloc", malloc_result.live_bytes, malloc_block_bytes,
+        delta(malloc_after.fordblks - malloc_after.keepcost,
+              malloc_before.fordblks - malloc_before.keepcost)
+      );
+    }
+#endif
+
+    maple::core::Log::Shutdown();
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,228 @@
+// STL
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// EASTL
+#include "EASTL/vector.h"
+
+// fmt
+#include "fmt/format.h"
+
+// Core
+#include "Core/FrameArena.h"
+#include "Core/LinearArena.h"
+#include "Core/Log.h"
+
+// Programs
+#include "BenchmarkTiming.h"
+
+namespace {
+
+using maple::benchmark::Summarize;
+using maple::benchmark::Times;
+
+/// Frames simulated per case unless given on the command line
+constexpr std::uint32_t kDefaultFrameCount{ 2'000U };
+
+/// Temporary containers built every frame
+constexpr std::size_t kContainersPerFrame{ 1'024U };
+
+/// Most elements pushed into one temporary container
+constexpr std::uint32_t kMaxContainerSize{ 256U };
+
+/// Raw temporary allocations made every frame
+constexpr std::size_t kAllocationsPerFrame{ 8'192U };
+
+/// Largest raw temporary allocation in bytes
+constexpr std::uint32_t kMaxAllocationSize{ 1'024U };
+
+/// Capacity of each frame's arena, enough for a frame of either workload
+constexpr std::size_t kArenaCapacity{ 16U * 1024U * 1024U };
+
+/// Frames in flight, as in Application
+constexpr std::uint32_t kFramesInFlight{ 2U };
+
+/**
+ * @brief Element of the temporary containers (e.g., a draw item).
+ */
+struct Item {
+  std::uint32_t key{ 0U };
+  std::uint32_t index{ 0U };
+  float depth{ 0.0F };
+  float weight{ 0.0F };
+};
+
+/**
+ * @brief Run a frame function repeatedly and summarize its frame times,
+ *        in microseconds.
+ */
+Times Measure(std::uint32_t frame_count,
+              const std::function<void(std::uint32_t)>& frame) {
+  using Clock = std::chrono::steady_clock;
+
+  std::vector<double> samples{};
+  samples.reserve(frame_count);
+  for (std::uint32_t f{ 0U }; f < frame_count; ++f) {
+    const Clock::time_point start{ Clock::now() };
+    frame(f);
+    samples.emplace_back(
+      std::chrono::duration<double, std::micro>(Clock::now() - start).count()
+    );
+  }
+
+  return Summarize(std::move(samples));
+}
+
+/**
+ * @brief Print a case's frame times, relative to a baseline case.
+ */
+void Report(std::string_view name, const Times& times,
+            const Times& baseline) {
+  std::cout << fmt::format("{:<34} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f} "
+                           "{:>8.2f}x\n", name, times.mean, times.p50,
+                           times.p99, times.max, baseline.mean / times.mean);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc > 2) {
+    std::cerr << "Usage: MapleArenaBenchmark [frames]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    maple::core::Log::Initialize();
+    const std::uint32_t frame_count{
+      argc == 2 ? static_cast<std::uint32_t>(std::stoul(argv[1]))
+                : kDefaultFrameCount
+    };
+
+    // Sizes are drawn once, so every case does the same work per frame
+    std::mt19937 random{ 42U };
+    std::uniform_int_distribution<std::uint32_t> container_size{
+      1U, kMaxContainerSize
+    };
+    std::uniform_int_distribution<std::uint32_t> allocation_size{
+      16U, kMaxAllocationSize
+    };
+    std::vector<std::uint32_t> container_sizes(kContainersPerFrame);
+    std::vector<std::uint32_t> allocation_sizes(kAllocationsPerFrame);
+    std::ranges::generate(container_sizes, [&] {
+      return container_size(random);
+    });
+    std::ranges::generate(allocation_sizes, [&] {
+      return allocation_size(random);
+    });
+
+    // Containers are grown one element at a time, like temporaries that
+    // gather items without knowing their final size
+    const auto fill{ [&container_sizes](auto& containers, std::size_t c,
+                                        std::uint32_t frame) {
+      auto& items{ containers[c] };
+      for (std::uint32_t i{ 0U }; i < container_sizes[c]; ++i) {
+        items.push_back(Item{ .key = frame, .index = i,
+                              .depth = static_cast<float>(i),
+                              .weight = 1.0F });
+      }
+    } };
+
+    // std::vector on the global heap; the frame's containers are freed at
+    // the end of the frame
+    std::vector<std::vector<Item>> heap_containers{};
+    heap_containers.reserve(kContainersPerFrame);
+    const Times heap_containers_times{ Measure(
+      frame_count, [&](std::uint32_t frame) {
+        for (std::size_t c{ 0U }; c < kContainersPerFrame; ++c) {
+          heap_containers.emplace_back();
+          fill(heap_containers, c, frame);
+        }
+        heap_containers.clear();
+      }
+    ) };
+
+    // eastl::vector on the frame arena, released in bulk by BeginFrame()
+    maple::core::FrameArena frame_arena{ kArenaCapacity, kFramesInFlight };
+    using ArenaVector = eastl::vector<Item, maple::core::ArenaAllocator>;
+    std::vector<ArenaVector> arena_containers{};
+    arena_containers.reserve(kContainersPerFrame);
+    const Times arena_containers_times{ Measure(
+      frame_count, [&](std::uint32_t frame) {
+        frame_arena.BeginFrame();
+        const maple::core::ArenaAllocator allocator{
+          frame_arena.GetAllocator()
+        };
+        for (std::size_t c{ 0U }; c < kContainersPerFrame; ++c) {
+          arena_containers.emplace_back(allocator);
+          fill(arena_containers, c, frame);
+        }
+        arena_containers.clear();
+      }
+    ) };
+    const std::size_t container_peak{ frame_arena.GetCurrent().GetPeak() };
+
+    // Raw allocations: malloc and free versus bump allocation
+    std::vector<void*> blocks(kAllocationsPerFrame, nullptr);
+    const Times malloc_times{ Measure(
+      frame_count, [&](std::uint32_t) {
+        for (std::size_t i{ 0U }; i < kAllocationsPerFrame; ++i) {
+          blocks[i] = std::malloc(allocation_sizes[i]);
+          *static_cast<std::byte*>(blocks[i]) = std::byte{ 1 };
+        }
+        for (void* block : blocks) {
+          std::free(block);
+        }
+      }
+    ) };
+
+    maple::core::FrameArena raw_arena{ kArenaCapacity, kFramesInFlight };
+    const Times arena_times{ Measure(
+      frame_count, [&](std::uint32_t) {
+        raw_arena.BeginFrame();
+        maple::core::LinearArena& arena{ raw_arena.GetCurrent() };
+        for (std::size_t i{ 0U }; i < kAllocationsPerFrame; ++i) {
+          blocks[i] = arena.Allocate(allocation_sizes[i]);
+          *static_cast<std::byte*>(blocks[i]) = std::byte{ 1 };
+        }
+      }
+    ) };
+    const std::size_t raw_peak{ raw_arena.GetCurrent().GetPeak() };
+
+    std::cout << fmt::format("{} frame(s); {} containers of 1-{} items and "
+                             "{} allocations of 16-{} bytes per frame\n\n",
+                             frame_count, kContainersPerFrame,
+                             kMaxContainerSize, kAllocationsPerFrame,
+                             kMaxAllocationSize);
+    std::cout << fmt::format("{:<34} {:>10} {:>10} {:>10} {:>10} {:>9}\n",
+                             "Frame time (us)", "Mean", "p50", "p99", "Max",
+                             "Speedup");
+    Report("std::vector, std::allocator", heap_containers_times,
+           heap_containers_times);
+    Report("eastl::vector, ArenaAllocator", arena_containers_times,
+           heap_containers_times);
+    Report("malloc/free", malloc_times, malloc_times);
+    Report("LinearArena::Allocate", arena_times, malloc_times);
+    std::cout << fmt::format("\nArena peak per frame: containers {:.1f} KiB, "
+                             "allocations {:.1f} KiB\n",
+                             static_cast<double>(container_peak) / 1024.0,
+                             static_cast<double>(raw_peak) / 1024.0);
+
+    maple::core::Log::Shutdown();
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
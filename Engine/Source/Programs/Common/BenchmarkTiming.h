@@ -0,0 +1,89 @@
+#pragma once
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace maple::benchmark {
+
+/**
+ * @brief Times of one benchmark case, in the unit of its samples.
+ */
+struct Times {
+  double mean{ 0.0 };
+  double p50{ 0.0 };
+  double p99{ 0.0 };
+  double p999{ 0.0 };
+  double max{ 0.0 };
+};
+
+/**
+ * @brief Summarize timed samples.
+ *
+ * Percentiles are nearest-rank below: the pth percentile of n sorted
+ * samples is the sample at index n * p / 100.
+ *
+ * @param samples Times of every run, in any unit and order
+ * @return Mean, percentile and maximum times, in the unit of the samples
+ * @throws std::invalid_argument if samples is empty
+ */
+inline Times Summarize(std::vector<double> samples) {
+  if (samples.empty()) {
+    throw std::invalid_argument{ "Benchmark case must run at least once" };
+  }
+
+  std::ranges::sort(samples);
+  double total{ 0.0 };
+  for (const double sample : samples) {
+    total += sample;
+  }
+  return Times{
+    .mean = total / static_cast<double>(samples.size()),
+    .p50 = samples[samples.size() / 2U],
+    .p99 = samples[samples.size() * 99U / 100U],
+    .p999 = samples[samples.size() * 999U / 1000U],
+    .max = samples.back()
+  };
+}
+
+/**
+ * @brief Run a function repeatedly and summarize its times.
+ *
+ * @code
+ * const benchmark::Times times{ benchmark::Measure<std::micro>(100U, [&] {
+ *   Update(scene);
+ * }) };
+ * @endcode
+ *
+ * @tparam Period Unit of the returned times (e.g., std::milli)
+ * @param count Number of runs (must not be zero)
+ * @param function Function to time
+ * @return Summary of the run times, as by Summarize()
+ * @throws std::invalid_argument if count is zero
+ */
+template <typename Period>
+Times Measure(std::size_t count, const std::function<void()>& function) {
+  if (count == 0U) {
+    throw std::invalid_argument{ "Benchmark case must run at least once" };
+  }
+
+  using Clock = std::chrono::steady_clock;
+  std::vector<double> samples{};
+  samples.reserve(count);
+  for (std::size_t i{ 0U }; i < count; ++i) {
+    const Clock::time_point start{ Clock::now() };
+    function();
+    samples.emplace_back(
+      std::chrono::duration<double, Period>(Clock::now() - start).count()
+    );
+  }
+
+  return Summarize(std::move(samples));
+}
+
+} // namespace maple::benchmark
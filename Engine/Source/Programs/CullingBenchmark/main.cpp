@@ -0,0 +1,300 @@
+// STL
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <numbers>
+#include <random>
+#include <ratio>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// fmt
+#include "fmt/format.h"
+
+// glm
+#include "glm/mat4x4.hpp"
+#include "glm/vec3.hpp"
+
+// Core
+#include "Core/JobSystem.h"
+#include "Core/Log.h"
+
+// Renderer
+#include "Renderer/Visibility.h"
+
+// Programs
+#include "BenchmarkTiming.h"
+
+namespace {
+
+namespace core = maple::core;
+namespace renderer = maple::renderer;
+
+using maple::benchmark::Measure;
+using maple::benchmark::Times;
+
+/// Renderable counts of the benchmarked scenes
+constexpr std::size_t kRenderableCounts[]{ 10'000U, 100'000U, 1'000'000U };
+
+/// Renderables tested per case, so small scenes are culled more often
+constexpr std::size_t kRenderablesPerCase{ 20'000'000U };
+
+/// Side of the square of ground each renderable gets on average, so
+/// larger scenes cover more ground
+constexpr float kSpacing{ 4.0F };
+
+/// Walls used as occluders (e.g., building facades)
+constexpr std::size_t kWallCount{ 32U };
+
+/// Farthest distance of a wall from the camera
+constexpr float kWallDistance{ 150.0F };
+
+/// Vertical field of view, in radians
+constexpr float kFieldOfView{ std::numbers::pi_v<float> / 3.0F };
+
+/// Width over height of the views
+constexpr float kAspect{ 16.0F / 9.0F };
+
+/// Near and far plane distances of the views
+constexpr float kNear{ 0.1F };
+constexpr float kFar{ 1000.0F };
+
+/**
+ * @brief World-space axis-aligned bounding box.
+ */
+struct Box {
+  glm::vec3 min{};
+  glm::vec3 max{};
+};
+
+/**
+ * @brief Make the world-to-clip transform of a camera looking level along
+ *        a heading, with clip-space depth in [0, w].
+ *
+ * @param eye Camera position
+ * @param yaw Heading in radians, 0 looking along +z
+ */
+glm::mat4 MakeViewProjection(const glm::vec3& eye, float yaw) {
+  const std::array<float, 3U> right{ std::cos(yaw), 0.0F, -std::sin(yaw) };
+  const std::array<float, 3U> up{ 0.0F, 1.0F, 0.0F };
+  const std::array<float, 3U> forward{ std::sin(yaw), 0.0F, std::cos(yaw) };
+  const auto view_row{ [&eye](const std::array<float, 3U>& axis) {
+    return std::array<float, 4U>{
+      axis[0], axis[1], axis[2],
+      -(axis[0] * eye.x + axis[1] * eye.y + axis[2] * eye.z)
+    };
+  } };
+
+  const float focal{ 1.0F / std::tan(kFieldOfView / 2.0F) };
+  const float depth_scale{ kFar / (kFar - kNear) };
+  const std::array<float, 4U> x{ view_row(right) };
+  const std::array<float, 4U> y{ view_row(up) };
+  const std::array<float, 4U> z{ view_row(forward) };
+  glm::mat4 view_projection{ 0.0F };
+  for (int c{ 0 }; c < 4; ++c) {
+    view_projection[c][0] = focal / kAspect * x[c];
+    view_projection[c][1] = focal * y[c];
+    view_projection[c][2] = depth_scale * z[c];
+    view_projection[c][3] = z[c];
+  }
+  view_projection[3][2] -= depth_scale * kNear;
+  return view_projection;
+}
+
+/**
+ * @brief Count the boxes inside a view's frustum one at a time, on one
+ *        thread, as the baseline.
+ */
+std::size_t CountVisible(std::span<const Box> boxes,
+                         const glm::mat4& view_projection) {
+  const auto row{ [&view_projection](int r) {
+    return std::array<float, 4U>{ view_projection[0][r],
+                                  view_projection[1][r],
+                                  view_projection[2][r],
+                                  view_projection[3][r] };
+  } };
+  const std::array<float, 4U> rows[4]{ row(0), row(1), row(2), row(3) };
+  std::array<std::array<float, 4U>, 6U> planes{};
+  for (std::size_t i{ 0U }; i < 4U; ++i) {
+    planes[0][i] = rows[3][i] + rows[0][i];
+    planes[1][i] = rows[3][i] - rows[0][i];
+    planes[2][i] = rows[3][i] + rows[1][i];
+    planes[3][i] = rows[3][i] - rows[1][i];
+    planes[4][i] = rows[2][i];
+    planes[5][i] = rows[3][i] - rows[2][i];
+  }
+
+  std::size_t visible{ 0U };
+  for (const Box& box : boxes) {
+    bool inside{ true };
+    for (const std::array<float, 4U>& plane : planes) {
+      // Corner of the box farthest along the plane's normal
+      const float x{ plane[0] > 0.0F ? box.max.x : box.min.x };
+      const float y{ plane[1] > 0.0F ? box.max.y : box.min.y };
+      const float z{ plane[2] > 0.0F ? box.max.z : box.min.z };
+      if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < 0.0F) {
+        inside = false;
+        break;
+      }
+    }
+    visible += inside ? 1U : 0U;
+  }
+  return visible;
+}
+
+/**
+ * @brief Print a case, with its speedup per box and view tested over the
+ *        baseline.
+ */
+void Report(std::size_t renderable_count, std::string_view name,
+            const Times& times, const renderer::VisibilityStats& stats,
+            const Times& baseline) {
+  const std::size_t tested{ stats.renderable_count * stats.view_count };
+  const double ns_per_box{
+    times.mean * 1.0e3 / static_cast<double>(tested)
+  };
+  const double baseline_ns_per_box{
+    baseline.mean * 1.0e3 / static_cast<double>(renderable_count)
+  };
+  std::cout << fmt::format(
+    "{:>9} {:<26} {:>10.1f} {:>10.1f} {:>9} {:>9} {:>9} {:>10.2f} "
+    "{:>8.2f}x\n",
+    renderable_count, name, times.mean, times.p99, stats.visible_count,
+    stats.frustum_culled_count, stats.occlusion_culled_count,
+    ns_per_box, baseline_ns_per_box / ns_per_box
+  );
+}
+
+/**
+ * @brief Cull a city-like scene: boxes scattered over the ground around
+ *        the camera, with walls standing in front of it.
+ */
+void Benchmark(std::size_t renderable_count) {
+  std::mt19937 random{ 42U };
+  const float half_side{
+    kSpacing * std::sqrt(static_cast<float>(renderable_count)) / 2.0F
+  };
+  std::uniform_real_distribution<float> position{ -half_side, half_side };
+  std::uniform_real_distribution<float> size{ 0.5F, 4.0F };
+  std::uniform_real_distribution<float> height{ 0.5F, 8.0F };
+
+  renderer::Visibility visibility{};
+  std::vector<Box> boxes(renderable_count);
+  for (Box& box : boxes) {
+    const float x{ position(random) };
+    const float z{ position(random) };
+    const float half_size{ size(random) / 2.0F };
+    box = Box{ .min = glm::vec3{ x - half_size, 0.0F, z - half_size },
+               .max = glm::vec3{ x + half_size, height(random),
+                                 z + half_size } };
+    static_cast<void>(visibility.AddRenderable(box.min, box.max));
+  }
+
+  // Walls face the camera at the origin, spread all around it
+  std::uniform_real_distribution<float> angle{
+    0.0F, 2.0F * std::numbers::pi_v<float>
+  };
+  std::uniform_real_distribution<float> distance{ 10.0F, kWallDistance };
+  std::uniform_real_distribution<float> wall_width{ 10.0F, 40.0F };
+  std::uniform_real_distribution<float> wall_height{ 10.0F, 30.0F };
+  for (std::size_t w{ 0U }; w < kWallCount; ++w) {
+    const float heading{ angle(random) };
+    const float center_distance{ distance(random) };
+    const float half_width{ wall_width(random) / 2.0F };
+    const float top{ wall_height(random) };
+    const float cx{ std::sin(heading) * center_distance };
+    const float cz{ std::cos(heading) * center_distance };
+    const float dx{ std::cos(heading) * half_width };
+    const float dz{ -std::sin(heading) * half_width };
+    const glm::vec3 vertices[]{
+      glm::vec3{ cx - dx, 0.0F, cz - dz }, glm::vec3{ cx + dx, 0.0F, cz + dz },
+      glm::vec3{ cx + dx, top, cz + dz }, glm::vec3{ cx - dx, top, cz - dz }
+    };
+    constexpr std::uint32_t kIndices[]{ 0U, 1U, 2U, 0U, 2U, 3U };
+    visibility.AddOccluder(vertices, kIndices);
+  }
+
+  // Eye height of a person; four views cover every heading, like the
+  // faces of a cube map
+  const glm::vec3 eye{ 0.0F, 1.7F, 0.0F };
+  std::vector<renderer::CullView> views{};
+  for (std::size_t v{ 0U }; v < 4U; ++v) {
+    views.push_back(renderer::CullView{
+      .view_projection = MakeViewProjection(
+        eye, static_cast<float>(v) * std::numbers::pi_v<float> / 2.0F
+      )
+    });
+  }
+  std::vector<renderer::CullView> occlusion_views{ views };
+  for (renderer::CullView& view : occlusion_views) {
+    view.occlusion_culling = true;
+  }
+  const std::span<const renderer::CullView> one_view{ views.data(), 1U };
+  const std::span<const renderer::CullView> one_occlusion_view{
+    occlusion_views.data(), 1U
+  };
+
+  const std::size_t cull_count{
+    std::max<std::size_t>(kRenderablesPerCase / renderable_count, 10U)
+  };
+  std::size_t baseline_visible{ 0U };
+  const Times baseline{ Measure<std::micro>(cull_count, [&] {
+    baseline_visible = CountVisible(boxes, views[0].view_projection);
+  }) };
+  Report(renderable_count, "Baseline, 1 view", baseline,
+         renderer::VisibilityStats{
+           .view_count = 1U,
+           .renderable_count = renderable_count,
+           .frustum_culled_count = renderable_count - baseline_visible,
+           .visible_count = baseline_visible
+         }, baseline);
+
+  const auto run_case{ [&](std::string_view name,
+                           std::span<const renderer::CullView> case_views) {
+    const Times times{ Measure<std::micro>(cull_count, [&] {
+      visibility.Cull(case_views);
+    }) };
+    Report(renderable_count, name, times, visibility.GetStats(), baseline);
+  } };
+  run_case("Frustum, 1 view", one_view);
+  run_case("Frustum+occlusion, 1 view", one_occlusion_view);
+  run_case("Frustum, 4 views", views);
+  run_case("Frustum+occlusion, 4 views", occlusion_views);
+}
+
+} // namespace
+
+int main() {
+  try {
+    core::Log::Initialize();
+    core::JobSystem::Initialize();
+
+    std::cout << fmt::format("{} job thread(s); {} occluder walls; "
+                             "speedup per box over the single-threaded "
+                             "scalar baseline\n\n", core::JobSystem::GetThreadCount(),
+                             kWallCount);
+    std::cout << fmt::format("{:>9} {:<26} {:>10} {:>10} {:>9} {:>9} {:>9} "
+                             "{:>10} {:>9}\n", "Boxes", "Case", "Mean us",
+                             "p99 us", "Visible", "Frustum", "Occluded",
+                             "ns/box", "Speedup");
+    for (const std::size_t renderable_count : kRenderableCounts) {
+      Benchmark(renderable_count);
+    }
+
+    core::JobSystem::Shutdown();
+    core::Log::Shutdown();
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    core::JobSystem::Shutdown();
+    core::Log::Shutdown();
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
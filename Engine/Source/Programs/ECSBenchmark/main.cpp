@@ -0,0 +1,276 @@
+// STL
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <ratio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// fmt
+#include "fmt/format.h"
+
+// Core
+#include "Core/JobSystem.h"
+#include "Core/Log.h"
+
+// ECS
+#include "ECS/CommandBuffer.h"
+#include "ECS/Entity.h"
+#include "ECS/Query.h"
+#include "ECS/World.h"
+
+// Programs
+#include "BenchmarkTiming.h"
+
+namespace {
+
+namespace benchmark = maple::benchmark;
+namespace ecs = maple::ecs;
+
+/// Entities per case unless given on the command line
+constexpr std::uint32_t kDefaultEntityCount{ 1'000'000U };
+
+/// Iterations measured per iteration case
+constexpr std::uint32_t kIterationCount{ 100U };
+
+/// Time step of the simulated updates
+constexpr float kDeltaTime{ 1.0F / 60.0F };
+
+struct Position {
+  float x{ 0.0F };
+  float y{ 0.0F };
+  float z{ 0.0F };
+};
+
+struct Velocity {
+  float x{ 1.0F };
+  float y{ 0.0F };
+  float z{ 0.0F };
+};
+
+struct Acceleration {
+  float x{ 0.0F };
+  float y{ -9.8F };
+  float z{ 0.0F };
+};
+
+struct Damping {
+  float factor{ 0.99F };
+};
+
+/**
+ * @brief Scene object holding its components, allocated on its own, as the
+ *        pointer-chasing baseline.
+ */
+struct SceneObject {
+  Position position{};
+  Velocity velocity{};
+  Acceleration acceleration{};
+  Damping damping{};
+};
+
+/**
+ * @brief Time kIterationCount runs of a function, in milliseconds.
+ */
+benchmark::Times MeasureIterations(const std::function<void()>& function) {
+  return benchmark::Measure<std::milli>(kIterationCount, function);
+}
+
+/**
+ * @brief Time a function once, in milliseconds.
+ */
+double MeasureOnce(const std::function<void()>& function) {
+  return benchmark::Measure<std::milli>(1U, function).mean;
+}
+
+/**
+ * @brief Print an iteration case.
+ */
+void ReportIteration(std::string_view name, std::uint32_t entity_count,
+                     const benchmark::Times& times) {
+  std::cout << fmt::format(
+    "{:<36} {:>10.3f} {:>10.3f} {:>12.2f}\n", name, times.mean,
+    times.p99, times.mean * 1.0e6 / static_cast<double>(entity_count)
+  );
+}
+
+/**
+ * @brief Print a structural change case.
+ */
+void ReportChange(std::string_view name, std::uint32_t entity_count,
+                  double ms) {
+  std::cout << fmt::format(
+    "{:<36} {:>10.3f} {:>12.2f}\n", name, ms,
+    ms * 1.0e6 / static_cast<double>(entity_count)
+  );
+}
+
+/**
+ * @brief Iterate entities with 1, 2 and 4 components, serially and on the
+ *        job system, against individually allocated objects.
+ */
+void BenchmarkIteration(std::uint32_t entity_count) {
+  ecs::World world{};
+  for (std::uint32_t i{ 0U }; i < entity_count; ++i) {
+    static_cast<void>(world.CreateEntity(
+      Position{ .x = static_cast<float>(i) }, Velocity{}, Acceleration{},
+      Damping{}
+    ));
+  }
+
+  ecs::Query<Position> one{ world };
+  ecs::Query<Position, const Velocity> two{ world };
+  ecs::Query<Position, Velocity, const Acceleration, const Damping> four{
+    world
+  };
+  const auto update_one{ [](Position& position) {
+    position.y += kDeltaTime;
+  } };
+  const auto update_two{ [](Position& position, const Velocity& velocity) {
+    position.x += velocity.x * kDeltaTime;
+    position.y += velocity.y * kDeltaTime;
+    position.z += velocity.z * kDeltaTime;
+  } };
+  const auto update_four{ [](Position& position, Velocity& velocity,
+                             const Acceleration& acceleration,
+                             const Damping& damping) {
+    velocity.x = (velocity.x + acceleration.x * kDeltaTime) * damping.factor;
+    velocity.y = (velocity.y + acceleration.y * kDeltaTime) * damping.factor;
+    velocity.z = (velocity.z + acceleration.z * kDeltaTime) * damping.factor;
+    position.x += velocity.x * kDeltaTime;
+    position.y += velocity.y * kDeltaTime;
+    position.z += velocity.z * kDeltaTime;
+  } };
+
+  // Objects are allocated in order but visited in shuffled order, as a
+  // scene graph's nodes end up scattered after a level has been edited
+  std::vector<std::unique_ptr<SceneObject>> objects{};
+  objects.reserve(entity_count);
+  for (std::uint32_t i{ 0U }; i < entity_count; ++i) {
+    objects.push_back(std::make_unique<SceneObject>());
+  }
+  std::ranges::shuffle(objects, std::mt19937{ 42U });
+
+  std::cout << fmt::format("{:<36} {:>10} {:>10} {:>12}\n", "Iteration",
+                           "Mean ms", "p99 ms", "ns/entity");
+  ReportIteration("1 component", entity_count, MeasureIterations(
+    [&] { one.ForEach(update_one); }
+  ));
+  ReportIteration("2 components", entity_count, MeasureIterations(
+    [&] { two.ForEach(update_two); }
+  ));
+  ReportIteration("4 components", entity_count, MeasureIterations(
+    [&] { four.ForEach(update_four); }
+  ));
+  ReportIteration("1 component, parallel", entity_count, MeasureIterations(
+    [&] { one.ParallelForEach(update_one); }
+  ));
+  ReportIteration("2 components, parallel", entity_count, MeasureIterations(
+    [&] { two.ParallelForEach(update_two); }
+  ));
+  ReportIteration("4 components, parallel", entity_count, MeasureIterations(
+    [&] { four.ParallelForEach(update_four); }
+  ));
+  const auto update_objects{ [&] {
+    for (const std::unique_ptr<SceneObject>& object : objects) {
+      update_four(object->position, object->velocity, object->acceleration,
+                  object->damping);
+    }
+  } };
+  ReportIteration("4 components, heap objects", entity_count,
+                  MeasureIterations(update_objects));
+}
+
+/**
+ * @brief Create and destroy entities and add and remove components, both
+ *        directly and through a command buffer.
+ */
+void BenchmarkStructuralChanges(std::uint32_t entity_count) {
+  ecs::World world{};
+  std::vector<ecs::Entity> entities(entity_count);
+
+  std::cout << fmt::format("\n{:<36} {:>10} {:>12}\n", "Structural change",
+                           "ms", "ns/entity");
+  ReportChange("Create (2 components)", entity_count, MeasureOnce([&] {
+    for (ecs::Entity& entity : entities) {
+      entity = world.CreateEntity(Position{}, Velocity{});
+    }
+  }));
+  ReportChange("Add component", entity_count, MeasureOnce([&] {
+    for (const ecs::Entity entity : entities) {
+      static_cast<void>(world.AddComponent(entity, Acceleration{}));
+    }
+  }));
+  ReportChange("Remove component", entity_count, MeasureOnce([&] {
+    for (const ecs::Entity entity : entities) {
+      world.RemoveComponent<Acceleration>(entity);
+    }
+  }));
+
+  // Recorded while iterating, as a system would, and played back after
+  ecs::CommandBuffer commands{ entity_count * sizeof(Acceleration) };
+  ecs::Query<const Position> query{ world };
+  ReportChange("Record add component", entity_count, MeasureOnce([&] {
+    query.ForEach([&commands](ecs::Entity entity, const Position&) {
+      commands.AddComponent(entity, Acceleration{});
+    });
+  }));
+  ReportChange("Play back add component", entity_count, MeasureOnce([&] {
+    commands.Playback(world);
+  }));
+  ReportChange("Record remove component", entity_count, MeasureOnce([&] {
+    query.ForEach([&commands](ecs::Entity entity, const Position&) {
+      commands.RemoveComponent<Acceleration>(entity);
+    });
+  }));
+  ReportChange("Play back remove component", entity_count, MeasureOnce([&] {
+    commands.Playback(world);
+  }));
+
+  ReportChange("Destroy", entity_count, MeasureOnce([&] {
+    for (const ecs::Entity entity : entities) {
+      world.DestroyEntity(entity);
+    }
+  }));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc > 2) {
+    std::cerr << "Usage: MapleECSBenchmark [entities]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    maple::core::Log::Initialize();
+    maple::core::JobSystem::Initialize();
+    const std::uint32_t entity_count{
+      argc == 2 ? static_cast<std::uint32_t>(std::stoul(argv[1]))
+                : kDefaultEntityCount
+    };
+
+    std::cout << fmt::format("{} entities, {} job thread(s)\n\n",
+                             entity_count,
+                             maple::core::JobSystem::GetThreadCount());
+    BenchmarkIteration(entity_count);
+    BenchmarkStructuralChanges(entity_count);
+
+    maple::core::JobSystem::Shutdown();
+    maple::core::Log::Shutdown();
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    maple::core::JobSystem::Shutdown();
+    maple::core::Log::Shutdown();
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,444 @@
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// fmt
+#include "fmt/format.h"
+
+// Core
+#include "Core/Log.h"
+
+// Platform
+#include "Platform/GraphicsAPI.h"
+#include "Platform/Window.h"
+
+// RHI
+#include "RHI/RHI.h"
+#include "RHI/RHIConfig.h"
+#include "RHI/RHIResources.h"
+#include "RHI/RHIStats.h"
+
+namespace {
+
+namespace rhi = maple::rhi;
+
+/// Bytes per mebibyte
+constexpr std::uint64_t kMiB{ 1024U * 1024U };
+
+/// Device selected unless given on the command line (Mesa's lavapipe)
+constexpr std::string_view kDefaultDeviceName{ "llvmpipe" };
+
+/// Budget of each memory heap, low enough to reach without using most of
+/// the machine's memory
+constexpr std::uint64_t kBudgetLimit{ 256U * kMiB };
+
+/// Frames the CPU may record ahead of the GPU
+constexpr std::uint32_t kFramesInFlight{ 2U };
+
+/// Create or destroy operations of the buddy churn case
+constexpr std::uint32_t kBuddyOperations{ 20'000U };
+
+/// Most buffers alive at once in the buddy churn case
+constexpr std::size_t kBuddyMaxLiveBuffers{ 1'024U };
+
+/// Frames of the linear churn case
+constexpr std::uint32_t kLinearFrames{ 300U };
+
+/// Transient buffers created every frame of the linear churn case
+constexpr std::uint32_t kLinearBuffersPerFrame{ 64U };
+
+/// Larger than half of the largest block, so always dedicated
+constexpr std::uint64_t kDedicatedSize{ 40U * kMiB };
+
+/// Size of the buffers filling blocks in the budget and defragmentation
+/// cases
+constexpr std::uint64_t kFillSize{ 1U * kMiB };
+
+/// Buffers created before fragmenting in the defragmentation case (four
+/// blocks of the largest size)
+constexpr std::uint32_t kDefragmentationBuffers{ 256U };
+
+/// One buffer in this many survives fragmentation
+constexpr std::uint32_t kDefragmentationStride{ 8U };
+
+/**
+ * @brief Throw if a condition of the stress test does not hold.
+ */
+void Check(bool condition, std::string_view what) {
+  if (!condition) {
+    throw std::runtime_error{ fmt::format("Check failed: {}", what) };
+  }
+}
+
+/**
+ * @brief Run empty frames.
+ */
+void RunFrames(rhi::RHI& rhi, maple::platform::Window& window,
+               std::uint32_t count) {
+  for (std::uint32_t i{ 0U }; i < count; ++i) {
+    window.PollEvents();
+    rhi.BeginFrame();
+    rhi.Clear(0.0F, 0.0F, 0.0F, 1.0F);
+    rhi.EndFrame();
+    rhi.Present();
+  }
+}
+
+/**
+ * @brief Run enough frames for destroyed resources to be released.
+ */
+void Flush(rhi::RHI& rhi, maple::platform::Window& window) {
+  RunFrames(rhi, window, kFramesInFlight + 1U);
+}
+
+/**
+ * @brief Print the memory statistics of a case.
+ */
+void Report(std::string_view name, const rhi::RHIMemoryStats& stats) {
+  const double block_bytes{ static_cast<double>(stats.block_bytes) };
+  std::cout << fmt::format(
+    "{:<24} {:>8} {:>7} {:>10.1f} {:>9.1f}% {:>10} {:>8}\n", name,
+    stats.buffer_count, stats.block_count, block_bytes / kMiB,
+    block_bytes > 0.0
+      ? 100.0 * static_cast<double>(stats.used_bytes) / block_bytes
+      : 0.0,
+    stats.dedicated_count, stats.device_allocation_count
+  );
+}
+
+/**
+ * @brief Check that every buffer of a case was released.
+ */
+void CheckReleased(const rhi::RHIMemoryStats& stats,
+                   const rhi::RHIMemoryStats& baseline) {
+  Check(stats.buffer_count == baseline.buffer_count, "buffers destroyed");
+  Check(stats.used_bytes == baseline.used_bytes, "sub-allocations freed");
+  Check(stats.dedicated_count == baseline.dedicated_count,
+        "dedicated allocations freed");
+
+  // Empty blocks are released, except the last one of each pool
+  Check(stats.block_count <= baseline.block_count + 1U,
+        "empty blocks released");
+}
+
+/**
+ * @brief Create and destroy GPU-only buffers of random sizes, which are
+ *        sub-allocated from buddy blocks.
+ */
+void TestBuddyChurn(rhi::RHI& rhi, maple::platform::Window& window) {
+  const rhi::RHIMemoryStats baseline{ rhi.GetMemoryStats() };
+
+  // Sizes are log-uniform from 256 B to 1 MiB, like a mix of small uniform
+  // and large mesh buffers
+  std::mt19937 random{ 42U };
+  std::uniform_real_distribution<double> size_exponent{ 8.0, 20.0 };
+  std::uniform_int_distribution<std::uint32_t> action{ 0U, 2U };
+
+  struct LiveBuffer {
+    rhi::BufferHandle handle{};
+    std::uint64_t size{ 0U };
+  };
+  std::vector<LiveBuffer> live{};
+  std::uint64_t live_bytes{ 0U };
+  rhi::RHIMemoryStats peak{};
+  for (std::uint32_t op{ 0U }; op < kBuddyOperations; ++op) {
+    // Grow two times in three until the live set is full
+    if (live.size() < kBuddyMaxLiveBuffers && (live.empty()
+                                               || action(random) != 0U)) {
+      const auto size{ static_cast<std::uint64_t>(
+        std::exp2(size_exponent(random))
+      ) };
+      live.push_back(LiveBuffer{
+        .handle = rhi.CreateBuffer(rhi::BufferDesc{
+          .size = size,
+          .usage = rhi::BufferUsage::Vertex | rhi::BufferUsage::TransferDst
+        }),
+        .size = size
+      });
+      live_bytes += size;
+    } else {
+      const std::size_t index{ random() % live.size() };
+      rhi.DestroyBuffer(live[index].handle);
+      live_bytes -= live[index].size;
+      live[index] = live.back();
+      live.pop_back();
+    }
+
+    if (op % 256U == 0U) {
+      RunFrames(rhi, window, 1U);
+      const rhi::RHIMemoryStats stats{ rhi.GetMemoryStats() };
+      Check(stats.used_bytes - baseline.used_bytes >= live_bytes,
+            "live buffers are backed by sub-allocations");
+      Check(stats.dedicated_count == baseline.dedicated_count,
+            "small buffers are sub-allocated");
+      if (stats.buffer_count > peak.buffer_count) {
+        peak = stats;
+      }
+    }
+  }
+  Report("Buddy churn (peak)", peak);
+
+  // Sub-allocation keeps device allocations far below the buffer count
+  Check(peak.device_allocation_count - baseline.device_allocation_count
+          < (peak.buffer_count - baseline.buffer_count) / 16U,
+        "buffers share device memory");
+
+  for (const LiveBuffer& buffer : live) {
+    rhi.DestroyBuffer(buffer.handle);
+  }
+  Flush(rhi, window);
+  CheckReleased(rhi.GetMemoryStats(), baseline);
+}
+
+/**
+ * @brief Create staging buffers every frame and destroy them the next,
+ *        which packs them into linear blocks.
+ */
+void TestLinearChurn(rhi::RHI& rhi, maple::platform::Window& window) {
+  const rhi::RHIMemoryStats baseline{ rhi.GetMemoryStats() };
+
+  std::mt19937 random{ 7U };
+  std::uniform_int_distribution<std::uint64_t> size{ 4U * 1024U,
+                                                     256U * 1024U };
+  std::vector<rhi::BufferHandle> previous_frame{};
+  std::vector<rhi::BufferHandle> frame{};
+  std::uint64_t first_half_blocks{ 0U };
+  std::uint64_t second_half_blocks{ 0U };
+  rhi::RHIMemoryStats peak{};
+  for (std::uint32_t f{ 0U }; f < kLinearFrames; ++f) {
+    for (std::uint32_t i{ 0U }; i < kLinearBuffersPerFrame; ++i) {
+      const rhi::BufferHandle buffer{ rhi.CreateBuffer(rhi::BufferDesc{
+        .size = size(random),
+        .usage = rhi::BufferUsage::TransferSrc,
+        .memory_usage = rhi::MemoryUsage::CpuToGpu,
+        .transient = true
+      }) };
+      void* mapped{ rhi.MapBuffer(buffer) };
+      Check(mapped != nullptr, "staging buffers are mapped");
+      std::memset(mapped, static_cast<int>(f), 64U);
+      frame.push_back(buffer);
+    }
+    for (const rhi::BufferHandle buffer : previous_frame) {
+      rhi.DestroyBuffer(buffer);
+    }
+    previous_frame.swap(frame);
+    frame.clear();
+
+    RunFrames(rhi, window, 1U);
+    const rhi::RHIMemoryStats stats{ rhi.GetMemoryStats() };
+    std::uint64_t& blocks{ f < kLinearFrames / 2U ? first_half_blocks
+                                                  : second_half_blocks };
+    blocks = std::max(blocks, stats.block_count);
+    if (stats.block_bytes > peak.block_bytes) {
+      peak = stats;
+    }
+  }
+  Report("Linear churn (peak)", peak);
+
+  // Blocks are recycled once their buffers are released, so a steady
+  // stream of staging buffers stops growing the pool
+  Check(second_half_blocks <= first_half_blocks,
+        "linear blocks are recycled");
+
+  for (const rhi::BufferHandle buffer : previous_frame) {
+    rhi.DestroyBuffer(buffer);
+  }
+  Flush(rhi, window);
+  CheckReleased(rhi.GetMemoryStats(), baseline);
+}
+
+/**
+ * @brief Create buffers larger than half a block, which get their own
+ *        device memory.
+ */
+void TestDedicated(rhi::RHI& rhi, maple::platform::Window& window) {
+  const rhi::RHIMemoryStats baseline{ rhi.GetMemoryStats() };
+
+  const rhi::BufferHandle gpu_buffer{ rhi.CreateBuffer(rhi::BufferDesc{
+    .size = kDedicatedSize,
+    .usage = rhi::BufferUsage::Storage
+  }) };
+  const rhi::BufferHandle cpu_buffer{ rhi.CreateBuffer(rhi::BufferDesc{
+    .size = kDedicatedSize,
+    .usage = rhi::BufferUsage::TransferSrc,
+    .memory_usage = rhi::MemoryUsage::CpuToGpu
+  }) };
+
+  // The whole mapping is writable
+  auto* mapped{ static_cast<std::byte*>(rhi.MapBuffer(cpu_buffer)) };
+  Check(mapped != nullptr, "dedicated host-visible buffers are mapped");
+  mapped[0] = std::byte{ 1U };
+  mapped[kDedicatedSize - 1U] = std::byte{ 2U };
+
+  const rhi::RHIMemoryStats stats{ rhi.GetMemoryStats() };
+  Report("Dedicated", stats);
+  Check(stats.dedicated_count == baseline.dedicated_count + 2U,
+        "large buffers are dedicated");
+  Check(stats.dedicated_bytes >= baseline.dedicated_bytes
+                                   + 2U * kDedicatedSize,
+        "dedicated bytes are counted");
+  Check(stats.device_allocation_count
+          == baseline.device_allocation_count + 2U,
+        "each dedicated buffer owns one device allocation");
+  Check(stats.used_bytes == baseline.used_bytes,
+        "dedicated buffers use no block");
+
+  rhi.DestroyBuffer(gpu_buffer);
+  rhi.DestroyBuffer(cpu_buffer);
+  Flush(rhi, window);
+  CheckReleased(rhi.GetMemoryStats(), baseline);
+}
+
+/**
+ * @brief Allocate past the heap budget (see kBudgetLimit).
+ *
+ * Device memory is taken from another heap once the device-local ones are
+ * over budget; devices with a single heap (e.g., lavapipe) allocate over
+ * budget instead. Either way, allocation keeps succeeding.
+ */
+void TestBudget(rhi::RHI& rhi, maple::platform::Window& window) {
+  const rhi::RHIMemoryStats baseline{ rhi.GetMemoryStats() };
+  Check(baseline.budget_bytes > 0U, "device-local budget is known");
+
+  std::vector<rhi::BufferHandle> buffers{};
+  std::uint64_t allocated_bytes{ 0U };
+  while (allocated_bytes < baseline.budget_bytes + kBudgetLimit / 2U) {
+    buffers.push_back(rhi.CreateBuffer(rhi::BufferDesc{
+      .size = kFillSize,
+      .usage = rhi::BufferUsage::Vertex
+    }));
+    allocated_bytes += kFillSize;
+  }
+
+  const rhi::RHIMemoryStats stats{ rhi.GetMemoryStats() };
+  Report("Over budget", stats);
+  const std::uint64_t fallbacks{ stats.budget_fallback_allocations
+                                 - baseline.budget_fallback_allocations };
+  const std::uint64_t over_budget{ stats.over_budget_allocations
+                                   - baseline.over_budget_allocations };
+  std::cout << fmt::format("  Budget {:.1f} MiB, usage {:.1f} MiB, {} "
+                           "fallback and {} over-budget allocation(s)\n",
+                           static_cast<double>(stats.budget_bytes) / kMiB,
+                           static_cast<double>(stats.usage_bytes) / kMiB,
+                           fallbacks, over_budget);
+  Check(fallbacks + over_budget > 0U, "budget pressure is detected");
+
+  // Memory in other heaps does not count against the device-local budget
+  if (over_budget == 0U) {
+    Check(stats.usage_bytes <= stats.budget_bytes,
+          "fallback keeps device-local heaps within budget");
+  }
+
+  for (const rhi::BufferHandle buffer : buffers) {
+    rhi.DestroyBuffer(buffer);
+  }
+  Flush(rhi, window);
+  CheckReleased(rhi.GetMemoryStats(), baseline);
+}
+
+/**
+ * @brief Thin out full blocks and compact them.
+ */
+void TestDefragmentation(rhi::RHI& rhi, maple::platform::Window& window) {
+  const rhi::RHIMemoryStats baseline{ rhi.GetMemoryStats() };
+
+  // Fill several blocks, then leave each one sparsely used
+  std::vector<rhi::BufferHandle> buffers{};
+  for (std::uint32_t i{ 0U }; i < kDefragmentationBuffers; ++i) {
+    buffers.push_back(rhi.CreateBuffer(rhi::BufferDesc{
+      .size = kFillSize,
+      .usage = rhi::BufferUsage::Vertex | rhi::BufferUsage::TransferDst
+    }));
+  }
+  std::vector<rhi::BufferHandle> survivors{};
+  for (std::uint32_t i{ 0U }; i < kDefragmentationBuffers; ++i) {
+    if (i % kDefragmentationStride == 0U) {
+      survivors.push_back(buffers[i]);
+    } else {
+      rhi.DestroyBuffer(buffers[i]);
+    }
+  }
+  Flush(rhi, window);
+
+  const rhi::RHIMemoryStats before{ rhi.GetMemoryStats() };
+  Report("Fragmented", before);
+  Check(before.block_count > baseline.block_count + 1U,
+        "buffers span several blocks");
+
+  // The pass runs at the next frame; the relocated buffers are released
+  // once the GPU has finished the frames that may read them
+  rhi.DefragmentMemory();
+  Flush(rhi, window);
+
+  const rhi::RHIMemoryStats after{ rhi.GetMemoryStats() };
+  Report("Defragmented", after);
+  Check(after.defragmented_bytes > before.defragmented_bytes,
+        "buffers are relocated");
+  Check(after.block_count < before.block_count, "source blocks are released");
+  Check(after.buffer_count == before.buffer_count, "handles stay valid");
+  Check(after.used_bytes == before.used_bytes,
+        "relocated buffers keep their size");
+
+  for (const rhi::BufferHandle buffer : survivors) {
+    rhi.DestroyBuffer(buffer);
+  }
+  Flush(rhi, window);
+  CheckReleased(rhi.GetMemoryStats(), baseline);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc > 2) {
+    std::cerr << "Usage: MapleGpuMemoryStressTest [device name]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    maple::core::Log::Initialize();
+
+    maple::platform::Window window{ "Maple GPU Memory Stress Test",
+                                    maple::platform::GraphicsAPI::Vulkan };
+    if (window.GetGraphicsAPI() != maple::platform::GraphicsAPI::Vulkan) {
+      throw std::runtime_error{ "Vulkan is not available" };
+    }
+    const std::unique_ptr<rhi::RHI> rhi{ rhi::RHI::Create(
+      &window, rhi::RHIConfig{
+        .device_name = std::string{ argc == 2 ? argv[1]
+                                              : kDefaultDeviceName },
+        .frames_in_flight = kFramesInFlight,
+        .memory_budget_limit = kBudgetLimit,
+        .pipeline_cache_path = {}
+      }
+    ) };
+
+    std::cout << fmt::format("{:<24} {:>8} {:>7} {:>10} {:>10} {:>10} "
+                             "{:>8}\n", "Case", "Buffers", "Blocks",
+                             "Block MiB", "Used", "Dedicated", "Allocs");
+    TestBuddyChurn(*rhi, window);
+    TestLinearChurn(*rhi, window);
+    TestDedicated(*rhi, window);
+    TestBudget(*rhi, window);
+    TestDefragmentation(*rhi, window);
+    std::cout << "All checks passed" << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    maple::core::Log::Shutdown();
+    return EXIT_FAILURE;
+  }
+
+  maple::core::Log::Shutdown();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,212 @@
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <ratio>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// fmt
+#include "fmt/format.h"
+
+// Core
+#include "Core/JobSystem.h"
+#include "Core/Log.h"
+#include "Core/Task.h"
+
+// Programs
+#include "BenchmarkTiming.h"
+
+namespace {
+
+namespace core = maple::core;
+
+using maple::benchmark::Measure;
+using maple::benchmark::Times;
+
+/// Empty jobs scheduled per batch before waiting
+constexpr std::uint32_t kBatchSize{ 1024U };
+
+/// Batches measured per worker count
+constexpr std::size_t kBatchCount{ 200U };
+
+/// Depth of the deep fork/join tree, which forks 2^depth - 1 tasks
+constexpr std::uint32_t kForkDepth{ 12U };
+
+/// Trees measured per worker count, for the single and deep fork cases
+constexpr std::size_t kShallowForkCount{ 10'000U };
+constexpr std::size_t kDeepForkCount{ 50U };
+
+/// Elements transformed per ParallelFor unless given on the command line
+constexpr std::size_t kDefaultElementCount{ 16'000'000U };
+
+/// Elements per ParallelFor chunk
+constexpr std::size_t kGrainSize{ 16'384U };
+
+/// ParallelFor runs measured per worker count
+constexpr std::size_t kParallelForCount{ 20U };
+
+/**
+ * @brief Count the nodes of a binary tree, forking one subtree to another
+ *        thread at every level and walking the other on this one.
+ */
+core::Task<std::uint64_t> CountNodes(std::uint32_t depth);
+
+/**
+ * @brief Count the nodes of a subtree into a result owned by the parent.
+ */
+core::Task<> CountNodesInto(std::uint32_t depth, std::uint64_t& result) {
+  result = co_await CountNodes(depth);
+}
+
+core::Task<std::uint64_t> CountNodes(std::uint32_t depth) {
+  if (depth == 0U) {
+    co_return 1U;
+  }
+
+  std::uint64_t left{ 0U };
+  core::JobCounter counter{};
+  core::Spawn(CountNodesInto(depth - 1U, left), counter);
+  const std::uint64_t right{ co_await CountNodes(depth - 1U) };
+  co_await counter;
+  co_return left + right + 1U;
+}
+
+/**
+ * @brief Get the worker counts to compare: powers of two, then one worker
+ *        per hardware thread besides the main thread, which runs jobs too
+ *        while it waits.
+ */
+std::vector<std::uint32_t> GetWorkerCounts() {
+  const std::uint32_t max_workers{
+    std::max(std::thread::hardware_concurrency(), 2U) - 1U
+  };
+  std::vector<std::uint32_t> worker_counts{};
+  for (std::uint32_t count{ 1U }; count < max_workers; count *= 2U) {
+    worker_counts.emplace_back(count);
+  }
+  worker_counts.emplace_back(max_workers);
+  return worker_counts;
+}
+
+/**
+ * @brief Print a case.
+ *
+ * @param item_count Jobs, tasks or elements handled per run
+ * @param speedup Throughput over the serial loop, for ParallelFor cases
+ */
+void Report(std::uint32_t worker_count, std::string_view name,
+            const Times& times, std::size_t item_count,
+            std::optional<double> speedup = std::nullopt) {
+  std::cout << fmt::format(
+    "{:>7} {:<26} {:>10.2f} {:>10.2f} {:>10.2f} {:>9}\n", worker_count, name,
+    times.mean, times.p99, times.mean * 1.0e3 / static_cast<double>(item_count),
+    speedup ? fmt::format("{:.2f}x", *speedup) : std::string{ "-" }
+  );
+}
+
+/**
+ * @brief Transform a range of values with a little arithmetic per element.
+ */
+void Transform(std::vector<float>& values, std::size_t begin,
+               std::size_t end) {
+  for (std::size_t i{ begin }; i < end; ++i) {
+    values[i] = std::sqrt(values[i] * 1.0001F + 1.0F);
+  }
+}
+
+/**
+ * @brief Measure scheduling overhead, fork/join latency and ParallelFor
+ *        throughput with the job system started with a given worker count.
+ *
+ * @param serial Times of the same transform as a plain loop
+ */
+void Benchmark(std::uint32_t worker_count, std::vector<float>& values,
+               const Times& serial) {
+  core::JobSystem::Initialize(worker_count);
+
+  Report(worker_count, "Schedule+Wait, empty", Measure<std::micro>(
+    kBatchCount, [] {
+      core::JobCounter counter{};
+      for (std::uint32_t i{ 0U }; i < kBatchSize; ++i) {
+        core::JobSystem::Schedule([] {}, &counter);
+      }
+      core::JobSystem::Wait(counter);
+    }
+  ), kBatchSize);
+
+  Report(worker_count, "Task fork/join, 1 fork", Measure<std::micro>(
+    kShallowForkCount, [] {
+      static_cast<void>(core::SyncWait(CountNodes(1U)));
+    }
+  ), 1U);
+  Report(worker_count, "Task fork/join, deep tree", Measure<std::micro>(
+    kDeepForkCount, [] {
+      static_cast<void>(core::SyncWait(CountNodes(kForkDepth)));
+    }
+  ), (std::size_t{ 1U } << kForkDepth) - 1U);
+
+  const Times parallel_for{ Measure<std::micro>(kParallelForCount, [&values] {
+    core::JobSystem::ParallelFor(
+      values.size(), kGrainSize,
+      [&values](std::size_t begin, std::size_t end) {
+        Transform(values, begin, end);
+      }
+    );
+  }) };
+  Report(worker_count, "ParallelFor", parallel_for, values.size(),
+         serial.mean / parallel_for.mean);
+
+  core::JobSystem::Shutdown();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc > 2) {
+    std::cerr << "Usage: MapleJobSystemBenchmark [elements]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    core::Log::Initialize();
+    const std::size_t element_count{
+      argc == 2 ? static_cast<std::size_t>(std::stoull(argv[1]))
+                : kDefaultElementCount
+    };
+
+    std::vector<float> values(element_count, 1.0F);
+    const Times serial{ Measure<std::micro>(kParallelForCount, [&values] {
+      Transform(values, 0U, values.size());
+    }) };
+
+    std::cout << fmt::format("{} hardware thread(s); the main thread runs "
+                             "jobs besides the workers; {} jobs per batch, "
+                             "{} elements per ParallelFor\n\n",
+                             std::thread::hardware_concurrency(), kBatchSize,
+                             element_count);
+    std::cout << fmt::format("{:>7} {:<26} {:>10} {:>10} {:>10} {:>9}\n",
+                             "Workers", "Case", "Mean us", "p99 us",
+                             "ns/item", "Speedup");
+    Report(0U, "Serial loop", serial, element_count, 1.0);
+    for (const std::uint32_t worker_count : GetWorkerCounts()) {
+      Benchmark(worker_count, values, serial);
+    }
+
+    core::Log::Shutdown();
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    core::JobSystem::Shutdown();
+    core::Log::Shutdown();
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
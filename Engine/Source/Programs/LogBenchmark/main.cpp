@@ -0,0 +1,178 @@
+// STL
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <ratio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// fmt
+#include "fmt/format.h"
+
+// Core
+#include "Core/Log.h"
+
+// Programs
+#include "BenchmarkTiming.h"
+
+namespace {
+
+MAPLE_DEFINE_LOG_CATEGORY(LogBenchmark);
+
+using maple::benchmark::Summarize;
+using maple::benchmark::Times;
+
+/// Producer thread counts measured in every run
+constexpr std::uint32_t kThreadCounts[]{ 1U, 4U, 16U };
+
+/// Messages logged per producer thread unless given on the command line
+constexpr std::uint32_t kDefaultMessageCount{ 20'000U };
+
+/**
+ * @brief Call-site latency distribution of one thread count.
+ */
+struct LatencySummary {
+  /// Times of a call, in nanoseconds
+  Times times{};
+
+  /// Messages logged per second by all producers together
+  double messages_per_second{ 0.0 };
+};
+
+/**
+ * @brief Parse the logging mode named on the command line.
+ */
+maple::core::LogConfig ParseMode(std::string_view mode) {
+  using maple::core::LogMode;
+  using maple::core::LogOverflowPolicy;
+  if (mode == "sync") {
+    return { .mode = LogMode::Synchronous };
+  }
+  if (mode == "block") {
+    return { .mode = LogMode::Asynchronous,
+             .overflow_policy = LogOverflowPolicy::Block };
+  }
+  if (mode == "drop") {
+    return { .mode = LogMode::Asynchronous,
+             .overflow_policy = LogOverflowPolicy::DropNewest };
+  }
+  if (mode == "overwrite") {
+    return { .mode = LogMode::Asynchronous,
+             .overflow_policy = LogOverflowPolicy::OverwriteOldest };
+  }
+  throw std::invalid_argument{ fmt::format("Unknown mode '{}'", mode) };
+}
+
+/**
+ * @brief Log from several threads at once, timing every call.
+ */
+LatencySummary Measure(std::uint32_t thread_count,
+                       std::uint32_t message_count) {
+  using Clock = std::chrono::steady_clock;
+
+  // Every producer waits for the others to start, so that they contend
+  std::vector<std::vector<double>> latencies(thread_count);
+  std::atomic<std::uint32_t> ready{ 0U };
+  const Clock::time_point begin{ Clock::now() };
+  std::vector<std::thread> producers{};
+  for (std::uint32_t t{ 0U }; t < thread_count; ++t) {
+    producers.emplace_back([t, thread_count, message_count, &ready,
+                            &samples = latencies[t]] {
+      samples.reserve(message_count);
+      ready.fetch_add(1U);
+      while (ready.load() < thread_count) {
+        std::this_thread::yield();
+      }
+
+      for (std::uint32_t i{ 0U }; i < message_count; ++i) {
+        const Clock::time_point start{ Clock::now() };
+        MAPLE_LOG_INFO(LogBenchmark, "Producer {} message {} value {:.3f}",
+                       t, i, static_cast<double>(i) * 0.5);
+        const Clock::time_point end{ Clock::now() };
+        samples.emplace_back(
+          std::chrono::duration<double, std::nano>(end - start).count()
+        );
+      }
+    });
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+  const double seconds{
+    std::chrono::duration<double>(Clock::now() - begin).count()
+  };
+
+  // Pool the samples of every producer
+  std::vector<double> samples{};
+  for (const std::vector<double>& thread_samples : latencies) {
+    samples.insert(samples.end(), thread_samples.begin(),
+                   thread_samples.end());
+  }
+  const double message_total{ static_cast<double>(samples.size()) };
+  return LatencySummary{
+    .times = Summarize(std::move(samples)),
+    .messages_per_second = message_total / seconds
+  };
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: MapleLogBenchmark <sync|block|drop|overwrite> "
+                 "[messages per thread]\n"
+                 "Results are written to stderr; redirect stdout to "
+                 "discard the logged messages." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    // Logging cannot be initialized again after Shutdown(), so each run
+    // measures one mode
+    const maple::core::LogConfig config{ ParseMode(argv[1]) };
+    const std::uint32_t message_count{
+      argc == 3 ? static_cast<std::uint32_t>(std::stoul(argv[2]))
+                : kDefaultMessageCount
+    };
+    if (message_count == 0U) {
+      throw std::invalid_argument{ "Message count must be at least 1" };
+    }
+    maple::core::Log::Initialize(config);
+
+    std::vector<LatencySummary> summaries{};
+    for (const std::uint32_t thread_count : kThreadCounts) {
+      summaries.push_back(Measure(thread_count, message_count));
+    }
+
+    // Report once everything was written, so the table is not interleaved
+    // with the queued messages
+    maple::core::Log::Shutdown();
+    std::cerr << fmt::format("Mode: {}, {} message(s) per thread\n",
+                             argv[1], message_count);
+    std::cerr << fmt::format("{:>8} {:>10} {:>10} {:>10} {:>10} {:>12} "
+                             "{:>14}\n", "Threads", "Mean ns", "p50 ns",
+                             "p99 ns", "p99.9 ns", "Max ns", "Messages/s");
+    for (std::size_t i{ 0U }; i < summaries.size(); ++i) {
+      const LatencySummary& summary{ summaries[i] };
+      std::cerr << fmt::format("{:>8} {:>10.0f} {:>10.0f} {:>10.0f} "
+                               "{:>10.0f} {:>12.0f} {:>14.0f}\n",
+                               kThreadCounts[i], summary.times.mean,
+                               summary.times.p50, summary.times.p99,
+                               summary.times.p999, summary.times.max,
+                               summary.messages_per_second);
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,306 @@
+// STL
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// fmt
+#include "fmt/args.h"
+#include "fmt/chrono.h"
+#include "fmt/format.h"
+
+// Core
+#include "Core/BinaryLogFormat.h"
+
+namespace {
+
+namespace binary_log = maple::core::binary_log;
+
+/// Level names matching spdlog's default output
+constexpr std::string_view kLevelNames[]{
+  "trace", "debug", "info", "warning", "error", "critical", "off"
+};
+
+/**
+ * @brief Decoded format definition record.
+ */
+struct FormatDefinition {
+  std::uint8_t level{ 0U };
+  std::uint32_t line{ 0U };
+  std::vector<binary_log::ArgType> arg_types{};
+  std::string category{};
+  std::string file{};
+  std::string format{};
+};
+
+/**
+ * @brief Bounds-checked sequential reader over a byte buffer.
+ */
+class Reader {
+public:
+  Reader(const std::byte* data, std::size_t size)
+    : data_{ data }
+    , size_{ size } {}
+
+  [[nodiscard]] bool AtEnd() const noexcept {
+    return offset_ == size_;
+  }
+
+  template <typename T>
+  T Read() {
+    T value{};
+    std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  std::string ReadString(std::size_t length) {
+    const auto* chars{ reinterpret_cast<const char*>(Take(length)) };
+    return std::string{ chars, length };
+  }
+
+private:
+  const std::byte* Take(std::size_t count) {
+    if (size_ - offset_ < count) {
+      throw std::out_of_range{ "Unexpected end of binary log" };
+    }
+    const std::byte* bytes{ data_ + offset_ };
+    offset_ += count;
+    return bytes;
+  }
+
+  const std::byte* data_;
+  std::size_t size_;
+  std::size_t offset_{ 0U };
+};
+
+/**
+ * @brief Parse a format definition record (after its kind byte).
+ */
+std::pair<std::uint32_t, FormatDefinition> ReadFormat(Reader& reader) {
+  FormatDefinition definition{};
+  const auto format_id{ reader.Read<std::uint32_t>() };
+  definition.level = reader.Read<std::uint8_t>();
+  definition.line = reader.Read<std::uint32_t>();
+
+  const auto arg_count{ reader.Read<std::uint8_t>() };
+  for (std::uint8_t i{ 0U }; i < arg_count; ++i) {
+    definition.arg_types.emplace_back(reader.Read<binary_log::ArgType>());
+  }
+
+  definition.category = reader.ReadString(reader.Read<std::uint16_t>());
+  definition.file = reader.ReadString(reader.Read<std::uint16_t>());
+  definition.format = reader.ReadString(reader.Read<std::uint32_t>());
+  return { format_id, std::move(definition) };
+}
+
+/**
+ * @brief Rebuild the message text of an event from its encoded arguments.
+ */
+std::string FormatMessage(const FormatDefinition& definition, Reader& args) {
+  fmt::dynamic_format_arg_store<fmt::format_context> store{};
+  for (const binary_log::ArgType type : definition.arg_types) {
+    switch (type) {
+      case binary_log::ArgType::Bool: {
+        store.push_back(args.Read<std::uint8_t>() != 0U);
+        break;
+      }
+
+      case binary_log::ArgType::Char: {
+        store.push_back(static_cast<char>(args.Read<std::uint8_t>()));
+        break;
+      }
+
+      case binary_log::ArgType::Int64: {
+        store.push_back(args.Read<std::int64_t>());
+        break;
+      }
+
+      case binary_log::ArgType::UInt64: {
+        store.push_back(args.Read<std::uint64_t>());
+        break;
+      }
+
+      case binary_log::ArgType::Double: {
+        store.push_back(args.Read<double>());
+        break;
+      }
+
+      case binary_log::ArgType::String: {
+        store.push_back(args.ReadString(args.Read<std::uint16_t>()));
+        break;
+      }
+
+      case binary_log::ArgType::Pointer: {
+        const auto address{ static_cast<std::uintptr_t>(
+          args.Read<std::uint64_t>()
+        ) };
+        store.push_back(reinterpret_cast<const void*>(address));
+        break;
+      }
+
+      default: {
+        throw std::runtime_error{ "Unknown argument type in binary log" };
+      }
+    }
+  }
+
+  // Keep the raw format string if the arguments do not match it
+  try {
+    return fmt::vformat(definition.format, store);
+  } catch (const fmt::format_error& e) {
+    return fmt::format("{} <format error: {}>", definition.format, e.what());
+  }
+}
+
+/**
+ * @brief Format an event timestamp as local wall-clock time.
+ *
+ * Falls back to the raw system time in nanoseconds if it cannot be
+ * converted.
+ */
+std::string FormatTime(const binary_log::FileHeader& header,
+                       std::int64_t timestamp_ns) {
+  const std::int64_t system_ns{
+    header.system_origin_ns + (timestamp_ns - header.steady_origin_ns)
+  };
+  const std::time_t seconds{
+    static_cast<std::time_t>(system_ns / 1'000'000'000)
+  };
+  const std::int64_t microseconds{ (system_ns % 1'000'000'000) / 1'000 };
+
+  // A corrupt header can put the time outside the calendar's range
+  std::tm local_time{};
+#if defined(_WIN32) || defined(_WIN64)
+  const bool converted{ localtime_s(&local_time, &seconds) == 0 };
+#else
+  const bool converted{ localtime_r(&seconds, &local_time) != nullptr };
+#endif
+  if (!converted) {
+    return fmt::format("{} ns", system_ns);
+  }
+  return fmt::format("{:%Y-%m-%d %H:%M:%S}.{:06}", local_time, microseconds);
+}
+
+/**
+ * @brief Decode a binary log file and write its text to the output stream.
+ */
+void Decode(const std::vector<std::byte>& data, std::ostream& out) {
+  Reader reader{ data.data(), data.size() };
+
+  // Validate the file header
+  const auto header{ reader.Read<binary_log::FileHeader>() };
+  if (header.magic != binary_log::kFileMagic) {
+    throw std::runtime_error{ "Not a Maple binary log file" };
+  }
+  if (header.version != binary_log::kFileVersion) {
+    throw std::runtime_error{
+      fmt::format("Unsupported binary log version {} (expected {})",
+                  header.version, binary_log::kFileVersion)
+    };
+  }
+
+  std::unordered_map<std::uint32_t, FormatDefinition> definitions{};
+  std::vector<std::pair<std::int64_t, std::string>> lines{};
+  while (!reader.AtEnd()) {
+    const auto kind{ reader.Read<binary_log::RecordKind>() };
+    switch (kind) {
+      case binary_log::RecordKind::Format: {
+        definitions.insert(ReadFormat(reader));
+        break;
+      }
+
+      case binary_log::RecordKind::Event: {
+        const auto format_id{ reader.Read<std::uint32_t>() };
+        const auto thread_index{ reader.Read<std::uint32_t>() };
+        const auto timestamp_ns{ reader.Read<std::int64_t>() };
+        const auto args_size{ reader.Read<std::uint16_t>() };
+        const std::string args_bytes{ reader.ReadString(args_size) };
+
+        const auto definition{ definitions.find(format_id) };
+        if (definition == definitions.end()) {
+          throw std::runtime_error{
+            fmt::format("Event references unknown format ID {}", format_id)
+          };
+        }
+
+        // Mirror spdlog's default pattern, with the thread index appended
+        Reader args{ reinterpret_cast<const std::byte*>(args_bytes.data()),
+                     args_bytes.size() };
+        const FormatDefinition& def{ definition->second };
+        const std::string_view level_name{
+          def.level < std::size(kLevelNames) ? kLevelNames[def.level] : "?"
+        };
+        lines.emplace_back(
+          timestamp_ns,
+          fmt::format("[{}] [{}] [{}] [{}:{}] [thread {}] {}",
+                      FormatTime(header, timestamp_ns), def.category,
+                      level_name, def.file, def.line, thread_index,
+                      FormatMessage(def, args))
+        );
+        break;
+      }
+
+      default: {
+        throw std::runtime_error{ "Unknown record kind in binary log" };
+      }
+    }
+  }
+
+  // Threads are written buffer by buffer; interleave them chronologically
+  std::ranges::stable_sort(lines, {}, [](const auto& line) {
+    return line.first;
+  });
+  for (const auto& [timestamp_ns, text] : lines) {
+    out << text << '\n';
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: MapleLogDecoder <input.mlog> [output.txt]"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    // Read the whole binary log into memory
+    std::ifstream input{ argv[1], std::ios::binary };
+    if (!input) {
+      throw std::runtime_error{ fmt::format("Failed to open {}", argv[1]) };
+    }
+    const std::vector<char> chars{ std::istreambuf_iterator<char>{ input },
+                                   std::istreambuf_iterator<char>{} };
+    std::vector<std::byte> data(chars.size());
+    std::memcpy(data.data(), chars.data(), chars.size());
+
+    // Decode to the output file, or to stdout if none is given
+    if (argc == 3) {
+      std::ofstream output{ argv[2] };
+      if (!output) {
+        throw std::runtime_error{ fmt::format("Failed to open {}", argv[2]) };
+      }
+      Decode(data, output);
+    } else {
+      Decode(data, std::cout);
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,362 @@
+// STL
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// fmt
+#include "fmt/format.h"
+
+// Core
+#include "Core/JobSystem.h"
+#include "Core/Log.h"
+
+// Platform
+#include "Platform/GraphicsAPI.h"
+#include "Platform/Window.h"
+
+// RHI
+#include "RHI/RHI.h"
+#include "RHI/RHIConfig.h"
+#include "RHI/RHIPipeline.h"
+#include "RHI/RHIStats.h"
+
+namespace {
+
+namespace rhi = maple::rhi;
+
+using Clock = std::chrono::steady_clock;
+
+/// Cache file written by the benchmark (deleted before and after)
+constexpr std::string_view kCachePath{ "PipelineCacheBenchmark.bin" };
+
+/// Fragment shader variants; each differs only in its output color, so
+/// every pipeline compiles its own code
+constexpr std::uint32_t kFragmentVariants{ 4U };
+
+/// Topologies of the manifest (points would need a point size)
+constexpr std::array kTopologies{
+  rhi::PrimitiveTopology::TriangleList,
+  rhi::PrimitiveTopology::TriangleStrip,
+  rhi::PrimitiveTopology::LineList
+};
+
+/// Cull modes of the manifest
+constexpr std::array kCullModes{ rhi::CullMode::None, rhi::CullMode::Back };
+
+/// Blend modes of the manifest
+constexpr std::array kBlendModes{
+  rhi::BlendMode::Opaque,
+  rhi::BlendMode::AlphaBlend,
+  rhi::BlendMode::Additive
+};
+
+/// Vertex shader writing a constant position:
+///   void main() { gl_Position = vec4(0.0, 0.0, 0.0, 1.0); }
+constexpr std::array<std::uint32_t, 67> kVertexShader{
+  0x07230203U, 0x00010000U, 0x00000000U, 0x0000000CU, 0x00000000U,
+  0x00020011U, 0x00000001U,                           // Capability Shader
+  0x0003000EU, 0x00000000U, 0x00000001U,              // MemoryModel GLSL450
+  0x0006000FU, 0x00000000U, 0x00000001U, 0x6E69616DU, // EntryPoint Vertex
+  0x00000000U, 0x00000002U,                           //   %1 "main" %2
+  0x00040047U, 0x00000002U, 0x0000000BU, 0x00000000U, // %2 BuiltIn Position
+  0x00020013U, 0x00000003U,                           // %3 = void
+  0x00030021U, 0x00000004U, 0x00000003U,              // %4 = void()
+  0x00030016U, 0x00000005U, 0x00000020U,              // %5 = float
+  0x00040017U, 0x00000006U, 0x00000005U, 0x00000004U, // %6 = vec4
+  0x00040020U, 0x00000007U, 0x00000003U, 0x00000006U, // %7 = out vec4*
+  0x0004003BU, 0x00000007U, 0x00000002U, 0x00000003U, // %2 = out var
+  0x0004002BU, 0x00000005U, 0x00000008U, 0x00000000U, // %8 = 0.0
+  0x0004002BU, 0x00000005U, 0x00000009U, 0x3F800000U, // %9 = 1.0
+  0x0007002CU, 0x00000006U, 0x0000000AU, 0x00000008U, // %10 = vec4(%8,
+  0x00000008U, 0x00000008U, 0x00000009U,              //   %8, %8, %9)
+  0x00050036U, 0x00000003U, 0x00000001U, 0x00000000U, // %1 = function
+  0x00000004U,
+  0x000200F8U, 0x0000000BU,                           // %11 = label
+  0x0003003EU, 0x00000002U, 0x0000000AU,              // store %2 %10
+  0x000100FDU,                                        // return
+  0x00010038U                                         // function end
+};
+
+/// Fragment shader writing a constant color:
+///   layout(location = 0) out vec4 color;
+///   void main() { color = vec4(c, c, c, 1.0); }
+constexpr std::array<std::uint32_t, 70> kFragmentShader{
+  0x07230203U, 0x00010000U, 0x00000000U, 0x0000000CU, 0x00000000U,
+  0x00020011U, 0x00000001U,                           // Capability Shader
+  0x0003000EU, 0x00000000U, 0x00000001U,              // MemoryModel GLSL450
+  0x0006000FU, 0x00000004U, 0x00000001U, 0x6E69616DU, // EntryPoint Fragment
+  0x00000000U, 0x00000002U,                           //   %1 "main" %2
+  0x00030010U, 0x00000001U, 0x00000007U,              // OriginUpperLeft
+  0x00040047U, 0x00000002U, 0x0000001EU, 0x00000000U, // %2 Location 0
+  0x00020013U, 0x00000003U,                           // %3 = void
+  0x00030021U, 0x00000004U, 0x00000003U,              // %4 = void()
+  0x00030016U, 0x00000005U, 0x00000020U,              // %5 = float
+  0x00040017U, 0x00000006U, 0x00000005U, 0x00000004U, // %6 = vec4
+  0x00040020U, 0x00000007U, 0x00000003U, 0x00000006U, // %7 = out vec4*
+  0x0004003BU, 0x00000007U, 0x00000002U, 0x00000003U, // %2 = out var
+  0x0004002BU, 0x00000005U, 0x00000008U, 0x00000000U, // %8 = c
+  0x0004002BU, 0x00000005U, 0x00000009U, 0x3F800000U, // %9 = 1.0
+  0x0007002CU, 0x00000006U, 0x0000000AU, 0x00000008U, // %10 = vec4(%8,
+  0x00000008U, 0x00000008U, 0x00000009U,              //   %8, %8, %9)
+  0x00050036U, 0x00000003U, 0x00000001U, 0x00000000U, // %1 = function
+  0x00000004U,
+  0x000200F8U, 0x0000000BU,                           // %11 = label
+  0x0003003EU, 0x00000002U, 0x0000000AU,              // store %2 %10
+  0x000100FDU,                                        // return
+  0x00010038U                                         // function end
+};
+
+/// Index of the color constant's value in kFragmentShader
+constexpr std::size_t kFragmentColorWord{ 46U };
+
+/**
+ * @brief Shaders of the manifest, created on one RHI.
+ */
+struct Shaders {
+  rhi::ShaderHandle vertex{};
+  std::vector<rhi::ShaderHandle> fragments{};
+};
+
+/**
+ * @brief Times of one case, in milliseconds.
+ */
+struct CaseTimes {
+  /// RHI creation, including loading the cache file
+  double create_ms{ 0.0 };
+
+  /// Pipeline creation until every pipeline of the manifest is usable
+  double compile_ms{ 0.0 };
+
+  /// Longest single pipeline creation (the worst first-use stutter)
+  double max_pipeline_ms{ 0.0 };
+
+  /// RHI creation until the first frame was presented
+  double first_frame_ms{ 0.0 };
+};
+
+/**
+ * @brief Milliseconds since a time point.
+ */
+double MillisecondsSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+    .count();
+}
+
+/**
+ * @brief Create the vertex shader and the fragment shader variants.
+ */
+Shaders CreateShaders(rhi::RHI& rhi) {
+  Shaders shaders{
+    .vertex = rhi.CreateShader(rhi::ShaderDesc{
+      .stage = rhi::ShaderStage::Vertex,
+      .code = kVertexShader
+    })
+  };
+  for (std::uint32_t v{ 0U }; v < kFragmentVariants; ++v) {
+    auto code{ kFragmentShader };
+    code[kFragmentColorWord] = std::bit_cast<std::uint32_t>(
+      static_cast<float>(v + 1U) / static_cast<float>(kFragmentVariants)
+    );
+    shaders.fragments.push_back(rhi.CreateShader(rhi::ShaderDesc{
+      .stage = rhi::ShaderStage::Fragment,
+      .code = code
+    }));
+  }
+  return shaders;
+}
+
+/**
+ * @brief Build a manifest of every combination of shader and state.
+ */
+std::vector<rhi::GraphicsPipelineDesc> BuildManifest(const Shaders& shaders) {
+  std::vector<rhi::GraphicsPipelineDesc> manifest{};
+  for (const rhi::ShaderHandle fragment : shaders.fragments) {
+    for (const rhi::PrimitiveTopology topology : kTopologies) {
+      for (const rhi::CullMode cull_mode : kCullModes) {
+        for (const rhi::BlendMode blend_mode : kBlendModes) {
+          for (const bool depth : { false, true }) {
+            rhi::GraphicsPipelineDesc desc{
+              .vertex_shader = shaders.vertex,
+              .fragment_shader = fragment,
+              .topology = topology,
+              .cull_mode = cull_mode,
+              .blend_mode = blend_mode,
+              .depth_test = depth,
+              .depth_write = depth
+            };
+            if (depth) {
+              desc.depth_format = rhi::TextureFormat::D32Float;
+            }
+            manifest.push_back(desc);
+          }
+        }
+      }
+    }
+  }
+  return manifest;
+}
+
+/**
+ * @brief Create an RHI that loads and saves the benchmark's cache file.
+ */
+std::unique_ptr<rhi::RHI> CreateRHI(maple::platform::Window& window,
+                                    const std::string& device_name) {
+  return rhi::RHI::Create(&window, rhi::RHIConfig{
+    .device_name = device_name,
+    .pipeline_cache_path = std::string{ kCachePath }
+  });
+}
+
+/**
+ * @brief Start an RHI, make every pipeline of the manifest usable, and
+ *        present a frame, as a game's loading screen would.
+ *
+ * @param prepare Makes the manifest usable; returns the longest time a
+ *                single pipeline took, in milliseconds
+ */
+CaseTimes RunCase(
+  maple::platform::Window& window,
+  const std::string& device_name,
+  const std::function<double(rhi::RHI&,
+                             const std::vector<rhi::GraphicsPipelineDesc>&)>&
+    prepare
+) {
+  CaseTimes times{};
+  const Clock::time_point start{ Clock::now() };
+  std::unique_ptr<rhi::RHI> rhi{ CreateRHI(window, device_name) };
+  times.create_ms = MillisecondsSince(start);
+
+  const Shaders shaders{ CreateShaders(*rhi) };
+  const std::vector<rhi::GraphicsPipelineDesc> manifest{
+    BuildManifest(shaders)
+  };
+  const Clock::time_point compile_start{ Clock::now() };
+  times.max_pipeline_ms = prepare(*rhi, manifest);
+  times.compile_ms = MillisecondsSince(compile_start);
+
+  window.PollEvents();
+  rhi->BeginFrame();
+  rhi->Clear(0.0F, 0.0F, 0.0F, 1.0F);
+  rhi->EndFrame();
+  rhi->Present();
+  times.first_frame_ms = MillisecondsSince(start);
+
+  rhi->DestroyShader(shaders.vertex);
+  for (const rhi::ShaderHandle fragment : shaders.fragments) {
+    rhi->DestroyShader(fragment);
+  }
+
+  // Destroying the RHI saves the cache file for the next case
+  rhi.reset();
+  return times;
+}
+
+/**
+ * @brief Compile each pipeline on first use, timing every one of them.
+ */
+double CompileOnFirstUse(
+  rhi::RHI& rhi,
+  const std::vector<rhi::GraphicsPipelineDesc>& manifest
+) {
+  double max_ms{ 0.0 };
+  for (const rhi::GraphicsPipelineDesc& desc : manifest) {
+    const Clock::time_point start{ Clock::now() };
+    static_cast<void>(rhi.GetGraphicsPipeline(desc));
+    max_ms = std::max(max_ms, MillisecondsSince(start));
+  }
+  return max_ms;
+}
+
+/**
+ * @brief Precompile the manifest on job threads, then time the first uses,
+ *        which find the pipelines compiled.
+ */
+double WarmUp(rhi::RHI& rhi,
+              const std::vector<rhi::GraphicsPipelineDesc>& manifest) {
+  rhi.WarmupPipelines(manifest);
+  while (!rhi.IsPipelineWarmupComplete()) {
+    std::this_thread::yield();
+  }
+  return CompileOnFirstUse(rhi, manifest);
+}
+
+/**
+ * @brief Print a case's times.
+ */
+void Report(std::string_view name, const CaseTimes& times) {
+  std::cout << fmt::format("{:<26} {:>10.1f} {:>12.1f} {:>12.2f} "
+                           "{:>12.1f}\n", name, times.create_ms,
+                           times.compile_ms, times.max_pipeline_ms,
+                           times.first_frame_ms);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc > 2) {
+    std::cerr << "Usage: MaplePipelineCacheBenchmark [device name]"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    maple::core::Log::Initialize();
+    maple::core::JobSystem::Initialize();
+
+    maple::platform::Window window{ "Maple Pipeline Cache Benchmark",
+                                    maple::platform::GraphicsAPI::Vulkan };
+    if (window.GetGraphicsAPI() != maple::platform::GraphicsAPI::Vulkan) {
+      throw std::runtime_error{ "Vulkan is not available" };
+    }
+    const std::string device_name{ argc == 2 ? argv[1] : "" };
+
+    std::cout << fmt::format("{} pipelines per case\n\n",
+                             kFragmentVariants * kTopologies.size()
+                               * kCullModes.size() * kBlendModes.size() * 2U);
+    std::cout << fmt::format("{:<26} {:>10} {:>12} {:>12} {:>12}\n", "Case",
+                             "Create ms", "Pipelines ms", "Worst use ms",
+                             "First frame");
+
+    // Cold: no cache file, so every pipeline is compiled from scratch.
+    // Drivers may keep a shader cache of their own, which makes this case
+    // warmer than a first run after install (for Mesa drivers such as
+    // lavapipe, set MESA_SHADER_CACHE_DISABLE=true)
+    std::filesystem::remove(kCachePath);
+    Report("Cold, compile on use",
+           RunCase(window, device_name, CompileOnFirstUse));
+
+    // Warm: the previous case saved the compiled state
+    Report("Warm, compile on use",
+           RunCase(window, device_name, CompileOnFirstUse));
+
+    // Warmup moves the compiles off the frame loop and onto job threads
+    std::filesystem::remove(kCachePath);
+    Report("Cold, warmup manifest", RunCase(window, device_name, WarmUp));
+    Report("Warm, warmup manifest", RunCase(window, device_name, WarmUp));
+
+    std::filesystem::remove(kCachePath);
+    maple::core::JobSystem::Shutdown();
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    maple::core::JobSystem::Shutdown();
+    maple::core::Log::Shutdown();
+    return EXIT_FAILURE;
+  }
+
+  maple::core::Log::Shutdown();
+  return EXIT_SUCCESS;
+}
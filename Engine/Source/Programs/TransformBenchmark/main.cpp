@@ -0,0 +1,203 @@
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <ratio>
+#include <string_view>
+#include <vector>
+
+// fmt
+#include "fmt/format.h"
+
+// glm
+#include "glm/mat4x4.hpp"
+
+// Core
+#include "Core/JobSystem.h"
+#include "Core/Log.h"
+#include "Core/TransformHierarchy.h"
+
+// Programs
+#include "BenchmarkTiming.h"
+
+namespace {
+
+namespace core = maple::core;
+
+using maple::benchmark::Measure;
+using maple::benchmark::Times;
+
+/// Node counts of the benchmarked hierarchies
+constexpr std::size_t kNodeCounts[]{ 10'000U, 100'000U, 1'000'000U };
+
+/// Kernels compared, scalar first as the baseline
+constexpr core::TransformKernel kKernels[]{
+  core::TransformKernel::Scalar, core::TransformKernel::SSE,
+  core::TransformKernel::AVX2
+};
+
+/// Roots of each hierarchy (e.g., objects placed in a level)
+constexpr std::size_t kRootCount{ 16U };
+
+/// Children of each inner node
+constexpr std::size_t kBranching{ 4U };
+
+/// Share of the nodes moved per update in the partial case
+constexpr double kMovedShare{ 0.01 };
+
+/// Nodes updated per case, so small hierarchies are updated more often
+constexpr std::size_t kNodesPerCase{ 20'000'000U };
+
+/**
+ * @brief Make a rotation about the z axis followed by a translation.
+ */
+glm::mat4 MakeLocal(float angle, float x, float y, float z) {
+  glm::mat4 local{ 1.0F };
+  local[0][0] = std::cos(angle);
+  local[0][1] = std::sin(angle);
+  local[1][0] = -std::sin(angle);
+  local[1][1] = std::cos(angle);
+  local[3][0] = x;
+  local[3][1] = y;
+  local[3][2] = z;
+  return local;
+}
+
+/**
+ * @brief Print a case, relative to the scalar kernel.
+ */
+void Report(std::size_t node_count, core::TransformKernel kernel,
+            std::string_view name, const Times& times,
+            const core::TransformStats& stats, const Times& baseline) {
+  std::cout << fmt::format(
+    "{:>9} {:<7} {:<10} {:>10.1f} {:>10.1f} {:>10} {:>12.2f} {:>8.2f}x\n",
+    node_count, core::GetTransformKernelName(kernel), name, times.mean,
+    times.p99, stats.updated_count,
+    stats.updated_count > 0U
+      ? times.mean * 1.0e3 / static_cast<double>(stats.updated_count)
+      : 0.0,
+    baseline.mean / times.mean
+  );
+}
+
+/**
+ * @brief Update a hierarchy with every kernel, moving every root (so every
+ *        node is recomputed), a few random nodes, or nothing.
+ */
+void Benchmark(std::size_t node_count) {
+  std::mt19937 random{ 42U };
+  std::uniform_real_distribution<float> angle{ -0.5F, 0.5F };
+  std::uniform_real_distribution<float> offset{ -1.0F, 1.0F };
+
+  // Nodes are created breadth-first, each inner node with kBranching
+  // children, so the hierarchy is about log4(node_count) deep
+  core::TransformHierarchy hierarchy{};
+  std::vector<core::TransformId> nodes{};
+  nodes.reserve(node_count);
+  for (std::size_t i{ 0U }; i < node_count; ++i) {
+    const core::TransformId parent{
+      i < kRootCount ? core::kInvalidTransform
+                     : nodes[(i - kRootCount) / kBranching]
+    };
+    nodes.push_back(hierarchy.Create(parent, MakeLocal(
+      angle(random), offset(random), offset(random), offset(random)
+    )));
+  }
+  hierarchy.Update();
+
+  // The same nodes move in every case
+  std::vector<core::TransformId> moved(static_cast<std::size_t>(
+    static_cast<double>(node_count) * kMovedShare
+  ));
+  std::ranges::generate(moved, [&] {
+    return nodes[std::uniform_int_distribution<std::size_t>{
+      0U, node_count - 1U
+    }(random)];
+  });
+
+  const std::size_t update_count{
+    std::max<std::size_t>(kNodesPerCase / node_count, 10U)
+  };
+  std::uint32_t frame{ 0U };
+  const auto move_roots{ [&] {
+    ++frame;
+    for (std::size_t i{ 0U }; i < kRootCount; ++i) {
+      hierarchy.SetLocal(nodes[i], MakeLocal(
+        static_cast<float>(frame) * 0.01F, static_cast<float>(i), 0.0F, 0.0F
+      ));
+    }
+    hierarchy.Update();
+  } };
+  const auto move_some{ [&] {
+    ++frame;
+    for (const core::TransformId node : moved) {
+      hierarchy.SetLocal(node, MakeLocal(
+        static_cast<float>(frame) * 0.01F, 1.0F, 0.0F, 0.0F
+      ));
+    }
+    hierarchy.Update();
+  } };
+  const auto move_none{ [&] { hierarchy.Update(); } };
+
+  Times all_baseline{};
+  Times some_baseline{};
+  Times none_baseline{};
+  for (const core::TransformKernel kernel : kKernels) {
+    if (!core::TransformHierarchy::IsKernelSupported(kernel)) {
+      std::cout << fmt::format("{:>9} {:<7} not supported\n", node_count,
+                               core::GetTransformKernelName(kernel));
+      continue;
+    }
+    hierarchy.SetKernel(kernel);
+    const bool is_baseline{ kernel == core::TransformKernel::Scalar };
+
+    const Times all{ Measure<std::micro>(update_count, move_roots) };
+    all_baseline = is_baseline ? all : all_baseline;
+    Report(node_count, kernel, "All", all, hierarchy.GetStats(),
+           all_baseline);
+
+    const Times some{ Measure<std::micro>(update_count, move_some) };
+    some_baseline = is_baseline ? some : some_baseline;
+    Report(node_count, kernel, "1% moved", some, hierarchy.GetStats(),
+           some_baseline);
+
+    const Times none{ Measure<std::micro>(update_count, move_none) };
+    none_baseline = is_baseline ? none : none_baseline;
+    Report(node_count, kernel, "Unchanged", none, hierarchy.GetStats(),
+           none_baseline);
+  }
+}
+
+} // namespace
+
+int main() {
+  try {
+    core::Log::Initialize();
+    core::JobSystem::Initialize();
+
+    std::cout << fmt::format("{} job thread(s); {} roots, {} children per "
+                             "node\n\n", core::JobSystem::GetThreadCount(),
+                             kRootCount, kBranching);
+    std::cout << fmt::format("{:>9} {:<7} {:<10} {:>10} {:>10} {:>10} {:>12} "
+                             "{:>9}\n", "Nodes", "Kernel", "Case", "Mean us",
+                             "p99 us", "Updated", "ns/updated", "Speedup");
+    for (const std::size_t node_count : kNodeCounts) {
+      Benchmark(node_count);
+    }
+
+    core::JobSystem::Shutdown();
+    core::Log::Shutdown();
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    core::JobSystem::Shutdown();
+    core::Log::Shutdown();
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,232 @@
+// STL
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// fmt
+#include "fmt/format.h"
+
+// Core
+#include "Core/Log.h"
+
+// Platform
+#include "Platform/GraphicsAPI.h"
+#include "Platform/Window.h"
+
+// RHI
+#include "RHI/RHI.h"
+#include "RHI/RHIConfig.h"
+#include "RHI/RHIResources.h"
+#include "RHI/RHIStats.h"
+
+// Programs
+#include "BenchmarkTiming.h"
+
+namespace {
+
+namespace rhi = maple::rhi;
+
+using Clock = std::chrono::steady_clock;
+using maple::benchmark::Summarize;
+using maple::benchmark::Times;
+
+/// Bytes per mebibyte
+constexpr std::uint64_t kMiB{ 1024U * 1024U };
+
+/// Bytes of the staging ring, as in RHIConfig
+constexpr std::uint64_t kStagingSize{ 32U * kMiB };
+
+/// Bytes uploaded by each throughput case
+constexpr std::uint64_t kThroughputBytes{ 512U * kMiB };
+
+/// Upload sizes of the throughput cases
+constexpr std::uint64_t kUploadSizes[]{
+  64U * 1024U, 1U * kMiB, 4U * kMiB, 16U * kMiB
+};
+
+/// Bytes uploaded per frame by the interleaved cases
+constexpr std::uint64_t kFrameUploadBytes[]{
+  1U * kMiB, 4U * kMiB, 16U * kMiB, 32U * kMiB, 64U * kMiB
+};
+
+/// Size of each upload of the interleaved cases, like a streamed mesh or
+/// texture mip
+constexpr std::uint64_t kStreamedUploadSize{ 1U * kMiB };
+
+/// Frames measured per interleaved case, after kWarmupFrames
+constexpr std::uint32_t kFrameCount{ 300U };
+
+/// Frames run before measuring, so the staging ring reaches steady state
+constexpr std::uint32_t kWarmupFrames{ 10U };
+
+/// Size of the buffer uploads are written to; offsets wrap around it
+constexpr std::uint64_t kDestinationSize{ 64U * kMiB };
+
+/**
+ * @brief Run one frame that clears the screen.
+ */
+void RunFrame(rhi::RHI& rhi, maple::platform::Window& window) {
+  window.PollEvents();
+  rhi.BeginFrame();
+  rhi.Clear(0.0F, 0.0F, 0.0F, 1.0F);
+  rhi.EndFrame();
+  rhi.Present();
+}
+
+/**
+ * @brief Upload data back to back and wait for the GPU to finish it.
+ */
+void MeasureThroughput(rhi::RHI& rhi, rhi::BufferHandle destination,
+                       std::span<const std::byte> source,
+                       std::uint64_t upload_size) {
+  const rhi::RHIStats before{ rhi.GetStats() };
+  const Clock::time_point start{ Clock::now() };
+  rhi::UploadTicket ticket{};
+  for (std::uint64_t uploaded{ 0U }; uploaded < kThroughputBytes;
+       uploaded += upload_size) {
+    ticket = rhi.UploadBuffer(destination, uploaded % kDestinationSize,
+                              source.first(upload_size));
+  }
+  rhi.WaitForUpload(ticket);
+  const double seconds{
+    std::chrono::duration<double>(Clock::now() - start).count()
+  };
+  const rhi::RHIStats after{ rhi.GetStats() };
+
+  std::cout << fmt::format(
+    "{:>10} KiB {:>12.1f} {:>10} {:>10}\n", upload_size / 1024U,
+    static_cast<double>(kThroughputBytes) / 1.0e6 / seconds,
+    after.upload_batches_submitted - before.upload_batches_submitted,
+    after.upload_stalls - before.upload_stalls
+  );
+}
+
+/**
+ * @brief Upload a fixed amount every frame while rendering, and count the
+ *        frames in which an upload waited for the staging ring.
+ */
+void MeasureInterleaved(rhi::RHI& rhi, maple::platform::Window& window,
+                        rhi::BufferHandle destination,
+                        std::span<const std::byte> source,
+                        std::uint64_t frame_bytes) {
+  std::uint64_t offset{ 0U };
+  const auto upload_frame{ [&] {
+    for (std::uint64_t uploaded{ 0U }; uploaded < frame_bytes;
+         uploaded += kStreamedUploadSize) {
+      static_cast<void>(rhi.UploadBuffer(
+        destination, offset, source.first(kStreamedUploadSize)
+      ));
+      offset = (offset + kStreamedUploadSize) % kDestinationSize;
+    }
+  } };
+  for (std::uint32_t f{ 0U }; f < kWarmupFrames; ++f) {
+    upload_frame();
+    RunFrame(rhi, window);
+  }
+
+  std::vector<double> frame_ms{};
+  frame_ms.reserve(kFrameCount);
+  std::uint32_t stalled_frames{ 0U };
+  const rhi::RHIStats before{ rhi.GetStats() };
+  const Clock::time_point start{ Clock::now() };
+  for (std::uint32_t f{ 0U }; f < kFrameCount; ++f) {
+    const Clock::time_point frame_start{ Clock::now() };
+    const std::uint64_t stalls{ rhi.GetStats().upload_stalls };
+    upload_frame();
+    if (rhi.GetStats().upload_stalls != stalls) {
+      ++stalled_frames;
+    }
+    RunFrame(rhi, window);
+    frame_ms.emplace_back(std::chrono::duration<double, std::milli>(
+      Clock::now() - frame_start
+    ).count());
+  }
+  const double seconds{
+    std::chrono::duration<double>(Clock::now() - start).count()
+  };
+  const rhi::RHIStats after{ rhi.GetStats() };
+
+  const Times times{ Summarize(std::move(frame_ms)) };
+  std::cout << fmt::format(
+    "{:>10} MiB {:>10} {:>9.1f}% {:>10.2f} {:>10.2f} {:>12.1f}\n",
+    frame_bytes / kMiB, after.upload_stalls - before.upload_stalls,
+    100.0 * stalled_frames / kFrameCount,
+    times.mean, times.p99,
+    static_cast<double>(after.uploaded_bytes - before.uploaded_bytes)
+      / 1.0e6 / seconds
+  );
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc > 2) {
+    std::cerr << "Usage: MapleUploadBenchmark [device name]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    maple::core::Log::Initialize();
+
+    maple::platform::Window window{ "Maple Upload Benchmark",
+                                    maple::platform::GraphicsAPI::Vulkan };
+    if (window.GetGraphicsAPI() != maple::platform::GraphicsAPI::Vulkan) {
+      throw std::runtime_error{ "Vulkan is not available" };
+    }
+
+    // Mailbox keeps vertical blank from pacing the frame loop
+    const std::unique_ptr<rhi::RHI> rhi{ rhi::RHI::Create(
+      &window, rhi::RHIConfig{
+        .device_name = argc == 2 ? std::string{ argv[1] } : std::string{},
+        .present_mode = rhi::PresentMode::Mailbox,
+        .upload_buffer_size = kStagingSize,
+        .pipeline_cache_path = {}
+      }
+    ) };
+
+    const rhi::BufferHandle destination{ rhi->CreateBuffer(rhi::BufferDesc{
+      .size = kDestinationSize,
+      .usage = rhi::BufferUsage::Vertex | rhi::BufferUsage::TransferDst
+    }) };
+    std::vector<std::byte> source(
+      *std::ranges::max_element(kUploadSizes)
+    );
+    for (std::size_t i{ 0U }; i < source.size(); ++i) {
+      source[i] = static_cast<std::byte>(i * 31U);
+    }
+
+    std::cout << fmt::format("Staging ring: {} MiB\n\n", kStagingSize / kMiB);
+    std::cout << fmt::format("{:>14} {:>12} {:>10} {:>10}\n", "Upload size",
+                             "MB/s", "Batches", "Stalls");
+    for (const std::uint64_t upload_size : kUploadSizes) {
+      MeasureThroughput(*rhi, destination, source, upload_size);
+    }
+
+    std::cout << fmt::format("\n{:>14} {:>10} {:>10} {:>10} {:>10} {:>12}\n",
+                             "Per frame", "Stalls", "Stalled", "Mean ms",
+                             "P99 ms", "MB/s");
+    for (const std::uint64_t frame_bytes : kFrameUploadBytes) {
+      MeasureInterleaved(*rhi, window, destination, source, frame_bytes);
+    }
+
+    rhi->DestroyBuffer(destination);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    maple::core::Log::Shutdown();
+    return EXIT_FAILURE;
+  }
+
+  maple::core::Log::Shutdown();
+  return EXIT_SUCCESS;
+}
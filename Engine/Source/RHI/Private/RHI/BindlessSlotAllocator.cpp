@@ -0,0 +1,37 @@
+#include "RHI/BindlessSlotAllocator.h"
+
+// RHI
+#include "RHI/RHIBindless.h"
+
+namespace maple::rhi {
+
+BindlessSlotAllocator::BindlessSlotAllocator(std::uint32_t capacity) noexcept
+  : capacity_{ capacity } {}
+
+std::uint32_t BindlessSlotAllocator::Allocate() {
+  if (!free_indices_.empty()) {
+    const std::uint32_t index{ free_indices_.back() };
+    free_indices_.pop_back();
+    return index;
+  }
+  if (high_water_mark_ == capacity_) {
+    return kInvalidBindlessIndex;
+  }
+  return high_water_mark_++;
+}
+
+void BindlessSlotAllocator::Free(std::uint32_t index) {
+  if (index < high_water_mark_) {
+    free_indices_.emplace_back(index);
+  }
+}
+
+std::uint32_t BindlessSlotAllocator::GetCapacity() const noexcept {
+  return capacity_;
+}
+
+std::uint32_t BindlessSlotAllocator::GetUsedCount() const noexcept {
+  return high_water_mark_ - static_cast<std::uint32_t>(free_indices_.size());
+}
+
+} // namespace maple::rhi
@@ -0,0 +1,69 @@
+#pragma once
+
+// STL
+#include <cstdint>
+#include <vector>
+
+namespace maple::rhi {
+
+/**
+ * @brief Free-list allocator of slots in a bindless descriptor array.
+ *
+ * Slots are handed out from the bottom of the array, and freed slots are
+ * reused most recently freed first, which keeps the used range compact.
+ * Freeing is immediate; a slot the GPU may still read must only be freed
+ * once the frames that used it have completed.
+ *
+ * @note Not thread-safe; callers must provide their own synchronization.
+ */
+class BindlessSlotAllocator {
+public:
+  BindlessSlotAllocator() = delete;
+  BindlessSlotAllocator(const BindlessSlotAllocator&) = delete;
+  BindlessSlotAllocator& operator=(const BindlessSlotAllocator&) = delete;
+  BindlessSlotAllocator(BindlessSlotAllocator&&) = delete;
+  BindlessSlotAllocator& operator=(BindlessSlotAllocator&&) = delete;
+
+  /**
+   * @brief Construct an allocator with every slot free.
+   *
+   * @param capacity Number of slots in the array
+   */
+  explicit BindlessSlotAllocator(std::uint32_t capacity) noexcept;
+
+  /**
+   * @brief Take a free slot.
+   *
+   * @return Index of the slot, or kInvalidBindlessIndex if every slot is used
+   */
+  [[nodiscard]] std::uint32_t Allocate();
+
+  /**
+   * @brief Return a slot; kInvalidBindlessIndex is ignored.
+   *
+   * @param index Index returned by Allocate()
+   */
+  void Free(std::uint32_t index);
+
+  /**
+   * @brief Get the number of slots in the array.
+   */
+  [[nodiscard]] std::uint32_t GetCapacity() const noexcept;
+
+  /**
+   * @brief Get the number of slots handed out.
+   */
+  [[nodiscard]] std::uint32_t GetUsedCount() const noexcept;
+
+private:
+  /// Number of slots in the array
+  std::uint32_t capacity_;
+
+  /// Slots below this index have been handed out at least once
+  std::uint32_t high_water_mark_{ 0U };
+
+  /// Freed slots below the high water mark, reused last in, first out
+  std::vector<std::uint32_t> free_indices_{};
+};
+
+} // namespace maple::rhi
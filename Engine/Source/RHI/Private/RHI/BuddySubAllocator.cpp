@@ -0,0 +1,99 @@
+#include "RHI/BuddySubAllocator.h"
+
+// STL
+#include <algorithm>
+#include <bit>
+
+namespace maple::rhi {
+
+BuddySubAllocator::BuddySubAllocator(std::uint64_t size,
+                                     std::uint64_t min_allocation_size)
+  : size_{ size }
+  , min_allocation_size_{ min_allocation_size } {
+  // One order per halving from the full range down to the minimum size
+  const auto order_count{ static_cast<std::uint32_t>(
+    std::countr_zero(size_) - std::countr_zero(min_allocation_size_) + 1
+  ) };
+  free_ranges_.resize(order_count);
+  free_ranges_.back().emplace(0U);
+}
+
+std::optional<std::uint64_t> BuddySubAllocator::Allocate(
+  std::uint64_t size,
+  std::uint64_t alignment
+) {
+  // Ranges are aligned to their size, so rounding up covers the alignment
+  const std::uint64_t range_size{
+    std::bit_ceil(std::max({ size, alignment, min_allocation_size_ }))
+  };
+  if (range_size > size_) {
+    return std::nullopt;
+  }
+  const auto order{ static_cast<std::uint32_t>(
+    std::countr_zero(range_size) - std::countr_zero(min_allocation_size_)
+  ) };
+
+  // Find the smallest free range that fits
+  std::uint32_t source_order{ order };
+  while (source_order < free_ranges_.size()
+         && free_ranges_[source_order].empty()) {
+    ++source_order;
+  }
+  if (source_order == free_ranges_.size()) {
+    return std::nullopt;
+  }
+
+  // Split it down to the requested order, freeing the upper halves
+  const auto lowest{ free_ranges_[source_order].begin() };
+  const std::uint64_t offset{ *lowest };
+  free_ranges_[source_order].erase(lowest);
+  while (source_order > order) {
+    --source_order;
+    free_ranges_[source_order].emplace(offset + GetOrderSize(source_order));
+  }
+
+  allocated_orders_.emplace(offset, order);
+  used_bytes_ += range_size;
+  return offset;
+}
+
+void BuddySubAllocator::Free(std::uint64_t offset) {
+  const auto allocated{ allocated_orders_.find(offset) };
+  if (allocated == allocated_orders_.end()) {
+    return;
+  }
+  std::uint32_t order{ allocated->second };
+  allocated_orders_.erase(allocated);
+  used_bytes_ -= GetOrderSize(order);
+
+  // Merge with the buddy for as long as it is free as well
+  while (order + 1U < free_ranges_.size()) {
+    const std::uint64_t buddy{ offset ^ GetOrderSize(order) };
+    if (free_ranges_[order].erase(buddy) == 0U) {
+      break;
+    }
+    offset = std::min(offset, buddy);
+    ++order;
+  }
+  free_ranges_[order].emplace(offset);
+}
+
+std::uint64_t BuddySubAllocator::GetSize() const noexcept {
+  return size_;
+}
+
+std::uint64_t BuddySubAllocator::GetUsedBytes() const noexcept {
+  return used_bytes_;
+}
+
+bool BuddySubAllocator::IsEmpty() const noexcept {
+  return allocated_orders_.empty();
+}
+
+std::uint64_t BuddySubAllocator::GetOrderSize(
+  std::uint32_t order
+) const noexcept {
+  return min_allocation_size_ << order;
+}
+
+} // namespace maple::rhi
@@ -0,0 +1,104 @@
+#pragma once
+
+// STL
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace maple::rhi {
+
+/**
+ * @brief Buddy allocator over an externally owned address range.
+ *
+ * Hands out power-of-two sized ranges aligned to their size and merges freed
+ * ranges with their buddies, which bounds external fragmentation at the cost
+ * of rounding requests up. Only offsets are managed; the range itself (e.g.,
+ * a block of GPU memory) is owned by the caller.
+ *
+ * @note Not thread-safe; callers must provide their own synchronization.
+ */
+class BuddySubAllocator {
+public:
+  BuddySubAllocator() = delete;
+  BuddySubAllocator(const BuddySubAllocator&) = delete;
+  BuddySubAllocator& operator=(const BuddySubAllocator&) = delete;
+  BuddySubAllocator(BuddySubAllocator&&) = default;
+  BuddySubAllocator& operator=(BuddySubAllocator&&) = default;
+
+  /**
+   * @brief Construct an allocator with the whole range free.
+   *
+   * @param size Size of the range in bytes (power of two)
+   * @param min_allocation_size Smallest range handed out (power of two)
+   */
+  BuddySubAllocator(std::uint64_t size, std::uint64_t min_allocation_size);
+
+  /**
+   * @brief Allocate a range.
+   *
+   * Prefers the lowest free offset, which keeps allocations packed towards
+   * the start of the range.
+   *
+   * @param size Requested size in bytes
+   * @param alignment Required alignment of the offset (power of two)
+   * @return Offset of the range, or std::nullopt if no range is large enough
+   */
+  [[nodiscard]] std::optional<std::uint64_t> Allocate(std::uint64_t size,
+                                                      std::uint64_t alignment);
+
+  /**
+   * @brief Free a range and merge it with its free buddies.
+   *
+   * @param offset Offset previously returned by Allocate()
+   */
+  void Free(std::uint64_t offset);
+
+  /**
+   * @brief Get the size of the managed range.
+   *
+   * @return Range size in bytes
+   */
+  [[nodiscard]] std::uint64_t GetSize() const noexcept;
+
+  /**
+   * @brief Get the bytes handed out, including rounding.
+   *
+   * @return Allocated bytes
+   */
+  [[nodiscard]] std::uint64_t GetUsedBytes() const noexcept;
+
+  /**
+   * @brief Check whether nothing is allocated.
+   *
+   * @return true if the whole range is free
+   */
+  [[nodiscard]] bool IsEmpty() const noexcept;
+
+private:
+  /**
+   * @brief Get the size of ranges of an order.
+   *
+   * @param order Order of the range (0 is the smallest)
+   * @return Range size in bytes
+   */
+  [[nodiscard]] std::uint64_t GetOrderSize(std::uint32_t order) const noexcept;
+
+  /// Size of the managed range
+  std::uint64_t size_;
+
+  /// Size of order-0 ranges
+  std::uint64_t min_allocation_size_;
+
+  /// Free range offsets per order, sorted for lowest-offset-first allocation
+  std::vector<std::set<std::uint64_t>> free_ranges_{};
+
+  /// Order of each allocated range by offset
+  std::unordered_map<std::uint64_t, std::uint32_t> allocated_orders_{};
+
+  /// Bytes handed out, including rounding
+  std::uint64_t used_bytes_{ 0U };
+};
+
+} // namespace maple::rhi
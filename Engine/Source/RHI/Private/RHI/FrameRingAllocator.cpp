@@ -0,0 +1,42 @@
+#include "RHI/FrameRingAllocator.h"
+
+namespace maple::rhi {
+
+FrameRingAllocator::FrameRingAllocator(std::uint64_t segment_size,
+                                       std::uint32_t segment_count) noexcept
+  : segment_size_{ segment_size }
+  , segment_count_{ segment_count } {}
+
+void FrameRingAllocator::BeginFrame(std::uint32_t segment_index) noexcept {
+  segment_begin_ = segment_size_ * (segment_index % segment_count_);
+  head_.store(0U, std::memory_order_relaxed);
+}
+
+std::optional<std::uint64_t> FrameRingAllocator::Allocate(
+  std::uint64_t size,
+  std::uint64_t alignment
+) noexcept {
+  // Segments start on kMaxAlignment boundaries, so aligning the offset within
+  // the segment aligns it within the ring
+  std::uint64_t head{ head_.load(std::memory_order_relaxed) };
+  std::uint64_t offset{ 0U };
+  do {
+    offset = (head + alignment - 1U) & ~(alignment - 1U);
+    if (offset > segment_size_ || size > segment_size_ - offset) {
+      return std::nullopt;
+    }
+  } while (!head_.compare_exchange_weak(head, offset + size,
+                                        std::memory_order_relaxed));
+
+  return segment_begin_ + offset;
+}
+
+std::uint64_t FrameRingAllocator::GetSize() const noexcept {
+  return segment_size_ * segment_count_;
+}
+
+std::uint64_t FrameRingAllocator::GetSegmentSize() const noexcept {
+  return segment_size_;
+}
+
+} // namespace maple::rhi
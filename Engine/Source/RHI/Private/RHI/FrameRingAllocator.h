@@ -0,0 +1,110 @@
+#pragma once
+
+// STL
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+namespace maple::rhi {
+
+/**
+ * @brief Lock-free ring allocator split into one segment per frame in flight.
+ *
+ * Each frame bumps an atomic offset through its own segment, so allocating is
+ * a single compare-and-swap and any number of threads may allocate at once.
+ * A segment is recycled as a whole when its frame slot comes around again,
+ * which the caller must only do once the GPU has finished the frame that
+ * last used it. Only offsets are managed; the range itself (e.g., a
+ * persistently mapped buffer) is owned by the caller.
+ */
+class FrameRingAllocator {
+public:
+  FrameRingAllocator() = delete;
+  FrameRingAllocator(const FrameRingAllocator&) = delete;
+  FrameRingAllocator& operator=(const FrameRingAllocator&) = delete;
+  FrameRingAllocator(FrameRingAllocator&&) = delete;
+  FrameRingAllocator& operator=(FrameRingAllocator&&) = delete;
+
+  /**
+   * @brief Construct an allocator with every segment free.
+   *
+   * @param segment_size Bytes per frame (multiple of kMaxAlignment)
+   * @param segment_count Number of frames in flight
+   */
+  FrameRingAllocator(std::uint64_t segment_size,
+                     std::uint32_t segment_count) noexcept;
+
+  /**
+   * @brief Switch to a frame slot's segment and recycle it.
+   *
+   * Must not race with Allocate().
+   *
+   * @param segment_index Frame slot [0 - segment count)
+   */
+  void BeginFrame(std::uint32_t segment_index) noexcept;
+
+  /**
+   * @brief Allocate a range from the current frame's segment.
+   *
+   * May be called from any thread.
+   *
+   * @param size Requested size in bytes
+   * @param alignment Required alignment of the offset (power of two, at most
+   *                  kMaxAlignment)
+   * @return Offset of the range from the start of the ring, or std::nullopt
+   *         if the segment is exhausted
+   */
+  [[nodiscard]] std::optional<std::uint64_t> Allocate(
+    std::uint64_t size,
+    std::uint64_t alignment
+  ) noexcept;
+
+  /**
+   * @brief Get the size of the whole ring.
+   *
+   * @return Segment size times segment count, in bytes
+   */
+  [[nodiscard]] std::uint64_t GetSize() const noexcept;
+
+  /**
+   * @brief Get the size of one segment.
+   *
+   * @return Bytes available per frame
+   */
+  [[nodiscard]] std::uint64_t GetSegmentSize() const noexcept;
+
+  /**
+   * @brief Round a requested segment size up to a valid one.
+   *
+   * @param size Requested bytes per frame
+   * @return Nonzero multiple of kMaxAlignment
+   */
+  [[nodiscard]] static constexpr std::uint64_t RoundSegmentSize(
+    std::uint64_t size
+  ) noexcept {
+    return std::max((size + kMaxAlignment - 1U) & ~(kMaxAlignment - 1U),
+                    kMaxAlignment);
+  }
+
+  /// Alignment of data without an offset alignment limit (e.g., vertices)
+  static constexpr std::uint64_t kMinAlignment{ 16U };
+
+  /// Largest supported alignment (the largest offset alignment Vulkan allows)
+  static constexpr std::uint64_t kMaxAlignment{ 256U };
+
+private:
+  /// Bytes per frame
+  std::uint64_t segment_size_;
+
+  /// Number of segments
+  std::uint32_t segment_count_;
+
+  /// Offset of the current frame's segment
+  std::uint64_t segment_begin_{ 0U };
+
+  /// Bytes allocated from the current segment
+  std::atomic<std::uint64_t> head_{ 0U };
+};
+
+} // namespace maple::rhi
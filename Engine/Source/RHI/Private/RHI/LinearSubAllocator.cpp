@@ -0,0 +1,43 @@
+#include "RHI/LinearSubAllocator.h"
+
+namespace maple::rhi {
+
+LinearSubAllocator::LinearSubAllocator(std::uint64_t size) noexcept
+  : size_{ size } {}
+
+std::optional<std::uint64_t> LinearSubAllocator::Allocate(
+  std::uint64_t size,
+  std::uint64_t alignment
+) noexcept {
+  const std::uint64_t offset{ (offset_ + alignment - 1U) & ~(alignment - 1U) };
+  if (offset > size_ || size > size_ - offset) {
+    return std::nullopt;
+  }
+
+  offset_ = offset + size;
+  ++allocation_count_;
+  used_bytes_ += size;
+  return offset;
+}
+
+void LinearSubAllocator::Free(std::uint64_t size) noexcept {
+  --allocation_count_;
+  used_bytes_ -= size;
+  if (allocation_count_ == 0U) {
+    offset_ = 0U;
+  }
+}
+
+std::uint64_t LinearSubAllocator::GetSize() const noexcept {
+  return size_;
+}
+
+std::uint64_t LinearSubAllocator::GetUsedBytes() const noexcept {
+  return used_bytes_;
+}
+
+bool LinearSubAllocator::IsEmpty() const noexcept {
+  return allocation_count_ == 0U;
+}
+
+} // namespace maple::rhi
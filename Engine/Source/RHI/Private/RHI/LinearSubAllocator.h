@@ -0,0 +1,90 @@
+#pragma once
+
+// STL
+#include <cstdint>
+#include <optional>
+
+namespace maple::rhi {
+
+/**
+ * @brief Bump allocator over an externally owned address range.
+ *
+ * Allocation only advances an offset, so it is the cheapest strategy and
+ * wastes nothing on rounding. Freed ranges are not reused individually: the
+ * whole range is recycled once every allocation has been freed, which suits
+ * short-lived allocations such as staging buffers.
+ *
+ * @note Not thread-safe; callers must provide their own synchronization.
+ */
+class LinearSubAllocator {
+public:
+  LinearSubAllocator() = delete;
+  LinearSubAllocator(const LinearSubAllocator&) = delete;
+  LinearSubAllocator& operator=(const LinearSubAllocator&) = delete;
+  LinearSubAllocator(LinearSubAllocator&&) = default;
+  LinearSubAllocator& operator=(LinearSubAllocator&&) = default;
+
+  /**
+   * @brief Construct an allocator with the whole range free.
+   *
+   * @param size Size of the range in bytes
+   */
+  explicit LinearSubAllocator(std::uint64_t size) noexcept;
+
+  /**
+   * @brief Allocate a range after the previous one.
+   *
+   * @param size Requested size in bytes
+   * @param alignment Required alignment of the offset (power of two)
+   * @return Offset of the range, or std::nullopt if the rest of the range is
+   *         too small
+   */
+  [[nodiscard]] std::optional<std::uint64_t> Allocate(
+    std::uint64_t size,
+    std::uint64_t alignment
+  ) noexcept;
+
+  /**
+   * @brief Free a range; the whole range is recycled when the last one is
+   *        freed.
+   *
+   * @param size Size passed to Allocate() for the range
+   */
+  void Free(std::uint64_t size) noexcept;
+
+  /**
+   * @brief Get the size of the managed range.
+   *
+   * @return Range size in bytes
+   */
+  [[nodiscard]] std::uint64_t GetSize() const noexcept;
+
+  /**
+   * @brief Get the bytes of live allocations.
+   *
+   * @return Allocated bytes
+   */
+  [[nodiscard]] std::uint64_t GetUsedBytes() const noexcept;
+
+  /**
+   * @brief Check whether nothing is allocated.
+   *
+   * @return true if the whole range is free
+   */
+  [[nodiscard]] bool IsEmpty() const noexcept;
+
+private:
+  /// Size of the managed range
+  std::uint64_t size_;
+
+  /// Offset of the next allocation
+  std::uint64_t offset_{ 0U };
+
+  /// Number of live allocations
+  std::uint64_t allocation_count_{ 0U };
+
+  /// Bytes of live allocations
+  std::uint64_t used_bytes_{ 0U };
+};
+
+} // namespace maple::rhi
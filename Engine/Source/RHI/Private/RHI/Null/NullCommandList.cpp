@@ -0,0 +1,160 @@
+#include "RHI/Null/NullCommandList.h"
+
+// STL
+#include <algorithm>
+
+// RHI
+#include "RHI/Null/NullRHI.h"
+
+namespace maple::rhi {
+
+namespace {
+
+/**
+ * @brief Find why a transition cannot be recorded on a list of a queue.
+ *
+ * @return Reason, or nullptr if the list may record the transition
+ */
+template <typename Barrier>
+const char* FindQueueError(const Barrier& barrier, QueueType queue) noexcept {
+  const bool hand_over{ barrier.src_queue != barrier.dst_queue };
+  if (hand_over && queue != barrier.src_queue && queue != barrier.dst_queue) {
+    return "a hand-over is recorded on a list of neither of its queues";
+  }
+  if (queue != QueueType::Compute) {
+    return nullptr;
+  }
+
+  // A list records the source side, the destination side, or both
+  const bool source_side{ !hand_over || queue == barrier.src_queue };
+  const bool destination_side{ !hand_over || queue == barrier.dst_queue };
+  if ((source_side && !IsComputeState(barrier.before))
+      || (destination_side && !IsComputeState(barrier.after))) {
+    return "a compute list transitions from or to a graphics state";
+  }
+  return nullptr;
+}
+
+} // namespace
+
+void NullCommandList::Clear(float r, float g, float b, float a) {
+  if (!recording_) {
+    NullRHI::FailValidation("RHICommandList::Clear",
+                            "called on a list that is not recording");
+  }
+  if (queue_ != QueueType::Graphics) {
+    NullRHI::FailValidation("RHICommandList::Clear",
+                            "called on a compute list");
+  }
+  NullRHI::ValidateColor("RHICommandList::Clear", r, g, b, a);
+
+  ++clear_calls_;
+}
+
+void NullCommandList::Barrier(std::span<const TextureBarrier> textures,
+                              std::span<const BufferBarrier> buffers) {
+  if (!recording_) {
+    NullRHI::FailValidation("RHICommandList::Barrier",
+                            "called on a list that is not recording");
+  }
+
+  // Undefined contents cannot be accessed afterwards
+  const auto discards{ [](const auto& barrier) {
+    return barrier.after == ResourceState::Undefined;
+  } };
+  if (std::ranges::any_of(textures, discards)
+      || std::ranges::any_of(buffers, discards)) {
+    NullRHI::FailValidation("RHICommandList::Barrier",
+                            "a transition ends in the Undefined state");
+  }
+
+  for (const TextureBarrier& barrier : textures) {
+    if (const char* error{ FindQueueError(barrier, queue_) }) {
+      NullRHI::FailValidation("RHICommandList::Barrier", error);
+    }
+  }
+  for (const BufferBarrier& barrier : buffers) {
+    if (const char* error{ FindQueueError(barrier, queue_) }) {
+      NullRHI::FailValidation("RHICommandList::Barrier", error);
+    }
+  }
+}
+
+void NullCommandList::FillBuffer(BufferHandle buffer, std::uint32_t value) {
+  static_cast<void>(value);
+  if (!recording_) {
+    NullRHI::FailValidation("RHICommandList::FillBuffer",
+                            "called on a list that is not recording");
+  }
+  if (!buffer.IsValid()) {
+    NullRHI::FailValidation("RHICommandList::FillBuffer",
+                            "the buffer handle is invalid");
+  }
+}
+
+void NullCommandList::BeginGpuZone(const char* name) {
+  if (!recording_) {
+    NullRHI::FailValidation("RHICommandList::BeginGpuZone",
+                            "called on a list that is not recording");
+  }
+  if (!name) {
+    NullRHI::FailValidation("RHICommandList::BeginGpuZone",
+                            "the zone has no name");
+  }
+
+  ++open_gpu_zones_;
+}
+
+void NullCommandList::EndGpuZone() {
+  if (!recording_) {
+    NullRHI::FailValidation("RHICommandList::EndGpuZone",
+                            "called on a list that is not recording");
+  }
+  if (open_gpu_zones_ == 0U) {
+    NullRHI::FailValidation("RHICommandList::EndGpuZone",
+                            "no zone was begun in this list");
+  }
+
+  --open_gpu_zones_;
+}
+
+void NullCommandList::Begin(std::uint64_t sort_key, QueueType queue,
+                            std::span<const std::uint64_t> wait_sort_keys) {
+  sort_key_ = sort_key;
+  queue_ = queue;
+  wait_sort_keys_.assign(wait_sort_keys.begin(), wait_sort_keys.end());
+  recording_ = true;
+  clear_calls_ = 0U;
+  open_gpu_zones_ = 0U;
+}
+
+void NullCommandList::End() noexcept {
+  recording_ = false;
+}
+
+bool NullCommandList::IsRecording() const noexcept {
+  return recording_;
+}
+
+std::uint64_t NullCommandList::GetSortKey() const noexcept {
+  return sort_key_;
+}
+
+QueueType NullCommandList::GetQueue() const noexcept {
+  return queue_;
+}
+
+std::span<const std::uint64_t> NullCommandList::GetWaitSortKeys()
+  const noexcept {
+  return wait_sort_keys_;
+}
+
+std::uint64_t NullCommandList::GetClearCalls() const noexcept {
+  return clear_calls_;
+}
+
+std::uint32_t NullCommandList::GetOpenGpuZoneCount() const noexcept {
+  return open_gpu_zones_;
+}
+
+} // namespace maple::rhi
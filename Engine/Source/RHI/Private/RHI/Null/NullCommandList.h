@@ -0,0 +1,107 @@
+#pragma once
+
+// STL
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// RHI
+#include "RHI/RHICommandList.h"
+
+namespace maple::rhi {
+
+/**
+ * @brief Command list of the Null backend.
+ *
+ * Validates and counts commands without recording any GPU work.
+ */
+class NullCommandList final : public RHICommandList {
+public:
+  NullCommandList() = default;
+
+  void Clear(float r, float g, float b, float a) override;
+  void Barrier(std::span<const TextureBarrier> textures,
+               std::span<const BufferBarrier> buffers) override;
+  void FillBuffer(BufferHandle buffer, std::uint32_t value) override;
+  void BeginGpuZone(const char* name) override;
+  void EndGpuZone() override;
+
+  /**
+   * @brief Start recording for the current frame.
+   *
+   * @param sort_key Submission position of the list
+   * @param queue Queue the list runs on
+   * @param wait_sort_keys Lists of the other queue to wait for (copied)
+   */
+  void Begin(std::uint64_t sort_key, QueueType queue,
+             std::span<const std::uint64_t> wait_sort_keys);
+
+  /**
+   * @brief Stop recording.
+   */
+  void End() noexcept;
+
+  /**
+   * @brief Check whether the list is between Begin() and End().
+   *
+   * @return true if the list is recording
+   */
+  [[nodiscard]] bool IsRecording() const noexcept;
+
+  /**
+   * @brief Get the submission position of the list.
+   *
+   * @return Sort key passed to Begin()
+   */
+  [[nodiscard]] std::uint64_t GetSortKey() const noexcept;
+
+  /**
+   * @brief Get the queue the list runs on.
+   *
+   * @return Queue passed to Begin()
+   */
+  [[nodiscard]] QueueType GetQueue() const noexcept;
+
+  /**
+   * @brief Get the lists the list waits for.
+   *
+   * @return Sort keys passed to Begin()
+   */
+  [[nodiscard]] std::span<const std::uint64_t> GetWaitSortKeys()
+    const noexcept;
+
+  /**
+   * @brief Get the number of Clear() calls recorded since Begin().
+   *
+   * @return Recorded clears
+   */
+  [[nodiscard]] std::uint64_t GetClearCalls() const noexcept;
+
+  /**
+   * @brief Get the number of GPU zones begun but not ended.
+   *
+   * @return Open zones
+   */
+  [[nodiscard]] std::uint32_t GetOpenGpuZoneCount() const noexcept;
+
+private:
+  /// Submission position of the list
+  std::uint64_t sort_key_{ 0U };
+
+  /// Queue the list runs on
+  QueueType queue_{ QueueType::Graphics };
+
+  /// Lists the list waits for
+  std::vector<std::uint64_t> wait_sort_keys_{};
+
+  /// Whether the list is between Begin() and End()
+  bool recording_{ false };
+
+  /// Clear() calls recorded since Begin()
+  std::uint64_t clear_calls_{ 0U };
+
+  /// GPU zones begun but not ended
+  std::uint32_t open_gpu_zones_{ 0U };
+};
+
+} // namespace maple::rhi
@@ -0,0 +1,616 @@
+#include "RHI/Null/NullRHI.h"
+
+// STL
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+// RHI
+#include "RHI/RHILog.h"
+
+namespace maple::rhi {
+
+namespace {
+
+/// Alignment of placed textures (the page size of common GPUs)
+constexpr std::uint64_t kPlacementAlignment{ 64U * 1024U };
+
+/**
+ * @brief Estimate the memory a texture would occupy on a GPU.
+ */
+std::uint64_t GetTextureSize(const TextureDesc& desc) noexcept {
+  std::uint64_t size{ 0U };
+  for (std::uint32_t mip{ 0U }; mip < desc.mip_levels; ++mip) {
+    size += GetMipSize(desc, mip);
+  }
+  return size;
+}
+
+} // namespace
+
+NullRHI::NullRHI(platform::Window* window, const RHIConfig& config)
+  : RHI{ window }
+  , async_compute_{ config.async_compute }
+  , sampled_texture_slots_{ config.max_bindless_textures }
+  , storage_texture_slots_{ config.max_bindless_textures }
+  , storage_buffer_slots_{ config.max_bindless_buffers }
+  , pipeline_state_cache_{ config.max_cached_pipelines }
+  , transient_allocator_{
+      FrameRingAllocator::RoundSegmentSize(config.transient_buffer_size), 1U
+    } {
+  transient_buffer_ = CreateBuffer(BufferDesc{
+    .size = transient_allocator_.GetSize(),
+    .usage = BufferUsage::Vertex | BufferUsage::Index | BufferUsage::Uniform
+             | BufferUsage::Storage,
+    .memory_usage = MemoryUsage::CpuToGpu
+  });
+  transient_data_ = static_cast<std::byte*>(MapBuffer(transient_buffer_));
+
+  MAPLE_LOG_INFO(LogRHI, "Null RHI created; no GPU work will be submitted");
+}
+
+NullRHI::~NullRHI() {
+  const RHIStats stats{ GetStats() };
+  MAPLE_LOG_INFO(LogRHI,
+                 "Null RHI destroyed after {} frame(s) ({} clear(s), {} "
+                 "present(s))",
+                 stats.begin_frame_calls, stats.clear_calls,
+                 stats.present_calls);
+}
+
+void NullRHI::BeginFrame() {
+  if (frame_state_ != FrameState::Idle) {
+    FailValidation("BeginFrame", "the previous frame was not presented");
+  }
+
+  frame_state_ = FrameState::Recording;
+  transient_allocator_.BeginFrame(0U);
+  Count(begin_frame_calls_);
+}
+
+void NullRHI::Clear(float r, float g, float b, float a) {
+  if (frame_state_ != FrameState::Recording) {
+    FailValidation("Clear", "called outside BeginFrame/EndFrame");
+  }
+
+  ValidateColor("Clear", r, g, b, a);
+
+  Count(clear_calls_);
+}
+
+RHICommandList* NullRHI::BeginCommandList(
+  std::uint64_t sort_key,
+  QueueType queue,
+  std::span<const std::uint64_t> wait_sort_keys
+) {
+  if (frame_state_ != FrameState::Recording) {
+    FailValidation("BeginCommandList", "called outside BeginFrame/EndFrame");
+  }
+
+  // Hand out the next pooled list, growing the pool as needed
+  NullCommandList* command_list{ nullptr };
+  {
+    std::lock_guard lock{ command_list_mutex_ };
+    if (command_lists_used_ == command_lists_.size()) {
+      command_lists_.emplace_back(std::make_unique<NullCommandList>());
+    }
+    command_list = command_lists_[command_lists_used_++].get();
+  }
+
+  command_list->Begin(sort_key, queue, wait_sort_keys);
+  return command_list;
+}
+
+void NullRHI::EndCommandList(RHICommandList* command_list) {
+  auto* null_command_list{ static_cast<NullCommandList*>(command_list) };
+  if (!null_command_list || !null_command_list->IsRecording()) {
+    FailValidation("EndCommandList", "the list is not recording");
+  }
+  if (null_command_list->GetOpenGpuZoneCount() != 0U) {
+    FailValidation("EndCommandList", "a GPU zone was not ended");
+  }
+
+  null_command_list->End();
+  std::lock_guard lock{ command_list_mutex_ };
+  pending_command_lists_.emplace_back(null_command_list);
+}
+
+void NullRHI::EndFrame() {
+  if (frame_state_ != FrameState::Recording) {
+    FailValidation("EndFrame", "called without a matching BeginFrame");
+  }
+
+  // Every list handed out must have been ended
+  if (pending_command_lists_.size() != command_lists_used_) {
+    FailValidation("EndFrame", "a command list was not ended");
+  }
+
+  // Merge the lists by sort key, as a GPU backend would submit them
+  std::ranges::sort(pending_command_lists_, {}, &NullCommandList::GetSortKey);
+  const auto duplicate{ std::ranges::adjacent_find(
+    pending_command_lists_, {},
+    [](const NullCommandList* list) { return list->GetSortKey(); }
+  ) };
+  if (duplicate != pending_command_lists_.end()) {
+    FailValidation("EndFrame", "two command lists share a sort key");
+  }
+
+  // Waits must name earlier lists of this frame; waits within a queue are
+  // met by submission order
+  std::uint64_t compute_lists{ 0U };
+  std::uint64_t queue_waits{ 0U };
+  for (const NullCommandList* command_list : pending_command_lists_) {
+    bool waits_for_other_queue{ false };
+    for (const std::uint64_t sort_key : command_list->GetWaitSortKeys()) {
+      const auto waited{ std::ranges::lower_bound(
+        pending_command_lists_, sort_key, {}, &NullCommandList::GetSortKey
+      ) };
+      if (waited == pending_command_lists_.end()
+          || (*waited)->GetSortKey() != sort_key) {
+        FailValidation("EndFrame", "a list waits for a list that was not "
+                                   "ended this frame");
+      }
+      if (sort_key >= command_list->GetSortKey()) {
+        FailValidation("EndFrame", "a list waits for a list that does not "
+                                   "precede it");
+      }
+      waits_for_other_queue = waits_for_other_queue
+                              || (*waited)->GetQueue()
+                                   != command_list->GetQueue();
+    }
+    if (command_list->GetQueue() == QueueType::Compute) {
+      ++compute_lists;
+    }
+    if (async_compute_ && waits_for_other_queue) {
+      ++queue_waits;
+    }
+    Count(clear_calls_, command_list->GetClearCalls());
+  }
+  Count(command_lists_submitted_, pending_command_lists_.size());
+  if (async_compute_) {
+    Count(compute_command_lists_submitted_, compute_lists);
+    Count(queue_waits_, queue_waits);
+  }
+  pending_command_lists_.clear();
+  command_lists_used_ = 0U;
+
+  frame_state_ = FrameState::Ended;
+  Count(end_frame_calls_);
+}
+
+void NullRHI::Present() {
+  if (frame_state_ != FrameState::Ended) {
+    FailValidation("Present", "called before EndFrame");
+  }
+
+  frame_state_ = FrameState::Idle;
+  Count(present_calls_);
+}
+
+std::span<const GpuZone> NullRHI::GetGpuZones() const {
+  // Nothing runs on a GPU
+  return {};
+}
+
+bool NullRHI::HasAsyncCompute() const noexcept {
+  return async_compute_;
+}
+
+void NullRHI::SetPresentMode(PresentMode present_mode) {
+  // Nothing is presented, so any mode is accepted
+}
+
+BufferHandle NullRHI::CreateBuffer(const BufferDesc& desc) {
+  if (desc.size == 0U || desc.usage == BufferUsage::None) {
+    FailValidation("CreateBuffer", "size and usage must be nonzero");
+  }
+
+  NullBuffer buffer{ .desc = desc };
+  if (desc.memory_usage != MemoryUsage::GpuOnly) {
+    buffer.data = std::make_unique<std::byte[]>(desc.size);
+  }
+
+  std::lock_guard lock{ resource_mutex_ };
+  if (HasUsage(desc.usage, BufferUsage::Storage)) {
+    buffer.bindless_index = storage_buffer_slots_.Allocate();
+    if (buffer.bindless_index == kInvalidBindlessIndex) {
+      FailValidation("CreateBuffer", "the bindless heap is full");
+    }
+  }
+  resource_bytes_ += desc.size;
+  return buffers_.Add(std::move(buffer));
+}
+
+void NullRHI::DestroyBuffer(BufferHandle buffer) {
+  std::lock_guard lock{ resource_mutex_ };
+  if (const auto removed{ buffers_.Remove(buffer) }) {
+    storage_buffer_slots_.Free(removed->bindless_index);
+    resource_bytes_ -= removed->desc.size;
+  }
+}
+
+void* NullRHI::MapBuffer(BufferHandle buffer) {
+  std::lock_guard lock{ resource_mutex_ };
+  const NullBuffer* null_buffer{ buffers_.Get(buffer) };
+  return null_buffer ? null_buffer->data.get() : nullptr;
+}
+
+TextureHandle NullRHI::CreateTexture(const TextureDesc& desc) {
+  ValidateTextureDesc("CreateTexture", desc);
+
+  std::lock_guard lock{ resource_mutex_ };
+  const TextureHandle texture{
+    AddTexture("CreateTexture", NullTexture{ .desc = desc })
+  };
+  resource_bytes_ += GetTextureSize(desc);
+  return texture;
+}
+
+void NullRHI::DestroyTexture(TextureHandle texture) {
+  std::lock_guard lock{ resource_mutex_ };
+  if (const auto removed{ textures_.Remove(texture) }) {
+    sampled_texture_slots_.Free(removed->sampled_index);
+    storage_texture_slots_.Free(removed->storage_index);
+    if (removed->heap.IsValid()) {
+      // Heaps cannot be destroyed while textures are placed in them
+      --memory_heaps_.Get(removed->heap)->placed_texture_count;
+    } else {
+      resource_bytes_ -= GetTextureSize(removed->desc);
+    }
+  }
+}
+
+MemoryRequirements NullRHI::GetTextureMemoryRequirements(
+  const TextureDesc& desc
+) const {
+  ValidateTextureDesc("GetTextureMemoryRequirements", desc);
+
+  // A single memory type, so every texture may share a heap
+  const std::uint64_t size{ GetTextureSize(desc) };
+  return MemoryRequirements{
+    .size = (size + kPlacementAlignment - 1U) / kPlacementAlignment
+            * kPlacementAlignment,
+    .alignment = kPlacementAlignment,
+    .memory_type_bits = 1U
+  };
+}
+
+MemoryHeapHandle NullRHI::CreateMemoryHeap(
+  const MemoryRequirements& requirements
+) {
+  if (requirements.size == 0U) {
+    FailValidation("CreateMemoryHeap", "size must be nonzero");
+  }
+  if ((requirements.memory_type_bits & 1U) == 0U) {
+    FailValidation("CreateMemoryHeap", "no memory type fits");
+  }
+
+  std::lock_guard lock{ resource_mutex_ };
+  resource_bytes_ += requirements.size;
+  return memory_heaps_.Add(NullMemoryHeap{ .requirements = requirements });
+}
+
+void NullRHI::DestroyMemoryHeap(MemoryHeapHandle heap) {
+  std::lock_guard lock{ resource_mutex_ };
+  const NullMemoryHeap* null_heap{ memory_heaps_.Get(heap) };
+  if (!null_heap) {
+    return;
+  }
+  if (null_heap->placed_texture_count != 0U) {
+    FailValidation("DestroyMemoryHeap", "textures are still placed in the "
+                                        "heap");
+  }
+  resource_bytes_ -= null_heap->requirements.size;
+  (void)memory_heaps_.Remove(heap);
+}
+
+TextureHandle NullRHI::CreatePlacedTexture(const TextureDesc& desc,
+                                           MemoryHeapHandle heap,
+                                           std::uint64_t offset) {
+  const MemoryRequirements requirements{ GetTextureMemoryRequirements(desc) };
+
+  std::lock_guard lock{ resource_mutex_ };
+  NullMemoryHeap* null_heap{ memory_heaps_.Get(heap) };
+  if (!null_heap) {
+    FailValidation("CreatePlacedTexture", "the heap handle is stale");
+  }
+  if (offset % requirements.alignment != 0U) {
+    FailValidation("CreatePlacedTexture", "the offset is misaligned");
+  }
+  if (offset > null_heap->requirements.size
+      || requirements.size > null_heap->requirements.size - offset) {
+    FailValidation("CreatePlacedTexture", "the range exceeds the heap");
+  }
+
+  const TextureHandle texture{
+    AddTexture("CreatePlacedTexture",
+               NullTexture{ .desc = desc, .heap = heap })
+  };
+  ++null_heap->placed_texture_count;
+  return texture;
+}
+
+std::uint32_t NullRHI::GetBindlessIndex(BufferHandle buffer) const {
+  std::lock_guard lock{ resource_mutex_ };
+  const NullBuffer* null_buffer{ buffers_.Get(buffer) };
+  return null_buffer ? null_buffer->bindless_index : kInvalidBindlessIndex;
+}
+
+std::uint32_t NullRHI::GetBindlessIndex(TextureHandle texture,
+                                        TextureUsage usage) const {
+  std::lock_guard lock{ resource_mutex_ };
+  const NullTexture* null_texture{ textures_.Get(texture) };
+  if (!null_texture) {
+    return kInvalidBindlessIndex;
+  }
+  if (usage == TextureUsage::Sampled) {
+    return null_texture->sampled_index;
+  }
+  if (usage == TextureUsage::Storage) {
+    return null_texture->storage_index;
+  }
+  return kInvalidBindlessIndex;
+}
+
+UploadTicket NullRHI::UploadBuffer(BufferHandle buffer, std::uint64_t offset,
+                                  std::span<const std::byte> data) {
+  {
+    std::lock_guard lock{ resource_mutex_ };
+    const NullBuffer* null_buffer{ buffers_.Get(buffer) };
+    if (!null_buffer) {
+      FailValidation("UploadBuffer", "the buffer handle is stale");
+    }
+    if (offset > null_buffer->desc.size
+        || data.size() > null_buffer->desc.size - offset) {
+      FailValidation("UploadBuffer", "the range exceeds the buffer");
+    }
+
+    // Only host-visible buffers have memory to copy into
+    if (null_buffer->data && !data.empty()) {
+      std::memcpy(null_buffer->data.get() + offset, data.data(), data.size());
+    }
+  }
+
+  uploaded_bytes_.fetch_add(data.size(), std::memory_order_relaxed);
+  return UploadTicket{
+    .value = upload_count_.fetch_add(1U, std::memory_order_relaxed) + 1U
+  };
+}
+
+UploadTicket NullRHI::UploadTexture(TextureHandle texture,
+                                    std::uint32_t mip_level,
+                                    std::span<const std::byte> data) {
+  {
+    std::lock_guard lock{ resource_mutex_ };
+    const NullTexture* null_texture{ textures_.Get(texture) };
+    const TextureDesc* desc{ null_texture ? &null_texture->desc : nullptr };
+    if (!desc) {
+      FailValidation("UploadTexture", "the texture handle is stale");
+    }
+    if (mip_level >= desc->mip_levels) {
+      FailValidation("UploadTexture", "the mip level does not exist");
+    }
+    if (data.size() != GetMipSize(*desc, mip_level)) {
+      FailValidation("UploadTexture", "the data size does not match the mip "
+                                      "level");
+    }
+  }
+
+  uploaded_bytes_.fetch_add(data.size(), std::memory_order_relaxed);
+  return UploadTicket{
+    .value = upload_count_.fetch_add(1U, std::memory_order_relaxed) + 1U
+  };
+}
+
+bool NullRHI::IsUploadComplete(UploadTicket ticket) const {
+  return ticket.value <= upload_count_.load(std::memory_order_relaxed);
+}
+
+void NullRHI::WaitForUpload(UploadTicket ticket) {
+  // Uploads complete before they return
+}
+
+ShaderHandle NullRHI::CreateShader(const ShaderDesc& desc) {
+  if (desc.code.empty() || desc.code.front() != kSpirvMagic) {
+    FailValidation("CreateShader", "the code is not SPIR-V");
+  }
+
+  std::lock_guard lock{ resource_mutex_ };
+  return shaders_.Add(desc.stage);
+}
+
+void NullRHI::DestroyShader(ShaderHandle shader) {
+  std::lock_guard lock{ resource_mutex_ };
+  (void)shaders_.Remove(shader);
+}
+
+PipelineHandle NullRHI::CreateGraphicsPipeline(
+  const GraphicsPipelineDesc& desc
+) {
+  std::lock_guard lock{ resource_mutex_ };
+  if (const char* error{ FindPipelineError(desc) }) {
+    FailValidation("CreateGraphicsPipeline", error);
+  }
+
+  pipelines_compiled_.fetch_add(1U, std::memory_order_relaxed);
+  return pipelines_.Add(NullPipeline{ .desc = desc });
+}
+
+PipelineHandle NullRHI::GetGraphicsPipeline(const GraphicsPipelineDesc& desc) {
+  return pipeline_state_cache_.GetOrCreate(desc, [&] {
+    std::lock_guard lock{ resource_mutex_ };
+    if (const char* error{ FindPipelineError(desc) }) {
+      FailValidation("GetGraphicsPipeline", error);
+    }
+
+    pipelines_compiled_.fetch_add(1U, std::memory_order_relaxed);
+    return pipelines_.Add(NullPipeline{ .desc = desc, .shared = true });
+  });
+}
+
+void NullRHI::DestroyPipeline(PipelineHandle pipeline) {
+  std::lock_guard lock{ resource_mutex_ };
+  const NullPipeline* null_pipeline{ pipelines_.Get(pipeline) };
+  if (null_pipeline && !null_pipeline->shared) {
+    (void)pipelines_.Remove(pipeline);
+  }
+}
+
+void NullRHI::WarmupPipelines(
+  std::span<const GraphicsPipelineDesc> manifest
+) {
+  // Nothing is compiled, so warmup finishes before it returns; invalid
+  // entries are skipped like failed compilations
+  for (const GraphicsPipelineDesc& desc : manifest) {
+    const char* error{ nullptr };
+    {
+      std::lock_guard lock{ resource_mutex_ };
+      error = FindPipelineError(desc);
+    }
+    if (error) {
+      MAPLE_LOG_WARN(LogRHI, "Skipped warming up a pipeline: {}", error);
+      continue;
+    }
+    (void)GetGraphicsPipeline(desc);
+    pipelines_warmed_up_.fetch_add(1U, std::memory_order_relaxed);
+  }
+}
+
+bool NullRHI::IsPipelineWarmupComplete() const {
+  return true;
+}
+
+TransientAllocation NullRHI::AllocateTransient(std::uint64_t size,
+                                               BufferUsage usage) {
+  if (frame_state_ != FrameState::Recording) {
+    FailValidation("AllocateTransient", "called outside BeginFrame/EndFrame");
+  }
+
+  // Use the strictest offset alignment GPUs require, so that headless runs
+  // pack data exactly as tightly as the worst real device
+  const std::uint64_t alignment{
+    HasUsage(usage, BufferUsage::Uniform)
+    || HasUsage(usage, BufferUsage::Storage)
+      ? FrameRingAllocator::kMaxAlignment
+      : FrameRingAllocator::kMinAlignment
+  };
+  const std::optional<std::uint64_t> offset{
+    transient_allocator_.Allocate(size, alignment)
+  };
+  if (!offset) {
+    FailValidation("AllocateTransient",
+                   "the frame's transient buffer is exhausted");
+  }
+
+  return TransientAllocation{
+    .data = std::span{ transient_data_ + *offset, size },
+    .buffer = transient_buffer_,
+    .offset = *offset
+  };
+}
+
+void NullRHI::DefragmentMemory() {
+  // Nothing is sub-allocated, so there is nothing to compact
+}
+
+RHIMemoryStats NullRHI::GetMemoryStats() const {
+  std::lock_guard lock{ resource_mutex_ };
+  return RHIMemoryStats{
+    .buffer_count = buffers_.GetSize(),
+    .texture_count = textures_.GetSize(),
+    .used_bytes = resource_bytes_,
+    .usage_bytes = resource_bytes_,
+    .bindless_texture_slots = sampled_texture_slots_.GetUsedCount()
+                              + storage_texture_slots_.GetUsedCount(),
+    .bindless_buffer_slots = storage_buffer_slots_.GetUsedCount()
+  };
+}
+
+RHIStats NullRHI::GetStats() const noexcept {
+  return RHIStats{
+    .begin_frame_calls = begin_frame_calls_.load(std::memory_order_relaxed),
+    .clear_calls = clear_calls_.load(std::memory_order_relaxed),
+    .command_lists_submitted =
+      command_lists_submitted_.load(std::memory_order_relaxed),
+    .compute_command_lists_submitted =
+      compute_command_lists_submitted_.load(std::memory_order_relaxed),
+    .queue_waits = queue_waits_.load(std::memory_order_relaxed),
+    .end_frame_calls = end_frame_calls_.load(std::memory_order_relaxed),
+    .present_calls = present_calls_.load(std::memory_order_relaxed),
+    .uploaded_bytes = uploaded_bytes_.load(std::memory_order_relaxed),
+    .pipelines_compiled = pipelines_compiled_.load(std::memory_order_relaxed),
+    .pipelines_warmed_up =
+      pipelines_warmed_up_.load(std::memory_order_relaxed),
+    .cached_pipelines = pipeline_state_cache_.GetSize()
+  };
+}
+
+void NullRHI::FailValidation(const char* call, const char* reason) {
+  const std::string msg{ std::format("Null RHI validation failed in {}: {}",
+                                     call, reason) };
+  MAPLE_LOG_CRITICAL(LogRHI, msg);
+  throw std::runtime_error{ msg };
+}
+
+void NullRHI::ValidateColor(const char* call, float r, float g, float b,
+                            float a) {
+  // Negated comparison so that NaN is rejected too
+  for (const float component : { r, g, b, a }) {
+    if (!(component >= 0.0F && component <= 1.0F)) {
+      FailValidation(call, "color components must be in [0.0, 1.0]");
+    }
+  }
+}
+
+void NullRHI::Count(std::atomic<std::uint64_t>& counter,
+                    std::uint64_t calls) noexcept {
+  // Single writer, so a plain load and store avoids a locked increment
+  counter.store(counter.load(std::memory_order_relaxed) + calls,
+                std::memory_order_relaxed);
+}
+
+void NullRHI::ValidateTextureDesc(const char* call, const TextureDesc& desc) {
+  if (desc.width == 0U || desc.height == 0U || desc.mip_levels == 0U
+      || desc.usage == TextureUsage::None) {
+    FailValidation(call, "size, mip levels, and usage must be nonzero");
+  }
+}
+
+TextureHandle NullRHI::AddTexture(const char* call, NullTexture null_texture) {
+  const TextureDesc& desc{ null_texture.desc };
+  if (HasUsage(desc.usage, TextureUsage::Sampled)) {
+    null_texture.sampled_index = sampled_texture_slots_.Allocate();
+    if (null_texture.sampled_index == kInvalidBindlessIndex) {
+      FailValidation(call, "the bindless heap is full");
+    }
+  }
+  if (HasUsage(desc.usage, TextureUsage::Storage)) {
+    null_texture.storage_index = storage_texture_slots_.Allocate();
+    if (null_texture.storage_index == kInvalidBindlessIndex) {
+      sampled_texture_slots_.Free(null_texture.sampled_index);
+      FailValidation(call, "the bindless heap is full");
+    }
+  }
+  return textures_.Add(null_texture);
+}
+
+const char* NullRHI::FindPipelineError(
+  const GraphicsPipelineDesc& desc
+) const {
+  const ShaderStage* vertex_stage{ shaders_.Get(desc.vertex_shader) };
+  const ShaderStage* fragment_stage{ shaders_.Get(desc.fragment_shader) };
+  if (!vertex_stage || !fragment_stage) {
+    return "a shader handle is stale";
+  }
+  if (*vertex_stage != ShaderStage::Vertex
+      || *fragment_stage != ShaderStage::Fragment) {
+    return "a shader is bound to the wrong stage";
+  }
+  return FindPipelineDescError(desc);
+}
+
+} // namespace maple::rhi
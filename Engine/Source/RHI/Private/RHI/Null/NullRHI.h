@@ -0,0 +1,336 @@
+#pragma once
+
+// STL
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// RHI
+#include "RHI/BindlessSlotAllocator.h"
+#include "RHI/FrameRingAllocator.h"
+#include "RHI/Null/NullCommandList.h"
+#include "RHI/PipelineStateCache.h"
+#include "RHI/RHI.h"
+#include "RHI/RHIHandlePool.h"
+
+// Forward declarations
+namespace maple::platform{ class Window; }
+
+namespace maple::rhi {
+
+/**
+ * @brief CPU-only backend for headless runs and benchmarking.
+ *
+ * Executes no GPU work. Every call is validated against the frame protocol
+ * (BeginFrame, commands, EndFrame, Present) and counted, so the engine loop,
+ * renderer, and profiler can run on machines without a GPU while measuring
+ * only the CPU side of rendering.
+ */
+class NullRHI final : public RHI {
+public:
+  NullRHI(platform::Window* window, const RHIConfig& config);
+
+  ~NullRHI() override;
+
+  void BeginFrame() override;
+  void Clear(float r, float g, float b, float a) override;
+  [[nodiscard]] RHICommandList* BeginCommandList(
+    std::uint64_t sort_key,
+    QueueType queue,
+    std::span<const std::uint64_t> wait_sort_keys
+  ) override;
+  void EndCommandList(RHICommandList* command_list) override;
+  void EndFrame() override;
+  void Present() override;
+  [[nodiscard]] std::span<const GpuZone> GetGpuZones() const override;
+  [[nodiscard]] bool HasAsyncCompute() const noexcept override;
+  void SetPresentMode(PresentMode present_mode) override;
+
+  [[nodiscard]] BufferHandle CreateBuffer(const BufferDesc& desc) override;
+  void DestroyBuffer(BufferHandle buffer) override;
+  [[nodiscard]] void* MapBuffer(BufferHandle buffer) override;
+  [[nodiscard]] TextureHandle CreateTexture(const TextureDesc& desc) override;
+  void DestroyTexture(TextureHandle texture) override;
+  [[nodiscard]] MemoryRequirements GetTextureMemoryRequirements(
+    const TextureDesc& desc
+  ) const override;
+  [[nodiscard]] MemoryHeapHandle CreateMemoryHeap(
+    const MemoryRequirements& requirements
+  ) override;
+  void DestroyMemoryHeap(MemoryHeapHandle heap) override;
+  [[nodiscard]] TextureHandle CreatePlacedTexture(
+    const TextureDesc& desc,
+    MemoryHeapHandle heap,
+    std::uint64_t offset
+  ) override;
+  [[nodiscard]] std::uint32_t GetBindlessIndex(
+    BufferHandle buffer
+  ) const override;
+  [[nodiscard]] std::uint32_t GetBindlessIndex(
+    TextureHandle texture,
+    TextureUsage usage
+  ) const override;
+  [[nodiscard]] UploadTicket UploadBuffer(
+    BufferHandle buffer,
+    std::uint64_t offset,
+    std::span<const std::byte> data
+  ) override;
+  [[nodiscard]] UploadTicket UploadTexture(
+    TextureHandle texture,
+    std::uint32_t mip_level,
+    std::span<const std::byte> data
+  ) override;
+  [[nodiscard]] bool IsUploadComplete(UploadTicket ticket) const override;
+  void WaitForUpload(UploadTicket ticket) override;
+  [[nodiscard]] ShaderHandle CreateShader(const ShaderDesc& desc) override;
+  void DestroyShader(ShaderHandle shader) override;
+  [[nodiscard]] PipelineHandle CreateGraphicsPipeline(
+    const GraphicsPipelineDesc& desc
+  ) override;
+  [[nodiscard]] PipelineHandle GetGraphicsPipeline(
+    const GraphicsPipelineDesc& desc
+  ) override;
+  void DestroyPipeline(PipelineHandle pipeline) override;
+  void WarmupPipelines(
+    std::span<const GraphicsPipelineDesc> manifest
+  ) override;
+  [[nodiscard]] bool IsPipelineWarmupComplete() const override;
+  [[nodiscard]] TransientAllocation AllocateTransient(
+    std::uint64_t size,
+    BufferUsage usage
+  ) override;
+  void DefragmentMemory() override;
+  [[nodiscard]] RHIMemoryStats GetMemoryStats() const override;
+
+  [[nodiscard]] RHIStats GetStats() const noexcept override;
+
+  /**
+   * @brief Fail a call that violates the frame protocol.
+   *
+   * @param call Name of the offending call
+   * @param reason Why the call is invalid
+   * @throws std::runtime_error Always
+   */
+  [[noreturn]] static void FailValidation(const char* call, const char* reason);
+
+  /**
+   * @brief Validate the components of a clear color.
+   *
+   * @param call Name of the validated call
+   * @param r Red component
+   * @param g Green component
+   * @param b Blue component
+   * @param a Alpha component
+   * @throws std::runtime_error If a component is outside [0.0, 1.0] or NaN
+   */
+  static void ValidateColor(const char* call, float r, float g, float b,
+                            float a);
+
+private:
+  /**
+   * @brief Buffer of the Null backend; host-visible buffers get CPU memory
+   *        so that mapping works.
+   */
+  struct NullBuffer {
+    /// Creation parameters
+    BufferDesc desc{};
+
+    /// Backing memory of host-visible buffers (null for GPU-only buffers)
+    std::unique_ptr<std::byte[]> data{};
+
+    /// Slot in the bindless storage buffer array
+    std::uint32_t bindless_index{ kInvalidBindlessIndex };
+  };
+
+  /**
+   * @brief Texture of the Null backend.
+   */
+  struct NullTexture {
+    /// Creation parameters
+    TextureDesc desc{};
+
+    /// Heap the texture is placed in (invalid if it owns its memory)
+    MemoryHeapHandle heap{};
+
+    /// Slot in the bindless sampled texture array
+    std::uint32_t sampled_index{ kInvalidBindlessIndex };
+
+    /// Slot in the bindless storage texture array
+    std::uint32_t storage_index{ kInvalidBindlessIndex };
+  };
+
+  /**
+   * @brief Memory heap of the Null backend; only its extent is tracked.
+   */
+  struct NullMemoryHeap {
+    /// Creation parameters
+    MemoryRequirements requirements{};
+
+    /// Live textures placed in the heap
+    std::uint32_t placed_texture_count{ 0U };
+  };
+
+  /**
+   * @brief Pipeline of the Null backend.
+   */
+  struct NullPipeline {
+    /// Creation parameters
+    GraphicsPipelineDesc desc{};
+
+    /// Whether the pipeline belongs to the pipeline state cache
+    bool shared{ false };
+  };
+
+  /**
+   * @brief Position of the backend in the frame protocol.
+   */
+  enum class FrameState {
+    /// Ready for BeginFrame()
+    Idle,
+
+    /// Between BeginFrame() and EndFrame()
+    Recording,
+
+    /// Between EndFrame() and Present()
+    Ended
+  };
+
+  /**
+   * @brief Count completed calls.
+   *
+   * Counters are only written by the thread driving the RHI, but may be read
+   * from any thread.
+   *
+   * @param counter Counter to increment
+   * @param calls Number of calls to add
+   */
+  static void Count(std::atomic<std::uint64_t>& counter,
+                    std::uint64_t calls = 1U) noexcept;
+
+  /**
+   * @brief Check a texture description.
+   *
+   * @param call Name of the validated call
+   * @param desc Description to check
+   * @throws std::runtime_error If the size, mip levels, or usage are zero
+   */
+  static void ValidateTextureDesc(const char* call, const TextureDesc& desc);
+
+  /**
+   * @brief Give a texture its bindless slots and add it to the pool.
+   *
+   * @param call Name of the creating call
+   * @param null_texture Texture to add (resource_mutex_ must be held)
+   * @return Handle to the texture
+   * @throws std::runtime_error If the bindless heap is full
+   */
+  [[nodiscard]] TextureHandle AddTexture(const char* call,
+                                         NullTexture null_texture);
+
+  /**
+   * @brief Check a pipeline description, including its shaders.
+   *
+   * @param desc Description to check (resource_mutex_ must be held)
+   * @return Why the description is invalid, or nullptr if it is valid
+   */
+  [[nodiscard]] const char* FindPipelineError(
+    const GraphicsPipelineDesc& desc
+  ) const;
+
+  /// Current position in the frame protocol
+  FrameState frame_state_{ FrameState::Idle };
+
+  /// Completed BeginFrame() calls
+  std::atomic<std::uint64_t> begin_frame_calls_{ 0U };
+
+  /// Completed Clear() calls
+  std::atomic<std::uint64_t> clear_calls_{ 0U };
+
+  /// Command lists submitted by EndFrame()
+  std::atomic<std::uint64_t> command_lists_submitted_{ 0U };
+
+  /// Compute lists submitted by EndFrame()
+  std::atomic<std::uint64_t> compute_command_lists_submitted_{ 0U };
+
+  /// Lists that waited for a list of the other queue
+  std::atomic<std::uint64_t> queue_waits_{ 0U };
+
+  /// Whether compute lists are treated as running on their own queue
+  bool async_compute_;
+
+  /// Guards the command list pool and the pending lists
+  std::mutex command_list_mutex_{};
+
+  /// Command lists reused across frames
+  std::vector<std::unique_ptr<NullCommandList>> command_lists_{};
+
+  /// Number of pooled lists handed out this frame
+  std::size_t command_lists_used_{ 0U };
+
+  /// Lists ended this frame, awaiting EndFrame()
+  std::vector<NullCommandList*> pending_command_lists_{};
+
+  /// Completed EndFrame() calls
+  std::atomic<std::uint64_t> end_frame_calls_{ 0U };
+
+  /// Completed Present() calls
+  std::atomic<std::uint64_t> present_calls_{ 0U };
+
+  /// Guards the resource pools and memory counters
+  mutable std::mutex resource_mutex_{};
+
+  /// Live buffers
+  RHIHandlePool<BufferHandle, NullBuffer> buffers_{};
+
+  /// Live textures
+  RHIHandlePool<TextureHandle, NullTexture> textures_{};
+
+  /// Live memory heaps
+  RHIHandlePool<MemoryHeapHandle, NullMemoryHeap> memory_heaps_{};
+
+  /// Slots of the bindless arrays; frames finish instantly, so slots are
+  /// reused as soon as their resource is destroyed
+  BindlessSlotAllocator sampled_texture_slots_;
+  BindlessSlotAllocator storage_texture_slots_;
+  BindlessSlotAllocator storage_buffer_slots_;
+
+  /// Bytes of live buffers, textures, and memory heaps (placed textures
+  /// are counted by their heap)
+  std::uint64_t resource_bytes_{ 0U };
+
+  /// Live shaders
+  RHIHandlePool<ShaderHandle, ShaderStage> shaders_{};
+
+  /// Live pipelines
+  RHIHandlePool<PipelineHandle, NullPipeline> pipelines_{};
+
+  /// Pipelines "compiled", including warmup (any thread)
+  std::atomic<std::uint64_t> pipelines_compiled_{ 0U };
+
+  /// Pipelines "compiled" by warmup (any thread)
+  std::atomic<std::uint64_t> pipelines_warmed_up_{ 0U };
+
+  /// Shared pipelines by description
+  PipelineStateCache<PipelineHandle> pipeline_state_cache_;
+
+  /// Uploads performed; uploads complete immediately, so this is also the
+  /// last completed ticket (any thread)
+  std::atomic<std::uint64_t> upload_count_{ 0U };
+
+  /// Bytes copied by uploads (any thread)
+  std::atomic<std::uint64_t> uploaded_bytes_{ 0U };
+
+  /// Offsets of per-frame data; one segment, since frames finish instantly
+  FrameRingAllocator transient_allocator_;
+
+  /// Buffer backing per-frame data
+  BufferHandle transient_buffer_{};
+
+  /// CPU memory of the transient buffer
+  std::byte* transient_data_{ nullptr };
+};
+
+} // namespace maple::rhi
@@ -0,0 +1,227 @@
+#pragma once
+
+// STL
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+// RHI
+#include "RHI/RHIPipeline.h"
+
+namespace maple::rhi {
+
+/**
+ * @brief Concurrent map from pipeline descriptions to compiled pipelines.
+ *
+ * An open-addressing table of fixed capacity whose slots are claimed with a
+ * compare-and-swap and never freed, so lookups of compiled pipelines take no
+ * lock and never retry. When several threads ask for the same uncached
+ * description, one compiles it and the others wait for its result; a failed
+ * compilation is retried by the next caller.
+ *
+ * @tparam Value Trivially copyable result of a compilation (e.g., a handle)
+ *
+ * @note GetOrCreate() and Find() may be called from any thread; ForEach()
+ *       must not run concurrently with them.
+ */
+template <typename Value>
+class PipelineStateCache {
+public:
+  PipelineStateCache() = delete;
+  PipelineStateCache(const PipelineStateCache&) = delete;
+  PipelineStateCache& operator=(const PipelineStateCache&) = delete;
+  PipelineStateCache(PipelineStateCache&&) = delete;
+  PipelineStateCache& operator=(PipelineStateCache&&) = delete;
+
+  /**
+   * @brief Create an empty cache.
+   *
+   * @param capacity Most descriptions the cache holds (rounded up to a power
+   *                 of two)
+   */
+  explicit PipelineStateCache(std::size_t capacity)
+    : capacity_{ std::bit_ceil(capacity < 2U ? 2U : capacity) }
+    , slots_{ std::make_unique<Slot[]>(capacity_) } {}
+
+  /**
+   * @brief Find the pipeline of a description, compiling it on a miss.
+   *
+   * @param desc Description to look up (copied into the cache on a miss)
+   * @param create Callable with signature Value(), run at most once per
+   *               description unless it throws
+   * @return The cached or newly compiled pipeline
+   * @throws std::runtime_error If the cache is full; rethrows what create
+   *                            throws
+   */
+  template <typename Create>
+  [[nodiscard]] Value GetOrCreate(const GraphicsPipelineDesc& desc,
+                                  Create&& create) {
+    const std::uint64_t hash{ HashPipelineDesc(desc) };
+    for (std::size_t probe{ 0U }; probe < capacity_; ++probe) {
+      Slot& slot{ slots_[(hash + probe) & (capacity_ - 1U)] };
+      State state{ slot.state.load(std::memory_order_acquire) };
+      while (true) {
+        if (state == State::Empty) {
+          // Claim the slot, then publish the key before compiling
+          if (!slot.state.compare_exchange_weak(state, State::Claimed,
+                                                std::memory_order_acquire)) {
+            continue;
+          }
+          slot.hash = hash;
+          slot.desc = desc;
+          size_.fetch_add(1U, std::memory_order_relaxed);
+          return Compile(slot, std::forward<Create>(create));
+        }
+        if (state == State::Claimed) {
+          // The key is being written; it is published within a few stores
+          slot.state.wait(state, std::memory_order_acquire);
+          state = slot.state.load(std::memory_order_acquire);
+          continue;
+        }
+        if (slot.hash != hash || slot.desc != desc) {
+          break;
+        }
+        if (state == State::Ready) {
+          return slot.value;
+        }
+        if (state == State::Compiling) {
+          slot.state.wait(state, std::memory_order_acquire);
+          state = slot.state.load(std::memory_order_acquire);
+          continue;
+        }
+
+        // The last attempt failed; try again unless another caller already is
+        if (slot.state.compare_exchange_weak(state, State::Compiling,
+                                             std::memory_order_acquire)) {
+          return Compile(slot, std::forward<Create>(create));
+        }
+      }
+    }
+
+    throw std::runtime_error{ "Pipeline state cache is full" };
+  }
+
+  /**
+   * @brief Find the pipeline of a description without compiling it.
+   *
+   * @param desc Description to look up
+   * @return The cached pipeline, or std::nullopt if it is not compiled yet
+   */
+  [[nodiscard]] std::optional<Value> Find(
+    const GraphicsPipelineDesc& desc
+  ) const noexcept {
+    const std::uint64_t hash{ HashPipelineDesc(desc) };
+    for (std::size_t probe{ 0U }; probe < capacity_; ++probe) {
+      const Slot& slot{ slots_[(hash + probe) & (capacity_ - 1U)] };
+      const State state{ slot.state.load(std::memory_order_acquire) };
+      if (state == State::Empty) {
+        return std::nullopt;
+      }
+      if (state != State::Claimed && slot.hash == hash && slot.desc == desc) {
+        return state == State::Ready ? std::optional<Value>{ slot.value }
+                                     : std::nullopt;
+      }
+    }
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Visit every compiled pipeline.
+   *
+   * @param function Callable with signature void(const GraphicsPipelineDesc&,
+   *                 Value)
+   */
+  template <typename Function>
+  void ForEach(Function&& function) const {
+    for (std::size_t i{ 0U }; i < capacity_; ++i) {
+      const Slot& slot{ slots_[i] };
+      if (slot.state.load(std::memory_order_acquire) == State::Ready) {
+        function(slot.desc, slot.value);
+      }
+    }
+  }
+
+  /**
+   * @brief Get the number of descriptions in the cache.
+   *
+   * @return Claimed slot count, including compilations in progress
+   */
+  [[nodiscard]] std::size_t GetSize() const noexcept {
+    return size_.load(std::memory_order_relaxed);
+  }
+
+private:
+  /**
+   * @brief Lifecycle of a slot; only ever moves away from Empty.
+   */
+  enum class State : std::uint32_t {
+    /// Unused; ends probe sequences
+    Empty,
+
+    /// Owned by a thread writing the key
+    Claimed,
+
+    /// Key published; a thread is compiling the pipeline
+    Compiling,
+
+    /// Key and value published
+    Ready,
+
+    /// Key published; the last compilation threw
+    Failed
+  };
+
+  /**
+   * @brief One description and its pipeline.
+   */
+  struct Slot {
+    /// Guards the other members: written only by the thread that moved the
+    /// state to Claimed or Compiling, read only after acquiring a later state
+    std::atomic<State> state{ State::Empty };
+
+    /// HashPipelineDesc() of desc
+    std::uint64_t hash{ 0U };
+
+    /// Key
+    GraphicsPipelineDesc desc{};
+
+    /// Compiled pipeline (valid in Ready)
+    Value value{};
+  };
+
+  /**
+   * @brief Compile the pipeline of a slot this thread owns and publish it.
+   */
+  template <typename Create>
+  Value Compile(Slot& slot, Create&& create) {
+    // Waiters are woken either way, so a failure never strands them
+    slot.state.store(State::Compiling, std::memory_order_release);
+    slot.state.notify_all();
+    try {
+      slot.value = create();
+    } catch (...) {
+      slot.state.store(State::Failed, std::memory_order_release);
+      slot.state.notify_all();
+      throw;
+    }
+    slot.state.store(State::Ready, std::memory_order_release);
+    slot.state.notify_all();
+    return slot.value;
+  }
+
+  /// Number of slots (a power of two)
+  std::size_t capacity_;
+
+  /// Slots, indexed by hash with linear probing
+  std::unique_ptr<Slot[]> slots_;
+
+  /// Claimed slot count
+  std::atomic<std::size_t> size_{ 0U };
+};
+
+} // namespace maple::rhi
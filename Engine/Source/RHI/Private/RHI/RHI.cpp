@@ -10,11 +10,13 @@
 
 // RHI
 #include "RHI/RHILog.h"
+#include "RHI/Null/NullRHI.h"
 #include "RHI/Vulkan/VulkanRHI.h"
 
 namespace maple::rhi {
 
-std::unique_ptr<RHI> RHI::Create(platform::Window* window) {
+std::unique_ptr<RHI> RHI::Create(platform::Window* window,
+                                 const RHIConfig& config) {
   // Validate window pointer
   if (!window) {
     const std::string msg{ "Window pointer is null" };
@@ -43,18 +45,27 @@ std::unique_ptr<RHI> RHI::Create(platform::Window* window) {
 
     case platform::GraphicsAPI::Vulkan: {
       MAPLE_LOG_INFO(LogRHI, "Selected RHI backend: Vulkan");
-      return std::make_unique<VulkanRHI>(window);
+      return std::make_unique<VulkanRHI>(window, config);
+    }
+
+    case platform::GraphicsAPI::Null: {
+      MAPLE_LOG_INFO(LogRHI, "Selected RHI backend: Null");
+      return std::make_unique<NullRHI>(window, config);
     }
 
     default: {
       const std::string msg{ "Unsupported RHI backend detected; choose one of "
-                             "the following: D3D12, Metal, or Vulkan." };
+                             "the following: D3D12, Metal, Vulkan, or Null." };
       MAPLE_LOG_CRITICAL(LogRHI, msg);
       throw std::runtime_error{ msg };
     }
   }
 }
 
+RHIStats RHI::GetStats() const noexcept {
+  return {};
+}
+
 RHI::RHI(platform::Window* window)
   : window_{ window } {}
 
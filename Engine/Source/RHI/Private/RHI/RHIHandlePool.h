@@ -0,0 +1,145 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace maple::rhi {
+
+/**
+ * @brief Slot map from generational handles to backend resources.
+ *
+ * Slots are recycled through a free list; each reuse bumps the slot's
+ * generation so that handles to the previous resource no longer resolve.
+ *
+ * @tparam Handle RHIHandle type handed out
+ * @tparam T Backend resource stored per handle
+ *
+ * @note Not thread-safe; callers must provide their own synchronization.
+ */
+template <typename Handle, typename T>
+class RHIHandlePool {
+public:
+  /**
+   * @brief Store a resource in a free slot.
+   *
+   * @param value Resource to store
+   * @return Handle to the stored resource
+   */
+  [[nodiscard]] Handle Add(T value) {
+    std::uint32_t index{ 0U };
+    if (free_indices_.empty()) {
+      index = static_cast<std::uint32_t>(slots_.size());
+      slots_.emplace_back();
+    } else {
+      index = free_indices_.back();
+      free_indices_.pop_back();
+    }
+
+    Slot& slot{ slots_[index] };
+    slot.value = std::move(value);
+    slot.occupied = true;
+    ++size_;
+    return Handle{ .index = index, .generation = slot.generation };
+  }
+
+  /**
+   * @brief Look up a resource.
+   *
+   * @param handle Handle returned by Add()
+   * @return Pointer to the resource, or nullptr if the handle is stale
+   */
+  [[nodiscard]] T* Get(Handle handle) noexcept {
+    if (handle.index >= slots_.size()) {
+      return nullptr;
+    }
+    Slot& slot{ slots_[handle.index] };
+    return slot.occupied && slot.generation == handle.generation ? &slot.value
+                                                                 : nullptr;
+  }
+
+  /**
+   * @brief Look up a resource.
+   *
+   * @param handle Handle returned by Add()
+   * @return Pointer to the resource, or nullptr if the handle is stale
+   */
+  [[nodiscard]] const T* Get(Handle handle) const noexcept {
+    return const_cast<RHIHandlePool*>(this)->Get(handle);
+  }
+
+  /**
+   * @brief Take a resource out of its slot and free the slot.
+   *
+   * @param handle Handle returned by Add()
+   * @return The resource, or std::nullopt if the handle is stale
+   */
+  [[nodiscard]] std::optional<T> Remove(Handle handle) {
+    if (!Get(handle)) {
+      return std::nullopt;
+    }
+
+    Slot& slot{ slots_[handle.index] };
+    std::optional<T> value{ std::move(slot.value) };
+    slot.value = T{};
+    slot.occupied = false;
+    ++slot.generation;
+    free_indices_.emplace_back(handle.index);
+    --size_;
+    return value;
+  }
+
+  /**
+   * @brief Visit every stored resource.
+   *
+   * @param function Callable with signature void(Handle, T&)
+   */
+  template <typename Function>
+  void ForEach(Function&& function) {
+    for (std::uint32_t i{ 0U }; i < slots_.size(); ++i) {
+      Slot& slot{ slots_[i] };
+      if (slot.occupied) {
+        function(Handle{ .index = i, .generation = slot.generation },
+                 slot.value);
+      }
+    }
+  }
+
+  /**
+   * @brief Get the number of stored resources.
+   *
+   * @return Occupied slot count
+   */
+  [[nodiscard]] std::size_t GetSize() const noexcept {
+    return size_;
+  }
+
+private:
+  /**
+   * @brief Storage of one resource.
+   */
+  struct Slot {
+    /// Stored resource (default-constructed while free)
+    T value{};
+
+    /// Incremented whenever the slot is freed
+    std::uint32_t generation{ 0U };
+
+    /// Whether the slot holds a resource
+    bool occupied{ false };
+  };
+
+  /// Resource slots
+  std::vector<Slot> slots_{};
+
+  /// Indices of free slots
+  std::vector<std::uint32_t> free_indices_{};
+
+  /// Number of occupied slots
+  std::size_t size_{ 0U };
+};
+
+} // namespace maple::rhi
@@ -0,0 +1,113 @@
+#include "RHI/Vulkan/VulkanCommandList.h"
+
+// RHI
+#include "RHI/Vulkan/VulkanRHI.h"
+
+namespace maple::rhi {
+
+VulkanCommandList::VulkanCommandList(const VulkanRHI* rhi,
+                                     vk::CommandBuffer command_buffer) noexcept
+  : rhi_{ rhi }
+  , command_buffer_{ command_buffer } {}
+
+void VulkanCommandList::Clear(float r, float g, float b, float a) {
+  // The swapchain image belongs to the graphics queue
+  if (!command_buffer_ || queue_ != QueueType::Graphics) {
+    return;
+  }
+
+  // The primary command buffer keeps the image in TransferDstOptimal while
+  // command lists execute
+  vk::ClearColorValue color{};
+  color.setFloat32({ r, g, b, a });
+  const vk::ImageSubresourceRange range{
+    .aspectMask = vk::ImageAspectFlagBits::eColor,
+    .baseMipLevel = 0U,
+    .levelCount = 1U,
+    .baseArrayLayer = 0U,
+    .layerCount = 1U
+  };
+  command_buffer_.clearColorImage(target_, vk::ImageLayout::eTransferDstOptimal,
+                                  color, range);
+}
+
+void VulkanCommandList::Barrier(std::span<const TextureBarrier> textures,
+                                std::span<const BufferBarrier> buffers) {
+  if (command_buffer_) {
+    rhi_->RecordBarrier(command_buffer_, queue_, textures, buffers);
+  }
+}
+
+void VulkanCommandList::FillBuffer(BufferHandle buffer, std::uint32_t value) {
+  if (command_buffer_) {
+    rhi_->RecordFillBuffer(command_buffer_, buffer, value);
+  }
+}
+
+void VulkanCommandList::BeginGpuZone(const char* name) {
+  if (command_buffer_) {
+    open_gpu_zones_.push_back(
+      rhi_->BeginGpuZone(command_buffer_, queue_, name)
+    );
+  }
+}
+
+void VulkanCommandList::EndGpuZone() {
+  if (command_buffer_ && !open_gpu_zones_.empty()) {
+    rhi_->EndGpuZone(command_buffer_, open_gpu_zones_.back());
+    open_gpu_zones_.pop_back();
+  }
+}
+
+void VulkanCommandList::Begin(std::uint64_t sort_key, QueueType queue,
+                              std::span<const std::uint64_t> wait_sort_keys,
+                              vk::Image target) {
+  // A discarding list is shared between threads and must stay untouched
+  if (!command_buffer_) {
+    return;
+  }
+
+  sort_key_ = sort_key;
+  queue_ = queue;
+  wait_sort_keys_.assign(wait_sort_keys.begin(), wait_sort_keys.end());
+  target_ = target;
+  open_gpu_zones_.clear();
+
+  // Secondary buffers executed outside a render pass inherit nothing
+  const vk::CommandBufferInheritanceInfo inheritance_info{};
+  command_buffer_.begin(vk::CommandBufferBeginInfo{
+    .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit,
+    .pInheritanceInfo = &inheritance_info
+  });
+}
+
+void VulkanCommandList::End() {
+  if (!command_buffer_) {
+    return;
+  }
+
+  // Zones left open would never get their second timestamp
+  while (!open_gpu_zones_.empty()) {
+    EndGpuZone();
+  }
+  command_buffer_.end();
+}
+
+vk::CommandBuffer VulkanCommandList::GetCommandBuffer() const noexcept {
+  return command_buffer_;
+}
+
+std::uint64_t VulkanCommandList::GetSortKey() const noexcept {
+  return sort_key_;
+}
+
+QueueType VulkanCommandList::GetQueue() const noexcept {
+  return queue_;
+}
+
+std::span<const std::uint64_t> VulkanCommandList::GetWaitSortKeys()
+  const noexcept {
+  return wait_sort_keys_;
+}
+
+} // namespace maple::rhi
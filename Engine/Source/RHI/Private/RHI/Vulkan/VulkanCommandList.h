@@ -0,0 +1,113 @@
+#pragma once
+
+// STL
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Vulkan
+#include "Vulkan/vulkan.hpp"
+
+// RHI
+#include "RHI/RHICommandList.h"
+
+namespace maple::rhi {
+
+class VulkanRHI;
+
+/**
+ * @brief Command list of the Vulkan backend, recorded into a secondary
+ *        command buffer.
+ *
+ * Lists are pooled per thread and per frame in flight, so recording never
+ * contends on a command pool. A list without a command buffer discards its
+ * commands; it is handed out while the frame is skipped (e.g., minimized).
+ */
+class VulkanCommandList final : public RHICommandList {
+public:
+  /**
+   * @brief Construct a list around a secondary command buffer.
+   *
+   * @param rhi Backend that resolves resource handles
+   * @param command_buffer Secondary command buffer owned by a thread's pool
+   *                       (null for a list that discards its commands)
+   */
+  VulkanCommandList(const VulkanRHI* rhi,
+                    vk::CommandBuffer command_buffer) noexcept;
+
+  void Clear(float r, float g, float b, float a) override;
+  void Barrier(std::span<const TextureBarrier> textures,
+               std::span<const BufferBarrier> buffers) override;
+  void FillBuffer(BufferHandle buffer, std::uint32_t value) override;
+  void BeginGpuZone(const char* name) override;
+  void EndGpuZone() override;
+
+  /**
+   * @brief Start recording for the current frame.
+   *
+   * @param sort_key Submission position of the list
+   * @param queue Queue the list runs on
+   * @param wait_sort_keys Lists of the other queue to wait for (copied)
+   * @param target Swapchain image acquired for the frame
+   */
+  void Begin(std::uint64_t sort_key, QueueType queue,
+             std::span<const std::uint64_t> wait_sort_keys, vk::Image target);
+
+  /**
+   * @brief Stop recording, ending any GPU zone left open.
+   */
+  void End();
+
+  /**
+   * @brief Get the secondary command buffer the list records into.
+   *
+   * @return Command buffer (null for a discarding list)
+   */
+  [[nodiscard]] vk::CommandBuffer GetCommandBuffer() const noexcept;
+
+  /**
+   * @brief Get the submission position of the list.
+   *
+   * @return Sort key passed to Begin()
+   */
+  [[nodiscard]] std::uint64_t GetSortKey() const noexcept;
+
+  /**
+   * @brief Get the queue the list runs on.
+   *
+   * @return Queue passed to Begin()
+   */
+  [[nodiscard]] QueueType GetQueue() const noexcept;
+
+  /**
+   * @brief Get the lists the list waits for.
+   *
+   * @return Sort keys passed to Begin()
+   */
+  [[nodiscard]] std::span<const std::uint64_t> GetWaitSortKeys()
+    const noexcept;
+
+private:
+  /// Backend that resolves resource handles
+  const VulkanRHI* rhi_;
+
+  /// Secondary command buffer owned by a thread's pool
+  vk::CommandBuffer command_buffer_{ nullptr };
+
+  /// Swapchain image acquired for the frame
+  vk::Image target_{ nullptr };
+
+  /// Submission position of the list
+  std::uint64_t sort_key_{ 0U };
+
+  /// Queue the list runs on
+  QueueType queue_{ QueueType::Graphics };
+
+  /// Lists the list waits for
+  std::vector<std::uint64_t> wait_sort_keys_{};
+
+  /// GPU zones begun and not yet ended, innermost last
+  std::vector<std::uint32_t> open_gpu_zones_{};
+};
+
+} // namespace maple::rhi
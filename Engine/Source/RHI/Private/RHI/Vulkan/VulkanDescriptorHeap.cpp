@@ -0,0 +1,307 @@
+#include "RHI/Vulkan/VulkanDescriptorHeap.h"
+
+// STL
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// RHI
+#include "RHI/RHILog.h"
+
+namespace maple::rhi {
+
+namespace {
+
+/// Anisotropy of the linear samplers where the device supports it
+constexpr float kMaxAnisotropy{ 16.0F };
+
+/**
+ * @brief Get the descriptor type of a bindless array.
+ */
+constexpr vk::DescriptorType GetDescriptorType(BindlessSet set) noexcept {
+  switch (set) {
+    case BindlessSet::SampledTextures: {
+      return vk::DescriptorType::eSampledImage;
+    }
+
+    case BindlessSet::StorageTextures: {
+      return vk::DescriptorType::eStorageImage;
+    }
+
+    case BindlessSet::StorageBuffers: {
+      return vk::DescriptorType::eStorageBuffer;
+    }
+
+    default: { return vk::DescriptorType::eSampler; }
+  }
+}
+
+} // namespace
+
+VulkanDescriptorHeap::VulkanDescriptorHeap(vk::PhysicalDevice physical_device,
+                                           vk::Device device,
+                                           std::uint32_t max_textures,
+                                           std::uint32_t max_buffers)
+  : device_{ device }
+  , array_sizes_{ ClampArraySizes(physical_device, max_textures, max_buffers) }
+  , sampled_image_slots_{ array_sizes_.textures }
+  , storage_image_slots_{ array_sizes_.textures }
+  , storage_buffer_slots_{ array_sizes_.buffers } {
+  // Create the fixed samplers; the RHI enables anisotropy where supported
+  const bool anisotropy{
+    physical_device.getFeatures().samplerAnisotropy == vk::True
+  };
+  const float max_anisotropy{
+    std::min(kMaxAnisotropy,
+             physical_device.getProperties().limits.maxSamplerAnisotropy)
+  };
+  for (std::size_t i{ 0U }; i < samplers_.size(); ++i) {
+    const auto sampler{ static_cast<BindlessSampler>(i) };
+    const bool linear{ sampler == BindlessSampler::LinearRepeat
+                       || sampler == BindlessSampler::LinearClamp };
+    const vk::SamplerAddressMode address_mode{
+      sampler == BindlessSampler::LinearRepeat
+          || sampler == BindlessSampler::NearestRepeat
+        ? vk::SamplerAddressMode::eRepeat
+        : vk::SamplerAddressMode::eClampToEdge
+    };
+    samplers_[i] = device_.createSamplerUnique(vk::SamplerCreateInfo{
+      .magFilter = linear ? vk::Filter::eLinear : vk::Filter::eNearest,
+      .minFilter = linear ? vk::Filter::eLinear : vk::Filter::eNearest,
+      .mipmapMode = linear ? vk::SamplerMipmapMode::eLinear
+                           : vk::SamplerMipmapMode::eNearest,
+      .addressModeU = address_mode,
+      .addressModeV = address_mode,
+      .addressModeW = address_mode,
+      .anisotropyEnable = linear && anisotropy ? vk::True : vk::False,
+      .maxAnisotropy = linear && anisotropy ? max_anisotropy : 1.0F,
+      .maxLod = vk::LodClampNone
+    });
+  }
+
+  // Resource arrays may be written while bound and while frames that use
+  // other slots are in flight; slots nobody reads may hold stale descriptors
+  constexpr vk::DescriptorBindingFlags kArrayFlags{
+    vk::DescriptorBindingFlagBits::ePartiallyBound
+    | vk::DescriptorBindingFlagBits::eUpdateAfterBind
+    | vk::DescriptorBindingFlagBits::eUpdateUnusedWhilePending
+  };
+  const vk::DescriptorSetLayoutBindingFlagsCreateInfo array_flags_info{
+    .bindingCount = 1U,
+    .pBindingFlags = &kArrayFlags
+  };
+  for (std::size_t i{ 0U }; i < kSetCount; ++i) {
+    const auto set{ static_cast<BindlessSet>(i) };
+    vk::DescriptorSetLayoutBinding binding{
+      .binding = 0U,
+      .descriptorType = GetDescriptorType(set),
+      .stageFlags = vk::ShaderStageFlagBits::eAllGraphics
+                    | vk::ShaderStageFlagBits::eCompute
+    };
+    vk::DescriptorSetLayoutCreateInfo create_info{
+      .bindingCount = 1U,
+      .pBindings = &binding
+    };
+
+    // Samplers never change, so they are baked into their layout
+    std::array<vk::Sampler, static_cast<std::size_t>(BindlessSampler::Count)>
+      immutable_samplers{};
+    if (set == BindlessSet::Samplers) {
+      std::ranges::transform(samplers_, immutable_samplers.begin(),
+                             [](const vk::UniqueSampler& sampler) {
+                               return *sampler;
+                             });
+      binding.descriptorCount =
+        static_cast<std::uint32_t>(immutable_samplers.size());
+      binding.pImmutableSamplers = immutable_samplers.data();
+    } else {
+      binding.descriptorCount = set == BindlessSet::StorageBuffers
+                                  ? array_sizes_.buffers
+                                  : array_sizes_.textures;
+      create_info.pNext = &array_flags_info;
+      create_info.flags =
+        vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool;
+    }
+    set_layouts_[i] = device_.createDescriptorSetLayoutUnique(create_info);
+    raw_set_layouts_[i] = *set_layouts_[i];
+  }
+
+  // Allocate one set of each layout
+  const std::array pool_sizes{
+    vk::DescriptorPoolSize{
+      .type = vk::DescriptorType::eSampledImage,
+      .descriptorCount = array_sizes_.textures
+    },
+    vk::DescriptorPoolSize{
+      .type = vk::DescriptorType::eStorageImage,
+      .descriptorCount = array_sizes_.textures
+    },
+    vk::DescriptorPoolSize{
+      .type = vk::DescriptorType::eStorageBuffer,
+      .descriptorCount = array_sizes_.buffers
+    },
+    vk::DescriptorPoolSize{
+      .type = vk::DescriptorType::eSampler,
+      .descriptorCount = static_cast<std::uint32_t>(samplers_.size())
+    }
+  };
+  pool_ = device_.createDescriptorPoolUnique(vk::DescriptorPoolCreateInfo{
+    .flags = vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind,
+    .maxSets = static_cast<std::uint32_t>(kSetCount),
+    .poolSizeCount = static_cast<std::uint32_t>(pool_sizes.size()),
+    .pPoolSizes = pool_sizes.data()
+  });
+  const std::vector<vk::DescriptorSet> sets{
+    device_.allocateDescriptorSets(vk::DescriptorSetAllocateInfo{
+      .descriptorPool = *pool_,
+      .descriptorSetCount = static_cast<std::uint32_t>(kSetCount),
+      .pSetLayouts = raw_set_layouts_.data()
+    })
+  };
+  std::ranges::copy(sets, sets_.begin());
+
+  MAPLE_LOG_INFO(LogRHI, "Bindless heap created ({} texture slot(s) per "
+                         "array, {} buffer slot(s))",
+                 array_sizes_.textures, array_sizes_.buffers);
+}
+
+std::uint32_t VulkanDescriptorHeap::AddSampledImage(vk::ImageView view) {
+  const vk::DescriptorImageInfo image_info{
+    .imageView = view,
+    .imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal
+  };
+  return AddDescriptor(BindlessSet::SampledTextures, vk::WriteDescriptorSet{
+    .descriptorType = vk::DescriptorType::eSampledImage,
+    .pImageInfo = &image_info
+  });
+}
+
+std::uint32_t VulkanDescriptorHeap::AddStorageImage(vk::ImageView view) {
+  const vk::DescriptorImageInfo image_info{
+    .imageView = view,
+    .imageLayout = vk::ImageLayout::eGeneral
+  };
+  return AddDescriptor(BindlessSet::StorageTextures, vk::WriteDescriptorSet{
+    .descriptorType = vk::DescriptorType::eStorageImage,
+    .pImageInfo = &image_info
+  });
+}
+
+std::uint32_t VulkanDescriptorHeap::AddStorageBuffer(vk::Buffer buffer) {
+  const vk::DescriptorBufferInfo buffer_info{
+    .buffer = buffer,
+    .offset = 0U,
+    .range = vk::WholeSize
+  };
+  return AddDescriptor(BindlessSet::StorageBuffers, vk::WriteDescriptorSet{
+    .descriptorType = vk::DescriptorType::eStorageBuffer,
+    .pBufferInfo = &buffer_info
+  });
+}
+
+void VulkanDescriptorHeap::Remove(BindlessSet set, std::uint32_t index) {
+  if (set == BindlessSet::Samplers) {
+    return;
+  }
+
+  std::lock_guard lock{ mutex_ };
+  GetSlots(set).Free(index);
+}
+
+void VulkanDescriptorHeap::Bind(vk::CommandBuffer command_buffer,
+                                vk::PipelineLayout layout,
+                                bool graphics) const {
+  if (graphics) {
+    command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, layout,
+                                      0U, sets_, nullptr);
+  }
+  command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, layout,
+                                    0U, sets_, nullptr);
+}
+
+std::span<const vk::DescriptorSetLayout>
+VulkanDescriptorHeap::GetSetLayouts() const noexcept {
+  return raw_set_layouts_;
+}
+
+std::uint32_t VulkanDescriptorHeap::GetTextureSlotCount() const {
+  std::lock_guard lock{ mutex_ };
+  return sampled_image_slots_.GetUsedCount()
+         + storage_image_slots_.GetUsedCount();
+}
+
+std::uint32_t VulkanDescriptorHeap::GetBufferSlotCount() const {
+  std::lock_guard lock{ mutex_ };
+  return storage_buffer_slots_.GetUsedCount();
+}
+
+VulkanDescriptorHeap::ArraySizes VulkanDescriptorHeap::ClampArraySizes(
+  vk::PhysicalDevice physical_device,
+  std::uint32_t max_textures,
+  std::uint32_t max_buffers
+) {
+  const auto properties{
+    physical_device.getProperties2<vk::PhysicalDeviceProperties2,
+                                   vk::PhysicalDeviceVulkan12Properties>()
+  };
+  const auto& properties12{
+    properties.get<vk::PhysicalDeviceVulkan12Properties>()
+  };
+
+  // Every array is visible to every stage, so both the per-set and the
+  // per-stage limits apply
+  const ArraySizes sizes{
+    .textures = std::min({
+      max_textures,
+      properties12.maxDescriptorSetUpdateAfterBindSampledImages,
+      properties12.maxPerStageDescriptorUpdateAfterBindSampledImages,
+      properties12.maxDescriptorSetUpdateAfterBindStorageImages,
+      properties12.maxPerStageDescriptorUpdateAfterBindStorageImages
+    }),
+    .buffers = std::min({
+      max_buffers,
+      properties12.maxDescriptorSetUpdateAfterBindStorageBuffers,
+      properties12.maxPerStageDescriptorUpdateAfterBindStorageBuffers
+    })
+  };
+  if (sizes.textures < max_textures || sizes.buffers < max_buffers) {
+    MAPLE_LOG_WARN(LogRHI, "Bindless heap clamped to the device's limits");
+  }
+  return sizes;
+}
+
+std::uint32_t VulkanDescriptorHeap::AddDescriptor(
+  BindlessSet set,
+  vk::WriteDescriptorSet write
+) {
+  // Writes to a set must be externally synchronized, so they share the lock
+  // with the slot allocators
+  std::lock_guard lock{ mutex_ };
+  const std::uint32_t index{ GetSlots(set).Allocate() };
+  if (index == kInvalidBindlessIndex) {
+    return kInvalidBindlessIndex;
+  }
+
+  write.dstSet = sets_[static_cast<std::size_t>(set)];
+  write.dstBinding = 0U;
+  write.dstArrayElement = index;
+  write.descriptorCount = 1U;
+  device_.updateDescriptorSets(write, nullptr);
+  return index;
+}
+
+BindlessSlotAllocator& VulkanDescriptorHeap::GetSlots(BindlessSet set) noexcept {
+  switch (set) {
+    case BindlessSet::StorageTextures: {
+      return storage_image_slots_;
+    }
+
+    case BindlessSet::StorageBuffers: {
+      return storage_buffer_slots_;
+    }
+
+    default: { return sampled_image_slots_; }
+  }
+}
+
+} // namespace maple::rhi
@@ -0,0 +1,191 @@
+#pragma once
+
+// STL
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+
+// Vulkan
+#include "Vulkan/vulkan.hpp"
+
+// RHI
+#include "RHI/BindlessSlotAllocator.h"
+#include "RHI/RHIBindless.h"
+
+namespace maple::rhi {
+
+/**
+ * @brief Bindless descriptor heap: one large descriptor set per resource
+ *        type, bound once per command buffer for every pipeline.
+ *
+ * Each set holds a single partially bound, update-after-bind array, so
+ * descriptors are written when resources are created, even while frames
+ * that use the sets are recorded or in flight, and draws select resources
+ * by index instead of binding descriptor sets. Slots of destroyed resources
+ * must only be removed once the GPU has finished every frame that could
+ * read them; removal does not touch the descriptor, which partially bound
+ * arrays allow while no shader reads it.
+ *
+ * @note May be used from any thread.
+ */
+class VulkanDescriptorHeap {
+public:
+  VulkanDescriptorHeap() = delete;
+  VulkanDescriptorHeap(const VulkanDescriptorHeap&) = delete;
+  VulkanDescriptorHeap& operator=(const VulkanDescriptorHeap&) = delete;
+  VulkanDescriptorHeap(VulkanDescriptorHeap&&) = delete;
+  VulkanDescriptorHeap& operator=(VulkanDescriptorHeap&&) = delete;
+
+  /**
+   * @brief Create the set layouts, the samplers, and the sets.
+   *
+   * @param physical_device Device whose limits bound the array sizes
+   * @param device Logical device (created with the descriptor indexing
+   *               features the arrays rely on)
+   * @param max_textures Requested slots of each texture array
+   * @param max_buffers Requested slots of the storage buffer array
+   */
+  VulkanDescriptorHeap(vk::PhysicalDevice physical_device, vk::Device device,
+                       std::uint32_t max_textures, std::uint32_t max_buffers);
+
+  /**
+   * @brief Write a sampled image into a free slot.
+   *
+   * @param view View read in ShaderReadOnlyOptimal layout
+   * @return Index of the slot, or kInvalidBindlessIndex if the array is full
+   */
+  [[nodiscard]] std::uint32_t AddSampledImage(vk::ImageView view);
+
+  /**
+   * @brief Write a storage image into a free slot.
+   *
+   * @param view View accessed in General layout
+   * @return Index of the slot, or kInvalidBindlessIndex if the array is full
+   */
+  [[nodiscard]] std::uint32_t AddStorageImage(vk::ImageView view);
+
+  /**
+   * @brief Write a whole storage buffer into a free slot.
+   *
+   * @param buffer Buffer created with eStorageBuffer usage
+   * @return Index of the slot, or kInvalidBindlessIndex if the array is full
+   */
+  [[nodiscard]] std::uint32_t AddStorageBuffer(vk::Buffer buffer);
+
+  /**
+   * @brief Free a slot for reuse; kInvalidBindlessIndex is ignored.
+   *
+   * @param set Array the slot belongs to (not BindlessSet::Samplers)
+   * @param index Index returned when the resource was added
+   */
+  void Remove(BindlessSet set, std::uint32_t index);
+
+  /**
+   * @brief Bind every set to the graphics and compute bind points.
+   *
+   * @param command_buffer Command buffer being recorded
+   * @param layout Pipeline layout created with GetSetLayouts()
+   * @param graphics Whether the command buffer's queue supports graphics
+   *                 (otherwise only the compute bind point is bound)
+   */
+  void Bind(vk::CommandBuffer command_buffer, vk::PipelineLayout layout,
+            bool graphics) const;
+
+  /**
+   * @brief Get the set layouts in BindlessSet order, for pipeline layouts.
+   */
+  [[nodiscard]] std::span<const vk::DescriptorSetLayout> GetSetLayouts()
+    const noexcept;
+
+  /**
+   * @brief Get the number of texture slots in use, sampled and storage
+   *        combined.
+   */
+  [[nodiscard]] std::uint32_t GetTextureSlotCount() const;
+
+  /**
+   * @brief Get the number of storage buffer slots in use.
+   */
+  [[nodiscard]] std::uint32_t GetBufferSlotCount() const;
+
+private:
+  /**
+   * @brief Slots of each array.
+   */
+  struct ArraySizes {
+    /// Slots of each texture array
+    std::uint32_t textures{ 0U };
+
+    /// Slots of the storage buffer array
+    std::uint32_t buffers{ 0U };
+  };
+
+  /**
+   * @brief Clamp requested array sizes to the device's update-after-bind
+   *        limits.
+   */
+  [[nodiscard]] static ArraySizes ClampArraySizes(
+    vk::PhysicalDevice physical_device,
+    std::uint32_t max_textures,
+    std::uint32_t max_buffers
+  );
+
+  /**
+   * @brief Take a slot of an array and write a descriptor into it.
+   *
+   * @param set Array to write into
+   * @param write Descriptor to write; the set and array element are filled
+   *              in
+   * @return Index of the slot, or kInvalidBindlessIndex if the array is full
+   */
+  [[nodiscard]] std::uint32_t AddDescriptor(BindlessSet set,
+                                            vk::WriteDescriptorSet write);
+
+  /**
+   * @brief Get the slot allocator of an array.
+   */
+  [[nodiscard]] BindlessSlotAllocator& GetSlots(BindlessSet set) noexcept;
+
+  /// Number of descriptor sets in the heap
+  static constexpr std::size_t kSetCount{
+    static_cast<std::size_t>(BindlessSet::Samplers) + 1U
+  };
+
+  /// Logical device
+  vk::Device device_;
+
+  /// Slots of each array
+  ArraySizes array_sizes_;
+
+  /// Samplers of the sampler array, indexed by BindlessSampler
+  std::array<vk::UniqueSampler,
+             static_cast<std::size_t>(BindlessSampler::Count)> samplers_{};
+
+  /// Layouts of the sets, indexed by BindlessSet
+  std::array<vk::UniqueDescriptorSetLayout, kSetCount> set_layouts_{};
+
+  /// Raw copies of set_layouts_, for pipeline layout creation
+  std::array<vk::DescriptorSetLayout, kSetCount> raw_set_layouts_{};
+
+  /// Pool the sets are allocated from (update-after-bind)
+  vk::UniqueDescriptorPool pool_{ nullptr };
+
+  /// Sets, indexed by BindlessSet (freed with the pool)
+  std::array<vk::DescriptorSet, kSetCount> sets_{};
+
+  /// Guards the slot allocators and descriptor writes
+  mutable std::mutex mutex_{};
+
+  /// Slots of the sampled texture array
+  BindlessSlotAllocator sampled_image_slots_;
+
+  /// Slots of the storage texture array
+  BindlessSlotAllocator storage_image_slots_;
+
+  /// Slots of the storage buffer array
+  BindlessSlotAllocator storage_buffer_slots_;
+};
+
+} // namespace maple::rhi
@@ -0,0 +1,164 @@
+#include "RHI/Vulkan/VulkanGpuTimer.h"
+
+// STL
+#include <algorithm>
+
+// RHI
+#include "RHI/RHILog.h"
+
+namespace maple::rhi {
+
+VulkanGpuTimer::VulkanGpuTimer(
+  vk::Device device,
+  float timestamp_period,
+  std::array<std::uint32_t, kQueueTypeCount> timestamp_bits,
+  std::size_t frame_count,
+  std::uint32_t max_zones
+)
+  : device_{ device }
+  , timestamp_period_{ static_cast<double>(timestamp_period) }
+  , max_zones_{ max_zones }
+  , frames_(frame_count) {
+  for (std::size_t i{ 0U }; i < kQueueTypeCount; ++i) {
+    timestamp_masks_[i] = timestamp_bits[i] >= 64U
+                            ? std::numeric_limits<std::uint64_t>::max()
+                            : (std::uint64_t{ 1U } << timestamp_bits[i]) - 1U;
+  }
+
+  // Queries must be reset before their first use
+  for (FrameQueries& frame : frames_) {
+    frame.pool = device_.createQueryPoolUnique(vk::QueryPoolCreateInfo{
+      .queryType = vk::QueryType::eTimestamp,
+      .queryCount = 2U * max_zones_
+    });
+    device_.resetQueryPool(*frame.pool, 0U, 2U * max_zones_);
+    frame.zones.resize(max_zones_);
+  }
+  results_.resize(4U * std::size_t{ max_zones_ });
+}
+
+std::uint32_t VulkanGpuTimer::BeginZone(vk::CommandBuffer command_buffer,
+                                        std::size_t frame,
+                                        QueueType queue,
+                                        const char* name) {
+  if (timestamp_masks_[static_cast<std::size_t>(queue)] == 0U) {
+    return kNoZone;
+  }
+
+  FrameQueries& queries{ frames_[frame] };
+  const std::uint32_t zone{
+    queries.zone_count.fetch_add(1U, std::memory_order_relaxed)
+  };
+  if (zone >= max_zones_) {
+    dropped_zones_.fetch_add(1U, std::memory_order_relaxed);
+    return kNoZone;
+  }
+
+  // Resolve() reads the zone once the frame was submitted, which orders it
+  // after this write
+  queries.zones[zone] = ZoneInfo{ .name = name, .queue = queue };
+  command_buffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe,
+                                *queries.pool, 2U * zone);
+  return zone;
+}
+
+void VulkanGpuTimer::EndZone(vk::CommandBuffer command_buffer,
+                             std::size_t frame,
+                             std::uint32_t zone) const {
+  if (zone != kNoZone) {
+    command_buffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe,
+                                  *frames_[frame].pool, 2U * zone + 1U);
+  }
+}
+
+void VulkanGpuTimer::Submit(std::size_t frame, std::int64_t submit_ns) noexcept {
+  frames_[frame].submit_ns = submit_ns;
+  frames_[frame].pending = true;
+}
+
+void VulkanGpuTimer::Resolve(std::size_t frame) {
+  FrameQueries& queries{ frames_[frame] };
+  if (!queries.pending) {
+    return;
+  }
+  queries.pending = false;
+  const std::uint32_t zone_count{ std::min(
+    queries.zone_count.exchange(0U, std::memory_order_relaxed), max_zones_
+  ) };
+  if (zone_count == 0U) {
+    return;
+  }
+
+  // The frame has finished, so this never waits; zones whose timestamps
+  // were not both written (e.g., by a list that was never submitted) are
+  // reported unavailable and skipped
+  const std::uint32_t query_count{ 2U * zone_count };
+  const vk::Result result{ device_.getQueryPoolResults(
+    *queries.pool, 0U, query_count,
+    std::size_t{ query_count } * 2U * sizeof(std::uint64_t), results_.data(),
+    2U * sizeof(std::uint64_t),
+    vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability
+  ) };
+  device_.resetQueryPool(*queries.pool, 0U, query_count);
+  if (result != vk::Result::eSuccess && result != vk::Result::eNotReady) {
+    MAPLE_LOG_WARN(LogRHI, "Failed to read GPU timestamps: {}",
+                           vk::to_string(result));
+    return;
+  }
+
+  // Convert to nanoseconds on the GPU clock; the earliest timestamp bounds
+  // the clock offset
+  const std::size_t first_zone{ resolved_zones_.size() };
+  std::int64_t first_ns{ std::numeric_limits<std::int64_t>::max() };
+  for (std::uint32_t zone{ 0U }; zone < zone_count; ++zone) {
+    const std::uint64_t* begin{ &results_[4U * std::size_t{ zone }] };
+    const std::uint64_t* end{ begin + 2U };
+    if (begin[1] == 0U || end[1] == 0U) {
+      continue;
+    }
+
+    const ZoneInfo& info{ queries.zones[zone] };
+    const std::uint64_t mask{
+      timestamp_masks_[static_cast<std::size_t>(info.queue)]
+    };
+    const std::uint64_t begin_ticks{ begin[0] & mask };
+    const std::uint64_t end_ticks{ end[0] & mask };
+    if (end_ticks < begin_ticks) {
+      continue;
+    }
+    const auto to_ns{ [this](std::uint64_t ticks) {
+      return static_cast<std::int64_t>(static_cast<double>(ticks)
+                                       * timestamp_period_);
+    } };
+    resolved_zones_.emplace_back(GpuZone{
+      .name = info.name,
+      .queue = info.queue,
+      .start_ns = to_ns(begin_ticks),
+      .end_ns = to_ns(end_ticks)
+    });
+    first_ns = std::min(first_ns, resolved_zones_.back().start_ns);
+  }
+  if (first_zone == resolved_zones_.size()) {
+    return;
+  }
+
+  clock_offset_ns_ = std::max(clock_offset_ns_, queries.submit_ns - first_ns);
+  for (std::size_t i{ first_zone }; i < resolved_zones_.size(); ++i) {
+    resolved_zones_[i].start_ns += clock_offset_ns_;
+    resolved_zones_[i].end_ns += clock_offset_ns_;
+  }
+}
+
+void VulkanGpuTimer::ClearResolvedZones() noexcept {
+  resolved_zones_.clear();
+}
+
+std::span<const GpuZone> VulkanGpuTimer::GetResolvedZones() const noexcept {
+  return resolved_zones_;
+}
+
+std::uint64_t VulkanGpuTimer::GetDroppedZoneCount() const noexcept {
+  return dropped_zones_.load(std::memory_order_relaxed);
+}
+
+} // namespace maple::rhi
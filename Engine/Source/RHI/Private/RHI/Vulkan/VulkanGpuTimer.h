@@ -0,0 +1,189 @@
+#pragma once
+
+// STL
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+// Vulkan
+#include "Vulkan/vulkan.hpp"
+
+// RHI
+#include "RHI/RHIStats.h"
+
+namespace maple::rhi {
+
+/**
+ * @brief Times zones of GPU work with timestamp queries.
+ *
+ * Each frame in flight owns a query pool holding a pair of timestamps per
+ * zone. Once the GPU has finished a frame, its timestamps are read without
+ * waiting, converted to the CPU profiler clock, and the pool is reset from
+ * the host, so that lists of any queue may write it in the next use of the
+ * frame slot.
+ *
+ * GPU and CPU clocks are aligned through submissions: a frame's work cannot
+ * start before it was submitted, so each frame bounds the offset between
+ * the clocks from below, and the largest bound seen is used.
+ *
+ * @note BeginZone() and EndZone() may be called from any thread; the other
+ *       functions belong to the render thread.
+ */
+class VulkanGpuTimer {
+public:
+  VulkanGpuTimer() = delete;
+  VulkanGpuTimer(const VulkanGpuTimer&) = delete;
+  VulkanGpuTimer& operator=(const VulkanGpuTimer&) = delete;
+  VulkanGpuTimer(VulkanGpuTimer&&) = delete;
+  VulkanGpuTimer& operator=(VulkanGpuTimer&&) = delete;
+
+  /// Number of QueueType values
+  static constexpr std::size_t kQueueTypeCount{ 2U };
+
+  /// Index meaning "zone not timed"
+  static constexpr std::uint32_t kNoZone{
+    std::numeric_limits<std::uint32_t>::max()
+  };
+
+  /**
+   * @brief Create and reset a query pool per frame in flight.
+   *
+   * @param device Logical device (created with the hostQueryReset feature)
+   * @param timestamp_period Nanoseconds per timestamp tick
+   * @param timestamp_bits timestampValidBits of the queue family each
+   *                       QueueType is submitted to (0 where unsupported)
+   * @param frame_count Frames in flight
+   * @param max_zones Zones timed per frame
+   */
+  VulkanGpuTimer(vk::Device device,
+                 float timestamp_period,
+                 std::array<std::uint32_t, kQueueTypeCount> timestamp_bits,
+                 std::size_t frame_count,
+                 std::uint32_t max_zones);
+
+  /**
+   * @brief Begin a zone by writing its first timestamp.
+   *
+   * @param command_buffer Command buffer being recorded
+   * @param frame Index of the frame slot being recorded
+   * @param queue Queue the command buffer is submitted to
+   * @param name Zone name (string literal)
+   * @return Index of the zone, or kNoZone if the queue has no timestamps or
+   *         the frame's pool is full
+   */
+  [[nodiscard]] std::uint32_t BeginZone(vk::CommandBuffer command_buffer,
+                                        std::size_t frame,
+                                        QueueType queue,
+                                        const char* name);
+
+  /**
+   * @brief End a zone by writing its second timestamp.
+   *
+   * @param command_buffer Command buffer being recorded (the one the zone
+   *                       began in, or one submitted after it on its queue)
+   * @param frame Index of the frame slot being recorded
+   * @param zone Index returned by BeginZone(); kNoZone is ignored
+   */
+  void EndZone(vk::CommandBuffer command_buffer, std::size_t frame,
+               std::uint32_t zone) const;
+
+  /**
+   * @brief Note that a frame slot's work is being submitted.
+   *
+   * @param frame Index of the frame slot
+   * @param submit_ns Submission time on the core::Profiler::Now() clock
+   */
+  void Submit(std::size_t frame, std::int64_t submit_ns) noexcept;
+
+  /**
+   * @brief Read the zones of a submitted frame slot and reset its pool.
+   *
+   * The GPU must have finished the slot's work; slots without submitted
+   * work are skipped.
+   *
+   * @param frame Index of the frame slot
+   */
+  void Resolve(std::size_t frame);
+
+  /**
+   * @brief Forget the zones resolved so far.
+   */
+  void ClearResolvedZones() noexcept;
+
+  /**
+   * @brief Get the zones resolved since ClearResolvedZones().
+   */
+  [[nodiscard]] std::span<const GpuZone> GetResolvedZones() const noexcept;
+
+  /**
+   * @brief Get the number of zones not timed because a pool was full.
+   */
+  [[nodiscard]] std::uint64_t GetDroppedZoneCount() const noexcept;
+
+private:
+  /**
+   * @brief Zone begun in a frame.
+   */
+  struct ZoneInfo {
+    /// Zone name (string literal)
+    const char* name{ "" };
+
+    /// Queue the zone runs on
+    QueueType queue{ QueueType::Graphics };
+  };
+
+  /**
+   * @brief Queries of one frame slot.
+   */
+  struct FrameQueries {
+    /// Pool of two timestamps per zone
+    vk::UniqueQueryPool pool{ nullptr };
+
+    /// Zones begun in the slot, including dropped ones
+    std::atomic<std::uint32_t> zone_count{ 0U };
+
+    /// Zones begun in the slot, indexed by zone
+    std::vector<ZoneInfo> zones{};
+
+    /// Submission time of the slot's work
+    std::int64_t submit_ns{ 0 };
+
+    /// Whether the slot's work was submitted and not yet resolved
+    bool pending{ false };
+  };
+
+  /// Logical device
+  vk::Device device_;
+
+  /// Nanoseconds per timestamp tick
+  double timestamp_period_;
+
+  /// Mask of the valid timestamp bits per QueueType (0 where unsupported)
+  std::array<std::uint64_t, kQueueTypeCount> timestamp_masks_{};
+
+  /// Zones timed per frame
+  std::uint32_t max_zones_;
+
+  /// Queries of each frame slot
+  std::vector<FrameQueries> frames_;
+
+  /// Scratch array of query results, two 64-bit words (value and
+  /// availability) per query
+  std::vector<std::uint64_t> results_{};
+
+  /// Zones resolved since ClearResolvedZones()
+  std::vector<GpuZone> resolved_zones_{};
+
+  /// Profiler clock minus GPU clock, in nanoseconds (largest lower bound
+  /// seen so far)
+  std::int64_t clock_offset_ns_{ std::numeric_limits<std::int64_t>::min() };
+
+  /// Zones not timed because a pool was full
+  std::atomic<std::uint64_t> dropped_zones_{ 0U };
+};
+
+} // namespace maple::rhi
@@ -0,0 +1,611 @@
+#include "RHI/Vulkan/VulkanMemoryAllocator.h"
+
+// STL
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <stdexcept>
+#include <string>
+
+// RHI
+#include "RHI/RHILog.h"
+
+namespace maple::rhi {
+
+namespace {
+
+/// Bytes per mebibyte, for log messages
+constexpr vk::DeviceSize kMiB{ 1024U * 1024U };
+
+/**
+ * @brief Get the memory properties a resource needs and the ones it prefers.
+ *
+ * @param memory_usage Which processor accesses the resource's memory
+ * @return Required and preferred properties
+ */
+std::pair<vk::MemoryPropertyFlags, vk::MemoryPropertyFlags> GetMemoryFlags(
+  MemoryUsage memory_usage
+) noexcept {
+  using enum vk::MemoryPropertyFlagBits;
+  switch (memory_usage) {
+    case MemoryUsage::GpuOnly: {
+      return { vk::MemoryPropertyFlags{}, eDeviceLocal };
+    }
+
+    case MemoryUsage::CpuToGpu: {
+      return { eHostVisible | eHostCoherent, vk::MemoryPropertyFlags{} };
+    }
+
+    case MemoryUsage::GpuToCpu: {
+      return { eHostVisible | eHostCoherent, eHostCached };
+    }
+
+    default: { return {}; }
+  }
+}
+
+} // namespace
+
+VulkanMemoryAllocator::VulkanMemoryAllocator(vk::PhysicalDevice physical_device,
+                                             vk::Device device,
+                                             bool memory_budget_enabled,
+                                             vk::DeviceSize budget_limit)
+  : physical_device_{ physical_device }
+  , device_{ device }
+  , memory_budget_enabled_{ memory_budget_enabled }
+  , budget_limit_{ budget_limit }
+  , memory_properties_{ physical_device.getMemoryProperties() }
+  , max_allocation_count_{
+      physical_device.getProperties().limits.maxMemoryAllocationCount
+    } {
+  // One pool of each kind per memory type; blocks are created on demand
+  pools_.resize(memory_properties_.memoryTypeCount * kPoolKindCount);
+  for (std::uint32_t i{ 0U }; i < pools_.size(); ++i) {
+    pools_[i].memory_type = i / kPoolKindCount;
+    pools_[i].kind = static_cast<PoolKind>(i % kPoolKindCount);
+  }
+
+  UpdateBudget();
+  MAPLE_LOG_INFO(LogRHI, "GPU memory allocator created ({} memory type(s), "
+                         "heap budgets {})",
+                         memory_properties_.memoryTypeCount,
+                         memory_budget_enabled_ ? "reported by the driver"
+                                                : "estimated");
+}
+
+VulkanMemoryAllocator::~VulkanMemoryAllocator() {
+  for (const Pool& pool : pools_) {
+    for (const auto& block : pool.blocks) {
+      device_.freeMemory(block->memory);
+    }
+  }
+}
+
+VulkanAllocation VulkanMemoryAllocator::AllocateBuffer(
+  vk::Buffer buffer,
+  MemoryUsage memory_usage,
+  bool transient
+) {
+  const auto chain{
+    device_.getBufferMemoryRequirements2<vk::MemoryRequirements2,
+                                         vk::MemoryDedicatedRequirements>(
+      vk::BufferMemoryRequirementsInfo2{ .buffer = buffer }
+    )
+  };
+  const auto& dedicated{ chain.get<vk::MemoryDedicatedRequirements>() };
+  const Requirements requirements{
+    .memory = chain.get<vk::MemoryRequirements2>().memoryRequirements,
+    .dedicated = dedicated.requiresDedicatedAllocation == vk::True
+                 || dedicated.prefersDedicatedAllocation == vk::True
+  };
+
+  const VulkanAllocation allocation{
+    Allocate(requirements, memory_usage,
+             transient ? PoolKind::TransientBuffer : PoolKind::Buffer,
+             vk::MemoryDedicatedAllocateInfo{ .buffer = buffer })
+  };
+  try {
+    device_.bindBufferMemory(buffer, allocation.memory, allocation.offset);
+  } catch (...) {
+    Free(allocation);
+    throw;
+  }
+  return allocation;
+}
+
+VulkanAllocation VulkanMemoryAllocator::AllocateImage(vk::Image image) {
+  const auto chain{
+    device_.getImageMemoryRequirements2<vk::MemoryRequirements2,
+                                        vk::MemoryDedicatedRequirements>(
+      vk::ImageMemoryRequirementsInfo2{ .image = image }
+    )
+  };
+  const auto& dedicated{ chain.get<vk::MemoryDedicatedRequirements>() };
+  const Requirements requirements{
+    .memory = chain.get<vk::MemoryRequirements2>().memoryRequirements,
+    .dedicated = dedicated.requiresDedicatedAllocation == vk::True
+                 || dedicated.prefersDedicatedAllocation == vk::True
+  };
+
+  const VulkanAllocation allocation{
+    Allocate(requirements, MemoryUsage::GpuOnly, PoolKind::Image,
+             vk::MemoryDedicatedAllocateInfo{ .image = image })
+  };
+  try {
+    device_.bindImageMemory(image, allocation.memory, allocation.offset);
+  } catch (...) {
+    Free(allocation);
+    throw;
+  }
+  return allocation;
+}
+
+VulkanAllocation VulkanMemoryAllocator::AllocateAliasable(
+  const vk::MemoryRequirements& requirements
+) {
+  // Dedicated, so the range is never shared with unrelated resources; the
+  // dedicated info names no resource, which leaves the memory unrestricted
+  return Allocate(Requirements{ .memory = requirements, .dedicated = true },
+                  MemoryUsage::GpuOnly, PoolKind::Image,
+                  vk::MemoryDedicatedAllocateInfo{});
+}
+
+std::uint32_t VulkanMemoryAllocator::GetMemoryType(
+  const VulkanAllocation& allocation
+) noexcept {
+  return allocation.pool_index / kPoolKindCount;
+}
+
+void VulkanMemoryAllocator::Free(const VulkanAllocation& allocation) {
+  if (!allocation.memory) {
+    return;
+  }
+
+  std::lock_guard lock{ mutex_ };
+  const std::uint32_t memory_type{ GetMemoryType(allocation) };
+  if (allocation.dedicated) {
+    FreeDeviceMemory(memory_type, allocation.memory, allocation.size);
+    --dedicated_count_;
+    dedicated_bytes_ -= allocation.size;
+    return;
+  }
+
+  Pool& pool{ pools_[allocation.pool_index] };
+  const auto it{ std::ranges::find_if(pool.blocks, [&](const auto& block) {
+    return block->id == allocation.block_id;
+  }) };
+  if (it == pool.blocks.end()) {
+    MAPLE_LOG_ERROR(LogRHI, "Freed GPU memory from unknown block {}",
+                            allocation.block_id);
+    return;
+  }
+
+  Block& block{ **it };
+  if (auto* buddy{ std::get_if<BuddySubAllocator>(&block.allocator) }) {
+    buddy->Free(allocation.offset);
+  } else {
+    std::get<LinearSubAllocator>(block.allocator).Free(allocation.size);
+  }
+
+  // Release empty blocks, but keep the pool's last one so that a steady
+  // stream of allocations does not allocate and free device memory
+  const bool empty{ std::visit([](const auto& allocator) {
+    return allocator.IsEmpty();
+  }, block.allocator) };
+  if (empty && pool.blocks.size() > 1U) {
+    const vk::DeviceSize block_size{ std::visit([](const auto& allocator) {
+      return allocator.GetSize();
+    }, block.allocator) };
+    FreeDeviceMemory(memory_type, block.memory, block_size);
+    pool.blocks.erase(it);
+  }
+}
+
+bool VulkanMemoryAllocator::BeginDefragmentation() {
+  std::lock_guard lock{ mutex_ };
+
+  // Empty the blocks of each buffer pool that are less than half used into
+  // the rest; the fullest block is never a source, so there is always
+  // somewhere to move to
+  bool marked{ false };
+  for (Pool& pool : pools_) {
+    if (pool.kind != PoolKind::Buffer || pool.blocks.size() < 2U) {
+      continue;
+    }
+
+    const auto used_bytes{ [](const auto& block) {
+      return std::get<BuddySubAllocator>(block->allocator).GetUsedBytes();
+    } };
+    const auto fullest{ std::ranges::max_element(pool.blocks, {}, used_bytes) };
+    for (const auto& block : pool.blocks) {
+      const auto& buddy{ std::get<BuddySubAllocator>(block->allocator) };
+      if (block != *fullest && buddy.GetUsedBytes() < buddy.GetSize() / 2U) {
+        block->defragmentation_source = true;
+        marked = true;
+      }
+    }
+  }
+
+  return marked;
+}
+
+bool VulkanMemoryAllocator::IsDefragmentationSource(
+  const VulkanAllocation& allocation
+) const {
+  if (!allocation.memory || allocation.dedicated) {
+    return false;
+  }
+
+  std::lock_guard lock{ mutex_ };
+  const Pool& pool{ pools_[allocation.pool_index] };
+  const auto it{ std::ranges::find_if(pool.blocks, [&](const auto& block) {
+    return block->id == allocation.block_id;
+  }) };
+  return it != pool.blocks.end() && (*it)->defragmentation_source;
+}
+
+std::optional<VulkanAllocation> VulkanMemoryAllocator::AllocateRelocation(
+  vk::Buffer buffer,
+  const VulkanAllocation& source
+) {
+  const vk::MemoryRequirements requirements{
+    device_.getBufferMemoryRequirements(buffer)
+  };
+
+  std::optional<VulkanAllocation> allocation{};
+  {
+    std::lock_guard lock{ mutex_ };
+    allocation = AllocateFromPool(source.pool_index, requirements, false);
+  }
+  if (allocation) {
+    try {
+      device_.bindBufferMemory(buffer, allocation->memory, allocation->offset);
+    } catch (...) {
+      Free(*allocation);
+      throw;
+    }
+  }
+  return allocation;
+}
+
+void VulkanMemoryAllocator::EndDefragmentation(std::uint64_t moved_bytes) {
+  std::lock_guard lock{ mutex_ };
+  for (Pool& pool : pools_) {
+    for (const auto& block : pool.blocks) {
+      block->defragmentation_source = false;
+    }
+  }
+  defragmented_bytes_ += moved_bytes;
+}
+
+void VulkanMemoryAllocator::GetStats(RHIMemoryStats& stats) const {
+  std::lock_guard lock{ mutex_ };
+  for (const Pool& pool : pools_) {
+    for (const auto& block : pool.blocks) {
+      std::visit([&](const auto& allocator) {
+        ++stats.block_count;
+        stats.block_bytes += allocator.GetSize();
+        stats.used_bytes += allocator.GetUsedBytes();
+      }, block->allocator);
+    }
+  }
+  stats.dedicated_count = dedicated_count_;
+  stats.dedicated_bytes = dedicated_bytes_;
+  stats.device_allocation_count = allocation_count_;
+  stats.defragmented_bytes = defragmented_bytes_;
+  stats.over_budget_allocations = over_budget_count_;
+  stats.budget_fallback_allocations = budget_fallback_count_;
+
+  // Budgets of the heaps that matter most: device-local ones
+  UpdateBudget();
+  for (std::uint32_t i{ 0U }; i < memory_properties_.memoryHeapCount; ++i) {
+    if (memory_properties_.memoryHeaps[i].flags
+        & vk::MemoryHeapFlagBits::eDeviceLocal) {
+      stats.budget_bytes += heap_budget_[i];
+      stats.usage_bytes += heap_usage_[i];
+    }
+  }
+}
+
+VulkanAllocation VulkanMemoryAllocator::Allocate(
+  const Requirements& requirements,
+  MemoryUsage memory_usage,
+  PoolKind kind,
+  const vk::MemoryDedicatedAllocateInfo& dedicated_info
+) {
+  std::lock_guard lock{ mutex_ };
+  std::uint32_t memory_type{
+    FindMemoryType(requirements.memory.memoryTypeBits, memory_usage)
+  };
+
+  // Large resources would leave most of a block unusable, so they own their
+  // memory, as do resources the driver can optimize when they do
+  const auto is_dedicated{ [&](std::uint32_t type) {
+    return requirements.dedicated
+           || requirements.memory.size > GetBlockSize(type) / 2U;
+  } };
+
+  // Room in an existing block of the preferred type costs no budget
+  if (!is_dedicated(memory_type)) {
+    if (auto allocation{ AllocateFromPool(GetPoolIndex(memory_type, kind),
+                                          requirements.memory, false) }) {
+      return *allocation;
+    }
+  }
+
+  // New device memory goes to another heap while the preferred one is over
+  // budget, which is slower for the GPU but does not make the driver page
+  UpdateBudget();
+  if (!HasBudget(memory_type,
+                 GetNewMemorySize(memory_type, requirements.memory,
+                                  requirements.dedicated))) {
+    if (const std::optional<std::uint32_t> fallback{
+          FindFallbackMemoryType(requirements.memory.memoryTypeBits,
+                                 memory_usage, memory_type,
+                                 requirements.memory, requirements.dedicated)
+        }) {
+      memory_type = *fallback;
+      ++budget_fallback_count_;
+    }
+  }
+  const std::uint32_t pool_index{ GetPoolIndex(memory_type, kind) };
+
+  if (is_dedicated(memory_type)) {
+    const auto [memory, mapped]{
+      AllocateDeviceMemory(memory_type, requirements.memory.size,
+                           &dedicated_info)
+    };
+    ++dedicated_count_;
+    dedicated_bytes_ += requirements.memory.size;
+    return VulkanAllocation{
+      .memory = memory,
+      .offset = 0U,
+      .size = requirements.memory.size,
+      .mapped = mapped,
+      .pool_index = pool_index,
+      .dedicated = true
+    };
+  }
+
+  return *AllocateFromPool(pool_index, requirements.memory, true);
+}
+
+std::optional<VulkanAllocation> VulkanMemoryAllocator::AllocateFromPool(
+  std::uint32_t pool_index,
+  const vk::MemoryRequirements& requirements,
+  bool allow_new_block
+) {
+  Pool& pool{ pools_[pool_index] };
+  const auto allocate{ [&](Block& block) -> std::optional<VulkanAllocation> {
+    const std::optional<std::uint64_t> offset{
+      std::visit([&](auto& allocator) {
+        return allocator.Allocate(requirements.size, requirements.alignment);
+      }, block.allocator)
+    };
+    if (!offset) {
+      return std::nullopt;
+    }
+    return VulkanAllocation{
+      .memory = block.memory,
+      .offset = *offset,
+      .size = requirements.size,
+      .mapped = block.mapped ? block.mapped + *offset : nullptr,
+      .pool_index = pool_index,
+      .block_id = block.id
+    };
+  } };
+
+  // First fit over the existing blocks, oldest first
+  for (const auto& block : pool.blocks) {
+    if (block->defragmentation_source) {
+      continue;
+    }
+    if (auto allocation{ allocate(*block) }) {
+      return allocation;
+    }
+  }
+  if (!allow_new_block) {
+    return std::nullopt;
+  }
+
+  // Grow the pool; resources are at most half a block, so they always fit
+  const vk::DeviceSize block_size{ GetBlockSize(pool.memory_type) };
+  const auto [memory, mapped]{
+    AllocateDeviceMemory(pool.memory_type, block_size, nullptr)
+  };
+  auto block{ std::make_unique<Block>(Block{
+    .memory = memory,
+    .mapped = mapped,
+    .id = next_block_id_++,
+    .allocator = pool.kind == PoolKind::TransientBuffer
+      ? decltype(Block::allocator){ LinearSubAllocator{ block_size } }
+      : decltype(Block::allocator){
+          BuddySubAllocator{ block_size, kMinAllocationSize }
+        }
+  }) };
+  const std::optional<VulkanAllocation> allocation{ allocate(*block) };
+  pool.blocks.emplace_back(std::move(block));
+  return allocation;
+}
+
+std::pair<vk::DeviceMemory, std::byte*>
+VulkanMemoryAllocator::AllocateDeviceMemory(
+  std::uint32_t memory_type,
+  vk::DeviceSize size,
+  const vk::MemoryDedicatedAllocateInfo* dedicated_info
+) {
+  if (allocation_count_ >= max_allocation_count_) {
+    const std::string msg{ std::format("GPU memory allocation limit of {} "
+                                       "reached", max_allocation_count_) };
+    MAPLE_LOG_CRITICAL(LogRHI, msg);
+    throw std::runtime_error{ msg };
+  }
+
+  // Going over budget makes the driver page memory out, which is slow but
+  // not fatal
+  const vk::MemoryType& type{ memory_properties_.memoryTypes[memory_type] };
+  UpdateBudget();
+  const bool over_budget{ !HasBudget(memory_type, size) };
+  if (over_budget) {
+    MAPLE_LOG_WARN(LogRHI, "Allocating {} MiB exceeds the budget of memory "
+                           "heap {} ({} of {} MiB used)",
+                           size / kMiB, type.heapIndex,
+                           heap_usage_[type.heapIndex] / kMiB,
+                           heap_budget_[type.heapIndex] / kMiB);
+  }
+
+  vk::DeviceMemory memory{ nullptr };
+  try {
+    memory = device_.allocateMemory(vk::MemoryAllocateInfo{
+      .pNext = dedicated_info,
+      .allocationSize = size,
+      .memoryTypeIndex = memory_type
+    });
+  } catch (const vk::SystemError& e) {
+    const std::string msg{ std::format("Failed to allocate {} MiB of GPU "
+                                       "memory: {}", size / kMiB, e.what()) };
+    MAPLE_LOG_CRITICAL(LogRHI, msg);
+    throw std::runtime_error{ msg };
+  }
+
+  // Host-visible memory stays mapped until it is freed
+  std::byte* mapped{ nullptr };
+  if (type.propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible) {
+    mapped = static_cast<std::byte*>(device_.mapMemory(memory, 0U, size));
+  }
+
+  ++allocation_count_;
+  if (over_budget) {
+    ++over_budget_count_;
+  }
+  heap_allocated_[type.heapIndex] += size;
+  return { memory, mapped };
+}
+
+void VulkanMemoryAllocator::FreeDeviceMemory(std::uint32_t memory_type,
+                                             vk::DeviceMemory memory,
+                                             vk::DeviceSize size) {
+  device_.freeMemory(memory);
+  --allocation_count_;
+  heap_allocated_[memory_properties_.memoryTypes[memory_type].heapIndex] -=
+    size;
+}
+
+std::uint32_t VulkanMemoryAllocator::FindMemoryType(
+  std::uint32_t type_bits,
+  MemoryUsage memory_usage
+) const {
+  const auto [required, preferred]{ GetMemoryFlags(memory_usage) };
+
+  // Memory types are ordered by performance, so the first match is best
+  for (const vk::MemoryPropertyFlags flags : { required | preferred,
+                                               required }) {
+    for (std::uint32_t i{ 0U }; i < memory_properties_.memoryTypeCount; ++i) {
+      if ((type_bits & (1U << i))
+          && (memory_properties_.memoryTypes[i].propertyFlags & flags)
+             == flags) {
+        return i;
+      }
+    }
+  }
+
+  const std::string msg{ std::format("No memory type with properties {} "
+                                     "(allowed types {:#x})",
+                                     vk::to_string(required), type_bits) };
+  MAPLE_LOG_CRITICAL(LogRHI, msg);
+  throw std::runtime_error{ msg };
+}
+
+std::optional<std::uint32_t> VulkanMemoryAllocator::FindFallbackMemoryType(
+  std::uint32_t type_bits,
+  MemoryUsage memory_usage,
+  std::uint32_t memory_type,
+  const vk::MemoryRequirements& requirements,
+  bool dedicated
+) const {
+  // Another type of the same heap would share its budget
+  const vk::MemoryPropertyFlags required{ GetMemoryFlags(memory_usage).first };
+  const std::uint32_t heap{
+    memory_properties_.memoryTypes[memory_type].heapIndex
+  };
+  for (std::uint32_t i{ 0U }; i < memory_properties_.memoryTypeCount; ++i) {
+    const vk::MemoryType& type{ memory_properties_.memoryTypes[i] };
+    if ((type_bits & (1U << i))
+        && (type.propertyFlags & required) == required
+        && type.heapIndex != heap
+        && HasBudget(i, GetNewMemorySize(i, requirements, dedicated))) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+vk::DeviceSize VulkanMemoryAllocator::GetNewMemorySize(
+  std::uint32_t memory_type,
+  const vk::MemoryRequirements& requirements,
+  bool dedicated
+) const noexcept {
+  const vk::DeviceSize block_size{ GetBlockSize(memory_type) };
+  return dedicated || requirements.size > block_size / 2U ? requirements.size
+                                                         : block_size;
+}
+
+bool VulkanMemoryAllocator::HasBudget(std::uint32_t memory_type,
+                                      vk::DeviceSize size) const noexcept {
+  const std::uint32_t heap{
+    memory_properties_.memoryTypes[memory_type].heapIndex
+  };
+  return heap_usage_[heap] + size <= heap_budget_[heap];
+}
+
+vk::DeviceSize VulkanMemoryAllocator::GetBlockSize(
+  std::uint32_t memory_type
+) const noexcept {
+  // Small heaps (e.g., the host-visible window of device memory) would be
+  // used up by a few full-size blocks
+  const vk::DeviceSize heap_size{
+    memory_properties_.memoryHeaps[
+      memory_properties_.memoryTypes[memory_type].heapIndex
+    ].size
+  };
+  return std::clamp(std::bit_floor(heap_size / 8U), kMinAllocationSize,
+                    kMaxBlockSize);
+}
+
+void VulkanMemoryAllocator::UpdateBudget() const {
+  if (memory_budget_enabled_) {
+    const auto chain{
+      physical_device_.getMemoryProperties2<
+        vk::PhysicalDeviceMemoryProperties2,
+        vk::PhysicalDeviceMemoryBudgetPropertiesEXT
+      >()
+    };
+    const auto& budget{
+      chain.get<vk::PhysicalDeviceMemoryBudgetPropertiesEXT>()
+    };
+    for (std::uint32_t i{ 0U }; i < memory_properties_.memoryHeapCount; ++i) {
+      heap_budget_[i] = budget.heapBudget[i];
+      heap_usage_[i] = budget.heapUsage[i];
+    }
+  } else {
+    // Without the extension, assume the process may use most of each heap
+    // and count only its own allocations
+    for (std::uint32_t i{ 0U }; i < memory_properties_.memoryHeapCount; ++i) {
+      heap_budget_[i] = memory_properties_.memoryHeaps[i].size / 10U * 8U;
+      heap_usage_[i] = heap_allocated_[i];
+    }
+  }
+
+  if (budget_limit_ > 0U) {
+    for (std::uint32_t i{ 0U }; i < memory_properties_.memoryHeapCount; ++i) {
+      heap_budget_[i] = std::min(heap_budget_[i], budget_limit_);
+    }
+  }
+}
+
+std::uint32_t VulkanMemoryAllocator::GetPoolIndex(std::uint32_t memory_type,
+                                                  PoolKind kind) noexcept {
+  return memory_type * kPoolKindCount + static_cast<std::uint32_t>(kind);
+}
+
+} // namespace maple::rhi
@@ -0,0 +1,458 @@
+#pragma once
+
+// STL
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// Vulkan
+#include "Vulkan/vulkan.hpp"
+
+// RHI
+#include "RHI/BuddySubAllocator.h"
+#include "RHI/LinearSubAllocator.h"
+#include "RHI/RHIResources.h"
+#include "RHI/RHIStats.h"
+
+namespace maple::rhi {
+
+/**
+ * @brief Range of device memory bound to a buffer or image.
+ */
+struct VulkanAllocation {
+  /// Device memory the range belongs to
+  vk::DeviceMemory memory{ nullptr };
+
+  /// Offset of the range within the memory
+  vk::DeviceSize offset{ 0U };
+
+  /// Size of the range requested by the resource
+  vk::DeviceSize size{ 0U };
+
+  /// CPU address of the range (null unless the memory is host-visible)
+  std::byte* mapped{ nullptr };
+
+  /// Pool the range was sub-allocated from
+  std::uint32_t pool_index{ 0U };
+
+  /// Block the range was sub-allocated from (0 for dedicated allocations)
+  std::uint64_t block_id{ 0U };
+
+  /// Whether the resource owns the whole device memory allocation
+  bool dedicated{ false };
+};
+
+/**
+ * @brief GPU memory allocator of the Vulkan backend.
+ *
+ * Device memory is allocated in large blocks per memory type and resources
+ * are sub-allocated from them, which keeps the number of device allocations
+ * far below maxMemoryAllocationCount. Each memory type has three pools:
+ *   - Buffers, sub-allocated with a buddy allocator
+ *   - Transient buffers (e.g., staging), packed by a linear allocator
+ *   - Images, kept apart from buffers so bufferImageGranularity never
+ *     applies within a block
+ * Resources larger than half a block, or that the driver prefers to own
+ * their memory, get a dedicated allocation. Host-visible blocks stay mapped
+ * for their whole lifetime.
+ *
+ * Heap budgets come from VK_EXT_memory_budget when the device supports it
+ * and are estimated otherwise. Device memory that would exceed the budget of
+ * its heap is taken from another heap the resource may use instead (e.g.,
+ * system memory for GPU-only resources), or over budget if no heap has
+ * room.
+ *
+ * @note Thread-safe.
+ */
+class VulkanMemoryAllocator {
+public:
+  VulkanMemoryAllocator() = delete;
+  VulkanMemoryAllocator(const VulkanMemoryAllocator&) = delete;
+  VulkanMemoryAllocator& operator=(const VulkanMemoryAllocator&) = delete;
+  VulkanMemoryAllocator(VulkanMemoryAllocator&&) = delete;
+  VulkanMemoryAllocator& operator=(VulkanMemoryAllocator&&) = delete;
+
+  /**
+   * @brief Construct an allocator for a device.
+   *
+   * @param physical_device Device whose memory types are used
+   * @param device Logical device memory is allocated from
+   * @param memory_budget_enabled Whether VK_EXT_memory_budget is enabled
+   * @param budget_limit Most bytes of each heap to use (0 for no limit)
+   */
+  VulkanMemoryAllocator(vk::PhysicalDevice physical_device, vk::Device device,
+                        bool memory_budget_enabled,
+                        vk::DeviceSize budget_limit);
+
+  /**
+   * @brief Free every block; all resources must have been destroyed.
+   */
+  ~VulkanMemoryAllocator();
+
+  /**
+   * @brief Allocate memory for a buffer and bind it.
+   *
+   * @param buffer Buffer without memory
+   * @param memory_usage Which processor accesses the buffer's memory
+   * @param transient Whether to pack the buffer into a linear block
+   * @return Memory bound to the buffer
+   * @throws std::runtime_error If no memory type fits or device memory is
+   *                            exhausted
+   */
+  [[nodiscard]] VulkanAllocation AllocateBuffer(vk::Buffer buffer,
+                                                MemoryUsage memory_usage,
+                                                bool transient);
+
+  /**
+   * @brief Allocate memory for an image and bind it.
+   *
+   * @param image Image without memory
+   * @return Device-local memory bound to the image
+   * @throws std::runtime_error If no memory type fits or device memory is
+   *                            exhausted
+   */
+  [[nodiscard]] VulkanAllocation AllocateImage(vk::Image image);
+
+  /**
+   * @brief Allocate device-local memory that several images may be bound to.
+   *
+   * The memory is a dedicated allocation that belongs to no resource, so
+   * images bound to overlapping ranges of it alias each other.
+   *
+   * @param requirements Combined requirements of the images
+   * @return Unbound allocation, freed with Free()
+   * @throws std::runtime_error If no memory type fits or device memory is
+   *                            exhausted
+   */
+  [[nodiscard]] VulkanAllocation AllocateAliasable(
+    const vk::MemoryRequirements& requirements
+  );
+
+  /**
+   * @brief Get the memory type an allocation was made from.
+   *
+   * @param allocation Allocation to inspect
+   * @return Index of the memory type
+   */
+  [[nodiscard]] static std::uint32_t GetMemoryType(
+    const VulkanAllocation& allocation
+  ) noexcept;
+
+  /**
+   * @brief Return memory to its block, freeing the block once it is empty.
+   *
+   * @param allocation Allocation whose resource the GPU no longer uses
+   */
+  void Free(const VulkanAllocation& allocation);
+
+  /**
+   * @brief Start a defragmentation pass.
+   *
+   * Marks the sparsely used blocks of each buffer pool as sources, except
+   * the fullest block. Until EndDefragmentation(), no allocation is placed
+   * in a source block.
+   *
+   * @return true if any block was marked
+   */
+  [[nodiscard]] bool BeginDefragmentation();
+
+  /**
+   * @brief Check whether an allocation should be relocated by the current
+   *        defragmentation pass.
+   *
+   * @param allocation Allocation to check
+   * @return true if the allocation lives in a source block
+   */
+  [[nodiscard]] bool IsDefragmentationSource(
+    const VulkanAllocation& allocation
+  ) const;
+
+  /**
+   * @brief Allocate the relocation target of a buffer and bind it.
+   *
+   * Only existing blocks of the source allocation's pool are used, so
+   * relocation never grows the pool.
+   *
+   * @param buffer Buffer without memory, created like the relocated one
+   * @param source Allocation being relocated
+   * @return Memory bound to the buffer, or std::nullopt if the pool has no
+   *         room outside the source blocks
+   */
+  [[nodiscard]] std::optional<VulkanAllocation> AllocateRelocation(
+    vk::Buffer buffer,
+    const VulkanAllocation& source
+  );
+
+  /**
+   * @brief Finish a defragmentation pass.
+   *
+   * @param moved_bytes Bytes relocated by the pass
+   */
+  void EndDefragmentation(std::uint64_t moved_bytes);
+
+  /**
+   * @brief Fill in the block, allocation, and budget fields of memory stats.
+   *
+   * @param stats Statistics to update
+   */
+  void GetStats(RHIMemoryStats& stats) const;
+
+private:
+  /**
+   * @brief Kind of resources a pool holds.
+   */
+  enum class PoolKind : std::uint32_t {
+    Buffer,
+    TransientBuffer,
+    Image
+  };
+
+  /**
+   * @brief Device memory allocation that resources are sub-allocated from.
+   */
+  struct Block {
+    /// Device memory of the block
+    vk::DeviceMemory memory{ nullptr };
+
+    /// CPU address of the block (null unless host-visible)
+    std::byte* mapped{ nullptr };
+
+    /// Unique identifier of the block
+    std::uint64_t id{ 0U };
+
+    /// Offsets within the block
+    std::variant<BuddySubAllocator, LinearSubAllocator> allocator;
+
+    /// Whether the current defragmentation pass empties the block
+    bool defragmentation_source{ false };
+  };
+
+  /**
+   * @brief Blocks of one memory type holding one kind of resource.
+   */
+  struct Pool {
+    /// Memory type of the blocks
+    std::uint32_t memory_type{ 0U };
+
+    /// Kind of resources in the blocks
+    PoolKind kind{ PoolKind::Buffer };
+
+    /// Blocks of the pool
+    std::vector<std::unique_ptr<Block>> blocks{};
+  };
+
+  /**
+   * @brief Memory requirements of a resource.
+   */
+  struct Requirements {
+    /// Size, alignment, and allowed memory types
+    vk::MemoryRequirements memory{};
+
+    /// Whether the driver requires or prefers a dedicated allocation
+    bool dedicated{ false };
+  };
+
+  /**
+   * @brief Allocate memory for a resource.
+   *
+   * @param requirements Memory requirements of the resource
+   * @param memory_usage Which processor accesses the resource's memory
+   * @param kind Pool kind to sub-allocate from
+   * @param dedicated_info Resource to dedicate memory to, if dedicated
+   * @return Allocation of the resource (unbound)
+   */
+  [[nodiscard]] VulkanAllocation Allocate(
+    const Requirements& requirements,
+    MemoryUsage memory_usage,
+    PoolKind kind,
+    const vk::MemoryDedicatedAllocateInfo& dedicated_info
+  );
+
+  /**
+   * @brief Sub-allocate from a pool's blocks.
+   *
+   * @param pool_index Pool to allocate from
+   * @param requirements Memory requirements of the resource
+   * @param allow_new_block Whether a block may be created if none has room
+   * @return Allocation, or std::nullopt if the existing blocks have no room
+   *         and no block may be created
+   */
+  [[nodiscard]] std::optional<VulkanAllocation> AllocateFromPool(
+    std::uint32_t pool_index,
+    const vk::MemoryRequirements& requirements,
+    bool allow_new_block
+  );
+
+  /**
+   * @brief Find a memory type for new device memory once the preferred
+   *        type's heap is over budget.
+   *
+   * @param type_bits Memory types allowed by the resource
+   * @param memory_usage Which processor accesses the resource's memory
+   * @param memory_type Preferred memory type
+   * @param requirements Memory requirements of the resource
+   * @param dedicated Whether the resource needs a dedicated allocation
+   *                  regardless of its size
+   * @return Memory type in another heap with room for the new memory, or
+   *         std::nullopt if there is none
+   */
+  [[nodiscard]] std::optional<std::uint32_t> FindFallbackMemoryType(
+    std::uint32_t type_bits,
+    MemoryUsage memory_usage,
+    std::uint32_t memory_type,
+    const vk::MemoryRequirements& requirements,
+    bool dedicated
+  ) const;
+
+  /**
+   * @brief Get the bytes of device memory a resource adds to a memory type's
+   *        heap if no existing block has room for it.
+   *
+   * @param memory_type Memory type to allocate from
+   * @param requirements Memory requirements of the resource
+   * @param dedicated Whether the resource needs a dedicated allocation
+   *                  regardless of its size
+   * @return Size of the dedicated allocation or of a new block
+   */
+  [[nodiscard]] vk::DeviceSize GetNewMemorySize(
+    std::uint32_t memory_type,
+    const vk::MemoryRequirements& requirements,
+    bool dedicated
+  ) const noexcept;
+
+  /**
+   * @brief Check whether a heap has budget left for new device memory.
+   *
+   * @param memory_type Memory type whose heap to check
+   * @param size Bytes to allocate
+   * @return true if the allocation keeps the heap within its budget, as of
+   *         the last UpdateBudget()
+   */
+  [[nodiscard]] bool HasBudget(std::uint32_t memory_type,
+                               vk::DeviceSize size) const noexcept;
+
+  /**
+   * @brief Allocate device memory, mapping it if it is host-visible.
+   *
+   * @param memory_type Memory type to allocate from
+   * @param size Size in bytes
+   * @param dedicated_info Resource to dedicate the memory to (pNext chain)
+   * @return Device memory and its CPU address
+   * @throws std::runtime_error If maxMemoryAllocationCount is reached or
+   *                            the heap is exhausted
+   */
+  [[nodiscard]] std::pair<vk::DeviceMemory, std::byte*> AllocateDeviceMemory(
+    std::uint32_t memory_type,
+    vk::DeviceSize size,
+    const vk::MemoryDedicatedAllocateInfo* dedicated_info
+  );
+
+  /**
+   * @brief Free device memory.
+   *
+   * @param memory_type Memory type the memory was allocated from
+   * @param memory Memory to free
+   * @param size Size the memory was allocated with
+   */
+  void FreeDeviceMemory(std::uint32_t memory_type, vk::DeviceMemory memory,
+                        vk::DeviceSize size);
+
+  /**
+   * @brief Pick the memory type for a resource.
+   *
+   * @param type_bits Memory types allowed by the resource
+   * @param memory_usage Which processor accesses the resource's memory
+   * @return Index of the memory type
+   * @throws std::runtime_error If no allowed type has the required properties
+   */
+  [[nodiscard]] std::uint32_t FindMemoryType(std::uint32_t type_bits,
+                                             MemoryUsage memory_usage) const;
+
+  /**
+   * @brief Get the block size of a memory type, scaled down for small heaps.
+   *
+   * @param memory_type Memory type of the block
+   * @return Block size in bytes (power of two)
+   */
+  [[nodiscard]] vk::DeviceSize GetBlockSize(
+    std::uint32_t memory_type
+  ) const noexcept;
+
+  /**
+   * @brief Refresh the budget and usage of every heap.
+   */
+  void UpdateBudget() const;
+
+  /**
+   * @brief Get the pool index of a memory type and pool kind.
+   */
+  [[nodiscard]] static std::uint32_t GetPoolIndex(std::uint32_t memory_type,
+                                                  PoolKind kind) noexcept;
+
+  /// Blocks are at most this large
+  static constexpr vk::DeviceSize kMaxBlockSize{ 64U * 1024U * 1024U };
+
+  /// Smallest range handed out by buddy blocks
+  static constexpr vk::DeviceSize kMinAllocationSize{ 256U };
+
+  /// Number of pool kinds
+  static constexpr std::uint32_t kPoolKindCount{ 3U };
+
+  /// Device whose memory types are used
+  vk::PhysicalDevice physical_device_;
+
+  /// Logical device memory is allocated from
+  vk::Device device_;
+
+  /// Whether heap budgets are reported by VK_EXT_memory_budget
+  bool memory_budget_enabled_;
+
+  /// Most bytes of each heap to use (0 for no limit)
+  vk::DeviceSize budget_limit_;
+
+  /// Memory types and heaps of the device
+  vk::PhysicalDeviceMemoryProperties memory_properties_{};
+
+  /// Device memory allocation limit of the device
+  std::uint32_t max_allocation_count_{ 0U };
+
+  /// Guards all allocator state
+  mutable std::mutex mutex_{};
+
+  /// Pools indexed by GetPoolIndex()
+  std::vector<Pool> pools_{};
+
+  /// Identifier of the next block
+  std::uint64_t next_block_id_{ 1U };
+
+  /// Live device memory allocations
+  std::uint32_t allocation_count_{ 0U };
+
+  /// Dedicated allocations and their bytes
+  std::uint64_t dedicated_count_{ 0U };
+  std::uint64_t dedicated_bytes_{ 0U };
+
+  /// Bytes allocated from each heap by this allocator
+  std::array<vk::DeviceSize, vk::MaxMemoryHeaps> heap_allocated_{};
+
+  /// Budget and usage of each heap, as of the last UpdateBudget()
+  mutable std::array<vk::DeviceSize, vk::MaxMemoryHeaps> heap_budget_{};
+  mutable std::array<vk::DeviceSize, vk::MaxMemoryHeaps> heap_usage_{};
+
+  /// Bytes relocated by defragmentation since creation
+  std::uint64_t defragmented_bytes_{ 0U };
+
+  /// Device memory allocations made over budget since creation
+  std::uint64_t over_budget_count_{ 0U };
+
+  /// Device memory allocations placed in a fallback heap since creation
+  std::uint64_t budget_fallback_count_{ 0U };
+};
+
+} // namespace maple::rhi
@@ -0,0 +1,147 @@
+#include "RHI/Vulkan/VulkanPipelineCache.h"
+
+// STL
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+// RHI
+#include "RHI/RHILog.h"
+
+namespace maple::rhi {
+
+VulkanPipelineCache::VulkanPipelineCache(vk::PhysicalDevice physical_device,
+                                         vk::Device device, std::string path)
+  : device_{ device }
+  , path_{ std::move(path) } {
+  // Identify the device and driver build the cache data depends on
+  const auto properties{
+    physical_device.getProperties2<vk::PhysicalDeviceProperties2,
+                                   vk::PhysicalDeviceIDProperties>()
+  };
+  const vk::PhysicalDeviceProperties& device_properties{
+    properties.get<vk::PhysicalDeviceProperties2>().properties
+  };
+  expected_header_.magic = kMagic;
+  expected_header_.version = kVersion;
+  expected_header_.vendor_id = device_properties.vendorID;
+  expected_header_.device_id = device_properties.deviceID;
+  expected_header_.driver_version = device_properties.driverVersion;
+  std::ranges::copy(
+    properties.get<vk::PhysicalDeviceIDProperties>().driverUUID,
+    expected_header_.driver_uuid.begin()
+  );
+  std::ranges::copy(device_properties.pipelineCacheUUID,
+                    expected_header_.pipeline_cache_uuid.begin());
+
+  const std::vector<std::uint8_t> data{ Load() };
+  try {
+    cache_ = device_.createPipelineCacheUnique(vk::PipelineCacheCreateInfo{
+      .initialDataSize = data.size(),
+      .pInitialData = data.data()
+    });
+  } catch (const vk::SystemError& e) {
+    // The driver rejected data that passed validation; start over
+    MAPLE_LOG_WARN(LogRHI, "Driver rejected the pipeline cache: {}", e.what());
+    cache_ = device_.createPipelineCacheUnique(vk::PipelineCacheCreateInfo{});
+  }
+}
+
+vk::PipelineCache VulkanPipelineCache::Get() const noexcept {
+  return *cache_;
+}
+
+void VulkanPipelineCache::Save() const {
+  if (path_.empty()) {
+    return;
+  }
+
+  std::vector<std::uint8_t> data{};
+  try {
+    data = device_.getPipelineCacheData(*cache_);
+  } catch (const vk::SystemError& e) {
+    MAPLE_LOG_ERROR(LogRHI, "Failed to read pipeline cache data: {}",
+                    e.what());
+    return;
+  }
+  FileHeader header{ expected_header_ };
+  header.data_size = data.size();
+  header.checksum = ComputeChecksum(data);
+
+  // Write next to the destination, then swap it in
+  const std::string temp_path{ path_ + ".tmp" };
+  {
+    std::ofstream out{ temp_path, std::ios::binary | std::ios::trunc };
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(data.data()),
+              static_cast<std::streamsize>(data.size()));
+    if (!out) {
+      MAPLE_LOG_ERROR(LogRHI, "Failed to write pipeline cache: {}", temp_path);
+      return;
+    }
+  }
+  std::error_code error{};
+  std::filesystem::rename(temp_path, path_, error);
+  if (error) {
+    MAPLE_LOG_ERROR(LogRHI, "Failed to replace pipeline cache: {}", path_);
+    return;
+  }
+
+  MAPLE_LOG_INFO(LogRHI, "Pipeline cache saved ({} KiB) to {}",
+                 data.size() / 1024U, path_);
+}
+
+std::vector<std::uint8_t> VulkanPipelineCache::Load() const {
+  if (path_.empty()) {
+    return {};
+  }
+
+  std::ifstream in{ path_, std::ios::binary };
+  if (!in) {
+    MAPLE_LOG_INFO(LogRHI, "No pipeline cache at {}; pipelines will be "
+                           "compiled from scratch", path_);
+    return {};
+  }
+
+  FileHeader header{};
+  in.read(reinterpret_cast<char*>(&header), sizeof(header));
+  FileHeader identity{ header };
+  identity.data_size = 0U;
+  identity.checksum = 0U;
+  if (!in || identity != expected_header_) {
+    MAPLE_LOG_INFO(LogRHI, "Pipeline cache at {} was written by another "
+                           "device or driver; discarding it", path_);
+    return {};
+  }
+
+  std::vector<std::uint8_t> data(
+    (std::istreambuf_iterator<char>{ in }), std::istreambuf_iterator<char>{}
+  );
+  if (data.size() != header.data_size
+      || ComputeChecksum(data) != header.checksum) {
+    MAPLE_LOG_WARN(LogRHI, "Pipeline cache at {} is corrupted; discarding it",
+                   path_);
+    return {};
+  }
+
+  MAPLE_LOG_INFO(LogRHI, "Pipeline cache loaded ({} KiB) from {}",
+                 data.size() / 1024U, path_);
+  return data;
+}
+
+std::uint64_t VulkanPipelineCache::ComputeChecksum(
+  const std::vector<std::uint8_t>& data
+) noexcept {
+  constexpr std::uint64_t kOffsetBasis{ 14695981039346656037ULL };
+  constexpr std::uint64_t kPrime{ 1099511628211ULL };
+
+  std::uint64_t hash{ kOffsetBasis };
+  for (const std::uint8_t byte : data) {
+    hash = (hash ^ byte) * kPrime;
+  }
+  return hash;
+}
+
+} // namespace maple::rhi
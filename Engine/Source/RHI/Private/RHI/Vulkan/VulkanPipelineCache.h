@@ -0,0 +1,129 @@
+#pragma once
+
+// STL
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Vulkan
+#include "Vulkan/vulkan.hpp"
+
+namespace maple::rhi {
+
+/**
+ * @brief VkPipelineCache persisted to disk across runs.
+ *
+ * The file starts with a header identifying the device and driver that
+ * produced the data (vendor ID, device ID, driver version, driver UUID, and
+ * pipeline cache UUID) and a checksum of the data. A file written by another
+ * device or driver, or a truncated or corrupted file, is discarded instead
+ * of being handed to the driver, since some drivers crash on foreign data.
+ *
+ * @note The cache may be used by any thread; Save() must not run while
+ *       pipelines are being compiled.
+ */
+class VulkanPipelineCache {
+public:
+  VulkanPipelineCache() = delete;
+  VulkanPipelineCache(const VulkanPipelineCache&) = delete;
+  VulkanPipelineCache& operator=(const VulkanPipelineCache&) = delete;
+  VulkanPipelineCache(VulkanPipelineCache&&) = delete;
+  VulkanPipelineCache& operator=(VulkanPipelineCache&&) = delete;
+
+  /**
+   * @brief Create the cache, seeded with the file's data if it is valid.
+   *
+   * @param physical_device Device the cache belongs to
+   * @param device Logical device
+   * @param path File to load from and save to; empty for no persistence
+   */
+  VulkanPipelineCache(vk::PhysicalDevice physical_device, vk::Device device,
+                      std::string path);
+
+  /**
+   * @brief Get the cache to compile pipelines with.
+   */
+  [[nodiscard]] vk::PipelineCache Get() const noexcept;
+
+  /**
+   * @brief Write the cache to its file.
+   *
+   * The file is replaced atomically, so a crash while saving never leaves a
+   * truncated cache behind. Failures are logged, not thrown, since losing
+   * the cache only costs compile time.
+   */
+  void Save() const;
+
+private:
+  /**
+   * @brief Header written in front of the driver's cache data.
+   */
+  struct FileHeader {
+    /// kMagic
+    std::uint32_t magic{ 0U };
+
+    /// kVersion
+    std::uint32_t version{ 0U };
+
+    /// PCI vendor ID of the device
+    std::uint32_t vendor_id{ 0U };
+
+    /// Vendor-specific device ID
+    std::uint32_t device_id{ 0U };
+
+    /// Vendor-specific driver version
+    std::uint32_t driver_version{ 0U };
+
+    /// Padding (zero)
+    std::uint32_t reserved{ 0U };
+
+    /// Build of the driver
+    std::array<std::uint8_t, vk::UuidSize> driver_uuid{};
+
+    /// Layout of the driver's cache data
+    std::array<std::uint8_t, vk::UuidSize> pipeline_cache_uuid{};
+
+    /// Bytes of cache data after the header
+    std::uint64_t data_size{ 0U };
+
+    /// FNV-1a hash of the cache data
+    std::uint64_t checksum{ 0U };
+
+    bool operator==(const FileHeader&) const = default;
+  };
+
+  /**
+   * @brief Read the file and check it against the device.
+   *
+   * @return Cache data, or empty if the file is missing or invalid
+   */
+  [[nodiscard]] std::vector<std::uint8_t> Load() const;
+
+  /**
+   * @brief Hash cache data for the file header.
+   */
+  [[nodiscard]] static std::uint64_t ComputeChecksum(
+    const std::vector<std::uint8_t>& data
+  ) noexcept;
+
+  /// "MPLC" in little-endian byte order
+  static constexpr std::uint32_t kMagic{ 0x434C504DU };
+
+  /// Layout version of FileHeader
+  static constexpr std::uint32_t kVersion{ 1U };
+
+  /// Logical device
+  vk::Device device_;
+
+  /// File the cache is persisted to (empty for none)
+  std::string path_;
+
+  /// Header matching the current device and driver (data fields unset)
+  FileHeader expected_header_{};
+
+  /// Driver pipeline cache
+  vk::UniquePipelineCache cache_{ nullptr };
+};
+
+} // namespace maple::rhi
@@ -1,9 +1,16 @@
 #include "RHI/Vulkan/VulkanRHI.h"
 
 // STL
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstdint>
 #include <format>
+#include <limits>
+#include <optional>
+#include <span>
 #include <stdexcept>
+#include <string_view>
 
 // SDL3
 #include "SDL3/SDL_vulkan.h"
@@ -11,6 +18,9 @@
 // Vulkan
 VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
 
+// Core
+#include "Core/Profiler.h"
+
 // Platform
 #include "Platform/Window.h"
 
@@ -18,299 +28,3014 @@ VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
 #include "RHI/RHILog.h"
 
 namespace maple::rhi {
-VulkanRHI::VulkanRHI(platform::Window* window)
-  : RHI{ window } {
-  // Initialize the default dynamic dispatcher with global functions
-  VULKAN_HPP_DEFAULT_DISPATCHER.init(vkGetInstanceProcAddr);
 
-  // Create Vulkan instance with required layers and extensions
-  CreateInstance();
+namespace {
 
-  // Setup debug messenger for validation layer output
-  if constexpr (kEnableValidation) {
-    CreateDebugMessenger();
+/// Device extensions every selected device must support
+constexpr std::array kRequiredDeviceExtensions{
+  VK_KHR_SWAPCHAIN_EXTENSION_NAME
+};
+
+/// Stages that wait for an acquired swapchain image to become writable
+constexpr vk::PipelineStageFlags kImageAcquireStages{
+  vk::PipelineStageFlagBits::eColorAttachmentOutput
+  | vk::PipelineStageFlagBits::eTransfer
+};
+
+/// Whole color subresource of a swapchain image
+constexpr vk::ImageSubresourceRange kColorSubresourceRange{
+  .aspectMask = vk::ImageAspectFlagBits::eColor,
+  .baseMipLevel = 0U,
+  .levelCount = 1U,
+  .baseArrayLayer = 0U,
+  .layerCount = 1U
+};
+
+/// Timeout for waits that should only end when the GPU finishes
+constexpr std::uint64_t kInfiniteTimeout{
+  std::numeric_limits<std::uint64_t>::max()
+};
+
+/**
+ * @brief Map buffer usage flags to Vulkan.
+ */
+vk::BufferUsageFlags ToVulkanBufferUsage(BufferUsage usage) noexcept {
+  using enum vk::BufferUsageFlagBits;
+  vk::BufferUsageFlags flags{};
+  if (HasUsage(usage, BufferUsage::Vertex)) {
+    flags |= eVertexBuffer;
+  }
+  if (HasUsage(usage, BufferUsage::Index)) {
+    flags |= eIndexBuffer;
+  }
+  if (HasUsage(usage, BufferUsage::Uniform)) {
+    flags |= eUniformBuffer;
+  }
+  if (HasUsage(usage, BufferUsage::Storage)) {
+    flags |= eStorageBuffer;
+  }
+  if (HasUsage(usage, BufferUsage::Indirect)) {
+    flags |= eIndirectBuffer;
   }
+  if (HasUsage(usage, BufferUsage::TransferSrc)) {
+    flags |= eTransferSrc;
+  }
+  if (HasUsage(usage, BufferUsage::TransferDst)) {
+    flags |= eTransferDst;
+  }
+  return flags;
 }
 
-VulkanRHI::~VulkanRHI() {
-  // ???
+/**
+ * @brief Map texture usage flags to Vulkan.
+ */
+vk::ImageUsageFlags ToVulkanTextureUsage(TextureUsage usage) noexcept {
+  using enum vk::ImageUsageFlagBits;
+  vk::ImageUsageFlags flags{};
+  if (HasUsage(usage, TextureUsage::Sampled)) {
+    flags |= eSampled;
+  }
+  if (HasUsage(usage, TextureUsage::Storage)) {
+    flags |= eStorage;
+  }
+  if (HasUsage(usage, TextureUsage::ColorAttachment)) {
+    flags |= eColorAttachment;
+  }
+  if (HasUsage(usage, TextureUsage::DepthStencilAttachment)) {
+    flags |= eDepthStencilAttachment;
+  }
+  if (HasUsage(usage, TextureUsage::TransferSrc)) {
+    flags |= eTransferSrc;
+  }
+  if (HasUsage(usage, TextureUsage::TransferDst)) {
+    flags |= eTransferDst;
+  }
+  return flags;
 }
 
-void VulkanRHI::BeginFrame() {
-  // ???
-}
+/**
+ * @brief Map a texture format to Vulkan.
+ */
+vk::Format ToVulkanFormat(TextureFormat format) noexcept {
+  switch (format) {
+    case TextureFormat::RGBA8Unorm: {
+      return vk::Format::eR8G8B8A8Unorm;
+    }
 
-void VulkanRHI::Clear(float r, float g, float b, float a) {
-  // ???
-}
+    case TextureFormat::RGBA8Srgb: {
+      return vk::Format::eR8G8B8A8Srgb;
+    }
 
-void VulkanRHI::EndFrame() {
-  // ???
+    case TextureFormat::BGRA8Unorm: {
+      return vk::Format::eB8G8R8A8Unorm;
+    }
+
+    case TextureFormat::BGRA8Srgb: {
+      return vk::Format::eB8G8R8A8Srgb;
+    }
+
+    case TextureFormat::RGBA16Float: {
+      return vk::Format::eR16G16B16A16Sfloat;
+    }
+
+    case TextureFormat::R32Float: {
+      return vk::Format::eR32Sfloat;
+    }
+
+    case TextureFormat::D32Float: {
+      return vk::Format::eD32Sfloat;
+    }
+
+    default: { break; }
+  }
+
+  return vk::Format::eUndefined;
 }
 
-void VulkanRHI::Present() {
-  // ???
+/**
+ * @brief Get the aspects of a texture format's images.
+ */
+vk::ImageAspectFlags GetAspectMask(TextureFormat format) noexcept {
+  return format == TextureFormat::D32Float ? vk::ImageAspectFlagBits::eDepth
+                                           : vk::ImageAspectFlagBits::eColor;
 }
 
-void VulkanRHI::CreateInstance() {
-  MAPLE_LOG_INFO(LogRHI, "Creating Vulkan instance...");
+/**
+ * @brief Synchronization scope and image layout of a resource state.
+ */
+struct StateAccess {
+  /// Stages that access the resource in the state
+  vk::PipelineStageFlags stages{};
 
-  // Query available layers and extensions
-  const auto available_layers{ QueryAvailableLayers() };
-  const auto available_extensions{ QueryAvailableExtensions() };
+  /// Accesses the stages perform
+  vk::AccessFlags access{};
 
-  // Gather required layers and extensions
-  const auto req_layers{ GatherRequiredLayers() };
-  const auto req_extensions{ GatherRequiredExtensions() };
+  /// Layout of images in the state
+  vk::ImageLayout layout{ vk::ImageLayout::eUndefined };
+};
 
-  // Validate required layers and extensions (throws if missing)
-  ValidateRequiredLayersAndExtensions(req_layers, req_extensions,
-                                      available_layers, available_extensions);
+/**
+ * @brief Map a resource state to its synchronization scope and layout.
+ */
+StateAccess GetStateAccess(ResourceState state) noexcept {
+  using Stage = vk::PipelineStageFlagBits;
+  using Access = vk::AccessFlagBits;
+  constexpr vk::PipelineStageFlags kShaderStages{
+    Stage::eVertexShader | Stage::eFragmentShader | Stage::eComputeShader
+  };
+  switch (state) {
+    case ResourceState::ColorAttachment: {
+      return StateAccess{
+        .stages = Stage::eColorAttachmentOutput,
+        .access = Access::eColorAttachmentRead | Access::eColorAttachmentWrite,
+        .layout = vk::ImageLayout::eColorAttachmentOptimal
+      };
+    }
 
-  // Gather optional layers and extensions
-  const auto opt_layers{ GatherOptionalLayers() };
-  const auto opt_extensions{ GatherOptionalExtensions() };
+    case ResourceState::DepthStencilAttachment: {
+      return StateAccess{
+        .stages = Stage::eEarlyFragmentTests | Stage::eLateFragmentTests,
+        .access = Access::eDepthStencilAttachmentRead
+                  | Access::eDepthStencilAttachmentWrite,
+        .layout = vk::ImageLayout::eDepthStencilAttachmentOptimal
+      };
+    }
 
-  // Validate optional layers and extensions; returns available
-  // layers and extensions, warns otherwise
-  auto [available_opt_layers, available_opt_extensions] {
-    ValidateOptionalLayersAndExtensions(opt_layers, opt_extensions,
-                                        available_layers, available_extensions)
-  };
+    case ResourceState::ShaderRead: {
+      return StateAccess{
+        .stages = kShaderStages,
+        .access = Access::eShaderRead,
+        .layout = vk::ImageLayout::eShaderReadOnlyOptimal
+      };
+    }
 
-  // Combine required and available optional layers for instance creation
-  std::vector<const char*> enabled_layers{};
-  for (const auto& layer : req_layers) {
-    enabled_layers.emplace_back(layer.c_str());
+    case ResourceState::ShaderWrite: {
+      return StateAccess{
+        .stages = kShaderStages,
+        .access = Access::eShaderRead | Access::eShaderWrite,
+        .layout = vk::ImageLayout::eGeneral
+      };
+    }
+
+    case ResourceState::TransferSrc: {
+      return StateAccess{
+        .stages = Stage::eTransfer,
+        .access = Access::eTransferRead,
+        .layout = vk::ImageLayout::eTransferSrcOptimal
+      };
+    }
+
+    case ResourceState::TransferDst: {
+      return StateAccess{
+        .stages = Stage::eTransfer,
+        .access = Access::eTransferWrite,
+        .layout = vk::ImageLayout::eTransferDstOptimal
+      };
+    }
+
+    default: {
+      // Wait for every earlier access, since the memory may have belonged to
+      // another resource
+      return StateAccess{
+        .stages = Stage::eAllCommands,
+        .access = Access::eMemoryWrite,
+        .layout = vk::ImageLayout::eUndefined
+      };
+    }
   }
-  for (const auto& layer : available_opt_layers) {
-    enabled_layers.emplace_back(layer.c_str());
+}
+
+/// Stages the async compute queue supports
+constexpr vk::PipelineStageFlags kComputeQueueStages{
+  vk::PipelineStageFlagBits::eTopOfPipe
+  | vk::PipelineStageFlagBits::eDrawIndirect
+  | vk::PipelineStageFlagBits::eComputeShader
+  | vk::PipelineStageFlagBits::eTransfer
+  | vk::PipelineStageFlagBits::eBottomOfPipe
+  | vk::PipelineStageFlagBits::eHost
+  | vk::PipelineStageFlagBits::eAllCommands
+};
+
+/**
+ * @brief Part of a transition that a command list records.
+ */
+enum class BarrierSide {
+  /// Nothing; a list of the other queue records the transition
+  None,
+
+  /// The whole transition
+  Whole,
+
+  /// Release half of a queue family ownership transfer
+  Release,
+
+  /// Acquire half of a queue family ownership transfer
+  Acquire
+};
+
+/**
+ * @brief Get the part of a transition that a list of a queue records.
+ *
+ * @param before State the transition starts in
+ * @param src_queue Queue the transition hands the resource over from
+ * @param dst_queue Queue the transition hands the resource over to
+ * @param queue Queue of the recording list
+ * @param ownership_transfer Whether the queues belong to different families
+ */
+BarrierSide GetBarrierSide(ResourceState before, QueueType src_queue,
+                           QueueType dst_queue, QueueType queue,
+                           bool ownership_transfer) noexcept {
+  if (src_queue == dst_queue) {
+    return BarrierSide::Whole;
   }
 
-  // Combine required and available optional extensions for instance creation
-  std::vector<const char*> enabled_extensions{};
-  for (const auto& extension : req_extensions) {
-    enabled_extensions.emplace_back(extension.c_str());
+  // Discarded contents need no release; the destination takes the resource
+  // over. Within one family, the source side transitions it ahead of time
+  if (before == ResourceState::Undefined) {
+    return queue == dst_queue ? BarrierSide::Whole : BarrierSide::None;
   }
-  for (const auto& extension : available_opt_extensions) {
-    enabled_extensions.emplace_back(extension.c_str());
+  if (!ownership_transfer) {
+    return queue == src_queue ? BarrierSide::Whole : BarrierSide::None;
   }
+  return queue == src_queue ? BarrierSide::Release : BarrierSide::Acquire;
+}
 
-  // Configure application and engine information
-  constexpr vk::ApplicationInfo app_info{
-    .pApplicationName = "Maple Application",
-    .applicationVersion = VK_MAKE_VERSION(0, 1, 0),
-    .pEngineName = "Maple Engine",
-    .engineVersion = VK_MAKE_VERSION(0, 1, 0),
-    .apiVersion = vk::ApiVersion12
-  };
+/**
+ * @brief Synchronization scopes and queue families of the part of a
+ *        transition that a command list records.
+ */
+struct BarrierScope {
+  /// Accesses to wait for, and the layout to transition from
+  StateAccess before{};
 
-  // Configure instance creation with validated layers and extensions
-  const vk::InstanceCreateInfo create_info{
-    .pApplicationInfo = &app_info,
-    .enabledLayerCount = static_cast<std::uint32_t>(enabled_layers.size()),
-    .ppEnabledLayerNames = enabled_layers.data(),
-    .enabledExtensionCount = static_cast<std::uint32_t>(enabled_extensions.size()),
-    .ppEnabledExtensionNames = enabled_extensions.data()
-  };
+  /// Accesses to block, and the layout to transition to
+  StateAccess after{};
 
-  // Create the Vulkan instance
-  instance_ = vk::createInstanceUnique(create_info);
+  /// Family releasing the resource (ignored unless transferring ownership)
+  std::uint32_t src_family{ vk::QueueFamilyIgnored };
 
-  // Initialize the default dynamic dispatcher with instance-level functions
-  VULKAN_HPP_DEFAULT_DISPATCHER.init(*instance_);
+  /// Family acquiring the resource (ignored unless transferring ownership)
+  std::uint32_t dst_family{ vk::QueueFamilyIgnored };
+};
 
-  MAPLE_LOG_INFO(LogRHI, "Vulkan instance created");
-}
+/**
+ * @brief Map a vertex attribute format to Vulkan.
+ */
+vk::Format ToVulkanVertexFormat(VertexFormat format) noexcept {
+  switch (format) {
+    case VertexFormat::Float: {
+      return vk::Format::eR32Sfloat;
+    }
 
-std::unordered_set<std::string> VulkanRHI::QueryAvailableLayers() {
-  std::unordered_set<std::string> layer_names{};
+    case VertexFormat::Float2: {
+      return vk::Format::eR32G32Sfloat;
+    }
 
-  // Query all available Vulkan layers and extract their names
-  const auto layers{ vk::enumerateInstanceLayerProperties() };
-  for (const auto& layer : layers) {
-    layer_names.emplace(layer.layerName.data());
+    case VertexFormat::Float3: {
+      return vk::Format::eR32G32B32Sfloat;
+    }
+
+    case VertexFormat::Float4: {
+      return vk::Format::eR32G32B32A32Sfloat;
+    }
+
+    case VertexFormat::UByte4Unorm: {
+      return vk::Format::eR8G8B8A8Unorm;
+    }
+
+    case VertexFormat::UInt: {
+      return vk::Format::eR32Uint;
+    }
+
+    default: { break; }
   }
 
-  return layer_names;
+  return vk::Format::eUndefined;
 }
 
-std::unordered_set<std::string> VulkanRHI::QueryAvailableExtensions() {
-  std::unordered_set<std::string> extension_names{};
+/**
+ * @brief Map a primitive topology to Vulkan.
+ */
+vk::PrimitiveTopology ToVulkanTopology(PrimitiveTopology topology) noexcept {
+  switch (topology) {
+    case PrimitiveTopology::TriangleStrip: {
+      return vk::PrimitiveTopology::eTriangleStrip;
+    }
 
-  // Query all available Vulkan instance extensions and extract their names
-  const auto extensions{ vk::enumerateInstanceExtensionProperties() };
-  for (const auto& extension : extensions) {
-    extension_names.emplace(extension.extensionName.data());
+    case PrimitiveTopology::LineList: {
+      return vk::PrimitiveTopology::eLineList;
+    }
+
+    case PrimitiveTopology::PointList: {
+      return vk::PrimitiveTopology::ePointList;
+    }
+
+    default: { break; }
   }
 
-  return extension_names;
+  return vk::PrimitiveTopology::eTriangleList;
 }
 
-std::vector<std::string> VulkanRHI::GatherRequiredLayers() {
-  std::vector<std::string> layer_names{};
-  return layer_names;
+/**
+ * @brief Map a cull mode to Vulkan.
+ */
+vk::CullModeFlags ToVulkanCullMode(CullMode cull_mode) noexcept {
+  switch (cull_mode) {
+    case CullMode::Front: {
+      return vk::CullModeFlagBits::eFront;
+    }
+
+    case CullMode::Back: {
+      return vk::CullModeFlagBits::eBack;
+    }
+
+    default: { break; }
+  }
+
+  return vk::CullModeFlagBits::eNone;
 }
 
-std::vector<std::string> VulkanRHI::GatherRequiredExtensions() {
-  std::vector<std::string> extension_names{};
+/**
+ * @brief Map a compare op to Vulkan (the enumerators are in the same order).
+ */
+vk::CompareOp ToVulkanCompareOp(CompareOp compare_op) noexcept {
+  return static_cast<vk::CompareOp>(compare_op);
+}
 
-  // Get required extensions from SDL
-  std::uint32_t num_sdl_extensions{};
-  const char* const* sdl_extensions{
-    SDL_Vulkan_GetInstanceExtensions(&num_sdl_extensions)
+/**
+ * @brief Get the color attachment blend state of a blend mode.
+ */
+vk::PipelineColorBlendAttachmentState GetBlendState(
+  BlendMode blend_mode
+) noexcept {
+  using enum vk::BlendFactor;
+  vk::PipelineColorBlendAttachmentState state{
+    .blendEnable = vk::False,
+    .srcColorBlendFactor = eOne,
+    .dstColorBlendFactor = eZero,
+    .colorBlendOp = vk::BlendOp::eAdd,
+    .srcAlphaBlendFactor = eOne,
+    .dstAlphaBlendFactor = eZero,
+    .alphaBlendOp = vk::BlendOp::eAdd,
+    .colorWriteMask = vk::ColorComponentFlagBits::eR
+                      | vk::ColorComponentFlagBits::eG
+                      | vk::ColorComponentFlagBits::eB
+                      | vk::ColorComponentFlagBits::eA
   };
+  switch (blend_mode) {
+    case BlendMode::AlphaBlend: {
+      state.blendEnable = vk::True;
+      state.srcColorBlendFactor = eSrcAlpha;
+      state.dstColorBlendFactor = eOneMinusSrcAlpha;
+      state.dstAlphaBlendFactor = eOneMinusSrcAlpha;
+      break;
+    }
 
-  // Add SDL extensions to the list
-  for (std::uint32_t i{ 0U }; i < num_sdl_extensions; ++i) {
-    extension_names.emplace_back(sdl_extensions[i]);
-  }
+    case BlendMode::Additive: {
+      state.blendEnable = vk::True;
+      state.srcColorBlendFactor = eSrcAlpha;
+      state.dstColorBlendFactor = eOne;
+      state.dstAlphaBlendFactor = eOne;
+      break;
+    }
 
-  return extension_names;
+    default: { break; }
+  }
+  return state;
 }
 
-std::vector<std::string> VulkanRHI::GatherOptionalLayers() {
-  std::vector<std::string> layer_names{};
+} // namespace
 
-  // Add validation layer in debug builds for error checking
+VulkanRHI::VulkanRHI(platform::Window* window, const RHIConfig& config)
+  : RHI{ window }
+  , requested_present_mode_{ config.present_mode } {
+  // Initialize the default dynamic dispatcher with global functions
+  VULKAN_HPP_DEFAULT_DISPATCHER.init(vkGetInstanceProcAddr);
+
+  // Create Vulkan instance with required layers and extensions
+  CreateInstance();
+
+  // Setup debug messenger for validation layer output
   if constexpr (kEnableValidation) {
-    layer_names.emplace_back("VK_LAYER_KHRONOS_validation");
+    CreateDebugMessenger();
   }
 
-  return layer_names;
-}
+  // Create the window surface, then pick a device that can present to it
+  CreateSurface();
+  SelectPhysicalDevice(config);
+  CreateLogicalDevice();
+  async_compute_ = config.async_compute && compute_queue_ != graphics_queue_;
+  MAPLE_LOG_INFO(LogRHI, "Async compute {}",
+                 async_compute_ ? "enabled" : "disabled");
 
-std::vector<std::string> VulkanRHI::GatherOptionalExtensions() {
-  std::vector<std::string> extension_names{};
+  // Sub-allocate resource memory from large per-memory-type blocks
+  memory_allocator_ = std::make_unique<VulkanMemoryAllocator>(
+    physical_device_, *device_, memory_budget_enabled_,
+    config.memory_budget_limit
+  );
 
-  // Add debug and validation extensions in debug builds
-  if constexpr (kEnableValidation) {
-    // Debug utils extension for validation layer messages
-    extension_names.emplace_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+  // Seed pipeline compilation with the state compiled in earlier runs
+  CreatePipelineResources(config);
 
-    // Device address binding report extension
-    extension_names.emplace_back(
-      VK_EXT_DEVICE_ADDRESS_BINDING_REPORT_EXTENSION_NAME
-    );
+  // Create the frame pipeline; the swapchain waits for a drawable area if
+  // the window starts minimized
+  const std::uint32_t frames_in_flight{
+    std::clamp(config.frames_in_flight, 1U, kMaxFramesInFlight)
+  };
+  if (frames_in_flight != config.frames_in_flight) {
+    MAPLE_LOG_WARN(LogRHI, "{} frames in flight requested; using {}",
+                           config.frames_in_flight, frames_in_flight);
   }
+  CreateFrameResources(frames_in_flight);
+  CreateTransientBuffer(config.transient_buffer_size, frames_in_flight);
+  CreateGpuTimer(config.max_gpu_zones);
 
-  return extension_names;
+  // Stream uploads on the transfer queue so they never stall rendering
+  upload_queue_ = std::make_unique<VulkanUploadQueue>(
+    *device_, *memory_allocator_, transfer_queue_, queue_families_.transfer,
+    queue_families_.graphics,
+    physical_device_.getQueueFamilyProperties()[queue_families_.transfer]
+      .minImageTransferGranularity,
+    queue_mutex_, config.upload_buffer_size
+  );
+  swapchain_dirty_ = !CreateSwapchain();
 }
 
-void VulkanRHI::ValidateRequiredLayersAndExtensions(
-  const std::vector<std::string>& req_layers,
-  const std::vector<std::string>& req_extensions,
-  const std::unordered_set<std::string>& available_layers,
-  const std::unordered_set<std::string>& available_extensions
-) {
-  // Validate required layers
-  bool all_layers_available{ true };
-  for (const auto& req_layer : req_layers) {
-    if (available_layers.contains(req_layer)) {
-      MAPLE_LOG_INFO(LogRHI, "Found required Vulkan layer: {}", req_layer);
-    } else {
-      MAPLE_LOG_CRITICAL(LogRHI, "Required Vulkan layer not available: {}",
-                                 req_layer);
-      all_layers_available = false;
+VulkanRHI::~VulkanRHI() {
+  // Let in-flight work finish before members are destroyed
+  core::JobSystem::Wait(warmup_counter_);
+  if (!device_) {
+    return;
+  }
+  device_->waitIdle();
+
+  // Keep what this run compiled for the next one
+  if (pipeline_cache_) {
+    pipeline_cache_->Save();
+  }
+
+  // Return all resource memory before the allocator frees its blocks
+  std::lock_guard lock{ resource_mutex_ };
+  buffers_.ForEach([&](BufferHandle, VulkanBuffer& buffer) {
+    RetiredResource resource{
+      .buffer = std::move(buffer.buffer),
+      .allocation = buffer.allocation
+    };
+    DestroyResource(resource);
+  });
+  textures_.ForEach([&](TextureHandle, VulkanTexture& texture) {
+    RetiredResource resource{
+      .view = std::move(texture.view),
+      .image = std::move(texture.image),
+      .allocation = texture.allocation
+    };
+    DestroyResource(resource);
+  });
+  memory_heaps_.ForEach([&](MemoryHeapHandle, VulkanAllocation& allocation) {
+    RetiredResource resource{ .allocation = allocation };
+    DestroyResource(resource);
+  });
+  for (auto* resources : { &pending_destroys_, &retired_resources_ }) {
+    for (RetiredResource& resource : *resources) {
+      DestroyResource(resource);
     }
+    resources->clear();
   }
+}
 
-  // Validate required extensions
-  bool all_extensions_available{ true };
-  for (const auto& req_extension : req_extensions) {
-    if (available_extensions.contains(req_extension)) {
-      MAPLE_LOG_INFO(LogRHI, "Found required Vulkan instance extension: {}",
-                             req_extension);
-    } else {
-      MAPLE_LOG_CRITICAL(LogRHI, "Required Vulkan instance extension not "
-                                 "available: {}", req_extension);
-      all_extensions_available = false;
+void VulkanRHI::BeginFrame() {
+  frame_active_ = false;
+  discard_transient_allocator_->BeginFrame(0U);
+
+  // Uploads keep flowing while frames are skipped
+  upload_queue_->Submit();
+
+  // Recreate the swapchain after a resize or present mode change; frames are
+  // skipped while the window has no drawable area
+  if (window_->ConsumeFramebufferResize()
+      || requested_present_mode_.load() != present_mode_) {
+    swapchain_dirty_ = true;
+  }
+  if (swapchain_dirty_ && !CreateSwapchain()) {
+    return;
+  }
+
+  // Wait until the GPU has finished the frame that last used these resources;
+  // with N frames in flight this lets the CPU record up to N frames ahead
+  FrameResources& frame{ GetCurrentFrame() };
+  WaitForTimeline(frame.timeline_value);
+  ResolveGpuZones();
+  DestroyRetiredSwapchains();
+  ReleaseRetiredResources();
+  transient_allocator_->BeginFrame(
+    static_cast<std::uint32_t>(frame_count_ % frames_.size())
+  );
+
+  // Recycle the command lists every thread recorded in this frame slot
+  for (auto& [thread_id, pools] : frame.thread_pools) {
+    for (ThreadCommandPool& pool : pools) {
+      if (pool.command_pool) {
+        device_->resetCommandPool(*pool.command_pool);
+      }
+      pool.used = 0U;
     }
   }
 
-  // Abort if any required layers or extensions are unavailable
-  if (!all_layers_available || !all_extensions_available) {
-    const std::string msg{ "One or more required Vulkan layers or extensions "
-                           "are unavailable" };
+  // Acquire the next swapchain image
+  const vk::Result result{
+    device_->acquireNextImageKHR(*swapchain_, kInfiniteTimeout,
+                                 *frame.image_available, vk::Fence{},
+                                 &image_index_)
+  };
+  if (result == vk::Result::eErrorOutOfDateKHR) {
+    swapchain_dirty_ = true;
+    return;
+  }
+  if (result == vk::Result::eSuboptimalKHR) {
+    // Still presentable; recreate once this frame is done
+    swapchain_dirty_ = true;
+  } else if (result != vk::Result::eSuccess) {
+    const std::string msg{ std::format("Failed to acquire swapchain image: {}",
+                                       vk::to_string(result)) };
     MAPLE_LOG_CRITICAL(LogRHI, msg);
     throw std::runtime_error{ msg };
   }
+
+  // Start recording into the frame's command buffer
+  device_->resetCommandPool(*frame.command_pool);
+  if (frame.compute_command_pool) {
+    device_->resetCommandPool(*frame.compute_command_pool);
+  }
+  frame.command_buffer.begin(vk::CommandBufferBeginInfo{
+    .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit
+  });
+  frame_gpu_zone_ = BeginGpuZone(frame.command_buffer, QueueType::Graphics,
+                                 "Frame");
+  upload_wait_value_ = upload_queue_->RecordAcquires(frame.command_buffer);
+  descriptor_heap_->Bind(frame.command_buffer, *pipeline_layout_, true);
+  if (defragment_requested_.exchange(false)) {
+    DefragmentBuffers(frame.command_buffer);
+  }
+  TransitionSwapchainImage(frame.command_buffer, vk::ImageLayout::eUndefined,
+                           vk::ImageLayout::eTransferDstOptimal);
+  frame_active_ = true;
 }
 
-std::pair<std::vector<std::string>, std::vector<std::string>>
-VulkanRHI::ValidateOptionalLayersAndExtensions(
-  const std::vector<std::string>& opt_layers,
-  const std::vector<std::string>& opt_extensions,
-  const std::unordered_set<std::string>& available_layers,
-  const std::unordered_set<std::string>& available_extensions
-) {
-  std::vector<std::string> validated_layers{};
-  std::vector<std::string> validated_extensions{};
+void VulkanRHI::Clear(float r, float g, float b, float a) {
+  if (!frame_active_) {
+    return;
+  }
+
+  const vk::CommandBuffer command_buffer{ GetCurrentFrame().command_buffer };
+  const std::uint32_t zone{
+    BeginGpuZone(command_buffer, QueueType::Graphics, "Clear")
+  };
+  vk::ClearColorValue color{};
+  color.setFloat32({ r, g, b, a });
+  command_buffer.clearColorImage(swapchain_images_[image_index_],
+                                 vk::ImageLayout::eTransferDstOptimal, color,
+                                 kColorSubresourceRange);
+  EndGpuZone(command_buffer, zone);
+}
+
+RHICommandList* VulkanRHI::BeginCommandList(
+  std::uint64_t sort_key,
+  QueueType queue,
+  std::span<const std::uint64_t> wait_sort_keys
+) {
+  // Commands of a skipped frame are discarded
+  if (!frame_active_) {
+    return &discard_command_list_;
+  }
+
+  // Find the calling thread's pool for this frame slot and queue
+  const bool compute{ async_compute_ && queue == QueueType::Compute };
+  ThreadCommandPool* pool{ nullptr };
+  {
+    std::lock_guard lock{ command_list_mutex_ };
+    pool = &GetCurrentFrame().thread_pools[std::this_thread::get_id()]
+                                          [compute ? 1U : 0U];
+  }
+
+  // The pool belongs to the calling thread, so it is used without the lock
+  if (!pool->command_pool) {
+    pool->command_pool = device_->createCommandPoolUnique(
+      vk::CommandPoolCreateInfo{
+        .flags = vk::CommandPoolCreateFlagBits::eTransient,
+        .queueFamilyIndex = compute ? queue_families_.compute
+                                    : queue_families_.graphics
+      }
+    );
+  }
+  if (pool->used == pool->command_lists.size()) {
+    const vk::CommandBuffer command_buffer{
+      device_->allocateCommandBuffers(vk::CommandBufferAllocateInfo{
+        .commandPool = *pool->command_pool,
+        .level = vk::CommandBufferLevel::eSecondary,
+        .commandBufferCount = 1U
+      }).front()
+    };
+    pool->command_lists.emplace_back(
+      std::make_unique<VulkanCommandList>(this, command_buffer)
+    );
+  }
+
+  // Secondary command buffers inherit no bindings, so each list binds the
+  // bindless heap once for all of its draws
+  VulkanCommandList* command_list{ pool->command_lists[pool->used++].get() };
+  command_list->Begin(sort_key, queue, wait_sort_keys,
+                      swapchain_images_[image_index_]);
+  descriptor_heap_->Bind(command_list->GetCommandBuffer(), *pipeline_layout_,
+                         !compute);
+  return command_list;
+}
+
+void VulkanRHI::EndCommandList(RHICommandList* command_list) {
+  auto* vulkan_command_list{ static_cast<VulkanCommandList*>(command_list) };
+  if (vulkan_command_list == &discard_command_list_) {
+    return;
+  }
+
+  vulkan_command_list->End();
+  std::lock_guard lock{ command_list_mutex_ };
+  pending_command_lists_.emplace_back(vulkan_command_list);
+}
+
+void VulkanRHI::EndFrame() {
+  if (!frame_active_) {
+    return;
+  }
+
+  // Execute the command lists after the immediate commands, ordered by sort
+  // key so the result does not depend on which thread finished first
+  FrameResources& frame{ GetCurrentFrame() };
+  std::ranges::sort(pending_command_lists_, {},
+                    &VulkanCommandList::GetSortKey);
+  ValidateCommandLists();
+  RecordQueueSubmissions(frame);
+  pending_command_lists_.clear();
+
+  // Submit the batches in order, so each is submitted after the batches it
+  // waits for. The first graphics batch waits for the acquired image and,
+  // in frames that acquired uploads, for the upload timeline, which makes
+  // the copies visible (the batches have completed already). The last one
+  // signals presentation and the frame's timeline value, which tells later
+  // frames when these resources are free again
+  std::lock_guard queue_lock{ queue_mutex_ };
+  if (gpu_timer_) {
+    gpu_timer_->Submit(GetCurrentFrameIndex(), core::Profiler::Now());
+  }
+  bool first_graphics{ true };
+  for (std::size_t i{ 0U }; i < queue_submissions_.size(); ++i) {
+    const QueueSubmission& submission{ queue_submissions_[i] };
+    const bool graphics{ submission.queue == QueueType::Graphics };
+
+    std::array<vk::Semaphore, 3> wait_semaphores{};
+    std::array<std::uint64_t, 3> wait_values{};
+    std::array<vk::PipelineStageFlags, 3> wait_stages{};
+    std::uint32_t wait_count{ 0U };
+    const auto add_wait{ [&](vk::Semaphore semaphore, std::uint64_t value,
+                             vk::PipelineStageFlags stages) {
+      wait_semaphores[wait_count] = semaphore;
+      wait_values[wait_count] = value;
+      wait_stages[wait_count] = stages;
+      ++wait_count;
+    } };
+    if (graphics && first_graphics) {
+      first_graphics = false;
+      add_wait(*frame.image_available, 0U, kImageAcquireStages);
+      if (upload_wait_value_ != 0U) {
+        add_wait(upload_queue_->GetTimeline(), upload_wait_value_,
+                 vk::PipelineStageFlagBits::eAllCommands);
+      }
+    }
+    if (submission.wait_value != 0U) {
+      add_wait(graphics ? *compute_timeline_ : *frame_timeline_,
+               submission.wait_value, vk::PipelineStageFlagBits::eAllCommands);
+    }
+
+    std::array<vk::Semaphore, 2> signal_semaphores{};
+    std::array<std::uint64_t, 2> signal_values{};
+    std::uint32_t signal_count{ 0U };
+    if (i + 1U == queue_submissions_.size()) {
+      signal_semaphores[signal_count++] = *render_finished_[image_index_];
+    }
+    if (submission.signal_value != 0U) {
+      signal_semaphores[signal_count] = graphics ? *frame_timeline_
+                                                 : *compute_timeline_;
+      signal_values[signal_count++] = submission.signal_value;
+    }
+
+    const vk::TimelineSemaphoreSubmitInfo timeline_info{
+      .waitSemaphoreValueCount = wait_count,
+      .pWaitSemaphoreValues = wait_values.data(),
+      .signalSemaphoreValueCount = signal_count,
+      .pSignalSemaphoreValues = signal_values.data()
+    };
+    const vk::SubmitInfo submit_info{
+      .pNext = &timeline_info,
+      .waitSemaphoreCount = wait_count,
+      .pWaitSemaphores = wait_semaphores.data(),
+      .pWaitDstStageMask = wait_stages.data(),
+      .commandBufferCount = 1U,
+      .pCommandBuffers = &submission.command_buffer,
+      .signalSemaphoreCount = signal_count,
+      .pSignalSemaphores = signal_semaphores.data()
+    };
+    (graphics ? graphics_queue_ : compute_queue_).submit(submit_info);
+  }
+}
+
+QueueType VulkanRHI::GetSubmissionQueue(
+  const VulkanCommandList& command_list
+) const noexcept {
+  return async_compute_ ? command_list.GetQueue() : QueueType::Graphics;
+}
+
+void VulkanRHI::ValidateCommandLists() {
+  const auto find_list{ [this](std::uint64_t sort_key) {
+    return std::ranges::lower_bound(pending_command_lists_, sort_key, {},
+                                    &VulkanCommandList::GetSortKey);
+  } };
+
+  std::optional<std::string> error{};
+  for (std::size_t i{ 0U }; i < pending_command_lists_.size() && !error;
+       ++i) {
+    const VulkanCommandList& command_list{ *pending_command_lists_[i] };
+    if (i > 0U
+        && pending_command_lists_[i - 1U]->GetSortKey()
+             == command_list.GetSortKey()) {
+      error = "Two command lists share a sort key";
+      break;
+    }
+    for (const std::uint64_t wait_sort_key : command_list.GetWaitSortKeys()) {
+      const auto waited{ find_list(wait_sort_key) };
+      if (wait_sort_key >= command_list.GetSortKey()
+          || waited == pending_command_lists_.end()
+          || (*waited)->GetSortKey() != wait_sort_key) {
+        error = std::format(
+          "Command list {} waits for {}, which does not precede it",
+          command_list.GetSortKey(), wait_sort_key
+        );
+        break;
+      }
+    }
+  }
+  if (!error) {
+    return;
+  }
+
+  pending_command_lists_.clear();
+  const std::string msg{ *error };
+  MAPLE_LOG_CRITICAL(LogRHI, msg);
+  throw std::runtime_error{ msg };
+}
+
+void VulkanRHI::RecordQueueSubmissions(FrameResources& frame) {
+  constexpr std::uint64_t kSignalRequested{
+    std::numeric_limits<std::uint64_t>::max()
+  };
+  constexpr auto kGraphics{ static_cast<std::size_t>(QueueType::Graphics) };
+  constexpr auto kCompute{ static_cast<std::size_t>(QueueType::Compute) };
+  const auto find_list{ [this](std::uint64_t sort_key) {
+    return static_cast<std::size_t>(std::ranges::distance(
+      pending_command_lists_.begin(),
+      std::ranges::lower_bound(pending_command_lists_, sort_key, {},
+                               &VulkanCommandList::GetSortKey)
+    ));
+  } };
+
+  // Lists the other queue waits for end a batch that signals their queue's
+  // timeline
+  list_signal_values_.assign(pending_command_lists_.size(), 0U);
+  for (const VulkanCommandList* command_list : pending_command_lists_) {
+    const QueueType queue{ GetSubmissionQueue(*command_list) };
+    for (const std::uint64_t wait_sort_key : command_list->GetWaitSortKeys()) {
+      const std::size_t waited{ find_list(wait_sort_key) };
+      if (GetSubmissionQueue(*pending_command_lists_[waited]) != queue) {
+        list_signal_values_[waited] = kSignalRequested;
+      }
+    }
+  }
+
+  // The frame's compute work must not overwrite resources the previous
+  // frame's graphics work still reads
+  const std::uint64_t previous_frame_value{ timeline_value_ };
+  std::array<std::optional<QueueSubmission>, kQueueTypeCount> open_batches{};
+  std::array<std::size_t, kQueueTypeCount> batch_counts{};
+  std::uint64_t compute_value{ 0U };
+  std::uint64_t queue_waits{ 0U };
+  std::uint64_t compute_command_lists{ 0U };
+  open_batches[kGraphics] = QueueSubmission{
+    .queue = QueueType::Graphics,
+    .command_buffer = frame.command_buffer
+  };
+  queue_submissions_.clear();
+
+  const auto open_batch{ [&](QueueType queue, std::uint64_t wait_value) {
+    const auto q{ static_cast<std::size_t>(queue) };
+    const std::uint64_t base_value{
+      queue == QueueType::Compute ? previous_frame_value : 0U
+    };
+    if (wait_value > base_value) {
+      ++queue_waits;
+    }
+    open_batches[q] = QueueSubmission{
+      .queue = queue,
+      .command_buffer = BeginSubmissionCommandBuffer(frame, queue,
+                                                     batch_counts[q]++),
+      .wait_value = wait_value
+    };
+  } };
+  const auto close_batch{ [&](QueueType queue, std::uint64_t signal_value) {
+    const auto q{ static_cast<std::size_t>(queue) };
+    QueueSubmission& batch{ *open_batches[q] };
+    if (!secondary_command_buffers_[q].empty()) {
+      batch.command_buffer.executeCommands(secondary_command_buffers_[q]);
+      secondary_command_buffers_[q].clear();
+    }
+    batch.command_buffer.end();
+    batch.signal_value = signal_value;
+    queue_submissions_.emplace_back(batch);
+    open_batches[q].reset();
+  } };
+
+  for (std::size_t i{ 0U }; i < pending_command_lists_.size(); ++i) {
+    const VulkanCommandList& command_list{ *pending_command_lists_[i] };
+    const QueueType queue{ GetSubmissionQueue(command_list) };
+    const auto q{ static_cast<std::size_t>(queue) };
+
+    // Waited lists precede the list, so their signal values are known
+    std::uint64_t wait_value{
+      queue == QueueType::Compute ? previous_frame_value : 0U
+    };
+    for (const std::uint64_t wait_sort_key : command_list.GetWaitSortKeys()) {
+      const std::size_t waited{ find_list(wait_sort_key) };
+      if (GetSubmissionQueue(*pending_command_lists_[waited]) != queue) {
+        wait_value = std::max(wait_value, list_signal_values_[waited]);
+      }
+    }
+    if (open_batches[q] && open_batches[q]->wait_value < wait_value) {
+      close_batch(queue, 0U);
+    }
+    if (!open_batches[q]) {
+      open_batch(queue, wait_value);
+    }
+
+    secondary_command_buffers_[q].emplace_back(command_list.GetCommandBuffer());
+    if (queue == QueueType::Compute) {
+      ++compute_command_lists;
+    }
+    if (list_signal_values_[i] == kSignalRequested) {
+      list_signal_values_[i] = queue == QueueType::Compute
+                                 ? ++compute_timeline_value_
+                                 : ++timeline_value_;
+      if (queue == QueueType::Compute) {
+        compute_value = list_signal_values_[i];
+      }
+      close_batch(queue, list_signal_values_[i]);
+    }
+  }
+
+  // The frame ends with a graphics batch after every compute batch, so its
+  // timeline value covers the whole frame
+  if (open_batches[kCompute]) {
+    compute_value = ++compute_timeline_value_;
+    close_batch(QueueType::Compute, compute_value);
+  }
+  if (open_batches[kGraphics]
+      && open_batches[kGraphics]->wait_value < compute_value) {
+    close_batch(QueueType::Graphics, 0U);
+  }
+  if (!open_batches[kGraphics]) {
+    open_batch(QueueType::Graphics, compute_value);
+  }
+
+  // Finish recording
+  QueueSubmission& last_batch{ *open_batches[kGraphics] };
+  if (!secondary_command_buffers_[kGraphics].empty()) {
+    last_batch.command_buffer.executeCommands(
+      secondary_command_buffers_[kGraphics]
+    );
+    secondary_command_buffers_[kGraphics].clear();
+  }
+  EndGpuZone(last_batch.command_buffer, frame_gpu_zone_);
+  TransitionSwapchainImage(last_batch.command_buffer,
+                           vk::ImageLayout::eTransferDstOptimal,
+                           vk::ImageLayout::ePresentSrcKHR);
+  close_batch(QueueType::Graphics, ++timeline_value_);
+  frame.timeline_value = timeline_value_;
+
+  compute_command_lists_submitted_.fetch_add(compute_command_lists,
+                                             std::memory_order_relaxed);
+  queue_waits_.fetch_add(queue_waits, std::memory_order_relaxed);
+}
+
+vk::CommandBuffer VulkanRHI::BeginSubmissionCommandBuffer(
+  FrameResources& frame,
+  QueueType queue,
+  std::size_t index
+) {
+  // Allocated on first use and reset with their frame's pool
+  std::vector<vk::CommandBuffer>& command_buffers{
+    frame.submission_command_buffers[static_cast<std::size_t>(queue)]
+  };
+  if (index == command_buffers.size()) {
+    command_buffers.emplace_back(device_->allocateCommandBuffers(
+      vk::CommandBufferAllocateInfo{
+        .commandPool = queue == QueueType::Compute
+                         ? *frame.compute_command_pool
+                         : *frame.command_pool,
+        .level = vk::CommandBufferLevel::ePrimary,
+        .commandBufferCount = 1U
+      }
+    ).front());
+  }
+
+  const vk::CommandBuffer command_buffer{ command_buffers[index] };
+  command_buffer.begin(vk::CommandBufferBeginInfo{
+    .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit
+  });
+  return command_buffer;
+}
+
+void VulkanRHI::Present() {
+  if (!frame_active_) {
+    return;
+  }
+  frame_active_ = false;
+
+  // Queue the image for display once rendering to it has finished
+  const vk::Semaphore wait_semaphore{ *render_finished_[image_index_] };
+  const vk::SwapchainKHR swapchain{ *swapchain_ };
+  const vk::PresentInfoKHR present_info{
+    .waitSemaphoreCount = 1U,
+    .pWaitSemaphores = &wait_semaphore,
+    .swapchainCount = 1U,
+    .pSwapchains = &swapchain,
+    .pImageIndices = &image_index_
+  };
+  vk::Result result{ vk::Result::eSuccess };
+  {
+    std::lock_guard queue_lock{ queue_mutex_ };
+    result = graphics_queue_.presentKHR(&present_info);
+  }
+  if (result == vk::Result::eErrorOutOfDateKHR
+      || result == vk::Result::eSuboptimalKHR) {
+    swapchain_dirty_ = true;
+  } else if (result != vk::Result::eSuccess) {
+    const std::string msg{ std::format("Failed to present swapchain image: {}",
+                                       vk::to_string(result)) };
+    MAPLE_LOG_CRITICAL(LogRHI, msg);
+    throw std::runtime_error{ msg };
+  }
+
+  // Move on to the next frame's resources
+  ++frame_count_;
+}
+
+std::span<const GpuZone> VulkanRHI::GetGpuZones() const {
+  if (!gpu_timer_) {
+    return {};
+  }
+  return gpu_timer_->GetResolvedZones();
+}
+
+bool VulkanRHI::HasAsyncCompute() const noexcept {
+  return async_compute_;
+}
+
+void VulkanRHI::SetPresentMode(PresentMode present_mode) {
+  requested_present_mode_.store(present_mode);
+}
+
+BufferHandle VulkanRHI::CreateBuffer(const BufferDesc& desc) {
+  if (desc.size == 0U || desc.usage == BufferUsage::None) {
+    const std::string msg{ "Buffer size and usage must be nonzero" };
+    MAPLE_LOG_CRITICAL(LogRHI, msg);
+    throw std::runtime_error{ msg };
+  }
+
+  // Every buffer may be uploaded to, and GPU-only buffers may be copied to a
+  // new location by defragmentation
+  vk::BufferUsageFlags usage{
+    ToVulkanBufferUsage(desc.usage) | vk::BufferUsageFlagBits::eTransferDst
+  };
+  if (desc.memory_usage == MemoryUsage::GpuOnly && !desc.transient) {
+    usage |= vk::BufferUsageFlagBits::eTransferSrc;
+  }
+
+  vk::UniqueBuffer buffer{ device_->createBufferUnique(vk::BufferCreateInfo{
+    .size = desc.size,
+    .usage = usage,
+    .sharingMode = vk::SharingMode::eExclusive
+  }) };
+  const VulkanAllocation allocation{
+    memory_allocator_->AllocateBuffer(*buffer, desc.memory_usage,
+                                      desc.transient)
+  };
+
+  // Publish storage buffers to shaders
+  std::uint32_t bindless_index{ kInvalidBindlessIndex };
+  if (HasUsage(desc.usage, BufferUsage::Storage)) {
+    bindless_index = descriptor_heap_->AddStorageBuffer(*buffer);
+    if (bindless_index == kInvalidBindlessIndex) {
+      memory_allocator_->Free(allocation);
+      const std::string msg{ "Bindless heap is full; raise "
+                             "RHIConfig::max_bindless_buffers" };
+      MAPLE_LOG_CRITICAL(LogRHI, msg);
+      throw std::runtime_error{ msg };
+    }
+  }
+
+  std::lock_guard lock{ resource_mutex_ };
+  return buffers_.Add(VulkanBuffer{
+    .buffer = std::move(buffer),
+    .allocation = allocation,
+    .desc = desc,
+    .bindless_index = bindless_index
+  });
+}
+
+void VulkanRHI::DestroyBuffer(BufferHandle buffer) {
+  std::lock_guard lock{ resource_mutex_ };
+  if (auto removed{ buffers_.Remove(buffer) }) {
+    pending_destroys_.emplace_back(RetiredResource{
+      .buffer = std::move(removed->buffer),
+      .allocation = removed->allocation,
+      .upload_ticket = removed->upload_ticket,
+      .storage_buffer_index = removed->bindless_index
+    });
+  }
+}
+
+void* VulkanRHI::MapBuffer(BufferHandle buffer) {
+  std::lock_guard lock{ resource_mutex_ };
+  const VulkanBuffer* vulkan_buffer{ buffers_.Get(buffer) };
+  return vulkan_buffer ? vulkan_buffer->allocation.mapped : nullptr;
+}
+
+TextureHandle VulkanRHI::CreateTexture(const TextureDesc& desc) {
+  vk::UniqueImage image{ CreateImage(desc) };
+  const VulkanAllocation allocation{ memory_allocator_->AllocateImage(*image) };
+  return AddTexture(std::move(image), allocation, MemoryHeapHandle{}, desc);
+}
+
+void VulkanRHI::DestroyTexture(TextureHandle texture) {
+  std::lock_guard lock{ resource_mutex_ };
+  if (auto removed{ textures_.Remove(texture) }) {
+    pending_destroys_.emplace_back(RetiredResource{
+      .view = std::move(removed->view),
+      .image = std::move(removed->image),
+      .allocation = removed->allocation,
+      .upload_ticket = removed->upload_ticket,
+      .sampled_texture_index = removed->sampled_index,
+      .storage_texture_index = removed->storage_index
+    });
+  }
+}
+
+MemoryRequirements VulkanRHI::GetTextureMemoryRequirements(
+  const TextureDesc& desc
+) const {
+  // Images only report their requirements once created
+  const vk::UniqueImage image{ CreateImage(desc) };
+  const vk::MemoryRequirements requirements{
+    device_->getImageMemoryRequirements(*image)
+  };
+  return MemoryRequirements{
+    .size = requirements.size,
+    .alignment = requirements.alignment,
+    .memory_type_bits = requirements.memoryTypeBits
+  };
+}
+
+MemoryHeapHandle VulkanRHI::CreateMemoryHeap(
+  const MemoryRequirements& requirements
+) {
+  if (requirements.size == 0U) {
+    const std::string msg{ "Memory heap size must be nonzero" };
+    MAPLE_LOG_CRITICAL(LogRHI, msg);
+    throw std::runtime_error{ msg };
+  }
+
+  const VulkanAllocation allocation{
+    memory_allocator_->AllocateAliasable(vk::MemoryRequirements{
+      .size = requirements.size,
+      .alignment = requirements.alignment,
+      .memoryTypeBits = requirements.memory_type_bits
+    })
+  };
+  std::lock_guard lock{ resource_mutex_ };
+  return memory_heaps_.Add(allocation);
+}
+
+void VulkanRHI::DestroyMemoryHeap(MemoryHeapHandle heap) {
+  std::lock_guard lock{ resource_mutex_ };
+  if (const auto removed{ memory_heaps_.Remove(heap) }) {
+    pending_destroys_.emplace_back(RetiredResource{ .allocation = *removed });
+  }
+}
+
+TextureHandle VulkanRHI::CreatePlacedTexture(const TextureDesc& desc,
+                                             MemoryHeapHandle heap,
+                                             std::uint64_t offset) {
+  vk::UniqueImage image{ CreateImage(desc) };
+  const vk::MemoryRequirements requirements{
+    device_->getImageMemoryRequirements(*image)
+  };
+
+  {
+    std::lock_guard lock{ resource_mutex_ };
+    const VulkanAllocation* memory{ memory_heaps_.Get(heap) };
+    const char* error{ nullptr };
+    if (!memory) {
+      error = "Memory heap handle is stale";
+    } else if (offset % requirements.alignment != 0U) {
+      error = "Placed texture offset is misaligned";
+    } else if (offset > memory->size
+               || requirements.size > memory->size - offset) {
+      error = "Placed texture exceeds its memory heap";
+    } else if ((requirements.memoryTypeBits
+                & (1U << VulkanMemoryAllocator::GetMemoryType(*memory)))
+               == 0U) {
+      error = "Memory type of the heap does not fit the placed texture";
+    }
+    if (error) {
+      const std::string msg{ error };
+      MAPLE_LOG_CRITICAL(LogRHI, msg);
+      throw std::runtime_error{ msg };
+    }
+    device_->bindImageMemory(*image, memory->memory, memory->offset + offset);
+  }
+
+  // The heap owns the memory, so the texture frees none of it
+  return AddTexture(std::move(image), VulkanAllocation{}, heap, desc);
+}
+
+std::uint32_t VulkanRHI::GetBindlessIndex(BufferHandle buffer) const {
+  std::lock_guard lock{ resource_mutex_ };
+  const VulkanBuffer* vulkan_buffer{ buffers_.Get(buffer) };
+  return vulkan_buffer ? vulkan_buffer->bindless_index : kInvalidBindlessIndex;
+}
+
+std::uint32_t VulkanRHI::GetBindlessIndex(TextureHandle texture,
+                                          TextureUsage usage) const {
+  std::lock_guard lock{ resource_mutex_ };
+  const VulkanTexture* vulkan_texture{ textures_.Get(texture) };
+  if (!vulkan_texture) {
+    return kInvalidBindlessIndex;
+  }
+  if (usage == TextureUsage::Sampled) {
+    return vulkan_texture->sampled_index;
+  }
+  if (usage == TextureUsage::Storage) {
+    return vulkan_texture->storage_index;
+  }
+  return kInvalidBindlessIndex;
+}
+
+UploadTicket VulkanRHI::UploadBuffer(BufferHandle buffer,
+                                    std::uint64_t offset,
+                                    std::span<const std::byte> data) {
+  // Resolve the buffer and keep defragmentation from moving it while the
+  // copy is recorded; a buffer destroyed mid-upload is freed at shutdown
+  vk::Buffer target{ nullptr };
+  {
+    std::lock_guard lock{ resource_mutex_ };
+    VulkanBuffer* vulkan_buffer{ buffers_.Get(buffer) };
+    if (!vulkan_buffer) {
+      const std::string msg{ "Upload to a stale buffer handle" };
+      MAPLE_LOG_CRITICAL(LogRHI, msg);
+      throw std::runtime_error{ msg };
+    }
+    if (offset > vulkan_buffer->desc.size
+        || data.size() > vulkan_buffer->desc.size - offset) {
+      const std::string msg{ "Upload range exceeds the buffer" };
+      MAPLE_LOG_CRITICAL(LogRHI, msg);
+      throw std::runtime_error{ msg };
+    }
+    target = *vulkan_buffer->buffer;
+    vulkan_buffer->upload_ticket = kUploadInProgress;
+  }
+
+  std::uint64_t ticket{ 0U };
+  try {
+    ticket = upload_queue_->UploadBuffer(target, offset, data);
+  } catch (...) {
+    std::lock_guard lock{ resource_mutex_ };
+    if (VulkanBuffer* vulkan_buffer{ buffers_.Get(buffer) }) {
+      vulkan_buffer->upload_ticket = 0U;
+    }
+    throw;
+  }
+
+  std::lock_guard lock{ resource_mutex_ };
+  if (VulkanBuffer* vulkan_buffer{ buffers_.Get(buffer) }) {
+    vulkan_buffer->upload_ticket = ticket;
+  }
+  return UploadTicket{ .value = ticket };
+}
+
+UploadTicket VulkanRHI::UploadTexture(TextureHandle texture,
+                                      std::uint32_t mip_level,
+                                      std::span<const std::byte> data) {
+  vk::Image target{ nullptr };
+  TextureDesc desc{};
+  {
+    std::lock_guard lock{ resource_mutex_ };
+    const VulkanTexture* vulkan_texture{ textures_.Get(texture) };
+    if (!vulkan_texture) {
+      const std::string msg{ "Upload to a stale texture handle" };
+      MAPLE_LOG_CRITICAL(LogRHI, msg);
+      throw std::runtime_error{ msg };
+    }
+    target = *vulkan_texture->image;
+    desc = vulkan_texture->desc;
+  }
+  if (mip_level >= desc.mip_levels
+      || data.size() != GetMipSize(desc, mip_level)) {
+    const std::string msg{ "Upload does not match the texture's mip level" };
+    MAPLE_LOG_CRITICAL(LogRHI, msg);
+    throw std::runtime_error{ msg };
+  }
+
+  const std::uint64_t ticket{ upload_queue_->UploadImage(
+    target,
+    desc.format == TextureFormat::D32Float ? vk::ImageAspectFlagBits::eDepth
+                                           : vk::ImageAspectFlagBits::eColor,
+    mip_level,
+    vk::Extent2D{
+      .width = std::max(desc.width >> mip_level, 1U),
+      .height = std::max(desc.height >> mip_level, 1U)
+    },
+    GetTexelSize(desc.format),
+    data
+  ) };
+
+  // Textures are never relocated, so the ticket only delays their release
+  std::lock_guard lock{ resource_mutex_ };
+  if (VulkanTexture* vulkan_texture{ textures_.Get(texture) }) {
+    vulkan_texture->upload_ticket = ticket;
+  }
+  return UploadTicket{ .value = ticket };
+}
+
+bool VulkanRHI::IsUploadComplete(UploadTicket ticket) const {
+  return upload_queue_->IsComplete(ticket.value);
+}
+
+void VulkanRHI::WaitForUpload(UploadTicket ticket) {
+  upload_queue_->Wait(ticket.value);
+}
+
+ShaderHandle VulkanRHI::CreateShader(const ShaderDesc& desc) {
+  if (desc.code.empty() || desc.code.front() != kSpirvMagic) {
+    const std::string msg{ "Shader code is not SPIR-V" };
+    MAPLE_LOG_CRITICAL(LogRHI, msg);
+    throw std::runtime_error{ msg };
+  }
+
+  auto module{ std::make_shared<vk::UniqueShaderModule>(
+    device_->createShaderModuleUnique(vk::ShaderModuleCreateInfo{
+      .codeSize = desc.code.size_bytes(),
+      .pCode = desc.code.data()
+    })
+  ) };
+
+  std::lock_guard lock{ resource_mutex_ };
+  return shaders_.Add(VulkanShader{
+    .module = std::move(module),
+    .stage = desc.stage
+  });
+}
+
+void VulkanRHI::DestroyShader(ShaderHandle shader) {
+  // The GPU never reads modules, so only running compilations keep it alive
+  std::lock_guard lock{ resource_mutex_ };
+  (void)shaders_.Remove(shader);
+}
+
+PipelineHandle VulkanRHI::CreateGraphicsPipeline(
+  const GraphicsPipelineDesc& desc
+) {
+  vk::UniquePipeline pipeline{ CompileGraphicsPipeline(desc) };
+
+  std::lock_guard lock{ resource_mutex_ };
+  return pipelines_.Add(VulkanPipeline{
+    .pipeline = std::move(pipeline),
+    .desc = desc
+  });
+}
+
+PipelineHandle VulkanRHI::GetGraphicsPipeline(
+  const GraphicsPipelineDesc& desc
+) {
+  return pipeline_state_cache_->GetOrCreate(desc, [&] {
+    vk::UniquePipeline pipeline{ CompileGraphicsPipeline(desc) };
+
+    std::lock_guard lock{ resource_mutex_ };
+    return pipelines_.Add(VulkanPipeline{
+      .pipeline = std::move(pipeline),
+      .desc = desc,
+      .shared = true
+    });
+  });
+}
+
+void VulkanRHI::DestroyPipeline(PipelineHandle pipeline) {
+  // Shared pipelines live as long as the cache that hands them out
+  std::lock_guard lock{ resource_mutex_ };
+  const VulkanPipeline* vulkan_pipeline{ pipelines_.Get(pipeline) };
+  if (!vulkan_pipeline || vulkan_pipeline->shared) {
+    return;
+  }
+  if (auto removed{ pipelines_.Remove(pipeline) }) {
+    pending_destroys_.emplace_back(RetiredResource{
+      .pipeline = std::move(removed->pipeline)
+    });
+  }
+}
+
+void VulkanRHI::WarmupPipelines(
+  std::span<const GraphicsPipelineDesc> manifest
+) {
+  if (manifest.empty()) {
+    return;
+  }
+
+  // The jobs read a copy of the manifest, freed with the others once every
+  // warmup has finished
+  std::vector<GraphicsPipelineDesc>* descs{ nullptr };
+  {
+    std::lock_guard lock{ warmup_mutex_ };
+    if (warmup_counter_.IsDone()) {
+      warmup_manifests_.clear();
+    }
+    descs = warmup_manifests_.emplace_back(
+      std::make_unique<std::vector<GraphicsPipelineDesc>>(manifest.begin(),
+                                                          manifest.end())
+    ).get();
+  }
+
+  // Compiled pipelines go into the pipeline state cache, so their first
+  // GetGraphicsPipeline() is a lookup
+  MAPLE_LOG_INFO(LogRHI, "Warming up {} pipeline(s)...", descs->size());
+  for (std::size_t i{ 0U }; i < descs->size(); ++i) {
+    core::JobSystem::Schedule([this, descs, i] {
+      try {
+        (void)GetGraphicsPipeline((*descs)[i]);
+        pipelines_warmed_up_.fetch_add(1U, std::memory_order_relaxed);
+      } catch (const std::exception& e) {
+        MAPLE_LOG_WARN(LogRHI, "Skipped warming up a pipeline: {}", e.what());
+      }
+    }, &warmup_counter_);
+  }
+}
+
+bool VulkanRHI::IsPipelineWarmupComplete() const {
+  return warmup_counter_.IsDone();
+}
+
+TransientAllocation VulkanRHI::AllocateTransient(std::uint64_t size,
+                                                 BufferUsage usage) {
+  vk::DeviceSize alignment{ FrameRingAllocator::kMinAlignment };
+  if (HasUsage(usage, BufferUsage::Uniform)) {
+    alignment = std::max(alignment, uniform_alignment_);
+  }
+  if (HasUsage(usage, BufferUsage::Storage)) {
+    alignment = std::max(alignment, storage_alignment_);
+  }
+
+  // Data of a skipped frame is written to CPU memory and discarded
+  const bool frame_active{ frame_active_ };
+  FrameRingAllocator& allocator{
+    frame_active ? *transient_allocator_ : *discard_transient_allocator_
+  };
+  const std::optional<std::uint64_t> offset{
+    allocator.Allocate(size, alignment)
+  };
+  if (!offset) {
+    const std::string msg{ std::format("Transient buffer exhausted ({} KiB "
+                                       "per frame); raise "
+                                       "RHIConfig::transient_buffer_size",
+                                       allocator.GetSegmentSize() / 1024U) };
+    MAPLE_LOG_CRITICAL(LogRHI, msg);
+    throw std::runtime_error{ msg };
+  }
+
+  std::byte* data{
+    frame_active ? transient_data_ : discard_transient_data_.get()
+  };
+  return TransientAllocation{
+    .data = std::span{ data + *offset, size },
+    .buffer = frame_active ? transient_buffer_ : BufferHandle{},
+    .offset = *offset
+  };
+}
+
+void VulkanRHI::DefragmentMemory() {
+  defragment_requested_.store(true);
+}
+
+RHIMemoryStats VulkanRHI::GetMemoryStats() const {
+  RHIMemoryStats stats{};
+  {
+    std::lock_guard lock{ resource_mutex_ };
+    stats.buffer_count = buffers_.GetSize();
+    stats.texture_count = textures_.GetSize();
+  }
+  memory_allocator_->GetStats(stats);
+  stats.bindless_texture_slots = descriptor_heap_->GetTextureSlotCount();
+  stats.bindless_buffer_slots = descriptor_heap_->GetBufferSlotCount();
+  return stats;
+}
+
+RHIStats VulkanRHI::GetStats() const noexcept {
+  return RHIStats{
+    .compute_command_lists_submitted =
+      compute_command_lists_submitted_.load(std::memory_order_relaxed),
+    .queue_waits = queue_waits_.load(std::memory_order_relaxed),
+    .uploaded_bytes = upload_queue_->GetUploadedBytes(),
+    .upload_batches_submitted = upload_queue_->GetSubmittedBatchCount(),
+    .upload_stalls = upload_queue_->GetStallCount(),
+    .pipelines_compiled = pipelines_compiled_.load(std::memory_order_relaxed),
+    .pipelines_warmed_up =
+      pipelines_warmed_up_.load(std::memory_order_relaxed),
+    .pipeline_compile_microseconds =
+      pipeline_compile_microseconds_.load(std::memory_order_relaxed),
+    .cached_pipelines = pipeline_state_cache_->GetSize(),
+    .gpu_zones_dropped = gpu_timer_ ? gpu_timer_->GetDroppedZoneCount() : 0U
+  };
+}
+
+void VulkanRHI::RecordBarrier(vk::CommandBuffer command_buffer,
+                              QueueType queue,
+                              std::span<const TextureBarrier> textures,
+                              std::span<const BufferBarrier> buffers) const {
+  vk::PipelineStageFlags src_stages{};
+  vk::PipelineStageFlags dst_stages{};
+  const auto get_family{ [&](QueueType barrier_queue) noexcept {
+    return barrier_queue == QueueType::Compute ? queue_families_.compute
+                                               : queue_families_.graphics;
+  } };
+
+  // Scope the part of a transition this list records. Each half of an
+  // ownership transfer only synchronizes its own queue: the release makes
+  // the writes available, and the acquire, which follows a semaphore wait
+  // for the release, makes them visible
+  const bool compute_queue{ async_compute_ && queue == QueueType::Compute };
+  const bool ownership_transfer{
+    async_compute_ && queue_families_.compute != queue_families_.graphics
+  };
+  const auto get_scope{ [&](const auto& barrier) {
+    std::optional<BarrierScope> scope{};
+    const BarrierSide side{ GetBarrierSide(barrier.before, barrier.src_queue,
+                                           barrier.dst_queue, queue,
+                                           ownership_transfer) };
+    if (side == BarrierSide::None
+        || barrier.after == ResourceState::Undefined) {
+      return scope;
+    }
+
+    scope = BarrierScope{
+      .before = GetStateAccess(barrier.before),
+      .after = GetStateAccess(barrier.after)
+    };
+    if (side == BarrierSide::Release || side == BarrierSide::Acquire) {
+      scope->src_family = get_family(barrier.src_queue);
+      scope->dst_family = get_family(barrier.dst_queue);
+    }
+    if (side == BarrierSide::Release) {
+      scope->after.stages = vk::PipelineStageFlagBits::eBottomOfPipe;
+      scope->after.access = vk::AccessFlags{};
+    } else if (side == BarrierSide::Acquire) {
+      scope->before.stages = vk::PipelineStageFlagBits::eTopOfPipe;
+      scope->before.access = vk::AccessFlags{};
+    }
+
+    // Graphics stages of a state never run on the compute queue
+    if (compute_queue) {
+      for (StateAccess* access : { &scope->before, &scope->after }) {
+        access->stages &= kComputeQueueStages;
+        if (!access->stages) {
+          access->stages = vk::PipelineStageFlagBits::eAllCommands;
+        }
+      }
+    }
+    src_stages |= scope->before.stages;
+    dst_stages |= scope->after.stages;
+    return scope;
+  } };
+
+  std::vector<vk::ImageMemoryBarrier> image_barriers{};
+  std::vector<vk::BufferMemoryBarrier> buffer_barriers{};
+  image_barriers.reserve(textures.size());
+  buffer_barriers.reserve(buffers.size());
+  {
+    std::lock_guard lock{ resource_mutex_ };
+    for (const TextureBarrier& barrier : textures) {
+      const VulkanTexture* texture{ textures_.Get(barrier.texture) };
+      if (!texture) {
+        continue;
+      }
+      const std::optional<BarrierScope> scope{ get_scope(barrier) };
+      if (!scope) {
+        continue;
+      }
+      image_barriers.emplace_back(vk::ImageMemoryBarrier{
+        .srcAccessMask = scope->before.access,
+        .dstAccessMask = scope->after.access,
+        .oldLayout = scope->before.layout,
+        .newLayout = scope->after.layout,
+        .srcQueueFamilyIndex = scope->src_family,
+        .dstQueueFamilyIndex = scope->dst_family,
+        .image = *texture->image,
+        .subresourceRange = vk::ImageSubresourceRange{
+          .aspectMask = GetAspectMask(texture->desc.format),
+          .baseMipLevel = 0U,
+          .levelCount = texture->desc.mip_levels,
+          .baseArrayLayer = 0U,
+          .layerCount = 1U
+        }
+      });
+    }
+    for (const BufferBarrier& barrier : buffers) {
+      const VulkanBuffer* buffer{ buffers_.Get(barrier.buffer) };
+      if (!buffer) {
+        continue;
+      }
+      const std::optional<BarrierScope> scope{ get_scope(barrier) };
+      if (!scope) {
+        continue;
+      }
+      buffer_barriers.emplace_back(vk::BufferMemoryBarrier{
+        .srcAccessMask = scope->before.access,
+        .dstAccessMask = scope->after.access,
+        .srcQueueFamilyIndex = scope->src_family,
+        .dstQueueFamilyIndex = scope->dst_family,
+        .buffer = *buffer->buffer,
+        .offset = 0U,
+        .size = vk::WholeSize
+      });
+    }
+  }
+
+  if (image_barriers.empty() && buffer_barriers.empty()) {
+    return;
+  }
+  command_buffer.pipelineBarrier(src_stages, dst_stages, vk::DependencyFlags{},
+                                 nullptr, buffer_barriers, image_barriers);
+}
+
+void VulkanRHI::RecordFillBuffer(vk::CommandBuffer command_buffer,
+                                 BufferHandle buffer,
+                                 std::uint32_t value) const {
+  vk::Buffer vulkan_buffer{ nullptr };
+  {
+    std::lock_guard lock{ resource_mutex_ };
+    const VulkanBuffer* found{ buffers_.Get(buffer) };
+    if (!found) {
+      return;
+    }
+    vulkan_buffer = *found->buffer;
+  }
+  command_buffer.fillBuffer(vulkan_buffer, 0U, vk::WholeSize, value);
+}
+
+void VulkanRHI::CreateInstance() {
+  MAPLE_LOG_INFO(LogRHI, "Creating Vulkan instance...");
+
+  // Query available layers and extensions
+  const auto available_layers{ QueryAvailableLayers() };
+  const auto available_extensions{ QueryAvailableExtensions() };
+
+  // Gather required layers and extensions
+  const auto req_layers{ GatherRequiredLayers() };
+  const auto req_extensions{ GatherRequiredExtensions() };
+
+  // Validate required layers and extensions (throws if missing)
+  ValidateRequiredLayersAndExtensions(req_layers, req_extensions,
+                                      available_layers, available_extensions);
+
+  // Gather optional layers and extensions
+  const auto opt_layers{ GatherOptionalLayers() };
+  const auto opt_extensions{ GatherOptionalExtensions() };
+
+  // Validate optional layers and extensions; returns available
+  // layers and extensions, warns otherwise
+  auto [available_opt_layers, available_opt_extensions] {
+    ValidateOptionalLayersAndExtensions(opt_layers, opt_extensions,
+                                        available_layers, available_extensions)
+  };
+
+  // Combine required and available optional layers for instance creation
+  std::vector<const char*> enabled_layers{};
+  for (const auto& layer : req_layers) {
+    enabled_layers.emplace_back(layer.c_str());
+  }
+  for (const auto& layer : available_opt_layers) {
+    enabled_layers.emplace_back(layer.c_str());
+  }
+
+  // Combine required and available optional extensions for instance creation
+  std::vector<const char*> enabled_extensions{};
+  for (const auto& extension : req_extensions) {
+    enabled_extensions.emplace_back(extension.c_str());
+  }
+  for (const auto& extension : available_opt_extensions) {
+    enabled_extensions.emplace_back(extension.c_str());
+  }
+
+  // Configure application and engine information
+  constexpr vk::ApplicationInfo app_info{
+    .pApplicationName = "Maple Application",
+    .applicationVersion = VK_MAKE_VERSION(0, 1, 0),
+    .pEngineName = "Maple Engine",
+    .engineVersion = VK_MAKE_VERSION(0, 1, 0),
+    .apiVersion = vk::ApiVersion12
+  };
+
+  // Configure instance creation with validated layers and extensions
+  const vk::InstanceCreateInfo create_info{
+    .pApplicationInfo = &app_info,
+    .enabledLayerCount = static_cast<std::uint32_t>(enabled_layers.size()),
+    .ppEnabledLayerNames = enabled_layers.data(),
+    .enabledExtensionCount = static_cast<std::uint32_t>(enabled_extensions.size()),
+    .ppEnabledExtensionNames = enabled_extensions.data()
+  };
+
+  // Create the Vulkan instance
+  instance_ = vk::createInstanceUnique(create_info);
+
+  // Initialize the default dynamic dispatcher with instance-level functions
+  VULKAN_HPP_DEFAULT_DISPATCHER.init(*instance_);
+
+  MAPLE_LOG_INFO(LogRHI, "Vulkan instance created");
+}
+
+std::unordered_set<std::string> VulkanRHI::QueryAvailableLayers() {
+  std::unordered_set<std::string> layer_names{};
+
+  // Query all available Vulkan layers and extract their names
+  const auto layers{ vk::enumerateInstanceLayerProperties() };
+  for (const auto& layer : layers) {
+    layer_names.emplace(layer.layerName.data());
+  }
+
+  return layer_names;
+}
+
+std::unordered_set<std::string> VulkanRHI::QueryAvailableExtensions() {
+  std::unordered_set<std::string> extension_names{};
+
+  // Query all available Vulkan instance extensions and extract their names
+  const auto extensions{ vk::enumerateInstanceExtensionProperties() };
+  for (const auto& extension : extensions) {
+    extension_names.emplace(extension.extensionName.data());
+  }
+
+  return extension_names;
+}
+
+std::vector<std::string> VulkanRHI::GatherRequiredLayers() {
+  std::vector<std::string> layer_names{};
+  return layer_names;
+}
+
+std::vector<std::string> VulkanRHI::GatherRequiredExtensions() {
+  std::vector<std::string> extension_names{};
+
+  // Get required extensions from SDL
+  std::uint32_t num_sdl_extensions{};
+  const char* const* sdl_extensions{
+    SDL_Vulkan_GetInstanceExtensions(&num_sdl_extensions)
+  };
+
+  // Add SDL extensions to the list
+  for (std::uint32_t i{ 0U }; i < num_sdl_extensions; ++i) {
+    extension_names.emplace_back(sdl_extensions[i]);
+  }
+
+  return extension_names;
+}
+
+std::vector<std::string> VulkanRHI::GatherOptionalLayers() {
+  std::vector<std::string> layer_names{};
+
+  // Add validation layer in debug builds for error checking
+  if constexpr (kEnableValidation) {
+    layer_names.emplace_back("VK_LAYER_KHRONOS_validation");
+  }
+
+  return layer_names;
+}
+
+std::vector<std::string> VulkanRHI::GatherOptionalExtensions() {
+  std::vector<std::string> extension_names{};
+
+  // Add debug and validation extensions in debug builds
+  if constexpr (kEnableValidation) {
+    // Debug utils extension for validation layer messages
+    extension_names.emplace_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+
+    // Device address binding report extension
+    extension_names.emplace_back(
+      VK_EXT_DEVICE_ADDRESS_BINDING_REPORT_EXTENSION_NAME
+    );
+  }
+
+  return extension_names;
+}
+
+void VulkanRHI::ValidateRequiredLayersAndExtensions(
+  const std::vector<std::string>& req_layers,
+  const std::vector<std::string>& req_extensions,
+  const std::unordered_set<std::string>& available_layers,
+  const std::unordered_set<std::string>& available_extensions
+) {
+  // Validate required layers
+  bool all_layers_available{ true };
+  for (const auto& req_layer : req_layers) {
+    if (available_layers.contains(req_layer)) {
+      MAPLE_LOG_INFO(LogRHI, "Found required Vulkan layer: {}", req_layer);
+    } else {
+      MAPLE_LOG_CRITICAL(LogRHI, "Required Vulkan layer not available: {}",
+                                 req_layer);
+      all_layers_available = false;
+    }
+  }
+
+  // Validate required extensions
+  bool all_extensions_available{ true };
+  for (const auto& req_extension : req_extensions) {
+    if (available_extensions.contains(req_extension)) {
+      MAPLE_LOG_INFO(LogRHI, "Found required Vulkan instance extension: {}",
+                             req_extension);
+    } else {
+      MAPLE_LOG_CRITICAL(LogRHI, "Required Vulkan instance extension not "
+                                 "available: {}", req_extension);
+      all_extensions_available = false;
+    }
+  }
+
+  // Abort if any required layers or extensions are unavailable
+  if (!all_layers_available || !all_extensions_available) {
+    const std::string msg{ "One or more required Vulkan layers or extensions "
+                           "are unavailable" };
+    MAPLE_LOG_CRITICAL(LogRHI, msg);
+    throw std::runtime_error{ msg };
+  }
+}
+
+std::pair<std::vector<std::string>, std::vector<std::string>>
+VulkanRHI::ValidateOptionalLayersAndExtensions(
+  const std::vector<std::string>& opt_layers,
+  const std::vector<std::string>& opt_extensions,
+  const std::unordered_set<std::string>& available_layers,
+  const std::unordered_set<std::string>& available_extensions
+) {
+  std::vector<std::string> validated_layers{};
+  std::vector<std::string> validated_extensions{};
+
+  // Validate optional layers and keep only available ones
+  for (const auto& opt_layer : opt_layers) {
+    if (available_layers.contains(opt_layer)) {
+      MAPLE_LOG_INFO(LogRHI, "Found optional Vulkan layer: {}", opt_layer);
+      validated_layers.emplace_back(opt_layer);
+    } else {
+      MAPLE_LOG_WARN(LogRHI, "Optional Vulkan layer not available: {}; "
+                             "skipping", opt_layer);
+    }
+  }
+
+  // Validate optional extensions and keep only available ones
+  for (const auto& opt_extension : opt_extensions) {
+    if (available_extensions.contains(opt_extension)) {
+      MAPLE_LOG_INFO(LogRHI, "Found optional Vulkan instance extension: {}",
+                             opt_extension);
+      validated_extensions.emplace_back(opt_extension);
+
+      // Track device address binding extension availability separately
+      if (opt_extension == VK_EXT_DEVICE_ADDRESS_BINDING_REPORT_EXTENSION_NAME) {
+        device_address_binding_available_ = true;
+      }
+    } else {
+      MAPLE_LOG_WARN(LogRHI, "Optional Vulkan instance extension not "
+                             "available: {}; skipping", opt_extension);
+    }
+  }
+
+  return std::make_pair(validated_layers, validated_extensions);
+}
+
+void VulkanRHI::CreateDebugMessenger() {
+  MAPLE_LOG_INFO(LogRHI, "Creating Vulkan debug messenger...");
+
+  // Configure which message severities to capture
+  constexpr vk::DebugUtilsMessageSeverityFlagsEXT message_severities{
+    vk::DebugUtilsMessageSeverityFlagBitsEXT::eVerbose |
+    vk::DebugUtilsMessageSeverityFlagBitsEXT::eInfo |
+    vk::DebugUtilsMessageSeverityFlagBitsEXT::eWarning |
+    vk::DebugUtilsMessageSeverityFlagBitsEXT::eError
+  };
+
+  // Configure debug messenger message types based on available extensions
+  vk::DebugUtilsMessageTypeFlagsEXT message_types =
+    vk::DebugUtilsMessageTypeFlagBitsEXT::eGeneral |
+    vk::DebugUtilsMessageTypeFlagBitsEXT::eValidation |
+    vk::DebugUtilsMessageTypeFlagBitsEXT::ePerformance;
+
+  // Add device address binding messages if extension is available
+  if (device_address_binding_available_) {
+    message_types |= vk::DebugUtilsMessageTypeFlagBitsEXT::eDeviceAddressBinding;
+  }
+
+  // Configure debug messenger to capture all message severities and types
+  const vk::DebugUtilsMessengerCreateInfoEXT create_info{
+    .messageSeverity = message_severities,
+    .messageType = message_types,
+    .pfnUserCallback = DebugCallback
+  };
+
+  // Create debug messenger and attach to instance
+  debug_messenger_ = instance_->createDebugUtilsMessengerEXTUnique(create_info);
+
+  MAPLE_LOG_INFO(LogRHI, "Vulkan debug messenger created");
+}
+
+void VulkanRHI::CreateSurface() {
+  MAPLE_LOG_INFO(LogRHI, "Creating Vulkan surface...");
+
+  VkSurfaceKHR surface{ VK_NULL_HANDLE };
+  if (!SDL_Vulkan_CreateSurface(window_->GetSDLWindow(),
+                                static_cast<VkInstance>(*instance_), nullptr,
+                                &surface)) {
+    const std::string msg{ std::format("Failed to create Vulkan surface: {}",
+                                       SDL_GetError()) };
+    MAPLE_LOG_CRITICAL(LogRHI, msg);
+    throw std::runtime_error{ msg };
+  }
+  surface_ = vk::UniqueSurfaceKHR{ vk::SurfaceKHR{ surface }, *instance_ };
+
+  MAPLE_LOG_INFO(LogRHI, "Vulkan surface created");
+}
+
+void VulkanRHI::SelectPhysicalDevice(const RHIConfig& config) {
+  MAPLE_LOG_INFO(LogRHI, "Selecting Vulkan physical device...");
+
+  // Evaluate every device the loader reports
+  const auto physical_devices{ instance_->enumeratePhysicalDevices() };
+  std::vector<DeviceCandidate> candidates{};
+  for (std::size_t i{ 0U }; i < physical_devices.size(); ++i) {
+    DeviceCandidate& candidate{
+      candidates.emplace_back(EvaluateDevice(physical_devices[i], *surface_))
+    };
+    if (candidate.rejection.empty()) {
+      MAPLE_LOG_INFO(LogRHI, "Found Vulkan device {}: {} (type rank {}, {} "
+                             "optional feature(s), {} MiB local memory)",
+                             i, candidate.name, candidate.score.type_rank,
+                             candidate.score.feature_count,
+                             candidate.score.local_heap_size / (1024U * 1024U));
+    } else {
+      MAPLE_LOG_INFO(LogRHI, "Found Vulkan device {}: {} (unsuitable: {})",
+                             i, candidate.name, candidate.rejection);
+    }
+  }
+
+  // Honor an explicit override, otherwise take the best suitable device
+  const DeviceCandidate* selected{ nullptr };
+  if (config.device_index >= 0) {
+    const auto index{ static_cast<std::size_t>(config.device_index) };
+    if (index >= candidates.size()) {
+      const std::string msg{ std::format("Vulkan device index {} out of range; "
+                                         "{} device(s) available",
+                                         index, candidates.size()) };
+      MAPLE_LOG_CRITICAL(LogRHI, msg);
+      throw std::runtime_error{ msg };
+    }
+    selected = &candidates[index];
+  } else if (!config.device_name.empty()) {
+    const auto it{ std::ranges::find_if(candidates, [&](const auto& candidate) {
+      return candidate.name.find(config.device_name) != std::string::npos;
+    }) };
+    if (it == candidates.end()) {
+      const std::string msg{ std::format("No Vulkan device name contains '{}'",
+                                         config.device_name) };
+      MAPLE_LOG_CRITICAL(LogRHI, msg);
+      throw std::runtime_error{ msg };
+    }
+    selected = &*it;
+  } else {
+    for (const DeviceCandidate& candidate : candidates) {
+      if (candidate.rejection.empty()
+          && (!selected || candidate.score > selected->score)) {
+        selected = &candidate;
+      }
+    }
+    if (!selected) {
+      const std::string msg{ "No suitable Vulkan device found" };
+      MAPLE_LOG_CRITICAL(LogRHI, msg);
+      throw std::runtime_error{ msg };
+    }
+  }
+
+  // A forced device must still be usable
+  if (!selected->rejection.empty()) {
+    const std::string msg{ std::format("Vulkan device {} is unsuitable: {}",
+                                       selected->name, selected->rejection) };
+    MAPLE_LOG_CRITICAL(LogRHI, msg);
+    throw std::runtime_error{ msg };
+  }
+
+  physical_device_ = selected->physical_device;
+  queue_families_ = selected->queue_families;
+  MAPLE_LOG_INFO(LogRHI, "Selected Vulkan device: {} (queue families: "
+                         "graphics {}, compute {} queue {}, transfer {})",
+                         selected->name, queue_families_.graphics,
+                         queue_families_.compute,
+                         queue_families_.compute_queue_index,
+                         queue_families_.transfer);
+}
+
+void VulkanRHI::CreateLogicalDevice() {
+  MAPLE_LOG_INFO(LogRHI, "Creating Vulkan logical device...");
+
+  // One queue from each distinct family, plus a second graphics family
+  // queue for async compute if it has no family of its own
+  constexpr float kQueuePriorities[]{ 1.0F, 1.0F };
+  std::vector<std::uint32_t> families{ queue_families_.graphics };
+  for (const std::uint32_t family : { queue_families_.compute,
+                                      queue_families_.transfer }) {
+    if (std::ranges::find(families, family) == families.end()) {
+      families.emplace_back(family);
+    }
+  }
+  std::vector<vk::DeviceQueueCreateInfo> queue_infos{};
+  for (const std::uint32_t family : families) {
+    queue_infos.emplace_back(vk::DeviceQueueCreateInfo{
+      .queueFamilyIndex = family,
+      .queueCount = family == queue_families_.compute
+                      ? queue_families_.compute_queue_index + 1U
+                      : 1U,
+      .pQueuePriorities = kQueuePriorities
+    });
+  }
+
+  // Enable required features plus supported optional ones
+  const auto supported{
+    physical_device_.getFeatures2<vk::PhysicalDeviceFeatures2,
+                                  vk::PhysicalDeviceVulkan12Features>()
+  };
+  // Descriptor indexing features back the bindless heap
+  const auto& supported12{
+    supported.get<vk::PhysicalDeviceVulkan12Features>()
+  };
+  vk::PhysicalDeviceVulkan12Features features12{
+    .shaderSampledImageArrayNonUniformIndexing = vk::True,
+    .shaderStorageBufferArrayNonUniformIndexing =
+      supported12.shaderStorageBufferArrayNonUniformIndexing,
+    .shaderStorageImageArrayNonUniformIndexing =
+      supported12.shaderStorageImageArrayNonUniformIndexing,
+    .descriptorBindingSampledImageUpdateAfterBind = vk::True,
+    .descriptorBindingStorageImageUpdateAfterBind = vk::True,
+    .descriptorBindingStorageBufferUpdateAfterBind = vk::True,
+    .descriptorBindingUpdateUnusedWhilePending = vk::True,
+    .descriptorBindingPartiallyBound = vk::True,
+    .runtimeDescriptorArray = vk::True,
+    .hostQueryReset = supported12.hostQueryReset,
+    .timelineSemaphore = vk::True
+  };
+  host_query_reset_enabled_ = supported12.hostQueryReset == vk::True;
+  vk::PhysicalDeviceFeatures2 features{ .pNext = &features12 };
+  features.features.samplerAnisotropy =
+    supported.get<vk::PhysicalDeviceFeatures2>().features.samplerAnisotropy;
+
+  // Enable the required extensions, plus memory budget queries if the
+  // driver supports them
+  std::vector<const char*> extensions{ kRequiredDeviceExtensions.begin(),
+                                       kRequiredDeviceExtensions.end() };
+  for (const auto& extension
+       : physical_device_.enumerateDeviceExtensionProperties()) {
+    if (std::string_view{ extension.extensionName.data() }
+        == VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) {
+      extensions.emplace_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+      memory_budget_enabled_ = true;
+    }
+  }
+
+  // Create the device
+  const vk::DeviceCreateInfo create_info{
+    .pNext = &features,
+    .queueCreateInfoCount = static_cast<std::uint32_t>(queue_infos.size()),
+    .pQueueCreateInfos = queue_infos.data(),
+    .enabledExtensionCount = static_cast<std::uint32_t>(extensions.size()),
+    .ppEnabledExtensionNames = extensions.data()
+  };
+  device_ = physical_device_.createDeviceUnique(create_info);
+
+  // Initialize the default dynamic dispatcher with device-level functions
+  VULKAN_HPP_DEFAULT_DISPATCHER.init(*device_);
+
+  // Retrieve the queues; roles without a dedicated family share a queue
+  graphics_queue_ = device_->getQueue(queue_families_.graphics, 0U);
+  compute_queue_ = device_->getQueue(queue_families_.compute,
+                                     queue_families_.compute_queue_index);
+  transfer_queue_ = device_->getQueue(queue_families_.transfer, 0U);
+
+  MAPLE_LOG_INFO(LogRHI, "Vulkan logical device created with {} queue(s)",
+                         queue_infos.size());
+}
 
-  // Validate optional layers and keep only available ones
-  for (const auto& opt_layer : opt_layers) {
-    if (available_layers.contains(opt_layer)) {
-      MAPLE_LOG_INFO(LogRHI, "Found optional Vulkan layer: {}", opt_layer);
-      validated_layers.emplace_back(opt_layer);
-    } else {
-      MAPLE_LOG_WARN(LogRHI, "Optional Vulkan layer not available: {}; "
-                             "skipping", opt_layer);
+void VulkanRHI::CreateFrameResources(std::uint32_t frames_in_flight) {
+  MAPLE_LOG_INFO(LogRHI, "Creating resources for {} frame(s) in flight...",
+                         frames_in_flight);
+
+  // One timeline semaphore tracks the completion of every frame
+  const vk::SemaphoreTypeCreateInfo timeline_info{
+    .semaphoreType = vk::SemaphoreType::eTimeline,
+    .initialValue = 0U
+  };
+  frame_timeline_ = device_->createSemaphoreUnique(vk::SemaphoreCreateInfo{
+    .pNext = &timeline_info
+  });
+
+  // Another orders the graphics queue after async compute batches
+  compute_timeline_ = device_->createSemaphoreUnique(vk::SemaphoreCreateInfo{
+    .pNext = &timeline_info
+  });
+
+  // Per-frame command pools and acquire semaphores
+  frames_.resize(frames_in_flight);
+  for (FrameResources& frame : frames_) {
+    frame.command_pool = device_->createCommandPoolUnique(
+      vk::CommandPoolCreateInfo{
+        .flags = vk::CommandPoolCreateFlagBits::eTransient,
+        .queueFamilyIndex = queue_families_.graphics
+      }
+    );
+    frame.command_buffer = device_->allocateCommandBuffers(
+      vk::CommandBufferAllocateInfo{
+        .commandPool = *frame.command_pool,
+        .level = vk::CommandBufferLevel::ePrimary,
+        .commandBufferCount = 1U
+      }
+    ).front();
+    if (async_compute_) {
+      frame.compute_command_pool = device_->createCommandPoolUnique(
+        vk::CommandPoolCreateInfo{
+          .flags = vk::CommandPoolCreateFlagBits::eTransient,
+          .queueFamilyIndex = queue_families_.compute
+        }
+      );
     }
+    frame.image_available = device_->createSemaphoreUnique(
+      vk::SemaphoreCreateInfo{}
+    );
   }
 
-  // Validate optional extensions and keep only available ones
-  for (const auto& opt_extension : opt_extensions) {
-    if (available_extensions.contains(opt_extension)) {
-      MAPLE_LOG_INFO(LogRHI, "Found optional Vulkan instance extension: {}",
-                             opt_extension);
-      validated_extensions.emplace_back(opt_extension);
+  MAPLE_LOG_INFO(LogRHI, "Frame resources created");
+}
 
-      // Track device address binding extension availability separately
-      if (opt_extension == VK_EXT_DEVICE_ADDRESS_BINDING_REPORT_EXTENSION_NAME) {
-        device_address_binding_available_ = true;
+void VulkanRHI::CreateTransientBuffer(std::uint64_t size,
+                                      std::uint32_t frames_in_flight) {
+  // Offsets handed out must satisfy the device's dynamic offset alignments,
+  // which Vulkan caps at the ring's maximum alignment
+  const vk::PhysicalDeviceLimits limits{
+    physical_device_.getProperties().limits
+  };
+  uniform_alignment_ = std::min(limits.minUniformBufferOffsetAlignment,
+                                FrameRingAllocator::kMaxAlignment);
+  storage_alignment_ = std::min(limits.minStorageBufferOffsetAlignment,
+                                FrameRingAllocator::kMaxAlignment);
+
+  // One mapped buffer holds every frame's segment, so steady-state frames
+  // neither map memory nor create buffers
+  const std::uint64_t segment_size{
+    FrameRingAllocator::RoundSegmentSize(size)
+  };
+  transient_allocator_ = std::make_unique<FrameRingAllocator>(
+    segment_size, frames_in_flight
+  );
+  transient_buffer_ = CreateBuffer(BufferDesc{
+    .size = transient_allocator_->GetSize(),
+    .usage = BufferUsage::Vertex | BufferUsage::Index | BufferUsage::Uniform
+             | BufferUsage::Storage | BufferUsage::Indirect,
+    .memory_usage = MemoryUsage::CpuToGpu
+  });
+  transient_data_ = static_cast<std::byte*>(MapBuffer(transient_buffer_));
+
+  discard_transient_allocator_ = std::make_unique<FrameRingAllocator>(
+    segment_size, 1U
+  );
+  discard_transient_data_ = std::make_unique<std::byte[]>(segment_size);
+
+  MAPLE_LOG_INFO(LogRHI, "Transient buffer created ({} KiB per frame)",
+                         segment_size / 1024U);
+}
+
+void VulkanRHI::CreateGpuTimer(std::uint32_t max_zones) {
+  if (max_zones == 0U) {
+    MAPLE_LOG_INFO(LogRHI, "GPU timing disabled");
+    return;
+  }
+
+  // Pools are reset from the host, since lists of the compute queue may
+  // start before the frame's first graphics commands
+  const auto families{ physical_device_.getQueueFamilyProperties() };
+  const std::uint32_t graphics_bits{
+    families[queue_families_.graphics].timestampValidBits
+  };
+  if (!host_query_reset_enabled_ || graphics_bits == 0U) {
+    MAPLE_LOG_WARN(LogRHI, "GPU timing unsupported by the device");
+    return;
+  }
+  const std::uint32_t compute_bits{
+    async_compute_ ? families[queue_families_.compute].timestampValidBits
+                   : graphics_bits
+  };
+  gpu_timer_ = std::make_unique<VulkanGpuTimer>(
+    *device_, physical_device_.getProperties().limits.timestampPeriod,
+    std::array{ graphics_bits, compute_bits }, frames_.size(), max_zones
+  );
+  MAPLE_LOG_INFO(LogRHI, "GPU timing enabled ({} zone(s) per frame)",
+                 max_zones);
+}
+
+void VulkanRHI::CreatePipelineResources(const RHIConfig& config) {
+  pipeline_cache_ = std::make_unique<VulkanPipelineCache>(
+    physical_device_, *device_, config.pipeline_cache_path
+  );
+  pipeline_state_cache_ = std::make_unique<PipelineStateCache<PipelineHandle>>(
+    config.max_cached_pipelines
+  );
+  descriptor_heap_ = std::make_unique<VulkanDescriptorHeap>(
+    physical_device_, *device_, config.max_bindless_textures,
+    config.max_bindless_buffers
+  );
+
+  // Every pipeline sees the bindless heap and the same push constants, so
+  // bindings survive pipeline switches
+  const std::span<const vk::DescriptorSetLayout> set_layouts{
+    descriptor_heap_->GetSetLayouts()
+  };
+  const vk::PushConstantRange push_constants{
+    .stageFlags = vk::ShaderStageFlagBits::eAllGraphics
+                  | vk::ShaderStageFlagBits::eCompute,
+    .offset = 0U,
+    .size = kPushConstantSize
+  };
+  pipeline_layout_ = device_->createPipelineLayoutUnique(
+    vk::PipelineLayoutCreateInfo{
+      .setLayoutCount = static_cast<std::uint32_t>(set_layouts.size()),
+      .pSetLayouts = set_layouts.data(),
+      .pushConstantRangeCount = 1U,
+      .pPushConstantRanges = &push_constants
+    }
+  );
+}
+
+vk::UniqueImage VulkanRHI::CreateImage(const TextureDesc& desc) const {
+  if (desc.width == 0U || desc.height == 0U || desc.mip_levels == 0U
+      || desc.usage == TextureUsage::None) {
+    const std::string msg{ "Texture size, mip levels, and usage must be "
+                           "nonzero" };
+    MAPLE_LOG_CRITICAL(LogRHI, msg);
+    throw std::runtime_error{ msg };
+  }
+
+  // Sampled and storage textures are filled by uploads
+  vk::ImageUsageFlags usage{ ToVulkanTextureUsage(desc.usage) };
+  if (HasUsage(desc.usage, TextureUsage::Sampled)
+      || HasUsage(desc.usage, TextureUsage::Storage)) {
+    usage |= vk::ImageUsageFlagBits::eTransferDst;
+  }
+  return device_->createImageUnique(vk::ImageCreateInfo{
+    .imageType = vk::ImageType::e2D,
+    .format = ToVulkanFormat(desc.format),
+    .extent = vk::Extent3D{
+      .width = desc.width,
+      .height = desc.height,
+      .depth = 1U
+    },
+    .mipLevels = desc.mip_levels,
+    .arrayLayers = 1U,
+    .samples = vk::SampleCountFlagBits::e1,
+    .tiling = vk::ImageTiling::eOptimal,
+    .usage = usage,
+    .sharingMode = vk::SharingMode::eExclusive,
+    .initialLayout = vk::ImageLayout::eUndefined
+  });
+}
+
+TextureHandle VulkanRHI::AddTexture(vk::UniqueImage image,
+                                    const VulkanAllocation& allocation,
+                                    MemoryHeapHandle heap,
+                                    const TextureDesc& desc) {
+  vk::UniqueImageView view{ nullptr };
+  try {
+    view = device_->createImageViewUnique(vk::ImageViewCreateInfo{
+      .image = *image,
+      .viewType = vk::ImageViewType::e2D,
+      .format = ToVulkanFormat(desc.format),
+      .subresourceRange = vk::ImageSubresourceRange{
+        .aspectMask = GetAspectMask(desc.format),
+        .baseMipLevel = 0U,
+        .levelCount = desc.mip_levels,
+        .baseArrayLayer = 0U,
+        .layerCount = 1U
       }
-    } else {
-      MAPLE_LOG_WARN(LogRHI, "Optional Vulkan instance extension not "
-                             "available: {}; skipping", opt_extension);
+    });
+  } catch (...) {
+    memory_allocator_->Free(allocation);
+    throw;
+  }
+
+  // Publish the texture to shaders, once per way it may be read
+  std::uint32_t sampled_index{ kInvalidBindlessIndex };
+  std::uint32_t storage_index{ kInvalidBindlessIndex };
+  if (HasUsage(desc.usage, TextureUsage::Sampled)) {
+    sampled_index = descriptor_heap_->AddSampledImage(*view);
+  }
+  if (HasUsage(desc.usage, TextureUsage::Storage)) {
+    storage_index = descriptor_heap_->AddStorageImage(*view);
+  }
+  if ((HasUsage(desc.usage, TextureUsage::Sampled)
+       && sampled_index == kInvalidBindlessIndex)
+      || (HasUsage(desc.usage, TextureUsage::Storage)
+          && storage_index == kInvalidBindlessIndex)) {
+    descriptor_heap_->Remove(BindlessSet::SampledTextures, sampled_index);
+    descriptor_heap_->Remove(BindlessSet::StorageTextures, storage_index);
+    memory_allocator_->Free(allocation);
+    const std::string msg{ "Bindless heap is full; raise "
+                           "RHIConfig::max_bindless_textures" };
+    MAPLE_LOG_CRITICAL(LogRHI, msg);
+    throw std::runtime_error{ msg };
+  }
+
+  std::lock_guard lock{ resource_mutex_ };
+  return textures_.Add(VulkanTexture{
+    .image = std::move(image),
+    .view = std::move(view),
+    .allocation = allocation,
+    .heap = heap,
+    .desc = desc,
+    .sampled_index = sampled_index,
+    .storage_index = storage_index
+  });
+}
+
+vk::UniquePipeline VulkanRHI::CompileGraphicsPipeline(
+  const GraphicsPipelineDesc& desc
+) {
+  MAPLE_PROFILE_FUNCTION(LogRHI);
+
+  // Hold on to the modules, since the shaders may be destroyed meanwhile
+  std::shared_ptr<vk::UniqueShaderModule> vertex_module{ nullptr };
+  std::shared_ptr<vk::UniqueShaderModule> fragment_module{ nullptr };
+  {
+    std::lock_guard lock{ resource_mutex_ };
+    const VulkanShader* vertex_shader{ shaders_.Get(desc.vertex_shader) };
+    const VulkanShader* fragment_shader{ shaders_.Get(desc.fragment_shader) };
+    if (!vertex_shader || !fragment_shader
+        || vertex_shader->stage != ShaderStage::Vertex
+        || fragment_shader->stage != ShaderStage::Fragment) {
+      const std::string msg{ "Pipeline shaders are stale or bound to the "
+                             "wrong stage" };
+      MAPLE_LOG_ERROR(LogRHI, msg);
+      throw std::runtime_error{ msg };
     }
+    vertex_module = vertex_shader->module;
+    fragment_module = fragment_shader->module;
+  }
+  if (const char* error{ FindPipelineDescError(desc) }) {
+    const std::string msg{ std::format("Invalid pipeline description: {}",
+                                       error) };
+    MAPLE_LOG_ERROR(LogRHI, msg);
+    throw std::runtime_error{ msg };
   }
 
-  return std::make_pair(validated_layers, validated_extensions);
+  const std::array stages{
+    vk::PipelineShaderStageCreateInfo{
+      .stage = vk::ShaderStageFlagBits::eVertex,
+      .module = **vertex_module,
+      .pName = "main"
+    },
+    vk::PipelineShaderStageCreateInfo{
+      .stage = vk::ShaderStageFlagBits::eFragment,
+      .module = **fragment_module,
+      .pName = "main"
+    }
+  };
+
+  // Vertex input
+  std::array<vk::VertexInputBindingDescription, kMaxVertexBindings>
+    bindings{};
+  for (std::uint32_t i{ 0U }; i < desc.vertex_binding_count; ++i) {
+    bindings[i] = vk::VertexInputBindingDescription{
+      .binding = i,
+      .stride = desc.vertex_bindings[i].stride,
+      .inputRate = desc.vertex_bindings[i].per_instance
+                     ? vk::VertexInputRate::eInstance
+                     : vk::VertexInputRate::eVertex
+    };
+  }
+  std::array<vk::VertexInputAttributeDescription, kMaxVertexAttributes>
+    attributes{};
+  for (std::uint32_t i{ 0U }; i < desc.vertex_attribute_count; ++i) {
+    const VertexAttribute& attribute{ desc.vertex_attributes[i] };
+    attributes[i] = vk::VertexInputAttributeDescription{
+      .location = attribute.location,
+      .binding = attribute.binding,
+      .format = ToVulkanVertexFormat(attribute.format),
+      .offset = attribute.offset
+    };
+  }
+  const vk::PipelineVertexInputStateCreateInfo vertex_input{
+    .vertexBindingDescriptionCount = desc.vertex_binding_count,
+    .pVertexBindingDescriptions = bindings.data(),
+    .vertexAttributeDescriptionCount = desc.vertex_attribute_count,
+    .pVertexAttributeDescriptions = attributes.data()
+  };
+  const vk::PipelineInputAssemblyStateCreateInfo input_assembly{
+    .topology = ToVulkanTopology(desc.topology)
+  };
+
+  // Fixed-function state; viewport and scissor are set while recording
+  const vk::PipelineViewportStateCreateInfo viewport{
+    .viewportCount = 1U,
+    .scissorCount = 1U
+  };
+  const vk::PipelineRasterizationStateCreateInfo rasterization{
+    .polygonMode = vk::PolygonMode::eFill,
+    .cullMode = ToVulkanCullMode(desc.cull_mode),
+    .frontFace = vk::FrontFace::eCounterClockwise,
+    .lineWidth = 1.0F
+  };
+  const vk::PipelineMultisampleStateCreateInfo multisample{
+    .rasterizationSamples = vk::SampleCountFlagBits::e1
+  };
+  const vk::PipelineDepthStencilStateCreateInfo depth_stencil{
+    .depthTestEnable = desc.depth_test ? vk::True : vk::False,
+    .depthWriteEnable = desc.depth_write ? vk::True : vk::False,
+    .depthCompareOp = ToVulkanCompareOp(desc.depth_compare)
+  };
+  const vk::PipelineColorBlendAttachmentState blend_attachment{
+    GetBlendState(desc.blend_mode)
+  };
+  const vk::PipelineColorBlendStateCreateInfo color_blend{
+    .attachmentCount = 1U,
+    .pAttachments = &blend_attachment
+  };
+  constexpr std::array kDynamicStates{ vk::DynamicState::eViewport,
+                                       vk::DynamicState::eScissor };
+  const vk::PipelineDynamicStateCreateInfo dynamic_state{
+    .dynamicStateCount = static_cast<std::uint32_t>(kDynamicStates.size()),
+    .pDynamicStates = kDynamicStates.data()
+  };
+
+  const vk::GraphicsPipelineCreateInfo create_info{
+    .stageCount = static_cast<std::uint32_t>(stages.size()),
+    .pStages = stages.data(),
+    .pVertexInputState = &vertex_input,
+    .pInputAssemblyState = &input_assembly,
+    .pViewportState = &viewport,
+    .pRasterizationState = &rasterization,
+    .pMultisampleState = &multisample,
+    .pDepthStencilState = &depth_stencil,
+    .pColorBlendState = &color_blend,
+    .pDynamicState = &dynamic_state,
+    .layout = *pipeline_layout_,
+    .renderPass = GetCompatibleRenderPass(
+      ToVulkanFormat(desc.color_format),
+      desc.depth_format ? ToVulkanFormat(*desc.depth_format)
+                        : vk::Format::eUndefined
+    ),
+    .subpass = 0U
+  };
+
+  // Compile, timing the driver so cache hits show up in the stats
+  const auto start{ std::chrono::steady_clock::now() };
+  auto compiled{ device_->createGraphicsPipelineUnique(
+    pipeline_cache_->Get(), create_info
+  ) };
+  const auto elapsed{ std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - start
+  ) };
+  pipeline_compile_microseconds_.fetch_add(
+    static_cast<std::uint64_t>(elapsed.count()), std::memory_order_relaxed
+  );
+  if (compiled.result != vk::Result::eSuccess) {
+    const std::string msg{ std::format("Failed to compile pipeline: {}",
+                                       vk::to_string(compiled.result)) };
+    MAPLE_LOG_ERROR(LogRHI, msg);
+    throw std::runtime_error{ msg };
+  }
+
+  pipelines_compiled_.fetch_add(1U, std::memory_order_relaxed);
+  return std::move(compiled.value);
 }
 
-void VulkanRHI::CreateDebugMessenger() {
-  MAPLE_LOG_INFO(LogRHI, "Creating Vulkan debug messenger...");
+vk::RenderPass VulkanRHI::GetCompatibleRenderPass(vk::Format color_format,
+                                                  vk::Format depth_format) {
+  const std::uint64_t key{
+    (static_cast<std::uint64_t>(color_format) << 32U)
+    | static_cast<std::uint32_t>(depth_format)
+  };
+  std::lock_guard lock{ render_pass_mutex_ };
+  if (const auto it{ render_passes_.find(key) }; it != render_passes_.end()) {
+    return *it->second;
+  }
 
-  // Configure which message severities to capture
-  constexpr vk::DebugUtilsMessageSeverityFlagsEXT message_severities{
-    vk::DebugUtilsMessageSeverityFlagBitsEXT::eVerbose |
-    vk::DebugUtilsMessageSeverityFlagBitsEXT::eInfo |
-    vk::DebugUtilsMessageSeverityFlagBitsEXT::eWarning |
-    vk::DebugUtilsMessageSeverityFlagBitsEXT::eError
+  // Load and store ops do not affect compatibility
+  const bool has_depth{ depth_format != vk::Format::eUndefined };
+  const std::array attachments{
+    vk::AttachmentDescription{
+      .format = color_format,
+      .samples = vk::SampleCountFlagBits::e1,
+      .loadOp = vk::AttachmentLoadOp::eDontCare,
+      .storeOp = vk::AttachmentStoreOp::eStore,
+      .stencilLoadOp = vk::AttachmentLoadOp::eDontCare,
+      .stencilStoreOp = vk::AttachmentStoreOp::eDontCare,
+      .initialLayout = vk::ImageLayout::eColorAttachmentOptimal,
+      .finalLayout = vk::ImageLayout::eColorAttachmentOptimal
+    },
+    vk::AttachmentDescription{
+      .format = depth_format,
+      .samples = vk::SampleCountFlagBits::e1,
+      .loadOp = vk::AttachmentLoadOp::eDontCare,
+      .storeOp = vk::AttachmentStoreOp::eStore,
+      .stencilLoadOp = vk::AttachmentLoadOp::eDontCare,
+      .stencilStoreOp = vk::AttachmentStoreOp::eDontCare,
+      .initialLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal,
+      .finalLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal
+    }
   };
+  const vk::AttachmentReference color_reference{
+    .attachment = 0U,
+    .layout = vk::ImageLayout::eColorAttachmentOptimal
+  };
+  const vk::AttachmentReference depth_reference{
+    .attachment = 1U,
+    .layout = vk::ImageLayout::eDepthStencilAttachmentOptimal
+  };
+  const vk::SubpassDescription subpass{
+    .pipelineBindPoint = vk::PipelineBindPoint::eGraphics,
+    .colorAttachmentCount = 1U,
+    .pColorAttachments = &color_reference,
+    .pDepthStencilAttachment = has_depth ? &depth_reference : nullptr
+  };
+  auto render_pass{ device_->createRenderPassUnique(vk::RenderPassCreateInfo{
+    .attachmentCount = has_depth ? 2U : 1U,
+    .pAttachments = attachments.data(),
+    .subpassCount = 1U,
+    .pSubpasses = &subpass
+  }) };
+  return *render_passes_.emplace(key, std::move(render_pass)).first->second;
+}
 
-  // Configure debug messenger message types based on available extensions
-  vk::DebugUtilsMessageTypeFlagsEXT message_types =
-    vk::DebugUtilsMessageTypeFlagBitsEXT::eGeneral |
-    vk::DebugUtilsMessageTypeFlagBitsEXT::eValidation |
-    vk::DebugUtilsMessageTypeFlagBitsEXT::ePerformance;
+bool VulkanRHI::CreateSwapchain() {
+  const vk::SurfaceCapabilitiesKHR capabilities{
+    physical_device_.getSurfaceCapabilitiesKHR(*surface_)
+  };
 
-  // Add device address binding messages if extension is available
-  if (device_address_binding_available_) {
-    message_types |= vk::DebugUtilsMessageTypeFlagBitsEXT::eDeviceAddressBinding;
+  // The surface dictates the extent unless it defers to the window
+  vk::Extent2D extent{ capabilities.currentExtent };
+  if (extent.width == std::numeric_limits<std::uint32_t>::max()) {
+    const platform::FramebufferSize size{ window_->GetFramebufferSize() };
+    extent.width = std::clamp(size.width, capabilities.minImageExtent.width,
+                              capabilities.maxImageExtent.width);
+    extent.height = std::clamp(size.height, capabilities.minImageExtent.height,
+                               capabilities.maxImageExtent.height);
+  }
+  if (extent.width == 0U || extent.height == 0U) {
+    return false;
   }
 
-  // Configure debug messenger to capture all message severities and types
-  const vk::DebugUtilsMessengerCreateInfoEXT create_info{
-    .messageSeverity = message_severities,
-    .messageType = message_types,
-    .pfnUserCallback = DebugCallback
+  // One image more than the minimum so acquiring rarely blocks
+  std::uint32_t image_count{ capabilities.minImageCount + 1U };
+  if (capabilities.maxImageCount != 0U) {
+    image_count = std::min(image_count, capabilities.maxImageCount);
+  }
+
+  const vk::SurfaceFormatKHR surface_format{ ChooseSurfaceFormat() };
+  const PresentMode present_mode{ requested_present_mode_.load() };
+  const vk::SwapchainCreateInfoKHR create_info{
+    .surface = *surface_,
+    .minImageCount = image_count,
+    .imageFormat = surface_format.format,
+    .imageColorSpace = surface_format.colorSpace,
+    .imageExtent = extent,
+    .imageArrayLayers = 1U,
+    .imageUsage = vk::ImageUsageFlagBits::eColorAttachment
+                  | vk::ImageUsageFlagBits::eTransferDst,
+    .imageSharingMode = vk::SharingMode::eExclusive,
+    .preTransform = capabilities.currentTransform,
+    .compositeAlpha = vk::CompositeAlphaFlagBitsKHR::eOpaque,
+    .presentMode = ChoosePresentMode(present_mode),
+    .clipped = vk::True,
+    .oldSwapchain = swapchain_.get()
+  };
+  vk::UniqueSwapchainKHR swapchain{
+    device_->createSwapchainKHRUnique(create_info)
   };
 
-  // Create debug messenger and attach to instance
-  debug_messenger_ = instance_->createDebugUtilsMessengerEXTUnique(create_info);
+  // Keep the old swapchain alive until the frames using it have completed,
+  // rather than waiting for the device to go idle
+  if (swapchain_) {
+    retired_swapchains_.emplace_back(RetiredSwapchain{
+      .swapchain = std::move(swapchain_),
+      .render_finished = std::move(render_finished_),
+      .timeline_value = timeline_value_
+    });
+  }
 
-  MAPLE_LOG_INFO(LogRHI, "Vulkan debug messenger created");
+  swapchain_ = std::move(swapchain);
+  swapchain_images_ = device_->getSwapchainImagesKHR(*swapchain_);
+  render_finished_.clear();
+  for (std::size_t i{ 0U }; i < swapchain_images_.size(); ++i) {
+    render_finished_.emplace_back(
+      device_->createSemaphoreUnique(vk::SemaphoreCreateInfo{})
+    );
+  }
+  swapchain_format_ = surface_format.format;
+  swapchain_extent_ = extent;
+  present_mode_ = present_mode;
+  swapchain_dirty_ = false;
+
+  MAPLE_LOG_INFO(LogRHI, "Vulkan swapchain created ({}x{}, {} image(s), {})",
+                         extent.width, extent.height, swapchain_images_.size(),
+                         vk::to_string(create_info.presentMode));
+  return true;
+}
+
+vk::SurfaceFormatKHR VulkanRHI::ChooseSurfaceFormat() const {
+  const auto formats{ physical_device_.getSurfaceFormatsKHR(*surface_) };
+
+  // Prefer 8-bit sRGB so shaders can write linear color
+  for (const vk::Format preferred : { vk::Format::eB8G8R8A8Srgb,
+                                      vk::Format::eR8G8B8A8Srgb }) {
+    for (const vk::SurfaceFormatKHR& format : formats) {
+      if (format.format == preferred
+          && format.colorSpace == vk::ColorSpaceKHR::eSrgbNonlinear) {
+        return format;
+      }
+    }
+  }
+
+  return formats.front();
+}
+
+vk::PresentModeKHR VulkanRHI::ChoosePresentMode(
+  PresentMode present_mode
+) const {
+  vk::PresentModeKHR requested{ vk::PresentModeKHR::eFifo };
+  switch (present_mode) {
+    case PresentMode::Fifo: {
+      requested = vk::PresentModeKHR::eFifo;
+      break;
+    }
+
+    case PresentMode::FifoRelaxed: {
+      requested = vk::PresentModeKHR::eFifoRelaxed;
+      break;
+    }
+
+    case PresentMode::Mailbox: {
+      requested = vk::PresentModeKHR::eMailbox;
+      break;
+    }
+
+    default: { break; }
+  }
+
+  // FIFO is the only mode every device must support
+  const auto supported{ physical_device_.getSurfacePresentModesKHR(*surface_) };
+  if (std::ranges::find(supported, requested) != supported.end()) {
+    return requested;
+  }
+  MAPLE_LOG_WARN(LogRHI, "Present mode {} unsupported; falling back to FIFO",
+                         vk::to_string(requested));
+  return vk::PresentModeKHR::eFifo;
+}
+
+void VulkanRHI::DestroyRetiredSwapchains() {
+  if (retired_swapchains_.empty()) {
+    return;
+  }
+
+  // A retired swapchain is unused once a frame submitted after it completes
+  const std::uint64_t completed{
+    device_->getSemaphoreCounterValue(*frame_timeline_)
+  };
+  std::erase_if(retired_swapchains_, [&](const RetiredSwapchain& retired) {
+    return completed > retired.timeline_value;
+  });
+}
+
+void VulkanRHI::ReleaseRetiredResources() {
+  // Resources destroyed since the last frame may be used by any frame
+  // submitted so far, but by none recorded from now on
+  {
+    std::lock_guard lock{ resource_mutex_ };
+    for (RetiredResource& resource : pending_destroys_) {
+      resource.timeline_value = timeline_value_;
+      retired_resources_.emplace_back(std::move(resource));
+    }
+    pending_destroys_.clear();
+  }
+  if (retired_resources_.empty()) {
+    return;
+  }
+
+  // Uploads may still be copying into a resource no frame has used yet
+  const std::uint64_t completed{
+    device_->getSemaphoreCounterValue(*frame_timeline_)
+  };
+  const std::uint64_t upload_completed{ upload_queue_->GetCompletedValue() };
+  std::erase_if(retired_resources_, [&](RetiredResource& resource) {
+    if (completed < resource.timeline_value
+        || upload_completed < resource.upload_ticket) {
+      return false;
+    }
+    DestroyResource(resource);
+    return true;
+  });
+}
+
+void VulkanRHI::DefragmentBuffers(vk::CommandBuffer command_buffer) {
+  std::lock_guard lock{ resource_mutex_ };
+  if (!memory_allocator_->BeginDefragmentation()) {
+    return;
+  }
+
+  // Copy buffers out of the source blocks until the pass limit; buffers that
+  // find no room elsewhere stay where they are
+  vk::DeviceSize moved_bytes{ 0U };
+  bool copied{ false };
+  buffers_.ForEach([&](BufferHandle, VulkanBuffer& buffer) {
+    // Bindless descriptors of storage buffers may be read by frames in
+    // flight, so they cannot be pointed at a copy
+    if (moved_bytes >= kMaxDefragmentationBytes
+        || buffer.desc.memory_usage != MemoryUsage::GpuOnly
+        || buffer.bindless_index != kInvalidBindlessIndex
+        || !upload_queue_->IsComplete(buffer.upload_ticket)
+        || !memory_allocator_->IsDefragmentationSource(buffer.allocation)) {
+      return;
+    }
+
+    vk::UniqueBuffer new_buffer{ device_->createBufferUnique(
+      vk::BufferCreateInfo{
+        .size = buffer.desc.size,
+        .usage = ToVulkanBufferUsage(buffer.desc.usage)
+                 | vk::BufferUsageFlagBits::eTransferSrc
+                 | vk::BufferUsageFlagBits::eTransferDst,
+        .sharingMode = vk::SharingMode::eExclusive
+      }
+    ) };
+    const std::optional<VulkanAllocation> allocation{
+      memory_allocator_->AllocateRelocation(*new_buffer, buffer.allocation)
+    };
+    if (!allocation) {
+      return;
+    }
+
+    // Earlier frames may still be writing the buffer
+    if (!copied) {
+      const vk::MemoryBarrier barrier{
+        .srcAccessMask = vk::AccessFlagBits::eMemoryWrite,
+        .dstAccessMask = vk::AccessFlagBits::eTransferRead
+      };
+      command_buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eAllCommands,
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::DependencyFlags{}, barrier, nullptr, nullptr
+      );
+      copied = true;
+    }
+    command_buffer.copyBuffer(*buffer.buffer, *new_buffer, vk::BufferCopy{
+      .srcOffset = 0U,
+      .dstOffset = 0U,
+      .size = buffer.desc.size
+    });
+
+    // The handle now resolves to the copy; the original is retired like a
+    // destroyed buffer, since in-flight frames may still read it
+    pending_destroys_.emplace_back(RetiredResource{
+      .buffer = std::move(buffer.buffer),
+      .allocation = buffer.allocation
+    });
+    buffer.buffer = std::move(new_buffer);
+    buffer.allocation = *allocation;
+    moved_bytes += buffer.desc.size;
+  });
+
+  // Make the copies visible to the rest of the frame
+  if (copied) {
+    const vk::MemoryBarrier barrier{
+      .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+      .dstAccessMask = vk::AccessFlagBits::eMemoryRead
+                       | vk::AccessFlagBits::eMemoryWrite
+    };
+    command_buffer.pipelineBarrier(
+      vk::PipelineStageFlagBits::eTransfer,
+      vk::PipelineStageFlagBits::eAllCommands,
+      vk::DependencyFlags{}, barrier, nullptr, nullptr
+    );
+  }
+  memory_allocator_->EndDefragmentation(moved_bytes);
+
+  MAPLE_LOG_INFO(LogRHI, "Defragmentation relocated {} KiB of buffers",
+                         moved_bytes / 1024U);
+}
+
+void VulkanRHI::DestroyResource(RetiredResource& resource) {
+  // No frame that could read the slots is in flight any more
+  descriptor_heap_->Remove(BindlessSet::SampledTextures,
+                           resource.sampled_texture_index);
+  descriptor_heap_->Remove(BindlessSet::StorageTextures,
+                           resource.storage_texture_index);
+  descriptor_heap_->Remove(BindlessSet::StorageBuffers,
+                           resource.storage_buffer_index);
+  resource.pipeline.reset();
+  resource.view.reset();
+  resource.image.reset();
+  resource.buffer.reset();
+  memory_allocator_->Free(resource.allocation);
+}
+
+void VulkanRHI::WaitForTimeline(std::uint64_t value) {
+  const vk::Semaphore timeline{ *frame_timeline_ };
+  const vk::SemaphoreWaitInfo wait_info{
+    .semaphoreCount = 1U,
+    .pSemaphores = &timeline,
+    .pValues = &value
+  };
+  if (device_->waitSemaphores(wait_info, kInfiniteTimeout)
+      != vk::Result::eSuccess) {
+    const std::string msg{ "Failed to wait for the frame timeline" };
+    MAPLE_LOG_CRITICAL(LogRHI, msg);
+    throw std::runtime_error{ msg };
+  }
+}
+
+std::uint32_t VulkanRHI::BeginGpuZone(vk::CommandBuffer command_buffer,
+                                      QueueType queue,
+                                      const char* name) const {
+  if (!gpu_timer_) {
+    return VulkanGpuTimer::kNoZone;
+  }
+  return gpu_timer_->BeginZone(
+    command_buffer, GetCurrentFrameIndex(),
+    async_compute_ ? queue : QueueType::Graphics, name
+  );
+}
+
+void VulkanRHI::EndGpuZone(vk::CommandBuffer command_buffer,
+                           std::uint32_t zone) const {
+  if (gpu_timer_) {
+    gpu_timer_->EndZone(command_buffer, GetCurrentFrameIndex(), zone);
+  }
+}
+
+void VulkanRHI::TransitionSwapchainImage(vk::CommandBuffer command_buffer,
+                                         vk::ImageLayout old_layout,
+                                         vk::ImageLayout new_layout) {
+  // Writes after the image is acquired; presentation after the writes
+  const bool to_present{ new_layout == vk::ImageLayout::ePresentSrcKHR };
+  const vk::ImageMemoryBarrier barrier{
+    .srcAccessMask = to_present ? vk::AccessFlagBits::eTransferWrite
+                                : vk::AccessFlags{},
+    .dstAccessMask = to_present ? vk::AccessFlags{}
+                                : vk::AccessFlagBits::eTransferWrite,
+    .oldLayout = old_layout,
+    .newLayout = new_layout,
+    .srcQueueFamilyIndex = vk::QueueFamilyIgnored,
+    .dstQueueFamilyIndex = vk::QueueFamilyIgnored,
+    .image = swapchain_images_[image_index_],
+    .subresourceRange = kColorSubresourceRange
+  };
+  command_buffer.pipelineBarrier(
+    to_present ? vk::PipelineStageFlags{ vk::PipelineStageFlagBits::eTransfer }
+               : kImageAcquireStages,
+    to_present ? vk::PipelineStageFlagBits::eBottomOfPipe
+               : vk::PipelineStageFlagBits::eTransfer,
+    vk::DependencyFlags{}, nullptr, nullptr, barrier
+  );
+}
+
+VulkanRHI::FrameResources& VulkanRHI::GetCurrentFrame() noexcept {
+  return frames_[GetCurrentFrameIndex()];
+}
+
+std::size_t VulkanRHI::GetCurrentFrameIndex() const noexcept {
+  return static_cast<std::size_t>(frame_count_ % frames_.size());
+}
+
+void VulkanRHI::ResolveGpuZones() {
+  if (!gpu_timer_) {
+    return;
+  }
+
+  // Slots are resolved once their frame has completed, which usually is the
+  // frame before the current one; the current slot, waited for already,
+  // holds the oldest frame
+  gpu_timer_->ClearResolvedZones();
+  const std::uint64_t completed{
+    device_->getSemaphoreCounterValue(*frame_timeline_)
+  };
+  for (std::size_t i{ 0U }; i < frames_.size(); ++i) {
+    const std::size_t index{ (GetCurrentFrameIndex() + i) % frames_.size() };
+    if (frames_[index].timeline_value <= completed) {
+      gpu_timer_->Resolve(index);
+    }
+  }
+}
+
+VulkanRHI::DeviceCandidate VulkanRHI::EvaluateDevice(
+  vk::PhysicalDevice physical_device,
+  vk::SurfaceKHR surface
+) {
+  const vk::PhysicalDeviceProperties properties{
+    physical_device.getProperties()
+  };
+  DeviceCandidate candidate{
+    .physical_device = physical_device,
+    .name = properties.deviceName.data()
+  };
+
+  // Vulkan 1.2 is required for timeline semaphores in core
+  if (properties.apiVersion < vk::ApiVersion12) {
+    candidate.rejection = "Vulkan 1.2 not supported";
+    return candidate;
+  }
+
+  // Check required device extensions
+  std::unordered_set<std::string> extension_names{};
+  for (const auto& extension
+       : physical_device.enumerateDeviceExtensionProperties()) {
+    extension_names.emplace(extension.extensionName.data());
+  }
+  for (const char* extension : kRequiredDeviceExtensions) {
+    if (!extension_names.contains(extension)) {
+      candidate.rejection = std::format("missing extension {}", extension);
+      return candidate;
+    }
+  }
+
+  // Check required features
+  const auto features{
+    physical_device.getFeatures2<vk::PhysicalDeviceFeatures2,
+                                 vk::PhysicalDeviceVulkan12Features>()
+  };
+  const auto& features10{
+    features.get<vk::PhysicalDeviceFeatures2>().features
+  };
+  const auto& features12{ features.get<vk::PhysicalDeviceVulkan12Features>() };
+  if (!features12.timelineSemaphore) {
+    candidate.rejection = "timeline semaphores not supported";
+    return candidate;
+  }
+  if (!features12.runtimeDescriptorArray
+      || !features12.descriptorBindingPartiallyBound
+      || !features12.descriptorBindingUpdateUnusedWhilePending
+      || !features12.descriptorBindingSampledImageUpdateAfterBind
+      || !features12.descriptorBindingStorageImageUpdateAfterBind
+      || !features12.descriptorBindingStorageBufferUpdateAfterBind
+      || !features12.shaderSampledImageArrayNonUniformIndexing) {
+    candidate.rejection = "bindless descriptor indexing not supported";
+    return candidate;
+  }
+
+  // Find a graphics family that can present, and families without graphics
+  // (and compute, for transfer) that can run work asynchronously
+  std::optional<std::uint32_t> graphics{};
+  std::optional<std::uint32_t> compute{};
+  std::optional<std::uint32_t> transfer{};
+  const auto queue_families{ physical_device.getQueueFamilyProperties() };
+  for (std::uint32_t i{ 0U }; i < queue_families.size(); ++i) {
+    using enum vk::QueueFlagBits;
+    const vk::QueueFlags flags{ queue_families[i].queueFlags };
+    const bool has_graphics{ static_cast<bool>(flags & eGraphics) };
+    const bool has_compute{ static_cast<bool>(flags & eCompute) };
+    const bool has_transfer{ static_cast<bool>(flags & eTransfer) };
+
+    if (has_graphics && has_compute && !graphics
+        && physical_device.getSurfaceSupportKHR(i, surface)) {
+      graphics = i;
+    } else if (!has_graphics && has_compute && !compute) {
+      compute = i;
+    } else if (!has_graphics && !has_compute && has_transfer && !transfer) {
+      transfer = i;
+    }
+  }
+  if (!graphics) {
+    candidate.rejection = "no queue family supports graphics and present";
+    return candidate;
+  }
+  // Without a compute family, async compute takes a second graphics queue
+  const bool shared_compute_queue{
+    !compute && queue_families[*graphics].queueCount > 1U
+  };
+  candidate.queue_families = QueueFamilies{
+    .graphics = *graphics,
+    .compute = compute.value_or(*graphics),
+    .compute_queue_index = shared_compute_queue ? 1U : 0U,
+    .transfer = transfer.value_or(compute.value_or(*graphics))
+  };
+
+  // Rank by device type first
+  switch (properties.deviceType) {
+    case vk::PhysicalDeviceType::eDiscreteGpu: {
+      candidate.score.type_rank = 4U;
+      break;
+    }
+
+    case vk::PhysicalDeviceType::eIntegratedGpu: {
+      candidate.score.type_rank = 3U;
+      break;
+    }
+
+    case vk::PhysicalDeviceType::eVirtualGpu: {
+      candidate.score.type_rank = 2U;
+      break;
+    }
+
+    case vk::PhysicalDeviceType::eCpu: {
+      candidate.score.type_rank = 1U;
+      break;
+    }
+
+    default: { break; }
+  }
+
+  // Then by optional features and dedicated queue families
+  const std::array optional_features{
+    features10.samplerAnisotropy == vk::True,
+    features12.shaderStorageImageArrayNonUniformIndexing == vk::True,
+    features12.shaderStorageBufferArrayNonUniformIndexing == vk::True,
+    features12.bufferDeviceAddress == vk::True,
+    compute.has_value() || shared_compute_queue,
+    transfer.has_value()
+  };
+  candidate.score.feature_count = static_cast<std::uint32_t>(
+    std::ranges::count(optional_features, true)
+  );
+
+  // Then by the largest device-local heap
+  const vk::PhysicalDeviceMemoryProperties memory{
+    physical_device.getMemoryProperties()
+  };
+  for (std::uint32_t i{ 0U }; i < memory.memoryHeapCount; ++i) {
+    const vk::MemoryHeap& heap{ memory.memoryHeaps[i] };
+    if (heap.flags & vk::MemoryHeapFlagBits::eDeviceLocal) {
+      candidate.score.local_heap_size = std::max(
+        candidate.score.local_heap_size, heap.size
+      );
+    }
+  }
+
+  return candidate;
 }
 
 VKAPI_ATTR vk::Bool32 VKAPI_CALL VulkanRHI::DebugCallback(
@@ -1,7 +1,18 @@
 #pragma once
 
 // STL
+#include <array>
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -9,8 +20,20 @@
 // Vulkan
 #include "Vulkan/vulkan.hpp"
 
+// Core
+#include "Core/JobSystem.h"
+
 // RHI
+#include "RHI/FrameRingAllocator.h"
+#include "RHI/PipelineStateCache.h"
 #include "RHI/RHI.h"
+#include "RHI/RHIHandlePool.h"
+#include "RHI/Vulkan/VulkanCommandList.h"
+#include "RHI/Vulkan/VulkanDescriptorHeap.h"
+#include "RHI/Vulkan/VulkanGpuTimer.h"
+#include "RHI/Vulkan/VulkanMemoryAllocator.h"
+#include "RHI/Vulkan/VulkanPipelineCache.h"
+#include "RHI/Vulkan/VulkanUploadQueue.h"
 
 // Forward declarations
 namespace maple::platform{ class Window; }
@@ -19,16 +42,386 @@ namespace maple::rhi {
 
 class VulkanRHI final : public RHI {
 public:
-  explicit VulkanRHI(platform::Window* window);
+  VulkanRHI(platform::Window* window, const RHIConfig& config);
 
   ~VulkanRHI() override;
 
   void BeginFrame() override;
   void Clear(float r, float g, float b, float a) override;
+  [[nodiscard]] RHICommandList* BeginCommandList(
+    std::uint64_t sort_key,
+    QueueType queue,
+    std::span<const std::uint64_t> wait_sort_keys
+  ) override;
+  void EndCommandList(RHICommandList* command_list) override;
   void EndFrame() override;
   void Present() override;
+  [[nodiscard]] std::span<const GpuZone> GetGpuZones() const override;
+  [[nodiscard]] bool HasAsyncCompute() const noexcept override;
+  void SetPresentMode(PresentMode present_mode) override;
+
+  [[nodiscard]] BufferHandle CreateBuffer(const BufferDesc& desc) override;
+  void DestroyBuffer(BufferHandle buffer) override;
+  [[nodiscard]] void* MapBuffer(BufferHandle buffer) override;
+  [[nodiscard]] TextureHandle CreateTexture(const TextureDesc& desc) override;
+  void DestroyTexture(TextureHandle texture) override;
+  [[nodiscard]] MemoryRequirements GetTextureMemoryRequirements(
+    const TextureDesc& desc
+  ) const override;
+  [[nodiscard]] MemoryHeapHandle CreateMemoryHeap(
+    const MemoryRequirements& requirements
+  ) override;
+  void DestroyMemoryHeap(MemoryHeapHandle heap) override;
+  [[nodiscard]] TextureHandle CreatePlacedTexture(
+    const TextureDesc& desc,
+    MemoryHeapHandle heap,
+    std::uint64_t offset
+  ) override;
+  [[nodiscard]] std::uint32_t GetBindlessIndex(
+    BufferHandle buffer
+  ) const override;
+  [[nodiscard]] std::uint32_t GetBindlessIndex(
+    TextureHandle texture,
+    TextureUsage usage
+  ) const override;
+  [[nodiscard]] UploadTicket UploadBuffer(
+    BufferHandle buffer,
+    std::uint64_t offset,
+    std::span<const std::byte> data
+  ) override;
+  [[nodiscard]] UploadTicket UploadTexture(
+    TextureHandle texture,
+    std::uint32_t mip_level,
+    std::span<const std::byte> data
+  ) override;
+  [[nodiscard]] bool IsUploadComplete(UploadTicket ticket) const override;
+  void WaitForUpload(UploadTicket ticket) override;
+  [[nodiscard]] ShaderHandle CreateShader(const ShaderDesc& desc) override;
+  void DestroyShader(ShaderHandle shader) override;
+  [[nodiscard]] PipelineHandle CreateGraphicsPipeline(
+    const GraphicsPipelineDesc& desc
+  ) override;
+  [[nodiscard]] PipelineHandle GetGraphicsPipeline(
+    const GraphicsPipelineDesc& desc
+  ) override;
+  void DestroyPipeline(PipelineHandle pipeline) override;
+  void WarmupPipelines(
+    std::span<const GraphicsPipelineDesc> manifest
+  ) override;
+  [[nodiscard]] bool IsPipelineWarmupComplete() const override;
+  [[nodiscard]] TransientAllocation AllocateTransient(
+    std::uint64_t size,
+    BufferUsage usage
+  ) override;
+  void DefragmentMemory() override;
+  [[nodiscard]] RHIMemoryStats GetMemoryStats() const override;
+
+  [[nodiscard]] RHIStats GetStats() const noexcept override;
+
+  /**
+   * @brief Record resource transitions as one pipeline barrier.
+   *
+   * Hand-overs between queues become the release or acquire half of a
+   * queue family ownership transfer, depending on the list's queue. May be
+   * called from any thread.
+   *
+   * @param command_buffer Command buffer being recorded
+   * @param queue Queue of the list being recorded
+   * @param textures Texture transitions (stale handles are skipped)
+   * @param buffers Buffer transitions (stale handles are skipped)
+   */
+  void RecordBarrier(vk::CommandBuffer command_buffer, QueueType queue,
+                     std::span<const TextureBarrier> textures,
+                     std::span<const BufferBarrier> buffers) const;
+
+  /**
+   * @brief Record a fill of a whole buffer with a repeated 32-bit value.
+   *
+   * May be called from any thread.
+   *
+   * @param command_buffer Command buffer being recorded
+   * @param buffer Buffer to fill (stale handles are skipped)
+   * @param value Value written to every 4 bytes of the buffer
+   */
+  void RecordFillBuffer(vk::CommandBuffer command_buffer, BufferHandle buffer,
+                        std::uint32_t value) const;
+
+  /**
+   * @brief Begin timing a zone of the current frame on the GPU.
+   *
+   * May be called from any thread.
+   *
+   * @param command_buffer Command buffer being recorded
+   * @param queue Queue of the list being recorded
+   * @param name Zone name (string literal)
+   * @return Zone to pass to EndGpuZone() (VulkanGpuTimer::kNoZone if the
+   *         zone is not timed)
+   */
+  [[nodiscard]] std::uint32_t BeginGpuZone(vk::CommandBuffer command_buffer,
+                                           QueueType queue,
+                                           const char* name) const;
+
+  /**
+   * @brief End timing a zone of the current frame.
+   *
+   * @param command_buffer Command buffer being recorded
+   * @param zone Zone returned by BeginGpuZone()
+   */
+  void EndGpuZone(vk::CommandBuffer command_buffer, std::uint32_t zone) const;
 
 private:
+  /**
+   * @brief Queue families used for each kind of work.
+   *
+   * Compute and transfer fall back to the graphics family (or transfer to the
+   * compute family) when the device has no dedicated family for them. A
+   * compute fallback still gets its own queue when the graphics family has
+   * more than one.
+   */
+  struct QueueFamilies {
+    /// Family with graphics, compute, and present support
+    std::uint32_t graphics{ 0U };
+
+    /// Family for async compute (compute without graphics, if available)
+    std::uint32_t compute{ 0U };
+
+    /// Index of the async compute queue in its family (1 if it shares the
+    /// graphics family but not its queue)
+    std::uint32_t compute_queue_index{ 0U };
+
+    /// Family for uploads (transfer without graphics or compute, if available)
+    std::uint32_t transfer{ 0U };
+  };
+
+  /**
+   * @brief Ranking of a suitable physical device; higher is better, compared
+   *        member by member.
+   */
+  struct DeviceScore {
+    /// Device type (discrete > integrated > virtual > CPU > other)
+    std::uint32_t type_rank{ 0U };
+
+    /// Number of supported optional features and dedicated queue families
+    std::uint32_t feature_count{ 0U };
+
+    /// Size of the largest device-local memory heap in bytes
+    vk::DeviceSize local_heap_size{ 0U };
+
+    auto operator<=>(const DeviceScore&) const = default;
+  };
+
+  /**
+   * @brief Physical device evaluated for selection.
+   */
+  struct DeviceCandidate {
+    /// Evaluated device
+    vk::PhysicalDevice physical_device{};
+
+    /// Device name reported by the driver
+    std::string name{};
+
+    /// Why the device cannot be used (empty if suitable)
+    std::string rejection{};
+
+    /// Queue families the device would use
+    QueueFamilies queue_families{};
+
+    /// Ranking among suitable devices
+    DeviceScore score{};
+  };
+
+  /**
+   * @brief Command lists of one thread for one frame in flight.
+   */
+  struct ThreadCommandPool {
+    /// Pool the thread's secondary command buffers are allocated from
+    vk::UniqueCommandPool command_pool{ nullptr };
+
+    /// Lists reused across frames, each owning a secondary command buffer
+    std::vector<std::unique_ptr<VulkanCommandList>> command_lists{};
+
+    /// Number of lists handed out this frame
+    std::size_t used{ 0U };
+  };
+
+  /// Number of QueueType values
+  static constexpr std::size_t kQueueTypeCount{ 2U };
+
+  /**
+   * @brief Resources of one frame in flight, reused once the GPU has finished
+   *        the frame that last used them.
+   */
+  struct FrameResources {
+    /// Pool for the frame's command buffers, reset as a whole each frame
+    vk::UniqueCommandPool command_pool{ nullptr };
+
+    /// Pool for the frame's async compute command buffers (null without an
+    /// async compute queue)
+    vk::UniqueCommandPool compute_command_pool{ nullptr };
+
+    /// Primary command buffer of the frame (owned by the pool)
+    vk::CommandBuffer command_buffer{ nullptr };
+
+    /// Primary command buffers of the frame's further submissions, by
+    /// QueueType (owned by the pools)
+    std::array<std::vector<vk::CommandBuffer>, kQueueTypeCount>
+      submission_command_buffers{};
+
+    /// Signaled when the acquired swapchain image may be written
+    vk::UniqueSemaphore image_available{ nullptr };
+
+    /// Frame timeline value signaled when the frame's GPU work completes
+    std::uint64_t timeline_value{ 0U };
+
+    /// Command lists of each thread that has recorded in this frame slot,
+    /// by QueueType
+    std::unordered_map<std::thread::id,
+                       std::array<ThreadCommandPool, kQueueTypeCount>>
+      thread_pools{};
+  };
+
+  /**
+   * @brief Command lists of a frame submitted to one queue as a batch.
+   *
+   * A frame's lists are split into batches where a list waits for the other
+   * queue, or the other queue waits for a list.
+   */
+  struct QueueSubmission {
+    /// Queue the batch runs on
+    QueueType queue{ QueueType::Graphics };
+
+    /// Primary command buffer executing the batch's lists
+    vk::CommandBuffer command_buffer{ nullptr };
+
+    /// Value of the other queue's timeline to wait for (0 for none)
+    std::uint64_t wait_value{ 0U };
+
+    /// Value to signal on the queue's timeline (0 for none)
+    std::uint64_t signal_value{ 0U };
+  };
+
+  /**
+   * @brief Swapchain replaced by a recreation, destroyed once the GPU has
+   *        moved past its last frame.
+   */
+  struct RetiredSwapchain {
+    /// Replaced swapchain
+    vk::UniqueSwapchainKHR swapchain{ nullptr };
+
+    /// Per-image semaphores that presentation of the swapchain may still use
+    std::vector<vk::UniqueSemaphore> render_finished{};
+
+    /// Last frame timeline value submitted before the swapchain was replaced
+    std::uint64_t timeline_value{ 0U };
+  };
+
+  /**
+   * @brief Buffer and the memory bound to it.
+   */
+  struct VulkanBuffer {
+    /// Buffer object (replaced when defragmentation relocates the buffer)
+    vk::UniqueBuffer buffer{ nullptr };
+
+    /// Memory bound to the buffer
+    VulkanAllocation allocation{};
+
+    /// Creation parameters
+    BufferDesc desc{};
+
+    /// Ticket of the last upload to the buffer (kUploadInProgress while an
+    /// upload is being recorded)
+    std::uint64_t upload_ticket{ 0U };
+
+    /// Slot in the bindless storage buffer array
+    std::uint32_t bindless_index{ kInvalidBindlessIndex };
+  };
+
+  /**
+   * @brief Texture, its default view, and the memory bound to it.
+   */
+  struct VulkanTexture {
+    /// Image object
+    vk::UniqueImage image{ nullptr };
+
+    /// View of every mip level
+    vk::UniqueImageView view{ nullptr };
+
+    /// Memory bound to the image (empty if the image is placed in a heap)
+    VulkanAllocation allocation{};
+
+    /// Heap the image is placed in (invalid if it owns its memory)
+    MemoryHeapHandle heap{};
+
+    /// Creation parameters
+    TextureDesc desc{};
+
+    /// Ticket of the last upload to the texture
+    std::uint64_t upload_ticket{ 0U };
+
+    /// Slot in the bindless sampled texture array
+    std::uint32_t sampled_index{ kInvalidBindlessIndex };
+
+    /// Slot in the bindless storage texture array
+    std::uint32_t storage_index{ kInvalidBindlessIndex };
+  };
+
+  /**
+   * @brief Shader module and its stage.
+   */
+  struct VulkanShader {
+    /// Module, shared with pipeline compilations still reading it
+    std::shared_ptr<vk::UniqueShaderModule> module{ nullptr };
+
+    /// Stage the shader runs in
+    ShaderStage stage{ ShaderStage::Vertex };
+  };
+
+  /**
+   * @brief Compiled pipeline and the description it was compiled from.
+   */
+  struct VulkanPipeline {
+    /// Pipeline object
+    vk::UniquePipeline pipeline{ nullptr };
+
+    /// Creation parameters
+    GraphicsPipelineDesc desc{};
+
+    /// Whether the pipeline belongs to the pipeline state cache
+    bool shared{ false };
+  };
+
+  /**
+   * @brief Destroyed resource, released once the GPU has finished the frames
+   *        that may use it.
+   */
+  struct RetiredResource {
+    /// Buffer object, if the resource is a buffer
+    vk::UniqueBuffer buffer{ nullptr };
+
+    /// Image view, if the resource is a texture
+    vk::UniqueImageView view{ nullptr };
+
+    /// Image object, if the resource is a texture
+    vk::UniqueImage image{ nullptr };
+
+    /// Pipeline object, if the resource is a pipeline
+    vk::UniquePipeline pipeline{ nullptr };
+
+    /// Memory bound to the resource
+    VulkanAllocation allocation{};
+
+    /// Last frame timeline value submitted before the resource was retired
+    std::uint64_t timeline_value{ 0U };
+
+    /// Ticket of the last upload to the resource
+    std::uint64_t upload_ticket{ 0U };
+
+    /// Bindless slots freed with the resource
+    std::uint32_t sampled_texture_index{ kInvalidBindlessIndex };
+    std::uint32_t storage_texture_index{ kInvalidBindlessIndex };
+    std::uint32_t storage_buffer_index{ kInvalidBindlessIndex };
+  };
+
   /**
    * @brief Create and initialize the Vulkan instance.
    *
@@ -142,6 +535,274 @@ private:
    */
   void CreateDebugMessenger();
 
+  /**
+   * @brief Create the presentation surface for the window.
+   *
+   * @throws std::runtime_error If SDL fails to create the surface
+   */
+  void CreateSurface();
+
+  /**
+   * @brief Select the physical device to render with.
+   *
+   * Evaluates every device and picks the highest-scoring suitable one, or the
+   * device forced by index or name in the configuration.
+   *
+   * @param config Device selection settings
+   * @throws std::runtime_error If no suitable device is found or the forced
+   *                            device is missing or unsuitable
+   */
+  void SelectPhysicalDevice(const RHIConfig& config);
+
+  /**
+   * @brief Create the logical device and retrieve its queues.
+   *
+   * Creates one queue per distinct queue family of the selected device and
+   * enables the required features (timeline semaphores) along with any
+   * supported optional ones.
+   */
+  void CreateLogicalDevice();
+
+  /**
+   * @brief Create the command pools and semaphores of each frame in flight
+   *        and the frame timeline semaphore.
+   *
+   * @param frames_in_flight Number of frames the CPU may record ahead
+   */
+  void CreateFrameResources(std::uint32_t frames_in_flight);
+
+  /**
+   * @brief Create the persistently mapped ring buffer for per-frame data.
+   *
+   * @param size Bytes per frame
+   * @param frames_in_flight Number of frames the CPU may record ahead
+   */
+  void CreateTransientBuffer(std::uint64_t size,
+                             std::uint32_t frames_in_flight);
+
+  /**
+   * @brief Create the GPU timer if the device and RHIConfig allow it.
+   *
+   * @param max_zones Zones timed per frame (0 disables timing)
+   */
+  void CreateGpuTimer(std::uint32_t max_zones);
+
+  /**
+   * @brief Load the pipeline cache, create the pipeline state cache and the
+   *        bindless heap, and create the pipeline layout shared by every
+   *        pipeline.
+   *
+   * @param config Pipeline cache path and pipeline and bindless capacities
+   */
+  void CreatePipelineResources(const RHIConfig& config);
+
+  /**
+   * @brief Create an image without memory for a texture.
+   *
+   * @param desc Size, format, and usage of the texture
+   * @return Image in Undefined layout
+   * @throws std::runtime_error If the description is invalid
+   */
+  [[nodiscard]] vk::UniqueImage CreateImage(const TextureDesc& desc) const;
+
+  /**
+   * @brief Create the view and bindless slots of an image with memory and
+   *        add it to the texture pool.
+   *
+   * @param image Image with memory bound
+   * @param allocation Memory owned by the image (empty if placed); freed if
+   *                   creation fails
+   * @param heap Heap the image is placed in (invalid if it owns its memory)
+   * @param desc Creation parameters of the image
+   * @return Handle to the texture
+   * @throws std::runtime_error If the view cannot be created or the bindless
+   *                            heap is full
+   */
+  [[nodiscard]] TextureHandle AddTexture(vk::UniqueImage image,
+                                         const VulkanAllocation& allocation,
+                                         MemoryHeapHandle heap,
+                                         const TextureDesc& desc);
+
+  /**
+   * @brief Compile a graphics pipeline through the pipeline cache.
+   *
+   * May be called from any thread.
+   *
+   * @param desc Shaders and fixed-function state of the pipeline
+   * @return Compiled pipeline
+   * @throws std::runtime_error If the description is invalid or compilation
+   *                            fails
+   */
+  [[nodiscard]] vk::UniquePipeline CompileGraphicsPipeline(
+    const GraphicsPipelineDesc& desc
+  );
+
+  /**
+   * @brief Get a render pass compatible with a pair of attachment formats.
+   *
+   * Pipelines are compiled against these; compatibility only depends on the
+   * formats, so one render pass per pair serves every pipeline.
+   *
+   * @param color_format Format of the color attachment
+   * @param depth_format Format of the depth attachment (eUndefined for none)
+   * @return Render pass owned by the backend
+   */
+  [[nodiscard]] vk::RenderPass GetCompatibleRenderPass(vk::Format color_format,
+                                                       vk::Format depth_format);
+
+  /**
+   * @brief Create the swapchain, or recreate it after a resize or present
+   *        mode change.
+   *
+   * The previous swapchain is passed to the driver as oldSwapchain and
+   * retired rather than destroyed, so recreation never waits for the device
+   * to go idle.
+   *
+   * @return false if the window has no drawable area (e.g., minimized)
+   */
+  bool CreateSwapchain();
+
+  /**
+   * @brief Pick the swapchain format, preferring 8-bit sRGB.
+   *
+   * @return Supported surface format
+   */
+  [[nodiscard]] vk::SurfaceFormatKHR ChooseSurfaceFormat() const;
+
+  /**
+   * @brief Map a present mode to Vulkan, falling back to FIFO.
+   *
+   * @param present_mode Requested presentation mode
+   * @return Supported Vulkan present mode
+   */
+  [[nodiscard]] vk::PresentModeKHR ChoosePresentMode(
+    PresentMode present_mode
+  ) const;
+
+  /**
+   * @brief Destroy retired swapchains the GPU no longer uses.
+   */
+  void DestroyRetiredSwapchains();
+
+  /**
+   * @brief Release destroyed resources the GPU no longer uses.
+   *
+   * Resources destroyed since the previous call are stamped with the last
+   * submitted timeline value first.
+   */
+  void ReleaseRetiredResources();
+
+  /**
+   * @brief Relocate GPU-only buffers out of sparsely used memory blocks.
+   *
+   * Records the copies into the frame's command buffer ahead of the frame's
+   * own commands and retires the old buffers.
+   *
+   * @param command_buffer Command buffer of the frame being recorded
+   */
+  void DefragmentBuffers(vk::CommandBuffer command_buffer);
+
+  /**
+   * @brief Free the memory of a retired resource and destroy its objects.
+   *
+   * @param resource Resource the GPU no longer uses
+   */
+  void DestroyResource(RetiredResource& resource);
+
+  /**
+   * @brief Get the queue a command list is submitted to.
+   *
+   * @return The list's queue, or Graphics without an async compute queue
+   */
+  [[nodiscard]] QueueType GetSubmissionQueue(
+    const VulkanCommandList& command_list
+  ) const noexcept;
+
+  /**
+   * @brief Check the waits of the frame's lists, sorted by sort key.
+   *
+   * @throws std::runtime_error If two lists share a sort key, or a list
+   *                            waits for a list that was not ended this
+   *                            frame or does not precede it
+   */
+  void ValidateCommandLists();
+
+  /**
+   * @brief Split the frame's lists into batches per queue and record the
+   *        batches' primary command buffers.
+   *
+   * Fills queue_submissions_ in submission order; the last batch is the
+   * graphics batch that ends the frame.
+   *
+   * @param frame Resources of the frame being recorded
+   */
+  void RecordQueueSubmissions(FrameResources& frame);
+
+  /**
+   * @brief Get a primary command buffer for a further batch of the frame.
+   *
+   * @param frame Resources of the frame being recorded
+   * @param queue Queue of the batch
+   * @param index Index of the batch among the frame's batches on the queue
+   * @return Command buffer, begun for one submission
+   */
+  [[nodiscard]] vk::CommandBuffer BeginSubmissionCommandBuffer(
+    FrameResources& frame,
+    QueueType queue,
+    std::size_t index
+  );
+
+  /**
+   * @brief Block until the GPU reaches a frame timeline value.
+   *
+   * @param value Timeline value to wait for
+   * @throws std::runtime_error If the wait fails
+   */
+  void WaitForTimeline(std::uint64_t value);
+
+  /**
+   * @brief Record a layout transition of the acquired swapchain image.
+   *
+   * @param command_buffer Graphics command buffer of the frame
+   * @param old_layout Current layout of the image
+   * @param new_layout Layout to transition to
+   */
+  void TransitionSwapchainImage(vk::CommandBuffer command_buffer,
+                                vk::ImageLayout old_layout,
+                                vk::ImageLayout new_layout);
+
+  /**
+   * @brief Get the resources of the frame being recorded.
+   *
+   * @return Resources of the current frame in flight
+   */
+  [[nodiscard]] FrameResources& GetCurrentFrame() noexcept;
+
+  /**
+   * @brief Get the index of the frame slot being recorded.
+   */
+  [[nodiscard]] std::size_t GetCurrentFrameIndex() const noexcept;
+
+  /**
+   * @brief Resolve the GPU zones of every finished frame slot, oldest
+   *        first.
+   */
+  void ResolveGpuZones();
+
+  /**
+   * @brief Check a physical device's suitability and score it.
+   *
+   * A device is suitable if it supports Vulkan 1.2, timeline semaphores, the
+   * swapchain extension, and has a queue family that can both render and
+   * present to the surface.
+   *
+   * @param physical_device Device to evaluate
+   * @param surface Surface the device must be able to present to
+   * @return Evaluation of the device
+   */
+  static DeviceCandidate EvaluateDevice(vk::PhysicalDevice physical_device,
+                                        vk::SurfaceKHR surface);
+
   /**
    * @brief Static callback for Vulkan validation layer messages.
    *
@@ -177,6 +838,239 @@ private:
 
   /// Debug messenger for validation layer output (debug builds only)
   vk::UniqueDebugUtilsMessengerEXT debug_messenger_{ nullptr };
+
+  /// Presentation surface of the window
+  vk::UniqueSurfaceKHR surface_{ nullptr };
+
+  /// Selected physical device
+  vk::PhysicalDevice physical_device_{ nullptr };
+
+  /// Queue families of the selected device
+  QueueFamilies queue_families_{};
+
+  /// Logical device with automatic cleanup
+  vk::UniqueDevice device_{ nullptr };
+
+  /// Queue for graphics work and presentation
+  vk::Queue graphics_queue_{ nullptr };
+
+  /// Queue for async compute work (the graphics queue if not dedicated)
+  vk::Queue compute_queue_{ nullptr };
+
+  /// Whether compute lists run on compute_queue_ (a dedicated family, and
+  /// RHIConfig::async_compute)
+  bool async_compute_{ false };
+
+  /// Queue for uploads (the compute or graphics queue if not dedicated)
+  vk::Queue transfer_queue_{ nullptr };
+
+  /// Guards submissions and presentation, since the transfer queue may be
+  /// the graphics queue and uploads are submitted from any thread
+  std::mutex queue_mutex_{};
+
+  /// Whether VK_EXT_memory_budget is enabled on the device
+  bool memory_budget_enabled_{ false };
+
+  /// Whether queries may be reset from the host (hostQueryReset)
+  bool host_query_reset_enabled_{ false };
+
+  /// Sub-allocator for buffer and texture memory
+  std::unique_ptr<VulkanMemoryAllocator> memory_allocator_{ nullptr };
+
+  /// Guards the resource pools and resources awaiting retirement
+  mutable std::mutex resource_mutex_{};
+
+  /// Live buffers
+  RHIHandlePool<BufferHandle, VulkanBuffer> buffers_{};
+
+  /// Live textures
+  RHIHandlePool<TextureHandle, VulkanTexture> textures_{};
+
+  /// Live memory heaps
+  RHIHandlePool<MemoryHeapHandle, VulkanAllocation> memory_heaps_{};
+
+  /// Resources destroyed since the last BeginFrame() (any thread)
+  std::vector<RetiredResource> pending_destroys_{};
+
+  /// Destroyed resources awaiting the GPU (render thread only)
+  std::vector<RetiredResource> retired_resources_{};
+
+  /// Whether DefragmentMemory() was called since the last pass
+  std::atomic<bool> defragment_requested_{ false };
+
+  /// Streams uploads through a staging ring on the transfer queue
+  std::unique_ptr<VulkanUploadQueue> upload_queue_{ nullptr };
+
+  /// Upload timeline value the current frame's submission waits for
+  std::uint64_t upload_wait_value_{ 0U };
+
+  /// Times zones of GPU work (null if timing is disabled or unsupported)
+  std::unique_ptr<VulkanGpuTimer> gpu_timer_{ nullptr };
+
+  /// Zone spanning the current frame's GPU work
+  std::uint32_t frame_gpu_zone_{ VulkanGpuTimer::kNoZone };
+
+  /// Upload ticket of a resource whose upload is still being recorded
+  static constexpr std::uint64_t kUploadInProgress{
+    std::numeric_limits<std::uint64_t>::max()
+  };
+
+  /// Offsets of per-frame data, one segment per frame in flight
+  std::unique_ptr<FrameRingAllocator> transient_allocator_{ nullptr };
+
+  /// Persistently mapped buffer backing per-frame data
+  BufferHandle transient_buffer_{};
+
+  /// CPU address of the transient buffer
+  std::byte* transient_data_{ nullptr };
+
+  /// Offsets of per-frame data written while the frame is skipped
+  std::unique_ptr<FrameRingAllocator> discard_transient_allocator_{ nullptr };
+
+  /// CPU memory that skipped frames write their per-frame data to
+  std::unique_ptr<std::byte[]> discard_transient_data_{ nullptr };
+
+  /// Dynamic offset alignment of uniform buffers on the device
+  vk::DeviceSize uniform_alignment_{ FrameRingAllocator::kMaxAlignment };
+
+  /// Dynamic offset alignment of storage buffers on the device
+  vk::DeviceSize storage_alignment_{ FrameRingAllocator::kMaxAlignment };
+
+  /// Compiled pipeline state persisted across runs
+  std::unique_ptr<VulkanPipelineCache> pipeline_cache_{ nullptr };
+
+  /// Descriptor sets every pipeline indexes resources through
+  std::unique_ptr<VulkanDescriptorHeap> descriptor_heap_{ nullptr };
+
+  /// Layout shared by every pipeline (bindless sets and push constants)
+  vk::UniquePipelineLayout pipeline_layout_{ nullptr };
+
+  /// Guards the compatible render passes
+  std::mutex render_pass_mutex_{};
+
+  /// Compatible render passes by color format (high bits) and depth format
+  std::unordered_map<std::uint64_t, vk::UniqueRenderPass> render_passes_{};
+
+  /// Live shaders (guarded by resource_mutex_)
+  RHIHandlePool<ShaderHandle, VulkanShader> shaders_{};
+
+  /// Live pipelines (guarded by resource_mutex_)
+  RHIHandlePool<PipelineHandle, VulkanPipeline> pipelines_{};
+
+  /// Shared pipelines by description
+  std::unique_ptr<PipelineStateCache<PipelineHandle>> pipeline_state_cache_{
+    nullptr
+  };
+
+  /// Outstanding warmup compilations
+  core::JobCounter warmup_counter_{};
+
+  /// Guards the warmup manifests
+  std::mutex warmup_mutex_{};
+
+  /// Copies of the manifests being warmed up, released once warmup is done
+  std::vector<std::unique_ptr<std::vector<GraphicsPipelineDesc>>>
+    warmup_manifests_{};
+
+  /// Pipelines compiled, including warmup (any thread)
+  std::atomic<std::uint64_t> pipelines_compiled_{ 0U };
+
+  /// Pipelines compiled by warmup (any thread)
+  std::atomic<std::uint64_t> pipelines_warmed_up_{ 0U };
+
+  /// Time spent compiling pipelines in microseconds (any thread)
+  std::atomic<std::uint64_t> pipeline_compile_microseconds_{ 0U };
+
+  /// Size of the push constant range of the pipeline layout (the minimum
+  /// every device supports)
+  static constexpr std::uint32_t kPushConstantSize{ 128U };
+
+  /// Upper bound on bytes relocated per defragmentation pass
+  static constexpr vk::DeviceSize kMaxDefragmentationBytes{
+    64U * 1024U * 1024U
+  };
+
+  /// Upper bound on frames in flight
+  static constexpr std::uint32_t kMaxFramesInFlight{ 3U };
+
+  /// Frame timeline semaphore; each submitted frame signals the next value
+  vk::UniqueSemaphore frame_timeline_{ nullptr };
+
+  /// Last value submitted to the frame timeline
+  std::uint64_t timeline_value_{ 0U };
+
+  /// Compute timeline semaphore; batches of the compute queue that the
+  /// graphics queue waits for signal the next value
+  vk::UniqueSemaphore compute_timeline_{ nullptr };
+
+  /// Last value submitted to the compute timeline
+  std::uint64_t compute_timeline_value_{ 0U };
+
+  /// Compute lists submitted (render thread writes, any thread reads)
+  std::atomic<std::uint64_t> compute_command_lists_submitted_{ 0U };
+
+  /// Batches that waited for the other queue within a frame
+  std::atomic<std::uint64_t> queue_waits_{ 0U };
+
+  /// Per-frame resources, used round-robin
+  std::vector<FrameResources> frames_{};
+
+  /// Number of frames presented (selects the current frame resources)
+  std::uint64_t frame_count_{ 0U };
+
+  /// Whether the current frame acquired an image and is being recorded
+  bool frame_active_{ false };
+
+  /// Guards the thread pools of the current frame and the pending lists
+  std::mutex command_list_mutex_{};
+
+  /// Lists ended this frame, awaiting EndFrame()
+  std::vector<VulkanCommandList*> pending_command_lists_{};
+
+  /// Scratch arrays of the secondary command buffers executed by the open
+  /// batch of each queue, by QueueType
+  std::array<std::vector<vk::CommandBuffer>, kQueueTypeCount>
+    secondary_command_buffers_{};
+
+  /// Scratch array of the frame's batches in submission order
+  std::vector<QueueSubmission> queue_submissions_{};
+
+  /// Scratch array of the timeline value each pending list's batch
+  /// signals (0 if the other queue does not wait for the list)
+  std::vector<std::uint64_t> list_signal_values_{};
+
+  /// List handed out while the frame is skipped; discards its commands
+  VulkanCommandList discard_command_list_{ this, vk::CommandBuffer{} };
+
+  /// Swapchain presenting to the window surface
+  vk::UniqueSwapchainKHR swapchain_{ nullptr };
+
+  /// Images owned by the swapchain
+  std::vector<vk::Image> swapchain_images_{};
+
+  /// Per-image semaphores signaled when rendering to the image is done
+  std::vector<vk::UniqueSemaphore> render_finished_{};
+
+  /// Pixel format of the swapchain images
+  vk::Format swapchain_format_{ vk::Format::eUndefined };
+
+  /// Size of the swapchain images
+  vk::Extent2D swapchain_extent_{};
+
+  /// Index of the acquired swapchain image
+  std::uint32_t image_index_{ 0U };
+
+  /// Whether the swapchain must be recreated before the next frame
+  bool swapchain_dirty_{ false };
+
+  /// Swapchains replaced by recreation, awaiting destruction
+  std::vector<RetiredSwapchain> retired_swapchains_{};
+
+  /// Present mode the swapchain was created with
+  PresentMode present_mode_{ PresentMode::Fifo };
+
+  /// Present mode requested by SetPresentMode() (any thread)
+  std::atomic<PresentMode> requested_present_mode_{ PresentMode::Fifo };
 };
 
 } // namespace maple::rhi
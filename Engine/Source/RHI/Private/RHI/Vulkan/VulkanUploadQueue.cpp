@@ -0,0 +1,518 @@
+#include "RHI/Vulkan/VulkanUploadQueue.h"
+
+// STL
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+// RHI
+#include "RHI/RHILog.h"
+
+namespace maple::rhi {
+
+namespace {
+
+/// Timeout for waits that should only end when the GPU finishes
+constexpr std::uint64_t kInfiniteTimeout{
+  std::numeric_limits<std::uint64_t>::max()
+};
+
+/**
+ * @brief Block until a timeline semaphore reaches a value.
+ *
+ * @param device Device owning the semaphore
+ * @param timeline Timeline semaphore to wait on
+ * @param value Value to wait for
+ * @throws std::runtime_error If the wait fails
+ */
+void WaitForValue(vk::Device device, vk::Semaphore timeline,
+                  std::uint64_t value) {
+  const vk::SemaphoreWaitInfo wait_info{
+    .semaphoreCount = 1U,
+    .pSemaphores = &timeline,
+    .pValues = &value
+  };
+  if (device.waitSemaphores(wait_info, kInfiniteTimeout)
+      != vk::Result::eSuccess) {
+    const std::string msg{ "Failed to wait for the upload timeline" };
+    MAPLE_LOG_CRITICAL(LogRHI, msg);
+    throw std::runtime_error{ msg };
+  }
+}
+
+} // namespace
+
+VulkanUploadQueue::VulkanUploadQueue(vk::Device device,
+                                     VulkanMemoryAllocator& memory_allocator,
+                                     vk::Queue transfer_queue,
+                                     std::uint32_t transfer_family,
+                                     std::uint32_t graphics_family,
+                                     vk::Extent3D image_granularity,
+                                     std::mutex& queue_mutex,
+                                     vk::DeviceSize staging_size)
+  : device_{ device }
+  , memory_allocator_{ memory_allocator }
+  , transfer_queue_{ transfer_queue }
+  , transfer_family_{ transfer_family }
+  , graphics_family_{ graphics_family }
+  , image_granularity_{ image_granularity }
+  , queue_mutex_{ queue_mutex }
+  , ownership_transfer_{ transfer_family != graphics_family }
+  , staging_size_{
+      std::max(staging_size & ~(kStagingAlignment - 1U),
+               kStagingAlignment * 4U)
+    } {
+  staging_buffer_ = device_.createBufferUnique(vk::BufferCreateInfo{
+    .size = staging_size_,
+    .usage = vk::BufferUsageFlagBits::eTransferSrc,
+    .sharingMode = vk::SharingMode::eExclusive
+  });
+  staging_allocation_ = memory_allocator_.AllocateBuffer(
+    *staging_buffer_, MemoryUsage::CpuToGpu, false
+  );
+
+  const vk::SemaphoreTypeCreateInfo timeline_info{
+    .semaphoreType = vk::SemaphoreType::eTimeline,
+    .initialValue = 0U
+  };
+  timeline_ = device_.createSemaphoreUnique(vk::SemaphoreCreateInfo{
+    .pNext = &timeline_info
+  });
+
+  MAPLE_LOG_INFO(LogRHI, "Upload queue created ({} KiB staging, {})",
+                 staging_size_ / 1024U,
+                 ownership_transfer_ ? "dedicated transfer family"
+                                     : "shared queue family");
+}
+
+VulkanUploadQueue::~VulkanUploadQueue() {
+  staging_buffer_.reset();
+  memory_allocator_.Free(staging_allocation_);
+}
+
+std::uint64_t VulkanUploadQueue::UploadBuffer(vk::Buffer buffer,
+                                              vk::DeviceSize offset,
+                                              std::span<const std::byte> data) {
+  MAPLE_PROFILE_FUNCTION(LogRHI);
+
+  if (data.empty()) {
+    return 0U;
+  }
+
+  // Large uploads are split so that no single copy needs most of the ring
+  const vk::DeviceSize max_chunk{ staging_size_ / 4U };
+
+  std::unique_lock lock{ mutex_ };
+  for (vk::DeviceSize copied{ 0U }; copied < data.size();) {
+    const vk::DeviceSize chunk{ std::min(data.size() - copied, max_chunk) };
+    const vk::DeviceSize staging_offset{ AcquireStaging(lock, chunk) };
+    std::memcpy(staging_allocation_.mapped + staging_offset,
+                data.data() + copied, chunk);
+
+    open_batch_->command_buffer.copyBuffer(
+      *staging_buffer_, buffer,
+      vk::BufferCopy{
+        .srcOffset = staging_offset,
+        .dstOffset = offset + copied,
+        .size = chunk
+      }
+    );
+    copied += chunk;
+  }
+
+  // The release barrier also covers chunks submitted in earlier batches,
+  // since those precede it on the same queue
+  const vk::BufferMemoryBarrier barrier{
+    .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+    .srcQueueFamilyIndex = transfer_family_,
+    .dstQueueFamilyIndex = graphics_family_,
+    .buffer = buffer,
+    .offset = offset,
+    .size = data.size()
+  };
+  RecordRelease(&barrier, nullptr);
+
+  uploaded_bytes_.fetch_add(data.size(), std::memory_order_relaxed);
+  return open_batch_->value;
+}
+
+std::uint64_t VulkanUploadQueue::UploadImage(vk::Image image,
+                                             vk::ImageAspectFlags aspect,
+                                             std::uint32_t mip_level,
+                                             vk::Extent2D extent,
+                                             std::uint32_t texel_size,
+                                             std::span<const std::byte> data) {
+  MAPLE_PROFILE_FUNCTION(LogRHI);
+
+  const vk::ImageSubresourceRange range{
+    .aspectMask = aspect,
+    .baseMipLevel = mip_level,
+    .levelCount = 1U,
+    .baseArrayLayer = 0U,
+    .layerCount = 1U
+  };
+
+  // Split by rows; chunks must start on the transfer granularity, and a
+  // granularity of zero only allows whole mip levels
+  const vk::DeviceSize row_size{
+    static_cast<vk::DeviceSize>(extent.width) * texel_size
+  };
+  std::uint32_t rows_per_chunk{ extent.height };
+  if (image_granularity_.height != 0U) {
+    const std::uint32_t max_rows{ static_cast<std::uint32_t>(
+      std::max<vk::DeviceSize>(staging_size_ / 4U / row_size, 1U)
+    ) };
+    rows_per_chunk = std::max(
+      max_rows - max_rows % image_granularity_.height,
+      std::min(image_granularity_.height, extent.height)
+    );
+  }
+  if (row_size * rows_per_chunk > staging_size_ / 2U) {
+    const std::string msg{
+      "Texture mip level is too large for the upload staging ring"
+    };
+    MAPLE_LOG_CRITICAL(LogRHI, msg);
+    throw std::runtime_error{ msg };
+  }
+
+  std::unique_lock lock{ mutex_ };
+  for (std::uint32_t row{ 0U }; row < extent.height;) {
+    const std::uint32_t rows{ std::min(rows_per_chunk, extent.height - row) };
+    const vk::DeviceSize chunk{ row_size * rows };
+    const vk::DeviceSize staging_offset{ AcquireStaging(lock, chunk) };
+    std::memcpy(staging_allocation_.mapped + staging_offset,
+                data.data() + row_size * row, chunk);
+
+    // Discard the previous contents before the first copy
+    if (row == 0U) {
+      const vk::ImageMemoryBarrier barrier{
+        .dstAccessMask = vk::AccessFlagBits::eTransferWrite,
+        .oldLayout = vk::ImageLayout::eUndefined,
+        .newLayout = vk::ImageLayout::eTransferDstOptimal,
+        .srcQueueFamilyIndex = vk::QueueFamilyIgnored,
+        .dstQueueFamilyIndex = vk::QueueFamilyIgnored,
+        .image = image,
+        .subresourceRange = range
+      };
+      open_batch_->command_buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTopOfPipe,
+        vk::PipelineStageFlagBits::eTransfer,
+        {}, {}, {}, barrier
+      );
+    }
+
+    open_batch_->command_buffer.copyBufferToImage(
+      *staging_buffer_, image, vk::ImageLayout::eTransferDstOptimal,
+      vk::BufferImageCopy{
+        .bufferOffset = staging_offset,
+        .bufferRowLength = 0U,
+        .bufferImageHeight = 0U,
+        .imageSubresource = vk::ImageSubresourceLayers{
+          .aspectMask = aspect,
+          .mipLevel = mip_level,
+          .baseArrayLayer = 0U,
+          .layerCount = 1U
+        },
+        .imageOffset = vk::Offset3D{ 0, static_cast<std::int32_t>(row), 0 },
+        .imageExtent = vk::Extent3D{ extent.width, rows, 1U }
+      }
+    );
+    row += rows;
+  }
+
+  const vk::ImageMemoryBarrier barrier{
+    .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+    .oldLayout = vk::ImageLayout::eTransferDstOptimal,
+    .newLayout = vk::ImageLayout::eShaderReadOnlyOptimal,
+    .srcQueueFamilyIndex = transfer_family_,
+    .dstQueueFamilyIndex = graphics_family_,
+    .image = image,
+    .subresourceRange = range
+  };
+  RecordRelease(nullptr, &barrier);
+
+  uploaded_bytes_.fetch_add(data.size(), std::memory_order_relaxed);
+  return open_batch_->value;
+}
+
+void VulkanUploadQueue::Submit() {
+  MAPLE_PROFILE_FUNCTION(LogRHI);
+
+  std::lock_guard lock{ mutex_ };
+  if (open_batch_) {
+    SubmitOpenBatch();
+  }
+  ReclaimCompletedBatches();
+}
+
+std::uint64_t VulkanUploadQueue::RecordAcquires(
+  vk::CommandBuffer command_buffer
+) {
+  std::lock_guard lock{ mutex_ };
+  if (pending_value_ == acquired_value_.load(std::memory_order_relaxed)) {
+    return 0U;
+  }
+
+  if (!pending_buffer_acquires_.empty() || !pending_image_acquires_.empty()) {
+    command_buffer.pipelineBarrier(
+      vk::PipelineStageFlagBits::eTopOfPipe,
+      vk::PipelineStageFlagBits::eAllCommands,
+      {}, {}, pending_buffer_acquires_, pending_image_acquires_
+    );
+    pending_buffer_acquires_.clear();
+    pending_image_acquires_.clear();
+  }
+
+  acquired_value_.store(pending_value_, std::memory_order_release);
+  return pending_value_;
+}
+
+bool VulkanUploadQueue::IsComplete(std::uint64_t ticket) const noexcept {
+  return ticket <= acquired_value_.load(std::memory_order_acquire);
+}
+
+void VulkanUploadQueue::Wait(std::uint64_t ticket) {
+  MAPLE_PROFILE_FUNCTION(LogRHI);
+
+  if (ticket == 0U) {
+    return;
+  }
+
+  {
+    std::lock_guard lock{ mutex_ };
+    if (open_batch_ && open_batch_->value <= ticket) {
+      SubmitOpenBatch();
+    }
+  }
+  WaitForValue(device_, *timeline_, ticket);
+}
+
+std::uint64_t VulkanUploadQueue::GetCompletedValue() const {
+  return device_.getSemaphoreCounterValue(*timeline_);
+}
+
+vk::Semaphore VulkanUploadQueue::GetTimeline() const noexcept {
+  return *timeline_;
+}
+
+std::uint64_t VulkanUploadQueue::GetUploadedBytes() const noexcept {
+  return uploaded_bytes_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t VulkanUploadQueue::GetSubmittedBatchCount() const noexcept {
+  return submitted_batch_count_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t VulkanUploadQueue::GetStallCount() const noexcept {
+  return stall_count_.load(std::memory_order_relaxed);
+}
+
+vk::DeviceSize VulkanUploadQueue::AcquireStaging(
+  std::unique_lock<std::mutex>& lock,
+  vk::DeviceSize size
+) {
+  while (true) {
+    ReclaimCompletedBatches();
+
+    const vk::DeviceSize used{ staging_used_ };
+    if (const auto offset{ AllocateStaging(size) }) {
+      Batch& batch{ GetOpenBatch() };
+      batch.staging_bytes += staging_used_ - used;
+      batch.staging_end = staging_head_;
+      return *offset;
+    }
+
+    // The ring is full of copies the GPU has not finished; submit them and
+    // wait for the oldest batch to free its memory
+    if (open_batch_) {
+      SubmitOpenBatch();
+    }
+    const std::uint64_t value{ submitted_batches_.front()->value };
+    stall_count_.fetch_add(1U, std::memory_order_relaxed);
+    MAPLE_LOG_DEBUG(LogRHI, "Upload stalled on a full staging ring");
+
+    lock.unlock();
+    WaitForValue(device_, *timeline_, value);
+    lock.lock();
+  }
+}
+
+std::optional<vk::DeviceSize> VulkanUploadQueue::AllocateStaging(
+  vk::DeviceSize size
+) noexcept {
+  if (staging_used_ == 0U) {
+    staging_head_ = 0U;
+    staging_tail_ = 0U;
+  } else if (staging_head_ == staging_tail_) {
+    return std::nullopt;
+  }
+
+  const vk::DeviceSize aligned{
+    (staging_head_ + kStagingAlignment - 1U) & ~(kStagingAlignment - 1U)
+  };
+  vk::DeviceSize offset{ aligned };
+  if (staging_head_ >= staging_tail_) {
+    // Free space is [head, size) followed by [0, tail)
+    if (aligned > staging_size_ || size > staging_size_ - aligned) {
+      if (size > staging_tail_) {
+        return std::nullopt;
+      }
+      offset = 0U;
+    }
+  } else if (size > staging_tail_ - std::min(aligned, staging_tail_)) {
+    // Free space is [head, tail)
+    return std::nullopt;
+  }
+
+  // Bytes skipped at the end of the ring by wrapping count as used until the
+  // batch that skipped them completes
+  staging_used_ += offset == 0U && staging_head_ != 0U
+                     ? staging_size_ - staging_head_ + size
+                     : offset + size - staging_head_;
+  staging_head_ = offset + size;
+  return offset;
+}
+
+VulkanUploadQueue::Batch& VulkanUploadQueue::GetOpenBatch() {
+  if (open_batch_) {
+    return *open_batch_;
+  }
+
+  std::unique_ptr<Batch> batch{};
+  if (free_batches_.empty()) {
+    batch = std::make_unique<Batch>();
+    batch->command_pool = device_.createCommandPoolUnique(
+      vk::CommandPoolCreateInfo{
+        .flags = vk::CommandPoolCreateFlagBits::eTransient,
+        .queueFamilyIndex = transfer_family_
+      }
+    );
+    batch->command_buffer = device_.allocateCommandBuffers(
+      vk::CommandBufferAllocateInfo{
+        .commandPool = *batch->command_pool,
+        .level = vk::CommandBufferLevel::ePrimary,
+        .commandBufferCount = 1U
+      }
+    ).front();
+  } else {
+    batch = std::move(free_batches_.back());
+    free_batches_.pop_back();
+    device_.resetCommandPool(*batch->command_pool);
+  }
+
+  batch->value = next_value_++;
+  batch->staging_bytes = 0U;
+  batch->staging_end = staging_head_;
+  batch->buffer_acquires.clear();
+  batch->image_acquires.clear();
+  batch->command_buffer.begin(vk::CommandBufferBeginInfo{
+    .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit
+  });
+
+  open_batch_ = std::move(batch);
+  return *open_batch_;
+}
+
+void VulkanUploadQueue::SubmitOpenBatch() {
+  Batch& batch{ *open_batch_ };
+  batch.command_buffer.end();
+
+  const vk::Semaphore timeline{ *timeline_ };
+  const vk::TimelineSemaphoreSubmitInfo timeline_info{
+    .signalSemaphoreValueCount = 1U,
+    .pSignalSemaphoreValues = &batch.value
+  };
+  const vk::SubmitInfo submit_info{
+    .pNext = &timeline_info,
+    .commandBufferCount = 1U,
+    .pCommandBuffers = &batch.command_buffer,
+    .signalSemaphoreCount = 1U,
+    .pSignalSemaphores = &timeline
+  };
+  {
+    std::lock_guard queue_lock{ queue_mutex_ };
+    transfer_queue_.submit(submit_info);
+  }
+
+  submitted_batches_.emplace_back(std::move(open_batch_));
+  submitted_batch_count_.fetch_add(1U, std::memory_order_relaxed);
+}
+
+void VulkanUploadQueue::ReclaimCompletedBatches() {
+  if (submitted_batches_.empty()) {
+    return;
+  }
+
+  const std::uint64_t completed{ GetCompletedValue() };
+  while (!submitted_batches_.empty()
+         && submitted_batches_.front()->value <= completed) {
+    std::unique_ptr<Batch> batch{ std::move(submitted_batches_.front()) };
+    submitted_batches_.pop_front();
+
+    staging_used_ -= batch->staging_bytes;
+    staging_tail_ = batch->staging_end;
+
+    pending_buffer_acquires_.insert(pending_buffer_acquires_.end(),
+                                    batch->buffer_acquires.begin(),
+                                    batch->buffer_acquires.end());
+    pending_image_acquires_.insert(pending_image_acquires_.end(),
+                                   batch->image_acquires.begin(),
+                                   batch->image_acquires.end());
+    pending_value_ = batch->value;
+
+    free_batches_.emplace_back(std::move(batch));
+  }
+}
+
+void VulkanUploadQueue::RecordRelease(
+  const vk::BufferMemoryBarrier* buffer_barrier,
+  const vk::ImageMemoryBarrier* image_barrier
+) {
+  Batch& batch{ *open_batch_ };
+
+  // Without an ownership transfer, buffers need no barrier (the frame's wait
+  // on the upload timeline makes the copies visible) and images only need
+  // their layout transition
+  if (!ownership_transfer_) {
+    if (image_barrier) {
+      vk::ImageMemoryBarrier transition{ *image_barrier };
+      transition.srcQueueFamilyIndex = vk::QueueFamilyIgnored;
+      transition.dstQueueFamilyIndex = vk::QueueFamilyIgnored;
+      batch.command_buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eBottomOfPipe,
+        {}, {}, {}, transition
+      );
+    }
+    return;
+  }
+
+  // Release on the transfer queue; the acquire repeats the barrier on the
+  // graphics queue with the destination access
+  if (buffer_barrier) {
+    batch.command_buffer.pipelineBarrier(
+      vk::PipelineStageFlagBits::eTransfer,
+      vk::PipelineStageFlagBits::eBottomOfPipe,
+      {}, {}, *buffer_barrier, {}
+    );
+    vk::BufferMemoryBarrier acquire{ *buffer_barrier };
+    acquire.srcAccessMask = {};
+    acquire.dstAccessMask = vk::AccessFlagBits::eMemoryRead;
+    batch.buffer_acquires.push_back(acquire);
+  }
+  if (image_barrier) {
+    batch.command_buffer.pipelineBarrier(
+      vk::PipelineStageFlagBits::eTransfer,
+      vk::PipelineStageFlagBits::eBottomOfPipe,
+      {}, {}, {}, *image_barrier
+    );
+    vk::ImageMemoryBarrier acquire{ *image_barrier };
+    acquire.srcAccessMask = {};
+    acquire.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+    batch.image_acquires.push_back(acquire);
+  }
+}
+
+} // namespace maple::rhi
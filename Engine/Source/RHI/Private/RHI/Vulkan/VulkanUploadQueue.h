@@ -0,0 +1,327 @@
+#pragma once
+
+// STL
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+// Vulkan
+#include "Vulkan/vulkan.hpp"
+
+// RHI
+#include "RHI/Vulkan/VulkanMemoryAllocator.h"
+
+namespace maple::rhi {
+
+/**
+ * @brief Streams buffer and image data to the GPU on the transfer queue.
+ *
+ * Uploads are copied into a persistently mapped staging ring and recorded
+ * into the open batch, a command buffer of the transfer queue. Batches are
+ * submitted once per frame (or early, when the ring fills up or an upload is
+ * waited for) and signal the upload timeline semaphore with their ticket.
+ *
+ * When the transfer family differs from the graphics family, each upload
+ * ends with a queue family release barrier; the matching acquire barrier is
+ * recorded into the first frame that starts after the batch completes, and
+ * the upload is complete from then on. Images are left in
+ * ShaderReadOnlyOptimal.
+ *
+ * @note Uploads may be issued from any thread; Submit() and RecordAcquires()
+ *       belong to the render thread.
+ */
+class VulkanUploadQueue {
+public:
+  VulkanUploadQueue() = delete;
+  VulkanUploadQueue(const VulkanUploadQueue&) = delete;
+  VulkanUploadQueue& operator=(const VulkanUploadQueue&) = delete;
+  VulkanUploadQueue(VulkanUploadQueue&&) = delete;
+  VulkanUploadQueue& operator=(VulkanUploadQueue&&) = delete;
+
+  /**
+   * @brief Create the staging ring and the upload timeline semaphore.
+   *
+   * @param device Logical device
+   * @param memory_allocator Allocator of the staging ring's memory
+   * @param transfer_queue Queue the copies are submitted to
+   * @param transfer_family Queue family of the transfer queue
+   * @param graphics_family Queue family that uses the uploaded resources
+   * @param image_granularity minImageTransferGranularity of the transfer
+   *                          family
+   * @param queue_mutex Guards submissions to the device's queues
+   * @param staging_size Bytes of the staging ring
+   */
+  VulkanUploadQueue(vk::Device device,
+                    VulkanMemoryAllocator& memory_allocator,
+                    vk::Queue transfer_queue,
+                    std::uint32_t transfer_family,
+                    std::uint32_t graphics_family,
+                    vk::Extent3D image_granularity,
+                    std::mutex& queue_mutex,
+                    vk::DeviceSize staging_size);
+
+  /**
+   * @brief Free the staging ring; the device must be idle.
+   */
+  ~VulkanUploadQueue();
+
+  /**
+   * @brief Copy data into a buffer.
+   *
+   * @param buffer Destination buffer (created with TransferDst usage)
+   * @param offset Offset of the destination range
+   * @param data Bytes to copy; copied into the staging ring before returning
+   * @return Ticket of the upload (0 if data is empty)
+   */
+  [[nodiscard]] std::uint64_t UploadBuffer(vk::Buffer buffer,
+                                           vk::DeviceSize offset,
+                                           std::span<const std::byte> data);
+
+  /**
+   * @brief Copy tightly packed texels into one mip level of an image.
+   *
+   * The previous contents of the mip level are discarded.
+   *
+   * @param image Destination image (created with TransferDst usage)
+   * @param aspect Aspect of the image's format
+   * @param mip_level Mip level to fill
+   * @param extent Size of the mip level
+   * @param texel_size Bytes per texel
+   * @param data Texels, row by row; copied before returning
+   * @return Ticket of the upload
+   */
+  [[nodiscard]] std::uint64_t UploadImage(vk::Image image,
+                                          vk::ImageAspectFlags aspect,
+                                          std::uint32_t mip_level,
+                                          vk::Extent2D extent,
+                                          std::uint32_t texel_size,
+                                          std::span<const std::byte> data);
+
+  /**
+   * @brief Submit the open batch and collect the acquire barriers of
+   *        completed batches.
+   *
+   * Called once per frame before RecordAcquires().
+   */
+  void Submit();
+
+  /**
+   * @brief Record the acquire barriers of completed batches into a frame.
+   *
+   * @param command_buffer Command buffer of the frame being recorded
+   * @return Upload timeline value the frame's submission must wait for, or 0
+   *         if no batch was acquired
+   */
+  [[nodiscard]] std::uint64_t RecordAcquires(vk::CommandBuffer command_buffer);
+
+  /**
+   * @brief Check whether frames recorded from now on see an upload.
+   *
+   * @param ticket Ticket returned by an upload
+   * @return true if the upload's batch has been acquired
+   */
+  [[nodiscard]] bool IsComplete(std::uint64_t ticket) const noexcept;
+
+  /**
+   * @brief Block until the GPU has finished an upload's copies.
+   *
+   * Submits the open batch first if it holds the upload.
+   *
+   * @param ticket Ticket returned by an upload
+   * @throws std::runtime_error If the wait fails
+   */
+  void Wait(std::uint64_t ticket);
+
+  /**
+   * @brief Get the last ticket whose copies the GPU has finished.
+   */
+  [[nodiscard]] std::uint64_t GetCompletedValue() const;
+
+  /**
+   * @brief Get the semaphore that batches signal with their ticket.
+   */
+  [[nodiscard]] vk::Semaphore GetTimeline() const noexcept;
+
+  /**
+   * @brief Get the bytes uploaded since creation.
+   */
+  [[nodiscard]] std::uint64_t GetUploadedBytes() const noexcept;
+
+  /**
+   * @brief Get the number of batches submitted since creation.
+   */
+  [[nodiscard]] std::uint64_t GetSubmittedBatchCount() const noexcept;
+
+  /**
+   * @brief Get the number of uploads that waited for the GPU to free staging
+   *        memory.
+   */
+  [[nodiscard]] std::uint64_t GetStallCount() const noexcept;
+
+private:
+  /**
+   * @brief Copies submitted together, and the staging memory they read.
+   */
+  struct Batch {
+    /// Pool of the batch's command buffer, reset when the batch is reused
+    vk::UniqueCommandPool command_pool{ nullptr };
+
+    /// Command buffer of the transfer queue (owned by the pool)
+    vk::CommandBuffer command_buffer{ nullptr };
+
+    /// Ticket of the batch's uploads, signaled when its copies complete
+    std::uint64_t value{ 0U };
+
+    /// Staging ring bytes consumed by the batch, including padding
+    vk::DeviceSize staging_bytes{ 0U };
+
+    /// Ring head after the batch's last staging allocation
+    vk::DeviceSize staging_end{ 0U };
+
+    /// Barriers the graphics queue records to take ownership of buffers
+    std::vector<vk::BufferMemoryBarrier> buffer_acquires{};
+
+    /// Barriers the graphics queue records to take ownership of images
+    std::vector<vk::ImageMemoryBarrier> image_acquires{};
+  };
+
+  /**
+   * @brief Reserve staging memory in the open batch, stalling until the GPU
+   *        frees enough of the ring.
+   *
+   * @param lock Held lock of mutex_, released while stalled
+   * @param size Bytes to reserve (at most a quarter of the ring)
+   * @return Offset of the reserved range within the staging buffer
+   */
+  [[nodiscard]] vk::DeviceSize AcquireStaging(std::unique_lock<std::mutex>& lock,
+                                              vk::DeviceSize size);
+
+  /**
+   * @brief Reserve a range at the head of the staging ring.
+   *
+   * @param size Bytes to reserve
+   * @return Offset of the range, or std::nullopt if the ring is full
+   */
+  [[nodiscard]] std::optional<vk::DeviceSize> AllocateStaging(
+    vk::DeviceSize size
+  ) noexcept;
+
+  /**
+   * @brief Get the open batch, opening one if needed.
+   */
+  [[nodiscard]] Batch& GetOpenBatch();
+
+  /**
+   * @brief Submit the open batch to the transfer queue.
+   */
+  void SubmitOpenBatch();
+
+  /**
+   * @brief Return the staging memory of completed batches and queue their
+   *        acquire barriers.
+   */
+  void ReclaimCompletedBatches();
+
+  /**
+   * @brief Record the end of an upload's copies into the open batch.
+   *
+   * Releases the resource to the graphics family, or only transitions the
+   * image layout when both families are the same.
+   *
+   * @param buffer_barrier Barrier of an uploaded buffer range, if any
+   * @param image_barrier Barrier of an uploaded image, if any
+   */
+  void RecordRelease(const vk::BufferMemoryBarrier* buffer_barrier,
+                     const vk::ImageMemoryBarrier* image_barrier);
+
+  /// Alignment of staging ranges (optimalBufferCopyOffsetAlignment is at
+  /// most this large in practice; texel sizes divide it)
+  static constexpr vk::DeviceSize kStagingAlignment{ 16U };
+
+  /// Logical device
+  vk::Device device_;
+
+  /// Allocator of the staging ring's memory
+  VulkanMemoryAllocator& memory_allocator_;
+
+  /// Queue the copies are submitted to
+  vk::Queue transfer_queue_;
+
+  /// Queue family of the transfer queue
+  std::uint32_t transfer_family_;
+
+  /// Queue family that uses the uploaded resources
+  std::uint32_t graphics_family_;
+
+  /// Image copies must be aligned to this granularity
+  vk::Extent3D image_granularity_;
+
+  /// Guards submissions to the device's queues
+  std::mutex& queue_mutex_;
+
+  /// Whether uploads change queue family ownership
+  bool ownership_transfer_;
+
+  /// Staging ring
+  vk::UniqueBuffer staging_buffer_{ nullptr };
+
+  /// Memory of the staging ring
+  VulkanAllocation staging_allocation_{};
+
+  /// Bytes of the staging ring
+  vk::DeviceSize staging_size_;
+
+  /// Signaled by each batch with its ticket
+  vk::UniqueSemaphore timeline_{ nullptr };
+
+  /// Guards the ring and the batches
+  mutable std::mutex mutex_{};
+
+  /// Offset of the next staging allocation
+  vk::DeviceSize staging_head_{ 0U };
+
+  /// Offset of the oldest staging range the GPU may still read
+  vk::DeviceSize staging_tail_{ 0U };
+
+  /// Bytes of the ring in use, including padding
+  vk::DeviceSize staging_used_{ 0U };
+
+  /// Ticket of the next batch
+  std::uint64_t next_value_{ 1U };
+
+  /// Batch uploads are recorded into (null until the next upload)
+  std::unique_ptr<Batch> open_batch_{ nullptr };
+
+  /// Submitted batches, oldest first
+  std::deque<std::unique_ptr<Batch>> submitted_batches_{};
+
+  /// Completed batches, reused when a batch is opened
+  std::vector<std::unique_ptr<Batch>> free_batches_{};
+
+  /// Acquire barriers of completed batches, awaiting RecordAcquires()
+  std::vector<vk::BufferMemoryBarrier> pending_buffer_acquires_{};
+  std::vector<vk::ImageMemoryBarrier> pending_image_acquires_{};
+
+  /// Ticket of the last completed batch
+  std::uint64_t pending_value_{ 0U };
+
+  /// Ticket of the last batch acquired by a frame (any thread)
+  std::atomic<std::uint64_t> acquired_value_{ 0U };
+
+  /// Bytes uploaded since creation (any thread)
+  std::atomic<std::uint64_t> uploaded_bytes_{ 0U };
+
+  /// Batches submitted since creation (any thread)
+  std::atomic<std::uint64_t> submitted_batch_count_{ 0U };
+
+  /// Uploads that waited for staging memory (any thread)
+  std::atomic<std::uint64_t> stall_count_{ 0U };
+};
+
+} // namespace maple::rhi
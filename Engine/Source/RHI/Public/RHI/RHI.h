@@ -1,17 +1,30 @@
 #pragma once
 
 // STL
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
+
+// Core
+#include "Core/Memory.h"
 
 // RHI
+#include "RHI/RHIBindless.h"
+#include "RHI/RHICommandList.h"
+#include "RHI/RHIConfig.h"
 #include "RHI/RHIExport.h"
+#include "RHI/RHIPipeline.h"
+#include "RHI/RHIResources.h"
+#include "RHI/RHIStats.h"
 
 // Forward declarations
 namespace maple::platform { class Window; }
 
 namespace maple::rhi {
 
-class MAPLE_RHI_API RHI {
+class MAPLE_RHI_API RHI
+  : public core::TrackedAllocation<core::MemoryTag::RHI> {
 public:
   virtual ~RHI() = default;
 
@@ -25,13 +38,16 @@ public:
    * @brief Create an RHI backend for the window's graphics API.
    *
    * Factory function that instantiates the appropriate backend implementation
-   * based on the window's configured graphics API (D3D12, Metal, or Vulkan).
+   * based on the window's configured graphics API (D3D12, Metal, Vulkan, or
+   * Null).
    *
    * @param window Non-owning pointer to the window (must not be null)
+   * @param config Device selection and backend settings
    * @return Unique pointer to the created RHI backend
    * @throws std::runtime_error If the backend is unavailable or creation fails
    */
-  static std::unique_ptr<RHI> Create(platform::Window* window);
+  static std::unique_ptr<RHI> Create(platform::Window* window,
+                                     const RHIConfig& config = {});
 
   /**
    * @brief Begin a new rendering frame.
@@ -48,8 +64,54 @@ public:
    */
   virtual void Clear(float r, float g, float b, float a) = 0;
 
+  /**
+   * @brief Begin recording a command list for the current frame.
+   *
+   * May be called from any thread between BeginFrame() and EndFrame(), so
+   * that a frame's commands can be recorded across cores. EndFrame() submits
+   * the ended lists after the frame's immediate commands (e.g., Clear()) in
+   * ascending sort key order, independent of which thread recorded them or
+   * when they were ended.
+   *
+   * Compute lists run on the async compute queue, concurrently with the
+   * graphics lists, and in sort key order among themselves. Lists of
+   * different queues are only ordered by waits: a list starts once the
+   * lists of the other queue it waits for have finished. A frame's compute
+   * lists start after the previous frame's graphics work, and its graphics
+   * work ends after its compute lists. Without an async compute queue (see
+   * HasAsyncCompute()), compute lists run on the graphics queue in sort key
+   * order and their waits are met by that order.
+   *
+   * @param sort_key Submission position of the list (unique within a frame)
+   * @param queue Queue the list runs on
+   * @param wait_sort_keys Sort keys of lists ended this frame to wait for
+   *                       (smaller than sort_key; lists of the same queue
+   *                       are ordered already)
+   * @return Non-owning pointer to the list, valid until EndCommandList()
+   */
+  [[nodiscard]] virtual RHICommandList* BeginCommandList(
+    std::uint64_t sort_key,
+    QueueType queue = QueueType::Graphics,
+    std::span<const std::uint64_t> wait_sort_keys = {}
+  ) = 0;
+
+  /**
+   * @brief Finish recording a command list and queue it for submission.
+   *
+   * Must be called on the thread that recorded the list, before EndFrame().
+   *
+   * @param command_list List returned by BeginCommandList()
+   */
+  virtual void EndCommandList(RHICommandList* command_list) = 0;
+
   /**
    * @brief End the current rendering frame.
+   *
+   * Submits the frame's immediate commands followed by its command lists.
+   *
+   * @throws std::runtime_error If two command lists share a sort key, or a
+   *                            list waits for a list that was not ended this
+   *                            frame or does not precede it
    */
   virtual void EndFrame() = 0;
 
@@ -58,6 +120,396 @@ public:
    */
   virtual void Present() = 0;
 
+  /**
+   * @brief Get the GPU times of the zones of finished frames.
+   *
+   * BeginFrame() collects the zones of every frame the GPU has finished
+   * since the previous call, usually the previous frame, without waiting
+   * for the GPU. Besides the zones of command lists, the backend times each
+   * frame ("Frame") and its immediate commands (e.g., "Clear"). GPU
+   * timestamps are mapped onto the CPU profiler clock, so the zones line up
+   * with CPU zones in a trace.
+   *
+   * @return Zones in the order their frames were submitted, valid until the
+   *         next BeginFrame(); empty if the backend does not time the GPU
+   */
+  [[nodiscard]] virtual std::span<const GpuZone> GetGpuZones() const = 0;
+
+  /**
+   * @brief Check whether compute lists run on their own queue.
+   *
+   * @return true if the device has a compute queue besides the graphics
+   *         queue (in a compute family or the graphics family) and
+   *         RHIConfig::async_compute is set
+   */
+  [[nodiscard]] virtual bool HasAsyncCompute() const noexcept = 0;
+
+  /**
+   * @brief Change how frames are presented.
+   *
+   * Takes effect at the start of the next frame; may be called from any
+   * thread.
+   *
+   * @param present_mode Requested presentation mode (falls back to Fifo if
+   *                     unsupported)
+   */
+  virtual void SetPresentMode(PresentMode present_mode) = 0;
+
+  /**
+   * @brief Create a buffer sub-allocated from the backend's memory pools.
+   *
+   * May be called from any thread.
+   *
+   * Storage buffers get a slot in the bindless heap (see
+   * GetBindlessIndex()).
+   *
+   * @param desc Size, usage, and memory access of the buffer
+   * @return Handle to the buffer
+   * @throws std::runtime_error If the buffer or its memory cannot be created,
+   *                            or the bindless heap is full
+   */
+  [[nodiscard]] virtual BufferHandle CreateBuffer(const BufferDesc& desc) = 0;
+
+  /**
+   * @brief Destroy a buffer once the GPU has finished using it.
+   *
+   * May be called from any thread; stale and invalid handles are ignored.
+   *
+   * @param buffer Buffer to destroy
+   */
+  virtual void DestroyBuffer(BufferHandle buffer) = 0;
+
+  /**
+   * @brief Get the CPU address of a mapped buffer.
+   *
+   * Buffers created with CpuToGpu or GpuToCpu memory stay mapped for their
+   * whole lifetime.
+   *
+   * @param buffer Buffer to access
+   * @return Pointer to the buffer's memory, or nullptr if the buffer is not
+   *         host-visible or the handle is stale
+   */
+  [[nodiscard]] virtual void* MapBuffer(BufferHandle buffer) = 0;
+
+  /**
+   * @brief Create a texture sub-allocated from the backend's memory pools.
+   *
+   * May be called from any thread.
+   *
+   * Sampled and storage textures get a slot in the bindless heap per usage
+   * (see GetBindlessIndex()).
+   *
+   * @param desc Size, format, and usage of the texture
+   * @return Handle to the texture
+   * @throws std::runtime_error If the texture or its memory cannot be created,
+   *                            or the bindless heap is full
+   */
+  [[nodiscard]] virtual TextureHandle CreateTexture(const TextureDesc& desc) = 0;
+
+  /**
+   * @brief Destroy a texture once the GPU has finished using it.
+   *
+   * May be called from any thread; stale and invalid handles are ignored.
+   *
+   * @param texture Texture to destroy
+   */
+  virtual void DestroyTexture(TextureHandle texture) = 0;
+
+  /**
+   * @brief Get the memory a texture would need if placed in a memory heap.
+   *
+   * May be called from any thread.
+   *
+   * @param desc Size, format, and usage of the texture
+   * @return Size, alignment, and memory types of the texture
+   * @throws std::runtime_error If the description is invalid
+   */
+  [[nodiscard]] virtual MemoryRequirements GetTextureMemoryRequirements(
+    const TextureDesc& desc
+  ) const = 0;
+
+  /**
+   * @brief Allocate GPU-only memory to place textures in.
+   *
+   * Textures placed in a heap may overlap, which lets textures that are
+   * never used at the same time share memory. May be called from any
+   * thread.
+   *
+   * @param requirements Size, alignment, and memory types the heap must
+   *                     satisfy (e.g., the combined requirements of the
+   *                     textures to place)
+   * @return Handle to the heap
+   * @throws std::runtime_error If no memory type fits or device memory is
+   *                            exhausted
+   */
+  [[nodiscard]] virtual MemoryHeapHandle CreateMemoryHeap(
+    const MemoryRequirements& requirements
+  ) = 0;
+
+  /**
+   * @brief Free a memory heap once the GPU has finished using it.
+   *
+   * Textures placed in the heap must be destroyed first. May be called from
+   * any thread; stale and invalid handles are ignored.
+   *
+   * @param heap Heap to free
+   */
+  virtual void DestroyMemoryHeap(MemoryHeapHandle heap) = 0;
+
+  /**
+   * @brief Create a texture in memory of a heap.
+   *
+   * The texture does not own its memory, and its contents are undefined
+   * whenever another texture overlapping it was used since, so its first
+   * use after such a texture must transition it from
+   * ResourceState::Undefined. Destroy it with DestroyTexture(). May be
+   * called from any thread.
+   *
+   * @param desc Size, format, and usage of the texture
+   * @param heap Heap to place the texture in
+   * @param offset Byte offset into the heap (a multiple of the alignment
+   *               from GetTextureMemoryRequirements())
+   * @return Handle to the texture
+   * @throws std::runtime_error If the heap handle is stale, the range
+   *                            exceeds the heap or is misaligned, the heap's
+   *                            memory type does not fit the texture, or the
+   *                            bindless heap is full
+   */
+  [[nodiscard]] virtual TextureHandle CreatePlacedTexture(
+    const TextureDesc& desc,
+    MemoryHeapHandle heap,
+    std::uint64_t offset
+  ) = 0;
+
+  /**
+   * @brief Get the index shaders read a storage buffer at.
+   *
+   * The index stays valid until the buffer is destroyed, and is reused only
+   * once the GPU has finished every frame that could read the buffer. May be
+   * called from any thread.
+   *
+   * @param buffer Buffer created with BufferUsage::Storage
+   * @return Index into the BindlessSet::StorageBuffers array, or
+   *         kInvalidBindlessIndex if the buffer is not a storage buffer or
+   *         the handle is stale
+   */
+  [[nodiscard]] virtual std::uint32_t GetBindlessIndex(
+    BufferHandle buffer
+  ) const = 0;
+
+  /**
+   * @brief Get the index shaders read a texture at.
+   *
+   * Sampled textures are read in ShaderReadOnlyOptimal layout and storage
+   * textures in General layout. The index stays valid until the texture is
+   * destroyed. May be called from any thread.
+   *
+   * @param texture Texture to look up
+   * @param usage TextureUsage::Sampled for the BindlessSet::SampledTextures
+   *              array, or TextureUsage::Storage for the
+   *              BindlessSet::StorageTextures array
+   * @return Index into the array, or kInvalidBindlessIndex if the texture
+   *         was not created with the usage or the handle is stale
+   */
+  [[nodiscard]] virtual std::uint32_t GetBindlessIndex(
+    TextureHandle texture,
+    TextureUsage usage
+  ) const = 0;
+
+  /**
+   * @brief Copy data into a buffer asynchronously.
+   *
+   * The data is copied into a staging ring before the call returns, so the
+   * caller may reuse it immediately. Uploads are batched and submitted at
+   * the start of the next frame on the transfer queue, and never stall the
+   * frame loop. May be called from any thread; blocks only if the staging
+   * ring is full of uploads the GPU has not finished.
+   *
+   * @param buffer Destination buffer
+   * @param offset Byte offset into the buffer
+   * @param data Bytes to copy
+   * @return Ticket to poll or wait for
+   * @throws std::runtime_error If the handle is stale or the range exceeds
+   *                            the buffer
+   */
+  [[nodiscard]] virtual UploadTicket UploadBuffer(
+    BufferHandle buffer,
+    std::uint64_t offset,
+    std::span<const std::byte> data
+  ) = 0;
+
+  /**
+   * @brief Copy the pixels of one mip level into a texture asynchronously.
+   *
+   * Behaves like UploadBuffer(). The mip level is left ready for sampling.
+   *
+   * @param texture Destination texture
+   * @param mip_level Mip level to replace
+   * @param data Tightly packed pixels of the whole mip level
+   * @return Ticket to poll or wait for
+   * @throws std::runtime_error If the handle is stale, the mip level does not
+   *                            exist, or the data size does not match it
+   */
+  [[nodiscard]] virtual UploadTicket UploadTexture(
+    TextureHandle texture,
+    std::uint32_t mip_level,
+    std::span<const std::byte> data
+  ) = 0;
+
+  /**
+   * @brief Check whether an upload may be used by the GPU.
+   *
+   * May be called from any thread.
+   *
+   * @param ticket Ticket returned by an upload
+   * @return true if frames recorded from now on see the uploaded data
+   */
+  [[nodiscard]] virtual bool IsUploadComplete(UploadTicket ticket) const = 0;
+
+  /**
+   * @brief Block until the GPU has finished an upload.
+   *
+   * Submits the upload's batch if it is still open. The data may be used
+   * from the next BeginFrame() on. Never call this in the frame loop.
+   *
+   * @param ticket Ticket returned by an upload
+   */
+  virtual void WaitForUpload(UploadTicket ticket) = 0;
+
+  /**
+   * @brief Allocate per-frame data from a persistently mapped ring buffer.
+   *
+   * Costs one atomic operation and never maps memory or creates buffers. The
+   * memory is host-visible and coherent, so writes need no flush. May be
+   * called from any thread between BeginFrame() and EndFrame(); the range
+   * is recycled once the GPU has finished the frame.
+   *
+   * @param size Size in bytes
+   * @param usage How the GPU reads the data (determines the alignment, e.g.,
+   *              the dynamic offset alignment of uniform buffers)
+   * @return Writable range and its location on the GPU
+   * @throws std::runtime_error If the frame's share of the ring is exhausted
+   *                            (see RHIConfig::transient_buffer_size)
+   */
+  [[nodiscard]] virtual TransientAllocation AllocateTransient(
+    std::uint64_t size,
+    BufferUsage usage
+  ) = 0;
+
+  /**
+   * @brief Create a shader module from SPIR-V.
+   *
+   * May be called from any thread.
+   *
+   * @param desc Stage and code of the shader
+   * @return Handle to the shader
+   * @throws std::runtime_error If the code is not SPIR-V or the module cannot
+   *                            be created
+   */
+  [[nodiscard]] virtual ShaderHandle CreateShader(const ShaderDesc& desc) = 0;
+
+  /**
+   * @brief Destroy a shader module.
+   *
+   * Pipelines already compiled from the shader stay valid. May be called
+   * from any thread; stale and invalid handles are ignored.
+   *
+   * @param shader Shader to destroy
+   */
+  virtual void DestroyShader(ShaderHandle shader) = 0;
+
+  /**
+   * @brief Compile a graphics pipeline.
+   *
+   * Compilation goes through the backend's pipeline cache, which is loaded
+   * from RHIConfig::pipeline_cache_path at startup and saved on shutdown, so
+   * pipelines compiled in earlier runs (or warmed up by WarmupPipelines())
+   * are created far faster. May be called from any thread.
+   *
+   * @param desc Shaders and fixed-function state of the pipeline
+   * @return Handle to the pipeline
+   * @throws std::runtime_error If a shader handle is stale or of the wrong
+   *                            stage, or compilation fails
+   */
+  [[nodiscard]] virtual PipelineHandle CreateGraphicsPipeline(
+    const GraphicsPipelineDesc& desc
+  ) = 0;
+
+  /**
+   * @brief Get the shared pipeline of a description, compiling it on first
+   *        use.
+   *
+   * Identical descriptions (see GraphicsPipelineDesc::operator==) share one
+   * pipeline, which lives until the RHI is destroyed. Lookups of compiled
+   * pipelines are lock-free, so this may be called per draw from any number
+   * of recording threads; concurrent first uses compile once while the
+   * other callers wait.
+   *
+   * @param desc Shaders and fixed-function state of the pipeline
+   * @return Handle to the shared pipeline
+   * @throws std::runtime_error If a shader handle is stale or of the wrong
+   *                            stage, compilation fails, or the cache is full
+   *                            (see RHIConfig::max_cached_pipelines)
+   */
+  [[nodiscard]] virtual PipelineHandle GetGraphicsPipeline(
+    const GraphicsPipelineDesc& desc
+  ) = 0;
+
+  /**
+   * @brief Destroy a pipeline once the GPU has finished using it.
+   *
+   * May be called from any thread; stale and invalid handles, and shared
+   * pipelines from GetGraphicsPipeline(), are ignored.
+   *
+   * @param pipeline Pipeline to destroy
+   */
+  virtual void DestroyPipeline(PipelineHandle pipeline) = 0;
+
+  /**
+   * @brief Precompile pipelines on job threads.
+   *
+   * Returns immediately. The pipelines are added to the cache of
+   * GetGraphicsPipeline(); those that fail to compile are logged and
+   * skipped. Call at startup or on a loading screen with the pipelines the
+   * next scene needs, so their first use does not stutter. The shaders must
+   * stay alive until IsPipelineWarmupComplete() returns true.
+   *
+   * @param manifest Descriptions of the pipelines to precompile (copied)
+   */
+  virtual void WarmupPipelines(
+    std::span<const GraphicsPipelineDesc> manifest
+  ) = 0;
+
+  /**
+   * @brief Check whether every warmup has finished.
+   *
+   * @return true if no warmup compilation is running
+   */
+  [[nodiscard]] virtual bool IsPipelineWarmupComplete() const = 0;
+
+  /**
+   * @brief Compact GPU memory at the start of the next frame.
+   *
+   * Relocates GPU-only buffers out of sparsely used memory blocks so that
+   * the blocks can be released. Handles stay valid. Storage buffers stay in
+   * place, since their bindless descriptors may be read by frames in flight.
+   */
+  virtual void DefragmentMemory() = 0;
+
+  /**
+   * @brief Get the GPU memory usage of the backend.
+   *
+   * @return Memory statistics as of the call
+   */
+  [[nodiscard]] virtual RHIMemoryStats GetMemoryStats() const = 0;
+
+  /**
+   * @brief Get the per-call counters collected by the backend.
+   *
+   * @return Counters accumulated since the backend was created
+   */
+  [[nodiscard]] virtual RHIStats GetStats() const noexcept;
+
 protected:
   /**
    * @brief Construct the RHI base class.
@@ -0,0 +1,59 @@
+#pragma once
+
+// STL
+#include <cstdint>
+#include <limits>
+
+namespace maple::rhi {
+
+/// Bindless index of a resource without a descriptor of the requested kind
+inline constexpr std::uint32_t kInvalidBindlessIndex{
+  std::numeric_limits<std::uint32_t>::max()
+};
+
+/**
+ * @brief Descriptor sets of the bindless heap, numbered as in shaders.
+ *
+ * Each set holds one runtime-sized array at binding 0, bound once per
+ * command list for every pipeline. Shaders index the arrays with the
+ * integers returned by RHI::GetBindlessIndex() (with nonuniformEXT when the
+ * index varies within a draw), e.g.:
+ *
+ *   layout(set = 0, binding = 0) uniform texture2D textures[];
+ *   layout(set = 3, binding = 0) uniform sampler samplers[];
+ */
+enum class BindlessSet : std::uint32_t {
+  /// Textures created with TextureUsage::Sampled
+  SampledTextures = 0U,
+
+  /// Textures created with TextureUsage::Storage
+  StorageTextures = 1U,
+
+  /// Buffers created with BufferUsage::Storage
+  StorageBuffers = 2U,
+
+  /// Fixed samplers, indexed by BindlessSampler
+  Samplers = 3U
+};
+
+/**
+ * @brief Samplers at fixed indices of the BindlessSet::Samplers array.
+ */
+enum class BindlessSampler : std::uint32_t {
+  /// Trilinear, wrapping (anisotropic where supported)
+  LinearRepeat,
+
+  /// Trilinear, clamped to the edge (anisotropic where supported)
+  LinearClamp,
+
+  /// Point sampled, wrapping
+  NearestRepeat,
+
+  /// Point sampled, clamped to the edge
+  NearestClamp,
+
+  /// Number of samplers
+  Count
+};
+
+} // namespace maple::rhi
@@ -0,0 +1,105 @@
+#pragma once
+
+// STL
+#include <cstdint>
+#include <span>
+
+// Core
+#include "Core/Memory.h"
+
+// RHI
+#include "RHI/RHIExport.h"
+#include "RHI/RHIResources.h"
+
+namespace maple::rhi {
+
+/**
+ * @brief List of GPU commands recorded for the current frame.
+ *
+ * Obtained from RHI::BeginCommandList() and handed back with
+ * RHI::EndCommandList(). Different lists may be recorded on different threads
+ * at the same time, but each list must be recorded by one thread at a time.
+ */
+class MAPLE_RHI_API RHICommandList
+  : public core::TrackedAllocation<core::MemoryTag::RHI> {
+public:
+  virtual ~RHICommandList() = default;
+
+  RHICommandList(const RHICommandList&) = delete;
+  RHICommandList& operator=(const RHICommandList&) = delete;
+  RHICommandList(RHICommandList&&) = delete;
+  RHICommandList& operator=(RHICommandList&&) = delete;
+
+  /**
+   * @brief Clear the frame's render target to a solid color.
+   *
+   * Graphics lists only.
+   *
+   * @param r Red component [0.0 - 1.0]
+   * @param g Green component [0.0 - 1.0]
+   * @param b Blue component [0.0 - 1.0]
+   * @param a Alpha component [0.0 - 1.0]
+   */
+  virtual void Clear(float r, float g, float b, float a) = 0;
+
+  /**
+   * @brief Transition resources between states with one pipeline barrier.
+   *
+   * Each transition waits for the accesses of its before state recorded
+   * earlier in this list or in lists submitted before it, and blocks the
+   * accesses of its after state. A transition from ResourceState::Undefined
+   * discards the contents and waits for every earlier access, so a texture
+   * placed over memory other textures used (see RHI::CreatePlacedTexture())
+   * starts its lifetime this way.
+   *
+   * Resources are owned by the graphics queue until handed to another
+   * queue. A hand-over is a transition whose queues differ, recorded twice
+   * with the same values: on a list of the source queue after its last
+   * access there, then on a list of the destination queue that waits for
+   * that list (see RHI::BeginCommandList()). A transition from Undefined
+   * needs no source side. Compute lists may only use compute states (see
+   * IsComputeState()) on their side of a transition.
+   *
+   * @param textures Texture transitions (stale handles are skipped)
+   * @param buffers Buffer transitions (stale handles are skipped)
+   */
+  virtual void Barrier(std::span<const TextureBarrier> textures,
+                       std::span<const BufferBarrier> buffers) = 0;
+
+  /**
+   * @brief Fill a buffer with a repeated 32-bit value.
+   *
+   * Graphics and compute lists. The buffer must have been created with
+   * BufferUsage::TransferDst and be in ResourceState::TransferDst.
+   *
+   * @param buffer Buffer to fill (stale handles are skipped)
+   * @param value Value written to every 4 bytes of the buffer
+   */
+  virtual void FillBuffer(BufferHandle buffer, std::uint32_t value) = 0;
+
+  /**
+   * @brief Start timing the commands recorded next on the GPU.
+   *
+   * Zones nest, and must be ended in the same list. Their times are
+   * reported once the GPU has finished the frame (see RHI::GetGpuZones()).
+   * Zones beyond RHIConfig::max_gpu_zones in a frame are not timed.
+   *
+   * @param name Zone name (string literal)
+   */
+  virtual void BeginGpuZone(const char* name) = 0;
+
+  /**
+   * @brief Stop timing the innermost zone started in this list.
+   */
+  virtual void EndGpuZone() = 0;
+
+protected:
+  /**
+   * @brief Construct the command list base class.
+   *
+   * Protected to enforce creation through RHI::BeginCommandList().
+   */
+  RHICommandList() = default;
+};
+
+} // namespace maple::rhi
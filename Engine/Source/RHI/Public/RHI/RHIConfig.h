@@ -0,0 +1,80 @@
+#pragma once
+
+// STL
+#include <cstdint>
+#include <string>
+
+namespace maple::rhi {
+
+/**
+ * @brief How finished frames are handed to the display.
+ */
+enum class PresentMode {
+  /// Wait for vertical blank; never tears (always supported)
+  Fifo,
+
+  /// Wait for vertical blank unless the frame is late, then tear
+  FifoRelaxed,
+
+  /// Replace the queued frame with the newest one; lowest latency without
+  /// tearing
+  Mailbox
+};
+
+/**
+ * @brief Configuration for creating an RHI backend.
+ */
+struct RHIConfig {
+  /// Use the first device whose name contains this text instead of the
+  /// highest-scoring one (e.g., "llvmpipe" to force a software rasterizer);
+  /// empty for automatic selection
+  std::string device_name{};
+
+  /// Use the device at this enumeration index instead of the highest-scoring
+  /// one; negative for automatic selection (takes precedence over the name)
+  std::int32_t device_index{ -1 };
+
+  /// Number of frames the CPU may record ahead of the GPU [1 - 3]
+  std::uint32_t frames_in_flight{ 2U };
+
+  /// Presentation mode (falls back to Fifo if unsupported)
+  PresentMode present_mode{ PresentMode::Fifo };
+
+  /// Run compute command lists on a dedicated compute queue when the device
+  /// has one; disable to compare against running them on the graphics queue
+  bool async_compute{ true };
+
+  /// Bytes of per-frame uniform and dynamic vertex data (see
+  /// RHI::AllocateTransient()); reserved once per frame in flight
+  std::uint64_t transient_buffer_size{ 4U * 1024U * 1024U };
+
+  /// Most bytes the process may use in each memory heap, when lower than
+  /// the driver's budget (e.g., to test low-memory behavior); 0 for no limit
+  std::uint64_t memory_budget_limit{ 0U };
+
+  /// Bytes of the staging ring that uploads are copied through; larger
+  /// uploads are split into chunks of a quarter of the ring
+  std::uint64_t upload_buffer_size{ 32U * 1024U * 1024U };
+
+  /// File the compiled pipeline cache is loaded from at startup and saved
+  /// to on shutdown; empty to keep the cache in memory only
+  std::string pipeline_cache_path{ "PipelineCache.bin" };
+
+  /// Most GPU zones timed per frame, including the backend's own (see
+  /// RHICommandList::BeginGpuZone()); 0 disables GPU timing
+  std::uint32_t max_gpu_zones{ 256U };
+
+  /// Most distinct descriptions RHI::GetGraphicsPipeline() caches; keep it
+  /// about twice the expected count so lookups stay short
+  std::uint32_t max_cached_pipelines{ 4096U };
+
+  /// Slots of each bindless texture array (sampled and storage); clamped to
+  /// the device's limits
+  std::uint32_t max_bindless_textures{ 16384U };
+
+  /// Slots of the bindless storage buffer array; clamped to the device's
+  /// limits
+  std::uint32_t max_bindless_buffers{ 16384U };
+};
+
+} // namespace maple::rhi
@@ -0,0 +1,294 @@
+#pragma once
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+// RHI
+#include "RHI/RHIResources.h"
+
+namespace maple::rhi {
+
+/// Handle to a shader module
+using ShaderHandle = RHIHandle<struct ShaderTag>;
+
+/// Handle to a compiled pipeline
+using PipelineHandle = RHIHandle<struct PipelineTag>;
+
+/// Upper bound on vertex buffer bindings per pipeline
+inline constexpr std::uint32_t kMaxVertexBindings{ 4U };
+
+/// Upper bound on vertex attributes per pipeline
+inline constexpr std::uint32_t kMaxVertexAttributes{ 8U };
+
+/// First word of every SPIR-V module
+inline constexpr std::uint32_t kSpirvMagic{ 0x07230203U };
+
+/**
+ * @brief Pipeline stage a shader runs in.
+ */
+enum class ShaderStage {
+  Vertex,
+  Fragment,
+  Compute
+};
+
+/**
+ * @brief Description of a shader module to create.
+ */
+struct ShaderDesc {
+  /// Stage the shader runs in
+  ShaderStage stage{ ShaderStage::Vertex };
+
+  /// SPIR-V words; the entry point must be named "main". Copied by
+  /// RHI::CreateShader()
+  std::span<const std::uint32_t> code{};
+};
+
+/**
+ * @brief Format of a vertex attribute.
+ */
+enum class VertexFormat {
+  Float,
+  Float2,
+  Float3,
+  Float4,
+  UByte4Unorm,
+  UInt
+};
+
+/**
+ * @brief Vertex buffer bound to a pipeline; the binding index is the
+ *        position in GraphicsPipelineDesc::vertex_bindings.
+ */
+struct VertexBinding {
+  /// Bytes between consecutive elements
+  std::uint32_t stride{ 0U };
+
+  /// Whether the buffer advances per instance instead of per vertex
+  bool per_instance{ false };
+
+  bool operator==(const VertexBinding&) const = default;
+};
+
+/**
+ * @brief Vertex attribute read by the vertex shader.
+ */
+struct VertexAttribute {
+  /// Shader input location
+  std::uint32_t location{ 0U };
+
+  /// Vertex binding the attribute is read from
+  std::uint32_t binding{ 0U };
+
+  /// Format of the attribute
+  VertexFormat format{ VertexFormat::Float3 };
+
+  /// Byte offset within an element of the binding
+  std::uint32_t offset{ 0U };
+
+  bool operator==(const VertexAttribute&) const = default;
+};
+
+/**
+ * @brief How primitives are assembled from vertices.
+ */
+enum class PrimitiveTopology {
+  TriangleList,
+  TriangleStrip,
+  LineList,
+  PointList
+};
+
+/**
+ * @brief Which triangle faces are discarded (front faces are
+ *        counter-clockwise).
+ */
+enum class CullMode {
+  None,
+  Front,
+  Back
+};
+
+/**
+ * @brief How fragment colors are combined with the render target.
+ */
+enum class BlendMode {
+  /// Overwrite the target
+  Opaque,
+
+  /// Blend by source alpha
+  AlphaBlend,
+
+  /// Add to the target
+  Additive
+};
+
+/**
+ * @brief Comparison of a fragment's depth against the depth buffer.
+ */
+enum class CompareOp {
+  Never,
+  Less,
+  Equal,
+  LessOrEqual,
+  Greater,
+  NotEqual,
+  GreaterOrEqual,
+  Always
+};
+
+/**
+ * @brief Description of a graphics pipeline to compile.
+ *
+ * A plain value with fixed-size arrays, so descriptions can be stored in
+ * manifests, compared, and hashed cheaply. Viewport and scissor are dynamic
+ * state.
+ */
+struct GraphicsPipelineDesc {
+  /// Vertex stage
+  ShaderHandle vertex_shader{};
+
+  /// Fragment stage
+  ShaderHandle fragment_shader{};
+
+  /// Vertex buffers; the first vertex_binding_count entries are used
+  std::array<VertexBinding, kMaxVertexBindings> vertex_bindings{};
+  std::uint32_t vertex_binding_count{ 0U };
+
+  /// Vertex attributes; the first vertex_attribute_count entries are used
+  std::array<VertexAttribute, kMaxVertexAttributes> vertex_attributes{};
+  std::uint32_t vertex_attribute_count{ 0U };
+
+  /// Primitive assembly
+  PrimitiveTopology topology{ PrimitiveTopology::TriangleList };
+
+  /// Face culling
+  CullMode cull_mode{ CullMode::Back };
+
+  /// Color blending
+  BlendMode blend_mode{ BlendMode::Opaque };
+
+  /// Whether fragments are tested against the depth buffer
+  bool depth_test{ false };
+
+  /// Whether passing fragments write the depth buffer
+  bool depth_write{ false };
+
+  /// Depth test comparison
+  CompareOp depth_compare{ CompareOp::LessOrEqual };
+
+  /// Format of the color target
+  TextureFormat color_format{ TextureFormat::BGRA8Srgb };
+
+  /// Format of the depth target (none if the pass has no depth buffer)
+  std::optional<TextureFormat> depth_format{};
+
+  /**
+   * @brief Check whether two descriptions produce the same pipeline.
+   *
+   * Vertex bindings and attributes past their counts are ignored.
+   */
+  constexpr bool operator==(const GraphicsPipelineDesc& other) const noexcept {
+    return vertex_shader == other.vertex_shader
+           && fragment_shader == other.fragment_shader
+           && vertex_binding_count == other.vertex_binding_count
+           && vertex_attribute_count == other.vertex_attribute_count
+           && std::equal(vertex_bindings.begin(),
+                         vertex_bindings.begin() + vertex_binding_count,
+                         other.vertex_bindings.begin())
+           && std::equal(vertex_attributes.begin(),
+                         vertex_attributes.begin() + vertex_attribute_count,
+                         other.vertex_attributes.begin())
+           && topology == other.topology && cull_mode == other.cull_mode
+           && blend_mode == other.blend_mode
+           && depth_test == other.depth_test
+           && depth_write == other.depth_write
+           && depth_compare == other.depth_compare
+           && color_format == other.color_format
+           && depth_format == other.depth_format;
+  }
+};
+
+/**
+ * @brief Hash a pipeline description consistently with its operator==.
+ *
+ * @param desc Description to hash (counts must not exceed the array sizes)
+ * @return Hash whose low bits are as well mixed as its high bits
+ */
+constexpr std::uint64_t HashPipelineDesc(
+  const GraphicsPipelineDesc& desc
+) noexcept {
+  // FNV-1a over whole fields, which are all small integers
+  std::uint64_t hash{ 14695981039346656037ULL };
+  const auto mix{ [&hash](std::uint64_t value) {
+    hash = (hash ^ value) * 1099511628211ULL;
+  } };
+
+  mix(desc.vertex_shader.index);
+  mix(desc.vertex_shader.generation);
+  mix(desc.fragment_shader.index);
+  mix(desc.fragment_shader.generation);
+  mix(desc.vertex_binding_count);
+  for (std::uint32_t i{ 0U }; i < desc.vertex_binding_count; ++i) {
+    mix(desc.vertex_bindings[i].stride);
+    mix(desc.vertex_bindings[i].per_instance);
+  }
+  mix(desc.vertex_attribute_count);
+  for (std::uint32_t i{ 0U }; i < desc.vertex_attribute_count; ++i) {
+    const VertexAttribute& attribute{ desc.vertex_attributes[i] };
+    mix(attribute.location);
+    mix(attribute.binding);
+    mix(static_cast<std::uint64_t>(attribute.format));
+    mix(attribute.offset);
+  }
+  mix(static_cast<std::uint64_t>(desc.topology));
+  mix(static_cast<std::uint64_t>(desc.cull_mode));
+  mix(static_cast<std::uint64_t>(desc.blend_mode));
+  mix(desc.depth_test);
+  mix(desc.depth_write);
+  mix(static_cast<std::uint64_t>(desc.depth_compare));
+  mix(static_cast<std::uint64_t>(desc.color_format));
+  mix(desc.depth_format ? static_cast<std::uint64_t>(*desc.depth_format) + 1U
+                        : 0U);
+
+  // Finalize (SplitMix64), since hash tables index by the low bits
+  hash = (hash ^ (hash >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+  hash = (hash ^ (hash >> 27U)) * 0x94D049BB133111EBULL;
+  return hash ^ (hash >> 31U);
+}
+
+/**
+ * @brief Check the backend-independent rules of a pipeline description.
+ *
+ * @param desc Description to check
+ * @return Why the description is invalid, or nullptr if it is valid
+ */
+constexpr const char* FindPipelineDescError(
+  const GraphicsPipelineDesc& desc
+) noexcept {
+  if (desc.vertex_binding_count > kMaxVertexBindings
+      || desc.vertex_attribute_count > kMaxVertexAttributes) {
+    return "too many vertex bindings or attributes";
+  }
+  for (std::uint32_t i{ 0U }; i < desc.vertex_attribute_count; ++i) {
+    if (desc.vertex_attributes[i].binding >= desc.vertex_binding_count) {
+      return "a vertex attribute reads an unused binding";
+    }
+  }
+  if (desc.color_format == TextureFormat::D32Float) {
+    return "the color format is a depth format";
+  }
+  if (desc.depth_format && *desc.depth_format != TextureFormat::D32Float) {
+    return "the depth format is a color format";
+  }
+  if ((desc.depth_test || desc.depth_write) && !desc.depth_format) {
+    return "depth testing requires a depth format";
+  }
+  return nullptr;
+}
+
+} // namespace maple::rhi
@@ -0,0 +1,373 @@
+#pragma once
+
+// STL
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace maple::rhi {
+
+/**
+ * @brief Generational handle to an RHI resource.
+ *
+ * Handles are plain values that stay valid to copy after the resource is
+ * destroyed; the generation lets backends detect use of a stale handle.
+ *
+ * @tparam Tag Resource type the handle refers to
+ */
+template <typename Tag>
+struct RHIHandle {
+  /// Index of the slot that holds the resource
+  std::uint32_t index{ std::numeric_limits<std::uint32_t>::max() };
+
+  /// Generation of the slot when the resource was created
+  std::uint32_t generation{ 0U };
+
+  /**
+   * @brief Check whether the handle was returned by a create call.
+   *
+   * @return true if the handle is not default-constructed
+   */
+  [[nodiscard]] constexpr bool IsValid() const noexcept {
+    return index != std::numeric_limits<std::uint32_t>::max();
+  }
+
+  bool operator==(const RHIHandle&) const = default;
+};
+
+/// Handle to a GPU buffer
+using BufferHandle = RHIHandle<struct BufferTag>;
+
+/// Handle to a GPU texture
+using TextureHandle = RHIHandle<struct TextureTag>;
+
+/// Handle to a block of GPU memory that textures are placed in
+using MemoryHeapHandle = RHIHandle<struct MemoryHeapTag>;
+
+/**
+ * @brief Ways a buffer may be used; combine with |.
+ */
+enum class BufferUsage : std::uint32_t {
+  None = 0U,
+  Vertex = 1U << 0U,
+  Index = 1U << 1U,
+  Uniform = 1U << 2U,
+  Storage = 1U << 3U,
+  Indirect = 1U << 4U,
+  TransferSrc = 1U << 5U,
+  TransferDst = 1U << 6U
+};
+
+/**
+ * @brief Ways a texture may be used; combine with |.
+ */
+enum class TextureUsage : std::uint32_t {
+  None = 0U,
+  Sampled = 1U << 0U,
+  Storage = 1U << 1U,
+  ColorAttachment = 1U << 2U,
+  DepthStencilAttachment = 1U << 3U,
+  TransferSrc = 1U << 4U,
+  TransferDst = 1U << 5U
+};
+
+/**
+ * @brief Combine usage flags.
+ */
+template <typename Usage>
+  requires std::is_same_v<Usage, BufferUsage>
+           || std::is_same_v<Usage, TextureUsage>
+constexpr Usage operator|(Usage lhs, Usage rhs) noexcept {
+  return static_cast<Usage>(static_cast<std::uint32_t>(lhs)
+                            | static_cast<std::uint32_t>(rhs));
+}
+
+/**
+ * @brief Check whether usage flags contain a flag.
+ *
+ * @param usage Usage flags
+ * @param flag Flag to look for
+ * @return true if every bit of flag is set in usage
+ */
+template <typename Usage>
+  requires std::is_same_v<Usage, BufferUsage>
+           || std::is_same_v<Usage, TextureUsage>
+constexpr bool HasUsage(Usage usage, Usage flag) noexcept {
+  return (static_cast<std::uint32_t>(usage) & static_cast<std::uint32_t>(flag))
+         == static_cast<std::uint32_t>(flag);
+}
+
+/**
+ * @brief Which processor accesses a resource's memory.
+ */
+enum class MemoryUsage {
+  /// Only the GPU reads and writes (fastest for the GPU)
+  GpuOnly,
+
+  /// The CPU writes and the GPU reads (persistently mapped)
+  CpuToGpu,
+
+  /// The GPU writes and the CPU reads back (persistently mapped)
+  GpuToCpu
+};
+
+/**
+ * @brief Pixel formats of textures.
+ */
+enum class TextureFormat {
+  RGBA8Unorm,
+  RGBA8Srgb,
+  BGRA8Unorm,
+  BGRA8Srgb,
+  RGBA16Float,
+  R32Float,
+  D32Float
+};
+
+/**
+ * @brief Get the size of one texel of a format.
+ *
+ * @param format Pixel format
+ * @return Texel size in bytes
+ */
+constexpr std::uint32_t GetTexelSize(TextureFormat format) noexcept {
+  switch (format) {
+    case TextureFormat::RGBA16Float: {
+      return 8U;
+    }
+
+    default: {
+      return 4U;
+    }
+  }
+}
+
+/**
+ * @brief Description of a buffer to create.
+ */
+struct BufferDesc {
+  /// Size in bytes
+  std::uint64_t size{ 0U };
+
+  /// Ways the buffer will be used
+  BufferUsage usage{ BufferUsage::None };
+
+  /// Which processor accesses the buffer's memory
+  MemoryUsage memory_usage{ MemoryUsage::GpuOnly };
+
+  /// Whether the buffer lives for a few frames at most (e.g., staging);
+  /// transient buffers are packed into linear blocks
+  bool transient{ false };
+};
+
+/**
+ * @brief Description of a 2D texture to create.
+ */
+struct TextureDesc {
+  /// Width in pixels
+  std::uint32_t width{ 1U };
+
+  /// Height in pixels
+  std::uint32_t height{ 1U };
+
+  /// Number of mip levels
+  std::uint32_t mip_levels{ 1U };
+
+  /// Pixel format
+  TextureFormat format{ TextureFormat::RGBA8Unorm };
+
+  /// Ways the texture will be used
+  TextureUsage usage{ TextureUsage::Sampled };
+
+  bool operator==(const TextureDesc&) const = default;
+};
+
+/**
+ * @brief Get the size of one mip level of a texture.
+ *
+ * @param desc Texture description
+ * @param mip_level Mip level (0 is the full-size image)
+ * @return Tightly packed size of the mip level in bytes
+ */
+constexpr std::uint64_t GetMipSize(const TextureDesc& desc,
+                                   std::uint32_t mip_level) noexcept {
+  const std::uint64_t width{ std::max(desc.width >> mip_level, 1U) };
+  const std::uint64_t height{ std::max(desc.height >> mip_level, 1U) };
+  return width * height * GetTexelSize(desc.format);
+}
+
+/**
+ * @brief Memory a resource needs when placed in a memory heap.
+ */
+struct MemoryRequirements {
+  /// Size in bytes
+  std::uint64_t size{ 0U };
+
+  /// Alignment of the resource's offset within the heap
+  std::uint64_t alignment{ 1U };
+
+  /// Backend-defined set of memory types the resource may live in;
+  /// resources whose sets intersect may share a heap
+  std::uint32_t memory_type_bits{ 0U };
+};
+
+/**
+ * @brief How the GPU accesses a resource between two barriers.
+ *
+ * Determines the layout of textures and what a barrier waits for and
+ * blocks. Write states also order accesses in the same state, so a barrier
+ * between two passes writing a resource is never redundant.
+ */
+enum class ResourceState {
+  /// Contents are discarded; only valid as the state before a barrier
+  Undefined,
+
+  /// Rendered to as a color attachment
+  ColorAttachment,
+
+  /// Rendered to as a depth attachment (depth tests read it too)
+  DepthStencilAttachment,
+
+  /// Read by shaders (sampled textures, uniform and storage buffers)
+  ShaderRead,
+
+  /// Read and written by shaders (storage textures and buffers)
+  ShaderWrite,
+
+  /// Source of a copy
+  TransferSrc,
+
+  /// Destination of a copy
+  TransferDst
+};
+
+/**
+ * @brief Check whether the GPU writes a resource in a state.
+ *
+ * @param state Resource state
+ * @return true if accesses in the state write the resource
+ */
+constexpr bool IsWriteState(ResourceState state) noexcept {
+  switch (state) {
+    case ResourceState::ColorAttachment:
+    case ResourceState::DepthStencilAttachment:
+    case ResourceState::ShaderWrite:
+    case ResourceState::TransferDst: {
+      return true;
+    }
+
+    default: {
+      return false;
+    }
+  }
+}
+
+/**
+ * @brief Check whether the compute queue can access a resource in a state.
+ *
+ * @param state Resource state
+ * @return true for states compute and copy commands access, and Undefined
+ */
+constexpr bool IsComputeState(ResourceState state) noexcept {
+  switch (state) {
+    case ResourceState::ColorAttachment:
+    case ResourceState::DepthStencilAttachment: {
+      return false;
+    }
+
+    default: {
+      return true;
+    }
+  }
+}
+
+/**
+ * @brief GPU queue a command list executes on.
+ */
+enum class QueueType {
+  /// Graphics queue; runs every kind of command and presents
+  Graphics,
+
+  /// Async compute queue; runs compute and copy commands alongside the
+  /// graphics queue (see RHI::HasAsyncCompute())
+  Compute
+};
+
+/**
+ * @brief Transition of a texture between two states.
+ *
+ * A transition whose queues differ also hands the texture to another queue
+ * (see RHICommandList::Barrier()).
+ */
+struct TextureBarrier {
+  /// Texture to transition (every mip level)
+  TextureHandle texture{};
+
+  /// State of the accesses to wait for
+  ResourceState before{ ResourceState::Undefined };
+
+  /// State of the accesses that follow
+  ResourceState after{ ResourceState::Undefined };
+
+  /// Queue of the accesses to wait for
+  QueueType src_queue{ QueueType::Graphics };
+
+  /// Queue of the accesses that follow
+  QueueType dst_queue{ QueueType::Graphics };
+};
+
+/**
+ * @brief Transition of a buffer between two states.
+ *
+ * A transition whose queues differ also hands the buffer to another queue
+ * (see RHICommandList::Barrier()).
+ */
+struct BufferBarrier {
+  /// Buffer to transition (the whole range)
+  BufferHandle buffer{};
+
+  /// State of the accesses to wait for
+  ResourceState before{ ResourceState::Undefined };
+
+  /// State of the accesses that follow
+  ResourceState after{ ResourceState::Undefined };
+
+  /// Queue of the accesses to wait for
+  QueueType src_queue{ QueueType::Graphics };
+
+  /// Queue of the accesses that follow
+  QueueType dst_queue{ QueueType::Graphics };
+};
+
+/**
+ * @brief Completion handle of an asynchronous upload.
+ *
+ * Tickets are ordered: once a ticket completes, every ticket returned before
+ * it has completed too.
+ */
+struct UploadTicket {
+  /// Position of the upload in the backend's upload sequence
+  std::uint64_t value{ 0U };
+};
+
+/**
+ * @brief Range of per-frame memory written by the CPU and read by the GPU.
+ *
+ * Valid until the end of the frame it was allocated in; the GPU reads it at
+ * buffer + offset (e.g., as a dynamic uniform buffer offset).
+ */
+struct TransientAllocation {
+  /// Persistently mapped memory to write
+  std::span<std::byte> data{};
+
+  /// Buffer containing the range
+  BufferHandle buffer{};
+
+  /// Offset of the range within the buffer
+  std::uint64_t offset{ 0U };
+};
+
+} // namespace maple::rhi
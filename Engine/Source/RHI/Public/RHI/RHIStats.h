@@ -0,0 +1,137 @@
+#pragma once
+
+// STL
+#include <cstdint>
+
+// RHI
+#include "RHI/RHIResources.h"
+
+namespace maple::rhi {
+
+/**
+ * @brief Per-call counters collected by an RHI backend.
+ *
+ * Counters accumulate from backend creation. Backends that do not collect
+ * statistics report zeroes.
+ */
+struct RHIStats {
+  /// Completed BeginFrame() calls
+  std::uint64_t begin_frame_calls{ 0U };
+
+  /// Completed Clear() calls, on the RHI and on command lists
+  std::uint64_t clear_calls{ 0U };
+
+  /// Command lists submitted by EndFrame()
+  std::uint64_t command_lists_submitted{ 0U };
+
+  /// Command lists submitted to the async compute queue (included in
+  /// command_lists_submitted)
+  std::uint64_t compute_command_lists_submitted{ 0U };
+
+  /// Submissions that waited for the other queue within a frame
+  std::uint64_t queue_waits{ 0U };
+
+  /// Completed EndFrame() calls
+  std::uint64_t end_frame_calls{ 0U };
+
+  /// Completed Present() calls
+  std::uint64_t present_calls{ 0U };
+
+  /// Bytes copied by uploads
+  std::uint64_t uploaded_bytes{ 0U };
+
+  /// Upload batches submitted to the transfer queue
+  std::uint64_t upload_batches_submitted{ 0U };
+
+  /// Uploads that waited for the GPU because the staging ring was full
+  std::uint64_t upload_stalls{ 0U };
+
+  /// Pipelines compiled, including warmup
+  std::uint64_t pipelines_compiled{ 0U };
+
+  /// Manifest entries WarmupPipelines() has made available, including ones
+  /// that were already cached
+  std::uint64_t pipelines_warmed_up{ 0U };
+
+  /// Time spent compiling pipelines across all threads, in microseconds
+  std::uint64_t pipeline_compile_microseconds{ 0U };
+
+  /// Distinct descriptions in the pipeline state cache
+  std::uint64_t cached_pipelines{ 0U };
+
+  /// GPU zones not timed because the frame's query pool was full (see
+  /// RHIConfig::max_gpu_zones)
+  std::uint64_t gpu_zones_dropped{ 0U };
+};
+
+/**
+ * @brief Time the GPU spent in a zone of a frame.
+ */
+struct GpuZone {
+  /// Zone name (string literal)
+  const char* name{ "" };
+
+  /// Queue the zone ran on
+  QueueType queue{ QueueType::Graphics };
+
+  /// Begin timestamp on the core::Profiler::Now() clock
+  std::int64_t start_ns{ 0 };
+
+  /// End timestamp on the core::Profiler::Now() clock
+  std::int64_t end_ns{ 0 };
+};
+
+/**
+ * @brief GPU memory usage of an RHI backend.
+ */
+struct RHIMemoryStats {
+  /// Live buffers
+  std::uint64_t buffer_count{ 0U };
+
+  /// Live textures
+  std::uint64_t texture_count{ 0U };
+
+  /// Memory blocks that resources are sub-allocated from
+  std::uint64_t block_count{ 0U };
+
+  /// Bytes reserved by memory blocks
+  std::uint64_t block_bytes{ 0U };
+
+  /// Bytes of blocks handed out to resources (including alignment)
+  std::uint64_t used_bytes{ 0U };
+
+  /// Resources with a dedicated device memory allocation
+  std::uint64_t dedicated_count{ 0U };
+
+  /// Bytes of dedicated allocations
+  std::uint64_t dedicated_bytes{ 0U };
+
+  /// Live device memory allocations (limited by maxMemoryAllocationCount)
+  std::uint64_t device_allocation_count{ 0U };
+
+  /// Memory the process may use in device-local heaps before the driver
+  /// starts paging (estimated if the driver cannot report it)
+  std::uint64_t budget_bytes{ 0U };
+
+  /// Memory the process currently uses in device-local heaps
+  std::uint64_t usage_bytes{ 0U };
+
+  /// Device memory allocations made over the budget of their heap since
+  /// creation
+  std::uint64_t over_budget_allocations{ 0U };
+
+  /// Device memory allocations placed in another heap since creation,
+  /// because the preferred heap was over budget
+  std::uint64_t budget_fallback_allocations{ 0U };
+
+  /// Bytes relocated by defragmentation since creation
+  std::uint64_t defragmented_bytes{ 0U };
+
+  /// Bindless texture slots in use, sampled and storage combined
+  std::uint64_t bindless_texture_slots{ 0U };
+
+  /// Bindless storage buffer slots in use
+  std::uint64_t bindless_buffer_slots{ 0U };
+};
+
+} // namespace maple::rhi
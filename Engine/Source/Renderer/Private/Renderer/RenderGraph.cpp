@@ -0,0 +1,853 @@
+#include "Renderer/RenderGraph.h"
+
+// STL
+#include <algorithm>
+#include <array>
+#include <format>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// RHI
+#include "RHI/RHI.h"
+
+// Renderer
+#include "Renderer/RendererLog.h"
+
+namespace maple::renderer {
+
+namespace {
+
+/**
+ * @brief Round a size up to a multiple of a power-of-two alignment.
+ */
+constexpr std::uint64_t AlignUp(std::uint64_t size,
+                                std::uint64_t alignment) noexcept {
+  return (size + alignment - 1U) & ~(alignment - 1U);
+}
+
+/// Number of rhi::QueueType values
+constexpr std::size_t kQueueCount{ 2U };
+
+/// Slot of a level's first pass; the slots before it hold the level's
+/// hand-overs and then its barriers, one per queue
+constexpr std::uint64_t kFirstPassSlot{ 2U * kQueueCount };
+
+/**
+ * @brief Get the sort key of a command list recorded by the graph.
+ *
+ * @param level Dependency level
+ * @param slot Queue index for the level's hand-overs, kQueueCount + queue
+ *             index for its barriers, kFirstPassSlot + index for its passes
+ */
+constexpr std::uint64_t GetSortKey(std::uint32_t level,
+                                   std::uint64_t slot) noexcept {
+  return (std::uint64_t{ level } << 32U) | slot;
+}
+
+} // namespace
+
+RenderGraphPassBuilder::RenderGraphPassBuilder(RenderGraph& graph,
+                                               std::uint32_t pass) noexcept
+  : graph_{ &graph }
+  , pass_{ pass } {}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::Read(
+  RenderGraphTexture texture,
+  rhi::ResourceState state
+) {
+  graph_->AddAccess(pass_, texture.index, state, false);
+  return *this;
+}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::Write(
+  RenderGraphTexture texture,
+  rhi::ResourceState state
+) {
+  graph_->AddAccess(pass_, texture.index, state, true);
+  return *this;
+}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::Read(RenderGraphBuffer buffer,
+                                                     rhi::ResourceState state) {
+  graph_->AddAccess(pass_, buffer.index, state, false);
+  return *this;
+}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::Write(
+  RenderGraphBuffer buffer,
+  rhi::ResourceState state
+) {
+  graph_->AddAccess(pass_, buffer.index, state, true);
+  return *this;
+}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::SideEffect() {
+  graph_->passes_[pass_].side_effect = true;
+  return *this;
+}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::AsyncCompute() {
+  graph_->passes_[pass_].async_compute = true;
+  return *this;
+}
+
+RenderGraph::RenderGraph(rhi::RHI* rhi)
+  : rhi_{ rhi } {}
+
+RenderGraph::~RenderGraph() {
+  // Placed textures must go before the heaps they are placed in
+  for (const PlacedTexture& placed : placed_textures_) {
+    rhi_->DestroyTexture(placed.texture);
+  }
+  for (const Heap& heap : heaps_) {
+    rhi_->DestroyMemoryHeap(heap.handle);
+  }
+}
+
+void RenderGraph::Reset() {
+  passes_.clear();
+  resources_.clear();
+  edges_.clear();
+  execution_order_.clear();
+  level_count_ = 0U;
+}
+
+RenderGraphTexture RenderGraph::CreateTexture(const rhi::TextureDesc& desc) {
+  resources_.emplace_back(Resource{ .is_texture = true, .desc = desc });
+  return RenderGraphTexture{
+    .index = static_cast<std::uint32_t>(resources_.size() - 1U)
+  };
+}
+
+RenderGraphTexture RenderGraph::ImportTexture(rhi::TextureHandle texture,
+                                              rhi::ResourceState initial_state,
+                                              rhi::ResourceState final_state) {
+  resources_.emplace_back(Resource{
+    .is_texture = true,
+    .imported = true,
+    .texture = texture,
+    .initial_state = initial_state,
+    .final_state = final_state
+  });
+  return RenderGraphTexture{
+    .index = static_cast<std::uint32_t>(resources_.size() - 1U)
+  };
+}
+
+RenderGraphBuffer RenderGraph::ImportBuffer(rhi::BufferHandle buffer,
+                                            rhi::ResourceState initial_state,
+                                            rhi::ResourceState final_state) {
+  resources_.emplace_back(Resource{
+    .is_texture = false,
+    .imported = true,
+    .buffer = buffer,
+    .initial_state = initial_state,
+    .final_state = final_state
+  });
+  return RenderGraphBuffer{
+    .index = static_cast<std::uint32_t>(resources_.size() - 1U)
+  };
+}
+
+RenderGraphPassBuilder RenderGraph::AddPass(const char* name,
+                                            ExecuteFunction execute) {
+  passes_.emplace_back(Pass{
+    .name = name,
+    .execute = std::move(execute)
+  });
+  return RenderGraphPassBuilder{
+    *this, static_cast<std::uint32_t>(passes_.size() - 1U)
+  };
+}
+
+void RenderGraph::Execute() {
+  MAPLE_PROFILE_FUNCTION(LogRenderer);
+
+  ++frame_index_;
+  const RenderGraphStats previous_stats{ stats_ };
+  stats_ = RenderGraphStats{
+    .pass_count = static_cast<std::uint32_t>(passes_.size())
+  };
+
+  AssignQueues();
+  BuildEdges();
+  CullAndSchedule();
+  AllocateTransients();
+  Record();
+
+  // Report changes of the graph's shape rather than every frame
+  if (stats_ != previous_stats) {
+    MAPLE_LOG_DEBUG(LogRenderer,
+                    "Render graph: {} pass(es) ({} culled) in {} level(s); "
+                    "{} barrier(s) in {} batch(es) ({} merged, {} batch(es) "
+                    "unbatched); {} transient texture(s) in {} KiB ({} KiB "
+                    "unaliased); {} async compute pass(es), {} queue "
+                    "transfer(s), {} queue wait(s), {} overlapped level(s)",
+                    stats_.pass_count, stats_.culled_pass_count,
+                    stats_.level_count, stats_.barrier_count,
+                    stats_.barrier_batch_count, stats_.merged_barrier_count,
+                    stats_.unbatched_barrier_batch_count,
+                    stats_.transient_texture_count,
+                    stats_.transient_bytes / 1024U,
+                    stats_.unaliased_transient_bytes / 1024U,
+                    stats_.async_compute_pass_count,
+                    stats_.queue_transfer_count, stats_.queue_wait_count,
+                    stats_.overlapped_level_count);
+  }
+}
+
+void RenderGraph::SetAsyncComputeEnabled(bool enabled) noexcept {
+  async_compute_enabled_ = enabled;
+}
+
+rhi::TextureHandle RenderGraph::GetTexture(
+  RenderGraphTexture texture
+) const noexcept {
+  return texture.index < resources_.size()
+           ? resources_[texture.index].texture
+           : rhi::TextureHandle{};
+}
+
+rhi::BufferHandle RenderGraph::GetBuffer(
+  RenderGraphBuffer buffer
+) const noexcept {
+  return buffer.index < resources_.size() ? resources_[buffer.index].buffer
+                                          : rhi::BufferHandle{};
+}
+
+const RenderGraphStats& RenderGraph::GetStats() const noexcept {
+  return stats_;
+}
+
+void RenderGraph::AddAccess(std::uint32_t pass, std::uint32_t resource,
+                            rhi::ResourceState state, bool write) {
+  Pass& graph_pass{ passes_[pass] };
+  const char* error{ nullptr };
+  if (resource >= resources_.size()) {
+    error = "uses a resource that was not declared this frame";
+  } else if (state == rhi::ResourceState::Undefined) {
+    error = "accesses a resource in the Undefined state";
+  }
+
+  const auto existing{ std::ranges::find(graph_pass.accesses, resource,
+                                         &Access::resource) };
+  if (!error && existing != graph_pass.accesses.end()) {
+    if (existing->state != state) {
+      error = "accesses a resource in two states";
+    } else {
+      existing->read = existing->read || !write;
+      existing->write = existing->write || write;
+      return;
+    }
+  }
+  if (error) {
+    const std::string msg{ std::format("Render graph pass '{}' {}",
+                                       graph_pass.name, error) };
+    MAPLE_LOG_CRITICAL(LogRenderer, msg);
+    throw std::runtime_error{ msg };
+  }
+
+  graph_pass.accesses.emplace_back(Access{
+    .resource = resource,
+    .state = state,
+    .read = !write,
+    .write = write
+  });
+}
+
+void RenderGraph::AssignQueues() {
+  const bool async_compute{ async_compute_enabled_ && rhi_->HasAsyncCompute() };
+  for (Pass& pass : passes_) {
+    if (pass.async_compute
+        && !std::ranges::all_of(pass.accesses, [](const Access& access) {
+             return rhi::IsComputeState(access.state);
+           })) {
+      const std::string msg{ std::format(
+        "Render graph pass '{}' runs on the compute queue but accesses a "
+        "resource in a graphics state", pass.name
+      ) };
+      MAPLE_LOG_CRITICAL(LogRenderer, msg);
+      throw std::runtime_error{ msg };
+    }
+    pass.queue = pass.async_compute && async_compute
+                   ? rhi::QueueType::Compute
+                   : rhi::QueueType::Graphics;
+  }
+}
+
+void RenderGraph::BuildEdges() {
+  /**
+   * @brief Pass reading the current contents of a resource.
+   */
+  struct Reader {
+    /// Reading pass
+    std::uint32_t pass{ 0U };
+
+    /// State it reads in
+    rhi::ResourceState state{ rhi::ResourceState::Undefined };
+  };
+
+  /**
+   * @brief Accesses to a resource by the passes visited so far.
+   */
+  struct Tracking {
+    /// Pass that wrote the current contents
+    std::uint32_t last_writer{ kNoPass };
+
+    /// Passes that read the current contents
+    std::vector<Reader> readers{};
+  };
+  std::vector<Tracking> tracking(resources_.size());
+
+  for (std::uint32_t pass{ 0U }; pass < passes_.size(); ++pass) {
+    for (const Access& access : passes_[pass].accesses) {
+      const Tracking& resource{ tracking[access.resource] };
+      if (access.read) {
+        // Read after write: the only kind of edge that carries data
+        if (resource.last_writer != kNoPass) {
+          edges_.emplace_back(Edge{
+            .from = resource.last_writer, .to = pass, .data = true
+          });
+        } else if (!resources_[access.resource].imported) {
+          const std::string msg{ std::format(
+            "Render graph pass '{}' reads a transient resource no earlier "
+            "pass writes", passes_[pass].name
+          ) };
+          MAPLE_LOG_CRITICAL(LogRenderer, msg);
+          throw std::runtime_error{ msg };
+        }
+      } else if (access.write && resource.last_writer != kNoPass) {
+        // Write after write
+        edges_.emplace_back(Edge{ .from = resource.last_writer, .to = pass });
+      }
+
+      // A write or a change of state must wait for the earlier reads, and
+      // so must a read on the other queue, since one queue owns the
+      // resource at a time
+      for (const Reader& reader : resource.readers) {
+        if (access.write || reader.state != access.state
+            || passes_[reader.pass].queue != passes_[pass].queue) {
+          edges_.emplace_back(Edge{ .from = reader.pass, .to = pass });
+        }
+      }
+    }
+
+    // Update after every access, so a pass never depends on itself
+    for (const Access& access : passes_[pass].accesses) {
+      Tracking& resource{ tracking[access.resource] };
+      if (access.write) {
+        resource.last_writer = pass;
+        resource.readers.clear();
+      } else {
+        resource.readers.emplace_back(Reader{
+          .pass = pass, .state = access.state
+        });
+      }
+    }
+  }
+}
+
+void RenderGraph::CullAndSchedule() {
+  // Roots: passes with side effects or results that outlive the frame
+  for (Pass& pass : passes_) {
+    pass.live = pass.side_effect
+                || std::ranges::any_of(pass.accesses, [&](const Access& access) {
+                     return access.write
+                            && resources_[access.resource].imported;
+                   });
+  }
+
+  // Edges are grouped by later pass in ascending order, so walking them
+  // backwards settles a pass's liveness before its producers are visited
+  for (auto edge{ edges_.rbegin() }; edge != edges_.rend(); ++edge) {
+    if (edge->data && passes_[edge->to].live) {
+      passes_[edge->from].live = true;
+    }
+  }
+
+  // Walking forwards settles a pass's level before its dependents read it
+  for (Pass& pass : passes_) {
+    pass.level = 0U;
+  }
+  for (const Edge& edge : edges_) {
+    if (passes_[edge.from].live && passes_[edge.to].live) {
+      passes_[edge.to].level = std::max(passes_[edge.to].level,
+                                        passes_[edge.from].level + 1U);
+    }
+  }
+
+  for (std::uint32_t pass{ 0U }; pass < passes_.size(); ++pass) {
+    if (!passes_[pass].live) {
+      ++stats_.culled_pass_count;
+      continue;
+    }
+    execution_order_.emplace_back(pass);
+    level_count_ = std::max(level_count_, passes_[pass].level + 1U);
+    for (const Access& access : passes_[pass].accesses) {
+      Resource& resource{ resources_[access.resource] };
+      resource.first_level = std::min(resource.first_level,
+                                       passes_[pass].level);
+      resource.last_level = std::max(resource.last_level,
+                                     passes_[pass].level);
+    }
+  }
+  std::ranges::stable_sort(execution_order_, {}, [&](std::uint32_t pass) {
+    return passes_[pass].level;
+  });
+  stats_.level_count = level_count_;
+
+  // Levels do not order the compute queue's accesses against the graphics
+  // queue's, so the transient textures it touches get the whole frame
+  // rather than sharing memory
+  for (const std::uint32_t pass : execution_order_) {
+    if (passes_[pass].queue != rhi::QueueType::Compute) {
+      continue;
+    }
+    ++stats_.async_compute_pass_count;
+    for (const Access& access : passes_[pass].accesses) {
+      Resource& resource{ resources_[access.resource] };
+      if (!resource.imported) {
+        resource.first_level = 0U;
+        resource.last_level = level_count_ - 1U;
+      }
+    }
+  }
+}
+
+void RenderGraph::AllocateTransients() {
+  /**
+   * @brief Range of a heap a transient texture occupies.
+   */
+  struct Placement {
+    /// Index of the resource
+    std::uint32_t resource{ 0U };
+
+    /// Memory requirements of the texture
+    rhi::MemoryRequirements requirements{};
+
+    /// Offset within the heap
+    std::uint64_t offset{ 0U };
+  };
+  std::vector<Placement> placements{};
+  for (std::uint32_t i{ 0U }; i < resources_.size(); ++i) {
+    const Resource& resource{ resources_[i] };
+    if (resource.is_texture && !resource.imported
+        && resource.first_level != kNoPass) {
+      placements.emplace_back(Placement{
+        .resource = i,
+        .requirements = GetRequirements(resource.desc)
+      });
+    }
+  }
+
+  // Place the largest textures first, each at the lowest offset that no
+  // texture alive at the same time occupies
+  std::ranges::stable_sort(placements, std::ranges::greater{},
+                           [](const Placement& placement) {
+                             return placement.requirements.size;
+                           });
+  std::vector<const Placement*> neighbors{};
+  for (auto placement{ placements.begin() }; placement != placements.end();
+       ++placement) {
+    const Resource& resource{ resources_[placement->resource] };
+    neighbors.clear();
+    for (auto other{ placements.begin() }; other != placement; ++other) {
+      const Resource& other_resource{ resources_[other->resource] };
+      if (other->requirements.memory_type_bits
+            == placement->requirements.memory_type_bits
+          && other_resource.first_level <= resource.last_level
+          && resource.first_level <= other_resource.last_level) {
+        neighbors.emplace_back(&*other);
+      }
+    }
+    std::ranges::sort(neighbors, {}, &Placement::offset);
+
+    const rhi::MemoryRequirements& requirements{ placement->requirements };
+    std::uint64_t offset{ 0U };
+    for (const Placement* neighbor : neighbors) {
+      if (AlignUp(offset, requirements.alignment) + requirements.size
+          <= neighbor->offset) {
+        break;
+      }
+      offset = std::max(offset,
+                        neighbor->offset + neighbor->requirements.size);
+    }
+    placement->offset = AlignUp(offset, requirements.alignment);
+
+    stats_.unaliased_transient_bytes += AlignUp(requirements.size,
+                                                requirements.alignment);
+  }
+  stats_.transient_texture_count =
+    static_cast<std::uint32_t>(placements.size());
+
+  // One heap per memory type set, sized to the extent of its textures
+  std::ranges::stable_sort(placements, {}, [](const Placement& placement) {
+    return placement.requirements.memory_type_bits;
+  });
+  for (auto group{ placements.begin() }; group != placements.end();) {
+    const std::uint32_t memory_type_bits{
+      group->requirements.memory_type_bits
+    };
+    const auto group_end{ std::ranges::find_if(
+      group, placements.end(), [&](const Placement& placement) {
+        return placement.requirements.memory_type_bits != memory_type_bits;
+      }
+    ) };
+    rhi::MemoryRequirements heap_requirements{
+      .memory_type_bits = memory_type_bits
+    };
+    for (auto placement{ group }; placement != group_end; ++placement) {
+      heap_requirements.size = std::max(
+        heap_requirements.size,
+        placement->offset + placement->requirements.size
+      );
+      heap_requirements.alignment = std::max(
+        heap_requirements.alignment, placement->requirements.alignment
+      );
+    }
+    stats_.transient_bytes += heap_requirements.size;
+
+    const rhi::MemoryHeapHandle heap{ AcquireHeap(heap_requirements) };
+    for (auto placement{ group }; placement != group_end; ++placement) {
+      Resource& resource{ resources_[placement->resource] };
+      resource.texture = AcquirePlacedTexture(resource.desc, heap,
+                                              placement->offset);
+    }
+    group = group_end;
+  }
+
+  ReleaseUnusedHeaps();
+  ReleasePlacedTextures(rhi::MemoryHeapHandle{});
+}
+
+void RenderGraph::Record() {
+  /**
+   * @brief Transitions recorded as one pipeline barrier.
+   */
+  struct BarrierList {
+    /// Texture transitions
+    std::vector<rhi::TextureBarrier> textures{};
+
+    /// Buffer transitions
+    std::vector<rhi::BufferBarrier> buffers{};
+  };
+
+  // Every resource starts out owned by the graphics queue
+  std::vector<rhi::ResourceState> states(resources_.size());
+  std::vector<rhi::QueueType> owners(resources_.size(),
+                                     rhi::QueueType::Graphics);
+  std::vector<std::uint32_t> transition_levels(resources_.size(), kNoPass);
+  std::vector<std::uint64_t> pass_keys(passes_.size(), 0U);
+  for (std::size_t i{ 0U }; i < resources_.size(); ++i) {
+    states[i] = resources_[i].initial_state;
+  }
+
+  // Per queue: the level's releases of resources to the other queue, and
+  // the transitions ahead of the level's passes
+  std::array<BarrierList, kQueueCount> releases{};
+  std::array<BarrierList, kQueueCount> batches{};
+  const auto add_barrier{ [&](BarrierList& list, std::uint32_t index,
+                              rhi::ResourceState state,
+                              rhi::QueueType src_queue,
+                              rhi::QueueType dst_queue) {
+    const Resource& resource{ resources_[index] };
+    if (resource.is_texture) {
+      list.textures.emplace_back(rhi::TextureBarrier{
+        .texture = resource.texture,
+        .before = states[index],
+        .after = state,
+        .src_queue = src_queue,
+        .dst_queue = dst_queue
+      });
+    } else {
+      list.buffers.emplace_back(rhi::BufferBarrier{
+        .buffer = resource.buffer,
+        .before = states[index],
+        .after = state,
+        .src_queue = src_queue,
+        .dst_queue = dst_queue
+      });
+    }
+  } };
+
+  // Transition a resource for a queue; a hand-over of defined contents is
+  // recorded on the owning queue as well. Returns whether it was
+  const auto transition{ [&](std::uint32_t index, rhi::ResourceState state,
+                             rhi::QueueType queue) {
+    const rhi::QueueType owner{ owners[index] };
+    const bool release{ owner != queue
+                        && states[index] != rhi::ResourceState::Undefined };
+    if (release) {
+      add_barrier(releases[static_cast<std::size_t>(owner)], index, state,
+                  owner, queue);
+      ++stats_.queue_transfer_count;
+    }
+    add_barrier(batches[static_cast<std::size_t>(queue)], index, state, owner,
+                queue);
+    states[index] = state;
+    owners[index] = queue;
+    return release;
+  } };
+
+  const auto flush_barriers{ [&](BarrierList& list, std::uint64_t sort_key,
+                                 rhi::QueueType queue,
+                                 std::span<const std::uint64_t> waits) {
+    const bool empty{ list.textures.empty() && list.buffers.empty() };
+    if (empty && waits.empty()) {
+      return false;
+    }
+    rhi::RHICommandList* command_list{
+      rhi_->BeginCommandList(sort_key, queue, waits)
+    };
+    if (!empty) {
+      command_list->Barrier(list.textures, list.buffers);
+      stats_.barrier_count += static_cast<std::uint32_t>(
+        list.textures.size() + list.buffers.size()
+      );
+      ++stats_.barrier_batch_count;
+    }
+    rhi_->EndCommandList(command_list);
+    if (!waits.empty()) {
+      ++stats_.queue_wait_count;
+    }
+    list.textures.clear();
+    list.buffers.clear();
+    return true;
+  } };
+
+  // Record a level's releases, then its barriers. A queue's barriers wait
+  // for the other queue's releases, or else for the latest pass of the
+  // other queue that its passes depend on; either precedes every other
+  // dependency on that queue
+  const auto record_barriers{ [&](std::uint32_t level, std::size_t begin,
+                                  std::size_t end) {
+    std::array<bool, kQueueCount> released{};
+    for (std::size_t q{ 0U }; q < kQueueCount; ++q) {
+      released[q] = flush_barriers(releases[q], GetSortKey(level, q),
+                                   static_cast<rhi::QueueType>(q), {});
+    }
+    for (std::size_t q{ 0U }; q < kQueueCount; ++q) {
+      const auto queue{ static_cast<rhi::QueueType>(q) };
+      const std::size_t other{ kQueueCount - 1U - q };
+      std::uint64_t wait_key{ 0U };
+      bool wait{ released[other] };
+      if (wait) {
+        wait_key = GetSortKey(level, other);
+      } else {
+        for (std::size_t i{ begin }; i < end; ++i) {
+          const std::uint32_t pass{ execution_order_[i] };
+          if (passes_[pass].queue != queue) {
+            continue;
+          }
+          const auto producers{ std::ranges::equal_range(edges_, pass, {},
+                                                         &Edge::to) };
+          for (const Edge& edge : producers) {
+            const Pass& producer{ passes_[edge.from] };
+            if (producer.live && producer.queue != queue) {
+              wait_key = std::max(wait_key, pass_keys[edge.from]);
+              wait = true;
+            }
+          }
+        }
+      }
+      flush_barriers(batches[q], GetSortKey(level, kQueueCount + q), queue,
+                     std::span<const std::uint64_t>{ &wait_key,
+                                                     wait ? 1U : 0U });
+    }
+  } };
+
+  std::size_t level_begin{ 0U };
+  for (std::uint32_t level{ 0U }; level < level_count_; ++level) {
+    std::size_t level_end{ level_begin };
+    while (level_end < execution_order_.size()
+           && passes_[execution_order_[level_end]].level == level) {
+      ++level_end;
+    }
+
+    // Gather the transitions of every pass of the level; passes reading a
+    // resource in the same state share one
+    std::array<bool, kQueueCount> queues_used{};
+    for (std::size_t i{ level_begin }; i < level_end; ++i) {
+      const Pass& pass{ passes_[execution_order_[i]] };
+      queues_used[static_cast<std::size_t>(pass.queue)] = true;
+      bool pass_transitions{ false };
+      bool pass_releases{ false };
+      for (const Access& access : pass.accesses) {
+        const rhi::ResourceState state{ states[access.resource] };
+        if (owners[access.resource] != pass.queue || state != access.state
+            || rhi::IsWriteState(state)) {
+          pass_releases = transition(access.resource, access.state,
+                                     pass.queue)
+                          || pass_releases;
+          transition_levels[access.resource] = level;
+          pass_transitions = true;
+        } else if (transition_levels[access.resource] == level) {
+          ++stats_.merged_barrier_count;
+          pass_transitions = true;
+        }
+      }
+      if (pass_transitions) {
+        ++stats_.unbatched_barrier_batch_count;
+      }
+      if (pass_releases) {
+        ++stats_.unbatched_barrier_batch_count;
+      }
+    }
+    if (std::ranges::all_of(queues_used, std::identity{})) {
+      ++stats_.overlapped_level_count;
+    }
+    record_barriers(level, level_begin, level_end);
+
+    for (std::size_t i{ level_begin }; i < level_end; ++i) {
+      const std::uint32_t pass_index{ execution_order_[i] };
+      Pass& pass{ passes_[pass_index] };
+      MAPLE_PROFILE_SCOPE(LogRenderer, pass.name);
+      pass_keys[pass_index] = GetSortKey(level,
+                                         kFirstPassSlot + (i - level_begin));
+      rhi::RHICommandList* command_list{
+        rhi_->BeginCommandList(pass_keys[pass_index], pass.queue)
+      };
+      command_list->BeginGpuZone(pass.name);
+      if (pass.execute) {
+        pass.execute(*command_list, *this);
+      }
+      command_list->EndGpuZone();
+      rhi_->EndCommandList(command_list);
+    }
+    level_begin = level_end;
+  }
+
+  // Hand imported resources back to the graphics queue, in the states they
+  // were promised in
+  for (std::uint32_t i{ 0U }; i < resources_.size(); ++i) {
+    const Resource& resource{ resources_[i] };
+    if (!resource.imported) {
+      continue;
+    }
+    const rhi::ResourceState final_state{
+      resource.final_state != rhi::ResourceState::Undefined
+        ? resource.final_state
+        : states[i]
+    };
+    if (owners[i] != rhi::QueueType::Graphics || states[i] != final_state) {
+      transition(i, final_state, rhi::QueueType::Graphics);
+    }
+  }
+  for (const BarrierList& list : releases) {
+    if (!list.textures.empty() || !list.buffers.empty()) {
+      ++stats_.unbatched_barrier_batch_count;
+    }
+  }
+  for (const BarrierList& list : batches) {
+    if (!list.textures.empty() || !list.buffers.empty()) {
+      ++stats_.unbatched_barrier_batch_count;
+    }
+  }
+  record_barriers(level_count_, execution_order_.size(),
+                  execution_order_.size());
+}
+
+rhi::MemoryRequirements RenderGraph::GetRequirements(
+  const rhi::TextureDesc& desc
+) {
+  const auto cached{ std::ranges::find(requirements_cache_, desc,
+                                       &CachedRequirements::desc) };
+  if (cached != requirements_cache_.end()) {
+    return cached->requirements;
+  }
+  const rhi::MemoryRequirements requirements{
+    rhi_->GetTextureMemoryRequirements(desc)
+  };
+  requirements_cache_.emplace_back(CachedRequirements{
+    .desc = desc, .requirements = requirements
+  });
+  return requirements;
+}
+
+rhi::MemoryHeapHandle RenderGraph::AcquireHeap(
+  const rhi::MemoryRequirements& requirements
+) {
+  auto heap{ std::ranges::find_if(heaps_, [&](const Heap& candidate) {
+    return candidate.requirements.memory_type_bits
+           == requirements.memory_type_bits;
+  }) };
+  if (heap != heaps_.end()
+      && (heap->requirements.size < requirements.size
+          || heap->requirements.alignment < requirements.alignment)) {
+    // Too small; the textures placed in it go with it
+    ReleasePlacedTextures(heap->handle);
+    rhi_->DestroyMemoryHeap(heap->handle);
+    heaps_.erase(heap);
+    heap = heaps_.end();
+  }
+  if (heap == heaps_.end()) {
+    rhi::MemoryRequirements heap_requirements{ requirements };
+    heap_requirements.size = AlignUp(requirements.size, kHeapGranularity);
+    heaps_.emplace_back(Heap{
+      .requirements = heap_requirements,
+      .handle = rhi_->CreateMemoryHeap(heap_requirements)
+    });
+    heap = std::prev(heaps_.end());
+    MAPLE_LOG_DEBUG(LogRenderer, "Render graph memory heap created ({} KiB)",
+                    heap_requirements.size / 1024U);
+  }
+
+  heap->last_used_frame = frame_index_;
+  return heap->handle;
+}
+
+rhi::TextureHandle RenderGraph::AcquirePlacedTexture(
+  const rhi::TextureDesc& desc,
+  rhi::MemoryHeapHandle heap,
+  std::uint64_t offset
+) {
+  const auto placed{ std::ranges::find_if(
+    placed_textures_, [&](const PlacedTexture& candidate) {
+      return candidate.heap == heap && candidate.offset == offset
+             && candidate.desc == desc;
+    }
+  ) };
+  if (placed != placed_textures_.end()) {
+    placed->last_used_frame = frame_index_;
+    return placed->texture;
+  }
+
+  const rhi::TextureHandle texture{
+    rhi_->CreatePlacedTexture(desc, heap, offset)
+  };
+  placed_textures_.emplace_back(PlacedTexture{
+    .desc = desc,
+    .heap = heap,
+    .offset = offset,
+    .texture = texture,
+    .last_used_frame = frame_index_
+  });
+  return texture;
+}
+
+void RenderGraph::ReleaseUnusedHeaps() {
+  std::erase_if(heaps_, [&](const Heap& heap) {
+    if (frame_index_ - heap.last_used_frame <= kUnusedLifetime) {
+      return false;
+    }
+    ReleasePlacedTextures(heap.handle);
+    rhi_->DestroyMemoryHeap(heap.handle);
+    return true;
+  });
+}
+
+void RenderGraph::ReleasePlacedTextures(rhi::MemoryHeapHandle heap) {
+  std::erase_if(placed_textures_, [&](const PlacedTexture& placed) {
+    if (placed.heap != heap
+        && frame_index_ - placed.last_used_frame <= kUnusedLifetime) {
+      return false;
+    }
+    rhi_->DestroyTexture(placed.texture);
+    return true;
+  });
+}
+
+} // namespace maple::renderer
@@ -1,8 +1,18 @@
 #include "Renderer/Renderer.h"
 
 // STL
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Core
+#include "Core/Profiler.h"
 
 // Platform
 #include "Platform/Window.h"
@@ -15,7 +25,91 @@
 
 namespace maple::renderer {
 
-Renderer::Renderer(platform::Window* window) {
+namespace {
+
+/// Zone the RHI backend times each frame with
+constexpr std::string_view kFrameZoneName{ "Frame" };
+
+/// Begin and end of a span of GPU time
+using Interval = std::pair<std::int64_t, std::int64_t>;
+
+/**
+ * @brief Merge intervals into disjoint ones.
+ *
+ * @param intervals Intervals to merge, sorted and merged in place
+ * @return Total length of the merged intervals
+ */
+std::int64_t MergeIntervals(std::vector<Interval>& intervals) {
+  std::ranges::sort(intervals);
+  std::size_t merged{ 0U };
+  for (const Interval& interval : intervals) {
+    if (merged > 0U && interval.first <= intervals[merged - 1U].second) {
+      intervals[merged - 1U].second = std::max(intervals[merged - 1U].second,
+                                               interval.second);
+    } else {
+      intervals[merged++] = interval;
+    }
+  }
+  intervals.resize(merged);
+
+  std::int64_t length{ 0 };
+  for (const auto& [begin, end] : intervals) {
+    length += end - begin;
+  }
+  return length;
+}
+
+/**
+ * @brief Get the profiler tracks GPU zones are recorded on, indexed by
+ *        rhi::QueueType.
+ *
+ * Zones of the two queues overlap, so they cannot share a track; the tracks
+ * are created once and shared by every renderer.
+ */
+const std::array<std::uint32_t, 2U>& GetGpuTracks() {
+  static const std::array<std::uint32_t, 2U> tracks{
+    core::Profiler::CreateTrack("GPU Graphics"),
+    core::Profiler::CreateTrack("GPU Compute")
+  };
+  return tracks;
+}
+
+} // namespace
+
+GpuQueueTimes MeasureGpuQueueTimes(std::span<const rhi::GpuZone> zones) {
+  std::vector<Interval> graphics{};
+  std::vector<Interval> compute{};
+  for (const rhi::GpuZone& zone : zones) {
+    if (zone.name == kFrameZoneName) {
+      continue;
+    }
+    auto& intervals{ zone.queue == rhi::QueueType::Compute ? compute
+                                                           : graphics };
+    intervals.emplace_back(zone.start_ns, zone.end_ns);
+  }
+
+  GpuQueueTimes times{
+    .graphics_ns = MergeIntervals(graphics),
+    .compute_ns = MergeIntervals(compute)
+  };
+
+  // Both lists are disjoint and sorted, so one sweep finds every overlap
+  auto g{ graphics.begin() };
+  auto c{ compute.begin() };
+  while (g != graphics.end() && c != compute.end()) {
+    times.overlapped_ns += std::max<std::int64_t>(
+      0, std::min(g->second, c->second) - std::max(g->first, c->first)
+    );
+    if (g->second < c->second) {
+      ++g;
+    } else {
+      ++c;
+    }
+  }
+  return times;
+}
+
+Renderer::Renderer(platform::Window* window, const rhi::RHIConfig& config) {
   // Validate window pointer
   if (!window) {
     const std::string msg{ "Window pointer is null" };
@@ -25,16 +119,22 @@ Renderer::Renderer(platform::Window* window) {
 
   // Create the RHI backend
   MAPLE_LOG_INFO(LogRenderer, "Creating RHI...");
-  rhi_ = rhi::RHI::Create(window);
+  rhi_ = rhi::RHI::Create(window, config);
   if (!rhi_) {
     const std::string msg{ "Failed to create RHI" };
     MAPLE_LOG_CRITICAL(LogRenderer, msg);
     throw std::runtime_error{ msg };
   }
   MAPLE_LOG_INFO(LogRenderer, "RHI created");
+
+  render_graph_ = std::make_unique<RenderGraph>(rhi_.get());
+  visibility_ = std::make_unique<Visibility>();
 }
 
 Renderer::~Renderer() {
+  // The render graph returns its memory to the RHI
+  render_graph_.reset();
+
   // Destroy the RHI backend
   MAPLE_LOG_INFO(LogRenderer, "Destroying RHI...");
   rhi_.reset();
@@ -42,7 +142,21 @@ Renderer::~Renderer() {
 }
 
 void Renderer::BeginFrame() {
+  MAPLE_PROFILE_FUNCTION(LogRenderer);
   rhi_->BeginFrame();
+  render_graph_->Reset();
+  gpu_queue_times_ = MeasureGpuQueueTimes(rhi_->GetGpuZones());
+
+  // GPU zones arrive a frame or more late, once the GPU has finished them
+  if (core::Profiler::IsEnabled()) {
+    const auto& tracks{ GetGpuTracks() };
+    for (const rhi::GpuZone& zone : rhi_->GetGpuZones()) {
+      core::Profiler::RecordOnTrack(
+        tracks[static_cast<std::size_t>(zone.queue)], "GPU", zone.name,
+        zone.start_ns, zone.end_ns
+      );
+    }
+  }
 }
 
 void Renderer::Clear(float r, float g, float b, float a) {
@@ -50,11 +164,56 @@ void Renderer::Clear(float r, float g, float b, float a) {
 }
 
 void Renderer::EndFrame() {
+  MAPLE_PROFILE_FUNCTION(LogRenderer);
+  render_graph_->Execute();
   rhi_->EndFrame();
 }
 
 void Renderer::Present() {
+  MAPLE_PROFILE_FUNCTION(LogRenderer);
   rhi_->Present();
+
+  // Report cold-start cost, including pipelines compiled before the frame
+  if (!first_frame_presented_) {
+    first_frame_presented_ = true;
+    const auto elapsed{ std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - creation_time_
+    ) };
+    const rhi::RHIStats stats{ rhi_->GetStats() };
+    MAPLE_LOG_INFO(LogRenderer, "First frame presented {} ms after renderer "
+                                "creation ({} pipeline(s) compiled in {} ms)",
+                   elapsed.count(), stats.pipelines_compiled,
+                   stats.pipeline_compile_microseconds / 1000U);
+  }
+}
+
+void Renderer::SetPresentMode(rhi::PresentMode present_mode) {
+  rhi_->SetPresentMode(present_mode);
+}
+
+rhi::TransientAllocation Renderer::AllocateTransient(std::uint64_t size,
+                                                    rhi::BufferUsage usage) {
+  return rhi_->AllocateTransient(size, usage);
+}
+
+RenderGraph& Renderer::GetRenderGraph() noexcept {
+  return *render_graph_;
+}
+
+const RenderGraphStats& Renderer::GetRenderGraphStats() const noexcept {
+  return render_graph_->GetStats();
+}
+
+std::span<const rhi::GpuZone> Renderer::GetGpuZones() const {
+  return rhi_->GetGpuZones();
+}
+
+const GpuQueueTimes& Renderer::GetGpuQueueTimes() const noexcept {
+  return gpu_queue_times_;
+}
+
+Visibility& Renderer::GetVisibility() noexcept {
+  return *visibility_;
 }
 
 rhi::RHI* Renderer::GetRHI() const noexcept {
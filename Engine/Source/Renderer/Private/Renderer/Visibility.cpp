@@ -0,0 +1,526 @@
+#include "Renderer/Visibility.h"
+
+// STL
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <xmmintrin.h>
+  #define MAPLE_RENDERER_SSE 1
+#endif
+
+// Core
+#include "Core/JobSystem.h"
+#include "Core/Profiler.h"
+
+// Renderer
+#include "Renderer/RendererLog.h"
+
+namespace maple::renderer {
+
+namespace {
+
+/// Smallest clip-space w treated as in front of the eye
+constexpr float kMinClipW{ 1.0e-5F };
+
+/// Fractional bits of occluder corners snapped to the pixel grid
+constexpr int kSubpixelBits{ 8 };
+
+/// Snapped units per pixel
+constexpr std::int64_t kSubpixelScale{ std::int64_t{ 1 } << kSubpixelBits };
+
+/// Farthest an occluder corner may lie from the depth buffer, in pixels;
+/// keeps snapped edge functions well within 64 bits
+constexpr float kGuardBand{ 1.0e6F };
+
+/**
+ * @brief Point transformed to clip space, then to depth buffer pixels.
+ */
+struct ScreenPoint {
+  /// Horizontal position, in pixels
+  float x{ 0.0F };
+
+  /// Vertical position, in pixels
+  float y{ 0.0F };
+
+  /// Depth in [0, 1], 0 at the near plane
+  float z{ 0.0F };
+
+  /// Whether the point is in front of the near plane
+  bool valid{ false };
+};
+
+ScreenPoint Project(const glm::mat4& m, float x, float y, float z) noexcept {
+  const float clip_x{ m[0][0] * x + m[1][0] * y + m[2][0] * z + m[3][0] };
+  const float clip_y{ m[0][1] * x + m[1][1] * y + m[2][1] * z + m[3][1] };
+  const float clip_z{ m[0][2] * x + m[1][2] * y + m[2][2] * z + m[3][2] };
+  const float clip_w{ m[0][3] * x + m[1][3] * y + m[2][3] * z + m[3][3] };
+  if (clip_w <= kMinClipW || clip_z < 0.0F) {
+    return {};
+  }
+
+  const float inverse_w{ 1.0F / clip_w };
+  return ScreenPoint{
+    .x = (clip_x * inverse_w * 0.5F + 0.5F)
+         * static_cast<float>(Visibility::kDepthWidth),
+    .y = (clip_y * inverse_w * 0.5F + 0.5F)
+         * static_cast<float>(Visibility::kDepthHeight),
+    .z = clip_z * inverse_w,
+    .valid = true
+  };
+}
+
+/**
+ * @brief Clamp a pixel range to the depth buffer.
+ *
+ * @return First pixel and one past the last pixel overlapping [min, max]
+ */
+std::array<std::uint32_t, 2U> ClampPixels(float min, float max,
+                                          std::uint32_t size) noexcept {
+  const float limit{ static_cast<float>(size) };
+  return {
+    static_cast<std::uint32_t>(std::clamp(std::floor(min), 0.0F, limit)),
+    static_cast<std::uint32_t>(std::clamp(std::ceil(max), 0.0F, limit))
+  };
+}
+
+} // namespace
+
+RenderableId Visibility::AddRenderable(const glm::vec3& min,
+                                       const glm::vec3& max) {
+  RenderableId renderable{ 0U };
+  if (free_ids_.empty()) {
+    // Grow by a lane group; new slots are padding until handed out
+    if (slot_count_ == alive_.size()) {
+      const std::size_t size{ alive_.size() + kLaneCount };
+      center_x_.resize(size, 0.0F);
+      center_y_.resize(size, 0.0F);
+      center_z_.resize(size, 0.0F);
+      extent_x_.resize(size, 0.0F);
+      extent_y_.resize(size, 0.0F);
+      extent_z_.resize(size, 0.0F);
+      alive_.resize(size, 0U);
+    }
+    renderable = static_cast<RenderableId>(slot_count_++);
+  } else {
+    renderable = free_ids_.back();
+    free_ids_.pop_back();
+  }
+
+  alive_[renderable] = 1U;
+  ++renderable_count_;
+  SetBounds(renderable, min, max);
+  return renderable;
+}
+
+void Visibility::SetBounds(RenderableId renderable, const glm::vec3& min,
+                           const glm::vec3& max) noexcept {
+  center_x_[renderable] = (min.x + max.x) * 0.5F;
+  center_y_[renderable] = (min.y + max.y) * 0.5F;
+  center_z_[renderable] = (min.z + max.z) * 0.5F;
+  extent_x_[renderable] = (max.x - min.x) * 0.5F;
+  extent_y_[renderable] = (max.y - min.y) * 0.5F;
+  extent_z_[renderable] = (max.z - min.z) * 0.5F;
+}
+
+void Visibility::RemoveRenderable(RenderableId renderable) {
+  if (renderable >= slot_count_ || alive_[renderable] == 0U) {
+    const std::string msg{ "Renderable " + std::to_string(renderable)
+                           + " does not exist" };
+    MAPLE_LOG_CRITICAL(LogRenderer, msg);
+    throw std::runtime_error{ msg };
+  }
+  alive_[renderable] = 0U;
+  free_ids_.push_back(renderable);
+  --renderable_count_;
+}
+
+std::size_t Visibility::GetRenderableCount() const noexcept {
+  return renderable_count_;
+}
+
+void Visibility::AddOccluder(std::span<const glm::vec3> vertices,
+                             std::span<const std::uint32_t> indices) {
+  const std::size_t index_count{ indices.size() - indices.size() % 3U };
+  for (std::size_t i{ 0U }; i < index_count; ++i) {
+    if (indices[i] >= vertices.size()) {
+      const std::string msg{ "Occluder index " + std::to_string(indices[i])
+                             + " is out of range for "
+                             + std::to_string(vertices.size())
+                             + " vertex(ices)" };
+      MAPLE_LOG_CRITICAL(LogRenderer, msg);
+      throw std::runtime_error{ msg };
+    }
+  }
+
+  occluder_vertices_.reserve(occluder_vertices_.size() + index_count);
+  for (std::size_t i{ 0U }; i < index_count; ++i) {
+    occluder_vertices_.push_back(vertices[indices[i]]);
+  }
+}
+
+void Visibility::ClearOccluders() noexcept {
+  occluder_vertices_.clear();
+}
+
+void Visibility::Cull(std::span<const CullView> views) {
+  MAPLE_PROFILE_FUNCTION(LogRenderer);
+
+  stats_ = VisibilityStats{
+    .view_count = views.size(),
+    .renderable_count = renderable_count_
+  };
+  visible_.resize(views.size());
+
+  const std::size_t box_count{ alive_.size() };
+  const std::size_t range_count{
+    (box_count + kBoxesPerJob - 1U) / kBoxesPerJob
+  };
+  range_counts_.assign(range_count, 0U);
+
+  for (std::size_t v{ 0U }; v < views.size(); ++v) {
+    const CullView& view{ views[v] };
+    ViewState state{ .view_projection = view.view_projection };
+
+    // Inward-facing planes from the rows of the view-projection matrix,
+    // with clip-space depth in [0, w]
+    const glm::mat4& m{ view.view_projection };
+    const auto row{ [&m](int r) {
+      return std::array<float, 4U>{ m[0][r], m[1][r], m[2][r], m[3][r] };
+    } };
+    const std::array<float, 4U> rows[4]{ row(0), row(1), row(2), row(3) };
+    const std::array<std::array<float, 4U>, 6U> planes{ {
+      { rows[3][0] + rows[0][0], rows[3][1] + rows[0][1],
+        rows[3][2] + rows[0][2], rows[3][3] + rows[0][3] },
+      { rows[3][0] - rows[0][0], rows[3][1] - rows[0][1],
+        rows[3][2] - rows[0][2], rows[3][3] - rows[0][3] },
+      { rows[3][0] + rows[1][0], rows[3][1] + rows[1][1],
+        rows[3][2] + rows[1][2], rows[3][3] + rows[1][3] },
+      { rows[3][0] - rows[1][0], rows[3][1] - rows[1][1],
+        rows[3][2] - rows[1][2], rows[3][3] - rows[1][3] },
+      rows[2],
+      { rows[3][0] - rows[2][0], rows[3][1] - rows[2][1],
+        rows[3][2] - rows[2][2], rows[3][3] - rows[2][3] }
+    } };
+    for (std::size_t p{ 0U }; p < planes.size(); ++p) {
+      state.planes[p] = Plane{
+        .x = planes[p][0], .y = planes[p][1], .z = planes[p][2],
+        .w = planes[p][3], .abs_x = std::fabs(planes[p][0]),
+        .abs_y = std::fabs(planes[p][1]), .abs_z = std::fabs(planes[p][2])
+      };
+    }
+
+    if (view.occlusion_culling && !occluder_vertices_.empty()) {
+      RasterizeOccluders(view.view_projection);
+      state.depth = depth_.data();
+    }
+
+    // Each job compacts its range in place; the ranges are then joined
+    std::vector<RenderableId>& visible{ visible_[v] };
+    visible.resize(box_count);
+    std::atomic<std::size_t> occluded_count{ 0U };
+    core::JobSystem::ParallelFor(
+      range_count, 1U,
+      [&](std::size_t begin, std::size_t end) {
+        for (std::size_t range{ begin }; range < end; ++range) {
+          const std::size_t first{ range * kBoxesPerJob };
+          std::size_t occluded{ 0U };
+          range_counts_[range] = CullRange(
+            state, first, std::min(first + kBoxesPerJob, box_count),
+            visible.data() + first, occluded
+          );
+          occluded_count.fetch_add(occluded, std::memory_order_relaxed);
+        }
+      }
+    );
+
+    std::size_t visible_count{ 0U };
+    for (std::size_t range{ 0U }; range < range_count; ++range) {
+      const auto first{ visible.begin()
+                        + static_cast<std::ptrdiff_t>(range * kBoxesPerJob) };
+      std::copy_n(first, range_counts_[range],
+                  visible.begin()
+                    + static_cast<std::ptrdiff_t>(visible_count));
+      visible_count += range_counts_[range];
+    }
+    visible.resize(visible_count);
+
+    const std::size_t occluded{
+      occluded_count.load(std::memory_order_relaxed)
+    };
+    stats_.visible_count += visible_count;
+    stats_.occlusion_culled_count += occluded;
+    stats_.frustum_culled_count += renderable_count_ - visible_count
+                                   - occluded;
+  }
+}
+
+std::span<const RenderableId> Visibility::GetVisible(
+  std::size_t view) const noexcept {
+  return visible_[view];
+}
+
+const VisibilityStats& Visibility::GetStats() const noexcept {
+  return stats_;
+}
+
+void Visibility::RasterizeOccluders(const glm::mat4& view_projection) {
+  MAPLE_PROFILE_FUNCTION(LogRenderer);
+
+  depth_.assign(std::size_t{ kDepthWidth } * kDepthHeight, 1.0F);
+  for (std::size_t i{ 0U }; i + 2U < occluder_vertices_.size(); i += 3U) {
+    std::array<ScreenPoint, 3U> v{};
+    bool valid{ true };
+    for (std::size_t corner{ 0U }; corner < 3U; ++corner) {
+      const glm::vec3& p{ occluder_vertices_[i + corner] };
+      v[corner] = Project(view_projection, p.x, p.y, p.z);
+      valid = valid && v[corner].valid;
+    }
+
+    // Triangles crossing the near plane (or the guard band) are skipped
+    // rather than clipped, which only hides less
+    for (const ScreenPoint& corner : v) {
+      valid = valid && std::fabs(corner.x) <= kGuardBand
+              && std::fabs(corner.y) <= kGuardBand;
+    }
+    if (!valid) {
+      continue;
+    }
+
+    // Snap the corners to the subpixel grid, so that edge functions are
+    // exact and triangles sharing an edge agree on every pixel along it
+    std::array<std::int64_t, 3U> fx{};
+    std::array<std::int64_t, 3U> fy{};
+    for (std::size_t corner{ 0U }; corner < 3U; ++corner) {
+      fx[corner] = std::llround(v[corner].x * kSubpixelScale);
+      fy[corner] = std::llround(v[corner].y * kSubpixelScale);
+    }
+    std::int64_t area{ (fx[1] - fx[0]) * (fy[2] - fy[0])
+                       - (fy[1] - fy[0]) * (fx[2] - fx[0]) };
+    if (area == 0) {
+      continue;
+    }
+    if (area < 0) {
+      std::swap(v[1], v[2]);
+      std::swap(fx[1], fx[2]);
+      std::swap(fy[1], fy[2]);
+      area = -area;
+    }
+    ++stats_.occluder_triangle_count;
+
+    // Edge functions, each positive on the inner side of the edge opposite
+    // one corner: e(x, y) = a * x + b * y + c. Each edge is set up from its
+    // lower endpoint and then flipped, so a shared edge yields the exact
+    // negation in both triangles. A pixel center on an edge belongs to the
+    // triangle on its top-left side (a > 0, or a == 0 and b > 0), so it is
+    // covered exactly once
+    std::array<std::int64_t, 3U> a{};
+    std::array<std::int64_t, 3U> b{};
+    std::array<std::int64_t, 3U> c{};
+    std::array<std::int64_t, 3U> bias{};
+    for (std::size_t edge{ 0U }; edge < 3U; ++edge) {
+      std::size_t from{ (edge + 1U) % 3U };
+      std::size_t to{ (edge + 2U) % 3U };
+      const bool flip{ fy[to] < fy[from]
+                       || (fy[to] == fy[from] && fx[to] < fx[from]) };
+      if (flip) {
+        std::swap(from, to);
+      }
+      a[edge] = fy[from] - fy[to];
+      b[edge] = fx[to] - fx[from];
+      c[edge] = -(a[edge] * fx[from] + b[edge] * fy[from]);
+      if (flip) {
+        a[edge] = -a[edge];
+        b[edge] = -b[edge];
+        c[edge] = -c[edge];
+      }
+      bias[edge] = (a[edge] > 0 || (a[edge] == 0 && b[edge] > 0)) ? 0 : -1;
+    }
+
+    // Depth is affine in screen space; write its farthest value over the
+    // pixel, which never exceeds the farthest corner
+    const float inverse_area{ 1.0F / static_cast<float>(area) };
+    const float pixel_step{ static_cast<float>(kSubpixelScale) };
+    const float dz_dx{
+      (v[0].z * static_cast<float>(a[0]) + v[1].z * static_cast<float>(a[1])
+       + v[2].z * static_cast<float>(a[2])) * pixel_step * inverse_area
+    };
+    const float dz_dy{
+      (v[0].z * static_cast<float>(b[0]) + v[1].z * static_cast<float>(b[1])
+       + v[2].z * static_cast<float>(b[2])) * pixel_step * inverse_area
+    };
+    const float depth_margin{ 0.5F * (std::fabs(dz_dx) + std::fabs(dz_dy)) };
+    const float max_depth{ std::max({ v[0].z, v[1].z, v[2].z }) };
+
+    const auto [x_begin, x_end]{ ClampPixels(
+      std::min({ v[0].x, v[1].x, v[2].x }),
+      std::max({ v[0].x, v[1].x, v[2].x }), kDepthWidth
+    ) };
+    const auto [y_begin, y_end]{ ClampPixels(
+      std::min({ v[0].y, v[1].y, v[2].y }),
+      std::max({ v[0].y, v[1].y, v[2].y }), kDepthHeight
+    ) };
+    if (x_begin >= x_end || y_begin >= y_end) {
+      continue;
+    }
+
+    // Step the edge functions across pixel centers
+    const std::int64_t px_begin{
+      std::int64_t{ x_begin } * kSubpixelScale + kSubpixelScale / 2
+    };
+    for (std::uint32_t y{ y_begin }; y < y_end; ++y) {
+      const std::int64_t py{
+        std::int64_t{ y } * kSubpixelScale + kSubpixelScale / 2
+      };
+      std::array<std::int64_t, 3U> e{};
+      std::array<std::int64_t, 3U> step{};
+      for (std::size_t edge{ 0U }; edge < 3U; ++edge) {
+        e[edge] = a[edge] * px_begin + b[edge] * py + c[edge] + bias[edge];
+        step[edge] = a[edge] * kSubpixelScale;
+      }
+
+      float* depth_row{ depth_.data() + std::size_t{ y } * kDepthWidth };
+      for (std::uint32_t x{ x_begin }; x < x_end; ++x) {
+        if ((e[0] | e[1] | e[2]) >= 0) {
+          const float z{
+            (static_cast<float>(e[0] - bias[0]) * v[0].z
+             + static_cast<float>(e[1] - bias[1]) * v[1].z
+             + static_cast<float>(e[2] - bias[2]) * v[2].z) * inverse_area
+          };
+          depth_row[x] = std::min(depth_row[x],
+                                  std::min(z + depth_margin, max_depth));
+        }
+        e[0] += step[0];
+        e[1] += step[1];
+        e[2] += step[2];
+      }
+    }
+  }
+}
+
+std::size_t Visibility::CullRange(const ViewState& view, std::size_t begin,
+                                  std::size_t end, RenderableId* visible,
+                                  std::size_t& occluded) const noexcept {
+  std::size_t count{ 0U };
+  for (std::size_t i{ begin }; i < end; i += kLaneCount) {
+    // A box is outside if it lies entirely behind any plane: the distance
+    // of its center plus its extent projected onto the normal is negative
+    int inside_mask{ 0 };
+#if defined(MAPLE_RENDERER_SSE)
+    const __m128 center_x{ _mm_loadu_ps(center_x_.data() + i) };
+    const __m128 center_y{ _mm_loadu_ps(center_y_.data() + i) };
+    const __m128 center_z{ _mm_loadu_ps(center_z_.data() + i) };
+    const __m128 extent_x{ _mm_loadu_ps(extent_x_.data() + i) };
+    const __m128 extent_y{ _mm_loadu_ps(extent_y_.data() + i) };
+    const __m128 extent_z{ _mm_loadu_ps(extent_z_.data() + i) };
+    __m128 outside{ _mm_setzero_ps() };
+    for (const Plane& plane : view.planes) {
+      __m128 distance{ _mm_set1_ps(plane.w) };
+      distance = _mm_add_ps(distance,
+                            _mm_mul_ps(center_x, _mm_set1_ps(plane.x)));
+      distance = _mm_add_ps(distance,
+                            _mm_mul_ps(center_y, _mm_set1_ps(plane.y)));
+      distance = _mm_add_ps(distance,
+                            _mm_mul_ps(center_z, _mm_set1_ps(plane.z)));
+      distance = _mm_add_ps(distance,
+                            _mm_mul_ps(extent_x, _mm_set1_ps(plane.abs_x)));
+      distance = _mm_add_ps(distance,
+                            _mm_mul_ps(extent_y, _mm_set1_ps(plane.abs_y)));
+      distance = _mm_add_ps(distance,
+                            _mm_mul_ps(extent_z, _mm_set1_ps(plane.abs_z)));
+      outside = _mm_or_ps(outside,
+                          _mm_cmplt_ps(distance, _mm_setzero_ps()));
+    }
+    inside_mask = ~_mm_movemask_ps(outside) & 0xF;
+#else
+    for (std::size_t lane{ 0U }; lane < kLaneCount; ++lane) {
+      const std::size_t box{ i + lane };
+      bool inside{ true };
+      for (const Plane& plane : view.planes) {
+        const float distance{
+          plane.w + center_x_[box] * plane.x + center_y_[box] * plane.y
+          + center_z_[box] * plane.z + extent_x_[box] * plane.abs_x
+          + extent_y_[box] * plane.abs_y + extent_z_[box] * plane.abs_z
+        };
+        inside = inside && distance >= 0.0F;
+      }
+      inside_mask |= inside ? (1 << lane) : 0;
+    }
+#endif
+
+    for (std::size_t lane{ 0U }; lane < kLaneCount; ++lane) {
+      const std::size_t box{ i + lane };
+      if ((inside_mask & (1 << lane)) == 0 || alive_[box] == 0U) {
+        continue;
+      }
+      if (view.depth && IsOccluded(view, box)) {
+        ++occluded;
+        continue;
+      }
+      visible[count++] = static_cast<RenderableId>(box);
+    }
+  }
+  return count;
+}
+
+bool Visibility::IsOccluded(const ViewState& view,
+                            std::size_t box) const noexcept {
+  // Screen rectangle and nearest depth of the box's eight corners; a box
+  // reaching behind the near plane is treated as visible
+  constexpr float kInfinity{ std::numeric_limits<float>::infinity() };
+  float min_x{ kInfinity };
+  float min_y{ kInfinity };
+  float max_x{ -kInfinity };
+  float max_y{ -kInfinity };
+  float min_z{ kInfinity };
+  for (std::uint32_t corner{ 0U }; corner < 8U; ++corner) {
+    const auto side{ [corner](std::uint32_t axis) {
+      return (corner & (1U << axis)) != 0U ? 1.0F : -1.0F;
+    } };
+    const ScreenPoint point{ Project(
+      view.view_projection,
+      center_x_[box] + side(0U) * extent_x_[box],
+      center_y_[box] + side(1U) * extent_y_[box],
+      center_z_[box] + side(2U) * extent_z_[box]
+    ) };
+    if (!point.valid) {
+      return false;
+    }
+    min_x = std::min(min_x, point.x);
+    min_y = std::min(min_y, point.y);
+    max_x = std::max(max_x, point.x);
+    max_y = std::max(max_y, point.y);
+    min_z = std::min(min_z, point.z);
+  }
+
+  // Grown by a pixel: an occluder covering the center of a pixel the box
+  // peeks through does not cover the next pixel outwards
+  const auto [x_begin, x_end]{
+    ClampPixels(min_x - 1.0F, max_x + 1.0F, kDepthWidth)
+  };
+  const auto [y_begin, y_end]{
+    ClampPixels(min_y - 1.0F, max_y + 1.0F, kDepthHeight)
+  };
+  if (x_begin >= x_end || y_begin >= y_end) {
+    return false;
+  }
+
+  // Hidden only if every pixel holds a nearer occluder
+  for (std::uint32_t y{ y_begin }; y < y_end; ++y) {
+    const float* depth_row{ view.depth + std::size_t{ y } * kDepthWidth };
+    for (std::uint32_t x{ x_begin }; x < x_end; ++x) {
+      if (depth_row[x] >= min_z) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace maple::renderer
@@ -0,0 +1,635 @@
+#pragma once
+
+// STL
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+// Core
+#include "Core/Memory.h"
+
+// RHI
+#include "RHI/RHIResources.h"
+
+// Renderer
+#include "Renderer/RendererExport.h"
+
+// Forward declarations
+namespace maple::rhi { class RHI; class RHICommandList; }
+
+namespace maple::renderer {
+
+/**
+ * @brief Handle to a texture used by a render graph during one frame.
+ */
+struct RenderGraphTexture {
+  /// Index of the resource in the graph
+  std::uint32_t index{ std::numeric_limits<std::uint32_t>::max() };
+
+  bool operator==(const RenderGraphTexture&) const = default;
+};
+
+/**
+ * @brief Handle to a buffer used by a render graph during one frame.
+ */
+struct RenderGraphBuffer {
+  /// Index of the resource in the graph
+  std::uint32_t index{ std::numeric_limits<std::uint32_t>::max() };
+
+  bool operator==(const RenderGraphBuffer&) const = default;
+};
+
+/**
+ * @brief What compiling and executing a frame's render graph did.
+ */
+struct RenderGraphStats {
+  /// Passes added during the frame
+  std::uint32_t pass_count{ 0U };
+
+  /// Passes culled because nothing used their results
+  std::uint32_t culled_pass_count{ 0U };
+
+  /// Dependency levels the remaining passes were grouped into
+  std::uint32_t level_count{ 0U };
+
+  /// Resource transitions recorded
+  std::uint32_t barrier_count{ 0U };
+
+  /// Transitions shared with another pass of the same level instead of
+  /// being recorded again
+  std::uint32_t merged_barrier_count{ 0U };
+
+  /// Pipeline barriers recorded (at most one per level)
+  std::uint32_t barrier_batch_count{ 0U };
+
+  /// Pipeline barriers recording transitions per pass would have taken
+  std::uint32_t unbatched_barrier_batch_count{ 0U };
+
+  /// Transient textures created by the remaining passes
+  std::uint32_t transient_texture_count{ 0U };
+
+  /// Bytes of memory heaps the transient textures were placed in
+  std::uint64_t transient_bytes{ 0U };
+
+  /// Bytes the transient textures would take without sharing memory
+  std::uint64_t unaliased_transient_bytes{ 0U };
+
+  /// Remaining passes run on the async compute queue
+  std::uint32_t async_compute_pass_count{ 0U };
+
+  /// Resources handed over between queues with their contents
+  std::uint32_t queue_transfer_count{ 0U };
+
+  /// Barrier lists that wait for the other queue
+  std::uint32_t queue_wait_count{ 0U };
+
+  /// Levels with passes on both queues, which the GPU may overlap (see
+  /// Renderer::GetGpuQueueTimes() for the measured overlap)
+  std::uint32_t overlapped_level_count{ 0U };
+
+  bool operator==(const RenderGraphStats&) const = default;
+};
+
+class RenderGraph;
+
+/**
+ * @brief Declares the resources a render graph pass accesses.
+ *
+ * Returned by RenderGraph::AddPass(); valid until the next AddPass() call.
+ * A pass may access a resource in one state only. Writes that keep the
+ * existing contents (e.g., blending) must declare a read as well.
+ */
+class MAPLE_RENDERER_API RenderGraphPassBuilder {
+public:
+  /**
+   * @brief Declare that the pass reads a texture.
+   *
+   * @param texture Texture to read
+   * @param state How the pass reads it (e.g., ShaderRead)
+   * @return This builder
+   * @throws std::runtime_error If the pass already accesses the texture in
+   *                            another state
+   */
+  RenderGraphPassBuilder& Read(RenderGraphTexture texture,
+                               rhi::ResourceState state);
+
+  /**
+   * @brief Declare that the pass writes a texture.
+   *
+   * @param texture Texture to write
+   * @param state How the pass writes it (e.g., ColorAttachment)
+   * @return This builder
+   * @throws std::runtime_error If the pass already accesses the texture in
+   *                            another state
+   */
+  RenderGraphPassBuilder& Write(RenderGraphTexture texture,
+                                rhi::ResourceState state);
+
+  /**
+   * @brief Declare that the pass reads a buffer.
+   *
+   * @param buffer Buffer to read
+   * @param state How the pass reads it (e.g., ShaderRead)
+   * @return This builder
+   * @throws std::runtime_error If the pass already accesses the buffer in
+   *                            another state
+   */
+  RenderGraphPassBuilder& Read(RenderGraphBuffer buffer,
+                               rhi::ResourceState state);
+
+  /**
+   * @brief Declare that the pass writes a buffer.
+   *
+   * @param buffer Buffer to write
+   * @param state How the pass writes it (e.g., ShaderWrite)
+   * @return This builder
+   * @throws std::runtime_error If the pass already accesses the buffer in
+   *                            another state
+   */
+  RenderGraphPassBuilder& Write(RenderGraphBuffer buffer,
+                                rhi::ResourceState state);
+
+  /**
+   * @brief Keep the pass even if no other pass uses its results (e.g., it
+   *        renders to the swapchain or reads back to the CPU).
+   *
+   * @return This builder
+   */
+  RenderGraphPassBuilder& SideEffect();
+
+  /**
+   * @brief Run the pass on the async compute queue, alongside graphics
+   *        passes (see rhi::RHI::HasAsyncCompute()).
+   *
+   * The pass records compute and copy commands only, and accesses resources
+   * in compute states only (see rhi::IsComputeState()). Without an async
+   * compute queue, it runs on the graphics queue like any other pass.
+   *
+   * @return This builder
+   */
+  RenderGraphPassBuilder& AsyncCompute();
+
+private:
+  friend class RenderGraph;
+
+  /**
+   * @brief Construct a builder for a pass.
+   *
+   * @param graph Graph the pass belongs to
+   * @param pass Index of the pass
+   */
+  RenderGraphPassBuilder(RenderGraph& graph, std::uint32_t pass) noexcept;
+
+  /// Graph the pass belongs to
+  RenderGraph* graph_;
+
+  /// Index of the pass
+  std::uint32_t pass_;
+};
+
+/**
+ * @brief Frame render graph: orders passes by the resources they access and
+ *        synchronizes and allocates those resources.
+ *
+ * Each frame, passes are added with the textures and buffers they read and
+ * write, then Execute() compiles the graph:
+ *   - Passes whose results reach neither a side-effect pass nor an imported
+ *     resource are culled
+ *   - The remaining passes are grouped into dependency levels; passes of a
+ *     level are independent of each other
+ *   - The transitions of a level are merged and recorded as one pipeline
+ *     barrier ahead of the level's passes
+ *   - Transient textures whose lifetimes (first to last level used) do not
+ *     overlap are placed at overlapping offsets of shared memory heaps
+ *   - Async compute passes run on the compute queue; resources are handed
+ *     over between the queues, and a queue waits for the other only where
+ *     a level depends on it
+ *
+ * Each pass records into its own command list, submitted in level order.
+ * Memory heaps and placed textures are kept across frames and only
+ * recreated when the frame's layout no longer fits them.
+ *
+ * @note Not thread-safe; build and execute the graph on the render thread.
+ */
+class MAPLE_RENDERER_API RenderGraph
+  : public core::TrackedAllocation<core::MemoryTag::Renderer> {
+public:
+  /**
+   * @brief Records a pass's commands; resolve graph resources through the
+   *        graph.
+   */
+  using ExecuteFunction =
+    std::function<void(rhi::RHICommandList&, const RenderGraph&)>;
+
+  RenderGraph() = delete;
+  RenderGraph(const RenderGraph&) = delete;
+  RenderGraph& operator=(const RenderGraph&) = delete;
+  RenderGraph(RenderGraph&&) = delete;
+  RenderGraph& operator=(RenderGraph&&) = delete;
+
+  /**
+   * @brief Construct an empty graph.
+   *
+   * @param rhi Backend to record and allocate with (must outlive the graph)
+   */
+  explicit RenderGraph(rhi::RHI* rhi);
+
+  /**
+   * @brief Destroy the cached placed textures and memory heaps.
+   */
+  ~RenderGraph();
+
+  /**
+   * @brief Drop the passes and resources of the previous frame.
+   */
+  void Reset();
+
+  /**
+   * @brief Declare a texture that only lives during the frame.
+   *
+   * The texture is created only if a remaining pass uses it, and may share
+   * memory with other transient textures; its contents are undefined until
+   * a pass writes it.
+   *
+   * @param desc Size, format, and usage of the texture
+   * @return Handle to the texture
+   */
+  [[nodiscard]] RenderGraphTexture CreateTexture(const rhi::TextureDesc& desc);
+
+  /**
+   * @brief Use a texture that outlives the frame.
+   *
+   * Passes that write imported resources are never culled.
+   *
+   * @param texture Texture to use
+   * @param initial_state State the texture is in before the frame
+   * @param final_state State to leave the texture in after the frame
+   * @return Handle to the texture
+   */
+  [[nodiscard]] RenderGraphTexture ImportTexture(
+    rhi::TextureHandle texture,
+    rhi::ResourceState initial_state,
+    rhi::ResourceState final_state
+  );
+
+  /**
+   * @brief Use a buffer that outlives the frame.
+   *
+   * Passes that write imported resources are never culled.
+   *
+   * @param buffer Buffer to use
+   * @param initial_state State the buffer is in before the frame
+   * @param final_state State to leave the buffer in after the frame
+   * @return Handle to the buffer
+   */
+  [[nodiscard]] RenderGraphBuffer ImportBuffer(
+    rhi::BufferHandle buffer,
+    rhi::ResourceState initial_state,
+    rhi::ResourceState final_state
+  );
+
+  /**
+   * @brief Add a pass; declare its accesses with the returned builder.
+   *
+   * @param name Name of the pass for logs and its CPU and GPU profile zones
+   *             (string literal)
+   * @param execute Records the pass's commands
+   * @return Builder of the pass
+   */
+  [[nodiscard]] RenderGraphPassBuilder AddPass(const char* name,
+                                               ExecuteFunction execute);
+
+  /**
+   * @brief Compile the graph and record the remaining passes.
+   *
+   * Must be called between RHI::BeginFrame() and RHI::EndFrame(). The
+   * command lists use sort keys (level << 32) | slot, so lists recorded
+   * outside the graph in the same frame need keys outside that range.
+   *
+   * @throws std::runtime_error If a pass reads a transient resource no
+   *                            earlier pass writes, or an async compute pass
+   *                            accesses a resource in a graphics state;
+   *                            rethrows what passes and the RHI throw
+   */
+  void Execute();
+
+  /**
+   * @brief Choose whether async compute passes run on the compute queue.
+   *
+   * Disabling runs them on the graphics queue, e.g., to compare frame times
+   * with and without overlap. Takes effect at the next Execute().
+   *
+   * @param enabled Whether to use the compute queue if the RHI has one
+   */
+  void SetAsyncComputeEnabled(bool enabled) noexcept;
+
+  /**
+   * @brief Get the RHI texture of a graph texture.
+   *
+   * Valid while passes execute.
+   *
+   * @param texture Texture declared this frame
+   * @return Texture handle (invalid if the texture was never created)
+   */
+  [[nodiscard]] rhi::TextureHandle GetTexture(
+    RenderGraphTexture texture
+  ) const noexcept;
+
+  /**
+   * @brief Get the RHI buffer of a graph buffer.
+   *
+   * @param buffer Buffer declared this frame
+   * @return Buffer handle
+   */
+  [[nodiscard]] rhi::BufferHandle GetBuffer(
+    RenderGraphBuffer buffer
+  ) const noexcept;
+
+  /**
+   * @brief Get what the last Execute() did.
+   *
+   * @return Statistics of the last executed frame
+   */
+  [[nodiscard]] const RenderGraphStats& GetStats() const noexcept;
+
+private:
+  friend class RenderGraphPassBuilder;
+
+  /// Index meaning "no pass"
+  static constexpr std::uint32_t kNoPass{
+    std::numeric_limits<std::uint32_t>::max()
+  };
+
+  /// Frames a cached heap or placed texture may go unused before it is
+  /// destroyed
+  static constexpr std::uint64_t kUnusedLifetime{ 8U };
+
+  /// Granularity memory heaps are sized in, so that small growth does not
+  /// recreate them every frame
+  static constexpr std::uint64_t kHeapGranularity{ 1024U * 1024U };
+
+  /**
+   * @brief Resource used during one frame.
+   */
+  struct Resource {
+    /// Whether the resource is a texture (otherwise a buffer)
+    bool is_texture{ true };
+
+    /// Whether the resource outlives the frame
+    bool imported{ false };
+
+    /// Creation parameters of transient textures
+    rhi::TextureDesc desc{};
+
+    /// Texture (transient textures: set once placed)
+    rhi::TextureHandle texture{};
+
+    /// Buffer
+    rhi::BufferHandle buffer{};
+
+    /// State before the frame (Undefined for transient textures)
+    rhi::ResourceState initial_state{ rhi::ResourceState::Undefined };
+
+    /// State to leave imported resources in
+    rhi::ResourceState final_state{ rhi::ResourceState::Undefined };
+
+    /// First level a remaining pass uses the resource in (kNoPass if none)
+    std::uint32_t first_level{ kNoPass };
+
+    /// Last level a remaining pass uses the resource in
+    std::uint32_t last_level{ 0U };
+  };
+
+  /**
+   * @brief Access of a pass to a resource.
+   */
+  struct Access {
+    /// Index of the resource
+    std::uint32_t resource{ 0U };
+
+    /// State the pass needs the resource in
+    rhi::ResourceState state{ rhi::ResourceState::Undefined };
+
+    /// Whether the pass reads the resource
+    bool read{ false };
+
+    /// Whether the pass writes the resource
+    bool write{ false };
+  };
+
+  /**
+   * @brief Pass added during one frame.
+   */
+  struct Pass {
+    /// Name (string literal)
+    const char* name{ "" };
+
+    /// Records the pass's commands
+    ExecuteFunction execute{};
+
+    /// Resources the pass accesses
+    std::vector<Access> accesses{};
+
+    /// Whether the pass is kept regardless of its results
+    bool side_effect{ false };
+
+    /// Whether the pass may run on the async compute queue
+    bool async_compute{ false };
+
+    /// Queue the pass runs on (set by AssignQueues())
+    rhi::QueueType queue{ rhi::QueueType::Graphics };
+
+    /// Whether the pass's results are used (set by Compile())
+    bool live{ false };
+
+    /// Dependency level (set by Compile())
+    std::uint32_t level{ 0U };
+  };
+
+  /**
+   * @brief Ordering constraint between two passes.
+   */
+  struct Edge {
+    /// Earlier pass
+    std::uint32_t from{ 0U };
+
+    /// Later pass
+    std::uint32_t to{ 0U };
+
+    /// Whether the later pass reads what the earlier one wrote (as opposed
+    /// to only having to run after it)
+    bool data{ false };
+  };
+
+  /**
+   * @brief Memory heap kept across frames.
+   */
+  struct Heap {
+    /// Size, alignment, and memory types of the heap
+    rhi::MemoryRequirements requirements{};
+
+    /// Heap handle
+    rhi::MemoryHeapHandle handle{};
+
+    /// Last frame the heap was used in
+    std::uint64_t last_used_frame{ 0U };
+  };
+
+  /**
+   * @brief Texture placed in a heap, kept across frames.
+   */
+  struct PlacedTexture {
+    /// Creation parameters
+    rhi::TextureDesc desc{};
+
+    /// Heap the texture is placed in
+    rhi::MemoryHeapHandle heap{};
+
+    /// Offset within the heap
+    std::uint64_t offset{ 0U };
+
+    /// Texture handle
+    rhi::TextureHandle texture{};
+
+    /// Last frame the texture was used in
+    std::uint64_t last_used_frame{ 0U };
+  };
+
+  /**
+   * @brief Memory requirements of a texture description, cached because
+   *        backends may have to create an image to query them.
+   */
+  struct CachedRequirements {
+    /// Texture description
+    rhi::TextureDesc desc{};
+
+    /// Requirements of the description
+    rhi::MemoryRequirements requirements{};
+  };
+
+  /**
+   * @brief Add an access of a pass to a resource.
+   *
+   * @param pass Index of the pass
+   * @param resource Index of the resource
+   * @param state State the pass needs the resource in
+   * @param write Whether the pass writes the resource (otherwise it reads)
+   * @throws std::runtime_error If the pass accesses the resource in another
+   *                            state
+   */
+  void AddAccess(std::uint32_t pass, std::uint32_t resource,
+                 rhi::ResourceState state, bool write);
+
+  /**
+   * @brief Choose the queue of every pass.
+   *
+   * @throws std::runtime_error If an async compute pass accesses a resource
+   *                            in a graphics state
+   */
+  void AssignQueues();
+
+  /**
+   * @brief Find the ordering constraints between passes.
+   *
+   * @throws std::runtime_error If a pass reads a transient resource before
+   *                            any pass writes it
+   */
+  void BuildEdges();
+
+  /**
+   * @brief Cull passes whose results are unused and assign the levels and
+   *        execution order of the others.
+   */
+  void CullAndSchedule();
+
+  /**
+   * @brief Place the transient textures in memory heaps, sharing memory
+   *        between textures whose lifetimes do not overlap.
+   */
+  void AllocateTransients();
+
+  /**
+   * @brief Record the barriers and passes of every level.
+   */
+  void Record();
+
+  /**
+   * @brief Get the memory requirements of a texture description.
+   */
+  [[nodiscard]] rhi::MemoryRequirements GetRequirements(
+    const rhi::TextureDesc& desc
+  );
+
+  /**
+   * @brief Get the heap for a memory type set, recreating it if too small.
+   *
+   * @param requirements Combined requirements of the textures to place
+   * @return Handle to the heap to place the textures in
+   */
+  [[nodiscard]] rhi::MemoryHeapHandle AcquireHeap(
+    const rhi::MemoryRequirements& requirements
+  );
+
+  /**
+   * @brief Get a texture placed at an offset of a heap, creating it on a
+   *        miss.
+   */
+  [[nodiscard]] rhi::TextureHandle AcquirePlacedTexture(
+    const rhi::TextureDesc& desc,
+    rhi::MemoryHeapHandle heap,
+    std::uint64_t offset
+  );
+
+  /**
+   * @brief Destroy heaps unused for a while and the textures placed in
+   *        them.
+   */
+  void ReleaseUnusedHeaps();
+
+  /**
+   * @brief Destroy placed textures unused for a while, or all of a heap's.
+   *
+   * @param heap Heap whose textures to destroy regardless of use (invalid
+   *             for none)
+   */
+  void ReleasePlacedTextures(rhi::MemoryHeapHandle heap);
+
+  /// Backend to record and allocate with
+  rhi::RHI* rhi_;
+
+  /// Passes of the frame, in the order they were added
+  std::vector<Pass> passes_{};
+
+  /// Resources of the frame
+  std::vector<Resource> resources_{};
+
+  /// Ordering constraints, grouped by later pass in ascending order
+  std::vector<Edge> edges_{};
+
+  /// Remaining passes in execution order (by level, then as added)
+  std::vector<std::uint32_t> execution_order_{};
+
+  /// Number of dependency levels
+  std::uint32_t level_count_{ 0U };
+
+  /// Heaps of transient textures, one per memory type set
+  std::vector<Heap> heaps_{};
+
+  /// Placed textures kept across frames
+  std::vector<PlacedTexture> placed_textures_{};
+
+  /// Memory requirements of the descriptions seen so far
+  std::vector<CachedRequirements> requirements_cache_{};
+
+  /// Frames executed
+  std::uint64_t frame_index_{ 0U };
+
+  /// Whether async compute passes use the compute queue if the RHI has one
+  bool async_compute_enabled_{ true };
+
+  /// Statistics of the last executed frame
+  RenderGraphStats stats_{};
+};
+
+} // namespace maple::renderer
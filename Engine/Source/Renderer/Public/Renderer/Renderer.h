@@ -1,10 +1,25 @@
 #pragma once
 
 // STL
+#include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <span>
+#include <type_traits>
+
+// Core
+#include "Core/Memory.h"
+
+// RHI
+#include "RHI/RHIConfig.h"
+#include "RHI/RHIResources.h"
+#include "RHI/RHIStats.h"
 
 // Renderer
+#include "Renderer/RenderGraph.h"
 #include "Renderer/RendererExport.h"
+#include "Renderer/Visibility.h"
 
 // Forward declarations
 namespace maple::platform { class Window; }
@@ -12,7 +27,36 @@ namespace maple::rhi { class RHI; }
 
 namespace maple::renderer {
 
-class MAPLE_RENDERER_API Renderer {
+/**
+ * @brief How long the GPU queues were busy, measured from GPU zones.
+ */
+struct GpuQueueTimes {
+  /// Nanoseconds the graphics queue was busy
+  std::int64_t graphics_ns{ 0 };
+
+  /// Nanoseconds the async compute queue was busy
+  std::int64_t compute_ns{ 0 };
+
+  /// Nanoseconds both queues were busy at once
+  std::int64_t overlapped_ns{ 0 };
+};
+
+/**
+ * @brief Measure how long the GPU queues were busy, alone and at once.
+ *
+ * A queue is busy during the union of its zones. The backend's "Frame"
+ * zones are left out, since they also span the gaps between a frame's
+ * submissions.
+ *
+ * @param zones GPU zones (e.g., from rhi::RHI::GetGpuZones())
+ * @return Busy and overlapped times of the queues
+ */
+[[nodiscard]] MAPLE_RENDERER_API GpuQueueTimes MeasureGpuQueueTimes(
+  std::span<const rhi::GpuZone> zones
+);
+
+class MAPLE_RENDERER_API Renderer
+  : public core::TrackedAllocation<core::MemoryTag::Renderer> {
 public:
   Renderer() = delete;
   Renderer(const Renderer&) = delete;
@@ -20,12 +64,24 @@ public:
   Renderer(Renderer&&) = delete;
   Renderer& operator=(Renderer&&) = delete;
 
-  explicit Renderer(platform::Window* window);
+  /**
+   * @brief Construct a renderer and its RHI backend for the window.
+   *
+   * @param window Non-owning pointer to the window (must not be null)
+   * @param config Device selection and backend settings
+   *
+   * @throws std::runtime_error If the RHI backend cannot be created
+   */
+  explicit Renderer(platform::Window* window,
+                    const rhi::RHIConfig& config = {});
 
   ~Renderer();
 
   /**
    * @brief Begin a new rendering frame.
+   *
+   * Starts an empty render graph for the frame, and adds the GPU zones of
+   * frames the GPU has finished to the profiler's trace.
    */
   void BeginFrame();
 
@@ -41,6 +97,8 @@ public:
 
   /**
    * @brief End the current rendering frame.
+   *
+   * Compiles and records the frame's render graph before submitting.
    */
   void EndFrame();
 
@@ -49,6 +107,106 @@ public:
    */
   void Present();
 
+  /**
+   * @brief Change how frames are presented (e.g., Mailbox to uncap the frame
+   *        rate without tearing).
+   *
+   * Takes effect at the start of the next frame; may be called from any
+   * thread.
+   *
+   * @param present_mode Requested presentation mode (falls back to Fifo if
+   *                     unsupported)
+   */
+  void SetPresentMode(rhi::PresentMode present_mode);
+
+  /**
+   * @brief Allocate per-frame data, such as shader constants or dynamic
+   *        vertices, for the GPU to read this frame.
+   *
+   * Sub-allocates from a persistently mapped ring buffer; may be called from
+   * any thread between BeginFrame() and EndFrame().
+   *
+   * @param size Size in bytes
+   * @param usage How the GPU reads the data (determines the alignment)
+   * @return Writable range, and the buffer and offset to bind it at
+   * @throws std::runtime_error If the frame's share of the ring is exhausted
+   */
+  [[nodiscard]] rhi::TransientAllocation AllocateTransient(
+    std::uint64_t size,
+    rhi::BufferUsage usage
+  );
+
+  /**
+   * @brief Copy values into per-frame memory for the GPU to read this frame.
+   *
+   * @tparam T Trivially copyable element type
+   * @param values Values to copy
+   * @param usage How the GPU reads the data (determines the alignment)
+   * @return Range holding the copy, and the buffer and offset to bind it at
+   * @throws std::runtime_error If the frame's share of the ring is exhausted
+   */
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  [[nodiscard]] rhi::TransientAllocation WriteTransient(
+    std::span<const T> values,
+    rhi::BufferUsage usage
+  ) {
+    const rhi::TransientAllocation allocation{
+      AllocateTransient(values.size_bytes(), usage)
+    };
+    std::memcpy(allocation.data.data(), values.data(), values.size_bytes());
+    return allocation;
+  }
+
+  /**
+   * @brief Get the render graph of the current frame.
+   *
+   * Add the frame's passes between BeginFrame() and EndFrame() on the
+   * render thread.
+   *
+   * @return Render graph owned by the renderer
+   */
+  [[nodiscard]] RenderGraph& GetRenderGraph() noexcept;
+
+  /**
+   * @brief Get what the render graph did in the last ended frame (culled
+   *        passes, barriers, and transient memory).
+   *
+   * @return Statistics of the last ended frame
+   */
+  [[nodiscard]] const RenderGraphStats& GetRenderGraphStats() const noexcept;
+
+  /**
+   * @brief Get the GPU zones collected by the last BeginFrame(), on the
+   *        profiler clock.
+   *
+   * @return Zones, valid until the next BeginFrame()
+   */
+  [[nodiscard]] std::span<const rhi::GpuZone> GetGpuZones() const;
+
+  /**
+   * @brief Get how long the GPU queues were busy in the frames whose zones
+   *        the last BeginFrame() collected.
+   *
+   * Compare overlapped_ns with compute_ns to see how much async compute
+   * work actually ran alongside graphics work, rather than the levels the
+   * render graph made eligible (see RenderGraphStats).
+   *
+   * @return Queue times measured from GetGpuZones()
+   */
+  [[nodiscard]] const GpuQueueTimes& GetGpuQueueTimes() const noexcept;
+
+  /**
+   * @brief Get the visibility stage that culls renderables before their
+   *        passes are added.
+   *
+   * Register renderable bounds and occluders, then cull once per frame for
+   * every view (e.g., the camera and shadow cascades) before recording.
+   *
+   * @return Visibility stage owned by the renderer
+   */
+  [[nodiscard]] Visibility& GetVisibility() noexcept;
+
   /**
    * @brief Get direct access to the RHI backend.
    *
@@ -62,6 +220,23 @@ public:
 private:
   /// Abstracted graphics API backend
   std::unique_ptr<rhi::RHI> rhi_{ nullptr };
+
+  /// Orders the frame's passes and manages their resources
+  std::unique_ptr<RenderGraph> render_graph_{ nullptr };
+
+  /// Culls renderables against the frame's views
+  std::unique_ptr<Visibility> visibility_{ nullptr };
+
+  /// When construction began, for measuring time to first frame
+  std::chrono::steady_clock::time_point creation_time_{
+    std::chrono::steady_clock::now()
+  };
+
+  /// Whether a frame has been presented yet
+  bool first_frame_presented_{ false };
+
+  /// Queue times of the zones collected by the last BeginFrame()
+  GpuQueueTimes gpu_queue_times_{};
 };
 
 } // namespace maple::renderer
@@ -0,0 +1,261 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// glm
+#include "glm/mat4x4.hpp"
+#include "glm/vec3.hpp"
+
+// Core
+#include "Core/Memory.h"
+
+// Renderer
+#include "Renderer/RendererExport.h"
+
+namespace maple::renderer {
+
+/// Handle to a renderable's bounds in a Visibility (reused once removed)
+using RenderableId = std::uint32_t;
+
+/**
+ * @brief Point of view to find the visible renderables of.
+ */
+struct CullView {
+  /// World-to-clip transform, with clip-space depth in [0, w] as in Vulkan
+  /// (e.g., glm with GLM_FORCE_DEPTH_ZERO_TO_ONE)
+  glm::mat4 view_projection{ 1.0F };
+
+  /// Whether to also cull renderables hidden behind the occluders
+  bool occlusion_culling{ false };
+};
+
+/**
+ * @brief What the last Cull() did, summed over its views.
+ */
+struct VisibilityStats {
+  /// Number of views culled
+  std::size_t view_count{ 0U };
+
+  /// Number of renderables tested per view
+  std::size_t renderable_count{ 0U };
+
+  /// Renderables outside a view's frustum
+  std::size_t frustum_culled_count{ 0U };
+
+  /// Renderables inside a view's frustum but hidden behind occluders
+  std::size_t occlusion_culled_count{ 0U };
+
+  /// Renderables visible from a view
+  std::size_t visible_count{ 0U };
+
+  /// Occluder triangles rasterized
+  std::size_t occluder_triangle_count{ 0U };
+};
+
+/**
+ * @brief Finds the renderables visible from a set of views, so that only
+ *        those are submitted.
+ *
+ * Renderables are registered as world-space axis-aligned bounding boxes,
+ * kept as arrays of centers and half extents. Cull() tests four boxes at
+ * once against a view's six frustum planes with SSE (scalar elsewhere),
+ * splitting the boxes across the job system's threads, and writes each
+ * view's visible handles to a compact list in ascending order.
+ *
+ * Views may also cull by occlusion: the occluders (world-space triangles,
+ * e.g., simplified walls and terrain) are rasterized into a small CPU depth
+ * buffer, and a box inside the frustum is culled if every pixel its
+ * projection covers holds a nearer occluder. Occluder corners are snapped
+ * to a subpixel grid and pixels are covered at their centers with a
+ * top-left rule, so triangles sharing an edge leave no gap along it.
+ * Occluders write their farthest depth over each pixel, and boxes are
+ * tested over their projection grown by a pixel, so that pixels an
+ * occluder's silhouette only partly covers do not hide boxes behind them.
+ *
+ * @note Not thread-safe; Cull() splits its own work across threads.
+ */
+class MAPLE_RENDERER_API Visibility
+  : public core::TrackedAllocation<core::MemoryTag::Renderer> {
+public:
+  Visibility(const Visibility&) = delete;
+  Visibility& operator=(const Visibility&) = delete;
+  Visibility(Visibility&&) = delete;
+  Visibility& operator=(Visibility&&) = delete;
+
+  /// Width of the occlusion depth buffer, in pixels
+  static constexpr std::uint32_t kDepthWidth{ 256U };
+
+  /// Height of the occlusion depth buffer, in pixels
+  static constexpr std::uint32_t kDepthHeight{ 128U };
+
+  /**
+   * @brief Construct an empty set of renderables and occluders.
+   */
+  Visibility() = default;
+
+  /**
+   * @brief Register a renderable's bounds.
+   *
+   * @param min Minimum corner of the world-space bounding box
+   * @param max Maximum corner of the world-space bounding box
+   * @return Handle to the renderable
+   */
+  [[nodiscard]] RenderableId AddRenderable(const glm::vec3& min,
+                                           const glm::vec3& max);
+
+  /**
+   * @brief Update a renderable's bounds, e.g., after it moved.
+   */
+  void SetBounds(RenderableId renderable, const glm::vec3& min,
+                 const glm::vec3& max) noexcept;
+
+  /**
+   * @brief Stop culling a renderable; its handle may be reused.
+   *
+   * @throws std::runtime_error If the renderable does not exist
+   */
+  void RemoveRenderable(RenderableId renderable);
+
+  /**
+   * @brief Get the number of registered renderables.
+   */
+  [[nodiscard]] std::size_t GetRenderableCount() const noexcept;
+
+  /**
+   * @brief Add occluder triangles, kept until ClearOccluders().
+   *
+   * @param vertices World-space positions
+   * @param indices Three vertex indices per triangle, either winding
+   * @throws std::runtime_error If an index is out of range
+   */
+  void AddOccluder(std::span<const glm::vec3> vertices,
+                   std::span<const std::uint32_t> indices);
+
+  /**
+   * @brief Remove every occluder.
+   */
+  void ClearOccluders() noexcept;
+
+  /**
+   * @brief Find the renderables visible from each view.
+   *
+   * @param views Views to cull for; results are indexed like this span
+   */
+  void Cull(std::span<const CullView> views);
+
+  /**
+   * @brief Get the renderables visible from a view of the last Cull().
+   *
+   * @param view Index of the view in the span passed to Cull()
+   * @return Handles in ascending order, valid until the next Cull()
+   */
+  [[nodiscard]] std::span<const RenderableId> GetVisible(
+    std::size_t view) const noexcept;
+
+  /**
+   * @brief Get what the last Cull() did.
+   */
+  [[nodiscard]] const VisibilityStats& GetStats() const noexcept;
+
+private:
+  /// Boxes tested at once
+  static constexpr std::size_t kLaneCount{ 4U };
+
+  /// Boxes per job
+  static constexpr std::size_t kBoxesPerJob{ 2048U };
+
+  /**
+   * @brief Plane with its normal's absolute value, for box tests.
+   */
+  struct Plane {
+    float x{ 0.0F };
+    float y{ 0.0F };
+    float z{ 0.0F };
+    float w{ 0.0F };
+    float abs_x{ 0.0F };
+    float abs_y{ 0.0F };
+    float abs_z{ 0.0F };
+  };
+
+  /**
+   * @brief View being culled.
+   */
+  struct ViewState {
+    /// World-to-clip transform
+    glm::mat4 view_projection{ 1.0F };
+
+    /// Frustum planes, facing inwards
+    Plane planes[6]{};
+
+    /// Occluder depth of each pixel (null without occlusion culling)
+    const float* depth{ nullptr };
+  };
+
+  /**
+   * @brief Rasterize the occluders into the depth buffer as seen by a view.
+   */
+  void RasterizeOccluders(const glm::mat4& view_projection);
+
+  /**
+   * @brief Test the boxes of a range of lane groups against a view.
+   *
+   * @param view View to test against
+   * @param begin First box (multiple of kLaneCount)
+   * @param end One past the last box (multiple of kLaneCount)
+   * @param[out] visible Visible boxes of the range, compacted
+   * @param[out] occluded Number of boxes culled by occlusion
+   * @return Number of visible boxes
+   */
+  std::size_t CullRange(const ViewState& view, std::size_t begin,
+                        std::size_t end, RenderableId* visible,
+                        std::size_t& occluded) const noexcept;
+
+  /**
+   * @brief Check whether a box inside the frustum is hidden by occluders.
+   */
+  [[nodiscard]] bool IsOccluded(const ViewState& view,
+                                std::size_t box) const noexcept;
+
+  /// Bounding box centers, padded to a multiple of kLaneCount
+  std::vector<float> center_x_{};
+  std::vector<float> center_y_{};
+  std::vector<float> center_z_{};
+
+  /// Bounding box half extents, padded like the centers
+  std::vector<float> extent_x_{};
+  std::vector<float> extent_y_{};
+  std::vector<float> extent_z_{};
+
+  /// Whether each slot holds a renderable (padding and removed slots do not)
+  std::vector<std::uint8_t> alive_{};
+
+  /// Removed slots, reused first
+  std::vector<RenderableId> free_ids_{};
+
+  /// Number of slots handed out, including removed ones
+  std::size_t slot_count_{ 0U };
+
+  /// Number of registered renderables
+  std::size_t renderable_count_{ 0U };
+
+  /// Occluder triangle corners, three per triangle
+  std::vector<glm::vec3> occluder_vertices_{};
+
+  /// Occluder depth of each pixel for the view being culled
+  std::vector<float> depth_{};
+
+  /// Visible renderables of each view, compacted
+  std::vector<std::vector<RenderableId>> visible_{};
+
+  /// Visible count of each job's range of the view being culled
+  std::vector<std::size_t> range_counts_{};
+
+  /// What the last Cull() did
+  VisibilityStats stats_{};
+};
+
+} // namespace maple::renderer